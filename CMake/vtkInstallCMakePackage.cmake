@@ -128,6 +128,7 @@ set(vtk_cmake_module_files
   FindPEGTL.cmake
   FindTBB.cmake
   FindTHEORA.cmake
+  FindZstd.cmake
   Findutf8cpp.cmake
   FindCGNS.cmake
   FindzSpace.cmake
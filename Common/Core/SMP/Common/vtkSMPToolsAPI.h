@@ -219,6 +219,79 @@ public:
     }
   }
 
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename T, typename BinaryOp>
+  T Reduce(InputIt begin, InputIt end, T init, BinaryOp op)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        return this->SequentialBackend->Reduce(begin, end, init, op);
+      case BackendType::STDThread:
+        return this->STDThreadBackend->Reduce(begin, end, init, op);
+      case BackendType::TBB:
+        return this->TBBBackend->Reduce(begin, end, init, op);
+      case BackendType::OpenMP:
+        return this->OpenMPBackend->Reduce(begin, end, init, op);
+    }
+    return init;
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  T InclusiveScan(InputIt begin, InputIt end, OutputIt outBegin, T init, BinaryOp op)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        return this->SequentialBackend->InclusiveScan(begin, end, outBegin, init, op);
+      case BackendType::STDThread:
+        return this->STDThreadBackend->InclusiveScan(begin, end, outBegin, init, op);
+      case BackendType::TBB:
+        return this->TBBBackend->InclusiveScan(begin, end, outBegin, init, op);
+      case BackendType::OpenMP:
+        return this->OpenMPBackend->InclusiveScan(begin, end, outBegin, init, op);
+    }
+    return init;
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  T ExclusiveScan(InputIt begin, InputIt end, OutputIt outBegin, T init, BinaryOp op)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        return this->SequentialBackend->ExclusiveScan(begin, end, outBegin, init, op);
+      case BackendType::STDThread:
+        return this->STDThreadBackend->ExclusiveScan(begin, end, outBegin, init, op);
+      case BackendType::TBB:
+        return this->TBBBackend->ExclusiveScan(begin, end, outBegin, init, op);
+      case BackendType::OpenMP:
+        return this->OpenMPBackend->ExclusiveScan(begin, end, outBegin, init, op);
+    }
+    return init;
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename RandomAccessIterator, typename Predicate>
+  RandomAccessIterator Partition(
+    RandomAccessIterator begin, RandomAccessIterator end, Predicate pred)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        return this->SequentialBackend->Partition(begin, end, pred);
+      case BackendType::STDThread:
+        return this->STDThreadBackend->Partition(begin, end, pred);
+      case BackendType::TBB:
+        return this->TBBBackend->Partition(begin, end, pred);
+      case BackendType::OpenMP:
+        return this->OpenMPBackend->Partition(begin, end, pred);
+    }
+    return begin;
+  }
+
   // disable copying
   vtkSMPToolsAPI(vtkSMPToolsAPI const&) = delete;
   void operator=(vtkSMPToolsAPI const&) = delete;
@@ -92,6 +92,23 @@ public:
   template <typename RandomAccessIterator, typename Compare>
   void Sort(RandomAccessIterator begin, RandomAccessIterator end, Compare comp);
 
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename T, typename BinaryOp>
+  T Reduce(InputIt begin, InputIt end, T init, BinaryOp op);
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  T InclusiveScan(InputIt begin, InputIt end, OutputIt outBegin, T init, BinaryOp op);
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  T ExclusiveScan(InputIt begin, InputIt end, OutputIt outBegin, T init, BinaryOp op);
+
+  //--------------------------------------------------------------------------------
+  template <typename RandomAccessIterator, typename Predicate>
+  RandomAccessIterator Partition(
+    RandomAccessIterator begin, RandomAccessIterator end, Predicate pred);
+
   //--------------------------------------------------------------------------------
   vtkSMPToolsImpl();
 
@@ -4,7 +4,10 @@
 #ifndef vtkSMPToolsInternal_h
 #define vtkSMPToolsInternal_h
 
-#include <iterator> // For std::advance
+#include <algorithm> // For std::min
+#include <iterator>  // For std::advance
+#include <utility>   // For std::move
+#include <vector>    // For std::vector
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 namespace vtk
@@ -90,6 +93,372 @@ public:
   T operator()(T vtkNotUsed(inValue)) { return Value; }
 };
 
+//--------------------------------------------------------------------------------
+// The Reduce, Scan and Partition implementations of the threaded backends split
+// the input range in contiguous blocks. Each block is processed by a single
+// task, and the per-block results are combined serially in block order, so the
+// combination operator only needs to be associative (it does not need to be
+// commutative nor to have an identity element).
+class BlockDecomposition
+{
+public:
+  BlockDecomposition(vtkIdType size, int numberOfThreads)
+    : Size(size)
+  {
+    // A few blocks per thread to balance the load, but not so many that the
+    // serial combination of the per-block results becomes noticeable.
+    constexpr vtkIdType minimumBlockSize = 1024;
+    const vtkIdType numberOfBlocks = 4 * static_cast<vtkIdType>(std::max(numberOfThreads, 1));
+    this->BlockSize = std::max((size + numberOfBlocks - 1) / numberOfBlocks, minimumBlockSize);
+    this->NumberOfBlocks = size > 0 ? (size + this->BlockSize - 1) / this->BlockSize : 0;
+  }
+
+  vtkIdType GetNumberOfBlocks() const { return this->NumberOfBlocks; }
+  vtkIdType GetBlockBegin(vtkIdType block) const { return block * this->BlockSize; }
+  vtkIdType GetBlockEnd(vtkIdType block) const
+  {
+    return std::min((block + 1) * this->BlockSize, this->Size);
+  }
+
+private:
+  vtkIdType Size;
+  vtkIdType BlockSize;
+  vtkIdType NumberOfBlocks;
+};
+
+//--------------------------------------------------------------------------------
+// Per-block values written concurrently by the block tasks. The value is
+// wrapped so that std::vector<bool> bit packing cannot make two tasks write to
+// the same memory location.
+template <typename T>
+struct BlockValue
+{
+  T Value;
+};
+
+template <typename T>
+using BlockValues = std::vector<BlockValue<T>>;
+
+//--------------------------------------------------------------------------------
+// Reduce each block of the input range, storing one partial result per block.
+template <typename InputIt, typename T, typename BinaryOp>
+class BlockReduceCall
+{
+  InputIt In;
+  BinaryOp& Op;
+  const BlockDecomposition& Blocks;
+  BlockValues<T>& Partials;
+
+public:
+  BlockReduceCall(
+    InputIt _in, BinaryOp& _op, const BlockDecomposition& _blocks, BlockValues<T>& _partials)
+    : In(_in)
+    , Op(_op)
+    , Blocks(_blocks)
+    , Partials(_partials)
+  {
+  }
+
+  void Execute(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType block = begin; block < end; ++block)
+    {
+      const vtkIdType first = this->Blocks.GetBlockBegin(block);
+      const vtkIdType last = this->Blocks.GetBlockEnd(block);
+      InputIt itIn(this->In);
+      std::advance(itIn, first);
+      T acc = *itIn;
+      ++itIn;
+      for (vtkIdType i = first + 1; i < last; ++i, ++itIn)
+      {
+        acc = this->Op(acc, *itIn);
+      }
+      this->Partials[block].Value = acc;
+    }
+  }
+};
+
+//--------------------------------------------------------------------------------
+// Scan each block of the input range, starting from the (exclusive) offset of
+// the block computed from the per-block partial results.
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp, bool Inclusive>
+class BlockScanCall
+{
+  InputIt In;
+  OutputIt Out;
+  BinaryOp& Op;
+  const BlockDecomposition& Blocks;
+  const BlockValues<T>& Offsets;
+
+public:
+  BlockScanCall(InputIt _in, OutputIt _out, BinaryOp& _op, const BlockDecomposition& _blocks,
+    const BlockValues<T>& _offsets)
+    : In(_in)
+    , Out(_out)
+    , Op(_op)
+    , Blocks(_blocks)
+    , Offsets(_offsets)
+  {
+  }
+
+  void Execute(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType block = begin; block < end; ++block)
+    {
+      const vtkIdType first = this->Blocks.GetBlockBegin(block);
+      const vtkIdType last = this->Blocks.GetBlockEnd(block);
+      InputIt itIn(this->In);
+      OutputIt itOut(this->Out);
+      std::advance(itIn, first);
+      std::advance(itOut, first);
+      vtkIdType i = first;
+      T acc = this->Offsets[block].Value;
+      if (Inclusive && block == 0)
+      {
+        // The first block of an inclusive scan has no offset to start from.
+        acc = *itIn;
+        *itOut = acc;
+        ++itIn;
+        ++itOut;
+        ++i;
+      }
+      for (; i < last; ++i, ++itIn, ++itOut)
+      {
+        if (Inclusive)
+        {
+          acc = this->Op(acc, *itIn);
+          *itOut = acc;
+        }
+        else
+        {
+          // Read before writing to support in-place scans.
+          T value = *itIn;
+          *itOut = acc;
+          acc = this->Op(acc, value);
+        }
+      }
+    }
+  }
+};
+
+//--------------------------------------------------------------------------------
+// Count the number of elements satisfying the predicate in each block.
+template <typename Iterator, typename Predicate>
+class BlockCountCall
+{
+  Iterator Begin;
+  Predicate& Pred;
+  const BlockDecomposition& Blocks;
+  std::vector<vtkIdType>& Counts;
+
+public:
+  BlockCountCall(Iterator _begin, Predicate& _pred, const BlockDecomposition& _blocks,
+    std::vector<vtkIdType>& _counts)
+    : Begin(_begin)
+    , Pred(_pred)
+    , Blocks(_blocks)
+    , Counts(_counts)
+  {
+  }
+
+  void Execute(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType block = begin; block < end; ++block)
+    {
+      const vtkIdType first = this->Blocks.GetBlockBegin(block);
+      const vtkIdType last = this->Blocks.GetBlockEnd(block);
+      Iterator it(this->Begin);
+      std::advance(it, first);
+      vtkIdType count = 0;
+      for (vtkIdType i = first; i < last; ++i, ++it)
+      {
+        count += this->Pred(*it) ? 1 : 0;
+      }
+      this->Counts[block] = count;
+    }
+  }
+};
+
+//--------------------------------------------------------------------------------
+// Scatter the elements of each block in a temporary buffer: elements satisfying
+// the predicate go to the front of the buffer, the others to the back, both in
+// their original relative order.
+template <typename Iterator, typename Predicate, typename ValueType>
+class BlockScatterCall
+{
+  Iterator Begin;
+  Predicate& Pred;
+  const BlockDecomposition& Blocks;
+  const std::vector<vtkIdType>& TrueOffsets;
+  vtkIdType NumberOfTrue;
+  BlockValues<ValueType>& Buffer;
+
+public:
+  BlockScatterCall(Iterator _begin, Predicate& _pred, const BlockDecomposition& _blocks,
+    const std::vector<vtkIdType>& _trueOffsets, vtkIdType _numberOfTrue,
+    BlockValues<ValueType>& _buffer)
+    : Begin(_begin)
+    , Pred(_pred)
+    , Blocks(_blocks)
+    , TrueOffsets(_trueOffsets)
+    , NumberOfTrue(_numberOfTrue)
+    , Buffer(_buffer)
+  {
+  }
+
+  void Execute(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType block = begin; block < end; ++block)
+    {
+      const vtkIdType first = this->Blocks.GetBlockBegin(block);
+      const vtkIdType last = this->Blocks.GetBlockEnd(block);
+      vtkIdType trueId = this->TrueOffsets[block];
+      vtkIdType falseId = this->NumberOfTrue + first - trueId;
+      Iterator it(this->Begin);
+      std::advance(it, first);
+      for (vtkIdType i = first; i < last; ++i, ++it)
+      {
+        if (this->Pred(*it))
+        {
+          this->Buffer[trueId++].Value = std::move(*it);
+        }
+        else
+        {
+          this->Buffer[falseId++].Value = std::move(*it);
+        }
+      }
+    }
+  }
+};
+
+//--------------------------------------------------------------------------------
+// Move a contiguous buffer back into an iterator range.
+template <typename Iterator, typename ValueType>
+class MoveBackCall
+{
+  Iterator Begin;
+  BlockValues<ValueType>& Buffer;
+
+public:
+  MoveBackCall(Iterator _begin, BlockValues<ValueType>& _buffer)
+    : Begin(_begin)
+    , Buffer(_buffer)
+  {
+  }
+
+  void Execute(vtkIdType begin, vtkIdType end)
+  {
+    Iterator it(this->Begin);
+    std::advance(it, begin);
+    for (vtkIdType i = begin; i < end; ++i, ++it)
+    {
+      *it = std::move(this->Buffer[i].Value);
+    }
+  }
+};
+
+//--------------------------------------------------------------------------------
+// Generic block based implementations of Reduce, InclusiveScan, ExclusiveScan
+// and Partition shared by the threaded backends. `impl` is the backend
+// implementation whose For() method is used to process the blocks.
+template <typename Impl, typename InputIt, typename T, typename BinaryOp>
+T BlockReduce(Impl& impl, InputIt begin, InputIt end, T init, BinaryOp& op)
+{
+  const vtkIdType size = std::distance(begin, end);
+  const BlockDecomposition blocks(size, impl.GetEstimatedNumberOfThreads());
+  if (blocks.GetNumberOfBlocks() == 0)
+  {
+    return init;
+  }
+
+  BlockValues<T> partials(blocks.GetNumberOfBlocks(), BlockValue<T>{ init });
+  BlockReduceCall<InputIt, T, BinaryOp> exec(begin, op, blocks, partials);
+  impl.For(0, blocks.GetNumberOfBlocks(), 1, exec);
+
+  for (const BlockValue<T>& partial : partials)
+  {
+    init = op(init, partial.Value);
+  }
+  return init;
+}
+
+template <typename Impl, typename InputIt, typename OutputIt, typename T, typename BinaryOp,
+  bool Inclusive>
+T BlockScan(Impl& impl, InputIt begin, InputIt end, OutputIt outBegin, T init, BinaryOp& op)
+{
+  const vtkIdType size = std::distance(begin, end);
+  const BlockDecomposition blocks(size, impl.GetEstimatedNumberOfThreads());
+  const vtkIdType nbBlocks = blocks.GetNumberOfBlocks();
+  if (nbBlocks == 0)
+  {
+    return init;
+  }
+
+  // First pass: reduce each block.
+  BlockValues<T> offsets(nbBlocks, BlockValue<T>{ init });
+  BlockReduceCall<InputIt, T, BinaryOp> reduce(begin, op, blocks, offsets);
+  impl.For(0, nbBlocks, 1, reduce);
+
+  // Serial exclusive scan over the (few) per-block results. For an inclusive
+  // scan, `init` is only a placeholder for the first block offset.
+  T total = Inclusive ? offsets[0].Value : init;
+  for (vtkIdType block = 0; block < nbBlocks; ++block)
+  {
+    T partial = offsets[block].Value;
+    offsets[block].Value = total;
+    if (!Inclusive || block > 0)
+    {
+      total = op(total, partial);
+    }
+  }
+
+  // Second pass: scan each block from its offset.
+  BlockScanCall<InputIt, OutputIt, T, BinaryOp, Inclusive> scan(
+    begin, outBegin, op, blocks, offsets);
+  impl.For(0, nbBlocks, 1, scan);
+
+  return total;
+}
+
+template <typename Impl, typename Iterator, typename Predicate>
+Iterator BlockPartition(Impl& impl, Iterator begin, Iterator end, Predicate& pred)
+{
+  using ValueType = typename std::iterator_traits<Iterator>::value_type;
+
+  const vtkIdType size = std::distance(begin, end);
+  const BlockDecomposition blocks(size, impl.GetEstimatedNumberOfThreads());
+  const vtkIdType nbBlocks = blocks.GetNumberOfBlocks();
+  if (nbBlocks == 0)
+  {
+    return begin;
+  }
+
+  // First pass: count the elements satisfying the predicate in each block.
+  std::vector<vtkIdType> trueOffsets(nbBlocks, 0);
+  BlockCountCall<Iterator, Predicate> count(begin, pred, blocks, trueOffsets);
+  impl.For(0, nbBlocks, 1, count);
+
+  vtkIdType numberOfTrue = 0;
+  for (vtkIdType block = 0; block < nbBlocks; ++block)
+  {
+    vtkIdType blockCount = trueOffsets[block];
+    trueOffsets[block] = numberOfTrue;
+    numberOfTrue += blockCount;
+  }
+
+  // Second pass: scatter into a buffer at their final location, then move back.
+  BlockValues<ValueType> buffer(size);
+  BlockScatterCall<Iterator, Predicate, ValueType> scatter(
+    begin, pred, blocks, trueOffsets, numberOfTrue, buffer);
+  impl.For(0, nbBlocks, 1, scatter);
+
+  MoveBackCall<Iterator, ValueType> moveBack(begin, buffer);
+  impl.For(0, size, 0, moveBack);
+
+  std::advance(begin, numberOfTrue);
+  return begin;
+}
+
 VTK_ABI_NAMESPACE_END
 
 } // namespace smp
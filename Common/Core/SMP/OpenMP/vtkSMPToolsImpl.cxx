@@ -80,7 +80,11 @@ int GetNumberOfThreadsOpenMP()
 //------------------------------------------------------------------------------
 bool GetSingleThreadOpenMP()
 {
-  return threadIdStack->top() == omp_get_thread_num();
+  bool singleThread;
+#pragma omp critical(vtkSMPToolsOpenMPThreadIdStack)
+  // An empty stack means that the functor is executed inline by the caller.
+  singleThread = threadIdStack->empty() || threadIdStack->top() == omp_get_thread_num();
+  return singleThread;
 }
 
 //------------------------------------------------------------------------------
@@ -116,7 +120,11 @@ void vtkSMPToolsImplForOpenMP(vtkIdType first, vtkIdType last, vtkIdType grain,
 
   omp_set_max_active_levels(nestedActivated);
 
-#pragma omp single
+  // A critical section rather than a single construct: For may be called by
+  // one thread of an enclosing team while the others are busy elsewhere (e.g.
+  // waiting for vtkSMPTaskGraph tasks), and a single construct would wait for
+  // all of them at its implicit barrier.
+#pragma omp critical(vtkSMPToolsOpenMPThreadIdStack)
   threadIdStack->emplace(omp_get_thread_num());
 
 #pragma omp parallel for schedule(runtime)
@@ -125,7 +133,7 @@ void vtkSMPToolsImplForOpenMP(vtkIdType first, vtkIdType last, vtkIdType grain,
     functorExecuter(functor, from, grain, last);
   }
 
-#pragma omp single
+#pragma omp critical(vtkSMPToolsOpenMPThreadIdStack)
   threadIdStack->pop();
 }
 
@@ -143,6 +143,43 @@ void vtkSMPToolsImpl<BackendType::OpenMP>::Sort(
   std::sort(begin, end, comp);
 }
 
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename T, typename BinaryOp>
+T vtkSMPToolsImpl<BackendType::OpenMP>::Reduce(InputIt begin, InputIt end, T init, BinaryOp op)
+{
+  return BlockReduce(*this, begin, end, init, op);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+T vtkSMPToolsImpl<BackendType::OpenMP>::InclusiveScan(
+  InputIt begin, InputIt end, OutputIt outBegin, T init, BinaryOp op)
+{
+  return BlockScan<vtkSMPToolsImpl, InputIt, OutputIt, T, BinaryOp, true>(
+    *this, begin, end, outBegin, init, op);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+T vtkSMPToolsImpl<BackendType::OpenMP>::ExclusiveScan(
+  InputIt begin, InputIt end, OutputIt outBegin, T init, BinaryOp op)
+{
+  return BlockScan<vtkSMPToolsImpl, InputIt, OutputIt, T, BinaryOp, false>(
+    *this, begin, end, outBegin, init, op);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator, typename Predicate>
+RandomAccessIterator vtkSMPToolsImpl<BackendType::OpenMP>::Partition(
+  RandomAccessIterator begin, RandomAccessIterator end, Predicate pred)
+{
+  return BlockPartition(*this, begin, end, pred);
+}
+
 //--------------------------------------------------------------------------------
 template <>
 VTKCOMMONCORE_EXPORT void vtkSMPToolsImpl<BackendType::OpenMP>::Initialize(int);
@@ -4,7 +4,8 @@
 #ifndef SequentialvtkSMPToolsImpl_txx
 #define SequentialvtkSMPToolsImpl_txx
 
-#include <algorithm> // For std::sort, std::transform, std::fill
+#include <algorithm> // For std::sort, std::transform, std::fill, std::stable_partition
+#include <numeric>   // For std::accumulate
 
 #include "SMP/Common/vtkSMPToolsImpl.h"
 #include "SMP/Common/vtkSMPToolsInternal.h" // For common vtk smp class
@@ -90,6 +91,60 @@ void vtkSMPToolsImpl<BackendType::Sequential>::Sort(
   std::sort(begin, end, comp);
 }
 
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename T, typename BinaryOp>
+T vtkSMPToolsImpl<BackendType::Sequential>::Reduce(
+  InputIt begin, InputIt end, T init, BinaryOp op)
+{
+  return std::accumulate(begin, end, init, op);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+T vtkSMPToolsImpl<BackendType::Sequential>::InclusiveScan(
+  InputIt begin, InputIt end, OutputIt outBegin, T init, BinaryOp op)
+{
+  if (begin == end)
+  {
+    return init;
+  }
+  T acc = *begin;
+  *outBegin = acc;
+  for (++begin, ++outBegin; begin != end; ++begin, ++outBegin)
+  {
+    acc = op(acc, *begin);
+    *outBegin = acc;
+  }
+  return acc;
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+T vtkSMPToolsImpl<BackendType::Sequential>::ExclusiveScan(
+  InputIt begin, InputIt end, OutputIt outBegin, T init, BinaryOp op)
+{
+  for (; begin != end; ++begin, ++outBegin)
+  {
+    // Read before writing to support in-place scans.
+    T value = *begin;
+    *outBegin = init;
+    init = op(init, value);
+  }
+  return init;
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator, typename Predicate>
+RandomAccessIterator vtkSMPToolsImpl<BackendType::Sequential>::Partition(
+  RandomAccessIterator begin, RandomAccessIterator end, Predicate pred)
+{
+  return std::stable_partition(begin, end, pred);
+}
+
 //--------------------------------------------------------------------------------
 template <>
 VTKCOMMONCORE_EXPORT void vtkSMPToolsImpl<BackendType::Sequential>::Initialize(int);
@@ -194,6 +194,43 @@ void vtkSMPToolsImpl<BackendType::TBB>::Sort(
   tbb::parallel_sort(begin, end, comp);
 }
 
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename T, typename BinaryOp>
+T vtkSMPToolsImpl<BackendType::TBB>::Reduce(InputIt begin, InputIt end, T init, BinaryOp op)
+{
+  return BlockReduce(*this, begin, end, init, op);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+T vtkSMPToolsImpl<BackendType::TBB>::InclusiveScan(
+  InputIt begin, InputIt end, OutputIt outBegin, T init, BinaryOp op)
+{
+  return BlockScan<vtkSMPToolsImpl, InputIt, OutputIt, T, BinaryOp, true>(
+    *this, begin, end, outBegin, init, op);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+T vtkSMPToolsImpl<BackendType::TBB>::ExclusiveScan(
+  InputIt begin, InputIt end, OutputIt outBegin, T init, BinaryOp op)
+{
+  return BlockScan<vtkSMPToolsImpl, InputIt, OutputIt, T, BinaryOp, false>(
+    *this, begin, end, outBegin, init, op);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator, typename Predicate>
+RandomAccessIterator vtkSMPToolsImpl<BackendType::TBB>::Partition(
+  RandomAccessIterator begin, RandomAccessIterator end, Predicate pred)
+{
+  return BlockPartition(*this, begin, end, pred);
+}
+
 //--------------------------------------------------------------------------------
 template <>
 VTKCOMMONCORE_EXPORT void vtkSMPToolsImpl<BackendType::TBB>::Initialize(int);
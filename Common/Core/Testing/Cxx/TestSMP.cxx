@@ -9,6 +9,7 @@
 #include "vtkSMPTools.h"
 #include "vtkStringScanner.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <deque>
 #include <functional>
@@ -497,6 +498,101 @@ int doTestSMP()
       return EXIT_FAILURE;
     }
   }
+
+  // Test reduce
+  constexpr vtkIdType reduceSize = 100000;
+  std::vector<vtkIdType> reduceData(reduceSize);
+  std::iota(reduceData.begin(), reduceData.end(), 0);
+  const vtkIdType reduceTarget = reduceSize * (reduceSize - 1) / 2 + 5;
+  if (vtkSMPTools::Reduce(reduceData.cbegin(), reduceData.cend(), vtkIdType(5)) != reduceTarget)
+  {
+    std::cerr << "Error: Invalid output for vtkSMPTools::Reduce!" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const vtkIdType maxValue = vtkSMPTools::Reduce(reduceData.cbegin(), reduceData.cend(),
+    vtkIdType(-1), [](vtkIdType a, vtkIdType b) { return std::max(a, b); });
+  if (maxValue != reduceSize - 1)
+  {
+    std::cerr << "Error: Invalid output for vtkSMPTools::Reduce with max operator!" << std::endl;
+    return EXIT_FAILURE;
+  }
+  // Associative but non commutative operator: the order of the values must be kept
+  const auto keepLast = [](vtkIdType, vtkIdType b) { return b; };
+  if (vtkSMPTools::Reduce(reduceData.cbegin(), reduceData.cend(), vtkIdType(-1), keepLast) !=
+    reduceSize - 1)
+  {
+    std::cerr << "Error: Invalid output for vtkSMPTools::Reduce with non commutative operator!"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (vtkSMPTools::Reduce(reduceData.cbegin(), reduceData.cbegin(), vtkIdType(7)) != 7)
+  {
+    std::cerr << "Error: Invalid output for vtkSMPTools::Reduce on an empty range!" << std::endl;
+    return EXIT_FAILURE;
+  }
+  // Partial results of bool type must not be bit packed
+  std::vector<bool> flags(reduceSize, true);
+  flags[reduceSize - 3] = false;
+  const auto logicalAnd = [](bool a, bool b) { return a && b; };
+  if (vtkSMPTools::Reduce(flags.cbegin(), flags.cend(), true, logicalAnd) ||
+    !vtkSMPTools::Reduce(flags.cbegin(), flags.cend() - 3, true, logicalAnd))
+  {
+    std::cerr << "Error: Invalid output for vtkSMPTools::Reduce on bool values!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Test scans
+  std::vector<vtkIdType> counts(reduceSize);
+  for (vtkIdType i = 0; i < reduceSize; ++i)
+  {
+    counts[i] = i % 7;
+  }
+  std::vector<vtkIdType> offsets(reduceSize + 1, -1);
+  offsets[reduceSize] =
+    vtkSMPTools::ExclusiveScan(counts.cbegin(), counts.cend(), offsets.begin(), vtkIdType(0));
+  std::vector<vtkIdType> inclusive(counts);
+  const vtkIdType inclusiveTotal =
+    vtkSMPTools::InclusiveScan(inclusive.begin(), inclusive.end(), inclusive.begin());
+  vtkIdType expected = 0;
+  for (vtkIdType i = 0; i < reduceSize; ++i)
+  {
+    if (offsets[i] != expected)
+    {
+      std::cerr << "Error: Invalid output for vtkSMPTools::ExclusiveScan at " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+    expected += counts[i];
+    if (inclusive[i] != expected)
+    {
+      std::cerr << "Error: Invalid output for in-place vtkSMPTools::InclusiveScan at " << i
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (offsets[reduceSize] != expected || inclusiveTotal != expected)
+  {
+    std::cerr << "Error: Invalid total returned by vtkSMPTools scans!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Test stable partition
+  std::vector<vtkIdType> partitionData(reduceData);
+  const auto isEven = [](vtkIdType value) { return value % 2 == 0; };
+  auto middle = vtkSMPTools::Partition(partitionData.begin(), partitionData.end(), isEven);
+  if (middle - partitionData.begin() != reduceSize / 2)
+  {
+    std::cerr << "Error: Invalid partition point returned by vtkSMPTools::Partition!" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < reduceSize / 2; ++i)
+  {
+    if (partitionData[i] != 2 * i || partitionData[reduceSize / 2 + i] != 2 * i + 1)
+    {
+      std::cerr << "Error: Invalid output for vtkSMPTools::Partition at " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   return EXIT_SUCCESS;
 }
 
@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkNew.h"
+#include "vtkSMPTaskGraph.h"
+#include "vtkSMPTools.h"
+#include "vtkStringScanner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+int doTestSMPTaskGraph()
+{
+  std::cout << "Testing vtkSMPTaskGraph with " << vtkSMPTools::GetBackend() << " backend."
+            << std::endl;
+
+  // A fan-in / fan-out graph: several independent chains joined by a final task.
+  constexpr int nbChains = 16;
+  constexpr int chainLength = 50;
+  std::vector<int> chainValues(nbChains, 0);
+  std::atomic<int> nbErrors(0);
+  int finalValue = 0;
+
+  vtkNew<vtkSMPTaskGraph> graph;
+  std::vector<vtkIdType> chainEnds;
+  for (int chain = 0; chain < nbChains; ++chain)
+  {
+    vtkIdType previous = graph->AddTask([&chainValues, chain] { chainValues[chain] = 1; });
+    for (int i = 1; i < chainLength; ++i)
+    {
+      // Each task checks that its predecessor ran before it.
+      previous = graph->AddContinuation(previous,
+        [&chainValues, &nbErrors, chain, i]
+        {
+          if (chainValues[chain] != i)
+          {
+            ++nbErrors;
+          }
+          chainValues[chain] = i + 1;
+        });
+    }
+    chainEnds.push_back(previous);
+  }
+  graph->AddTask(
+    [&]
+    {
+      for (int value : chainValues)
+      {
+        finalValue += value;
+      }
+    },
+    chainEnds);
+
+  if (graph->GetNumberOfTasks() != nbChains * chainLength + 1)
+  {
+    std::cerr << "Error: wrong number of tasks " << graph->GetNumberOfTasks() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The graph can be executed several times.
+  for (int run = 0; run < 2; ++run)
+  {
+    std::fill(chainValues.begin(), chainValues.end(), 0);
+    finalValue = 0;
+    if (!graph->Execute())
+    {
+      std::cerr << "Error: execution of an acyclic graph failed." << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (nbErrors != 0 || finalValue != nbChains * chainLength)
+    {
+      std::cerr << "Error: dependencies were not honored, got " << finalValue << " instead of "
+                << nbChains * chainLength << " with " << nbErrors << " ordering errors."
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Tasks may use vtkSMPTools themselves, while the other workers wait for
+  // tasks to become ready.
+  vtkNew<vtkSMPTaskGraph> nestedGraph;
+  std::vector<vtkIdType> sums(4, 0);
+  vtkIdType previousSum = -1;
+  for (int i = 0; i < 4; ++i)
+  {
+    auto sum = [&sums, i]
+    {
+      std::vector<vtkIdType> values(10000, 1);
+      sums[i] = vtkSMPTools::Reduce(values.begin(), values.end(), vtkIdType(0));
+    };
+    previousSum =
+      previousSum < 0 ? nestedGraph->AddTask(sum) : nestedGraph->AddContinuation(previousSum, sum);
+  }
+  nestedGraph->Execute();
+  for (vtkIdType sum : sums)
+  {
+    if (sum != 10000)
+    {
+      std::cerr << "Error: wrong result for a task using vtkSMPTools." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // A cycle must be detected and nothing must run.
+  vtkNew<vtkSMPTaskGraph> cyclicGraph;
+  bool hasRun = false;
+  vtkIdType first = cyclicGraph->AddTask([&] { hasRun = true; });
+  vtkIdType second = cyclicGraph->AddContinuation(first, [&] { hasRun = true; });
+  cyclicGraph->AddDependency(second, first);
+  std::cout << "Expecting an error about a cycle." << std::endl;
+  if (cyclicGraph->Execute() || hasRun)
+  {
+    std::cerr << "Error: a cyclic graph was executed." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+}
+
+int TestSMPTaskGraph(int argc, char* argv[])
+{
+  int returnValue = EXIT_SUCCESS;
+  for (int i = 1; i < argc; i++)
+  {
+    std::string argument(argv[i] + 2);
+    std::size_t separator = argument.find('=');
+    std::string backend = argument.substr(0, separator);
+    int value;
+    VTK_FROM_CHARS_IF_ERROR_RETURN(argument.substr(separator + 1), value, EXIT_FAILURE);
+    if (value)
+    {
+      vtkSMPTools::SetBackend(backend.c_str());
+      if (doTestSMPTaskGraph() != EXIT_SUCCESS)
+      {
+        returnValue = EXIT_FAILURE;
+      }
+    }
+  }
+  return returnValue;
+}
@@ -0,0 +1,316 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkSMPTaskGraph.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkSMPTaskGraph);
+
+namespace
+{
+//------------------------------------------------------------------------------
+struct TaskNode
+{
+  vtkSMPTaskGraph::TaskFunction Function;
+  std::vector<vtkIdType> Dependents;
+  vtkIdType NumberOfDependencies = 0;
+};
+}
+
+//------------------------------------------------------------------------------
+struct vtkSMPTaskGraph::vtkInternals
+{
+  std::vector<TaskNode> Tasks;
+
+  bool IsValid(vtkIdType id) const
+  {
+    return id >= 0 && id < static_cast<vtkIdType>(this->Tasks.size());
+  }
+
+  // Kahn's algorithm: the graph is acyclic if all the tasks can be reached by
+  // removing the tasks without dependencies one after another.
+  bool IsAcyclic() const
+  {
+    const vtkIdType nbTasks = static_cast<vtkIdType>(this->Tasks.size());
+    std::vector<vtkIdType> remaining(nbTasks);
+    std::vector<vtkIdType> ready;
+    for (vtkIdType id = 0; id < nbTasks; ++id)
+    {
+      remaining[id] = this->Tasks[id].NumberOfDependencies;
+      if (remaining[id] == 0)
+      {
+        ready.push_back(id);
+      }
+    }
+    vtkIdType nbVisited = 0;
+    while (!ready.empty())
+    {
+      const vtkIdType id = ready.back();
+      ready.pop_back();
+      ++nbVisited;
+      for (vtkIdType dependent : this->Tasks[id].Dependents)
+      {
+        if (--remaining[dependent] == 0)
+        {
+          ready.push_back(dependent);
+        }
+      }
+    }
+    return nbVisited == nbTasks;
+  }
+};
+
+namespace
+{
+//------------------------------------------------------------------------------
+// State shared by the workers during one execution of the graph.
+class TaskGraphExecution
+{
+public:
+  TaskGraphExecution(std::vector<TaskNode>& tasks, vtkIdType numberOfWorkers)
+    : Tasks(tasks)
+    , RemainingDependencies(new std::atomic<vtkIdType>[tasks.size()])
+    , Queues(numberOfWorkers)
+    , NumberOfPendingTasks(static_cast<vtkIdType>(tasks.size()))
+  {
+    // Spread the initial tasks over the workers.
+    vtkIdType worker = 0;
+    for (std::size_t id = 0; id < tasks.size(); ++id)
+    {
+      this->RemainingDependencies[id] = tasks[id].NumberOfDependencies;
+      if (tasks[id].NumberOfDependencies == 0)
+      {
+        this->Queues[worker].Tasks.push_back(static_cast<vtkIdType>(id));
+        ++this->NumberOfReadyTasks;
+        worker = (worker + 1) % numberOfWorkers;
+      }
+    }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType worker = begin; worker < end; ++worker)
+    {
+      this->RunWorker(worker);
+    }
+  }
+
+private:
+  struct WorkerQueue
+  {
+    std::mutex Mutex;
+    std::deque<vtkIdType> Tasks;
+  };
+
+  void RunWorker(vtkIdType worker)
+  {
+    while (this->NumberOfPendingTasks > 0)
+    {
+      vtkIdType id;
+      if (this->Pop(worker, id) || this->Steal(worker, id))
+      {
+        --this->NumberOfReadyTasks;
+        this->Run(worker, id);
+      }
+      else
+      {
+        std::unique_lock<std::mutex> lock(this->WaitMutex);
+        this->WaitCondition.wait(lock,
+          [this] { return this->NumberOfReadyTasks > 0 || this->NumberOfPendingTasks == 0; });
+      }
+    }
+  }
+
+  // The owner of a queue picks its most recent task, which most likely uses
+  // the data the worker just produced.
+  bool Pop(vtkIdType worker, vtkIdType& id)
+  {
+    WorkerQueue& queue = this->Queues[worker];
+    std::lock_guard<std::mutex> lock(queue.Mutex);
+    if (queue.Tasks.empty())
+    {
+      return false;
+    }
+    id = queue.Tasks.back();
+    queue.Tasks.pop_back();
+    return true;
+  }
+
+  // Thieves pick the oldest task of the other queues.
+  bool Steal(vtkIdType worker, vtkIdType& id)
+  {
+    const vtkIdType nbQueues = static_cast<vtkIdType>(this->Queues.size());
+    for (vtkIdType i = 1; i < nbQueues; ++i)
+    {
+      WorkerQueue& queue = this->Queues[(worker + i) % nbQueues];
+      std::lock_guard<std::mutex> lock(queue.Mutex);
+      if (!queue.Tasks.empty())
+      {
+        id = queue.Tasks.front();
+        queue.Tasks.pop_front();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void Run(vtkIdType worker, vtkIdType id)
+  {
+    TaskNode& task = this->Tasks[id];
+    if (task.Function)
+    {
+      task.Function();
+    }
+
+    for (vtkIdType dependent : task.Dependents)
+    {
+      if (--this->RemainingDependencies[dependent] == 0)
+      {
+        {
+          WorkerQueue& queue = this->Queues[worker];
+          std::lock_guard<std::mutex> lock(queue.Mutex);
+          queue.Tasks.push_back(dependent);
+        }
+        ++this->NumberOfReadyTasks;
+        this->Notify(false);
+      }
+    }
+
+    if (--this->NumberOfPendingTasks == 0)
+    {
+      this->Notify(true);
+    }
+  }
+
+  void Notify(bool all)
+  {
+    // Taking the lock ensures that a worker cannot miss the notification
+    // between the evaluation of its wait predicate and its sleep.
+    {
+      std::lock_guard<std::mutex> lock(this->WaitMutex);
+    }
+    if (all)
+    {
+      this->WaitCondition.notify_all();
+    }
+    else
+    {
+      this->WaitCondition.notify_one();
+    }
+  }
+
+  std::vector<TaskNode>& Tasks;
+  std::unique_ptr<std::atomic<vtkIdType>[]> RemainingDependencies;
+  std::vector<WorkerQueue> Queues;
+  std::atomic<vtkIdType> NumberOfPendingTasks;
+  std::atomic<vtkIdType> NumberOfReadyTasks{ 0 };
+  std::mutex WaitMutex;
+  std::condition_variable WaitCondition;
+};
+}
+
+//------------------------------------------------------------------------------
+vtkSMPTaskGraph::vtkSMPTaskGraph()
+  : Internals(new vtkInternals())
+{
+}
+
+//------------------------------------------------------------------------------
+vtkSMPTaskGraph::~vtkSMPTaskGraph() = default;
+
+//------------------------------------------------------------------------------
+vtkIdType vtkSMPTaskGraph::AddTask(TaskFunction task)
+{
+  this->Internals->Tasks.emplace_back();
+  this->Internals->Tasks.back().Function = std::move(task);
+  this->Modified();
+  return static_cast<vtkIdType>(this->Internals->Tasks.size()) - 1;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkSMPTaskGraph::AddTask(
+  TaskFunction task, std::initializer_list<vtkIdType> dependencies)
+{
+  return this->AddTask(std::move(task), std::vector<vtkIdType>(dependencies));
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkSMPTaskGraph::AddTask(TaskFunction task, const std::vector<vtkIdType>& dependencies)
+{
+  const vtkIdType id = this->AddTask(std::move(task));
+  for (vtkIdType dependency : dependencies)
+  {
+    this->AddDependency(dependency, id);
+  }
+  return id;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkSMPTaskGraph::AddContinuation(vtkIdType predecessor, TaskFunction task)
+{
+  return this->AddTask(std::move(task), { predecessor });
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTaskGraph::AddDependency(vtkIdType before, vtkIdType after)
+{
+  if (!this->Internals->IsValid(before) || !this->Internals->IsValid(after))
+  {
+    vtkErrorMacro("Invalid dependency between tasks " << before << " and " << after << ".");
+    return false;
+  }
+  this->Internals->Tasks[before].Dependents.push_back(after);
+  ++this->Internals->Tasks[after].NumberOfDependencies;
+  this->Modified();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkSMPTaskGraph::GetNumberOfTasks() const
+{
+  return static_cast<vtkIdType>(this->Internals->Tasks.size());
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTaskGraph::Clear()
+{
+  this->Internals->Tasks.clear();
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTaskGraph::Execute()
+{
+  const vtkIdType nbTasks = this->GetNumberOfTasks();
+  if (nbTasks == 0)
+  {
+    return true;
+  }
+  if (!this->Internals->IsAcyclic())
+  {
+    vtkErrorMacro("The task graph contains a cycle, it cannot be executed.");
+    return false;
+  }
+
+  const vtkIdType nbWorkers = std::max<vtkIdType>(
+    1, std::min<vtkIdType>(vtkSMPTools::GetEstimatedNumberOfThreads(), nbTasks));
+  TaskGraphExecution execution(this->Internals->Tasks, nbWorkers);
+  vtkSMPTools::For(0, nbWorkers, 1, execution);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTaskGraph::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfTasks: " << this->GetNumberOfTasks() << "\n";
+}
+VTK_ABI_NAMESPACE_END
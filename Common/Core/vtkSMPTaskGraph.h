@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class vtkSMPTaskGraph
+ * @brief run a graph of dependent tasks using the vtkSMPTools backend
+ *
+ * vtkSMPTaskGraph stores a set of tasks (any callable taking no argument) and
+ * dependencies between them, then runs the whole graph in parallel with
+ * `Execute()`. A task starts as soon as all the tasks it depends on are
+ * finished, so independent chains of tasks run concurrently.
+ *
+ * Tasks are executed by a set of workers started with `vtkSMPTools::For`, so
+ * the graph runs on whichever vtkSMPTools backend is in use (STDThread thread
+ * pool, TBB, OpenMP or Sequential) and honors `vtkSMPTools::LocalScope`. Each
+ * worker owns a queue of ready tasks: when a task completes, the dependents it
+ * makes ready are pushed to the queue of the worker that ran it, which picks
+ * the most recent one first for cache locality. Idle workers steal the oldest
+ * tasks from the other queues.
+ *
+ * A continuation is a task that runs right after another one: it is a
+ * shortcut for adding a task with a single dependency.
+ *
+ * @code
+ *   vtkNew<vtkSMPTaskGraph> graph;
+ *   auto readA = graph->AddTask([&] { readerA->Update(); });
+ *   auto readB = graph->AddTask([&] { readerB->Update(); });
+ *   auto merge = graph->AddTask([&] { append->Update(); }, { readA, readB });
+ *   graph->AddContinuation(merge, [&] { writer->Write(); });
+ *   graph->Execute();
+ * @endcode
+ *
+ * Tasks can call vtkSMPTools functions. Whether they run in parallel inside a
+ * task depends on the nested parallelism setting of the backend.
+ *
+ * The graph is not modified by `Execute()`, so it can be executed several
+ * times. Adding tasks or dependencies while the graph is executing is not
+ * supported.
+ *
+ * @sa
+ * vtkSMPTools vtkThreadedCallbackQueue
+ */
+
+#ifndef vtkSMPTaskGraph_h
+#define vtkSMPTaskGraph_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+#include <functional>       // For std::function
+#include <initializer_list> // For std::initializer_list
+#include <memory>           // For std::unique_ptr
+#include <vector>           // For std::vector
+
+#if !defined(__WRAP__)
+
+VTK_ABI_NAMESPACE_BEGIN
+
+class VTKCOMMONCORE_EXPORT vtkSMPTaskGraph : public vtkObject
+{
+public:
+  static vtkSMPTaskGraph* New();
+  vtkTypeMacro(vtkSMPTaskGraph, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  using TaskFunction = std::function<void()>;
+
+  ///@{
+  /**
+   * Add a task to the graph and return its id. The task will not start before
+   * all the tasks listed in `dependencies` are finished.
+   */
+  vtkIdType AddTask(TaskFunction task);
+  vtkIdType AddTask(TaskFunction task, std::initializer_list<vtkIdType> dependencies);
+  vtkIdType AddTask(TaskFunction task, const std::vector<vtkIdType>& dependencies);
+  ///@}
+
+  /**
+   * Add a task that runs once the task `predecessor` is finished.
+   * Return the id of the new task.
+   */
+  vtkIdType AddContinuation(vtkIdType predecessor, TaskFunction task);
+
+  /**
+   * Make the task `after` wait for the task `before` to be finished.
+   * Return false if one of the ids is invalid.
+   */
+  bool AddDependency(vtkIdType before, vtkIdType after);
+
+  /**
+   * Get the number of tasks in the graph.
+   */
+  vtkIdType GetNumberOfTasks() const;
+
+  /**
+   * Remove all the tasks.
+   */
+  void Clear();
+
+  /**
+   * Run all the tasks of the graph and return when they are all finished.
+   * Return false (and run nothing) if the dependencies contain a cycle.
+   */
+  bool Execute();
+
+protected:
+  vtkSMPTaskGraph();
+  ~vtkSMPTaskGraph() override;
+
+private:
+  vtkSMPTaskGraph(const vtkSMPTaskGraph&) = delete;
+  void operator=(const vtkSMPTaskGraph&) = delete;
+
+  struct vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+VTK_ABI_NAMESPACE_END
+
+#endif
+#endif
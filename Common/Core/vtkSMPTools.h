@@ -6,6 +6,9 @@
  *
  * vtkSMPTools provides a set of utility functions that can
  * be used to parallelize parts of VTK code using multiple threads.
+ * Besides the generic For loop, it offers parallel versions of common
+ * algorithms: Transform, Fill, Sort, Reduce, InclusiveScan, ExclusiveScan
+ * and Partition.
  * There are several back-end implementations of parallel functionality
  * (currently Sequential, TBB, OpenMP and STDThread) that actual execution is
  * delegated to.
@@ -24,7 +27,8 @@
 #include "SMP/Common/vtkSMPToolsAPI.h"
 #include "vtkSMPThreadLocal.h" // For Initialized
 
-#include <functional>  // For std::function
+#include <functional>  // For std::function, std::plus
+#include <iterator>    // For std::iterator_traits
 #include <type_traits> // For std:::enable_if
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -623,6 +627,120 @@ public:
     auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
     SMPToolsAPI.Sort(begin, end, comp);
   }
+
+  ///@{
+  /**
+   * A convenience method for reducing data. It computes the generalized sum of
+   * `init` and of all the values of the range using the binary operation `op`
+   * (std::plus by default), like std::reduce().
+   *
+   * The range is split in contiguous blocks processed in parallel, and the
+   * per-block results are combined in order. `op` must therefore be
+   * associative, but it does not need to be commutative. Note that with
+   * floating point values, the result may slightly depend on the number of
+   * threads in use.
+   *
+   * Usage example with vtkDataArray:
+   * \code
+   * const auto range = vtk::DataArrayValueRange<1>(array);
+   * double max = vtkSMPTools::Reduce(range.cbegin(), range.cend(), VTK_DOUBLE_MIN,
+   *   [](double a, double b) { return std::max(a, b); });
+   * \endcode
+   */
+  template <typename InputIt, typename T, typename BinaryOp>
+  static T Reduce(InputIt begin, InputIt end, T init, BinaryOp op)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.Reduce(begin, end, init, op);
+  }
+
+  template <typename InputIt, typename T>
+  static T Reduce(InputIt begin, InputIt end, T init)
+  {
+    return vtkSMPTools::Reduce(begin, end, init, std::plus<T>());
+  }
+  ///@}
+
+  ///@{
+  /**
+   * A convenience method computing an inclusive prefix sum (or generalized
+   * prefix sum using the associative binary operation `op`, std::plus by
+   * default). The i-th output value is the sum of the first i+1 input values,
+   * like std::inclusive_scan(). The output range may be the input range
+   * (in-place scan).
+   *
+   * It returns the sum of all the input values, i.e. the last output value,
+   * or a value-initialized value if the range is empty.
+   *
+   * The scan is done in two parallel passes over the data, and only a few
+   * values (one per block of data) are processed serially in between.
+   */
+  template <typename InputIt, typename OutputIt, typename BinaryOp>
+  static typename std::iterator_traits<InputIt>::value_type InclusiveScan(
+    InputIt begin, InputIt end, OutputIt outBegin, BinaryOp op)
+  {
+    using T = typename std::iterator_traits<InputIt>::value_type;
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.InclusiveScan(begin, end, outBegin, T{}, op);
+  }
+
+  template <typename InputIt, typename OutputIt>
+  static typename std::iterator_traits<InputIt>::value_type InclusiveScan(
+    InputIt begin, InputIt end, OutputIt outBegin)
+  {
+    using T = typename std::iterator_traits<InputIt>::value_type;
+    return vtkSMPTools::InclusiveScan(begin, end, outBegin, std::plus<T>());
+  }
+  ///@}
+
+  ///@{
+  /**
+   * A convenience method computing an exclusive prefix sum (or generalized
+   * prefix sum using the associative binary operation `op`, std::plus by
+   * default). The i-th output value is the sum of `init` and of the first i
+   * input values, like std::exclusive_scan(). The output range may be the input
+   * range (in-place scan).
+   *
+   * It returns the sum of `init` and of all the input values. This makes it
+   * well suited to turn per-item counts into offsets:
+   * \code
+   * // counts has n entries, offsets has n + 1 entries
+   * offsets[n] =
+   *   vtkSMPTools::ExclusiveScan(counts.begin(), counts.end(), offsets.begin(), vtkIdType(0));
+   * \endcode
+   */
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  static T ExclusiveScan(InputIt begin, InputIt end, OutputIt outBegin, T init, BinaryOp op)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.ExclusiveScan(begin, end, outBegin, init, op);
+  }
+
+  template <typename InputIt, typename OutputIt, typename T>
+  static T ExclusiveScan(InputIt begin, InputIt end, OutputIt outBegin, T init)
+  {
+    return vtkSMPTools::ExclusiveScan(begin, end, outBegin, init, std::plus<T>());
+  }
+  ///@}
+
+  /**
+   * A convenience method for partitioning data. It is a drop in replacement
+   * for std::stable_partition(): the elements for which `pred` returns true
+   * are moved before the others, and the relative order of the elements is
+   * preserved in both groups. It returns an iterator to the first element of
+   * the second group.
+   *
+   * `pred` is evaluated twice per element and must not modify it. The value
+   * type of the range must be default constructible, since a temporary buffer
+   * of the size of the range is used.
+   */
+  template <typename RandomAccessIterator, typename Predicate>
+  static RandomAccessIterator Partition(
+    RandomAccessIterator begin, RandomAccessIterator end, Predicate pred)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.Partition(begin, end, pred);
+  }
 };
 
 VTK_ABI_NAMESPACE_END
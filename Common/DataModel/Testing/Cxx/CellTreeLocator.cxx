@@ -8,9 +8,11 @@
 #include "vtkDataArray.h"
 #include "vtkDebugLeaks.h"
 #include "vtkGenericCell.h"
+#include "vtkImageData.h"
 #include "vtkNew.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSphereSource.h"
 #include "vtkTransform.h"
 #include "vtkTransformFilter.h"
@@ -256,11 +258,58 @@ int Test2dFindMultipleCells()
   return retVal;
 }
 
+// Build the tree of a thin grid, large enough for the first nodes to be split
+// with their cells processed concurrently, and check that it finds the cells
+// holding points with one and several threads.
+int TestParallelBuild()
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(101, 101, 21);
+  image->SetSpacing(1.0, 1.0, 0.001);
+
+  int retVal = EXIT_SUCCESS;
+  for (int numberOfThreads : { 1, 4 })
+  {
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ numberOfThreads },
+      [&]()
+      {
+        vtkNew<vtkCellTreeLocator> locator;
+        locator->SetDataSet(image);
+        locator->BuildLocator();
+
+        vtkNew<vtkGenericCell> cell;
+        double pcoords[3], weights[8];
+        int subId;
+        for (int k = 0; k < 20; k += 3)
+        {
+          for (int j = 0; j < 100; j += 7)
+          {
+            for (int i = 0; i < 100; i += 7)
+            {
+              double x[3] = { i + 0.5, j + 0.5, (k + 0.5) * 0.001 };
+              int ijk[3] = { i, j, k };
+              const vtkIdType expected = image->ComputeCellId(ijk);
+              const vtkIdType cellId = locator->FindCell(x, 0, cell, subId, pcoords, weights);
+              if (cellId != expected)
+              {
+                std::cerr << "Expected cell " << expected << " but found " << cellId << " with "
+                          << numberOfThreads << " threads" << std::endl;
+                retVal = EXIT_FAILURE;
+              }
+            }
+          }
+        }
+      });
+  }
+  return retVal;
+}
+
 int CellTreeLocator(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
 {
   int retVal = TestWithCachedCellBoundsParameter(0);
   retVal += TestWithCachedCellBoundsParameter(1);
   retVal += Test2dFindMultipleCells();
+  retVal += TestParallelBuild();
 
   return retVal;
 }
@@ -0,0 +1,286 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check the queries of vtkBVHCellLocator against brute force evaluations over
+// all the cells.
+
+#include "vtkBVHCellLocator.h"
+
+#include "vtkBoundingBox.h"
+#include "vtkBox.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <set>
+#include <vector>
+
+namespace
+{
+// Points scattered in [lo, hi]^3.
+void MakePoints(std::vector<double>& points, int numPoints, double lo, double hi, int seed)
+{
+  points.resize(3 * numPoints);
+  for (int i = 0; i < numPoints; ++i)
+  {
+    for (int a = 0; a < 3; ++a)
+    {
+      const double f = std::fmod((i + seed) * (0.618034 + 0.1 * a) + 0.3 * a, 1.0);
+      points[3 * i + a] = lo + (hi - lo) * f;
+    }
+  }
+}
+
+int TestLines(vtkBVHCellLocator* locator, vtkDataSet* surface)
+{
+  // Random segments, and segments parallel to the axes.
+  std::vector<double> starts, ends;
+  MakePoints(starts, 300, -1.0, 1.0, 0);
+  MakePoints(ends, 300, -1.0, 1.0, 7);
+  for (int i = 0; i < 300; i += 3)
+  {
+    const int a = (i / 3) % 3;
+    std::copy(starts.begin() + 3 * i, starts.begin() + 3 * i + 3, ends.begin() + 3 * i);
+    starts[3 * i + a] = -1.0;
+    ends[3 * i + a] = 1.0;
+  }
+
+  int numErrors = 0;
+  int numHits = 0;
+  vtkNew<vtkGenericCell> cell;
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkIdList> cellsAlongLine;
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 300; ++i)
+  {
+    const double* p1 = starts.data() + 3 * i;
+    const double* p2 = ends.data() + 3 * i;
+    double rayDir[3], t, x[3], pcoords[3], cellBounds[6], hitPosition[3], tBox;
+    int subId;
+    vtkMath::Subtract(p2, p1, rayDir);
+
+    // Brute force
+    double tMin = VTK_DOUBLE_MAX;
+    std::set<vtkIdType> hitCells;
+    for (vtkIdType cellId = 0; cellId < surface->GetNumberOfCells(); ++cellId)
+    {
+      surface->GetCellBounds(cellId, cellBounds);
+      if (!vtkBox::IntersectBox(cellBounds, p1, rayDir, hitPosition, tBox, 0.0))
+      {
+        continue;
+      }
+      surface->GetCell(cellId, cell);
+      if (cell->IntersectWithLine(p1, p2, 0.0, t, x, pcoords, subId))
+      {
+        tMin = std::min(tMin, t);
+        hitCells.insert(cellId);
+      }
+    }
+
+    vtkIdType cellId = -1;
+    if (locator->IntersectWithLine(p1, p2, 0.0, t, x, pcoords, subId, cellId, cell))
+    {
+      ++numHits;
+      if (t != tMin || !hitCells.count(cellId))
+      {
+        std::cerr << "Segment " << i << " first intersects cell " << cellId << " at t " << t
+                  << " instead of t " << tMin << std::endl;
+        ++numErrors;
+      }
+    }
+    else if (!hitCells.empty())
+    {
+      std::cerr << "Segment " << i << " should intersect the surface" << std::endl;
+      ++numErrors;
+    }
+
+    locator->IntersectWithLine(p1, p2, 0.0, points, cellIds, cell);
+    std::set<vtkIdType> cells(cellIds->begin(), cellIds->end());
+    if (!hitCells.empty() &&
+      (cells != hitCells || cellIds->GetNumberOfIds() != points->GetNumberOfPoints()))
+    {
+      std::cerr << "Segment " << i << " intersects " << cellIds->GetNumberOfIds()
+                << " cells instead of " << hitCells.size() << std::endl;
+      ++numErrors;
+    }
+
+    locator->FindCellsAlongLine(p1, p2, 0.0, cellsAlongLine);
+    for (vtkIdType hitCell : hitCells)
+    {
+      if (cellsAlongLine->IsId(hitCell) < 0)
+      {
+        std::cerr << "Cell " << hitCell << " is missing along segment " << i << std::endl;
+        ++numErrors;
+      }
+    }
+  }
+
+  if (numHits < 50)
+  {
+    std::cerr << "Only " << numHits << " segments intersect the surface" << std::endl;
+    ++numErrors;
+  }
+  return numErrors;
+}
+
+int TestClosestPoints(vtkBVHCellLocator* locator, vtkDataSet* surface)
+{
+  std::vector<double> queries;
+  MakePoints(queries, 200, -1.5, 1.5, 3);
+
+  int numErrors = 0;
+  vtkNew<vtkGenericCell> cell;
+  std::vector<double> weights(surface->GetMaxCellSize());
+  for (int i = 0; i < 200; ++i)
+  {
+    double* x = queries.data() + 3 * i;
+    double closest[3], pcoords[3], dist2;
+    int subId;
+
+    double minDist2 = VTK_DOUBLE_MAX;
+    for (vtkIdType cellId = 0; cellId < surface->GetNumberOfCells(); ++cellId)
+    {
+      surface->GetCell(cellId, cell);
+      if (cell->EvaluatePosition(x, closest, subId, pcoords, dist2, weights.data()) != -1)
+      {
+        minDist2 = std::min(minDist2, dist2);
+      }
+    }
+
+    vtkIdType cellId;
+    locator->FindClosestPoint(x, closest, cell, cellId, subId, dist2);
+    if (dist2 != minDist2)
+    {
+      std::cerr << "Closest point of query " << i << " is at distance " << std::sqrt(dist2)
+                << " instead of " << std::sqrt(minDist2) << std::endl;
+      ++numErrors;
+    }
+  }
+  return numErrors;
+}
+
+int TestCellsWithinBounds(vtkBVHCellLocator* locator, vtkDataSet* surface)
+{
+  int numErrors = 0;
+  vtkNew<vtkIdList> cellIds;
+  double cellBounds[6];
+  for (int i = 0; i < 10; ++i)
+  {
+    double bounds[6] = { -0.5, 0.2, -0.3, 0.4, -1.0, 1.0 };
+    bounds[i % 6] += 0.05 * i;
+    const vtkBoundingBox box(bounds);
+    std::set<vtkIdType> expected;
+    for (vtkIdType cellId = 0; cellId < surface->GetNumberOfCells(); ++cellId)
+    {
+      surface->GetCellBounds(cellId, cellBounds);
+      if (box.Intersects(vtkBoundingBox(cellBounds)))
+      {
+        expected.insert(cellId);
+      }
+    }
+    locator->FindCellsWithinBounds(bounds, cellIds);
+    if (std::set<vtkIdType>(cellIds->begin(), cellIds->end()) != expected ||
+      static_cast<size_t>(cellIds->GetNumberOfIds()) != expected.size())
+    {
+      std::cerr << "Found " << cellIds->GetNumberOfIds() << " cells within bounds " << i
+                << " instead of " << expected.size() << std::endl;
+      ++numErrors;
+    }
+  }
+  return numErrors;
+}
+
+int TestFindCell()
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(21, 16, 11);
+  image->SetSpacing(0.1, 0.2, 0.3);
+  image->SetOrigin(-1.0, -1.5, -1.5);
+
+  vtkNew<vtkBVHCellLocator> locator;
+  locator->SetDataSet(image);
+  locator->BuildLocator();
+
+  std::vector<double> queries;
+  MakePoints(queries, 500, -2.0, 2.0, 11);
+
+  int numErrors = 0;
+  for (int i = 0; i < 500; ++i)
+  {
+    double* x = queries.data() + 3 * i;
+    int ijk[3];
+    double pcoords[3];
+    vtkIdType expected = -1;
+    if (image->ComputeStructuredCoordinates(x, ijk, pcoords))
+    {
+      expected = image->ComputeCellId(ijk);
+    }
+    const vtkIdType cellId = locator->FindCell(x);
+    if (cellId != expected)
+    {
+      std::cerr << "Query " << i << " is in cell " << cellId << " instead of " << expected
+                << std::endl;
+      ++numErrors;
+    }
+  }
+  return numErrors;
+}
+}
+
+int TestBVHCellLocator(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(32);
+  sphere->Update();
+  vtkPolyData* surface = sphere->GetOutput();
+
+  vtkNew<vtkBVHCellLocator> locator;
+  locator->SetDataSet(surface);
+  locator->BuildLocator();
+
+  int numErrors = 0;
+  if (locator->GetLevel() < 2)
+  {
+    std::cerr << "The hierarchy has a depth of " << locator->GetLevel() << std::endl;
+    ++numErrors;
+  }
+
+  numErrors += TestLines(locator, surface);
+  numErrors += TestClosestPoints(locator, surface);
+  numErrors += TestCellsWithinBounds(locator, surface);
+  numErrors += TestFindCell();
+
+  // Cell bounds computed on the fly
+  vtkNew<vtkBVHCellLocator> uncachedLocator;
+  uncachedLocator->CacheCellBoundsOff();
+  uncachedLocator->SetDataSet(surface);
+  numErrors += TestLines(uncachedLocator, surface);
+
+  // A shallow copy shares the hierarchy.
+  vtkNew<vtkBVHCellLocator> copy;
+  copy->SetDataSet(surface);
+  copy->ShallowCopy(locator);
+  numErrors += TestLines(copy, surface);
+  numErrors += TestClosestPoints(copy, surface);
+
+  // The leaves contain all the cells.
+  vtkNew<vtkPolyData> representation;
+  locator->GenerateRepresentation(-1, representation);
+  if (representation->GetNumberOfPolys() < 6 * surface->GetNumberOfCells() / 4)
+  {
+    std::cerr << "The representation has " << representation->GetNumberOfPolys() << " faces"
+              << std::endl;
+    ++numErrors;
+  }
+
+  return numErrors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
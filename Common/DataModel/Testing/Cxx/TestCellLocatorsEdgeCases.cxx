@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
 // SPDX-License-Identifier: BSD-3-Clause
 
+#include "vtkBVHCellLocator.h"
 #include "vtkCellLocator.h"
 #include "vtkCellTreeLocator.h"
 #include "vtkGenericCell.h"
@@ -132,6 +133,8 @@ int TestCellLocatorsEdgeCases(int argc, char* argv[])
   allTestsPassed &= TestLocator(data, scl);
   vtkNew<vtkCellTreeLocator> ctl;
   allTestsPassed &= TestLocator(data, ctl);
+  vtkNew<vtkBVHCellLocator> bvh;
+  allTestsPassed &= TestLocator(data, bvh);
   // can't test vtkModifiedBSPTree because of the peculiarities
   // of how this test is executed
   // vtkNew<vtkModifiedBSPTree> mbsp;
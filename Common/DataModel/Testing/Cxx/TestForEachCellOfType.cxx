@@ -0,0 +1,249 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that vtk::ForEachCellOfType and vtk::ForEachCellOfTypes visit the
+// cells of the requested types with the same points as vtkUnstructuredGrid::GetCell.
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkForEachCellOfType.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkSMPTools.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <atomic>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+// A grid of hexahedra split into tetrahedra, wedges and hexahedra, with a
+// triangle on one face of each of the hexahedra.
+void MakeGrid(vtkUnstructuredGrid* grid, int dataType)
+{
+  const int n = 6;
+  vtkNew<vtkPoints> points;
+  points->SetDataType(dataType);
+  for (int k = 0; k <= n; ++k)
+  {
+    for (int j = 0; j <= n; ++j)
+    {
+      for (int i = 0; i <= n; ++i)
+      {
+        points->InsertNextPoint(i + 0.1 * j, j + 0.01 * k, k + 0.2 * i);
+      }
+    }
+  }
+  grid->SetPoints(points);
+
+  auto id = [&](int i, int j, int k)
+  { return static_cast<vtkIdType>(i + (n + 1) * (j + (n + 1) * k)); };
+  grid->AllocateEstimate(4 * n * n * n, 8);
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        const vtkIdType h[8] = { id(i, j, k), id(i + 1, j, k), id(i + 1, j + 1, k), id(i, j + 1, k),
+          id(i, j, k + 1), id(i + 1, j, k + 1), id(i + 1, j + 1, k + 1), id(i, j + 1, k + 1) };
+        switch ((i + j + k) % 3)
+        {
+          case 0:
+          {
+            grid->InsertNextCell(VTK_HEXAHEDRON, 8, h);
+            const vtkIdType t[3] = { h[0], h[1], h[2] };
+            grid->InsertNextCell(VTK_TRIANGLE, 3, t);
+            break;
+          }
+          case 1:
+          {
+            const vtkIdType w1[6] = { h[0], h[1], h[3], h[4], h[5], h[7] };
+            const vtkIdType w2[6] = { h[1], h[2], h[3], h[5], h[6], h[7] };
+            grid->InsertNextCell(VTK_WEDGE, 6, w1);
+            grid->InsertNextCell(VTK_WEDGE, 6, w2);
+            break;
+          }
+          default:
+          {
+            const vtkIdType t[5][4] = { { h[0], h[1], h[3], h[4] }, { h[1], h[2], h[3], h[6] },
+              { h[1], h[4], h[5], h[6] }, { h[3], h[4], h[6], h[7] }, { h[1], h[3], h[4], h[6] } };
+            for (const auto& tetra : t)
+            {
+              grid->InsertNextCell(VTK_TETRA, 4, tetra);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+// Check one visited cell against GetCell.
+template <typename PointIdsT, typename PointsT>
+int CheckCell(vtkUnstructuredGrid* grid, int cellType, vtkIdType cellId, const PointIdsT& pointIds,
+  const PointsT& points, vtkGenericCell* cell)
+{
+  grid->GetCell(cellId, cell);
+  if (cell->GetCellType() != cellType ||
+    static_cast<vtkIdType>(pointIds.size()) != cell->GetNumberOfPoints())
+  {
+    std::cerr << "Cell " << cellId << " of type " << cell->GetCellType()
+              << " is visited as a cell of type " << cellType << std::endl;
+    return 1;
+  }
+  for (vtkIdType i = 0; i < cell->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    cell->GetPoints()->GetPoint(i, x);
+    const auto point = points[pointIds[i]];
+    if (pointIds[i] != cell->GetPointId(i) || point[0] != x[0] || point[1] != x[1] ||
+      point[2] != x[2])
+    {
+      std::cerr << "Wrong point " << i << " of cell " << cellId << std::endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+template <int CellType>
+int TestCellType(vtkUnstructuredGrid* grid)
+{
+  int numErrors = 0;
+  vtkNew<vtkGenericCell> cell;
+  std::vector<vtkIdType> visited;
+  vtk::ForEachCellOfType<CellType>(grid,
+    [&](vtkIdType cellId, const auto& pointIds, const auto& points)
+    {
+      visited.push_back(cellId);
+      numErrors += CheckCell(grid, CellType, cellId, pointIds, points, cell);
+    });
+
+  std::vector<vtkIdType> expected;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    if (grid->GetCellType(cellId) == CellType)
+    {
+      expected.push_back(cellId);
+    }
+  }
+  if (visited != expected)
+  {
+    std::cerr << "Visited " << visited.size() << " cells of type " << CellType << " instead of "
+              << expected.size() << std::endl;
+    ++numErrors;
+  }
+
+  // A range of cells, processed concurrently
+  const vtkIdType begin = grid->GetNumberOfCells() / 3;
+  const vtkIdType end = 2 * grid->GetNumberOfCells() / 3;
+  std::atomic<vtkIdType> numVisited(0);
+  vtkSMPTools::For(begin, end,
+    [&](vtkIdType first, vtkIdType last)
+    {
+      vtk::ForEachCellOfType<CellType>(grid, first, last,
+        [&](vtkIdType cellId, const auto&, const auto&)
+        {
+          if (cellId >= begin && cellId < end)
+          {
+            ++numVisited;
+          }
+        });
+    });
+  vtkIdType numExpected = 0;
+  for (const vtkIdType cellId : expected)
+  {
+    numExpected += cellId >= begin && cellId < end ? 1 : 0;
+  }
+  if (numVisited != numExpected)
+  {
+    std::cerr << "Visited " << numVisited << " cells of type " << CellType << " in ["
+              << begin << ", " << end << ") instead of " << numExpected << std::endl;
+    ++numErrors;
+  }
+  return numErrors;
+}
+
+int TestGrid(vtkUnstructuredGrid* grid)
+{
+  int numErrors = 0;
+  numErrors += TestCellType<VTK_TETRA>(grid);
+  numErrors += TestCellType<VTK_HEXAHEDRON>(grid);
+  numErrors += TestCellType<VTK_WEDGE>(grid);
+  numErrors += TestCellType<VTK_TRIANGLE>(grid);
+  numErrors += TestCellType<VTK_PYRAMID>(grid);
+
+  // Mixed types, grouped by type
+  vtkNew<vtkGenericCell> cell;
+  std::vector<int> types;
+  vtkIdType numVisited = 0;
+  vtk::ForEachCellOfTypes<VTK_WEDGE, VTK_TETRA, VTK_HEXAHEDRON>(grid,
+    [&](auto cellType, vtkIdType cellId, const auto& pointIds, const auto& points)
+    {
+      if (types.empty() || types.back() != cellType)
+      {
+        types.push_back(cellType);
+      }
+      ++numVisited;
+      numErrors += CheckCell(grid, decltype(cellType)::value, cellId, pointIds, points, cell);
+    });
+  vtkIdType numExpected = 0;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    numExpected += grid->GetCellType(cellId) != VTK_TRIANGLE ? 1 : 0;
+  }
+  if (types != std::vector<int>{ VTK_WEDGE, VTK_TETRA, VTK_HEXAHEDRON } ||
+    numVisited != numExpected)
+  {
+    std::cerr << "The cells are not grouped by type" << std::endl;
+    ++numErrors;
+  }
+  return numErrors;
+}
+}
+
+int TestForEachCellOfType(int, char*[])
+{
+  int numErrors = 0;
+  for (int dataType : { VTK_FLOAT, VTK_DOUBLE })
+  {
+    vtkNew<vtkUnstructuredGrid> grid;
+    MakeGrid(grid, dataType);
+    numErrors += TestGrid(grid);
+    grid->GetCells()->ConvertTo32BitStorage();
+    numErrors += TestGrid(grid);
+  }
+
+  // Points that are accessed through the vtkDataArray API
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid, VTK_DOUBLE);
+  vtkNew<vtkSOADataArrayTemplate<double>> soaPoints;
+  soaPoints->DeepCopy(grid->GetPoints()->GetData());
+  grid->GetPoints()->SetData(soaPoints);
+  numErrors += TestGrid(grid);
+
+  // Cells of a single type
+  vtkNew<vtkUnstructuredGrid> tetras;
+  tetras->SetPoints(grid->GetPoints());
+  vtkNew<vtkCellArray> cells;
+  vtkNew<vtkIdList> pointIds;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    if (grid->GetCellType(cellId) == VTK_TETRA)
+    {
+      grid->GetCellPoints(cellId, pointIds);
+      cells->InsertNextCell(pointIds);
+    }
+  }
+  cells->ConvertToFixedSize64BitStorage();
+  tetras->SetCells(VTK_TETRA, cells);
+  numErrors += TestCellType<VTK_TETRA>(tetras);
+  numErrors += TestCellType<VTK_HEXAHEDRON>(tetras);
+
+  return numErrors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the batched queries of the point and cell locators return the
+// same results as the corresponding single queries.
+
+#include "vtkCellLocator.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkStaticPointLocator.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+// Query points scattered in and around the grid.
+void MakeQueryPoints(vtkPoints* points, vtkIdType numPoints)
+{
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPoints);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+  {
+    points->SetPoint(i, -1.0 + 12.0 * std::fmod(i * 0.618034, 1.0),
+      -1.0 + 12.0 * std::fmod(i * 0.414214, 1.0), -1.0 + 12.0 * std::fmod(i * 0.732051, 1.0));
+  }
+}
+
+int TestPointLocator(vtkAbstractPointLocator* locator, vtkPoints* queries)
+{
+  const int N = 5;
+  vtkNew<vtkIdList> closest;
+  vtkNew<vtkIdTypeArray> closestN;
+  locator->FindClosestPoints(queries, closest);
+  locator->FindClosestPoints(N, queries, closestN);
+
+  int numErrors = 0;
+  vtkNew<vtkIdList> ids;
+  double x[3];
+  for (vtkIdType i = 0; i < queries->GetNumberOfPoints(); ++i)
+  {
+    queries->GetPoint(i, x);
+    if (closest->GetId(i) != locator->FindClosestPoint(x))
+    {
+      std::cerr << locator->GetClassName() << ": wrong closest point of query " << i << std::endl;
+      ++numErrors;
+    }
+    locator->FindClosestNPoints(N, x, ids);
+    for (int j = 0; j < N; ++j)
+    {
+      if (closestN->GetTypedComponent(i, j) != ids->GetId(j))
+      {
+        std::cerr << locator->GetClassName() << ": wrong closest point " << j << " of query " << i
+                  << std::endl;
+        ++numErrors;
+      }
+    }
+  }
+  return numErrors;
+}
+
+int TestCellLocator(vtkAbstractCellLocator* locator, vtkPoints* queries)
+{
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkDoubleArray> pcoords;
+  locator->FindCells(queries, 0.0, cellIds, pcoords);
+
+  vtkNew<vtkIdList> closestCellIds;
+  vtkNew<vtkPoints> closestPoints;
+  closestPoints->SetDataTypeToDouble();
+  vtkNew<vtkDoubleArray> dist2;
+  locator->FindClosestPoints(queries, closestCellIds, closestPoints, dist2);
+
+  // Segments from the query points towards the center of the grid.
+  vtkNew<vtkPoints> endPoints;
+  endPoints->SetNumberOfPoints(queries->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < queries->GetNumberOfPoints(); ++i)
+  {
+    endPoints->SetPoint(i, 5.0, 5.0, 5.0);
+  }
+  vtkNew<vtkIdList> lineCellIds;
+  vtkNew<vtkDoubleArray> ts;
+  vtkNew<vtkPoints> intersections;
+  intersections->SetDataTypeToDouble();
+  locator->IntersectWithLines(queries, endPoints, 0.0, lineCellIds, ts, intersections);
+
+  int numErrors = 0;
+  vtkNew<vtkGenericCell> cell;
+  std::vector<double> weights(8);
+  for (vtkIdType i = 0; i < queries->GetNumberOfPoints(); ++i)
+  {
+    double x[3], pc[3], closest[3], d2, t, p[3];
+    int subId;
+    queries->GetPoint(i, x);
+    const vtkIdType cellId = locator->FindCell(x, 0.0, cell, subId, pc, weights.data());
+    if (cellIds->GetId(i) != cellId ||
+      (cellId >= 0 && vtkMath::Distance2BetweenPoints(pc, pcoords->GetTuple3(i)) != 0.0))
+    {
+      std::cerr << locator->GetClassName() << ": wrong cell containing query " << i << std::endl;
+      ++numErrors;
+    }
+
+    vtkIdType closestCellId;
+    locator->FindClosestPoint(x, closest, cell, closestCellId, subId, d2);
+    closestPoints->GetPoint(i, p);
+    if (closestCellIds->GetId(i) != closestCellId || dist2->GetValue(i) != d2 ||
+      vtkMath::Distance2BetweenPoints(closest, p) != 0.0)
+    {
+      std::cerr << locator->GetClassName() << ": wrong closest cell of query " << i << std::endl;
+      ++numErrors;
+    }
+
+    vtkIdType lineCellId = -1;
+    const double end[3] = { 5.0, 5.0, 5.0 };
+    if (locator->IntersectWithLine(x, end, 0.0, t, closest, pc, subId, lineCellId, cell))
+    {
+      intersections->GetPoint(i, p);
+      if (lineCellIds->GetId(i) != lineCellId || ts->GetValue(i) != t ||
+        vtkMath::Distance2BetweenPoints(closest, p) != 0.0)
+      {
+        std::cerr << locator->GetClassName() << ": wrong intersection of segment " << i
+                  << std::endl;
+        ++numErrors;
+      }
+    }
+    else if (lineCellIds->GetId(i) != -1 || ts->GetValue(i) != VTK_DOUBLE_MAX)
+    {
+      std::cerr << locator->GetClassName() << ": segment " << i << " should not intersect"
+                << std::endl;
+      ++numErrors;
+    }
+  }
+  return numErrors;
+}
+}
+
+int TestLocatorBatchedQueries(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(11, 11, 11);
+
+  vtkNew<vtkPoints> queries;
+  MakeQueryPoints(queries, 2000);
+
+  int numErrors = 0;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 4 },
+    [&]()
+    {
+      vtkNew<vtkStaticPointLocator> staticPointLocator;
+      staticPointLocator->SetDataSet(image);
+      numErrors += TestPointLocator(staticPointLocator, queries);
+
+      vtkNew<vtkPointLocator> pointLocator;
+      pointLocator->SetDataSet(image);
+      numErrors += TestPointLocator(pointLocator, queries);
+
+      vtkNew<vtkStaticCellLocator> staticCellLocator;
+      staticCellLocator->SetDataSet(image);
+      numErrors += TestCellLocator(staticCellLocator, queries);
+
+      vtkNew<vtkCellLocator> cellLocator;
+      cellLocator->SetDataSet(image);
+      numErrors += TestCellLocator(cellLocator, queries);
+    });
+
+  return numErrors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
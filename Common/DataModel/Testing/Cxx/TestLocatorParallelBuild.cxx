@@ -0,0 +1,327 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that vtkCellLocator, vtkKdTree and vtkOctreePointLocator build the
+// same structures whatever the number of threads, and that inserting appended
+// points in a vtkOctreePointLocator gives the same octree as a new build.
+// Empty cells must not be inserted in the vtkCellLocator.
+
+#include "vtkCellLocator.h"
+#include "vtkCellType.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkKdTree.h"
+#include "vtkNew.h"
+#include "vtkOctreePointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+// Points scattered in [0, 1]^3, denser near the origin.
+void AddPoints(vtkPoints* points, vtkIdType numPoints, double scale)
+{
+  const vtkIdType start = points->GetNumberOfPoints();
+  for (vtkIdType i = start; i < start + numPoints; ++i)
+  {
+    const double x = std::fmod(i * 0.618034, 1.0);
+    const double y = std::fmod(i * 0.414214, 1.0);
+    const double z = std::fmod(i * 0.732051, 1.0);
+    points->InsertNextPoint(scale * x * x, scale * y, scale * z * z);
+  }
+}
+
+// Region bounds and contents of an octree.
+std::vector<double> DescribeOctree(vtkOctreePointLocator* locator)
+{
+  std::vector<double> description;
+  double bounds[6];
+  for (int region = 0; region < locator->GetNumberOfLeafNodes(); ++region)
+  {
+    locator->GetRegionBounds(region, bounds);
+    description.insert(description.end(), bounds, bounds + 6);
+    vtkIdTypeArray* ids = locator->GetPointsInRegion(region);
+    description.push_back(static_cast<double>(ids->GetNumberOfTuples()));
+    for (vtkIdType i = 0; i < ids->GetNumberOfTuples(); ++i)
+    {
+      description.push_back(static_cast<double>(ids->GetValue(i)));
+    }
+    ids->Delete();
+  }
+  return description;
+}
+
+// Region bounds and cell lists of a k-d tree built from cells.
+std::vector<double> DescribeKdTree(vtkKdTree* kdTree)
+{
+  std::vector<double> description;
+  double bounds[6];
+  kdTree->CreateCellLists();
+  for (int region = 0; region < kdTree->GetNumberOfRegions(); ++region)
+  {
+    kdTree->GetRegionBounds(region, bounds);
+    description.insert(description.end(), bounds, bounds + 6);
+    vtkIdList* cells = kdTree->GetCellList(region);
+    description.push_back(static_cast<double>(cells->GetNumberOfIds()));
+    description.insert(description.end(), cells->begin(), cells->end());
+  }
+  return description;
+}
+
+// Points of each region of a k-d tree built from points.
+std::vector<double> DescribePointKdTree(vtkKdTree* kdTree)
+{
+  std::vector<double> description;
+  for (int region = 0; region < kdTree->GetNumberOfRegions(); ++region)
+  {
+    vtkIdTypeArray* ids = kdTree->GetPointsInRegion(region);
+    description.push_back(static_cast<double>(ids->GetNumberOfTuples()));
+    for (vtkIdType i = 0; i < ids->GetNumberOfTuples(); ++i)
+    {
+      description.push_back(static_cast<double>(ids->GetValue(i)));
+    }
+    ids->Delete();
+  }
+  return description;
+}
+
+// Cells found in boxes scattered in the grid, in the order of the locator.
+std::vector<double> DescribeCellLocator(vtkCellLocator* locator)
+{
+  std::vector<double> description;
+  vtkNew<vtkIdList> cells;
+  for (int i = 0; i < 50; ++i)
+  {
+    const double x = 20.0 * std::fmod(i * 0.618034, 1.0);
+    const double y = 20.0 * std::fmod(i * 0.414214, 1.0);
+    const double z = 20.0 * std::fmod(i * 0.732051, 1.0);
+    double bounds[6] = { x, x + 2.5, y, y + 1.5, z, z + 3.5 };
+    locator->FindCellsWithinBounds(bounds, cells);
+    description.push_back(static_cast<double>(cells->GetNumberOfIds()));
+    description.insert(description.end(), cells->begin(), cells->end());
+  }
+  return description;
+}
+
+int Compare(const std::vector<double>& serial, const std::vector<double>& parallel,
+  const char* name)
+{
+  if (serial.size() < 2 || serial != parallel)
+  {
+    std::cerr << name << " differs between the builds" << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+std::vector<double> BuildOctree(vtkPolyData* cloud, int numberOfThreads)
+{
+  std::vector<double> description;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ numberOfThreads },
+    [&]()
+    {
+      vtkNew<vtkOctreePointLocator> locator;
+      locator->SetMaximumPointsPerRegion(50);
+      locator->SetDataSet(cloud);
+      locator->BuildLocator();
+      description = DescribeOctree(locator);
+    });
+  return description;
+}
+
+std::vector<double> BuildKdTree(vtkImageData* grid, int numberOfThreads)
+{
+  std::vector<double> description;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ numberOfThreads },
+    [&]()
+    {
+      vtkNew<vtkKdTree> kdTree;
+      kdTree->SetMinCells(20);
+      kdTree->AddDataSet(grid);
+      kdTree->BuildLocator();
+      description = DescribeKdTree(kdTree);
+    });
+  return description;
+}
+
+std::vector<double> BuildPointKdTree(vtkPoints* points, int numberOfThreads)
+{
+  std::vector<double> description;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ numberOfThreads },
+    [&]()
+    {
+      vtkNew<vtkKdTree> kdTree;
+      kdTree->BuildLocatorFromPoints(points);
+      description = DescribePointKdTree(kdTree);
+    });
+  return description;
+}
+
+std::vector<double> BuildCellLocator(vtkImageData* grid, int numberOfThreads)
+{
+  std::vector<double> description;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ numberOfThreads },
+    [&]()
+    {
+      vtkNew<vtkCellLocator> locator;
+      locator->SetDataSet(grid);
+      locator->BuildLocator();
+      description = DescribeCellLocator(locator);
+    });
+  return description;
+}
+
+// Triangles in the z = 0 plane with empty cells in between, the first cell
+// being empty.
+vtkSmartPointer<vtkUnstructuredGrid> MakeGridWithEmptyCells()
+{
+  const int n = 20;
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j <= n; ++j)
+  {
+    for (int i = 0; i <= n; ++i)
+    {
+      points->InsertNextPoint(i, 0.5 * j, 0.0);
+    }
+  }
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->AllocateEstimate(2 * n * n, 3);
+  for (int j = 0; j < n; ++j)
+  {
+    for (int i = 0; i < n; ++i)
+    {
+      if ((i + j) % 7 == 0)
+      {
+        grid->InsertNextCell(VTK_EMPTY_CELL, 0, nullptr);
+      }
+      const vtkIdType p0 = i + (n + 1) * j;
+      const vtkIdType t0[3] = { p0, p0 + 1, p0 + n + 2 };
+      const vtkIdType t1[3] = { p0, p0 + n + 2, p0 + n + 1 };
+      grid->InsertNextCell(VTK_TRIANGLE, 3, t0);
+      grid->InsertNextCell(VTK_TRIANGLE, 3, t1);
+    }
+  }
+  return grid;
+}
+
+int TestEmptyCells(int numberOfThreads)
+{
+  auto grid = MakeGridWithEmptyCells();
+  int numErrors = 0;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ numberOfThreads },
+    [&]()
+    {
+      vtkNew<vtkCellLocator> locator;
+      locator->SetNumberOfCellsPerNode(4);
+      locator->SetDataSet(grid);
+      locator->BuildLocator();
+
+      vtkNew<vtkIdList> cells;
+      locator->FindCellsWithinBounds(grid->GetBounds(), cells);
+      vtkIdType numNonEmptyCells = 0;
+      for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+      {
+        numNonEmptyCells += grid->GetCellType(cellId) != VTK_EMPTY_CELL ? 1 : 0;
+      }
+      if (cells->GetNumberOfIds() != numNonEmptyCells)
+      {
+        std::cerr << "Found " << cells->GetNumberOfIds() << " cells instead of "
+                  << numNonEmptyCells << " with " << numberOfThreads << " threads" << std::endl;
+        ++numErrors;
+      }
+      for (const vtkIdType cellId : *cells)
+      {
+        if (grid->GetCellType(cellId) == VTK_EMPTY_CELL)
+        {
+          std::cerr << "Empty cell " << cellId << " is in the locator" << std::endl;
+          ++numErrors;
+          break;
+        }
+      }
+    });
+  return numErrors;
+}
+
+int TestAppendedPoints(double scale)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  AddPoints(points, 20000, 1.0);
+  // Make sure the appended points fit in the bounds of the first ones.
+  points->InsertNextPoint(0.0, 0.0, 0.0);
+  points->InsertNextPoint(1.0, 1.0, 1.0);
+  vtkNew<vtkPolyData> cloud;
+  cloud->SetPoints(points);
+
+  vtkNew<vtkOctreePointLocator> locator;
+  locator->SetMaximumPointsPerRegion(50);
+  locator->SetDataSet(cloud);
+  locator->BuildLocator();
+
+  AddPoints(points, 5000, scale);
+  points->Modified();
+  locator->BuildLocator();
+
+  vtkNew<vtkOctreePointLocator> newLocator;
+  newLocator->SetMaximumPointsPerRegion(50);
+  newLocator->SetDataSet(cloud);
+  newLocator->BuildLocator();
+
+  int numErrors =
+    Compare(DescribeOctree(newLocator), DescribeOctree(locator), "vtkOctreePointLocator update");
+  if (locator->GetLevel() != newLocator->GetLevel())
+  {
+    std::cerr << "The updated octree has " << locator->GetLevel() << " levels instead of "
+              << newLocator->GetLevel() << std::endl;
+    ++numErrors;
+  }
+
+  double x[3] = { 0.3, 0.6, 0.2 };
+  for (vtkIdType i = 0; i < 100; ++i, x[0] = std::fmod(x[0] + 0.618034, 1.0))
+  {
+    if (locator->FindClosestPoint(x) != newLocator->FindClosestPoint(x))
+    {
+      std::cerr << "Wrong closest point after the update" << std::endl;
+      ++numErrors;
+    }
+  }
+  return numErrors;
+}
+}
+
+int TestLocatorParallelBuild(int, char*[])
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  AddPoints(points, 100000, 1.0);
+  vtkNew<vtkPolyData> cloud;
+  cloud->SetPoints(points);
+
+  vtkNew<vtkImageData> grid;
+  grid->SetDimensions(31, 21, 26);
+  grid->SetSpacing(0.7, 1.0, 0.8);
+
+  int numErrors = 0;
+  numErrors += Compare(BuildOctree(cloud, 1), BuildOctree(cloud, 4), "vtkOctreePointLocator");
+  numErrors += Compare(BuildKdTree(grid, 1), BuildKdTree(grid, 4), "vtkKdTree");
+  numErrors +=
+    Compare(BuildPointKdTree(points, 1), BuildPointKdTree(points, 4), "vtkKdTree from points");
+  numErrors += Compare(BuildCellLocator(grid, 1), BuildCellLocator(grid, 4), "vtkCellLocator");
+  numErrors += TestEmptyCells(1);
+  numErrors += TestEmptyCells(4);
+
+  // Appended points within the bounds of the octree, then outside of them.
+  numErrors += TestAppendedPoints(1.0);
+  numErrors += TestAppendedPoints(1.5);
+
+  return numErrors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -6,6 +6,7 @@
 #include "vtkCellArray.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
@@ -13,11 +14,47 @@
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
-//------------------------------------------------------------------------------
+#include <algorithm>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+// Answer batched queries concurrently, with a generic cell and weights per
+// thread. The first query is answered serially to trigger the non-thread
+// safe initialization of the locator and of the dataset.
+template <typename TQuery>
+void AnswerQueries(vtkIdType numQueries, vtkIdType maxCellSize, TQuery&& query)
+{
+  if (numQueries == 0)
+  {
+    return;
+  }
+  vtkNew<vtkGenericCell> cell;
+  std::vector<double> weights(maxCellSize);
+  query(0, cell.GetPointer(), weights.data());
+
+  vtkSMPThreadLocalObject<vtkGenericCell> threadCell;
+  vtkSMPThreadLocal<std::vector<double>> threadWeights(weights);
+  vtkSMPTools::For(1, numQueries,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkGenericCell* localCell = threadCell.Local();
+      double* localWeights = threadWeights.Local().data();
+      for (vtkIdType queryId = begin; queryId < end; ++queryId)
+      {
+        query(queryId, localCell, localWeights);
+      }
+    });
+}
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
 vtkAbstractCellLocator::vtkAbstractCellLocator()
 {
   this->CacheCellBounds = 1;
@@ -260,6 +297,150 @@ vtkIdType vtkAbstractCellLocator::FindCell(
   return returnVal;
 }
 
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::FindCells(
+  vtkPoints* queryPoints, double tol2, vtkIdList* cellIds, vtkDoubleArray* pcoords)
+{
+  if (!queryPoints || !cellIds)
+  {
+    vtkErrorMacro(<< "FindCells: query points and cell ids are required");
+    return;
+  }
+  const vtkIdType numQueries = queryPoints->GetNumberOfPoints();
+  cellIds->SetNumberOfIds(numQueries);
+  if (pcoords)
+  {
+    pcoords->SetNumberOfComponents(3);
+    pcoords->SetNumberOfTuples(numQueries);
+  }
+  if (!this->DataSet)
+  {
+    std::fill_n(cellIds->GetPointer(0), numQueries, -1);
+    return;
+  }
+
+  this->BuildLocator();
+  AnswerQueries(numQueries, this->DataSet->GetMaxCellSize(),
+    [&](vtkIdType queryId, vtkGenericCell* cell, double* weights)
+    {
+      double x[3], pc[3] = { 0.0, 0.0, 0.0 };
+      int subId;
+      queryPoints->GetPoint(queryId, x);
+      cellIds->SetId(queryId, this->FindCell(x, tol2, cell, subId, pc, weights));
+      if (pcoords)
+      {
+        pcoords->SetTypedTuple(queryId, pc);
+      }
+    });
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::FindClosestPoints(
+  vtkPoints* queryPoints, vtkIdList* cellIds, vtkPoints* closestPoints, vtkDoubleArray* dist2)
+{
+  if (!queryPoints || !cellIds)
+  {
+    vtkErrorMacro(<< "FindClosestPoints: query points and cell ids are required");
+    return;
+  }
+  const vtkIdType numQueries = queryPoints->GetNumberOfPoints();
+  cellIds->SetNumberOfIds(numQueries);
+  if (closestPoints)
+  {
+    closestPoints->SetNumberOfPoints(numQueries);
+  }
+  if (dist2)
+  {
+    dist2->SetNumberOfComponents(1);
+    dist2->SetNumberOfTuples(numQueries);
+  }
+  if (!this->DataSet)
+  {
+    std::fill_n(cellIds->GetPointer(0), numQueries, -1);
+    return;
+  }
+
+  this->BuildLocator();
+  AnswerQueries(numQueries, 0,
+    [&](vtkIdType queryId, vtkGenericCell* cell, double*)
+    {
+      double x[3], closest[3], d2 = VTK_DOUBLE_MAX;
+      vtkIdType cellId = -1;
+      int subId;
+      queryPoints->GetPoint(queryId, x);
+      this->FindClosestPoint(x, closest, cell, cellId, subId, d2);
+      cellIds->SetId(queryId, cellId);
+      if (closestPoints)
+      {
+        closestPoints->SetPoint(queryId, cellId < 0 ? x : closest);
+      }
+      if (dist2)
+      {
+        dist2->SetValue(queryId, cellId < 0 ? VTK_DOUBLE_MAX : d2);
+      }
+    });
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::IntersectWithLines(vtkPoints* startPoints, vtkPoints* endPoints,
+  double tol, vtkIdList* cellIds, vtkDoubleArray* ts, vtkPoints* points)
+{
+  if (!startPoints || !endPoints || !cellIds)
+  {
+    vtkErrorMacro(<< "IntersectWithLines: start points, end points and cell ids are required");
+    return;
+  }
+  const vtkIdType numLines = startPoints->GetNumberOfPoints();
+  if (endPoints->GetNumberOfPoints() != numLines)
+  {
+    vtkErrorMacro(<< "IntersectWithLines: " << numLines << " start points but "
+                  << endPoints->GetNumberOfPoints() << " end points");
+    return;
+  }
+  cellIds->SetNumberOfIds(numLines);
+  if (ts)
+  {
+    ts->SetNumberOfComponents(1);
+    ts->SetNumberOfTuples(numLines);
+  }
+  if (points)
+  {
+    points->SetNumberOfPoints(numLines);
+  }
+  if (this->DataSet)
+  {
+    this->BuildLocator();
+  }
+
+  AnswerQueries(numLines, 0,
+    [&](vtkIdType lineId, vtkGenericCell* cell, double*)
+    {
+      double p1[3], p2[3], t, x[3], pcoords[3];
+      int subId;
+      vtkIdType cellId = -1;
+      startPoints->GetPoint(lineId, p1);
+      endPoints->GetPoint(lineId, p2);
+      if (!this->DataSet ||
+        !this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId, cell))
+      {
+        cellId = -1;
+        t = VTK_DOUBLE_MAX;
+        x[0] = p2[0];
+        x[1] = p2[1];
+        x[2] = p2[2];
+      }
+      cellIds->SetId(lineId, cellId);
+      if (ts)
+      {
+        ts->SetValue(lineId, t);
+      }
+      if (points)
+      {
+        points->SetPoint(lineId, x);
+      }
+    });
+}
+
 //------------------------------------------------------------------------------
 bool vtkAbstractCellLocator::InsideCellBounds(double x[3], vtkIdType cell_ID)
 {
@@ -34,6 +34,7 @@
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkCellArray;
+class vtkDoubleArray;
 class vtkGenericCell;
 class vtkIdList;
 class vtkPoints;
@@ -287,6 +288,41 @@ public:
     double pcoords[3], double* weights);
   ///@}
 
+  /**
+   * Find the cell containing each of the given query points concurrently,
+   * as FindCell() does, and store its id in cellIds, or -1 if no cell
+   * contains the point. If given, pcoords is filled with the parametric
+   * coordinates of the query points in their cells. Subclasses may reorder
+   * the queries to improve memory locality, the results are always stored in
+   * the order of the query points. The locator is built if needed.
+   */
+  virtual void FindCells(
+    vtkPoints* queryPoints, double tol2, vtkIdList* cellIds, vtkDoubleArray* pcoords = nullptr);
+
+  /**
+   * Find the closest point on the cells of the dataset to each of the given
+   * query points concurrently, as FindClosestPoint() does, and store the id
+   * of its cell in cellIds. If given, closestPoints and dist2 are filled with
+   * the closest points and their squared distances to the query points.
+   * Subclasses may reorder the queries to improve memory locality, the
+   * results are always stored in the order of the query points. The locator
+   * is built if needed.
+   */
+  virtual void FindClosestPoints(vtkPoints* queryPoints, vtkIdList* cellIds,
+    vtkPoints* closestPoints = nullptr, vtkDoubleArray* dist2 = nullptr);
+
+  /**
+   * Intersect many line segments with the cells of the dataset concurrently.
+   * Segment i goes from startPoints[i] to endPoints[i]. Its intersected cell,
+   * as returned by IntersectWithLine(), is stored in cellIds[i], or -1 if it
+   * intersects no cell. If given, ts and points are filled with the
+   * parametric coordinates along the segments and the intersection points.
+   * For segments intersecting no cell, they hold VTK_DOUBLE_MAX and the end
+   * point of the segment. The locator is built if needed.
+   */
+  virtual void IntersectWithLines(vtkPoints* startPoints, vtkPoints* endPoints, double tol,
+    vtkIdList* cellIds, vtkDoubleArray* ts = nullptr, vtkPoints* points = nullptr);
+
   /**
    * Quickly test if a point is inside the bounds of a particular cell.
    * Some locators cache cell bounds and this function can make use
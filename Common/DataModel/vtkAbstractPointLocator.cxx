@@ -4,6 +4,13 @@
 
 #include "vtkDataSet.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
 
 //------------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
@@ -53,6 +60,82 @@ void vtkAbstractPointLocator::FindPointsWithinRadius(
   this->FindPointsWithinRadius(R, p, result);
 }
 
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindClosestPoints(vtkPoints* queryPoints, vtkIdList* result)
+{
+  if (!queryPoints || !result)
+  {
+    vtkErrorMacro(<< "FindClosestPoints: query points and result are required");
+    return;
+  }
+  const vtkIdType numQueries = queryPoints->GetNumberOfPoints();
+  result->SetNumberOfIds(numQueries);
+  if (numQueries == 0)
+  {
+    return;
+  }
+
+  // The locator is built, if needed, by the first query.
+  double x[3];
+  queryPoints->GetPoint(0, x);
+  result->SetId(0, this->FindClosestPoint(x));
+  vtkSMPTools::For(1, numQueries,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      double query[3];
+      for (vtkIdType queryId = begin; queryId < end; ++queryId)
+      {
+        queryPoints->GetPoint(queryId, query);
+        result->SetId(queryId, this->FindClosestPoint(query));
+      }
+    });
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindClosestPoints(
+  int N, vtkPoints* queryPoints, vtkIdTypeArray* result)
+{
+  if (!queryPoints || !result || N < 1)
+  {
+    vtkErrorMacro(<< "FindClosestPoints: query points, result and N > 0 are required");
+    return;
+  }
+  const vtkIdType numQueries = queryPoints->GetNumberOfPoints();
+  result->SetNumberOfComponents(N);
+  result->SetNumberOfTuples(numQueries);
+  if (numQueries == 0)
+  {
+    return;
+  }
+
+  auto findClosestNPoints = [this, N, result](const double x[3], vtkIdType queryId, vtkIdList* ids)
+  {
+    this->FindClosestNPoints(N, x, ids);
+    const vtkIdType numIds = std::min<vtkIdType>(N, ids->GetNumberOfIds());
+    vtkIdType* tuple = result->GetPointer(queryId * N);
+    std::copy_n(ids->GetPointer(0), numIds, tuple);
+    std::fill(tuple + numIds, tuple + N, -1);
+  };
+
+  // The locator is built, if needed, by the first query.
+  vtkNew<vtkIdList> ids;
+  double x[3];
+  queryPoints->GetPoint(0, x);
+  findClosestNPoints(x, 0, ids);
+  vtkSMPThreadLocalObject<vtkIdList> threadIds;
+  vtkSMPTools::For(1, numQueries,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdList* localIds = threadIds.Local();
+      double query[3];
+      for (vtkIdType queryId = begin; queryId < end; ++queryId)
+      {
+        queryPoints->GetPoint(queryId, query);
+        findClosestNPoints(query, queryId, localIds);
+      }
+    });
+}
+
 //------------------------------------------------------------------------------
 void vtkAbstractPointLocator::GetBounds(double* bnds)
 {
@@ -23,6 +23,8 @@
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkIdList;
+class vtkIdTypeArray;
+class vtkPoints;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAbstractPointLocator : public vtkLocator
 {
@@ -78,6 +80,21 @@ public:
   void FindPointsWithinRadius(double R, double x, double y, double z, vtkIdList* result);
   ///@}
 
+  ///@{
+  /**
+   * Batched versions of FindClosestPoint() and FindClosestNPoints(), which
+   * answer the queries concurrently with vtkSMPTools after building the
+   * locator. The first one stores the id of the point closest to each query
+   * point in result. The second one stores the ids of the N closest points,
+   * sorted from closest to farthest, in the N components of the tuple of each
+   * query point, padded with -1 when the dataset has fewer than N points.
+   * Subclasses may reorder the queries to improve memory locality, the
+   * results are always stored in the order of the query points.
+   */
+  virtual void FindClosestPoints(vtkPoints* queryPoints, vtkIdList* result);
+  virtual void FindClosestPoints(int N, vtkPoints* queryPoints, vtkIdTypeArray* result);
+  ///@}
+
   ///@{
   /**
    * Provide an accessor to the bounds. Valid after the locator is built.
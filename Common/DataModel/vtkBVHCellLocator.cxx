@@ -0,0 +1,1201 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkBVHCellLocator.h"
+
+#include "vtkBoundingBox.h"
+#include "vtkBox.h"
+#include "vtkCellArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkBVHCellLocator);
+
+namespace
+{
+// Number of children of a node
+constexpr int BVH_WIDTH = 4;
+// Maximum depth of the binary hierarchy, and therefore of the wide one
+constexpr int BVH_MAX_DEPTH = 64;
+// Each expansion of a node during a traversal pops one entry and pushes at
+// most BVH_WIDTH of them
+constexpr int BVH_STACK_SIZE = (BVH_WIDTH - 1) * BVH_MAX_DEPTH + 1;
+// Number of bins used to evaluate the surface area heuristic
+constexpr int BVH_NUMBER_OF_BINS = 16;
+
+//------------------------------------------------------------------------------
+// A node of the hierarchy. Along axis a, the bounds of the child i are
+// [Origin[a] + Min[a][i] * Scale[a], Origin[a] + Max[a][i] * Scale[a]]. The
+// child is an inner node if Count[i] is 0, and a leaf holding the Count[i]
+// cells starting at Cells[Child[i]] otherwise. Unused children have a Child of -1.
+struct vtkBVHNode
+{
+  float Origin[3];
+  float Scale[3];
+  uint8_t Min[3][BVH_WIDTH];
+  uint8_t Max[3][BVH_WIDTH];
+  vtkIdType Child[BVH_WIDTH];
+  int Count[BVH_WIDTH];
+
+  void GetChildBounds(int i, double bounds[6]) const
+  {
+    for (int a = 0; a < 3; ++a)
+    {
+      bounds[2 * a] = this->Decode(a, this->Min[a][i]);
+      bounds[2 * a + 1] = this->Decode(a, this->Max[a][i]);
+    }
+  }
+
+  double Decode(int a, uint8_t q) const
+  {
+    return static_cast<double>(this->Origin[a]) +
+      static_cast<double>(q) * static_cast<double>(this->Scale[a]);
+  }
+};
+
+// A node of the binary hierarchy, only used during the build.
+struct vtkBVHBuildNode
+{
+  double Bounds[6];
+  vtkIdType Begin;
+  vtkIdType End;
+  vtkIdType Left = -1; // -1 for leaves
+  vtkIdType Right = -1;
+};
+
+// An entry of the traversal stacks: a node, or a leaf if Count > 0, along
+// with a lower bound of the query metric (line parameter or squared distance).
+struct vtkBVHStackEntry
+{
+  vtkIdType Child;
+  int Count;
+  double Key;
+};
+
+//------------------------------------------------------------------------------
+double Area(const double bounds[6])
+{
+  const double dx = bounds[1] - bounds[0];
+  const double dy = bounds[3] - bounds[2];
+  const double dz = bounds[5] - bounds[4];
+  return dx * dy + dy * dz + dz * dx;
+}
+
+void InitializeBounds(double bounds[6])
+{
+  bounds[0] = bounds[2] = bounds[4] = VTK_DOUBLE_MAX;
+  bounds[1] = bounds[3] = bounds[5] = VTK_DOUBLE_MIN;
+}
+
+void AddBounds(double bounds[6], const double other[6])
+{
+  for (int a = 0; a < 3; ++a)
+  {
+    bounds[2 * a] = std::min(bounds[2 * a], other[2 * a]);
+    bounds[2 * a + 1] = std::max(bounds[2 * a + 1], other[2 * a + 1]);
+  }
+}
+
+double Distance2ToBounds(const double x[3], const double bounds[6])
+{
+  double d2 = 0.0;
+  for (int a = 0; a < 3; ++a)
+  {
+    const double d = std::max({ bounds[2 * a] - x[a], 0.0, x[a] - bounds[2 * a + 1] });
+    d2 += d * d;
+  }
+  return d2;
+}
+
+//------------------------------------------------------------------------------
+// Intersect the line origin + t * dir, 0 <= t <= tMax, with the boxes of the
+// children of a node enlarged by pad. Return the bit mask of the children
+// intersected, and set their entry parameters. The loops have a fixed length
+// so that the lanes are processed together.
+int IntersectChildren(const vtkBVHNode& node, const double origin[3], const double invDir[3],
+  double pad, double tMax, double tEntry[BVH_WIDTH])
+{
+  double tNear[BVH_WIDTH], tFar[BVH_WIDTH];
+  for (int i = 0; i < BVH_WIDTH; ++i)
+  {
+    tNear[i] = 0.0;
+    tFar[i] = tMax;
+  }
+  for (int a = 0; a < 3; ++a)
+  {
+    const double o = static_cast<double>(node.Origin[a]) - origin[a];
+    const double s = node.Scale[a];
+    for (int i = 0; i < BVH_WIDTH; ++i)
+    {
+      const double t0 = (o + node.Min[a][i] * s - pad) * invDir[a];
+      const double t1 = (o + node.Max[a][i] * s + pad) * invDir[a];
+      tNear[i] = std::max(tNear[i], std::min(t0, t1));
+      tFar[i] = std::min(tFar[i], std::max(t0, t1));
+    }
+  }
+  int mask = 0;
+  for (int i = 0; i < BVH_WIDTH; ++i)
+  {
+    tEntry[i] = tNear[i];
+    mask |= (tNear[i] <= tFar[i] && node.Child[i] >= 0) << i;
+  }
+  return mask;
+}
+
+// Return the bit mask of the children whose boxes enlarged by pad contain x.
+int ContainingChildren(const vtkBVHNode& node, const double x[3], double pad)
+{
+  bool inside[BVH_WIDTH];
+  for (int i = 0; i < BVH_WIDTH; ++i)
+  {
+    inside[i] = node.Child[i] >= 0;
+  }
+  for (int a = 0; a < 3; ++a)
+  {
+    const double o = static_cast<double>(node.Origin[a]) - x[a];
+    const double s = node.Scale[a];
+    for (int i = 0; i < BVH_WIDTH; ++i)
+    {
+      inside[i] = inside[i] && o + node.Min[a][i] * s - pad <= 0.0 &&
+        o + node.Max[a][i] * s + pad >= 0.0;
+    }
+  }
+  int mask = 0;
+  for (int i = 0; i < BVH_WIDTH; ++i)
+  {
+    mask |= inside[i] << i;
+  }
+  return mask;
+}
+
+// Compute the squared distances from x to the boxes of the children.
+void Distance2ToChildren(const vtkBVHNode& node, const double x[3], double dist2[BVH_WIDTH])
+{
+  for (int i = 0; i < BVH_WIDTH; ++i)
+  {
+    dist2[i] = node.Child[i] >= 0 ? 0.0 : VTK_DOUBLE_MAX;
+  }
+  for (int a = 0; a < 3; ++a)
+  {
+    const double o = static_cast<double>(node.Origin[a]) - x[a];
+    const double s = node.Scale[a];
+    for (int i = 0; i < BVH_WIDTH; ++i)
+    {
+      const double d = std::max({ o + node.Min[a][i] * s, 0.0, -o - node.Max[a][i] * s });
+      dist2[i] += d * d;
+    }
+  }
+}
+
+// Push the selected children on the stack so that the one with the smallest
+// key is on top.
+void PushChildren(const vtkBVHNode& node, int mask, const double keys[BVH_WIDTH],
+  vtkBVHStackEntry* stack, int& top)
+{
+  int order[BVH_WIDTH];
+  int n = 0;
+  for (int i = 0; i < BVH_WIDTH; ++i)
+  {
+    if (mask & (1 << i))
+    {
+      int j = n++;
+      for (; j > 0 && keys[order[j - 1]] < keys[i]; --j)
+      {
+        order[j] = order[j - 1];
+      }
+      order[j] = i;
+    }
+  }
+  for (int j = 0; j < n; ++j)
+  {
+    const int i = order[j];
+    stack[top++] = { node.Child[i], node.Count[i], keys[i] };
+  }
+}
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+// The hierarchy, shared by shallow copies of the locator.
+struct vtkBVHCellLocatorTree
+{
+  std::vector<vtkBVHNode> Nodes; // the root is the first node
+  std::vector<vtkIdType> Cells;  // the cells of the leaves, leaf after leaf
+  double Bounds[6];
+  // Absolute tolerance covering the rounding errors of the box tests
+  double Padding;
+  int Depth;
+  int MaxCellSize;
+
+  void Build(vtkBVHCellLocator* locator);
+  int BuildBinary(vtkBVHCellLocator* locator, const double* cellBounds,
+    std::vector<vtkBVHBuildNode>& binaryNodes);
+  void Collapse(const std::vector<vtkBVHBuildNode>& binaryNodes);
+  void Quantize(vtkBVHNode& node, const double childBounds[BVH_WIDTH][6], int numChildren);
+
+  int IntersectWithLine(vtkBVHCellLocator* locator, const double p1[3], const double p2[3],
+    double tol, double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId,
+    vtkGenericCell* cell) const;
+  int IntersectWithLine(vtkBVHCellLocator* locator, const double p1[3], const double p2[3],
+    double tol, vtkPoints* points, vtkIdList* cellIds, vtkGenericCell* cell) const;
+  vtkIdType FindClosestPointWithinRadius(vtkBVHCellLocator* locator, const double x[3],
+    double radius, double closestPoint[3], vtkGenericCell* cell, vtkIdType& cellId, int& subId,
+    double& dist2, int& inside) const;
+  vtkIdType FindCell(vtkBVHCellLocator* locator, double x[3], vtkGenericCell* cell, int& subId,
+    double pcoords[3], double* weights) const;
+  void FindCellsWithinBounds(vtkBVHCellLocator* locator, double* bbox, vtkIdList* cells) const;
+  void FindCellsAlongPlane(vtkBVHCellLocator* locator, const double o[3], const double n[3],
+    double tol, vtkIdList* cells) const;
+  void GenerateRepresentation(int level, vtkPolyData* pd) const;
+
+  // Set up the traversal of the line p1 + t * (p2 - p1).
+  static void InitializeLine(
+    const double p1[3], const double p2[3], double rayDir[3], double invDir[3])
+  {
+    vtkMath::Subtract(p2, p1, rayDir);
+    for (int a = 0; a < 3; ++a)
+    {
+      invDir[a] = rayDir[a] != 0.0 ? 1.0 / rayDir[a] : VTK_DOUBLE_MAX;
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocatorTree::Build(vtkBVHCellLocator* locator)
+{
+  vtkDataSet* dataSet = locator->DataSet;
+  const vtkIdType numCells = dataSet->GetNumberOfCells();
+  this->MaxCellSize = dataSet->GetMaxCellSize();
+
+  // Use the cached cell bounds if any, compute them otherwise. The first
+  // call to GetCellBounds is made serially to trigger the lazy initialization
+  // of the dataset.
+  std::vector<double> computedBounds;
+  const double* cellBounds = locator->CellBounds;
+  if (!cellBounds)
+  {
+    computedBounds.resize(6 * numCells);
+    dataSet->GetCellBounds(0, computedBounds.data());
+    vtkSMPTools::For(1, numCells,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType cellId = begin; cellId < end; ++cellId)
+        {
+          dataSet->GetCellBounds(cellId, computedBounds.data() + 6 * cellId);
+        }
+      });
+    cellBounds = computedBounds.data();
+  }
+
+  std::vector<vtkBVHBuildNode> binaryNodes;
+  this->Depth = this->BuildBinary(locator, cellBounds, binaryNodes);
+
+  const double* bounds = binaryNodes[0].Bounds;
+  std::copy(bounds, bounds + 6, this->Bounds);
+  double maxCoordinate = 0.0;
+  for (int i = 0; i < 6; ++i)
+  {
+    maxCoordinate = std::max(maxCoordinate, std::abs(bounds[i]));
+  }
+  this->Padding = 1e-12 * maxCoordinate;
+
+  this->Collapse(binaryNodes);
+}
+
+//------------------------------------------------------------------------------
+// Build the binary hierarchy top-down, splitting the cells along the plane
+// minimizing the surface area heuristic among BVH_NUMBER_OF_BINS - 1
+// candidates per axis. Return the depth of the hierarchy.
+int vtkBVHCellLocatorTree::BuildBinary(vtkBVHCellLocator* locator, const double* cellBounds,
+  std::vector<vtkBVHBuildNode>& binaryNodes)
+{
+  const vtkIdType numCells = locator->DataSet->GetNumberOfCells();
+  const vtkIdType cellsPerLeaf = std::max(locator->NumberOfCellsPerNode, 1);
+
+  std::vector<double> centers(3 * numCells);
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        const double* b = cellBounds + 6 * cellId;
+        for (int a = 0; a < 3; ++a)
+        {
+          centers[3 * cellId + a] = 0.5 * (b[2 * a] + b[2 * a + 1]);
+        }
+      }
+    });
+
+  this->Cells.resize(numCells);
+  std::iota(this->Cells.begin(), this->Cells.end(), 0);
+  vtkIdType* cells = this->Cells.data();
+
+  binaryNodes.reserve(2 * (numCells / cellsPerLeaf) + 1);
+  binaryNodes.emplace_back();
+  binaryNodes[0].Begin = 0;
+  binaryNodes[0].End = numCells;
+
+  struct Bin
+  {
+    double Bounds[6];
+    vtkIdType Count;
+  };
+
+  int depth = 0;
+  std::vector<std::pair<vtkIdType, int>> stack{ { 0, 0 } };
+  while (!stack.empty())
+  {
+    const vtkIdType nodeId = stack.back().first;
+    const int level = stack.back().second;
+    stack.pop_back();
+    depth = std::max(depth, level);
+
+    const vtkIdType begin = binaryNodes[nodeId].Begin;
+    const vtkIdType end = binaryNodes[nodeId].End;
+    double nodeBounds[6], centerBounds[6];
+    InitializeBounds(nodeBounds);
+    InitializeBounds(centerBounds);
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      AddBounds(nodeBounds, cellBounds + 6 * cells[i]);
+      const double* c = centers.data() + 3 * cells[i];
+      const double cb[6] = { c[0], c[0], c[1], c[1], c[2], c[2] };
+      AddBounds(centerBounds, cb);
+    }
+    std::copy(nodeBounds, nodeBounds + 6, binaryNodes[nodeId].Bounds);
+
+    const vtkIdType count = end - begin;
+    if (count <= cellsPerLeaf || level >= BVH_MAX_DEPTH)
+    {
+      continue;
+    }
+
+    // Evaluate the cost of the candidate planes of each axis.
+    int bestAxis = -1;
+    int bestPlane = 0;
+    double bestCost = VTK_DOUBLE_MAX;
+    for (int a = 0; a < 3; ++a)
+    {
+      const double lo = centerBounds[2 * a];
+      const double extent = centerBounds[2 * a + 1] - lo;
+      if (!(extent > 0.0))
+      {
+        continue;
+      }
+      const double binScale = BVH_NUMBER_OF_BINS / extent;
+      Bin bins[BVH_NUMBER_OF_BINS];
+      for (Bin& bin : bins)
+      {
+        InitializeBounds(bin.Bounds);
+        bin.Count = 0;
+      }
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const int b = std::min(static_cast<int>((centers[3 * cells[i] + a] - lo) * binScale),
+          BVH_NUMBER_OF_BINS - 1);
+        AddBounds(bins[b].Bounds, cellBounds + 6 * cells[i]);
+        ++bins[b].Count;
+      }
+
+      // Sweep from the right to accumulate the cost of the right sides.
+      double rightCost[BVH_NUMBER_OF_BINS];
+      double sweepBounds[6];
+      InitializeBounds(sweepBounds);
+      vtkIdType sweepCount = 0;
+      for (int b = BVH_NUMBER_OF_BINS - 1; b > 0; --b)
+      {
+        AddBounds(sweepBounds, bins[b].Bounds);
+        sweepCount += bins[b].Count;
+        rightCost[b] = sweepCount ? Area(sweepBounds) * sweepCount : 0.0;
+      }
+      InitializeBounds(sweepBounds);
+      sweepCount = 0;
+      for (int b = 0; b < BVH_NUMBER_OF_BINS - 1; ++b)
+      {
+        AddBounds(sweepBounds, bins[b].Bounds);
+        sweepCount += bins[b].Count;
+        if (sweepCount == 0 || sweepCount == count)
+        {
+          continue;
+        }
+        const double cost = Area(sweepBounds) * sweepCount + rightCost[b + 1];
+        if (cost < bestCost)
+        {
+          bestCost = cost;
+          bestAxis = a;
+          bestPlane = b + 1;
+        }
+      }
+    }
+
+    vtkIdType* middle = nullptr;
+    if (bestAxis >= 0)
+    {
+      const double lo = centerBounds[2 * bestAxis];
+      const double binScale = BVH_NUMBER_OF_BINS / (centerBounds[2 * bestAxis + 1] - lo);
+      middle = std::partition(cells + begin, cells + end,
+        [&](vtkIdType cellId)
+        {
+          return std::min(static_cast<int>((centers[3 * cellId + bestAxis] - lo) * binScale),
+                   BVH_NUMBER_OF_BINS - 1) < bestPlane;
+        });
+    }
+    if (!middle || middle == cells + begin || middle == cells + end)
+    {
+      // The centers coincide: split the cells in two halves.
+      middle = cells + begin + count / 2;
+    }
+
+    const vtkIdType left = static_cast<vtkIdType>(binaryNodes.size());
+    binaryNodes[nodeId].Left = left;
+    binaryNodes[nodeId].Right = left + 1;
+    binaryNodes.emplace_back();
+    binaryNodes.back().Begin = begin;
+    binaryNodes.back().End = middle - cells;
+    binaryNodes.emplace_back();
+    binaryNodes.back().Begin = middle - cells;
+    binaryNodes.back().End = end;
+    stack.emplace_back(left, level + 1);
+    stack.emplace_back(left + 1, level + 1);
+  }
+  return depth;
+}
+
+//------------------------------------------------------------------------------
+// Collapse the binary hierarchy into a hierarchy of nodes with BVH_WIDTH
+// children, by repeatedly replacing the inner child of largest area with its
+// own children.
+void vtkBVHCellLocatorTree::Collapse(const std::vector<vtkBVHBuildNode>& binaryNodes)
+{
+  this->Nodes.clear();
+  this->Nodes.reserve(binaryNodes.size() / (BVH_WIDTH - 1) + 1);
+  this->Nodes.emplace_back();
+
+  // The root of the binary hierarchy may be a leaf. It is then the single
+  // child of the root.
+  std::vector<std::pair<vtkIdType, vtkIdType>> stack{ { 0, 0 } };
+  while (!stack.empty())
+  {
+    const vtkIdType binaryId = stack.back().first;
+    const vtkIdType nodeId = stack.back().second;
+    stack.pop_back();
+
+    vtkIdType children[BVH_WIDTH] = { binaryId };
+    int numChildren = 1;
+    if (binaryNodes[binaryId].Left >= 0)
+    {
+      children[0] = binaryNodes[binaryId].Left;
+      children[1] = binaryNodes[binaryId].Right;
+      numChildren = 2;
+    }
+    while (numChildren < BVH_WIDTH)
+    {
+      int largest = -1;
+      double largestArea = -1.0;
+      for (int i = 0; i < numChildren; ++i)
+      {
+        const vtkBVHBuildNode& child = binaryNodes[children[i]];
+        if (child.Left >= 0 && Area(child.Bounds) > largestArea)
+        {
+          largest = i;
+          largestArea = Area(child.Bounds);
+        }
+      }
+      if (largest < 0)
+      {
+        break;
+      }
+      const vtkBVHBuildNode& child = binaryNodes[children[largest]];
+      children[largest] = child.Left;
+      children[numChildren++] = child.Right;
+    }
+
+    double childBounds[BVH_WIDTH][6];
+    vtkBVHNode node;
+    for (int i = 0; i < BVH_WIDTH; ++i)
+    {
+      node.Child[i] = -1;
+      node.Count[i] = 0;
+      if (i >= numChildren)
+      {
+        continue;
+      }
+      const vtkBVHBuildNode& child = binaryNodes[children[i]];
+      std::copy(child.Bounds, child.Bounds + 6, childBounds[i]);
+      if (child.Left < 0)
+      {
+        node.Child[i] = child.Begin;
+        node.Count[i] = static_cast<int>(child.End - child.Begin);
+      }
+      else
+      {
+        node.Child[i] = static_cast<vtkIdType>(this->Nodes.size());
+        this->Nodes.emplace_back();
+        stack.emplace_back(children[i], node.Child[i]);
+      }
+    }
+    this->Quantize(node, childBounds, numChildren);
+    this->Nodes[nodeId] = node;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Quantize the bounds of the children relative to the bounds of the node. The
+// decoded bounds always contain the exact ones.
+void vtkBVHCellLocatorTree::Quantize(
+  vtkBVHNode& node, const double childBounds[BVH_WIDTH][6], int numChildren)
+{
+  for (int a = 0; a < 3; ++a)
+  {
+    double lo = VTK_DOUBLE_MAX, hi = VTK_DOUBLE_MIN;
+    for (int i = 0; i < numChildren; ++i)
+    {
+      lo = std::min(lo, childBounds[i][2 * a]);
+      hi = std::max(hi, childBounds[i][2 * a + 1]);
+    }
+
+    float origin = static_cast<float>(lo);
+    if (origin > lo)
+    {
+      origin = std::nextafter(origin, -FLT_MAX);
+    }
+    float scale = static_cast<float>((hi - origin) / 255.0);
+    scale = std::max(scale, FLT_MIN);
+    node.Origin[a] = origin;
+    node.Scale[a] = scale;
+    while (node.Decode(a, 255) < hi)
+    {
+      scale = std::nextafter(scale, FLT_MAX);
+      node.Scale[a] = scale;
+    }
+
+    for (int i = 0; i < BVH_WIDTH; ++i)
+    {
+      if (i >= numChildren)
+      {
+        node.Min[a][i] = 255;
+        node.Max[a][i] = 0;
+        continue;
+      }
+      const double qmin = std::floor((childBounds[i][2 * a] - origin) / scale);
+      const double qmax = std::ceil((childBounds[i][2 * a + 1] - origin) / scale);
+      int qlo = static_cast<int>(std::min(std::max(qmin, 0.0), 255.0));
+      int qhi = static_cast<int>(std::min(std::max(qmax, 0.0), 255.0));
+      while (qlo > 0 && node.Decode(a, static_cast<uint8_t>(qlo)) > childBounds[i][2 * a])
+      {
+        --qlo;
+      }
+      while (qhi < 255 && node.Decode(a, static_cast<uint8_t>(qhi)) < childBounds[i][2 * a + 1])
+      {
+        ++qhi;
+      }
+      node.Min[a][i] = static_cast<uint8_t>(qlo);
+      node.Max[a][i] = static_cast<uint8_t>(qhi);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Return the first intersection of the line with the cells. The children are
+// visited from nearest to farthest, and the nodes entered beyond the current
+// intersection are skipped.
+int vtkBVHCellLocatorTree::IntersectWithLine(vtkBVHCellLocator* locator, const double p1[3],
+  const double p2[3], double tol, double& t, double x[3], double pcoords[3], int& subId,
+  vtkIdType& cellId, vtkGenericCell* cell) const
+{
+  double rayDir[3], invDir[3];
+  InitializeLine(p1, p2, rayDir, invDir);
+  const double pad = std::max(tol, static_cast<double>(FLT_EPSILON)) + this->Padding;
+
+  vtkDataSet* dataSet = locator->DataSet;
+  double cellBounds[6], *cellBoundsPtr = cellBounds;
+  double tEntry[BVH_WIDTH], tBest = VTK_DOUBLE_MAX, tHit, hitPosition[3], xHit[3], pcoordsHit[3];
+  int subIdHit;
+  vtkIdType bestCellId = -1;
+
+  std::array<vtkBVHStackEntry, BVH_STACK_SIZE> stack;
+  int top = 0;
+  stack[top++] = { 0, 0, 0.0 };
+  while (top > 0)
+  {
+    const vtkBVHStackEntry entry = stack[--top];
+    if (entry.Key > tBest)
+    {
+      continue;
+    }
+    if (entry.Count == 0)
+    {
+      const vtkBVHNode& node = this->Nodes[entry.Child];
+      const int mask = IntersectChildren(node, p1, invDir, pad, std::min(tBest, 1.0), tEntry);
+      PushChildren(node, mask, tEntry, stack.data(), top);
+      continue;
+    }
+    for (vtkIdType i = entry.Child; i < entry.Child + entry.Count; ++i)
+    {
+      const vtkIdType cId = this->Cells[i];
+      locator->GetCellBounds(cId, cellBoundsPtr);
+      if (!vtkBox::IntersectBox(cellBoundsPtr, p1, rayDir, hitPosition, tHit, tol) ||
+        tHit > tBest)
+      {
+        continue;
+      }
+      dataSet->GetCell(cId, cell);
+      if (cell->IntersectWithLine(p1, p2, tol, tHit, xHit, pcoordsHit, subIdHit) && tHit < tBest)
+      {
+        tBest = tHit;
+        bestCellId = cId;
+        subId = subIdHit;
+        std::copy(xHit, xHit + 3, x);
+        std::copy(pcoordsHit, pcoordsHit + 3, pcoords);
+      }
+    }
+  }
+
+  if (bestCellId < 0)
+  {
+    return 0;
+  }
+  t = tBest;
+  cellId = bestCellId;
+  dataSet->GetCell(cellId, cell);
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkBVHCellLocatorTree::IntersectWithLine(vtkBVHCellLocator* locator, const double p1[3],
+  const double p2[3], double tol, vtkPoints* points, vtkIdList* cellIds,
+  vtkGenericCell* cell) const
+{
+  double rayDir[3], invDir[3];
+  InitializeLine(p1, p2, rayDir, invDir);
+  const double pad = std::max(tol, static_cast<double>(FLT_EPSILON)) + this->Padding;
+
+  struct Intersection
+  {
+    vtkIdType CellId;
+    double X[3];
+    double T;
+  };
+  std::vector<Intersection> intersections;
+
+  vtkDataSet* dataSet = locator->DataSet;
+  double cellBounds[6], *cellBoundsPtr = cellBounds;
+  double tEntry[BVH_WIDTH], tHit, hitPosition[3], xHit[3], pcoords[3];
+  int subId;
+
+  std::array<vtkBVHStackEntry, BVH_STACK_SIZE> stack;
+  int top = 0;
+  stack[top++] = { 0, 0, 0.0 };
+  while (top > 0)
+  {
+    const vtkBVHStackEntry entry = stack[--top];
+    if (entry.Count == 0)
+    {
+      const vtkBVHNode& node = this->Nodes[entry.Child];
+      const int mask = IntersectChildren(node, p1, invDir, pad, 1.0, tEntry);
+      PushChildren(node, mask, tEntry, stack.data(), top);
+      continue;
+    }
+    for (vtkIdType i = entry.Child; i < entry.Child + entry.Count; ++i)
+    {
+      const vtkIdType cId = this->Cells[i];
+      locator->GetCellBounds(cId, cellBoundsPtr);
+      if (!vtkBox::IntersectBox(cellBoundsPtr, p1, rayDir, hitPosition, tHit, tol))
+      {
+        continue;
+      }
+      if (cell)
+      {
+        dataSet->GetCell(cId, cell);
+        if (cell->IntersectWithLine(p1, p2, tol, tHit, xHit, pcoords, subId))
+        {
+          intersections.push_back({ cId, { xHit[0], xHit[1], xHit[2] }, tHit });
+        }
+      }
+      else
+      {
+        intersections.push_back(
+          { cId, { hitPosition[0], hitPosition[1], hitPosition[2] }, tHit });
+      }
+    }
+  }
+
+  if (intersections.empty())
+  {
+    return 0;
+  }
+  std::sort(intersections.begin(), intersections.end(),
+    [](const Intersection& a, const Intersection& b) { return a.T < b.T; });
+  const vtkIdType numIntersections = static_cast<vtkIdType>(intersections.size());
+  if (points)
+  {
+    points->SetNumberOfPoints(numIntersections);
+    for (vtkIdType i = 0; i < numIntersections; ++i)
+    {
+      points->SetPoint(i, intersections[i].X);
+    }
+  }
+  if (cellIds)
+  {
+    cellIds->SetNumberOfIds(numIntersections);
+    for (vtkIdType i = 0; i < numIntersections; ++i)
+    {
+      cellIds->SetId(i, intersections[i].CellId);
+    }
+  }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocatorTree::FindClosestPointWithinRadius(vtkBVHCellLocator* locator,
+  const double x[3], double radius, double closestPoint[3], vtkGenericCell* cell,
+  vtkIdType& closestCellId, int& closestSubId, double& minDist2, int& inside) const
+{
+  vtkDataSet* dataSet = locator->DataSet;
+  std::vector<double> weights(this->MaxCellSize);
+  double cellBounds[6], *cellBoundsPtr = cellBounds;
+  double dist2[BVH_WIDTH], pcoords[3], point[3], d2;
+  int subId, stat;
+  vtkIdType retVal = 0;
+
+  // minimum squared distance to the closest point
+  minDist2 = radius * radius;
+
+  std::array<vtkBVHStackEntry, BVH_STACK_SIZE> stack;
+  int top = 0;
+  stack[top++] = { 0, 0, 0.0 };
+  while (top > 0)
+  {
+    const vtkBVHStackEntry entry = stack[--top];
+    if (entry.Key > minDist2)
+    {
+      continue;
+    }
+    if (entry.Count == 0)
+    {
+      const vtkBVHNode& node = this->Nodes[entry.Child];
+      Distance2ToChildren(node, x, dist2);
+      int mask = 0;
+      for (int i = 0; i < BVH_WIDTH; ++i)
+      {
+        mask |= (dist2[i] <= minDist2) << i;
+      }
+      PushChildren(node, mask, dist2, stack.data(), top);
+      continue;
+    }
+    for (vtkIdType i = entry.Child; i < entry.Child + entry.Count; ++i)
+    {
+      const vtkIdType cId = this->Cells[i];
+      locator->GetCellBounds(cId, cellBoundsPtr);
+      if (Distance2ToBounds(x, cellBoundsPtr) >= minDist2)
+      {
+        continue;
+      }
+      dataSet->GetCell(cId, cell);
+      // stat==(-1) is numerical error; stat==0 means outside; stat=1 means inside.
+      stat = cell->EvaluatePosition(x, point, subId, pcoords, d2, weights.data());
+      if (stat != -1 && d2 < minDist2)
+      {
+        retVal = 1;
+        inside = stat;
+        minDist2 = d2;
+        closestCellId = cId;
+        closestSubId = subId;
+        std::copy(point, point + 3, closestPoint);
+      }
+    }
+  }
+
+  if (retVal)
+  {
+    dataSet->GetCell(closestCellId, cell);
+  }
+  return retVal;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocatorTree::FindCell(vtkBVHCellLocator* locator, double x[3],
+  vtkGenericCell* cell, int& subId, double pcoords[3], double* weights) const
+{
+  vtkDataSet* dataSet = locator->DataSet;
+  double dist2;
+
+  std::array<vtkBVHStackEntry, BVH_STACK_SIZE> stack;
+  int top = 0;
+  stack[top++] = { 0, 0, 0.0 };
+  while (top > 0)
+  {
+    const vtkBVHStackEntry entry = stack[--top];
+    if (entry.Count == 0)
+    {
+      const vtkBVHNode& node = this->Nodes[entry.Child];
+      const int mask = ContainingChildren(node, x, this->Padding);
+      for (int i = 0; i < BVH_WIDTH; ++i)
+      {
+        if (mask & (1 << i))
+        {
+          stack[top++] = { node.Child[i], node.Count[i], 0.0 };
+        }
+      }
+      continue;
+    }
+    for (vtkIdType i = entry.Child; i < entry.Child + entry.Count; ++i)
+    {
+      const vtkIdType cId = this->Cells[i];
+      if (locator->InsideCellBounds(x, cId))
+      {
+        dataSet->GetCell(cId, cell);
+        if (cell->EvaluatePosition(x, nullptr, subId, pcoords, dist2, weights) == 1)
+        {
+          return cId;
+        }
+      }
+    }
+  }
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocatorTree::FindCellsWithinBounds(
+  vtkBVHCellLocator* locator, double* bbox, vtkIdList* cells) const
+{
+  const vtkBoundingBox testBox(bbox);
+  double bounds[6], cellBounds[6], *cellBoundsPtr = cellBounds;
+
+  std::array<vtkBVHStackEntry, BVH_STACK_SIZE> stack;
+  int top = 0;
+  stack[top++] = { 0, 0, 0.0 };
+  while (top > 0)
+  {
+    const vtkBVHStackEntry entry = stack[--top];
+    if (entry.Count == 0)
+    {
+      const vtkBVHNode& node = this->Nodes[entry.Child];
+      for (int i = 0; i < BVH_WIDTH; ++i)
+      {
+        node.GetChildBounds(i, bounds);
+        if (node.Child[i] >= 0 && testBox.Intersects(vtkBoundingBox(bounds)))
+        {
+          stack[top++] = { node.Child[i], node.Count[i], 0.0 };
+        }
+      }
+      continue;
+    }
+    for (vtkIdType i = entry.Child; i < entry.Child + entry.Count; ++i)
+    {
+      const vtkIdType cId = this->Cells[i];
+      locator->GetCellBounds(cId, cellBoundsPtr);
+      if (testBox.Intersects(vtkBoundingBox(cellBoundsPtr)))
+      {
+        cells->InsertNextId(cId);
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocatorTree::FindCellsAlongPlane(vtkBVHCellLocator* locator, const double o[3],
+  const double n[3], double tol, vtkIdList* cells) const
+{
+  double bounds[6], cellBounds[6], *cellBoundsPtr = cellBounds;
+  double origin[3] = { o[0], o[1], o[2] };
+  double normal[3] = { n[0], n[1], n[2] };
+
+  std::array<vtkBVHStackEntry, BVH_STACK_SIZE> stack;
+  int top = 0;
+  stack[top++] = { 0, 0, 0.0 };
+  while (top > 0)
+  {
+    const vtkBVHStackEntry entry = stack[--top];
+    if (entry.Count == 0)
+    {
+      const vtkBVHNode& node = this->Nodes[entry.Child];
+      for (int i = 0; i < BVH_WIDTH; ++i)
+      {
+        if (node.Child[i] < 0)
+        {
+          continue;
+        }
+        // Compare the distance from the center of the box to the plane with
+        // the projection of its half diagonal on the normal.
+        node.GetChildBounds(i, bounds);
+        double distance = 0.0, radius = 0.0;
+        for (int a = 0; a < 3; ++a)
+        {
+          distance += n[a] * (0.5 * (bounds[2 * a] + bounds[2 * a + 1]) - o[a]);
+          radius += 0.5 * std::abs(n[a]) * (bounds[2 * a + 1] - bounds[2 * a]);
+        }
+        if (std::abs(distance) <= radius + tol + this->Padding)
+        {
+          stack[top++] = { node.Child[i], node.Count[i], 0.0 };
+        }
+      }
+      continue;
+    }
+    for (vtkIdType i = entry.Child; i < entry.Child + entry.Count; ++i)
+    {
+      const vtkIdType cId = this->Cells[i];
+      locator->GetCellBounds(cId, cellBoundsPtr);
+      if (vtkBox::IntersectWithPlane(cellBoundsPtr, origin, normal))
+      {
+        cells->InsertNextId(cId);
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocatorTree::GenerateRepresentation(int level, vtkPolyData* pd) const
+{
+  vtkNew<vtkPoints> pts;
+  vtkNew<vtkCellArray> polys;
+
+  auto addBox = [&](const double bounds[6])
+  {
+    vtkIdType ids[8];
+    for (int i = 0; i < 8; ++i)
+    {
+      ids[i] = pts->InsertNextPoint(
+        bounds[(i & 1)], bounds[2 + ((i >> 1) & 1)], bounds[4 + ((i >> 2) & 1)]);
+    }
+    const vtkIdType faces[6][4] = { { ids[0], ids[2], ids[6], ids[4] },
+      { ids[1], ids[5], ids[7], ids[3] }, { ids[0], ids[4], ids[5], ids[1] },
+      { ids[2], ids[3], ids[7], ids[6] }, { ids[0], ids[1], ids[3], ids[2] },
+      { ids[4], ids[6], ids[7], ids[5] } };
+    for (const auto& face : faces)
+    {
+      polys->InsertNextCell(4, face);
+    }
+  };
+
+  if (level == 0)
+  {
+    addBox(this->Bounds);
+  }
+  else
+  {
+    // The children of a node at level l are at level l + 1.
+    double bounds[6];
+    std::vector<std::pair<vtkIdType, int>> stack{ { 0, 0 } };
+    while (!stack.empty())
+    {
+      const vtkBVHNode& node = this->Nodes[stack.back().first];
+      const int childLevel = stack.back().second + 1;
+      stack.pop_back();
+      for (int i = 0; i < BVH_WIDTH; ++i)
+      {
+        if (node.Child[i] < 0)
+        {
+          continue;
+        }
+        const bool isLeaf = node.Count[i] > 0;
+        if (childLevel == level || (level < 0 && isLeaf))
+        {
+          node.GetChildBounds(i, bounds);
+          addBox(bounds);
+        }
+        else if (!isLeaf && (level < 0 || childLevel < level))
+        {
+          stack.emplace_back(node.Child[i], childLevel);
+        }
+      }
+    }
+  }
+
+  pd->SetPoints(pts);
+  pd->SetPolys(polys);
+}
+
+//------------------------------------------------------------------------------
+vtkBVHCellLocator::vtkBVHCellLocator()
+{
+  this->NumberOfCellsPerNode = 4;
+}
+
+//------------------------------------------------------------------------------
+vtkBVHCellLocator::~vtkBVHCellLocator()
+{
+  this->FreeSearchStructure();
+  this->FreeCellBounds();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::FreeSearchStructure()
+{
+  this->Tree.reset();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::BuildLocator()
+{
+  // don't rebuild if build time is newer than modified and dataset modified time
+  if (this->Tree && this->BuildTime > this->MTime && this->BuildTime > this->DataSet->GetMTime())
+  {
+    return;
+  }
+  // don't rebuild if UseExistingSearchStructure is ON and a search structure already exists
+  if (this->Tree && this->UseExistingSearchStructure)
+  {
+    this->BuildTime.Modified();
+    vtkDebugMacro(<< "BuildLocator exited - UseExistingSearchStructure");
+    return;
+  }
+  this->BuildLocatorInternal();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::ForceBuildLocator()
+{
+  this->BuildLocatorInternal();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::BuildLocatorInternal()
+{
+  if (!this->DataSet || this->DataSet->GetNumberOfCells() < 1)
+  {
+    vtkErrorMacro(<< " No Cells in the data set\n");
+    return;
+  }
+  this->FreeSearchStructure();
+  this->ComputeCellBounds();
+
+  auto tree = std::make_shared<vtkBVHCellLocatorTree>();
+  tree->Build(this);
+  this->Tree = tree;
+  this->Level = tree->Depth;
+  this->BuildTime.Modified();
+}
+
+//------------------------------------------------------------------------------
+int vtkBVHCellLocator::IntersectWithLine(const double p1[3], const double p2[3], double tol,
+  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
+{
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return 0;
+  }
+  return this->Tree->IntersectWithLine(this, p1, p2, tol, t, x, pcoords, subId, cellId, cell);
+}
+
+//------------------------------------------------------------------------------
+int vtkBVHCellLocator::IntersectWithLine(const double p1[3], const double p2[3], double tol,
+  vtkPoints* points, vtkIdList* cellIds, vtkGenericCell* cell)
+{
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return 0;
+  }
+  return this->Tree->IntersectWithLine(this, p1, p2, tol, points, cellIds, cell);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::FindClosestPointWithinRadius(double x[3], double radius,
+  double closestPoint[3], vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2,
+  int& inside)
+{
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return 0;
+  }
+  return this->Tree->FindClosestPointWithinRadius(
+    this, x, radius, closestPoint, cell, cellId, subId, dist2, inside);
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::FindCellsWithinBounds(double* bbox, vtkIdList* cells)
+{
+  cells->Reset();
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return;
+  }
+  this->Tree->FindCellsWithinBounds(this, bbox, cells);
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::FindCellsAlongPlane(
+  const double o[3], const double n[3], double tol, vtkIdList* cells)
+{
+  cells->Reset();
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return;
+  }
+  this->Tree->FindCellsAlongPlane(this, o, n, tol, cells);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::FindCell(
+  double x[3], double, vtkGenericCell* cell, int& subId, double pcoords[3], double* weights)
+{
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return -1;
+  }
+  return this->Tree->FindCell(this, x, cell, subId, pcoords, weights);
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::GenerateRepresentation(int level, vtkPolyData* pd)
+{
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return;
+  }
+  this->Tree->GenerateRepresentation(level, pd);
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::ShallowCopy(vtkAbstractCellLocator* locator)
+{
+  vtkBVHCellLocator* cellLocator = vtkBVHCellLocator::SafeDownCast(locator);
+  if (!cellLocator)
+  {
+    vtkErrorMacro("Cannot cast " << locator->GetClassName() << " to vtkBVHCellLocator.");
+    return;
+  }
+  // we only copy what's actually used by vtkBVHCellLocator
+
+  // vtkLocator parameters
+  this->SetUseExistingSearchStructure(cellLocator->GetUseExistingSearchStructure());
+  this->Level = cellLocator->Level;
+
+  // vtkAbstractCellLocator parameters
+  this->SetNumberOfCellsPerNode(cellLocator->GetNumberOfCellsPerNode());
+  this->CacheCellBounds = cellLocator->CacheCellBounds;
+  this->CellBoundsSharedPtr = cellLocator->CellBoundsSharedPtr; // This is important
+  this->CellBounds = this->CellBoundsSharedPtr.get() ? this->CellBoundsSharedPtr->data() : nullptr;
+
+  // vtkBVHCellLocator parameters
+  this->Tree = cellLocator->Tree;
+  this->BuildTime.Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Number Of Nodes: " << (this->Tree ? this->Tree->Nodes.size() : 0) << "\n";
+}
+VTK_ABI_NAMESPACE_END
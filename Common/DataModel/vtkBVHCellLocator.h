@@ -0,0 +1,187 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkBVHCellLocator
+ * @brief   a cell locator based on a wide bounding volume hierarchy
+ *
+ * vtkBVHCellLocator organizes the cells of a dataset in a bounding volume
+ * hierarchy (BVH) whose nodes have up to four children. Each cell belongs to
+ * exactly one leaf, so queries never visit a cell twice. The hierarchy is
+ * built top-down, splitting the cells with a binned surface area heuristic
+ * (SAH), which minimizes the expected cost of ray traversal, and the binary
+ * hierarchy obtained is then collapsed into four-wide nodes.
+ *
+ * To keep the nodes small, the bounds of the children of a node are quantized
+ * to 8 bits relative to the bounds of the node, and rounded outward so that
+ * they still contain the cells. A node thus takes 96 bytes instead of the 192
+ * bytes of the double precision bounds of its children. Traversal tests a
+ * line against the four children of a node at once, in loops of fixed length
+ * that the compiler can vectorize, and visits the intersected children from
+ * nearest to farthest, which makes it well suited to ray casting on large
+ * surface meshes.
+ *
+ * vtkBVHCellLocator utilizes the following parent class parameters:
+ * - NumberOfCellsPerNode        (default 4)
+ * - CacheCellBounds             (default true)
+ * - UseExistingSearchStructure  (default false)
+ *
+ * vtkBVHCellLocator does NOT utilize the following parameters:
+ * - Automatic
+ * - MaxLevel
+ * - Tolerance
+ * - RetainCellLists
+ *
+ * After the locator is built, Level is the depth of the hierarchy.
+ *
+ * @warning
+ * The build and traversals are only fast if the code is optimized during
+ * compilation. Build in Release or ReleaseWithDebugInfo.
+ *
+ * @sa
+ * vtkAbstractCellLocator vtkCellLocator vtkStaticCellLocator vtkCellTreeLocator
+ * vtkModifiedBSPTree vtkOBBTree
+ */
+
+#ifndef vtkBVHCellLocator_h
+#define vtkBVHCellLocator_h
+
+#include "vtkAbstractCellLocator.h"
+#include "vtkCommonDataModelModule.h" // For export macro
+
+#include <memory> // For shared_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+struct vtkBVHCellLocatorTree;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkBVHCellLocator : public vtkAbstractCellLocator
+{
+  friend struct vtkBVHCellLocatorTree;
+
+public:
+  ///@{
+  /**
+   * Standard methods to instantiate, print and obtain type-related information.
+   */
+  static vtkBVHCellLocator* New();
+  vtkTypeMacro(vtkBVHCellLocator, vtkAbstractCellLocator);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  ///@}
+
+  // Reuse any superclass signatures that we don't override.
+  using vtkAbstractCellLocator::FindCell;
+  using vtkAbstractCellLocator::FindClosestPoint;
+  using vtkAbstractCellLocator::FindClosestPointWithinRadius;
+  using vtkAbstractCellLocator::IntersectWithLine;
+
+  /**
+   * Return intersection point (if any) AND the cell which was intersected by
+   * the finite line. The cell is returned as a cell id and as a generic cell.
+   *
+   * For other IntersectWithLine signatures, see vtkAbstractCellLocator.
+   */
+  int IntersectWithLine(const double p1[3], const double p2[3], double tol, double& t, double x[3],
+    double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell) override;
+
+  /**
+   * Take the passed line segment and intersect it with the data set.
+   * The return value of the function is 0 if no intersections were found.
+   * For each intersection with the bounds of a cell or with a cell (if a cell is provided),
+   * the points and cellIds have the relevant information added sorted by t.
+   * If points or cellIds are nullptr pointers, then no information is generated for that list.
+   *
+   * For other IntersectWithLine signatures, see vtkAbstractCellLocator.
+   */
+  int IntersectWithLine(const double p1[3], const double p2[3], double tol, vtkPoints* points,
+    vtkIdList* cellIds, vtkGenericCell* cell) override;
+
+  /**
+   * Return the closest point within a specified radius and the cell which is
+   * closest to the point x. The closest point is somewhere on a cell, it
+   * need not be one of the vertices of the cell. This method returns 1 if a
+   * point is found within the specified radius. If there are no cells within
+   * the specified radius, the method returns 0 and the values of
+   * closestPoint, cellId, subId, and dist2 are undefined. If a closest point
+   * is found, inside returns the return value of the EvaluatePosition call to
+   * the closest cell; inside(=1) or outside(=0).
+   *
+   * For other FindClosestPointWithinRadius signatures, see vtkAbstractCellLocator.
+   */
+  vtkIdType FindClosestPointWithinRadius(double x[3], double radius, double closestPoint[3],
+    vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2, int& inside) override;
+
+  /**
+   * Return a list of unique cell ids inside of a given bounding box. The
+   * user must provide the vtkIdList to populate.
+   */
+  void FindCellsWithinBounds(double* bbox, vtkIdList* cells) override;
+
+  /**
+   * Take the passed line segment and intersect it with the data set.
+   * For each intersection with the bounds of a cell, the cellIds
+   * have the relevant information added sort by t. If cellIds is nullptr
+   * pointer, then no information is generated for that list.
+   *
+   * Reimplemented from vtkAbstractCellLocator to showcase that it's a supported function.
+   */
+  void FindCellsAlongLine(
+    const double p1[3], const double p2[3], double tolerance, vtkIdList* cellsIds) override
+  {
+    this->Superclass::FindCellsAlongLine(p1, p2, tolerance, cellsIds);
+  }
+
+  /**
+   * Given an unbounded plane defined by an origin o[3] and unit normal n[3],
+   * return the list of unique cell ids whose bounds are within tolerance of
+   * the plane. The user must provide the vtkIdList cell list to populate.
+   */
+  void FindCellsAlongPlane(
+    const double o[3], const double n[3], double tolerance, vtkIdList* cells) override;
+
+  /**
+   * Find the cell containing a given point. returns -1 if no cell found
+   * the cell parameters are copied into the supplied variables, a cell must
+   * be provided to store the information.
+   *
+   * For other FindCell signatures, see vtkAbstractCellLocator.
+   */
+  vtkIdType FindCell(double x[3], double vtkNotUsed(tol2), vtkGenericCell* cell, int& subId,
+    double pcoords[3], double* weights) override;
+
+  ///@{
+  /**
+   * Satisfy vtkLocator abstract interface.
+   */
+  void FreeSearchStructure() override;
+  void BuildLocator() override;
+  void ForceBuildLocator() override;
+  ///@}
+
+  /**
+   * Generate the boxes of the nodes at the given level of the hierarchy, the
+   * root being at level 0, as quadrilaterals. A level of -1 generates the
+   * boxes of the leaves.
+   */
+  void GenerateRepresentation(int level, vtkPolyData* pd) override;
+
+  /**
+   * Shallow copy of a vtkBVHCellLocator. The hierarchy is shared.
+   *
+   * Before you shallow copy, make sure to call SetDataSet()
+   */
+  void ShallowCopy(vtkAbstractCellLocator* locator) override;
+
+protected:
+  vtkBVHCellLocator();
+  ~vtkBVHCellLocator() override;
+
+  void BuildLocatorInternal() override;
+
+  std::shared_ptr<vtkBVHCellLocatorTree> Tree;
+
+private:
+  vtkBVHCellLocator(const vtkBVHCellLocator&) = delete;
+  void operator=(const vtkBVHCellLocator&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
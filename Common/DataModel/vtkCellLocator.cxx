@@ -9,10 +9,13 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <utility>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 //------------------------------------------------------------------------------
@@ -713,7 +716,7 @@ void vtkCellLocator::BuildLocatorInternal()
   cellBoundsPtr = cellBounds;
   vtkIdType numCells;
   int ndivs, product;
-  int i, j, k, ijkMin[3], ijkMax[3];
+  int i, j, k;
   vtkIdType cellId, idx;
   int parentOffset;
   int numCellsPerBucket = this->NumberOfCellsPerNode;
@@ -773,42 +776,116 @@ void vtkCellLocator::BuildLocatorInternal()
   //  falls within octant.
   parentOffset = numOctants - (ndivs * ndivs * ndivs);
   product = ndivs * ndivs;
-  auto parentOctant = vtkSmartPointer<vtkIdList>::New(); // This is just a place-holder for parents
-  for (cellId = 0; cellId < numCells; cellId++)
+  auto computeOctantRange = [&](vtkIdType id, int octantMin[3], int octantMax[3])
   {
-    this->GetCellBounds(cellId, cellBoundsPtr);
+    double bds[6], *bdsPtr = bds;
+    this->GetCellBounds(id, bdsPtr);
 
     // find min/max locations of bounding box
-    for (i = 0; i < 3; i++)
+    for (int ii = 0; ii < 3; ii++)
     {
-      ijkMin[i] =
-        static_cast<int>((cellBoundsPtr[2 * i] - this->Bounds[2 * i] - hTol[i]) / this->H[i]);
-      ijkMax[i] =
-        static_cast<int>((cellBoundsPtr[2 * i + 1] - this->Bounds[2 * i] + hTol[i]) / this->H[i]);
+      if (bdsPtr[2 * ii] > bdsPtr[2 * ii + 1])
+      {
+        // Empty cell (e.g. VTK_EMPTY_CELL): it is in no octant.
+        octantMin[ii] = 0;
+        octantMax[ii] = -1;
+        continue;
+      }
+      octantMin[ii] =
+        static_cast<int>((bdsPtr[2 * ii] - this->Bounds[2 * ii] - hTol[ii]) / this->H[ii]);
+      octantMax[ii] =
+        static_cast<int>((bdsPtr[2 * ii + 1] - this->Bounds[2 * ii] + hTol[ii]) / this->H[ii]);
 
-      ijkMin[i] = std::max(ijkMin[i], 0);
-      ijkMax[i] = std::min(ijkMax[i], ndivs - 1);
+      octantMin[ii] = std::max(octantMin[ii], 0);
+      octantMax[ii] = std::min(octantMax[ii], ndivs - 1);
     }
+  };
 
-    // each octant between min/max point may have cell in it
-    for (k = ijkMin[2]; k <= ijkMax[2]; k++)
+  // Make sure GetCellBounds() is thread safe.
+  this->GetCellBounds(0, cellBoundsPtr);
+
+  // Count the octants that each cell may be in, then list the (octant, cell)
+  // pairs and sort them, so that the cells of each octant are contiguous and
+  // in increasing order, as if they were inserted one after another.
+  std::vector<vtkIdType> offsets(numCells + 1, 0);
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
     {
-      for (j = ijkMin[1]; j <= ijkMax[1]; j++)
+      int octantMin[3], octantMax[3];
+      for (vtkIdType id = begin; id < end; id++)
       {
-        for (i = ijkMin[0]; i <= ijkMax[0]; i++)
+        computeOctantRange(id, octantMin, octantMax);
+        offsets[id + 1] = static_cast<vtkIdType>(std::max(0, octantMax[0] - octantMin[0] + 1)) *
+          std::max(0, octantMax[1] - octantMin[1] + 1) *
+          std::max(0, octantMax[2] - octantMin[2] + 1);
+      }
+    });
+  for (cellId = 0; cellId < numCells; cellId++)
+  {
+    offsets[cellId + 1] += offsets[cellId];
+  }
+
+  std::vector<std::pair<vtkIdType, vtkIdType>> octantCells(offsets[numCells]);
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      int octantMin[3], octantMax[3];
+      for (vtkIdType id = begin; id < end; id++)
+      {
+        computeOctantRange(id, octantMin, octantMax);
+        auto octantCell = octantCells.begin() + offsets[id];
+        for (int kk = octantMin[2]; kk <= octantMax[2]; kk++)
         {
-          idx = parentOffset + i + j * ndivs + k * product;
-          this->MarkParents(parentOctant, i, j, k, ndivs, this->Level);
-          if (!this->Tree[idx])
+          for (int jj = octantMin[1]; jj <= octantMax[1]; jj++)
           {
-            this->Tree[idx] = vtkSmartPointer<vtkIdList>::New();
-            this->Tree[idx]->Allocate(numCellsPerBucket, numCellsPerBucket / 2);
+            for (int ii = octantMin[0]; ii <= octantMax[0]; ii++)
+            {
+              *octantCell++ = { parentOffset + ii + jj * ndivs + kk * product, id };
+            }
           }
-          this->Tree[idx]->InsertNextId(cellId);
         }
       }
+    });
+  vtkSMPTools::Sort(octantCells.begin(), octantCells.end());
+
+  // Find where the cells of each non-empty octant start.
+  std::vector<vtkIdType> octantStarts;
+  for (vtkIdType pair = 0; pair < static_cast<vtkIdType>(octantCells.size()); pair++)
+  {
+    if (pair == 0 || octantCells[pair].first != octantCells[pair - 1].first)
+    {
+      octantStarts.push_back(pair);
     }
-  } // for all cells
+  }
+  const vtkIdType numLeaves = static_cast<vtkIdType>(octantStarts.size());
+  octantStarts.push_back(static_cast<vtkIdType>(octantCells.size()));
+
+  vtkSMPTools::For(0, numLeaves,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType leaf = begin; leaf < end; leaf++)
+      {
+        const vtkIdType start = octantStarts[leaf];
+        const vtkIdType numIds = octantStarts[leaf + 1] - start;
+        auto cells = vtkSmartPointer<vtkIdList>::New();
+        cells->SetNumberOfIds(numIds);
+        for (vtkIdType ii = 0; ii < numIds; ii++)
+        {
+          cells->SetId(ii, octantCells[start + ii].second);
+        }
+        this->Tree[octantCells[start].first] = cells;
+      }
+    });
+
+  auto parentOctant = vtkSmartPointer<vtkIdList>::New(); // This is just a place-holder for parents
+  for (vtkIdType leaf = 0; leaf < numLeaves; leaf++)
+  {
+    idx = octantCells[octantStarts[leaf]].first - parentOffset;
+    k = static_cast<int>(idx / product);
+    j = static_cast<int>((idx % product) / ndivs);
+    i = static_cast<int>(idx % ndivs);
+    this->MarkParents(parentOctant, i, j, k, ndivs, this->Level);
+  }
 
   this->BuildTime.Modified();
 }
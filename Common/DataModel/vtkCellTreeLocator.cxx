@@ -10,6 +10,8 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm>
 #include <array>
@@ -280,10 +282,19 @@ struct CellPointTraversal
     }
   }
 };
+//------------------------------------------------------------------------------
+// Nodes with at least this many cells, and holding more than the share of the
+// cells of one thread, are split with their cells processed concurrently.
+constexpr vtkIdType CELLTREE_PARALLEL_SPLIT_SIZE = 65536;
 
 //------------------------------------------------------------------------------
 // This class builds the CellTree according to the algorithm given in the paper.
 // This class is derived from the avtCellLocatorBIH class in VisIT.
+// The tree is built one level at a time. The nodes of a level are split
+// concurrently, except for the few large nodes near the root, which are split
+// one after the other with their cells processed concurrently. Each split only
+// reorders the cells of its own node, so the tree does not depend on the number
+// of threads.
 template <typename T>
 struct CellTreeBuilder
 {
@@ -307,6 +318,13 @@ private:
       this->Min = std::min(min, this->Min);
       this->Max = std::max(max, this->Max);
     }
+
+    void Merge(const Bucket& other)
+    {
+      this->Cnt += other.Cnt;
+      this->Min = std::min(other.Min, this->Min);
+      this->Max = std::max(other.Max, this->Max);
+    }
   };
 
   struct CellInfo
@@ -357,6 +375,19 @@ private:
     }
   };
 
+  // The split of a node, applied to the tree once all the nodes of a level are split.
+  struct SplitResult
+  {
+    bool IsSplit = false;
+    T Dim = 0;
+    T Mid = 0; // index of the first cell of the right child
+    double Clip[2];
+    double LeftMin[3];
+    double LeftMax[3];
+    double RightMin[3];
+    double RightMax[3];
+  };
+
   using TCellTree = CellTree<T>;
   using TCellTreeNode = typename TCellTree::TCellTreeNode;
 
@@ -368,10 +399,12 @@ private:
 
   std::vector<CellInfo> CellsInfo;
   std::vector<CellTreeNode<T>> Nodes;
-  std::stack<SplitInfo> SplitStack;
+  std::vector<SplitInfo> SplitLevel;
 
   struct BucketsType : public std::array<std::vector<Bucket>, 3>
   {
+    std::vector<double> RightMin; // minimum of the buckets at the right of each bucket
+
     BucketsType() = default;
 
     BucketsType(int numBuckets)
@@ -380,6 +413,7 @@ private:
       (*this)[0].resize(numberOfBuckets);
       (*this)[1].resize(numberOfBuckets);
       (*this)[2].resize(numberOfBuckets);
+      this->RightMin.resize(numberOfBuckets);
     }
 
     void Reset()
@@ -422,20 +456,100 @@ private:
   }
 
   // -------------------------------------------------------------------------
-  void Split(T index, double min[3], double max[3], BucketsType& buckets)
+  void FindMinMaxParallel(const CellInfo* begin, const CellInfo* end, double* min, double* max)
+  {
+    if (begin == end)
+    {
+      return;
+    }
+
+    const std::array<double, 6> empty = { VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, VTK_DOUBLE_MAX,
+      -VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+    vtkSMPThreadLocal<std::array<double, 6>> localMinMax(empty);
+    vtkSMPTools::For(0, end - begin,
+      [&](vtkIdType first, vtkIdType last)
+      {
+        std::array<double, 6>& minMax = localMinMax.Local();
+        this->FindMinMax(begin + first, begin + last, minMax.data(), minMax.data() + 3);
+      });
+
+    for (uint8_t d = 0; d < 3; ++d)
+    {
+      min[d] = empty[d];
+      max[d] = empty[d + 3];
+    }
+    for (const std::array<double, 6>& minMax : localMinMax)
+    {
+      for (uint8_t d = 0; d < 3; ++d)
+      {
+        min[d] = std::min(minMax[d], min[d]);
+        max[d] = std::max(minMax[d + 3], max[d]);
+      }
+    }
+  }
+
+  // -------------------------------------------------------------------------
+  void FillBuckets(const CellInfo* begin, const CellInfo* end, const double min[3],
+    const double iext[3], BucketsType& buckets)
   {
-    const T& start = this->Nodes[index].Start();
-    const T& size = this->Nodes[index].Size();
+    for (const CellInfo* pc = begin; pc != end; ++pc)
+    {
+      for (uint8_t d = 0; d < 3; ++d)
+      {
+        double cen = (pc->Min[d] + pc->Max[d]) / 2.0;
+        double dblIdx = (cen - min[d]) * iext[d];
+        dblIdx = vtkMath::ClampValue(dblIdx, 0.0, static_cast<double>(this->NumberOfBuckets - 1));
+        size_t ind = static_cast<size_t>(dblIdx);
+
+        buckets[d][ind].Add(pc->Min[d], pc->Max[d]);
+      }
+    }
+  }
+
+  // -------------------------------------------------------------------------
+  void FillBucketsParallel(const CellInfo* begin, const CellInfo* end, const double min[3],
+    const double iext[3], BucketsType& buckets)
+  {
+    vtkSMPThreadLocal<BucketsType> localBuckets(BucketsType(this->NumberOfBuckets));
+    vtkSMPTools::For(0, end - begin,
+      [&](vtkIdType first, vtkIdType last)
+      {
+        this->FillBuckets(begin + first, begin + last, min, iext, localBuckets.Local());
+      });
+
+    for (const BucketsType& threadBuckets : localBuckets)
+    {
+      for (uint8_t d = 0; d < 3; ++d)
+      {
+        for (int n = 0; n < this->NumberOfBuckets; ++n)
+        {
+          buckets[d][n].Merge(threadBuckets[d][n]);
+        }
+      }
+    }
+  }
+
+  // -------------------------------------------------------------------------
+  // Split the node of splitInfo. Only the cells of this node are modified, so
+  // nodes of a same level can be split concurrently. If parallel is true, the
+  // cells of the node are processed concurrently.
+  SplitResult Split(const SplitInfo& splitInfo, BucketsType& buckets, bool parallel)
+  {
+    SplitResult result;
+    const T start = this->Nodes[splitInfo.Index].Start();
+    const T size = this->Nodes[splitInfo.Index].Size();
 
     if (size < this->NumberOfNodesPerLeaf)
     {
-      return;
+      return result;
     }
 
     CellInfo* begin = &(this->CellsInfo[start]);
     CellInfo* end = this->CellsInfo.data() + start + size;
     CellInfo* mid = begin;
 
+    const double* min = splitInfo.Min;
+    const double* max = splitInfo.Max;
     const double ext[3] = { max[0] - min[0], max[1] - min[1], max[2] - min[2] };
     double iext[3];
 
@@ -446,18 +560,13 @@ private:
     }
 
     buckets.Reset();
-
-    for (const CellInfo* pc = begin; pc != end; ++pc)
+    if (parallel)
     {
-      for (uint8_t d = 0; d < 3; ++d)
-      {
-        double cen = (pc->Min[d] + pc->Max[d]) / 2.0;
-        double dblIdx = (cen - min[d]) * iext[d];
-        dblIdx = vtkMath::ClampValue(dblIdx, 0.0, static_cast<double>(this->NumberOfBuckets - 1));
-        size_t ind = static_cast<size_t>(dblIdx);
-
-        buckets[d][ind].Add(pc->Min[d], pc->Max[d]);
-      }
+      this->FillBucketsParallel(begin, end, min, iext, buckets);
+    }
+    else
+    {
+      this->FillBuckets(begin, end, min, iext, buckets);
     }
 
     double cost = VTK_DOUBLE_MAX;
@@ -465,32 +574,26 @@ private:
     T dim = VTK_INT_MAX;           // bad value in case it doesn't get set
     T sum;
     double lVol, rVol, c, lMaxValue, rMinValue;
-    int n, m;
+    int n;
 
     for (uint8_t d = 0; d < 3; ++d)
     {
+      // Sweep the buckets from the right, then from the left, to get the
+      // bounds of both sides of each candidate plane in linear time
+      std::vector<double>& rightMin = buckets.RightMin;
+      rightMin[this->NumberOfBuckets - 1] = buckets[d][this->NumberOfBuckets - 1].Min;
+      for (n = this->NumberOfBuckets - 2; n >= 0; --n)
+      {
+        rightMin[n] = std::min(buckets[d][n].Min, rightMin[n + 1]);
+      }
+
       sum = 0;
+      lMaxValue = -VTK_DOUBLE_MAX;
 
       for (n = 0; n < this->NumberOfBuckets - 1; ++n)
       {
-        lMaxValue = -VTK_DOUBLE_MAX;
-        rMinValue = VTK_DOUBLE_MAX;
-
-        for (m = 0; m <= n; ++m)
-        {
-          if (buckets[d][m].Max > lMaxValue)
-          {
-            lMaxValue = buckets[d][m].Max;
-          }
-        }
-
-        for (m = n + 1; m < this->NumberOfBuckets; ++m)
-        {
-          if (buckets[d][m].Min < rMinValue)
-          {
-            rMinValue = buckets[d][m].Min;
-          }
-        }
+        lMaxValue = std::max(buckets[d][n].Max, lMaxValue);
+        rMinValue = rightMin[n + 1];
 
         if (lMaxValue != -VTK_DOUBLE_MAX && rMinValue != VTK_DOUBLE_MAX)
         {
@@ -525,22 +628,23 @@ private:
       std::nth_element(begin, mid, end, CenterOrder(dim));
     }
 
-    double lMin[3], lMax[3], rMin[3], rMax[3];
-
-    this->FindMinMax(begin, mid, lMin, lMax);
-    this->FindMinMax(mid, end, rMin, rMax);
-
-    double clip[2] = { lMax[dim], rMin[dim] };
-
-    TCellTreeNode child[2];
-    child[0].MakeLeaf(begin - this->CellsInfo.data(), mid - begin);
-    child[1].MakeLeaf(mid - this->CellsInfo.data(), end - mid);
-
-    this->Nodes[index].MakeNode(static_cast<T>(this->Nodes.size()), dim, clip);
-    this->Nodes.insert(this->Nodes.end(), child, child + 2);
+    if (parallel)
+    {
+      this->FindMinMaxParallel(begin, mid, result.LeftMin, result.LeftMax);
+      this->FindMinMaxParallel(mid, end, result.RightMin, result.RightMax);
+    }
+    else
+    {
+      this->FindMinMax(begin, mid, result.LeftMin, result.LeftMax);
+      this->FindMinMax(mid, end, result.RightMin, result.RightMax);
+    }
 
-    this->SplitStack.emplace(this->Nodes[index].GetRightChildIndex(), rMin, rMax);
-    this->SplitStack.emplace(this->Nodes[index].GetLeftChildIndex(), lMin, lMax);
+    result.IsSplit = true;
+    result.Dim = dim;
+    result.Mid = static_cast<T>(mid - this->CellsInfo.data());
+    result.Clip[0] = result.LeftMax[dim];
+    result.Clip[1] = result.RightMin[dim];
+    return result;
   }
 
 public:
@@ -555,33 +659,57 @@ public:
     const auto numberOfCells = static_cast<T>(this->DataSet->GetNumberOfCells());
     this->CellsInfo.resize(static_cast<size_t>(numberOfCells));
 
+    // This is done to cause non-thread safe initialization to occur due to
+    // side effects from GetCellBounds().
+    double cellBounds[6], *cellBoundsPtr;
+    cellBoundsPtr = cellBounds;
+    this->Locator->GetCellBounds(0, cellBoundsPtr);
+
+    const std::array<double, 6> empty = { VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, VTK_DOUBLE_MAX,
+      -VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+    vtkSMPThreadLocal<std::array<double, 6>> localMinMax(empty);
+    vtkSMPTools::For(0, numberOfCells,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        double* min = localMinMax.Local().data();
+        double* max = min + 3;
+        double bounds[6], *boundsPtr;
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          CellInfo& cellInfo = this->CellsInfo[i];
+          cellInfo.Ind = static_cast<T>(i);
+          boundsPtr = bounds;
+          this->Locator->GetCellBounds(i, boundsPtr);
+
+          for (uint8_t d = 0; d < 3; ++d)
+          {
+            cellInfo.Min[d] = boundsPtr[2 * d + 0];
+            cellInfo.Max[d] = boundsPtr[2 * d + 1];
+
+            if (cellInfo.Min[d] < min[d])
+            {
+              min[d] = cellInfo.Min[d];
+            }
+            if (cellInfo.Max[d] > max[d])
+            {
+              max[d] = cellInfo.Max[d];
+            }
+          }
+        }
+      });
+
     double min[3] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, VTK_DOUBLE_MAX };
     double max[3] = {
       -VTK_DOUBLE_MAX,
       -VTK_DOUBLE_MAX,
       -VTK_DOUBLE_MAX,
     };
-
-    double cellBounds[6], *cellBoundsPtr;
-    cellBoundsPtr = cellBounds;
-    for (T i = 0; i < numberOfCells; ++i)
+    for (const std::array<double, 6>& minMax : localMinMax)
     {
-      this->CellsInfo[i].Ind = i;
-      this->Locator->GetCellBounds(i, cellBoundsPtr);
-
       for (uint8_t d = 0; d < 3; ++d)
       {
-        this->CellsInfo[i].Min[d] = cellBoundsPtr[2 * d + 0];
-        this->CellsInfo[i].Max[d] = cellBoundsPtr[2 * d + 1];
-
-        if (this->CellsInfo[i].Min[d] < min[d])
-        {
-          min[d] = this->CellsInfo[i].Min[d];
-        }
-        if (this->CellsInfo[i].Max[d] > max[d])
-        {
-          max[d] = this->CellsInfo[i].Max[d];
-        }
+        min[d] = std::min(minMax[d], min[d]);
+        max[d] = std::max(minMax[d + 3], max[d]);
       }
     }
 
@@ -596,7 +724,7 @@ public:
     root.MakeLeaf(0, numberOfCells);
     this->Nodes.push_back(root);
 
-    this->SplitStack.emplace(0, min, max);
+    this->SplitLevel.emplace_back(0, min, max);
   }
 
   void Initialize()
@@ -607,12 +735,65 @@ public:
 
   void operator()()
   {
-    auto& buckets = this->Buckets;
-    while (!this->SplitStack.empty())
+    const vtkIdType numberOfCells = static_cast<vtkIdType>(this->CellsInfo.size());
+    const vtkIdType numberOfThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+    std::vector<SplitResult> results;
+    std::vector<size_t> concurrentSplits;
+    std::vector<SplitInfo> nextLevel;
+    vtkSMPThreadLocal<BucketsType> localBuckets(BucketsType(this->NumberOfBuckets));
+
+    while (!this->SplitLevel.empty())
     {
-      auto splitInfo = std::move(this->SplitStack.top());
-      this->SplitStack.pop();
-      this->Split(splitInfo.Index, splitInfo.Min, splitInfo.Max, buckets);
+      const size_t numberOfSplits = this->SplitLevel.size();
+      results.assign(numberOfSplits, SplitResult());
+      concurrentSplits.clear();
+      for (size_t i = 0; i < numberOfSplits; ++i)
+      {
+        const vtkIdType size = this->Nodes[this->SplitLevel[i].Index].Size();
+        if (size >= CELLTREE_PARALLEL_SPLIT_SIZE && size * numberOfThreads > numberOfCells)
+        {
+          results[i] = this->Split(this->SplitLevel[i], this->Buckets, true);
+        }
+        else
+        {
+          concurrentSplits.push_back(i);
+        }
+      }
+
+      vtkSMPTools::For(0, static_cast<vtkIdType>(concurrentSplits.size()),
+        [&](vtkIdType begin, vtkIdType end)
+        {
+          BucketsType& buckets = localBuckets.Local();
+          for (vtkIdType i = begin; i < end; ++i)
+          {
+            const size_t split = concurrentSplits[i];
+            results[split] = this->Split(this->SplitLevel[split], buckets, false);
+          }
+        });
+
+      nextLevel.clear();
+      for (size_t i = 0; i < numberOfSplits; ++i)
+      {
+        const SplitResult& result = results[i];
+        if (!result.IsSplit)
+        {
+          continue;
+        }
+
+        TCellTreeNode& node = this->Nodes[this->SplitLevel[i].Index];
+        const T end = node.Start() + node.Size();
+        TCellTreeNode child[2];
+        child[0].MakeLeaf(node.Start(), result.Mid - node.Start());
+        child[1].MakeLeaf(result.Mid, end - result.Mid);
+
+        node.MakeNode(static_cast<T>(this->Nodes.size()), result.Dim, result.Clip);
+        const T left = node.GetLeftChildIndex();
+        this->Nodes.insert(this->Nodes.end(), child, child + 2);
+
+        nextLevel.emplace_back(left, result.LeftMin, result.LeftMax);
+        nextLevel.emplace_back(left + 1, result.RightMin, result.RightMax);
+      }
+      std::swap(this->SplitLevel, nextLevel);
     }
   }
 
@@ -634,12 +815,16 @@ public:
       ni->SetChildren(nn - this->Tree.Nodes.begin() - 2);
     }
 
-    const auto numberOfCells = static_cast<size_t>(this->DataSet->GetNumberOfCells());
-    this->Tree.Leaves.resize(numberOfCells);
-    for (size_t i = 0; i < numberOfCells; ++i)
-    {
-      this->Tree.Leaves[i] = this->CellsInfo[i].Ind;
-    }
+    const auto numberOfCells = static_cast<vtkIdType>(this->DataSet->GetNumberOfCells());
+    this->Tree.Leaves.resize(static_cast<size_t>(numberOfCells));
+    vtkSMPTools::For(0, numberOfCells,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          this->Tree.Leaves[i] = this->CellsInfo[i].Ind;
+        }
+      });
     this->CellsInfo.clear();
   }
 };
@@ -1308,7 +1493,7 @@ void vtkCellTreeLocator::BuildLocatorInternal()
 {
   using namespace detail;
   vtkIdType numCells;
-  if (!this->DataSet || (numCells = this->DataSet->GetNumberOfCells() < 1))
+  if (!this->DataSet || (numCells = this->DataSet->GetNumberOfCells()) < 1)
   {
     vtkErrorMacro(<< " No Cells in the data set\n");
     return;
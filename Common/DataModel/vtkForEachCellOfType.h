@@ -0,0 +1,194 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+/**
+ * @file vtkForEachCellOfType.h
+ * @brief Cell type specialized traversal of the cells of a vtkUnstructuredGrid.
+ *
+ * `vtk::ForEachCellOfType<CellType>(grid, functor)` calls the functor for
+ * each cell of type `CellType` of the grid, in increasing cell id order:
+ *
+ * ```
+ * vtk::ForEachCellOfType<VTK_TETRA>(grid,
+ *   [&](vtkIdType cellId, const auto& pointIds, const auto& points)
+ *   {
+ *     double center[3] = { 0.0, 0.0, 0.0 };
+ *     for (const vtkIdType pointId : pointIds)
+ *     {
+ *       const auto point = points[pointId];
+ *       center[0] += 0.25 * point[0];
+ *       center[1] += 0.25 * point[1];
+ *       center[2] += 0.25 * point[2];
+ *     }
+ *     ...
+ *   });
+ * ```
+ *
+ * `pointIds` is a vtk::DataArrayValueRange of the point ids of the cell,
+ * viewed in place in the connectivity array of the grid, and `points` is a
+ * vtk::DataArrayTupleRange of the coordinates of all the points of the
+ * grid. The connectivity and the coordinates are neither copied nor accessed
+ * through virtual calls, unlike with `vtkUnstructuredGrid::GetCell()` or
+ * vtkCellIterator, since the functor is instantiated for the actual types of
+ * the arrays: 32 or 64 bit cell arrays, and float or double AOS points. Other
+ * point arrays are accessed through the vtkDataArray API.
+ *
+ * `vtk::ForEachCellOfTypes<CellTypes...>(grid, functor)` processes the cells
+ * of mixed-type grids grouped by type: all the cells of the first type, then
+ * all the cells of the second type, and so on. The functor additionally
+ * receives the type of the cell as a `std::integral_constant<int, CellType>`,
+ * so that it can be specialized at compile time for each type:
+ *
+ * ```
+ * vtk::ForEachCellOfTypes<VTK_TETRA, VTK_HEXAHEDRON>(grid,
+ *   [&](auto cellType, vtkIdType cellId, const auto& pointIds, const auto& points)
+ *   {
+ *     constexpr int numberOfPoints = decltype(cellType)::value == VTK_TETRA ? 4 : 8;
+ *     ...
+ *   });
+ * ```
+ *
+ * Both functions also accept a range of cell ids `[begin, end)`, and only read
+ * the grid, so they can be called concurrently, for instance from the functor
+ * of `vtkSMPTools::For()`.
+ *
+ * @warning
+ * Polyhedra are visited with their point ids only. Their faces are available
+ * with `vtkUnstructuredGrid::GetPolyhedronFaces()`.
+ */
+
+#ifndef vtkForEachCellOfType_h
+#define vtkForEachCellOfType_h
+
+#include "vtkAOSDataArrayTemplate.h"
+#include "vtkArrayDispatch.h"
+#include "vtkArrayDispatchDataSetArrayList.h"
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkConstantArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkPoints.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace vtk
+{
+VTK_ABI_NAMESPACE_BEGIN
+
+/**
+ * Call `functor(cellId, pointIds, points)` for each cell of type `CellType`
+ * whose id is in `[begin, end)`.
+ */
+template <int CellType, typename Functor>
+void ForEachCellOfType(
+  vtkUnstructuredGrid* grid, vtkIdType begin, vtkIdType end, Functor&& functor)
+{
+  static_assert(CellType >= 0 && CellType < VTK_NUMBER_OF_CELL_TYPES, "Invalid cell type");
+
+  vtkCellArray* cells = grid ? grid->GetCells() : nullptr;
+  vtkPoints* points = grid ? grid->GetPoints() : nullptr;
+  vtkDataArray* types = grid ? grid->GetCellTypes() : nullptr;
+  if (!cells || !points || !types || begin >= end)
+  {
+    return;
+  }
+
+  // The type of each cell is read directly from the array, unless all the
+  // cells have the same type.
+  const unsigned char* cellTypes = nullptr;
+  vtkIdType cellTypesOffset = 0;
+  std::vector<unsigned char> cellTypesCopy;
+  if (auto constantTypes = vtkConstantArray<unsigned char>::FastDownCast(types))
+  {
+    if (constantTypes->GetValue(0) != CellType)
+    {
+      return;
+    }
+  }
+  else if (auto aosTypes = vtkAOSDataArrayTemplate<unsigned char>::FastDownCast(types))
+  {
+    cellTypes = aosTypes->GetPointer(0);
+  }
+  else
+  {
+    cellTypesCopy.resize(end - begin);
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      cellTypesCopy[cellId - begin] = static_cast<unsigned char>(types->GetComponent(cellId, 0));
+    }
+    cellTypes = cellTypesCopy.data();
+    cellTypesOffset = begin;
+  }
+
+  auto visitCells = [&](auto* pointsArray)
+  {
+    const auto pointsRange = vtk::DataArrayTupleRange<3>(pointsArray);
+    cells->Dispatch(
+      [&](auto* offsets, auto* connectivity)
+      {
+        const auto offsetsRange = vtk::DataArrayValueRange<1, vtkIdType>(offsets);
+        for (vtkIdType cellId = begin; cellId < end; ++cellId)
+        {
+          if (cellTypes && cellTypes[cellId - cellTypesOffset] != CellType)
+          {
+            continue;
+          }
+          const auto pointIds = vtk::DataArrayValueRange<1, vtkIdType>(
+            connectivity, offsetsRange[cellId], offsetsRange[cellId + 1]);
+          functor(cellId, pointIds, pointsRange);
+        }
+      });
+  };
+
+  using Dispatcher = vtkArrayDispatch::DispatchByArray<vtkArrayDispatch::AOSPointArrays>;
+  if (!Dispatcher::Execute(points->GetData(), visitCells))
+  {
+    visitCells(points->GetData());
+  }
+}
+
+/**
+ * Call `functor(cellId, pointIds, points)` for each cell of type `CellType`.
+ */
+template <int CellType, typename Functor>
+void ForEachCellOfType(vtkUnstructuredGrid* grid, Functor&& functor)
+{
+  vtk::ForEachCellOfType<CellType>(
+    grid, 0, grid ? grid->GetNumberOfCells() : 0, std::forward<Functor>(functor));
+}
+
+/**
+ * Call `functor(cellType, cellId, pointIds, points)` for each cell whose id is
+ * in `[begin, end)` and whose type is one of `CellTypes`, grouping the cells by
+ * type. `cellType` is a `std::integral_constant<int, CellType>`.
+ */
+template <int... CellTypes, typename Functor>
+void ForEachCellOfTypes(
+  vtkUnstructuredGrid* grid, vtkIdType begin, vtkIdType end, Functor&& functor)
+{
+  (vtk::ForEachCellOfType<CellTypes>(grid, begin, end,
+     [&](vtkIdType cellId, const auto& pointIds, const auto& points)
+     { functor(std::integral_constant<int, CellTypes>{}, cellId, pointIds, points); }),
+    ...);
+}
+
+/**
+ * Call `functor(cellType, cellId, pointIds, points)` for each cell whose type
+ * is one of `CellTypes`, grouping the cells by type.
+ */
+template <int... CellTypes, typename Functor>
+void ForEachCellOfTypes(vtkUnstructuredGrid* grid, Functor&& functor)
+{
+  vtk::ForEachCellOfTypes<CellTypes...>(
+    grid, 0, grid ? grid->GetNumberOfCells() : 0, std::forward<Functor>(functor));
+}
+
+VTK_ABI_NAMESPACE_END
+} // end namespace vtk
+
+#endif // vtkForEachCellOfType_h
+
+// VTK-HeaderTest-Exclude: vtkForEachCellOfType.h
@@ -12,17 +12,21 @@
 #include "vtkDataSetCollection.h"
 #include "vtkFloatArray.h"
 #include "vtkGarbageCollector.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkIntArray.h"
 #include "vtkKdNode.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointSet.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTimerLog.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
@@ -32,6 +36,7 @@
 #include <map>
 #include <queue>
 #include <set>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 namespace
@@ -619,11 +624,11 @@ float* vtkKdTree::ComputeCellCenters(vtkDataSet* set)
     return nullptr;
   }
 
-  int maxCellSize = 0;
+  std::vector<vtkDataSet*> sets;
 
   if (set)
   {
-    maxCellSize = set->GetMaxCellSize();
+    sets.push_back(set);
   }
   else
   {
@@ -632,56 +637,52 @@ float* vtkKdTree::ComputeCellCenters(vtkDataSet* set)
     for (vtkDataSet* iset = this->DataSets->GetNextDataSet(cookie); iset != nullptr;
          iset = this->DataSets->GetNextDataSet(cookie))
     {
-      int cellSize = iset->GetMaxCellSize();
-      maxCellSize = (cellSize > maxCellSize) ? cellSize : maxCellSize;
+      sets.push_back(iset);
     }
   }
 
-  double* weights = new double[maxCellSize];
+  // The centers of the cells of each data set are computed in parallel,
+  // each thread using its own cell and weights.
+  vtkSMPThreadLocalObject<vtkGenericCell> cells;
+  vtkSMPThreadLocal<std::vector<double>> weights;
+  vtkIdType offset = 0;
 
-  float* cptr = center;
-  double dcenter[3];
-
-  if (set)
+  for (vtkDataSet* iset : sets)
   {
-    for (int j = 0; j < totalCells; j++)
+    vtkIdType nCells = iset->GetNumberOfCells();
+    if (nCells == 0)
     {
-      this->ComputeCellCenter(set->GetCell(j), dcenter, weights);
-      cptr[0] = static_cast<float>(dcenter[0]);
-      cptr[1] = static_cast<float>(dcenter[1]);
-      cptr[2] = static_cast<float>(dcenter[2]);
-      cptr += 3;
-      if (j % 1000 == 0)
-      {
-        this->UpdateSubOperationProgress(static_cast<double>(j) / totalCells);
-      }
+      continue;
     }
-  }
-  else
-  {
-    vtkCollectionSimpleIterator cookie;
-    this->DataSets->InitTraversal(cookie);
-    for (vtkDataSet* iset = this->DataSets->GetNextDataSet(cookie); iset != nullptr;
-         iset = this->DataSets->GetNextDataSet(cookie))
-    {
-      int nCells = iset->GetNumberOfCells();
 
-      for (int j = 0; j < nCells; j++)
+    // Make sure GetCell() is thread safe.
+    vtkNew<vtkGenericCell> cell;
+    iset->GetCell(0, cell);
+
+    int maxCellSize = iset->GetMaxCellSize();
+    float* cptr = center + 3 * offset;
+
+    vtkSMPTools::For(0, nCells,
+      [&](vtkIdType begin, vtkIdType end)
       {
-        this->ComputeCellCenter(iset->GetCell(j), dcenter, weights);
-        cptr[0] = static_cast<float>(dcenter[0]);
-        cptr[1] = static_cast<float>(dcenter[1]);
-        cptr[2] = static_cast<float>(dcenter[2]);
-        cptr += 3;
-        if (j % 1000 == 0)
+        vtkGenericCell* genericCell = cells.Local();
+        std::vector<double>& localWeights = weights.Local();
+        localWeights.resize(std::max(maxCellSize, 1));
+        double dcenter[3];
+
+        for (vtkIdType j = begin; j < end; j++)
         {
-          this->UpdateSubOperationProgress(static_cast<double>(j) / totalCells);
+          iset->GetCell(j, genericCell);
+          this->ComputeCellCenter(genericCell, dcenter, localWeights.data());
+          cptr[3 * j] = static_cast<float>(dcenter[0]);
+          cptr[3 * j + 1] = static_cast<float>(dcenter[1]);
+          cptr[3 * j + 2] = static_cast<float>(dcenter[2]);
         }
-      }
-    }
-  }
+      });
 
-  delete[] weights;
+    offset += nCells;
+    this->UpdateSubOperationProgress(static_cast<double>(offset) / totalCells);
+  }
 
   this->UpdateSubOperationProgress(1.0);
   return center;
@@ -894,7 +895,7 @@ void vtkKdTree::BuildLocatorInternal()
 
     this->ProgressOffset += this->ProgressScale;
     this->ProgressScale = 0.7;
-    this->DivideRegion(kd, ptarray, nullptr, 0);
+    this->DivideRegionInParallel(kd, ptarray, nullptr);
 
     TIMERDONE("Build tree");
 
@@ -1238,12 +1239,32 @@ int vtkKdTree::DivideTest(int size, int level)
 
 //------------------------------------------------------------------------------
 int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
+{
+  if (!this->SplitRegion(kd, c1, ids, level))
+  {
+    return 0; // unable to divide region further
+  }
+
+  int nleft = kd->GetLeft()->GetNumberOfPoints();
+
+  int* leftIds = ids;
+  int* rightIds = ids ? ids + nleft : nullptr;
+
+  this->DivideRegion(kd->GetLeft(), c1, leftIds, level + 1);
+
+  this->DivideRegion(kd->GetRight(), c1 + nleft * 3, rightIds, level + 1);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+bool vtkKdTree::SplitRegion(vtkKdNode* kd, float* c1, int* ids, int level)
 {
   int ok = this->DivideTest(kd->GetNumberOfPoints(), level);
 
   if (!ok)
   {
-    return 0;
+    return false;
   }
 
   int maxdim = this->SelectCutDirection(kd);
@@ -1292,21 +1313,50 @@ int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
 
   this->DoMedianFind(kd, c1, ids, dim1, dim2, dim3);
 
-  if (kd->GetLeft() == nullptr)
-  {
-    return 0; // unable to divide region further
-  }
-
-  int nleft = kd->GetLeft()->GetNumberOfPoints();
-
-  int* leftIds = ids;
-  int* rightIds = ids ? ids + nleft : nullptr;
+  return kd->GetLeft() != nullptr;
+}
 
-  this->DivideRegion(kd->GetLeft(), c1, leftIds, level + 1);
+//------------------------------------------------------------------------------
+void vtkKdTree::DivideRegionInParallel(vtkKdNode* kd, float* c1, int* ids)
+{
+  struct Region
+  {
+    vtkKdNode* Node;
+    float* Points;
+    int* Ids;
+    int Level;
+  };
 
-  this->DivideRegion(kd->GetRight(), c1 + nleft * 3, rightIds, level + 1);
+  // Divide the top of the tree breadth first until there are enough
+  // subtrees to balance the work between the threads.
+  const std::size_t minNumberOfRegions =
+    8 * static_cast<std::size_t>(vtkSMPTools::GetEstimatedNumberOfThreads());
+  std::vector<Region> regions{ { kd, c1, ids, 0 } };
+  std::vector<Region> children;
+  while (!regions.empty() && regions.size() < minNumberOfRegions)
+  {
+    children.clear();
+    for (const Region& region : regions)
+    {
+      if (this->SplitRegion(region.Node, region.Points, region.Ids, region.Level))
+      {
+        int nleft = region.Node->GetLeft()->GetNumberOfPoints();
+        children.push_back({ region.Node->GetLeft(), region.Points, region.Ids, region.Level + 1 });
+        children.push_back({ region.Node->GetRight(), region.Points + nleft * 3,
+          region.Ids ? region.Ids + nleft : nullptr, region.Level + 1 });
+      }
+    }
+    regions.swap(children);
+  }
 
-  return 0;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(regions.size()), 1,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        this->DivideRegion(regions[i].Node, regions[i].Points, regions[i].Ids, regions[i].Level);
+      }
+    });
 }
 
 //------------------------------------------------------------------------------
@@ -1837,7 +1887,7 @@ void vtkKdTree::BuildLocatorFromPoints(vtkPoints** ptArrays, int numPtArrays)
 
   TIMER("Build tree");
 
-  this->DivideRegion(kd, points, ptIds, 0);
+  this->DivideRegionInParallel(kd, points, ptIds);
 
   this->SetActualLevel();
   this->BuildRegionList();
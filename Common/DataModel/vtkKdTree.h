@@ -34,6 +34,11 @@
  *     tolerance, or you can use FindPoint and FindClosestPoint to
  *     locate points in the original set that the tree was built from.
  *
+ *     The cell centers are computed and the subtrees below the top of the
+ *     tree are divided in parallel using vtkSMPTools. Each subtree is divided
+ *     by a single thread, so the regions do not depend on the number of
+ *     threads.
+ *
  * @sa
  *      vtkLocator vtkCellLocator vtkPKdTree
  */
@@ -768,6 +773,18 @@ protected:
 
   int DivideRegion(vtkKdNode* kd, float* c1, int* ids, int nlevels);
 
+  /**
+   * Divide the region in two at the median of its points, if DivideTest
+   * allows it. Return whether the region was divided.
+   */
+  bool SplitRegion(vtkKdNode* kd, float* c1, int* ids, int level);
+
+  /**
+   * Divide the top of the tree serially, then the subtrees below it in
+   * parallel.
+   */
+  void DivideRegionInParallel(vtkKdNode* kd, float* c1, int* ids);
+
   void DoMedianFind(vtkKdNode* kd, float* c1, int* ids, int d1, int d2, int d3);
 
   void SelfRegister(vtkKdNode* kd);
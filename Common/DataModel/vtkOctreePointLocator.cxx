@@ -14,7 +14,12 @@
 #include "vtkOctreePointLocatorNode.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
 #include <list>
 #include <map>
 #include <queue>
@@ -98,6 +103,108 @@ private:
   // map from dist^2 to a list of ids
   std::map<float, std::list<vtkIdType>> dist2ToIds;
 };
+
+//------------------------------------------------------------------------------
+// Compute the bounds of the root octant from the bounds of the dataset:
+// (1) push out a little if flat
+// (2) pull back the x, y and z lower bounds a little bit so that
+// points are clearly "inside" the spatial region.  Point p is
+// "inside" region r = [r1, r2] if r1 < p <= r2.
+void ComputeRootBounds(vtkDataSet* dataSet, bool createCubicOctants, double bounds[6],
+  float& maxWidth, double& fudgeFactor)
+{
+  double diff[3];
+  dataSet->GetBounds(bounds);
+
+  maxWidth = 0.0;
+  for (int i = 0; i < 3; i++)
+  {
+    diff[i] = bounds[2 * i + 1] - bounds[2 * i];
+    maxWidth = static_cast<float>((diff[i] > maxWidth) ? diff[i] : maxWidth);
+  }
+
+  if (createCubicOctants)
+  {
+    // make the bounding box have equal length sides so that all octants
+    // will also have equal length sides
+    for (int i = 0; i < 3; i++)
+    {
+      if (diff[i] != maxWidth)
+      {
+        double delta = maxWidth - diff[i];
+        bounds[2 * i] -= .5 * delta;
+        bounds[2 * i + 1] += .5 * delta;
+        diff[i] = maxWidth;
+      }
+    }
+  }
+
+  fudgeFactor = maxWidth * 10e-6;
+
+  double aLittle = maxWidth * 10e-2;
+
+  for (int i = 0; i < 3; i++)
+  {
+    if (diff[i] < aLittle) // case (1) above
+    {
+      double temp = bounds[2 * i];
+      bounds[2 * i] = bounds[2 * i + 1] - aLittle;
+      bounds[2 * i + 1] = temp + aLittle;
+    }
+    else // case (2) above
+    {
+      bounds[2 * i] -= fudgeFactor;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Return the depth of the octree below node.
+int ComputeDepth(vtkOctreePointLocatorNode* node)
+{
+  int depth = 0;
+  if (node->GetChild(0))
+  {
+    for (int i = 0; i < 8; i++)
+    {
+      depth = std::max(depth, ComputeDepth(node->GetChild(i)) + 1);
+    }
+  }
+  return depth;
+}
+
+//------------------------------------------------------------------------------
+// Append the levels of the leaves below node, in the order of their ids.
+void ComputeLeafLevels(vtkOctreePointLocatorNode* node, int level, std::vector<int>& levels)
+{
+  if (node->GetChild(0))
+  {
+    for (int i = 0; i < 8; i++)
+    {
+      ComputeLeafLevels(node->GetChild(i), level + 1, levels);
+    }
+  }
+  else
+  {
+    levels.push_back(level);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Set the number of points of the non-leaf octants from their children.
+int UpdateNumberOfPoints(vtkOctreePointLocatorNode* node)
+{
+  if (node->GetChild(0))
+  {
+    int numberOfPoints = 0;
+    for (int i = 0; i < 8; i++)
+    {
+      numberOfPoints += UpdateNumberOfPoints(node->GetChild(i));
+    }
+    node->SetNumberOfPoints(numberOfPoints);
+  }
+  return node->GetNumberOfPoints();
+}
 }
 
 //------------------------------------------------------------------------------
@@ -227,52 +334,146 @@ int vtkOctreePointLocator::DivideTest(int size, int level)
 //------------------------------------------------------------------------------
 void vtkOctreePointLocator::DivideRegion(vtkOctreePointLocatorNode* node, int* ordering, int level)
 {
-  if (!this->DivideTest(node->GetNumberOfPoints(), level))
+  if (!this->SplitRegion(node, ordering, level))
   {
     return;
   }
-  if (level >= this->Level)
+  int counter = 0;
+  for (int i = 0; i < 8; i++)
   {
-    this->Level = level + 1;
+    this->DivideRegion(node->GetChild(i), ordering + counter, level + 1);
+    counter += node->GetChild(i)->GetNumberOfPoints();
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkOctreePointLocator::SplitRegion(vtkOctreePointLocatorNode* node, int* ordering, int level)
+{
+  if (!this->DivideTest(node->GetNumberOfPoints(), level))
+  {
+    return false;
   }
 
   node->CreateChildNodes();
-  int numberOfPoints = node->GetNumberOfPoints();
+  const int numberOfPoints = node->GetNumberOfPoints();
   vtkDataSet* ds = this->GetDataSet();
 
-  std::vector<int> points[7];
-  int i;
-  int subOctantNumberOfPoints[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-  for (i = 0; i < numberOfPoints; i++)
+  // Stable counting sort of the points by sub-octant. The points are
+  // processed by blocks, in parallel for large octants, so that the order of
+  // the points does not depend on the number of threads.
+  const int blockSize = 16384;
+  const int numberOfBlocks = (numberOfPoints + blockSize - 1) / blockSize;
+  std::vector<unsigned char> subOctants(numberOfPoints);
+  std::vector<std::array<int, 8>> offsets(numberOfBlocks);
+  auto forEachBlock = [numberOfBlocks](const std::function<void(vtkIdType, vtkIdType)>& functor)
   {
-    int index = node->GetSubOctantIndex(ds->GetPoint(ordering[i]), 0);
-    if (index)
+    if (numberOfBlocks > 1)
     {
-      points[index - 1].push_back(ordering[i]);
+      vtkSMPTools::For(0, numberOfBlocks, 1, functor);
     }
     else
     {
-      ordering[subOctantNumberOfPoints[0]] = ordering[i];
+      functor(0, numberOfBlocks);
     }
-    subOctantNumberOfPoints[index]++;
-  }
+  };
+
+  forEachBlock(
+    [&](vtkIdType beginBlock, vtkIdType endBlock)
+    {
+      double x[3];
+      for (vtkIdType block = beginBlock; block < endBlock; block++)
+      {
+        std::array<int, 8>& counts = offsets[block];
+        counts.fill(0);
+        const int end = std::min(numberOfPoints, static_cast<int>(block + 1) * blockSize);
+        for (int i = static_cast<int>(block) * blockSize; i < end; i++)
+        {
+          ds->GetPoint(ordering[i], x);
+          subOctants[i] = static_cast<unsigned char>(node->GetSubOctantIndex(x, 0));
+          counts[subOctants[i]]++;
+        }
+      }
+    });
+
+  int subOctantNumberOfPoints[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
   int counter = 0;
-  int sizeOfInt = sizeof(int);
-  for (i = 0; i < 7; i++)
+  for (int i = 0; i < 8; i++)
   {
-    counter += subOctantNumberOfPoints[i];
-    if (!points[i].empty())
+    for (std::array<int, 8>& blockOffsets : offsets)
     {
-      memcpy(ordering + counter, points[i].data(), subOctantNumberOfPoints[i + 1] * sizeOfInt);
+      const int count = blockOffsets[i];
+      blockOffsets[i] = counter;
+      counter += count;
+      subOctantNumberOfPoints[i] += count;
     }
   }
-  counter = 0;
-  for (i = 0; i < 8; i++)
+
+  std::vector<int> sorted(numberOfPoints);
+  forEachBlock(
+    [&](vtkIdType beginBlock, vtkIdType endBlock)
+    {
+      for (vtkIdType block = beginBlock; block < endBlock; block++)
+      {
+        std::array<int, 8>& blockOffsets = offsets[block];
+        const int end = std::min(numberOfPoints, static_cast<int>(block + 1) * blockSize);
+        for (int i = static_cast<int>(block) * blockSize; i < end; i++)
+        {
+          sorted[blockOffsets[subOctants[i]]++] = ordering[i];
+        }
+      }
+    });
+  std::copy(sorted.begin(), sorted.end(), ordering);
+
+  for (int i = 0; i < 8; i++)
   {
     node->GetChild(i)->SetNumberOfPoints(subOctantNumberOfPoints[i]);
-    this->DivideRegion(node->GetChild(i), ordering + counter, level + 1);
-    counter += subOctantNumberOfPoints[i];
   }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkOctreePointLocator::DivideRegionInParallel(vtkOctreePointLocatorNode* node, int* ordering)
+{
+  struct Region
+  {
+    vtkOctreePointLocatorNode* Node;
+    int* Ordering;
+    int Level;
+  };
+
+  // Divide the top of the octree breadth first until there are enough
+  // subtrees to balance the work between the threads.
+  const std::size_t minNumberOfRegions =
+    8 * static_cast<std::size_t>(vtkSMPTools::GetEstimatedNumberOfThreads());
+  std::vector<Region> regions{ { node, ordering, 0 } };
+  std::vector<Region> children;
+  while (!regions.empty() && regions.size() < minNumberOfRegions)
+  {
+    children.clear();
+    for (const Region& region : regions)
+    {
+      if (this->SplitRegion(region.Node, region.Ordering, region.Level))
+      {
+        int* childOrdering = region.Ordering;
+        for (int i = 0; i < 8; i++)
+        {
+          vtkOctreePointLocatorNode* child = region.Node->GetChild(i);
+          children.push_back({ child, childOrdering, region.Level + 1 });
+          childOrdering += child->GetNumberOfPoints();
+        }
+      }
+    }
+    regions.swap(children);
+  }
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(regions.size()), 1,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        this->DivideRegion(regions[i].Node, regions[i].Ordering, regions[i].Level);
+      }
+    });
 }
 
 //------------------------------------------------------------------------------
@@ -290,6 +491,12 @@ void vtkOctreePointLocator::BuildLocator()
     vtkDebugMacro(<< "BuildLocator exited - UseExistingSearchStructure");
     return;
   }
+  // update the octree in place if points were only appended to the data set
+  if (this->Top && this->BuildTime > this->MTime && this->InsertAppendedPoints())
+  {
+    vtkDebugMacro(<< "BuildLocator exited - appended points inserted");
+    return;
+  }
   this->BuildLocatorInternal();
 }
 
@@ -324,56 +531,9 @@ void vtkOctreePointLocator::BuildLocatorInternal()
   vtkDebugMacro(<< "Creating octree");
   this->FreeSearchStructure();
 
-  // Fix bounds - (1) push out a little if flat
-  // (2) pull back the x, y and z lower bounds a little bit so that
-  // points are clearly "inside" the spatial region.  Point p is
-  // "inside" region r = [r1, r2] if r1 < p <= r2.
-
-  double bounds[6], diff[3];
-
-  this->GetDataSet()->GetBounds(bounds);
-
-  this->MaxWidth = 0.0;
-  int i;
-  for (i = 0; i < 3; i++)
-  {
-    diff[i] = bounds[2 * i + 1] - bounds[2 * i];
-    this->MaxWidth = static_cast<float>((diff[i] > this->MaxWidth) ? diff[i] : this->MaxWidth);
-  }
-
-  if (this->CreateCubicOctants)
-  {
-    // make the bounding box have equal length sides so that all octants
-    // will also have equal length sides
-    for (i = 0; i < 3; i++)
-    {
-      if (diff[i] != this->MaxWidth)
-      {
-        double delta = this->MaxWidth - diff[i];
-        bounds[2 * i] -= .5 * delta;
-        bounds[2 * i + 1] += .5 * delta;
-        diff[i] = this->MaxWidth;
-      }
-    }
-  }
-
-  this->FudgeFactor = this->MaxWidth * 10e-6;
-
-  double aLittle = this->MaxWidth * 10e-2;
-
-  for (i = 0; i < 3; i++)
-  {
-    if (diff[i] < aLittle) // case (1) above
-    {
-      double temp = bounds[2 * i];
-      bounds[2 * i] = bounds[2 * i + 1] - aLittle;
-      bounds[2 * i + 1] = temp + aLittle;
-    }
-    else // case (2) above
-    {
-      bounds[2 * i] -= this->FudgeFactor;
-    }
-  }
+  double bounds[6];
+  ComputeRootBounds(
+    this->GetDataSet(), this->CreateCubicOctants, bounds, this->MaxWidth, this->FudgeFactor);
 
   // root node of octree - it's the whole space
 
@@ -386,32 +546,37 @@ void vtkOctreePointLocator::BuildLocatorInternal()
   node->SetDataBounds(bounds[0], bounds[1], bounds[2], bounds[3], bounds[4], bounds[5]);
 
   this->LocatorIds = new int[numPoints];
-  this->LocatorPoints = new float[3 * numPoints];
 
-  if (!this->LocatorPoints || !this->LocatorIds)
-  {
-    this->FreeSearchStructure();
-    vtkErrorMacro("vtkOctreePointLocator::BuildLocatorFromPoints - memory allocation");
-    return;
-  }
-
-  for (i = 0; i < numPoints; i++)
+  for (int i = 0; i < numPoints; i++)
   {
     this->LocatorIds[i] = i;
   }
-  this->DivideRegion(node, this->LocatorIds, 0);
+  this->DivideRegionInParallel(node, this->LocatorIds);
+  this->FinishBuild(numPoints);
+}
+
+//------------------------------------------------------------------------------
+void vtkOctreePointLocator::FinishBuild(int numPoints)
+{
   // TODO: may want to directly check if there exists a point array that
   // is of type float and directly copy that instead of dealing with
   // all of the casts
+  delete[] this->LocatorPoints;
+  this->LocatorPoints = new float[3 * numPoints];
   vtkDataSet* ds = this->GetDataSet();
-  for (i = 0; i < numPoints; i++)
-  {
-    double* pt = ds->GetPoint(this->LocatorIds[i]);
+  vtkSMPTools::For(0, numPoints,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      double pt[3];
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        ds->GetPoint(this->LocatorIds[i], pt);
 
-    this->LocatorPoints[i * 3] = static_cast<float>(pt[0]);
-    this->LocatorPoints[i * 3 + 1] = static_cast<float>(pt[1]);
-    this->LocatorPoints[i * 3 + 2] = static_cast<float>(pt[2]);
-  }
+        this->LocatorPoints[i * 3] = static_cast<float>(pt[0]);
+        this->LocatorPoints[i * 3 + 1] = static_cast<float>(pt[1]);
+        this->LocatorPoints[i * 3 + 2] = static_cast<float>(pt[2]);
+      }
+    });
 
   int nextLeafNodeId = 0;
   int nextMinId = 0;
@@ -420,11 +585,139 @@ void vtkOctreePointLocator::BuildLocatorInternal()
 
   this->NumberOfLeafNodes = nextLeafNodeId;
   int index = 0;
+  delete[] this->LeafNodeList;
   this->LeafNodeList = new vtkOctreePointLocatorNode*[this->NumberOfLeafNodes];
   this->BuildLeafNodeList(this->Top, index);
+  this->NumberOfLocatorPoints = numPoints;
+  this->Level = std::max(this->Level, ComputeDepth(this->Top));
   this->BuildTime.Modified();
 }
 
+//------------------------------------------------------------------------------
+bool vtkOctreePointLocator::InsertAppendedPoints()
+{
+  vtkDataSet* ds = this->GetDataSet();
+  const vtkIdType numPoints = ds->GetNumberOfPoints();
+  const int numOldPoints = this->NumberOfLocatorPoints;
+  if (numPoints <= numOldPoints || numPoints >= VTK_INT_MAX)
+  {
+    return false;
+  }
+
+  // The octants only depend on the bounds of the data set and on the number
+  // of points in each of them, so the octree can be updated if the bounds did
+  // not change and if the previous points are still in their octants.
+  double bounds[6], fudgeFactor;
+  float maxWidth;
+  ComputeRootBounds(ds, this->CreateCubicOctants, bounds, maxWidth, fudgeFactor);
+  const double* minBounds = this->Top->GetMinBounds();
+  const double* maxBounds = this->Top->GetMaxBounds();
+  for (int i = 0; i < 3; i++)
+  {
+    if (bounds[2 * i] != minBounds[i] || bounds[2 * i + 1] != maxBounds[i])
+    {
+      return false;
+    }
+  }
+
+  std::atomic<bool> moved(false);
+  vtkSMPTools::For(0, this->NumberOfLeafNodes,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      double pt[3];
+      for (vtkIdType leaf = begin; leaf < end && !moved; leaf++)
+      {
+        vtkOctreePointLocatorNode* node = this->LeafNodeList[leaf];
+        const double* min = node->GetMinBounds();
+        const double* max = node->GetMaxBounds();
+        const int last = node->GetMinID() + node->GetNumberOfPoints();
+        for (int i = node->GetMinID(); i < last; i++)
+        {
+          ds->GetPoint(this->LocatorIds[i], pt);
+          if (pt[0] <= min[0] || pt[0] > max[0] || pt[1] <= min[1] || pt[1] > max[1] ||
+            pt[2] <= min[2] || pt[2] > max[2])
+          {
+            moved = true;
+            break;
+          }
+        }
+      }
+    });
+  if (moved)
+  {
+    return false;
+  }
+
+  // Find the leaves containing the appended points.
+  const int numNewPoints = static_cast<int>(numPoints) - numOldPoints;
+  std::vector<int> newPointLeaves(numNewPoints);
+  vtkSMPTools::For(0, numNewPoints,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      double pt[3];
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        ds->GetPoint(numOldPoints + i, pt);
+        vtkOctreePointLocatorNode* node = this->Top;
+        while (node->GetChild(0))
+        {
+          node = node->GetChild(node->GetSubOctantIndex(pt, 0));
+        }
+        newPointLeaves[i] = node->GetID();
+      }
+    });
+
+  // Append the new points to the points of their leaves. Since their ids are
+  // larger, the points of each leaf remain sorted by id, as after a rebuild.
+  std::vector<int> numberOfNewPoints(this->NumberOfLeafNodes, 0);
+  for (int leaf : newPointLeaves)
+  {
+    numberOfNewPoints[leaf]++;
+  }
+  int* locatorIds = new int[numPoints];
+  std::vector<int> leafOffsets(this->NumberOfLeafNodes);
+  std::vector<int> nextIds(this->NumberOfLeafNodes);
+  int offset = 0;
+  for (int leaf = 0; leaf < this->NumberOfLeafNodes; leaf++)
+  {
+    vtkOctreePointLocatorNode* node = this->LeafNodeList[leaf];
+    const int numLeafPoints = node->GetNumberOfPoints();
+    std::copy(this->LocatorIds + node->GetMinID(),
+      this->LocatorIds + node->GetMinID() + numLeafPoints, locatorIds + offset);
+    leafOffsets[leaf] = offset;
+    nextIds[leaf] = offset + numLeafPoints;
+    node->SetNumberOfPoints(numLeafPoints + numberOfNewPoints[leaf]);
+    offset += node->GetNumberOfPoints();
+  }
+  for (int i = 0; i < numNewPoints; i++)
+  {
+    locatorIds[nextIds[newPointLeaves[i]]++] = numOldPoints + i;
+  }
+  delete[] this->LocatorIds;
+  this->LocatorIds = locatorIds;
+
+  // Divide the leaves that now contain too many points.
+  std::vector<int> leafLevels;
+  leafLevels.reserve(this->NumberOfLeafNodes);
+  ComputeLeafLevels(this->Top, 0, leafLevels);
+  vtkSMPTools::For(0, this->NumberOfLeafNodes,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType leaf = begin; leaf < end; leaf++)
+      {
+        if (numberOfNewPoints[leaf])
+        {
+          this->DivideRegion(
+            this->LeafNodeList[leaf], this->LocatorIds + leafOffsets[leaf], leafLevels[leaf]);
+        }
+      }
+    });
+  UpdateNumberOfPoints(this->Top);
+
+  this->FinishBuild(static_cast<int>(numPoints));
+  return true;
+}
+
 //------------------------------------------------------------------------------
 void vtkOctreePointLocator::BuildLeafNodeList(vtkOctreePointLocatorNode* node, int& index)
 {
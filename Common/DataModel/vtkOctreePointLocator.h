@@ -15,6 +15,12 @@
  * This class can also generate a PolyData representation of
  * the boundaries of the spatial regions in the decomposition.
  *
+ * The octree is built in parallel using vtkSMPTools, and the result does not
+ * depend on the number of threads. When points are appended to the dataset
+ * without changing its bounds, and the previous points remain in their
+ * octants, BuildLocator() inserts the new points in the existing octree
+ * instead of rebuilding it. The result is the same as the one of a rebuild.
+ *
  * @sa
  * vtkLocator vtkPointLocator vtkOctreePointLocatorNode
  */
@@ -223,6 +229,32 @@ protected:
 
   int DivideTest(int size, int level);
 
+  /**
+   * Divide the octant in eight if it contains too many points, and reorder
+   * the points of ordering so that the points of each child are contiguous,
+   * keeping their relative order. Return whether the octant was divided.
+   */
+  bool SplitRegion(vtkOctreePointLocatorNode* node, int* ordering, int level);
+
+  /**
+   * Divide the top of the octree serially, then the subtrees below it in
+   * parallel.
+   */
+  void DivideRegionInParallel(vtkOctreePointLocatorNode* node, int* ordering);
+
+  /**
+   * Insert the points appended to the dataset since the last build in the
+   * octree. Return false, leaving the octree untouched, if the bounds of the
+   * dataset changed or if previous points moved to other octants.
+   */
+  bool InsertAppendedPoints();
+
+  /**
+   * Compute the locator points, leaf list and node information once the
+   * octants are divided.
+   */
+  void FinishBuild(int numPoints);
+
   void AddPolys(vtkOctreePointLocatorNode* node, vtkPoints* pts, vtkCellArray* polys);
 
   /**
@@ -15,11 +15,14 @@
 #include "vtkPlane.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 
 #include <algorithm>
 #include <array>
 #include <queue>
+#include <utility>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -1436,6 +1439,214 @@ int vtkStaticCellLocator::IntersectWithLine(const double p1[3], const double p2[
   return this->Processor->IntersectWithLine(p1, p2, tol, points, cellIds, cell);
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// Return the order in which to answer batched queries: sorted by bin, so that
+// the queries answered by a thread visit neighboring bins and cells.
+std::vector<vtkIdType> SortQueriesByBin(const vtkCellBinner* binner, vtkPoints* queryPoints)
+{
+  const vtkIdType numQueries = queryPoints->GetNumberOfPoints();
+  std::vector<std::pair<vtkIdType, vtkIdType>> keys(numQueries);
+  vtkSMPTools::For(0, numQueries,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      double x[3];
+      for (vtkIdType queryId = begin; queryId < end; ++queryId)
+      {
+        queryPoints->GetPoint(queryId, x);
+        keys[queryId] = std::make_pair(binner->GetBinIndex(x), queryId);
+      }
+    });
+  vtkSMPTools::Sort(keys.begin(), keys.end());
+
+  std::vector<vtkIdType> order(numQueries);
+  std::transform(keys.begin(), keys.end(), order.begin(),
+    [](const std::pair<vtkIdType, vtkIdType>& key) { return key.second; });
+  return order;
+}
+
+// Answer batched queries concurrently in the given order, with a generic cell
+// and weights per thread. The first query is answered serially to trigger the
+// non-thread safe initialization of the dataset.
+template <typename TQuery>
+void AnswerQueriesInOrder(const std::vector<vtkIdType>& order, size_t maxCellSize, TQuery&& query)
+{
+  if (order.empty())
+  {
+    return;
+  }
+  vtkNew<vtkGenericCell> cell;
+  std::vector<double> weights(maxCellSize);
+  query(order[0], cell.GetPointer(), weights.data());
+
+  vtkSMPThreadLocalObject<vtkGenericCell> threadCell;
+  vtkSMPThreadLocal<std::vector<double>> threadWeights(weights);
+  vtkSMPTools::For(1, static_cast<vtkIdType>(order.size()),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkGenericCell* localCell = threadCell.Local();
+      double* localWeights = threadWeights.Local().data();
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        query(order[i], localCell, localWeights);
+      }
+    });
+}
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+void vtkStaticCellLocator::FindCells(
+  vtkPoints* queryPoints, double vtkNotUsed(tol2), vtkIdList* cellIds, vtkDoubleArray* pcoords)
+{
+  if (!queryPoints || !cellIds)
+  {
+    vtkErrorMacro(<< "FindCells: query points and cell ids are required");
+    return;
+  }
+  this->BuildLocator();
+  if (!this->Processor)
+  {
+    // Reports every query point as outside of the cells.
+    this->Superclass::FindCells(queryPoints, 0.0, cellIds, pcoords);
+    return;
+  }
+  const vtkIdType numQueries = queryPoints->GetNumberOfPoints();
+  cellIds->SetNumberOfIds(numQueries);
+  if (pcoords)
+  {
+    pcoords->SetNumberOfComponents(3);
+    pcoords->SetNumberOfTuples(numQueries);
+  }
+
+  AnswerQueriesInOrder(SortQueriesByBin(this->Binner, queryPoints), this->Processor->MaxCellSize,
+    [&](vtkIdType queryId, vtkGenericCell* cell, double* weights)
+    {
+      double x[3], pc[3] = { 0.0, 0.0, 0.0 };
+      int subId;
+      queryPoints->GetPoint(queryId, x);
+      cellIds->SetId(queryId, this->Processor->FindCell(x, cell, subId, pc, weights));
+      if (pcoords)
+      {
+        pcoords->SetTypedTuple(queryId, pc);
+      }
+    });
+}
+
+//------------------------------------------------------------------------------
+void vtkStaticCellLocator::FindClosestPoints(
+  vtkPoints* queryPoints, vtkIdList* cellIds, vtkPoints* closestPoints, vtkDoubleArray* dist2)
+{
+  if (!queryPoints || !cellIds)
+  {
+    vtkErrorMacro(<< "FindClosestPoints: query points and cell ids are required");
+    return;
+  }
+  this->BuildLocator();
+  if (!this->Processor)
+  {
+    // Reports no closest cell for every query point.
+    this->Superclass::FindClosestPoints(queryPoints, cellIds, closestPoints, dist2);
+    return;
+  }
+  const vtkIdType numQueries = queryPoints->GetNumberOfPoints();
+  cellIds->SetNumberOfIds(numQueries);
+  if (closestPoints)
+  {
+    closestPoints->SetNumberOfPoints(numQueries);
+  }
+  if (dist2)
+  {
+    dist2->SetNumberOfComponents(1);
+    dist2->SetNumberOfTuples(numQueries);
+  }
+
+  AnswerQueriesInOrder(SortQueriesByBin(this->Binner, queryPoints), 0,
+    [&](vtkIdType queryId, vtkGenericCell* cell, double*)
+    {
+      double x[3], closest[3], d2 = VTK_DOUBLE_MAX;
+      vtkIdType cellId = -1;
+      int subId, inside;
+      queryPoints->GetPoint(queryId, x);
+      if (!this->Processor->FindClosestPointWithinRadius(
+            x, vtkMath::Inf(), closest, cell, cellId, subId, d2, inside))
+      {
+        cellId = -1;
+      }
+      cellIds->SetId(queryId, cellId);
+      if (closestPoints)
+      {
+        closestPoints->SetPoint(queryId, cellId < 0 ? x : closest);
+      }
+      if (dist2)
+      {
+        dist2->SetValue(queryId, cellId < 0 ? VTK_DOUBLE_MAX : d2);
+      }
+    });
+}
+
+//------------------------------------------------------------------------------
+void vtkStaticCellLocator::IntersectWithLines(vtkPoints* startPoints, vtkPoints* endPoints,
+  double tol, vtkIdList* cellIds, vtkDoubleArray* ts, vtkPoints* points)
+{
+  if (!startPoints || !endPoints || !cellIds)
+  {
+    vtkErrorMacro(<< "IntersectWithLines: start points, end points and cell ids are required");
+    return;
+  }
+  const vtkIdType numLines = startPoints->GetNumberOfPoints();
+  if (endPoints->GetNumberOfPoints() != numLines)
+  {
+    vtkErrorMacro(<< "IntersectWithLines: " << numLines << " start points but "
+                  << endPoints->GetNumberOfPoints() << " end points");
+    return;
+  }
+  this->BuildLocator();
+  if (!this->Processor)
+  {
+    // Reports every segment as a miss.
+    this->Superclass::IntersectWithLines(startPoints, endPoints, tol, cellIds, ts, points);
+    return;
+  }
+  cellIds->SetNumberOfIds(numLines);
+  if (ts)
+  {
+    ts->SetNumberOfComponents(1);
+    ts->SetNumberOfTuples(numLines);
+  }
+  if (points)
+  {
+    points->SetNumberOfPoints(numLines);
+  }
+
+  AnswerQueriesInOrder(SortQueriesByBin(this->Binner, startPoints), 0,
+    [&](vtkIdType lineId, vtkGenericCell* cell, double*)
+    {
+      double p1[3], p2[3], t, x[3], pcoords[3];
+      int subId;
+      vtkIdType cellId = -1;
+      startPoints->GetPoint(lineId, p1);
+      endPoints->GetPoint(lineId, p2);
+      if (!this->Processor->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId, cell))
+      {
+        cellId = -1;
+        t = VTK_DOUBLE_MAX;
+        x[0] = p2[0];
+        x[1] = p2[1];
+        x[2] = p2[2];
+      }
+      cellIds->SetId(lineId, cellId);
+      if (ts)
+      {
+        ts->SetValue(lineId, t);
+      }
+      if (points)
+      {
+        points->SetPoint(lineId, x);
+      }
+    });
+}
+
 //------------------------------------------------------------------------------
 bool vtkStaticCellLocator::InsideCellBounds(double x[3], vtkIdType cellId)
 {
@@ -193,6 +193,20 @@ public:
   vtkIdType FindCell(double x[3], double vtkNotUsed(tol2), vtkGenericCell* GenCell, int& subId,
     double pcoords[3], double* weights) override;
 
+  ///@{
+  /**
+   * Batched queries, see vtkAbstractCellLocator. The queries are sorted by
+   * the bin containing their (start) point before being answered
+   * concurrently, so that neighboring queries visit the same bins and cells.
+   */
+  void FindCells(vtkPoints* queryPoints, double tol2, vtkIdList* cellIds,
+    vtkDoubleArray* pcoords = nullptr) override;
+  void FindClosestPoints(vtkPoints* queryPoints, vtkIdList* cellIds,
+    vtkPoints* closestPoints = nullptr, vtkDoubleArray* dist2 = nullptr) override;
+  void IntersectWithLines(vtkPoints* startPoints, vtkPoints* endPoints, double tol,
+    vtkIdList* cellIds, vtkDoubleArray* ts = nullptr, vtkPoints* points = nullptr) override;
+  ///@}
+
   /**
    * Quickly test if a point is inside the bounds of a particular cell.
    * This function should be used ONLY after the locator is built.
@@ -8,6 +8,7 @@
 #include "vtkDataArray.h"
 #include "vtkDoubleArray.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkLine.h"
 #include "vtkLocatorInterface.h"
 #include "vtkMath.h"
@@ -15,6 +16,7 @@
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 #include "vtkStructuredData.h"
 
@@ -25,6 +27,8 @@
 // file.
 #include "vtkStaticPointLocatorPrivate.h"
 
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -1884,6 +1888,136 @@ void vtkStaticPointLocator::FindClosestNPoints(int N, const double x[3], vtkIdLi
   }
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// Return the order in which to answer batched queries: sorted by bucket, so
+// that the queries answered by a thread visit neighboring buckets and points.
+std::vector<vtkIdType> SortQueriesByBucket(const vtkBucketList* buckets, vtkPoints* queryPoints)
+{
+  const vtkIdType numQueries = queryPoints->GetNumberOfPoints();
+  std::vector<std::pair<vtkIdType, vtkIdType>> keys(numQueries);
+  vtkSMPTools::For(0, numQueries,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      double x[3];
+      for (vtkIdType queryId = begin; queryId < end; ++queryId)
+      {
+        queryPoints->GetPoint(queryId, x);
+        keys[queryId] = std::make_pair(buckets->GetBucketIndex(x), queryId);
+      }
+    });
+  vtkSMPTools::Sort(keys.begin(), keys.end());
+
+  std::vector<vtkIdType> order(numQueries);
+  std::transform(keys.begin(), keys.end(), order.begin(),
+    [](const std::pair<vtkIdType, vtkIdType>& key) { return key.second; });
+  return order;
+}
+
+template <typename TIds>
+void FindClosestPointsInOrder(BucketList<TIds>* buckets, vtkPoints* queryPoints,
+  const std::vector<vtkIdType>& order, vtkIdList* result)
+{
+  vtkSMPTools::For(0, static_cast<vtkIdType>(order.size()),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      double x[3];
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const vtkIdType queryId = order[i];
+        queryPoints->GetPoint(queryId, x);
+        result->SetId(queryId, buckets->FindClosestPoint(x));
+      }
+    });
+}
+
+template <typename TIds>
+void FindClosestNPointsInOrder(BucketList<TIds>* buckets, int N, vtkPoints* queryPoints,
+  const std::vector<vtkIdType>& order, vtkIdTypeArray* result)
+{
+  vtkSMPThreadLocalObject<vtkIdList> threadIds;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(order.size()),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdList* ids = threadIds.Local();
+      double x[3];
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const vtkIdType queryId = order[i];
+        queryPoints->GetPoint(queryId, x);
+        buckets->FindClosestNPoints(N, x, ids);
+        const vtkIdType numIds = std::min<vtkIdType>(N, ids->GetNumberOfIds());
+        vtkIdType* tuple = result->GetPointer(queryId * N);
+        std::copy_n(ids->GetPointer(0), numIds, tuple);
+        std::fill(tuple + numIds, tuple + N, -1);
+      }
+    });
+}
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+void vtkStaticPointLocator::FindClosestPoints(vtkPoints* queryPoints, vtkIdList* result)
+{
+  if (!queryPoints || !result)
+  {
+    vtkErrorMacro(<< "FindClosestPoints: query points and result are required");
+    return;
+  }
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  const vtkIdType numQueries = queryPoints->GetNumberOfPoints();
+  result->SetNumberOfIds(numQueries);
+  if (!this->Buckets)
+  {
+    std::fill_n(result->GetPointer(0), numQueries, -1);
+    return;
+  }
+
+  const std::vector<vtkIdType> order = SortQueriesByBucket(this->Buckets, queryPoints);
+  if (this->LargeIds)
+  {
+    FindClosestPointsInOrder(
+      static_cast<BucketList<vtkIdType>*>(this->Buckets), queryPoints, order, result);
+  }
+  else
+  {
+    FindClosestPointsInOrder(
+      static_cast<BucketList<int>*>(this->Buckets), queryPoints, order, result);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkStaticPointLocator::FindClosestPoints(
+  int N, vtkPoints* queryPoints, vtkIdTypeArray* result)
+{
+  if (!queryPoints || !result || N < 1)
+  {
+    vtkErrorMacro(<< "FindClosestPoints: query points, result and N > 0 are required");
+    return;
+  }
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  const vtkIdType numQueries = queryPoints->GetNumberOfPoints();
+  result->SetNumberOfComponents(N);
+  result->SetNumberOfTuples(numQueries);
+  if (!this->Buckets)
+  {
+    result->Fill(-1);
+    return;
+  }
+
+  const std::vector<vtkIdType> order = SortQueriesByBucket(this->Buckets, queryPoints);
+  if (this->LargeIds)
+  {
+    FindClosestNPointsInOrder(
+      static_cast<BucketList<vtkIdType>*>(this->Buckets), N, queryPoints, order, result);
+  }
+  else
+  {
+    FindClosestNPointsInOrder(
+      static_cast<BucketList<int>*>(this->Buckets), N, queryPoints, order, result);
+  }
+}
+
 //------------------------------------------------------------------------------
 double vtkStaticPointLocator::FindNPointsInShell(int N, const double x[3],
   vtkDist2TupleArray& results, double minDist2, bool sort, vtkDoubleArray* petals)
@@ -145,6 +145,17 @@ public:
    */
   void FindClosestNPoints(int N, const double x[3], vtkIdList* result) override;
 
+  ///@{
+  /**
+   * Batched versions of FindClosestPoint() and FindClosestNPoints(), see
+   * vtkAbstractPointLocator. The queries are sorted by bucket before being
+   * answered concurrently, so that neighboring queries visit the same
+   * buckets and points.
+   */
+  void FindClosestPoints(vtkPoints* queryPoints, vtkIdList* result) override;
+  void FindClosestPoints(int N, vtkPoints* queryPoints, vtkIdTypeArray* result) override;
+  ///@}
+
   /**
    * Find approximately N close points which are strictly greater than
    * >minDist2 away from the query point x (minDist2 is the square of the
@@ -378,6 +378,13 @@ void vtkUnstructuredGrid::GetCell(vtkIdType cellId, vtkGenericCell* cell)
   this->Connectivity->GetCellAtId(cellId, cell->PointIds);
   this->Points->GetPoints(cell->PointIds, cell->Points);
 
+  // Fast path for the linear cells, which need no faces, initialization,
+  // order or weights. This skips several virtual calls per cell.
+  if (cellType < VTK_QUADRATIC_EDGE)
+  {
+    return;
+  }
+
   // Explicit face representation
   if (cell->RequiresExplicitFaceRepresentation())
   {
@@ -11,6 +11,10 @@
  * (e.g., triangles, polygons), and 3D (e.g., hexahedron, tetrahedron,
  * polyhedron, etc.). vtkUnstructuredGrid provides random access to cells, as
  * well as topological information (such as lists of cells using each point).
+ *
+ * To process all the cells of a given type without copying their points
+ * through vtkGenericCell, see vtk::ForEachCellOfType() in
+ * vtkForEachCellOfType.h.
  */
 
 #ifndef vtkUnstructuredGrid_h
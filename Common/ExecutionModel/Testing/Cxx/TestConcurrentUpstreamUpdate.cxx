@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkAppendPolyData.h"
+#include "vtkCommand.h"
+#include "vtkElevationFilter.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSMPTools.h"
+#include "vtkSphereSource.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace
+{
+// Count the executions of the observed algorithms.
+class ExecutionCounter : public vtkCommand
+{
+public:
+  static ExecutionCounter* New() { return new ExecutionCounter; }
+  void Execute(vtkObject*, unsigned long, void*) override { ++this->Count; }
+  std::atomic<int> Count{ 0 };
+};
+
+// A source recording how many sources of the same group execute at the same
+// time. When WaitForOverlap is on, each execution waits a little for another
+// one to start, so that executions overlap whenever the branches are updated
+// concurrently.
+class InFlightSource : public vtkPolyDataAlgorithm
+{
+public:
+  static InFlightSource* New();
+  vtkTypeMacro(InFlightSource, vtkPolyDataAlgorithm);
+
+  std::atomic<int>* InFlight = nullptr;
+  std::atomic<int>* PeakInFlight = nullptr;
+  bool WaitForOverlap = false;
+
+protected:
+  InFlightSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override
+  {
+    const int inFlight = ++*this->InFlight;
+    int peak = *this->PeakInFlight;
+    while (inFlight > peak && !this->PeakInFlight->compare_exchange_weak(peak, inFlight))
+    {
+    }
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (this->WaitForOverlap && *this->InFlight < 2 &&
+      std::chrono::steady_clock::now() < timeout)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    --*this->InFlight;
+    return 1;
+  }
+};
+vtkStandardNewMacro(InFlightSource);
+
+void EnableConcurrentUpdate(vtkAlgorithm* algorithm)
+{
+  vtkStreamingDemandDrivenPipeline::SafeDownCast(algorithm->GetExecutive())
+    ->ConcurrentUpstreamUpdateOn();
+}
+}
+
+int TestConcurrentUpstreamUpdate(int, char*[])
+{
+  vtkNew<ExecutionCounter> counter;
+
+  // Independent branches: each sphere goes through its own elevation filter.
+  constexpr int nbBranches = 6;
+  vtkIdType expectedNumberOfPoints = 0;
+  vtkNew<vtkAppendPolyData> append;
+  EnableConcurrentUpdate(append);
+  for (int i = 0; i < nbBranches; ++i)
+  {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetThetaResolution(16 + 4 * i);
+    sphere->SetPhiResolution(16 + 4 * i);
+    sphere->AddObserver(vtkCommand::StartEvent, counter);
+    sphere->Update();
+    expectedNumberOfPoints += sphere->GetOutput()->GetNumberOfPoints();
+    sphere->Modified();
+
+    vtkNew<vtkElevationFilter> elevation;
+    elevation->SetInputConnection(sphere->GetOutputPort());
+    elevation->AddObserver(vtkCommand::StartEvent, counter);
+    append->AddInputConnection(elevation->GetOutputPort());
+  }
+  counter->Count = 0;
+  append->Update();
+
+  if (append->GetOutput()->GetNumberOfPoints() != expectedNumberOfPoints)
+  {
+    vtkLog(ERROR,
+      "Wrong number of points: " << append->GetOutput()->GetNumberOfPoints() << " instead of "
+                                 << expectedNumberOfPoints);
+    return EXIT_FAILURE;
+  }
+  if (counter->Count != 2 * nbBranches)
+  {
+    vtkLog(ERROR, "Wrong number of executions: " << counter->Count << " instead of "
+                                                 << 2 * nbBranches);
+    return EXIT_FAILURE;
+  }
+
+  // Nothing is modified: nothing must execute again.
+  counter->Count = 0;
+  append->Update();
+  if (counter->Count != 0)
+  {
+    vtkLog(ERROR, "Up-to-date branches were executed again.");
+    return EXIT_FAILURE;
+  }
+
+  // Branches sharing a source must not update it concurrently, and the shared
+  // source must only execute once.
+  vtkNew<ExecutionCounter> sharedCounter;
+  vtkNew<vtkSphereSource> sharedSphere;
+  sharedSphere->AddObserver(vtkCommand::StartEvent, sharedCounter);
+  vtkNew<vtkAppendPolyData> diamond;
+  EnableConcurrentUpdate(diamond);
+  for (int i = 0; i < 4; ++i)
+  {
+    vtkNew<vtkElevationFilter> elevation;
+    elevation->SetInputConnection(sharedSphere->GetOutputPort());
+    diamond->AddInputConnection(elevation->GetOutputPort());
+  }
+  // And one more independent branch.
+  vtkNew<vtkSphereSource> otherSphere;
+  diamond->AddInputConnection(otherSphere->GetOutputPort());
+  diamond->Update();
+
+  if (sharedCounter->Count != 1)
+  {
+    vtkLog(ERROR, "Shared source executed " << sharedCounter->Count << " times.");
+    return EXIT_FAILURE;
+  }
+  sharedSphere->Update();
+  otherSphere->Update();
+  if (diamond->GetOutput()->GetNumberOfPoints() !=
+    4 * sharedSphere->GetOutput()->GetNumberOfPoints() +
+      otherSphere->GetOutput()->GetNumberOfPoints())
+  {
+    vtkLog(ERROR, "Wrong number of points for the pipeline with a shared source.");
+    return EXIT_FAILURE;
+  }
+
+  // The independent branches must actually execute at the same time, when
+  // several threads are available.
+  std::atomic<int> inFlight(0);
+  std::atomic<int> peakInFlight(0);
+  const bool concurrent = std::string(vtkSMPTools::GetBackend()) != "Sequential" &&
+    vtkSMPTools::GetEstimatedNumberOfThreads() > 1;
+  vtkNew<vtkAppendPolyData> fanIn;
+  EnableConcurrentUpdate(fanIn);
+  for (int i = 0; i < 4; ++i)
+  {
+    vtkNew<InFlightSource> source;
+    source->InFlight = &inFlight;
+    source->PeakInFlight = &peakInFlight;
+    source->WaitForOverlap = concurrent;
+    fanIn->AddInputConnection(source->GetOutputPort());
+  }
+  fanIn->Update();
+  if (concurrent && peakInFlight < 2)
+  {
+    vtkLog(ERROR, "The independent branches were not updated concurrently.");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
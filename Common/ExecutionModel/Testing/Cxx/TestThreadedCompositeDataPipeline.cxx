@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that vtkThreadedCompositeDataPipeline executes the blocks of a
+// composite input concurrently and collects all their outputs.
+
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSMPTools.h"
+#include "vtkThreadedCompositeDataPipeline.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace
+{
+// Pass the input through, recording how many executions are in flight. When
+// WaitForOverlap is on, each execution waits a little for another one to
+// start, so that executions overlap whenever the executive runs them
+// concurrently.
+class InFlightCounter : public vtkPolyDataAlgorithm
+{
+public:
+  static InFlightCounter* New();
+  vtkTypeMacro(InFlightCounter, vtkPolyDataAlgorithm);
+
+  std::atomic<int> InFlight{ 0 };
+  std::atomic<int> PeakInFlight{ 0 };
+  bool WaitForOverlap = false;
+
+protected:
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override
+  {
+    const int inFlight = ++this->InFlight;
+    int peak = this->PeakInFlight;
+    while (inFlight > peak && !this->PeakInFlight.compare_exchange_weak(peak, inFlight))
+    {
+    }
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (this->WaitForOverlap && this->InFlight < 2 &&
+      std::chrono::steady_clock::now() < timeout)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    vtkPolyData::GetData(outputVector)->ShallowCopy(vtkPolyData::GetData(inputVector[0]));
+    --this->InFlight;
+    return 1;
+  }
+};
+vtkStandardNewMacro(InFlightCounter);
+}
+
+int TestThreadedCompositeDataPipeline(int, char*[])
+{
+  constexpr unsigned int nbBlocks = 8;
+  vtkNew<vtkMultiBlockDataSet> input;
+  for (unsigned int i = 0; i < nbBlocks; ++i)
+  {
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(i + 1);
+    vtkNew<vtkPolyData> block;
+    block->SetPoints(points);
+    input->SetBlock(i, block);
+  }
+
+  vtkNew<InFlightCounter> counter;
+  vtkNew<vtkThreadedCompositeDataPipeline> executive;
+  counter->SetExecutive(executive);
+  counter->SetInputDataObject(input);
+  // Blocks can only overlap if several threads are available.
+  const bool concurrent = std::string(vtkSMPTools::GetBackend()) != "Sequential" &&
+    vtkSMPTools::GetEstimatedNumberOfThreads() > 1;
+  counter->WaitForOverlap = concurrent;
+  counter->Update();
+
+  auto output = vtkMultiBlockDataSet::SafeDownCast(counter->GetOutputDataObject(0));
+  if (!output || output->GetNumberOfBlocks() != nbBlocks)
+  {
+    vtkLog(ERROR, "Wrong output structure.");
+    return EXIT_FAILURE;
+  }
+  for (unsigned int i = 0; i < nbBlocks; ++i)
+  {
+    auto block = vtkPolyData::SafeDownCast(output->GetBlock(i));
+    if (!block || block->GetNumberOfPoints() != static_cast<vtkIdType>(i + 1))
+    {
+      vtkLog(ERROR, "Wrong output for block " << i);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (concurrent && counter->PeakInFlight < 2)
+  {
+    vtkLog(ERROR, "The blocks were not executed concurrently.");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -13,10 +13,16 @@
 #include "vtkInformationIterator.h"
 #include "vtkInformationKeyVectorKey.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTaskGraph.h"
 #include "vtkSmartPointer.h"
 
+#include <algorithm>
+#include <numeric>
+#include <set>
 #include <sstream>
+#include <utility>
 #include <vector>
 
 #include "vtkCompositeDataPipeline.h"
@@ -579,7 +585,111 @@ int vtkExecutive::ForwardUpstream(vtkInformation* request)
   }
 
   // Forward the request upstream through all input connections.
-  int result = 1;
+  int result = this->ForwardUpstreamToProducers(request);
+
+  if (!this->Algorithm->ModifyRequest(request, AfterForward))
+  {
+    return 0;
+  }
+
+  return result;
+}
+
+//------------------------------------------------------------------------------
+namespace
+{
+using ProducerType = std::pair<vtkExecutive*, int>;
+
+// Collect the executive and all the executives upstream of it.
+std::set<vtkExecutive*> CollectUpstreamExecutives(vtkExecutive* executive)
+{
+  std::set<vtkExecutive*> executives;
+  std::vector<vtkExecutive*> stack{ executive };
+  while (!stack.empty())
+  {
+    vtkExecutive* current = stack.back();
+    stack.pop_back();
+    if (!current || !executives.insert(current).second)
+    {
+      continue;
+    }
+    for (int i = 0; i < current->GetNumberOfInputPorts(); ++i)
+    {
+      for (int j = 0; j < current->GetNumberOfInputConnections(i); ++j)
+      {
+        stack.push_back(current->GetInputExecutive(i, j));
+      }
+    }
+  }
+  return executives;
+}
+
+bool Intersects(const std::set<vtkExecutive*>& a, const std::set<vtkExecutive*>& b)
+{
+  const auto& smallest = a.size() < b.size() ? a : b;
+  const auto& largest = a.size() < b.size() ? b : a;
+  return std::any_of(smallest.begin(), smallest.end(),
+    [&largest](vtkExecutive* executive) { return largest.count(executive) != 0; });
+}
+
+// Group the producers in branches: two producers belong to the same branch when
+// their upstream pipelines share at least one executive. Producers keep their
+// original order inside a branch.
+std::vector<std::vector<std::size_t>> GroupIndependentBranches(
+  const std::vector<ProducerType>& producers)
+{
+  const std::size_t nbProducers = producers.size();
+  std::vector<std::set<vtkExecutive*>> upstream(nbProducers);
+  for (std::size_t k = 0; k < nbProducers; ++k)
+  {
+    upstream[k] = ::CollectUpstreamExecutives(producers[k].first);
+  }
+
+  std::vector<std::size_t> parent(nbProducers);
+  std::iota(parent.begin(), parent.end(), 0);
+  auto find = [&parent](std::size_t k)
+  {
+    while (parent[k] != k)
+    {
+      k = parent[k] = parent[parent[k]];
+    }
+    return k;
+  };
+  for (std::size_t a = 0; a < nbProducers; ++a)
+  {
+    for (std::size_t b = a + 1; b < nbProducers; ++b)
+    {
+      std::size_t rootA = find(a);
+      std::size_t rootB = find(b);
+      if (rootA != rootB && ::Intersects(upstream[a], upstream[b]))
+      {
+        parent[std::max(rootA, rootB)] = std::min(rootA, rootB);
+      }
+    }
+  }
+
+  std::vector<std::vector<std::size_t>> branches;
+  std::vector<std::size_t> branchOfRoot(nbProducers, nbProducers);
+  for (std::size_t k = 0; k < nbProducers; ++k)
+  {
+    std::size_t root = find(k);
+    if (branchOfRoot[root] == nbProducers)
+    {
+      branchOfRoot[root] = branches.size();
+      branches.emplace_back();
+    }
+    branches[branchOfRoot[root]].push_back(k);
+  }
+  return branches;
+}
+}
+
+//------------------------------------------------------------------------------
+int vtkExecutive::ForwardUpstreamToProducers(vtkInformation* request)
+{
+  // Get the executives producing the inputs.  If there is none, then it is a
+  // nullptr input.
+  std::vector<ProducerType> producers;
   for (int i = 0; i < this->GetNumberOfInputPorts(); ++i)
   {
     int nic = this->Algorithm->GetNumberOfInputConnections(i);
@@ -587,30 +697,78 @@ int vtkExecutive::ForwardUpstream(vtkInformation* request)
     for (int j = 0; j < nic; ++j)
     {
       vtkInformation* info = inVector->GetInformationObject(j);
-      // Get the executive producing this input.  If there is none, then
-      // it is a nullptr input.
       vtkExecutive* e;
       int producerPort;
       vtkExecutive::PRODUCER()->Get(info, e, producerPort);
       if (e)
       {
-        int port = request->Get(FROM_OUTPUT_PORT());
-        request->Set(FROM_OUTPUT_PORT(), producerPort);
-        if (!e->ProcessRequest(request, e->GetInputInformation(), e->GetOutputInformation()))
-        {
-          result = 0;
-        }
-        request->Set(FROM_OUTPUT_PORT(), port);
+        producers.emplace_back(e, producerPort);
       }
     }
   }
 
-  if (!this->Algorithm->ModifyRequest(request, AfterForward))
+  std::vector<std::vector<std::size_t>> branches;
+  if (producers.size() > 1 && this->CanForwardUpstreamConcurrently(request))
   {
-    return 0;
+    branches = ::GroupIndependentBranches(producers);
   }
 
-  return result;
+  if (branches.size() <= 1)
+  {
+    int result = 1;
+    for (const auto& producer : producers)
+    {
+      int port = request->Get(FROM_OUTPUT_PORT());
+      request->Set(FROM_OUTPUT_PORT(), producer.second);
+      if (!producer.first->ProcessRequest(
+            request, producer.first->GetInputInformation(), producer.first->GetOutputInformation()))
+      {
+        result = 0;
+      }
+      request->Set(FROM_OUTPUT_PORT(), port);
+    }
+    return result;
+  }
+
+  // Independent branches do not share any executive, hence any information
+  // object. The request is the only shared state: give each branch its own copy.
+  const std::size_t nbBranches = branches.size();
+  std::vector<vtkSmartPointer<vtkInformation>> requests(nbBranches);
+  std::vector<int> results(nbBranches, 1);
+  vtkNew<vtkSMPTaskGraph> graph;
+  for (std::size_t b = 0; b < nbBranches; ++b)
+  {
+    requests[b] = vtkSmartPointer<vtkInformation>::New();
+    requests[b]->Copy(request);
+    // The request key itself is not an entry of the map copied above.
+    requests[b]->SetRequest(request->GetRequest());
+    graph->AddTask(
+      [&, b]()
+      {
+        vtkInformation* branchRequest = requests[b];
+        for (std::size_t k : branches[b])
+        {
+          vtkExecutive* e = producers[k].first;
+          branchRequest->Set(FROM_OUTPUT_PORT(), producers[k].second);
+          if (!e->ProcessRequest(
+                branchRequest, e->GetInputInformation(), e->GetOutputInformation()))
+          {
+            results[b] = 0;
+          }
+        }
+      });
+  }
+  graph->Execute();
+
+  const bool success =
+    std::all_of(results.begin(), results.end(), [](int result) { return result != 0; });
+  return success ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+bool vtkExecutive::CanForwardUpstreamConcurrently(vtkInformation*)
+{
+  return false;
 }
 
 //------------------------------------------------------------------------------
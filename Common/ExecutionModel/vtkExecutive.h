@@ -247,6 +247,23 @@ protected:
 
   virtual int ForwardDownstream(vtkInformation* request);
   virtual int ForwardUpstream(vtkInformation* request);
+
+  /**
+   * Send the request to the executives producing the inputs of the algorithm,
+   * as done by ForwardUpstream(). When CanForwardUpstreamConcurrently()
+   * returns true, the inputs whose upstream pipelines do not share any
+   * executive are processed concurrently, each with its own copy of the
+   * request. Inputs sharing an upstream executive are processed in order by
+   * the same task.
+   */
+  int ForwardUpstreamToProducers(vtkInformation* request);
+
+  /**
+   * Return true if independent upstream branches may be processed
+   * concurrently for this request. Returns false by default.
+   */
+  virtual bool CanForwardUpstreamConcurrently(vtkInformation* request);
+
   virtual void CopyDefaultInformation(vtkInformation* request, int direction,
     vtkInformationVector** inInfo, vtkInformationVector* outInfo);
 
@@ -115,6 +115,7 @@ vtkStreamingDemandDrivenPipeline::~vtkStreamingDemandDrivenPipeline()
 void vtkStreamingDemandDrivenPipeline::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "ConcurrentUpstreamUpdate: " << this->ConcurrentUpstreamUpdate << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -679,6 +680,14 @@ void vtkStreamingDemandDrivenPipeline ::ResetPipelineInformation(int port, vtkIn
   info->Remove(vtkAlgorithm::CAN_PRODUCE_SUB_EXTENT());
 }
 
+//------------------------------------------------------------------------------
+bool vtkStreamingDemandDrivenPipeline::CanForwardUpstreamConcurrently(vtkInformation* request)
+{
+  // Only the data request is worth running concurrently, the other passes are
+  // cheap and some of them combine information coming from all the inputs.
+  return this->ConcurrentUpstreamUpdate && request->Has(REQUEST_DATA());
+}
+
 //------------------------------------------------------------------------------
 int vtkStreamingDemandDrivenPipeline::PropagateUpdateExtent(int outputPort)
 {
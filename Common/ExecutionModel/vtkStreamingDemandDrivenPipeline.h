@@ -278,6 +278,27 @@ public:
   static int GetUpdateGhostLevel(vtkInformation*);
   ///@}
 
+  ///@{
+  /**
+   * When enabled, the data request updates the inputs of the algorithm that
+   * come from independent upstream pipelines concurrently, using
+   * vtkSMPTaskGraph and the current vtkSMPTools backend. Two inputs are
+   * independent when their upstream pipelines do not share any algorithm.
+   * This is typically useful for algorithms with several inputs such as
+   * vtkAppendFilter or vtkMergeFilter fed by several readers.
+   *
+   * Only the executive of the algorithm with several inputs needs this
+   * option. The algorithms of the independent branches must be safe to
+   * execute at the same time: they must not share any object that is
+   * modified during execution.
+   *
+   * Default is false.
+   */
+  vtkSetMacro(ConcurrentUpstreamUpdate, bool);
+  vtkGetMacro(ConcurrentUpstreamUpdate, bool);
+  vtkBooleanMacro(ConcurrentUpstreamUpdate, bool);
+  ///@}
+
 protected:
   vtkStreamingDemandDrivenPipeline();
   ~vtkStreamingDemandDrivenPipeline() override;
@@ -328,6 +349,9 @@ protected:
   // Remove update/whole extent when resetting pipeline information.
   void ResetPipelineInformation(int port, vtkInformation*) override;
 
+  // Allow concurrent update of independent inputs for data requests.
+  bool CanForwardUpstreamConcurrently(vtkInformation* request) override;
+
   // Flag for when an algorithm returns with CONTINUE_EXECUTING in the
   // request.
   int ContinueExecuting;
@@ -340,6 +364,8 @@ protected:
   // did the most recent PUE do anything ?
   int LastPropogateUpdateExtentShortCircuited;
 
+  bool ConcurrentUpstreamUpdate = false;
+
 private:
   vtkStreamingDemandDrivenPipeline(const vtkStreamingDemandDrivenPipeline&) = delete;
   void operator=(const vtkStreamingDemandDrivenPipeline&) = delete;
@@ -24,9 +24,9 @@
 #include "vtkTimerLog.h"
 
 #include "vtkSMPProgressObserver.h"
+#include "vtkSMPTaskGraph.h"
 #include "vtkSMPThreadLocal.h"
 #include "vtkSMPThreadLocalObject.h"
-#include "vtkSMPTools.h"
 
 #include <cassert>
 #include <vector>
@@ -150,27 +150,27 @@ public:
     request->Copy(this->Request, 1);
   }
 
-  void operator()(vtkIdType begin, vtkIdType end)
+  void Execute(vtkIdType i)
   {
+    // The information objects are cloned the first time a thread runs a block.
+    if (!this->InInfoVecs.Local())
+    {
+      this->Initialize();
+    }
     vtkInformationVector** inInfoVec = this->InInfoVecs.Local();
     vtkInformationVector* outInfoVec = this->OutInfoVecs.Local();
     vtkInformation* request = this->Requests.Local();
 
     vtkInformation* inInfo = inInfoVec[this->CompositePort]->GetInformationObject(this->Connection);
 
-    for (vtkIdType i = begin; i < end; ++i)
+    std::vector<vtkDataObject*> outObjList = this->Exec->ExecuteSimpleAlgorithmForBlock(
+      &inInfoVec[0], outInfoVec, inInfo, request, this->InObjs[i]);
+    for (int j = 0; j < outInfoVec->GetNumberOfInformationObjects(); ++j)
     {
-      std::vector<vtkDataObject*> outObjList = this->Exec->ExecuteSimpleAlgorithmForBlock(
-        &inInfoVec[0], outInfoVec, inInfo, request, this->InObjs[i]);
-      for (int j = 0; j < outInfoVec->GetNumberOfInformationObjects(); ++j)
-      {
-        this->OutObjs[i * outInfoVec->GetNumberOfInformationObjects() + j] = outObjList[j];
-      }
+      this->OutObjs[i * outInfoVec->GetNumberOfInformationObjects() + j] = outObjList[j];
     }
   }
 
-  void Reduce() {}
-
 protected:
   vtkThreadedCompositeDataPipeline* Exec;
   vtkInformationVector** InInfoVec;
@@ -235,7 +235,14 @@ void vtkThreadedCompositeDataPipeline::ExecuteEach(vtkCompositeDataIterator* ite
   vtkSmartPointer<vtkProgressObserver> origPo(this->Algorithm->GetProgressObserver());
   vtkNew<vtkSMPProgressObserver> po;
   this->Algorithm->SetProgressObserver(po);
-  vtkSMPTools::For(0, static_cast<vtkIdType>(inObjs.size()), processBlock);
+  // One task per block: idle threads steal the remaining blocks, which
+  // balances blocks of very different sizes.
+  vtkNew<vtkSMPTaskGraph> graph;
+  for (vtkIdType i = 0; i < static_cast<vtkIdType>(inObjs.size()); ++i)
+  {
+    graph->AddTask([&processBlock, i]() { processBlock.Execute(i); });
+  }
+  graph->Execute();
   this->Algorithm->SetProgressObserver(origPo);
 
   int i = 0;
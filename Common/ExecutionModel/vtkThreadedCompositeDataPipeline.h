@@ -6,11 +6,12 @@
  *
  * vtkThreadedCompositeDataPipeline processes a composite data object in
  * parallel using the SMP framework. It does this by creating a vector of
- * data objects (the pieces of the composite data) and processing them
- * using vtkSMPTools::For. Note that this requires that the
- * algorithm implement all pipeline passes in a re-entrant way. It should
- * store/retrieve all state changes using input and output information
- * objects, which are unique to each thread.
+ * data objects (the pieces of the composite data) and processing each of
+ * them in its own vtkSMPTaskGraph task, so that idle threads pick up the
+ * remaining pieces when the pieces have different sizes. Note that this
+ * requires that the algorithm implement all pipeline passes in a re-entrant
+ * way. It should store/retrieve all state changes using input and output
+ * information objects, which are unique to each thread.
  */
 
 #ifndef vtkThreadedCompositeDataPipeline_h
@@ -0,0 +1,187 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the threaded implementation of vtkCleanPolyData produces the same
+// output as the sequential one.
+
+#include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
+#include "vtkCellData.h"
+#include "vtkCleanPolyData.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cstdlib>
+
+namespace
+{
+// Build a polydata where each cell has its own points, like a STL file, with
+// unused points and cells that degenerate once points are merged.
+vtkSmartPointer<vtkPolyData> CreateInput(double jitter, bool withGhosts, bool withGlobalIds)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(32);
+  sphere->SetPhiResolution(16);
+  sphere->Update();
+  vtkPolyData* spherePD = sphere->GetOutput();
+
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  vtkNew<vtkDoubleArray> index;
+  index->SetName("Index");
+  vtkNew<vtkIdTypeArray> globalIds;
+  globalIds->SetName("GlobalIds");
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+
+  auto addPoint = [&](vtkIdType spherePtId)
+  {
+    double x[3];
+    spherePD->GetPoint(spherePtId, x);
+    const vtkIdType ptId = points->GetNumberOfPoints();
+    for (int i = 0; i < 3; ++i)
+    {
+      x[i] += jitter * ((ptId * (i + 1)) % 7 - 3);
+    }
+    points->InsertNextPoint(x);
+    index->InsertNextValue(ptId);
+    globalIds->InsertNextValue(spherePtId);
+    ghosts->InsertNextValue(ptId % 5 == 0 ? vtkDataSetAttributes::DUPLICATEPOINT : 0);
+    return ptId;
+  };
+
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkCellArray> strips;
+
+  // A few unused points.
+  addPoint(0);
+  addPoint(7);
+
+  // Polygons, each one with its own points.
+  const vtkIdType* pts;
+  vtkIdType npts;
+  auto sphereIter = vtk::TakeSmartPointer(spherePD->GetPolys()->NewIterator());
+  for (sphereIter->GoToFirstCell(); !sphereIter->IsDoneWithTraversal();
+       sphereIter->GoToNextCell())
+  {
+    sphereIter->GetCurrentCell(npts, pts);
+    polys->InsertNextCell(static_cast<int>(npts));
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      polys->InsertCellPoint(addPoint(pts[i]));
+    }
+  }
+  // Degenerate polygons: becomes a line, a vertex, and a triangle.
+  polys->InsertNextCell({ addPoint(3), addPoint(3), addPoint(4) });
+  polys->InsertNextCell({ addPoint(5), addPoint(5), addPoint(5) });
+  polys->InsertNextCell({ addPoint(6), addPoint(9), addPoint(6), addPoint(10) });
+
+  // Vertices, with duplicates.
+  verts->InsertNextCell({ addPoint(1), addPoint(1), addPoint(2) });
+  verts->InsertNextCell({ addPoint(11) });
+
+  // Lines: a polyline with consecutive duplicates and a degenerate line.
+  lines->InsertNextCell({ addPoint(12), addPoint(12), addPoint(13), addPoint(14) });
+  lines->InsertNextCell({ addPoint(15), addPoint(15) });
+
+  // Strips: a proper one, one becoming a polygon and one becoming a line.
+  strips->InsertNextCell({ addPoint(20), addPoint(21), addPoint(22), addPoint(23), addPoint(24) });
+  strips->InsertNextCell({ addPoint(25), addPoint(26), addPoint(26), addPoint(27) });
+  strips->InsertNextCell({ addPoint(28), addPoint(29), addPoint(29), addPoint(28) });
+
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  input->SetVerts(verts);
+  input->SetLines(lines);
+  input->SetPolys(polys);
+  input->SetStrips(strips);
+  input->GetPointData()->AddArray(index);
+  if (withGlobalIds)
+  {
+    input->GetPointData()->SetGlobalIds(globalIds);
+  }
+  if (withGhosts)
+  {
+    input->GetPointData()->AddArray(ghosts);
+  }
+
+  vtkNew<vtkDoubleArray> cellIndex;
+  cellIndex->SetName("CellIndex");
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId)
+  {
+    cellIndex->InsertNextValue(cellId);
+  }
+  input->GetCellData()->AddArray(cellIndex);
+  return input;
+}
+
+bool TestConfiguration(vtkPolyData* input, const char* name,
+  void (*configure)(vtkCleanPolyData*) = [](vtkCleanPolyData*) {})
+{
+  vtkNew<vtkCleanPolyData> sequential;
+  sequential->SetInputData(input);
+  configure(sequential);
+  sequential->Update();
+
+  vtkNew<vtkCleanPolyData> threaded;
+  threaded->SetInputData(input);
+  configure(threaded);
+  threaded->UseThreadingOn();
+  threaded->Update();
+
+  if (!vtkTestUtilities::CompareDataObjects(sequential->GetOutput(), threaded->GetOutput()))
+  {
+    vtkLog(ERROR, "Threaded output differs from sequential output with " << name << ".");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestCleanPolyDataThreaded(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> input = CreateInput(0.0, false, false);
+  bool success = TestConfiguration(input, "default parameters");
+  success &= TestConfiguration(input, "no conversion",
+    [](vtkCleanPolyData* clean)
+    {
+      clean->ConvertLinesToPointsOff();
+      clean->ConvertPolysToLinesOff();
+      clean->ConvertStripsToPolysOff();
+    });
+  success &= TestConfiguration(
+    input, "no point merging", [](vtkCleanPolyData* clean) { clean->PointMergingOff(); });
+  success &= TestConfiguration(input, "double precision",
+    [](vtkCleanPolyData* clean)
+    { clean->SetOutputPointsPrecision(vtkAlgorithm::DOUBLE_PRECISION); });
+
+  vtkSmartPointer<vtkPolyData> ghostInput = CreateInput(0.0, true, false);
+  success &= TestConfiguration(ghostInput, "ghost points");
+
+  // Points are merged according to their global ids, whatever their position.
+  vtkSmartPointer<vtkPolyData> globalIdsInput = CreateInput(1e-3, true, true);
+  success &= TestConfiguration(globalIdsInput, "global ids");
+
+  // Points are merged within a tolerance much larger than the jitter, and
+  // much smaller than the distance between distinct points.
+  vtkSmartPointer<vtkPolyData> jitteredInput = CreateInput(1e-7, false, false);
+  success &= TestConfiguration(jitteredInput, "tolerance",
+    [](vtkCleanPolyData* clean)
+    {
+      clean->ToleranceIsAbsoluteOn();
+      clean->SetAbsoluteTolerance(1e-5);
+    });
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,271 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the threaded labelling of vtkConnectivityFilter and
+// vtkPolyDataConnectivityFilter extracts the same regions as the sequential
+// traversal, in all the extraction modes.
+
+#include "vtkAppendFilter.h"
+#include "vtkAppendPolyData.h"
+#include "vtkCellData.h"
+#include "vtkConnectivityFilter.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkElevationFilter.h"
+#include "vtkIdList.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPlaneSource.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataConnectivityFilter.h"
+#include "vtkSphereSource.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+
+namespace
+{
+// Several spheres and planes, with elevation scalars splitting the planes
+// into several regions when scalar connectivity is on.
+vtkSmartPointer<vtkPolyData> CreateInput()
+{
+  vtkNew<vtkAppendPolyData> append;
+  for (int i = 0; i < 4; ++i)
+  {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetCenter(3.0 * i, 0.0, 0.0);
+    sphere->SetThetaResolution(8 + 4 * i);
+    sphere->SetPhiResolution(8 + 2 * i);
+    append->AddInputConnection(sphere->GetOutputPort());
+
+    vtkNew<vtkPlaneSource> plane;
+    plane->SetOrigin(3.0 * i, 2.0, 0.0);
+    plane->SetPoint1(3.0 * i + 2.0, 2.0, 0.0);
+    plane->SetPoint2(3.0 * i, 4.0 + i, 0.0);
+    plane->SetResolution(10 + i, 20);
+    append->AddInputConnection(plane->GetOutputPort());
+  }
+
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(append->GetOutputPort());
+  elevation->SetLowPoint(0.0, -1.0, 0.0);
+  elevation->SetHighPoint(1.0, 8.0, 0.0);
+  elevation->Update();
+  return vtkPolyData::SafeDownCast(elevation->GetOutput());
+}
+
+bool CompareTuples(vtkDataArray* expected, vtkIdType expectedId, vtkDataArray* actual,
+  vtkIdType actualId)
+{
+  if (!actual || expected->GetNumberOfComponents() != actual->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (int c = 0; c < expected->GetNumberOfComponents(); ++c)
+  {
+    if (expected->GetComponent(expectedId, c) != actual->GetComponent(actualId, c))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Points are numbered differently by the threaded implementation: compare
+// the points and their data through the cells using them.
+bool CompareOutputs(vtkPointSet* expected, vtkPointSet* actual, bool compareCellRegionIds)
+{
+  if (expected->GetNumberOfPoints() != actual->GetNumberOfPoints() ||
+    expected->GetNumberOfCells() != actual->GetNumberOfCells())
+  {
+    vtkLog(ERROR,
+      "Got " << actual->GetNumberOfPoints() << " points and " << actual->GetNumberOfCells()
+             << " cells instead of " << expected->GetNumberOfPoints() << " and "
+             << expected->GetNumberOfCells());
+    return false;
+  }
+  vtkNew<vtkIdList> expectedIds;
+  vtkNew<vtkIdList> actualIds;
+  vtkPointData* expectedPD = expected->GetPointData();
+  vtkCellData* expectedCD = expected->GetCellData();
+  for (vtkIdType cellId = 0; cellId < expected->GetNumberOfCells(); ++cellId)
+  {
+    if (expected->GetCellType(cellId) != actual->GetCellType(cellId))
+    {
+      vtkLog(ERROR, "Cell " << cellId << " has a different type.");
+      return false;
+    }
+    for (int i = 0; i < expectedCD->GetNumberOfArrays(); ++i)
+    {
+      vtkDataArray* array = expectedCD->GetArray(i);
+      if (!compareCellRegionIds && !strcmp(array->GetName(), "RegionId"))
+      {
+        continue;
+      }
+      if (!CompareTuples(array, cellId, actual->GetCellData()->GetArray(array->GetName()), cellId))
+      {
+        vtkLog(ERROR, "Cell array " << array->GetName() << " differs for cell " << cellId);
+        return false;
+      }
+    }
+    expected->GetCellPoints(cellId, expectedIds);
+    actual->GetCellPoints(cellId, actualIds);
+    if (expectedIds->GetNumberOfIds() != actualIds->GetNumberOfIds())
+    {
+      vtkLog(ERROR, "Cell " << cellId << " has a different size.");
+      return false;
+    }
+    for (vtkIdType i = 0; i < expectedIds->GetNumberOfIds(); ++i)
+    {
+      const vtkIdType expectedId = expectedIds->GetId(i);
+      const vtkIdType actualId = actualIds->GetId(i);
+      if (!CompareTuples(
+            expected->GetPoints()->GetData(), expectedId, actual->GetPoints()->GetData(), actualId))
+      {
+        vtkLog(ERROR, "Points of cell " << cellId << " differ.");
+        return false;
+      }
+      for (int a = 0; a < expectedPD->GetNumberOfArrays(); ++a)
+      {
+        vtkDataArray* array = expectedPD->GetArray(a);
+        if (!CompareTuples(
+              array, expectedId, actual->GetPointData()->GetArray(array->GetName()), actualId))
+        {
+          vtkLog(ERROR, "Point array " << array->GetName() << " differs for cell " << cellId);
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+template <typename FilterT>
+bool TestConfiguration(vtkDataSet* input, const char* name,
+  const std::function<void(FilterT*)>& configure, bool compareCellRegionIds = true)
+{
+  vtkNew<FilterT> sequential;
+  sequential->SetInputData(input);
+  sequential->ColorRegionsOn();
+  configure(sequential);
+  sequential->Update();
+
+  vtkNew<FilterT> threaded;
+  threaded->SetInputData(input);
+  threaded->ColorRegionsOn();
+  configure(threaded);
+  threaded->UseThreadingOn();
+  threaded->Update();
+
+  auto expected = vtkPointSet::SafeDownCast(sequential->GetOutputDataObject(0));
+  auto actual = vtkPointSet::SafeDownCast(threaded->GetOutputDataObject(0));
+  if (expected->GetNumberOfCells() == 0)
+  {
+    vtkLog(ERROR, "Nothing extracted with " << input->GetClassName() << " and " << name << ".");
+    return false;
+  }
+  if (sequential->GetNumberOfExtractedRegions() != threaded->GetNumberOfExtractedRegions())
+  {
+    vtkLog(ERROR,
+      "Extracted " << threaded->GetNumberOfExtractedRegions() << " regions instead of "
+                   << sequential->GetNumberOfExtractedRegions() << " with "
+                   << input->GetClassName() << " and " << name << ".");
+    return false;
+  }
+  if (!CompareOutputs(expected, actual, compareCellRegionIds))
+  {
+    vtkLog(ERROR,
+      "Threaded output differs from sequential output with " << input->GetClassName() << " and "
+                                                             << name << ".");
+    return false;
+  }
+  return true;
+}
+
+template <typename FilterT>
+bool TestExtractionModes(vtkDataSet* input)
+{
+  bool success = TestConfiguration<FilterT>(
+    input, "all regions", [](FilterT* filter) { filter->SetExtractionModeToAllRegions(); });
+  success &= TestConfiguration<FilterT>(
+    input, "largest region", [](FilterT* filter) { filter->SetExtractionModeToLargestRegion(); });
+  success &= TestConfiguration<FilterT>(input, "specified regions",
+    [](FilterT* filter)
+    {
+      filter->SetExtractionModeToSpecifiedRegions();
+      filter->AddSpecifiedRegion(1);
+      filter->AddSpecifiedRegion(4);
+    });
+  // Cell region ids are only defined for the extracted cells with seeds.
+  success &= TestConfiguration<FilterT>(
+    input, "point seeds",
+    [](FilterT* filter)
+    {
+      filter->SetExtractionModeToPointSeededRegions();
+      filter->AddSeed(0);
+      filter->AddSeed(500);
+    },
+    false);
+  success &= TestConfiguration<FilterT>(
+    input, "cell seeds",
+    [](FilterT* filter)
+    {
+      filter->SetExtractionModeToCellSeededRegions();
+      filter->AddSeed(10);
+      filter->AddSeed(700);
+    },
+    false);
+  success &= TestConfiguration<FilterT>(
+    input, "closest point",
+    [](FilterT* filter)
+    {
+      filter->SetExtractionModeToClosestPointRegion();
+      filter->SetClosestPoint(6.0, 3.0, 0.0);
+    },
+    false);
+  success &= TestConfiguration<FilterT>(input, "scalar connectivity",
+    [](FilterT* filter)
+    {
+      filter->SetExtractionModeToAllRegions();
+      filter->ScalarConnectivityOn();
+      filter->SetScalarRange(0.3, 0.6);
+    });
+  success &= TestConfiguration<FilterT>(
+    input, "seeded scalar connectivity",
+    [](FilterT* filter)
+    {
+      filter->SetExtractionModeToPointSeededRegions();
+      filter->AddSeed(500);
+      filter->ScalarConnectivityOn();
+      filter->SetScalarRange(0.3, 0.6);
+    },
+    false);
+  return success;
+}
+}
+
+int TestConnectivityFilterThreaded(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> polyData = CreateInput();
+  vtkNew<vtkAppendFilter> toUnstructuredGrid;
+  toUnstructuredGrid->AddInputData(polyData);
+  toUnstructuredGrid->Update();
+
+  bool success = TestExtractionModes<vtkConnectivityFilter>(polyData);
+  success &= TestExtractionModes<vtkConnectivityFilter>(toUnstructuredGrid->GetOutput());
+  success &= TestExtractionModes<vtkPolyDataConnectivityFilter>(polyData);
+  success &= TestConfiguration<vtkPolyDataConnectivityFilter>(polyData,
+    "full scalar connectivity",
+    [](vtkPolyDataConnectivityFilter* filter)
+    {
+      filter->SetExtractionModeToAllRegions();
+      filter->ScalarConnectivityOn();
+      filter->FullScalarConnectivityOn();
+      filter->SetScalarRange(0.3, 0.6);
+    });
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that vtkDelaunay3D produces the same triangulation when the points are
+// inserted in a spatially sorted order, for points in general position.
+
+#include "vtkDelaunay3D.h"
+#include "vtkIdList.h"
+#include "vtkLogger.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> CreateInput(vtkIdType numPts)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(7);
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetNextRangeValue(-1.0, 1.0);
+    }
+    points->InsertNextPoint(x);
+  }
+
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  return input;
+}
+
+// Describe the cells independently of their order and of the ordering of
+// their points.
+std::vector<std::vector<vtkIdType>> GetCells(vtkUnstructuredGrid* grid)
+{
+  std::vector<std::vector<vtkIdType>> cells;
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    grid->GetCellPoints(cellId, ptIds);
+    std::vector<vtkIdType> cell(ptIds->begin(), ptIds->end());
+    std::sort(cell.begin(), cell.end());
+    cell.insert(cell.begin(), grid->GetCellType(cellId));
+    cells.push_back(cell);
+  }
+  std::sort(cells.begin(), cells.end());
+  return cells;
+}
+
+bool TestConfiguration(vtkPolyData* input, const char* name,
+  const std::function<void(vtkDelaunay3D*)>& configure)
+{
+  vtkNew<vtkDelaunay3D> sequential;
+  sequential->SetInputData(input);
+  configure(sequential);
+  sequential->Update();
+
+  vtkNew<vtkDelaunay3D> sorted;
+  sorted->SetInputData(input);
+  configure(sorted);
+  sorted->UseSpatialSortInsertionOn();
+  sorted->Update();
+
+  vtkUnstructuredGrid* expected = sequential->GetOutput();
+  vtkUnstructuredGrid* actual = sorted->GetOutput();
+  if (expected->GetNumberOfCells() == 0)
+  {
+    vtkLog(ERROR, "Nothing generated with " << name << ".");
+    return false;
+  }
+  if (expected->GetNumberOfPoints() != actual->GetNumberOfPoints())
+  {
+    vtkLog(ERROR,
+      "Got " << actual->GetNumberOfPoints() << " points instead of "
+             << expected->GetNumberOfPoints() << " with " << name << ".");
+    return false;
+  }
+  if (GetCells(expected) != GetCells(actual))
+  {
+    vtkLog(ERROR,
+      "Got " << actual->GetNumberOfCells() << " cells instead of " << expected->GetNumberOfCells()
+             << ", or different cells, with " << name << ".");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestDelaunay3DSpatialSortInsertion(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> input = CreateInput(3000);
+
+  bool success = TestConfiguration(input, "default parameters", [](vtkDelaunay3D*) {});
+  success &= TestConfiguration(input, "bounding triangulation",
+    [](vtkDelaunay3D* delaunay) { delaunay->BoundingTriangulationOn(); });
+  success &= TestConfiguration(
+    input, "alpha", [](vtkDelaunay3D* delaunay) { delaunay->SetAlpha(0.12); });
+  success &= TestConfiguration(input, "alpha without tetras",
+    [](vtkDelaunay3D* delaunay)
+    {
+      delaunay->SetAlpha(0.2);
+      delaunay->AlphaTetsOff();
+    });
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
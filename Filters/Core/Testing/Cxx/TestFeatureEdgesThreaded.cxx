@@ -0,0 +1,195 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the threaded classification of vtkFeatureEdges extracts the same
+// edges, in the same order, as the sequential one.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkDoubleArray.h"
+#include "vtkFeatureEdges.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+
+namespace
+{
+// A folded grid of quads, triangles and strips, with polylines and, unless
+// ghosts are requested, a fin of triangles making non-manifold edges.
+vtkSmartPointer<vtkPolyData> CreateInput(bool withGhosts)
+{
+  const vtkIdType resX = 60;
+  const vtkIdType resY = 40;
+  vtkNew<vtkPoints> points;
+  for (vtkIdType j = 0; j <= resY; ++j)
+  {
+    for (vtkIdType i = 0; i <= resX; ++i)
+    {
+      const double z =
+        0.6 * std::abs(i - resX / 2.0) + 0.3 * std::sin(0.4 * i) * std::cos(0.3 * j);
+      points->InsertNextPoint(i, j, z);
+    }
+  }
+  auto id = [resX](vtkIdType i, vtkIdType j) { return i + (resX + 1) * j; };
+
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkCellArray> strips;
+  for (vtkIdType j = 0; j < resY; ++j)
+  {
+    if (j >= 3 * resY / 4)
+    {
+      vtkNew<vtkIdList> stripPts;
+      for (vtkIdType i = 0; i <= resX; ++i)
+      {
+        stripPts->InsertNextId(id(i, j));
+        stripPts->InsertNextId(id(i, j + 1));
+      }
+      strips->InsertNextCell(stripPts);
+      continue;
+    }
+    for (vtkIdType i = 0; i < resX; ++i)
+    {
+      if ((i + 2 * j) % 5 == 0)
+      {
+        const vtkIdType triPts0[] = { id(i, j), id(i + 1, j), id(i + 1, j + 1) };
+        polys->InsertNextCell(3, triPts0);
+        const vtkIdType triPts1[] = { id(i, j), id(i + 1, j + 1), id(i, j + 1) };
+        polys->InsertNextCell(3, triPts1);
+      }
+      else
+      {
+        const vtkIdType quadPts[] = { id(i, j), id(i + 1, j), id(i + 1, j + 1), id(i, j + 1) };
+        polys->InsertNextCell(4, quadPts);
+      }
+    }
+  }
+  if (!withGhosts)
+  {
+    for (vtkIdType i = 5; i < 25; ++i)
+    {
+      const vtkIdType apex = points->InsertNextPoint(i + 0.5, 10.0, 8.0);
+      const vtkIdType finPts[] = { id(i, 10), id(i + 1, 10), apex };
+      polys->InsertNextCell(3, finPts);
+    }
+  }
+
+  vtkNew<vtkCellArray> lines;
+  for (vtkIdType j = 0; j < resY; j += 7)
+  {
+    vtkNew<vtkIdList> linePts;
+    for (vtkIdType i = 0; i <= j % 10 + 2; ++i)
+    {
+      linePts->InsertNextId(id(i, j));
+    }
+    lines->InsertNextCell(linePts);
+  }
+
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  input->SetLines(lines);
+  input->SetPolys(polys);
+  input->SetStrips(strips);
+
+  vtkNew<vtkDoubleArray> cellIndex;
+  cellIndex->SetName("CellIndex");
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId)
+  {
+    cellIndex->InsertNextValue(cellId);
+  }
+  input->GetCellData()->AddArray(cellIndex);
+  vtkNew<vtkDoubleArray> pointIndex;
+  pointIndex->SetName("PointIndex");
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    pointIndex->InsertNextValue(ptId);
+  }
+  input->GetPointData()->AddArray(pointIndex);
+
+  if (withGhosts)
+  {
+    vtkNew<vtkUnsignedCharArray> ghosts;
+    ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+    for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId)
+    {
+      ghosts->InsertNextValue(cellId % 11 == 3 ? vtkDataSetAttributes::DUPLICATECELL : 0);
+    }
+    input->GetCellData()->AddArray(ghosts);
+  }
+  return input;
+}
+
+bool TestConfiguration(vtkPolyData* input, const char* name,
+  const std::function<void(vtkFeatureEdges*)>& configure)
+{
+  vtkNew<vtkFeatureEdges> sequential;
+  sequential->SetInputData(input);
+  configure(sequential);
+  sequential->Update();
+
+  vtkNew<vtkFeatureEdges> threaded;
+  threaded->SetInputData(input);
+  configure(threaded);
+  threaded->UseThreadingOn();
+  threaded->Update();
+
+  if (sequential->GetOutput()->GetNumberOfLines() == 0)
+  {
+    vtkLog(ERROR, "No edge extracted with " << name << ".");
+    return false;
+  }
+  if (!vtkTestUtilities::CompareDataObjects(sequential->GetOutput(), threaded->GetOutput()))
+  {
+    vtkLog(ERROR, "Threaded output differs from sequential output with " << name << ".");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestFeatureEdgesThreaded(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> input = CreateInput(false);
+  vtkSmartPointer<vtkPolyData> ghostInput = CreateInput(true);
+
+  bool success = TestConfiguration(input, "default parameters", [](vtkFeatureEdges*) {});
+  success &= TestConfiguration(
+    input, "all edge types", [](vtkFeatureEdges* filter) { filter->ExtractAllEdgeTypesOn(); });
+  success &= TestConfiguration(input, "feature edges",
+    [](vtkFeatureEdges* filter)
+    {
+      filter->ExtractAllEdgeTypesOff();
+      filter->FeatureEdgesOn();
+      filter->SetFeatureAngle(10.0);
+    });
+  success &= TestConfiguration(input, "non-manifold edges without coloring",
+    [](vtkFeatureEdges* filter)
+    {
+      filter->ExtractAllEdgeTypesOff();
+      filter->NonManifoldEdgesOn();
+      filter->ColoringOff();
+    });
+  success &= TestConfiguration(ghostInput, "ghosts",
+    [](vtkFeatureEdges* filter)
+    {
+      filter->ExtractAllEdgeTypesOn();
+      filter->NonManifoldEdgesOff();
+    });
+  success &= TestConfiguration(ghostInput, "ghost interfaces",
+    [](vtkFeatureEdges* filter)
+    {
+      filter->ExtractAllEdgeTypesOn();
+      filter->NonManifoldEdgesOff();
+      filter->RemoveGhostInterfacesOff();
+    });
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
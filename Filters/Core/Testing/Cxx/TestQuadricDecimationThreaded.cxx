@@ -0,0 +1,221 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the threaded vtkQuadricDecimation reaches the requested reduction
+// with a quality comparable to the sequential decimation, and that its output
+// does not depend on the number of threads.
+
+#include "vtkCellArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkIdList.h"
+#include "vtkLogger.h"
+#include "vtkMassProperties.h"
+#include "vtkNew.h"
+#include "vtkPlaneSource.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricDecimation.h"
+#include "vtkSMPTools.h"
+#include "vtkSphereSource.h"
+#include "vtkTriangleFilter.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <string>
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> CreateSphere()
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(80);
+  sphere->SetPhiResolution(60);
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphere->GetOutputPort());
+  elevation->SetLowPoint(0.0, 0.0, -0.5);
+  elevation->SetHighPoint(0.0, 0.0, 0.5);
+  elevation->Update();
+  return vtkPolyData::SafeDownCast(elevation->GetOutput());
+}
+
+vtkSmartPointer<vtkPolyData> CreatePlane()
+{
+  vtkNew<vtkPlaneSource> plane;
+  plane->SetResolution(60, 40);
+  vtkNew<vtkTriangleFilter> triangles;
+  triangles->SetInputConnection(plane->GetOutputPort());
+  triangles->Update();
+  return triangles->GetOutput();
+}
+
+bool SameOutputs(vtkPolyData* expected, vtkPolyData* actual)
+{
+  if (expected->GetNumberOfPoints() != actual->GetNumberOfPoints() ||
+    expected->GetNumberOfPolys() != actual->GetNumberOfPolys())
+  {
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < expected->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], y[3];
+    expected->GetPoint(ptId, x);
+    actual->GetPoint(ptId, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> expectedIds;
+  vtkNew<vtkIdList> actualIds;
+  for (vtkIdType cellId = 0; cellId < expected->GetNumberOfPolys(); ++cellId)
+  {
+    expected->GetPolys()->GetCellAtId(cellId, expectedIds);
+    actual->GetPolys()->GetCellAtId(cellId, actualIds);
+    for (vtkIdType i = 0; i < expectedIds->GetNumberOfIds(); ++i)
+    {
+      if (expectedIds->GetId(i) != actualIds->GetId(i))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+double GetVolume(vtkPolyData* polyData)
+{
+  vtkNew<vtkMassProperties> mass;
+  mass->SetInputData(polyData);
+  mass->Update();
+  return mass->GetVolume();
+}
+
+bool TestConfiguration(vtkPolyData* input, const char* name,
+  const std::function<void(vtkQuadricDecimation*)>& configure, bool closed)
+{
+  vtkNew<vtkQuadricDecimation> sequential;
+  sequential->SetInputData(input);
+  sequential->SetTargetReduction(0.9);
+  configure(sequential);
+  sequential->Update();
+
+  vtkNew<vtkQuadricDecimation> threaded;
+  threaded->SetInputData(input);
+  threaded->SetTargetReduction(0.9);
+  configure(threaded);
+  threaded->UseThreadingOn();
+  threaded->Update();
+
+  vtkNew<vtkQuadricDecimation> singleThread;
+  singleThread->SetInputData(input);
+  singleThread->SetTargetReduction(0.9);
+  configure(singleThread);
+  singleThread->UseThreadingOn();
+  vtkSMPTools::LocalScope(
+    vtkSMPTools::Config{ std::string("Sequential") }, [&]() { singleThread->Update(); });
+
+  vtkPolyData* expected = sequential->GetOutput();
+  vtkPolyData* actual = threaded->GetOutput();
+  const vtkIdType numTris = input->GetNumberOfPolys();
+  if (threaded->GetActualReduction() < threaded->GetTargetReduction() ||
+    std::abs(actual->GetNumberOfPolys() - expected->GetNumberOfPolys()) > numTris / 100)
+  {
+    vtkLog(ERROR,
+      "Got " << actual->GetNumberOfPolys() << " triangles instead of about "
+             << expected->GetNumberOfPolys() << " with " << name << ".");
+    return false;
+  }
+  if (closed)
+  {
+    const double expectedVolume = GetVolume(expected);
+    const double actualVolume = GetVolume(actual);
+    if (std::abs(actualVolume - expectedVolume) > 0.05 * expectedVolume)
+    {
+      vtkLog(ERROR,
+        "Got a volume of " << actualVolume << " instead of about " << expectedVolume << " with "
+                           << name << ".");
+      return false;
+    }
+  }
+  else
+  {
+    // The boundary constraints keep the corners of the plane.
+    double expectedBounds[6], actualBounds[6];
+    input->GetBounds(expectedBounds);
+    actual->GetBounds(actualBounds);
+    for (int i = 0; i < 6; ++i)
+    {
+      if (std::abs(expectedBounds[i] - actualBounds[i]) > 1e-6)
+      {
+        vtkLog(ERROR, "The boundary is not preserved with " << name << ".");
+        return false;
+      }
+    }
+  }
+  if (input->GetPointData()->GetScalars() && threaded->GetAttributeErrorMetric() &&
+    !actual->GetPointData()->GetScalars())
+  {
+    vtkLog(ERROR, "Scalars are not interpolated with " << name << ".");
+    return false;
+  }
+  if (!SameOutputs(actual, singleThread->GetOutput()))
+  {
+    vtkLog(ERROR, "The output depends on the number of threads with " << name << ".");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestQuadricDecimationThreaded(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> sphere = CreateSphere();
+  vtkSmartPointer<vtkPolyData> plane = CreatePlane();
+
+  bool success =
+    TestConfiguration(sphere, "default parameters", [](vtkQuadricDecimation*) {}, true);
+  success &= TestConfiguration(
+    sphere, "volume preservation",
+    [](vtkQuadricDecimation* decimation) { decimation->VolumePreservationOn(); }, true);
+  success &= TestConfiguration(
+    sphere, "attribute error metric",
+    [](vtkQuadricDecimation* decimation)
+    {
+      decimation->AttributeErrorMetricOn();
+      decimation->SetScalarsWeight(0.2);
+    },
+    true);
+  success &= TestConfiguration(
+    sphere, "attributes and volume preservation",
+    [](vtkQuadricDecimation* decimation)
+    {
+      decimation->AttributeErrorMetricOn();
+      decimation->VolumePreservationOn();
+    },
+    true);
+  success &= TestConfiguration(
+    plane, "boundary weight",
+    [](vtkQuadricDecimation* decimation) { decimation->SetBoundaryWeightFactor(2.0); }, false);
+
+  // No collapse is cheap enough, as in TestQuadricDecimationMaximumError.
+  vtkNew<vtkSphereSource> source;
+  source->SetThetaResolution(70);
+  source->SetPhiResolution(70);
+  source->Update();
+  vtkNew<vtkQuadricDecimation> decimation;
+  decimation->SetInputConnection(source->GetOutputPort());
+  decimation->SetTargetReduction(0.9);
+  decimation->VolumePreservationOn();
+  decimation->SetMaximumError(0.0);
+  decimation->UseThreadingOn();
+  decimation->Update();
+  if (decimation->GetOutput()->GetNumberOfPolys() != source->GetOutput()->GetNumberOfPolys())
+  {
+    vtkLog(ERROR, "The maximum error is not respected.");
+    success = false;
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
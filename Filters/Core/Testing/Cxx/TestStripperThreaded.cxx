@@ -0,0 +1,255 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the partitioned stripping of vtkStripper covers the same
+// triangles and line segments as its input, that the original cell ids and
+// field data follow the merged strips, and that the output does not depend on
+// the number of threads.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkStripper.h"
+#include "vtkTestUtilities.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace
+{
+// A grid of triangles with a few quads, and circles of line segments stored
+// in a scrambled order.
+vtkSmartPointer<vtkPolyData> CreateInput()
+{
+  const vtkIdType resX = 150;
+  const vtkIdType resY = 100;
+  vtkNew<vtkPoints> points;
+  for (vtkIdType j = 0; j <= resY; ++j)
+  {
+    for (vtkIdType i = 0; i <= resX; ++i)
+    {
+      points->InsertNextPoint(i, j, 0.0);
+    }
+  }
+  auto id = [resX](vtkIdType i, vtkIdType j) { return i + (resX + 1) * j; };
+
+  vtkNew<vtkCellArray> polys;
+  for (vtkIdType j = 0; j < resY; ++j)
+  {
+    for (vtkIdType i = 0; i < resX; ++i)
+    {
+      if ((i + j) % 97 == 0)
+      {
+        const vtkIdType quadPts[] = { id(i, j), id(i + 1, j), id(i + 1, j + 1), id(i, j + 1) };
+        polys->InsertNextCell(4, quadPts);
+        continue;
+      }
+      const vtkIdType triPts0[] = { id(i, j), id(i + 1, j), id(i + 1, j + 1) };
+      polys->InsertNextCell(3, triPts0);
+      const vtkIdType triPts1[] = { id(i, j), id(i + 1, j + 1), id(i, j + 1) };
+      polys->InsertNextCell(3, triPts1);
+    }
+  }
+
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  input->SetPolys(polys);
+
+  vtkNew<vtkCellArray> lines;
+  const vtkIdType numCirclePts = 500;
+  for (int circle = 0; circle < 4; ++circle)
+  {
+    const vtkIdType firstPt = points->GetNumberOfPoints();
+    for (vtkIdType i = 0; i < numCirclePts; ++i)
+    {
+      const double angle = 2.0 * 3.14159265358979 * i / numCirclePts;
+      points->InsertNextPoint(std::cos(angle), std::sin(angle), 1.0 + circle);
+    }
+    for (vtkIdType i = 0; i < numCirclePts; ++i)
+    {
+      const vtkIdType j = (i * 7) % numCirclePts;
+      const vtkIdType linePts[] = { firstPt + j, firstPt + (j + 1) % numCirclePts };
+      lines->InsertNextCell(2, linePts);
+    }
+  }
+  input->SetLines(lines);
+
+  vtkNew<vtkDoubleArray> cellIndex;
+  cellIndex->SetName("CellIndex");
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId)
+  {
+    cellIndex->InsertNextValue(cellId);
+  }
+  input->GetCellData()->AddArray(cellIndex);
+  return input;
+}
+
+using Simplex = std::array<vtkIdType, 3>;
+
+Simplex MakeSimplex(vtkIdType a, vtkIdType b, vtkIdType c = -1)
+{
+  Simplex simplex = { a, b, c };
+  std::sort(simplex.begin(), simplex.end());
+  return simplex;
+}
+
+// The triangles, line segments and polygons of a dataset (polygons are
+// identified by their first three points), each with the original cell id
+// associated to it by vtkStripper, in the order of the field data.
+std::vector<std::pair<Simplex, vtkIdType>> GetSimplices(vtkPolyData* polyData, bool output)
+{
+  vtkIdTypeArray* originalIds = output
+    ? vtkIdTypeArray::SafeDownCast(polyData->GetFieldData()->GetArray("vtkOriginalCellIds"))
+    : nullptr;
+  std::vector<std::pair<Simplex, vtkIdType>> simplices;
+  vtkIdType cellId = 0;
+  vtkIdType tupleId = 0;
+  auto add = [&](const Simplex& simplex)
+  {
+    simplices.emplace_back(simplex, originalIds ? originalIds->GetValue(tupleId) : cellId);
+  };
+
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType i = 0; i < polyData->GetNumberOfLines(); ++i, ++cellId, ++tupleId)
+  {
+    polyData->GetLines()->GetCellAtId(i, ptIds);
+    for (vtkIdType j = 0; j + 1 < ptIds->GetNumberOfIds(); ++j)
+    {
+      add(MakeSimplex(ptIds->GetId(j), ptIds->GetId(j + 1)));
+    }
+  }
+  for (vtkIdType i = 0; i < polyData->GetNumberOfPolys(); ++i, ++cellId, ++tupleId)
+  {
+    polyData->GetPolys()->GetCellAtId(i, ptIds);
+    add(MakeSimplex(ptIds->GetId(0), ptIds->GetId(1), ptIds->GetId(2)));
+  }
+  for (vtkIdType i = 0; i < polyData->GetNumberOfStrips(); ++i, ++cellId)
+  {
+    polyData->GetStrips()->GetCellAtId(i, ptIds);
+    for (vtkIdType j = 0; j + 2 < ptIds->GetNumberOfIds(); ++j, ++tupleId)
+    {
+      add(MakeSimplex(ptIds->GetId(j), ptIds->GetId(j + 1), ptIds->GetId(j + 2)));
+    }
+  }
+  return simplices;
+}
+
+bool CheckOutput(vtkPolyData* input, vtkPolyData* output, const char* name)
+{
+  std::vector<std::pair<Simplex, vtkIdType>> inputSimplices = GetSimplices(input, false);
+  std::vector<std::pair<Simplex, vtkIdType>> outputSimplices = GetSimplices(output, true);
+  std::vector<Simplex> expected, actual;
+  for (const auto& simplex : inputSimplices)
+  {
+    expected.push_back(simplex.first);
+  }
+  for (const auto& simplex : outputSimplices)
+  {
+    actual.push_back(simplex.first);
+    // Only the first segment of a poly-line comes from its original cell.
+    const vtkIdType originalId = simplex.second;
+    if (originalId < 0 || originalId >= input->GetNumberOfCells() ||
+      (simplex.first[0] != -1 && inputSimplices[originalId].first != simplex.first))
+    {
+      vtkLog(ERROR, "Wrong original cell id " << originalId << " with " << name << ".");
+      return false;
+    }
+  }
+  std::sort(expected.begin(), expected.end());
+  std::sort(actual.begin(), actual.end());
+  if (expected != actual)
+  {
+    vtkLog(ERROR, "The output does not cover the input cells with " << name << ".");
+    return false;
+  }
+
+  vtkDataArray* originalIds = output->GetFieldData()->GetArray("vtkOriginalCellIds");
+  vtkDataArray* cellIndex = output->GetFieldData()->GetArray("CellIndex");
+  if (!cellIndex || cellIndex->GetNumberOfTuples() != originalIds->GetNumberOfTuples())
+  {
+    vtkLog(ERROR, "Wrong field data with " << name << ".");
+    return false;
+  }
+  for (vtkIdType i = 0; i < cellIndex->GetNumberOfTuples(); ++i)
+  {
+    if (cellIndex->GetComponent(i, 0) != originalIds->GetComponent(i, 0))
+    {
+      vtkLog(ERROR, "Field data does not follow the original ids with " << name << ".");
+      return false;
+    }
+  }
+  return true;
+}
+
+vtkSmartPointer<vtkPolyData> Strip(vtkPolyData* input, bool useThreading, vtkIdType partitionSize)
+{
+  vtkNew<vtkStripper> stripper;
+  stripper->SetInputData(input);
+  stripper->PassCellDataAsFieldDataOn();
+  stripper->PassThroughCellIdsOn();
+  stripper->SetUseThreading(useThreading);
+  stripper->SetPartitionSize(partitionSize);
+  stripper->Update();
+  return stripper->GetOutput();
+}
+}
+
+int TestStripperThreaded(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> input = CreateInput();
+  bool success = true;
+
+  vtkSmartPointer<vtkPolyData> sequential = Strip(input, false, 1);
+  success &= CheckOutput(input, sequential, "sequential stripping");
+
+  // Small partitions, so that strips and poly-lines are split. The strips of
+  // the grid run across its rows, so they are cut every few rows but should
+  // still hold several triangles.
+  vtkSmartPointer<vtkPolyData> threaded = Strip(input, true, 1000);
+  success &= CheckOutput(input, threaded, "partitions");
+  vtkIdType numTriangles = 0;
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId)
+  {
+    numTriangles += input->GetCellType(cellId) == VTK_TRIANGLE ? 1 : 0;
+  }
+  if (threaded->GetNumberOfStrips() < sequential->GetNumberOfStrips() ||
+    4 * threaded->GetNumberOfStrips() > numTriangles)
+  {
+    vtkLog(ERROR,
+      "Got " << threaded->GetNumberOfStrips() << " strips for " << numTriangles
+             << " triangles with partitions, and " << sequential->GetNumberOfStrips()
+             << " without.");
+    success = false;
+  }
+
+  vtkSmartPointer<vtkPolyData> singleThread;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ std::string("Sequential") },
+    [&]() { singleThread = Strip(input, true, 1000); });
+  if (!vtkTestUtilities::CompareDataObjects(threaded, singleThread))
+  {
+    vtkLog(ERROR, "The output depends on the number of threads.");
+    success = false;
+  }
+
+  // A single partition strips like the sequential implementation.
+  vtkSmartPointer<vtkPolyData> onePartition = Strip(input, true, input->GetNumberOfCells());
+  if (!vtkTestUtilities::CompareDataObjects(sequential, onePartition))
+  {
+    vtkLog(ERROR, "A single partition differs from the sequential stripping.");
+    success = false;
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the threaded vtkTriangleFilter produces the same output as the
+// sequential one for poly-vertices, polylines, polygons and triangle strips.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestUtilities.h"
+#include "vtkTriangleFilter.h"
+
+#include <cstdlib>
+#include <functional>
+
+namespace
+{
+// A grid of points used by cells of all kinds, with several thousands of
+// cells of each kind so that they are processed by several blocks.
+vtkSmartPointer<vtkPolyData> CreateInput(bool trianglesOnly)
+{
+  const vtkIdType res = 60;
+  vtkNew<vtkPoints> points;
+  for (vtkIdType j = 0; j < res; ++j)
+  {
+    for (vtkIdType i = 0; i < res; ++i)
+    {
+      points->InsertNextPoint(i, j, 0.01 * ((i * j) % 7));
+    }
+  }
+  auto id = [res](vtkIdType i, vtkIdType j) { return i + res * j; };
+
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkCellArray> strips;
+  for (vtkIdType j = 0; j < res - 2; ++j)
+  {
+    for (vtkIdType i = 0; i < res - 2; ++i)
+    {
+      const vtkIdType k = i + j;
+      const vtkIdType vertPts[] = { id(i, j), id(i + 1, j), id(i, j + 1), id(i + 1, j + 1) };
+      verts->InsertNextCell(1 + k % 4, vertPts);
+      const vtkIdType linePts[] = { id(i, j), id(i + 1, j), id(i + 1, j + 1), id(i + 2, j + 1),
+        id(i + 2, j + 2) };
+      lines->InsertNextCell(2 + k % 4, linePts);
+      if (trianglesOnly || k % 3 == 0)
+      {
+        const vtkIdType triPts[] = { id(i, j), id(i + 1, j), id(i + 1, j + 1) };
+        polys->InsertNextCell(3, triPts);
+      }
+      else if (k % 3 == 1)
+      {
+        const vtkIdType quadPts[] = { id(i, j), id(i + 1, j), id(i + 1, j + 1), id(i, j + 1) };
+        polys->InsertNextCell(4, quadPts);
+      }
+      else
+      {
+        const vtkIdType polyPts[] = { id(i, j), id(i + 1, j), id(i + 2, j + 1), id(i + 2, j + 2),
+          id(i + 1, j + 2), id(i, j + 1) };
+        polys->InsertNextCell(6, polyPts);
+      }
+      const vtkIdType stripPts[] = { id(i, j), id(i, j + 1), id(i + 1, j), id(i + 1, j + 1),
+        id(i + 2, j), id(i + 2, j + 1) };
+      strips->InsertNextCell(3 + k % 4, stripPts);
+    }
+  }
+
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  input->SetVerts(verts);
+  input->SetLines(lines);
+  input->SetPolys(polys);
+  input->SetStrips(strips);
+  vtkNew<vtkDoubleArray> cellIndex;
+  cellIndex->SetName("CellIndex");
+  cellIndex->SetNumberOfComponents(2);
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId)
+  {
+    cellIndex->InsertNextTuple2(cellId, -cellId);
+  }
+  input->GetCellData()->AddArray(cellIndex);
+  return input;
+}
+
+bool TestConfiguration(vtkPolyData* input, const char* name,
+  const std::function<void(vtkTriangleFilter*)>& configure)
+{
+  vtkNew<vtkTriangleFilter> sequential;
+  sequential->SetInputData(input);
+  configure(sequential);
+  sequential->Update();
+
+  vtkNew<vtkTriangleFilter> threaded;
+  threaded->SetInputData(input);
+  configure(threaded);
+  threaded->UseThreadingOn();
+  threaded->Update();
+
+  if (sequential->GetOutput()->GetNumberOfCells() == 0)
+  {
+    vtkLog(ERROR, "Nothing generated with " << name << ".");
+    return false;
+  }
+  if (!vtkTestUtilities::CompareDataObjects(sequential->GetOutput(), threaded->GetOutput()))
+  {
+    vtkLog(ERROR, "Threaded output differs from sequential output with " << name << ".");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestTriangleFilterThreaded(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> input = CreateInput(false);
+  vtkSmartPointer<vtkPolyData> triangles = CreateInput(true);
+
+  bool success = TestConfiguration(input, "default parameters", [](vtkTriangleFilter*) {});
+  success &= TestConfiguration(
+    input, "tolerance", [](vtkTriangleFilter* filter) { filter->SetTolerance(1e-4); });
+  success &= TestConfiguration(
+    input, "no verts", [](vtkTriangleFilter* filter) { filter->PassVertsOff(); });
+  success &= TestConfiguration(
+    input, "no lines", [](vtkTriangleFilter* filter) { filter->PassLinesOff(); });
+  success &= TestConfiguration(
+    input, "preserved polys", [](vtkTriangleFilter* filter) { filter->PreservePolysOn(); });
+  success &= TestConfiguration(triangles, "triangles", [](vtkTriangleFilter*) {});
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
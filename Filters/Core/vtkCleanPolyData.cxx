@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkCleanPolyData.h"
 
+#include "vtkArrayListTemplate.h" // For processing attribute data
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkIdTypeArray.h"
@@ -13,9 +14,17 @@
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <numeric>
 #include <unordered_map>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkCleanPolyData);
@@ -37,6 +46,231 @@ void InsertPointUsingGlobalId(vtkIdType globalId, vtkPoints* newPts,
     ptId = it->second;
   }
 }
+
+//------------------------------------------------------------------------------
+// Threaded implementation. As in the sequential implementation, output points
+// are numbered in the order they are first used by the cells (verts, then
+// lines, polys and strips). This order is given by the position of the point
+// ids in the concatenation of the four connectivity arrays.
+constexpr vtkIdType UnusedPosition = VTK_ID_MAX;
+
+void AtomicMin(std::atomic<vtkIdType>& value, vtkIdType candidate)
+{
+  vtkIdType current = value.load(std::memory_order_relaxed);
+  while (candidate < current &&
+    !value.compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+  {
+  }
+}
+
+void AtomicMax(std::atomic<vtkIdType>& value, vtkIdType candidate)
+{
+  vtkIdType current = value.load(std::memory_order_relaxed);
+  while (candidate > current &&
+    !value.compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+  {
+  }
+}
+
+// Record the first position where each point is used.
+struct MarkFirstUses : public vtkCellArray::DispatchUtilities
+{
+  template <typename OffsetsT, typename ConnectivityT>
+  void operator()(OffsetsT* vtkNotUsed(offsets), ConnectivityT* conn, vtkIdType firstPosition,
+    std::atomic<vtkIdType>* firstUses)
+  {
+    vtkSMPTools::For(0, conn->GetNumberOfValues(),
+      [&](vtkIdType id, vtkIdType endId)
+      {
+        auto connRange = GetRange(conn);
+        for (; id < endId; ++id)
+        {
+          ::AtomicMin(firstUses[connRange[id]], firstPosition + id);
+        }
+      });
+  }
+};
+
+// Cell types, in the order of the input and output cell data.
+enum CleanCellType
+{
+  VERT_CELLS = 0,
+  LINE_CELLS,
+  POLY_CELLS,
+  STRIP_CELLS,
+  NUMBER_OF_CELL_TYPES
+};
+constexpr int RemovedCell = NUMBER_OF_CELL_TYPES;
+
+struct CleanCellsState
+{
+  vtkCleanPolyData* Filter;
+  bool ConvertLinesToPoints;
+  bool ConvertPolysToLines;
+  bool ConvertStripsToPolys;
+  const vtkIdType* PointMap;
+  ArrayList CellArrays;
+  vtkIdType FirstOutputCell[NUMBER_OF_CELL_TYPES];
+  vtkIdType* Offsets[NUMBER_OF_CELL_TYPES];
+  vtkIdType* Connectivity[NUMBER_OF_CELL_TYPES];
+};
+
+// Output cells produced by a block of input cells: their number and
+// connectivity size during the counting pass, then the location of the first
+// of them in the output arrays.
+struct CellBlock
+{
+  vtkIdType NumberOfCells[NUMBER_OF_CELL_TYPES] = {};
+  vtkIdType ConnectivitySize[NUMBER_OF_CELL_TYPES] = {};
+};
+constexpr vtkIdType CellBlockSize = 1024;
+
+// Renumber the points of a cell and return its output type, following the
+// rules of the sequential implementation: consecutive duplicated points are
+// removed (except in vertices), and degenerate cells are converted or removed.
+template <typename CellRangeT>
+int CleanCell(
+  const CleanCellsState& state, int inputType, const CellRangeT& cell, std::vector<vtkIdType>& ids)
+{
+  ids.clear();
+  for (const auto ptId : cell)
+  {
+    const vtkIdType newId = state.PointMap[ptId];
+    if (inputType == VERT_CELLS || ids.empty() || newId != ids.back())
+    {
+      ids.push_back(newId);
+    }
+  }
+  if (((inputType == POLY_CELLS && ids.size() > 2) ||
+        (inputType == STRIP_CELLS && ids.size() > 1)) &&
+    ids.front() == ids.back())
+  {
+    ids.pop_back();
+  }
+
+  const vtkIdType npts = static_cast<vtkIdType>(cell.size());
+  const vtkIdType numNewPts = static_cast<vtkIdType>(ids.size());
+  switch (inputType)
+  {
+    case VERT_CELLS:
+      return numNewPts > 0 ? VERT_CELLS : RemovedCell;
+    case LINE_CELLS:
+      if (numNewPts >= 2)
+      {
+        return LINE_CELLS;
+      }
+      break;
+    case POLY_CELLS:
+      if (numNewPts > 2)
+      {
+        return POLY_CELLS;
+      }
+      if (numNewPts == 2 && (npts == 2 || state.ConvertPolysToLines))
+      {
+        return LINE_CELLS;
+      }
+      break;
+    case STRIP_CELLS:
+    default:
+      if (numNewPts > 3)
+      {
+        return STRIP_CELLS;
+      }
+      if (numNewPts == 3 && (npts == 3 || state.ConvertStripsToPolys))
+      {
+        return POLY_CELLS;
+      }
+      if (numNewPts == 2 && (npts == 2 || state.ConvertPolysToLines))
+      {
+        return LINE_CELLS;
+      }
+      break;
+  }
+  if (numNewPts == 1 && (npts == 1 || state.ConvertLinesToPoints))
+  {
+    return VERT_CELLS;
+  }
+  return RemovedCell;
+}
+
+// First pass over the input cells: count the output cells of each block.
+struct CountCleanCells : public vtkCellArray::DispatchUtilities
+{
+  template <typename OffsetsT, typename ConnectivityT>
+  void operator()(OffsetsT* offsets, ConnectivityT* conn, int inputType, CleanCellsState& state,
+    std::vector<CellBlock>& blocks)
+  {
+    const vtkIdType numCells = this->GetNumberOfCells(offsets);
+    blocks.resize((numCells + CellBlockSize - 1) / CellBlockSize);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(blocks.size()),
+      [&](vtkIdType block, vtkIdType endBlock)
+      {
+        std::vector<vtkIdType> ids;
+        bool isFirst = vtkSMPTools::GetSingleThread();
+        for (; block < endBlock; ++block)
+        {
+          if (isFirst)
+          {
+            state.Filter->CheckAbort();
+          }
+          if (state.Filter->GetAbortOutput())
+          {
+            break;
+          }
+          CellBlock& counts = blocks[block];
+          const vtkIdType endCellId = std::min(numCells, (block + 1) * CellBlockSize);
+          for (vtkIdType cellId = block * CellBlockSize; cellId < endCellId; ++cellId)
+          {
+            const int type =
+              ::CleanCell(state, inputType, GetCellRange(offsets, conn, cellId), ids);
+            if (type != RemovedCell)
+            {
+              ++counts.NumberOfCells[type];
+              counts.ConnectivitySize[type] += static_cast<vtkIdType>(ids.size());
+            }
+          }
+        }
+      });
+  }
+};
+
+// Second pass over the input cells: write the output cells and copy the cell
+// data at the locations computed from the counts.
+struct FillCleanCells : public vtkCellArray::DispatchUtilities
+{
+  template <typename OffsetsT, typename ConnectivityT>
+  void operator()(OffsetsT* offsets, ConnectivityT* conn, int inputType, vtkIdType firstInputCell,
+    CleanCellsState& state, const std::vector<CellBlock>& blocks)
+  {
+    const vtkIdType numCells = this->GetNumberOfCells(offsets);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(blocks.size()),
+      [&](vtkIdType block, vtkIdType endBlock)
+      {
+        std::vector<vtkIdType> ids;
+        for (; block < endBlock; ++block)
+        {
+          CellBlock next = blocks[block];
+          const vtkIdType endCellId = std::min(numCells, (block + 1) * CellBlockSize);
+          for (vtkIdType cellId = block * CellBlockSize; cellId < endCellId; ++cellId)
+          {
+            const int type =
+              ::CleanCell(state, inputType, GetCellRange(offsets, conn, cellId), ids);
+            if (type == RemovedCell)
+            {
+              continue;
+            }
+            const vtkIdType outCellId = next.NumberOfCells[type]++;
+            state.Offsets[type][outCellId] = next.ConnectivitySize[type];
+            std::copy(
+              ids.begin(), ids.end(), state.Connectivity[type] + next.ConnectivitySize[type]);
+            next.ConnectivitySize[type] += static_cast<vtkIdType>(ids.size());
+            state.CellArrays.Copy(
+              firstInputCell + cellId, state.FirstOutputCell[type] + outCellId);
+          }
+        }
+      });
+  }
+};
 } // anonymous namespace
 
 //------------------------------------------------------------------------------
@@ -170,6 +404,10 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
     vtkDebugMacro(<< "No data to Operate On!");
     return 1;
   }
+  if (this->UseThreading)
+  {
+    return this->ThreadedRequestData(input, output);
+  }
   vtkIdType* updatedPts = new vtkIdType[input->GetMaxCellSize()];
 
   vtkIdType numNewPts;
@@ -709,6 +947,345 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+int vtkCleanPolyData::ThreadedRequestData(vtkPolyData* input, vtkPolyData* output)
+{
+  vtkPoints* inPts = input->GetPoints();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPointData* inPD = input->GetPointData();
+  vtkCellData* inCD = input->GetCellData();
+  vtkPointData* outPD = output->GetPointData();
+  vtkCellData* outCD = output->GetCellData();
+  vtkCellArray* inCells[NUMBER_OF_CELL_TYPES] = { input->GetVerts(), input->GetLines(),
+    input->GetPolys(), input->GetStrips() };
+
+  // Find the first position where each point is used. Unused points are
+  // removed, the others are given a compact id.
+  std::unique_ptr<std::atomic<vtkIdType>[]> firstUses(new std::atomic<vtkIdType>[numPts]);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType ptId, vtkIdType endPtId)
+    {
+      for (; ptId < endPtId; ++ptId)
+      {
+        firstUses[ptId].store(UnusedPosition, std::memory_order_relaxed);
+      }
+    });
+  vtkIdType firstPosition = 0;
+  for (vtkCellArray* cells : inCells)
+  {
+    cells->Dispatch(MarkFirstUses{}, firstPosition, firstUses.get());
+    firstPosition += cells->GetNumberOfConnectivityIds();
+  }
+
+  std::vector<vtkIdType> pointMap(numPts);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType ptId, vtkIdType endPtId)
+    {
+      for (; ptId < endPtId; ++ptId)
+      {
+        pointMap[ptId] = firstUses[ptId].load(std::memory_order_relaxed) != UnusedPosition;
+      }
+    });
+  const vtkIdType numUsedPts =
+    vtkSMPTools::ExclusiveScan(pointMap.begin(), pointMap.end(), pointMap.begin(), vtkIdType(0));
+  std::vector<vtkIdType> usedPtIds(numUsedPts);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType ptId, vtkIdType endPtId)
+    {
+      for (; ptId < endPtId; ++ptId)
+      {
+        if (firstUses[ptId].load(std::memory_order_relaxed) != UnusedPosition)
+        {
+          usedPtIds[pointMap[ptId]] = ptId;
+        }
+      }
+    });
+
+  // Operate on the used points.
+  vtkNew<vtkPoints> mappedPts;
+  mappedPts->SetDataTypeToDouble();
+  mappedPts->SetNumberOfPoints(numUsedPts);
+  vtkSMPTools::For(0, numUsedPts,
+    [&](vtkIdType id, vtkIdType endId)
+    {
+      double x[3], newx[3];
+      for (; id < endId; ++id)
+      {
+        inPts->GetPoint(usedPtIds[id], x);
+        this->OperateOnPoint(x, newx);
+        mappedPts->SetPoint(id, newx);
+      }
+    });
+  this->UpdateProgress(0.2);
+  if (this->CheckAbort())
+  {
+    return 1;
+  }
+
+  // Merge the used points: each one is mapped to a representative point of
+  // the set of points it is merged with.
+  std::vector<vtkIdType> mergeMap(numUsedPts);
+  vtkIdTypeArray* globalIdsArray = vtkIdTypeArray::SafeDownCast(inPD->GetGlobalIds());
+  if (!this->PointMerging || numUsedPts == 0)
+  {
+    std::iota(mergeMap.begin(), mergeMap.end(), 0);
+  }
+  else if (globalIdsArray)
+  {
+    // Points sharing a global id are merged: sort the points by global id and
+    // use the first point of each run as representative.
+    const vtkIdType* globalIds = globalIdsArray->GetPointer(0);
+    auto globalId = [&](vtkIdType id) { return globalIds[usedPtIds[id]]; };
+    std::vector<vtkIdType> order(numUsedPts);
+    std::iota(order.begin(), order.end(), 0);
+    vtkSMPTools::Sort(order.begin(), order.end(),
+      [&](vtkIdType a, vtkIdType b)
+      { return globalId(a) < globalId(b) || (globalId(a) == globalId(b) && a < b); });
+    std::vector<vtkIdType> runStarts(numUsedPts);
+    vtkSMPTools::For(0, numUsedPts,
+      [&](vtkIdType i, vtkIdType endI)
+      {
+        for (; i < endI; ++i)
+        {
+          runStarts[i] = (i == 0 || globalId(order[i]) != globalId(order[i - 1])) ? i : 0;
+        }
+      });
+    vtkSMPTools::InclusiveScan(runStarts.begin(), runStarts.end(), runStarts.begin(),
+      [](vtkIdType a, vtkIdType b) { return std::max(a, b); });
+    vtkSMPTools::For(0, numUsedPts,
+      [&](vtkIdType i, vtkIdType endI)
+      {
+        for (; i < endI; ++i)
+        {
+          mergeMap[order[i]] = order[runStarts[i]];
+        }
+      });
+  }
+  else
+  {
+    vtkNew<vtkPolyData> mappedInput;
+    mappedInput->SetPoints(mappedPts);
+    vtkNew<vtkStaticPointLocator> locator;
+    locator->SetDataSet(mappedInput);
+    locator->BuildLocator();
+    const double tol =
+      this->ToleranceIsAbsolute ? this->AbsoluteTolerance : this->Tolerance * input->GetLength();
+    locator->MergePoints(tol, mergeMap.data());
+  }
+  this->UpdateProgress(0.4);
+  if (this->CheckAbort())
+  {
+    return 1;
+  }
+
+  // The output point takes its coordinates from the first used point of the
+  // merged set. Like in the sequential implementation, its point data comes
+  // from the last (in order of first use) primary point, or from the first
+  // used point if they are all ghosts.
+  std::unique_ptr<std::atomic<vtkIdType>[]> mergedFirstUses(
+    new std::atomic<vtkIdType>[numUsedPts]);
+  std::unique_ptr<std::atomic<vtkIdType>[]> mergedDataUses(new std::atomic<vtkIdType>[numUsedPts]);
+  vtkSMPTools::For(0, numUsedPts,
+    [&](vtkIdType id, vtkIdType endId)
+    {
+      for (; id < endId; ++id)
+      {
+        mergedFirstUses[id].store(UnusedPosition, std::memory_order_relaxed);
+        mergedDataUses[id].store(-1, std::memory_order_relaxed);
+      }
+    });
+  vtkUnsignedCharArray* ghosts =
+    input->HasAnyGhostPoints() ? input->GetGhostArray(vtkDataObject::POINT) : nullptr;
+  vtkSMPTools::For(0, numUsedPts,
+    [&](vtkIdType id, vtkIdType endId)
+    {
+      for (; id < endId; ++id)
+      {
+        const vtkIdType position = firstUses[usedPtIds[id]].load(std::memory_order_relaxed);
+        ::AtomicMin(mergedFirstUses[mergeMap[id]], position);
+        if (!ghosts || ghosts->GetValue(usedPtIds[id]) == 0)
+        {
+          ::AtomicMax(mergedDataUses[mergeMap[id]], position);
+        }
+      }
+    });
+  std::vector<vtkIdType> coordinatesSources(numUsedPts);
+  std::vector<vtkIdType> dataSources(numUsedPts);
+  vtkSMPTools::For(0, numUsedPts,
+    [&](vtkIdType id, vtkIdType endId)
+    {
+      for (; id < endId; ++id)
+      {
+        const vtkIdType representative = mergeMap[id];
+        const vtkIdType position = firstUses[usedPtIds[id]].load(std::memory_order_relaxed);
+        const vtkIdType firstUse = mergedFirstUses[representative].load(std::memory_order_relaxed);
+        vtkIdType dataUse = mergedDataUses[representative].load(std::memory_order_relaxed);
+        dataUse = dataUse >= 0 ? dataUse : firstUse;
+        if (position == firstUse)
+        {
+          coordinatesSources[representative] = id;
+        }
+        if (position == dataUse)
+        {
+          dataSources[representative] = usedPtIds[id];
+        }
+      }
+    });
+
+  // Number the output points in order of first use.
+  std::vector<vtkIdType> outputOrder(numUsedPts);
+  std::iota(outputOrder.begin(), outputOrder.end(), 0);
+  auto endOutputOrder = vtkSMPTools::Partition(outputOrder.begin(), outputOrder.end(),
+    [&](vtkIdType id) { return mergeMap[id] == id; });
+  vtkSMPTools::Sort(outputOrder.begin(), endOutputOrder,
+    [&](vtkIdType a, vtkIdType b)
+    {
+      return mergedFirstUses[a].load(std::memory_order_relaxed) <
+        mergedFirstUses[b].load(std::memory_order_relaxed);
+    });
+  const vtkIdType numNewPts = static_cast<vtkIdType>(endOutputOrder - outputOrder.begin());
+  std::vector<vtkIdType> newIds(numUsedPts);
+  vtkSMPTools::For(0, numNewPts,
+    [&](vtkIdType ptId, vtkIdType endPtId)
+    {
+      for (; ptId < endPtId; ++ptId)
+      {
+        newIds[outputOrder[ptId]] = ptId;
+      }
+    });
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType ptId, vtkIdType endPtId)
+    {
+      for (; ptId < endPtId; ++ptId)
+      {
+        if (firstUses[ptId].load(std::memory_order_relaxed) == UnusedPosition)
+        {
+          pointMap[ptId] = -1;
+        }
+        else
+        {
+          pointMap[ptId] = newIds[mergeMap[pointMap[ptId]]];
+        }
+      }
+    });
+
+  // Produce the output points and point data.
+  vtkNew<vtkPoints> newPts;
+  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    newPts->SetDataType(inPts->GetDataType());
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_FLOAT);
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_DOUBLE);
+  }
+  newPts->SetNumberOfPoints(numNewPts);
+  if (!this->PointMerging || globalIdsArray)
+  {
+    outPD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
+  }
+  outPD->CopyAllocate(inPD);
+  ArrayList pointArrays;
+  pointArrays.AddArrays(numNewPts, inPD, outPD, 0.0, /*promote=*/false);
+  vtkSMPTools::For(0, numNewPts,
+    [&](vtkIdType ptId, vtkIdType endPtId)
+    {
+      double x[3];
+      for (; ptId < endPtId; ++ptId)
+      {
+        const vtkIdType representative = outputOrder[ptId];
+        mappedPts->GetPoint(coordinatesSources[representative], x);
+        newPts->SetPoint(ptId, x);
+        pointArrays.Copy(dataSources[representative], ptId);
+      }
+    });
+  output->SetPoints(newPts);
+  this->UpdateProgress(0.6);
+  if (this->CheckAbort())
+  {
+    return 1;
+  }
+
+  // Count the output cells of each type produced by each block of input
+  // cells, then turn the counts into output locations. Output cells of a
+  // given type are ordered by input type, then by input cell id.
+  CleanCellsState state;
+  state.Filter = this;
+  state.ConvertLinesToPoints = this->ConvertLinesToPoints;
+  state.ConvertPolysToLines = this->ConvertPolysToLines;
+  state.ConvertStripsToPolys = this->ConvertStripsToPolys;
+  state.PointMap = pointMap.data();
+  std::vector<CellBlock> blocks[NUMBER_OF_CELL_TYPES];
+  for (int type = 0; type < NUMBER_OF_CELL_TYPES; ++type)
+  {
+    inCells[type]->Dispatch(CountCleanCells{}, type, state, blocks[type]);
+  }
+  this->UpdateProgress(0.8);
+  if (this->CheckAbort())
+  {
+    return 1;
+  }
+
+  CellBlock totals;
+  for (auto& typeBlocks : blocks)
+  {
+    for (CellBlock& block : typeBlocks)
+    {
+      for (int type = 0; type < NUMBER_OF_CELL_TYPES; ++type)
+      {
+        std::swap(block.NumberOfCells[type], totals.NumberOfCells[type]);
+        totals.NumberOfCells[type] += block.NumberOfCells[type];
+        std::swap(block.ConnectivitySize[type], totals.ConnectivitySize[type]);
+        totals.ConnectivitySize[type] += block.ConnectivitySize[type];
+      }
+    }
+  }
+
+  vtkNew<vtkIdTypeArray> newOffsets[NUMBER_OF_CELL_TYPES];
+  vtkNew<vtkIdTypeArray> newConnectivity[NUMBER_OF_CELL_TYPES];
+  vtkIdType numNewCells = 0;
+  for (int type = 0; type < NUMBER_OF_CELL_TYPES; ++type)
+  {
+    newOffsets[type]->SetNumberOfValues(totals.NumberOfCells[type] + 1);
+    newOffsets[type]->SetValue(totals.NumberOfCells[type], totals.ConnectivitySize[type]);
+    newConnectivity[type]->SetNumberOfValues(totals.ConnectivitySize[type]);
+    state.Offsets[type] = newOffsets[type]->GetPointer(0);
+    state.Connectivity[type] = newConnectivity[type]->GetPointer(0);
+    state.FirstOutputCell[type] = numNewCells;
+    numNewCells += totals.NumberOfCells[type];
+  }
+
+  // Produce the output cells and cell data.
+  outCD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
+  outCD->CopyAllocate(inCD);
+  state.CellArrays.AddArrays(numNewCells, inCD, outCD, 0.0, /*promote=*/false);
+  vtkIdType firstInputCell = 0;
+  for (int type = 0; type < NUMBER_OF_CELL_TYPES; ++type)
+  {
+    inCells[type]->Dispatch(FillCleanCells{}, type, firstInputCell, state, blocks[type]);
+    firstInputCell += inCells[type]->GetNumberOfCells();
+  }
+
+  vtkNew<vtkCellArray> newCells[NUMBER_OF_CELL_TYPES];
+  for (int type = 0; type < NUMBER_OF_CELL_TYPES; ++type)
+  {
+    newCells[type]->SetData(newOffsets[type], newConnectivity[type]);
+  }
+  output->SetVerts(newCells[VERT_CELLS]);
+  output->SetLines(newCells[LINE_CELLS]);
+  output->SetPolys(newCells[POLY_CELLS]);
+  output->SetStrips(newCells[STRIP_CELLS]);
+
+  vtkDebugMacro(<< "Removed " << numPts - numNewPts << " points and "
+                << input->GetNumberOfCells() - numNewCells << " cells");
+
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 // Method manages creation of locators. It takes into account the potential
 // change of tolerance (zero to non-zero).
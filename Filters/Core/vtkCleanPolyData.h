@@ -41,6 +41,16 @@
  * will not be used, and points that are not used by any cells will be
  * eliminated, but never merged.
  *
+ * When UseThreading is on, the filter runs a threaded implementation based on
+ * vtkSMPTools: points are merged with a vtkStaticPointLocator (the Locator is
+ * not used), then points and cells are renumbered, converted and copied in
+ * parallel. Points are still numbered in the order they are first used by
+ * the cells, and degenerate cells are converted following the same rules, so
+ * the output is identical to the one of the sequential implementation when
+ * points are merged exactly (zero tolerance), merged using global ids, or not
+ * merged at all. With a non-zero tolerance, which points are merged together
+ * may differ.
+ *
  * @warning
  * Merging points can alter topology, including introducing non-manifold
  * forms. The tolerance should be chosen carefully to avoid these problems.
@@ -152,6 +162,17 @@ public:
   vtkBooleanMacro(PointMerging, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off the threaded implementation of the filter (see the class
+   * documentation). When on, OperateOnPoint() is called concurrently from
+   * several threads and the Locator is ignored. Default is off.
+   */
+  vtkSetMacro(UseThreading, bool);
+  vtkGetMacro(UseThreading, bool);
+  vtkBooleanMacro(UseThreading, bool);
+  ///@}
+
   ///@{
   /**
    * Set/Get a spatial locator for speeding the search process. By
@@ -224,6 +245,7 @@ protected:
 
   vtkTypeBool PieceInvariant;
   int OutputPointsPrecision;
+  bool UseThreading = false;
 
 private:
   vtkCleanPolyData(const vtkCleanPolyData&) = delete;
@@ -236,6 +258,8 @@ private:
   // Insert point into newPts. If already present, only get its id.
   void InsertUniquePoint(vtkIdTypeArray* globalIdsArray, vtkIdType ptIndex, vtkPoints* newPts,
     std::unordered_map<vtkIdType, vtkIdType>& addedGlobalIdsMap, double* point, vtkIdType& ptId);
+  // Threaded implementation of RequestData, used when UseThreading is on.
+  int ThreadedRequestData(vtkPolyData* input, vtkPolyData* output);
 
   std::unordered_set<vtkIdType> CopiedPoints;
 };
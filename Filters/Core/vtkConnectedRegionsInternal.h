@@ -0,0 +1,571 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkConnectedRegionsInternal
+ * @brief   threaded labelling of the connected regions of a dataset
+ *
+ * vtkConnectedRegionsInternal labels the connected regions of a dataset the
+ * way vtkConnectivityFilter and vtkPolyDataConnectivityFilter do with their
+ * wave propagation, but with threads. The cells satisfying the scalar
+ * connectivity criterion (all the cells when there is no criterion) are
+ * first grouped into components with a lock-free union-find over the cell
+ * links: each union links the larger root under the smaller one, so the root
+ * of a component is its smallest cell id. A region is then made of a seed
+ * cell plus the components it reaches through its points, and regions are
+ * numbered in the order of their seed cells. This reproduces the region ids
+ * of the sequential traversal whatever the number of threads.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkConnectivityFilter vtkPolyDataConnectivityFilter
+ */
+
+#ifndef vtkConnectedRegionsInternal_h
+#define vtkConnectedRegionsInternal_h
+
+#include "vtkAlgorithm.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLinks.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+//------------------------------------------------------------------------------
+// Lower an atomic value to the given one if it is larger.
+inline void ConnectedRegionsAtomicMin(std::atomic<vtkIdType>& value, vtkIdType newValue)
+{
+  vtkIdType current = value.load(std::memory_order_relaxed);
+  while (newValue < current &&
+    !value.compare_exchange_weak(current, newValue, std::memory_order_relaxed))
+  {
+  }
+}
+
+//------------------------------------------------------------------------------
+class ConnectedRegions
+{
+public:
+  /**
+   * Prepare the labelling of the given dataset. When scalars are given, only
+   * the cells whose point scalars (first component) satisfy the criterion
+   * propagate the regions: with fullScalarConnectivity all the points of the
+   * cell must lie in the scalar range, otherwise any of them.
+   */
+  ConnectedRegions(vtkAlgorithm* filter, vtkDataSet* input, vtkDataArray* scalars,
+    const double scalarRange[2], bool fullScalarConnectivity)
+    : Filter(filter)
+    , Input(input)
+    , Scalars(scalars)
+    , FullScalarConnectivity(fullScalarConnectivity)
+    , NumberOfCells(input->GetNumberOfCells())
+    , NumberOfPoints(input->GetNumberOfPoints())
+  {
+    this->ScalarRange[0] = scalarRange[0];
+    this->ScalarRange[1] = scalarRange[1];
+  }
+
+  /**
+   * Build the cell links and group the connected cells into components.
+   * Returns false if the filter was aborted.
+   */
+  bool BuildComponents();
+
+  ///@{
+  /**
+   * Access the cells using a point, valid after BuildComponents().
+   */
+  vtkIdType GetNumberOfPointCells(vtkIdType ptId) { return this->Links->GetNcells(ptId); }
+  const vtkIdType* GetPointCells(vtkIdType ptId) { return this->Links->GetCells(ptId); }
+  ///@}
+
+  /**
+   * Return the id of the point closest to x, the smallest one in case of ties.
+   */
+  vtkIdType FindClosestPoint(const double x[3]);
+
+  /**
+   * Label all the regions of the dataset: cellRegions (of size the number of
+   * cells) receives the region id of each cell, and RegionSizes the number of
+   * cells of each region. Returns false if the filter was aborted.
+   */
+  bool LabelAllRegions(vtkIdType* cellRegions);
+
+  /**
+   * Label the single region reached from the given seed cells: cellRegions
+   * receives 0 for the cells of the region and -1 for the others.
+   * Returns false if the filter was aborted.
+   */
+  bool LabelSeededRegion(const std::vector<vtkIdType>& seedCells, vtkIdType* cellRegions);
+
+  /**
+   * Number the points used by the labelled cells (cellRegions >= 0) in
+   * increasing input point id order. pointMap (of size the number of points)
+   * receives the output id of each input point or -1 if it is not used, and
+   * pointRegions the smallest region id among the cells using each output
+   * point. Returns the number of output points.
+   */
+  vtkIdType MapPoints(const vtkIdType* cellRegions, vtkIdType* pointMap, vtkIdType* pointRegions);
+
+  /**
+   * Number of cells of each region, filled by the labelling methods.
+   */
+  std::vector<vtkIdType> RegionSizes;
+
+private:
+  static constexpr vtkIdType Unset = std::numeric_limits<vtkIdType>::max();
+
+  // Find the root of a component, halving the path on the way. Parents are
+  // always smaller than their children, so concurrent updates only shortcut
+  // to other ancestors.
+  vtkIdType Find(vtkIdType cellId)
+  {
+    vtkIdType parent = this->Parents[cellId].load(std::memory_order_relaxed);
+    while (parent != cellId)
+    {
+      const vtkIdType grandParent = this->Parents[parent].load(std::memory_order_relaxed);
+      if (grandParent != parent)
+      {
+        this->Parents[cellId].store(grandParent, std::memory_order_relaxed);
+      }
+      cellId = grandParent;
+      parent = this->Parents[cellId].load(std::memory_order_relaxed);
+    }
+    return cellId;
+  }
+
+  // Merge the components of two cells, linking the larger root under the
+  // smaller one.
+  void Union(vtkIdType cellId0, vtkIdType cellId1)
+  {
+    vtkIdType root0 = this->Find(cellId0);
+    vtkIdType root1 = this->Find(cellId1);
+    while (root0 != root1)
+    {
+      if (root0 > root1)
+      {
+        std::swap(root0, root1);
+      }
+      vtkIdType expected = root1;
+      if (this->Parents[root1].compare_exchange_strong(
+            expected, root0, std::memory_order_relaxed))
+      {
+        return;
+      }
+      // root1 got linked meanwhile, start again from its new parent.
+      root0 = this->Find(root0);
+      root1 = this->Find(expected);
+    }
+  }
+
+  // Whether a cell satisfies the scalar connectivity criterion.
+  bool IsConnected(vtkIdType cellId, vtkIdList* ptIds);
+
+  vtkAlgorithm* Filter;
+  vtkDataSet* Input;
+  vtkDataArray* Scalars;
+  double ScalarRange[2];
+  bool FullScalarConnectivity;
+  vtkIdType NumberOfCells;
+  vtkIdType NumberOfPoints;
+
+  vtkNew<vtkStaticCellLinks> Links;
+  vtkSMPThreadLocalObject<vtkIdList> CellPointIds;
+  // Whether each cell satisfies the scalar connectivity criterion.
+  std::vector<unsigned char> Connected;
+  // Union-find forest of the connected cells, flattened by BuildComponents()
+  // so that each cell directly refers to the root of its component.
+  std::unique_ptr<std::atomic<vtkIdType>[]> Parents;
+  // Root of the component of the connected cells using each point, or -1.
+  std::vector<vtkIdType> PointComponents;
+};
+
+//------------------------------------------------------------------------------
+inline bool ConnectedRegions::IsConnected(vtkIdType cellId, vtkIdList* ptIds)
+{
+  if (!this->Scalars)
+  {
+    return true;
+  }
+  vtkIdType npts;
+  const vtkIdType* pts;
+  this->Input->GetCellPoints(cellId, npts, pts, ptIds);
+  double range[2] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+  for (vtkIdType i = 0; i < npts; ++i)
+  {
+    // The sequential traversal gathers the scalars in a float array.
+    const double s = static_cast<float>(this->Scalars->GetComponent(pts[i], 0));
+    range[0] = std::min(s, range[0]);
+    range[1] = std::max(s, range[1]);
+  }
+  if (this->FullScalarConnectivity)
+  {
+    return range[0] >= this->ScalarRange[0] && range[1] <= this->ScalarRange[1];
+  }
+  return range[1] >= this->ScalarRange[0] && range[0] <= this->ScalarRange[1];
+}
+
+//------------------------------------------------------------------------------
+inline bool ConnectedRegions::BuildComponents()
+{
+  const vtkIdType numCells = this->NumberOfCells;
+  const vtkIdType numPts = this->NumberOfPoints;
+
+  // Random access to the cells of a polydata must be built before threading.
+  vtkPolyData* polyData = vtkPolyData::SafeDownCast(this->Input);
+  if (polyData && polyData->NeedToBuildCells())
+  {
+    polyData->BuildCells();
+  }
+  this->Links->SetDataSet(this->Input);
+  this->Links->BuildLinks();
+  if (this->Filter->CheckAbort())
+  {
+    return false;
+  }
+
+  this->Connected.resize(numCells);
+  this->Parents.reset(new std::atomic<vtkIdType>[numCells]);
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdList* ptIds = this->CellPointIds.Local();
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        this->Connected[cellId] = this->IsConnected(cellId, ptIds);
+        this->Parents[cellId].store(cellId, std::memory_order_relaxed);
+      }
+    });
+  if (this->Filter->CheckAbort())
+  {
+    return false;
+  }
+
+  // Connected cells sharing a point belong to the same component.
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        const vtkIdType ncells = this->Links->GetNcells(ptId);
+        const vtkIdType* cells = this->Links->GetCells(ptId);
+        vtkIdType first = -1;
+        for (vtkIdType i = 0; i < ncells; ++i)
+        {
+          if (this->Connected[cells[i]])
+          {
+            if (first < 0)
+            {
+              first = cells[i];
+            }
+            else
+            {
+              this->Union(first, cells[i]);
+            }
+          }
+        }
+      }
+    });
+  if (this->Filter->CheckAbort())
+  {
+    return false;
+  }
+
+  // Flatten the forest, then record the component of each point.
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        this->Parents[cellId].store(this->Find(cellId), std::memory_order_relaxed);
+      }
+    });
+  this->PointComponents.resize(numPts);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        const vtkIdType ncells = this->Links->GetNcells(ptId);
+        const vtkIdType* cells = this->Links->GetCells(ptId);
+        const vtkIdType* connected = std::find_if(cells, cells + ncells,
+          [this](vtkIdType cellId) { return this->Connected[cellId] != 0; });
+        this->PointComponents[ptId] = connected == cells + ncells
+          ? -1
+          : this->Parents[*connected].load(std::memory_order_relaxed);
+      }
+    });
+  return !this->Filter->CheckAbort();
+}
+
+//------------------------------------------------------------------------------
+inline vtkIdType ConnectedRegions::FindClosestPoint(const double x[3])
+{
+  using Candidate = std::pair<double, vtkIdType>;
+  vtkSMPThreadLocal<Candidate> closest(Candidate(VTK_DOUBLE_MAX, 0));
+  vtkSMPTools::For(0, this->NumberOfPoints,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      Candidate& localClosest = closest.Local();
+      double p[3];
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        this->Input->GetPoint(ptId, p);
+        const Candidate candidate(vtkMath::Distance2BetweenPoints(p, x), ptId);
+        if (candidate < localClosest)
+        {
+          localClosest = candidate;
+        }
+      }
+    });
+  Candidate result(VTK_DOUBLE_MAX, 0);
+  for (const Candidate& candidate : closest)
+  {
+    result = std::min(result, candidate);
+  }
+  return result.second;
+}
+
+//------------------------------------------------------------------------------
+inline bool ConnectedRegions::LabelAllRegions(vtkIdType* cellRegions)
+{
+  const vtkIdType numCells = this->NumberOfCells;
+
+  // A region starts at each cell which is not connected, and at the first
+  // cell of each component unless a smaller cell which is not connected
+  // reaches it first. Find the cell which owns each component.
+  std::unique_ptr<std::atomic<vtkIdType>[]> owners(new std::atomic<vtkIdType>[numCells]);
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        owners[cellId].store(cellId, std::memory_order_relaxed);
+      }
+    });
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdList* ptIds = this->CellPointIds.Local();
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        if (!this->Connected[cellId])
+        {
+          this->Input->GetCellPoints(cellId, npts, pts, ptIds);
+          for (vtkIdType i = 0; i < npts; ++i)
+          {
+            const vtkIdType component = this->PointComponents[pts[i]];
+            if (component >= 0)
+            {
+              ConnectedRegionsAtomicMin(owners[component], cellId);
+            }
+          }
+        }
+      }
+    });
+  if (this->Filter->CheckAbort())
+  {
+    return false;
+  }
+
+  // Regions are numbered in the order of the cells starting them.
+  std::vector<vtkIdType> seedRanks(numCells);
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        seedRanks[cellId] = !this->Connected[cellId] ||
+          (this->Parents[cellId].load(std::memory_order_relaxed) == cellId &&
+            owners[cellId].load(std::memory_order_relaxed) == cellId);
+      }
+    });
+  const vtkIdType numRegions = vtkSMPTools::ExclusiveScan(
+    seedRanks.begin(), seedRanks.end(), seedRanks.begin(), vtkIdType(0));
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        const vtkIdType seed = this->Connected[cellId]
+          ? owners[this->Parents[cellId].load(std::memory_order_relaxed)].load(
+              std::memory_order_relaxed)
+          : cellId;
+        cellRegions[cellId] = seedRanks[seed];
+      }
+    });
+  owners.reset();
+  seedRanks = std::vector<vtkIdType>();
+
+  // Count the cells of each region. Cells of the same region tend to be
+  // consecutive, so count runs before updating the shared counters.
+  std::unique_ptr<std::atomic<vtkIdType>[]> sizes(new std::atomic<vtkIdType>[numRegions]);
+  for (vtkIdType regionId = 0; regionId < numRegions; ++regionId)
+  {
+    sizes[regionId].store(0, std::memory_order_relaxed);
+  }
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdType runRegion = cellRegions[begin];
+      vtkIdType runSize = 0;
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        if (cellRegions[cellId] != runRegion)
+        {
+          sizes[runRegion].fetch_add(runSize, std::memory_order_relaxed);
+          runRegion = cellRegions[cellId];
+          runSize = 0;
+        }
+        ++runSize;
+      }
+      sizes[runRegion].fetch_add(runSize, std::memory_order_relaxed);
+    });
+  this->RegionSizes.resize(numRegions);
+  for (vtkIdType regionId = 0; regionId < numRegions; ++regionId)
+  {
+    this->RegionSizes[regionId] = sizes[regionId].load(std::memory_order_relaxed);
+  }
+  return !this->Filter->CheckAbort();
+}
+
+//------------------------------------------------------------------------------
+inline bool ConnectedRegions::LabelSeededRegion(
+  const std::vector<vtkIdType>& seedCells, vtkIdType* cellRegions)
+{
+  const vtkIdType numCells = this->NumberOfCells;
+
+  // The region is made of the seeds and of the components they reach.
+  constexpr unsigned char seedMark = 1;
+  constexpr unsigned char componentMark = 2;
+  std::vector<unsigned char> marks(numCells, 0);
+  vtkIdList* ptIds = this->CellPointIds.Local();
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (vtkIdType seed : seedCells)
+  {
+    if (seed < 0 || seed >= numCells || (marks[seed] & seedMark))
+    {
+      continue;
+    }
+    marks[seed] |= seedMark;
+    this->Input->GetCellPoints(seed, npts, pts, ptIds);
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      const vtkIdType component = this->PointComponents[pts[i]];
+      if (component >= 0)
+      {
+        marks[component] |= componentMark;
+      }
+    }
+  }
+
+  vtkSMPThreadLocal<vtkIdType> counts(0);
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdType& count = counts.Local();
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        const bool inRegion = (marks[cellId] & seedMark) ||
+          (this->Connected[cellId] &&
+            (marks[this->Parents[cellId].load(std::memory_order_relaxed)] & componentMark));
+        cellRegions[cellId] = inRegion ? 0 : -1;
+        count += inRegion;
+      }
+    });
+  vtkIdType numCellsInRegion = 0;
+  for (vtkIdType count : counts)
+  {
+    numCellsInRegion += count;
+  }
+  this->RegionSizes.assign(1, numCellsInRegion);
+  return !this->Filter->CheckAbort();
+}
+
+//------------------------------------------------------------------------------
+inline vtkIdType ConnectedRegions::MapPoints(
+  const vtkIdType* cellRegions, vtkIdType* pointMap, vtkIdType* pointRegions)
+{
+  const vtkIdType numCells = this->NumberOfCells;
+  const vtkIdType numPts = this->NumberOfPoints;
+
+  // A point takes the region of the first cell reaching it, which is the
+  // region with the smallest id.
+  std::unique_ptr<std::atomic<vtkIdType>[]> minRegions(new std::atomic<vtkIdType>[numPts]);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        minRegions[ptId].store(Unset, std::memory_order_relaxed);
+      }
+    });
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdList* ptIds = this->CellPointIds.Local();
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        if (cellRegions[cellId] >= 0)
+        {
+          this->Input->GetCellPoints(cellId, npts, pts, ptIds);
+          for (vtkIdType i = 0; i < npts; ++i)
+          {
+            ConnectedRegionsAtomicMin(minRegions[pts[i]], cellRegions[cellId]);
+          }
+        }
+      }
+    });
+
+  vtkSMPTools::Transform(minRegions.get(), minRegions.get() + numPts, pointMap,
+    [](const std::atomic<vtkIdType>& region) -> vtkIdType
+    { return region.load(std::memory_order_relaxed) != Unset; });
+  const vtkIdType numOutPts =
+    vtkSMPTools::ExclusiveScan(pointMap, pointMap + numPts, pointMap, vtkIdType(0));
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        const vtkIdType region = minRegions[ptId].load(std::memory_order_relaxed);
+        if (region == Unset)
+        {
+          pointMap[ptId] = -1;
+        }
+        else
+        {
+          pointRegions[pointMap[ptId]] = region;
+        }
+      }
+    });
+  return numOutPts;
+}
+
+} // anonymous namespace
+
+#endif // vtkConnectedRegionsInternal_h
+// VTK-HeaderTest-Exclude: vtkConnectedRegionsInternal.h
@@ -4,6 +4,7 @@
 
 #include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkConnectedRegionsInternal.h"
 #include "vtkDataSet.h"
 #include "vtkDemandDrivenPipeline.h"
 #include "vtkFloatArray.h"
@@ -16,10 +17,13 @@
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkToImplicitTypeErasureStrategy.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <map>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkObjectFactoryNewMacro(vtkConnectivityFilter);
@@ -207,7 +211,11 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
   this->PointIds = vtkIdList::New();
   this->PointIds->Allocate(8, VTK_CELL_SIZE);
 
-  if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
+  if (this->UseThreading)
+  { // label all regions at once with threads
+    largestRegionId = this->ThreadedTraverseAndMark(input);
+  }
+  else if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
@@ -588,6 +596,83 @@ void vtkConnectivityFilter::TraverseAndMark(vtkDataSet* input)
   } // while wave is not empty
 }
 
+//-------------------------------------------------------------------------------------------------
+vtkIdType vtkConnectivityFilter::ThreadedTraverseAndMark(vtkDataSet* input)
+{
+  const vtkIdType numCells = input->GetNumberOfCells();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const bool seeded = this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS ||
+    this->ExtractionMode == VTK_EXTRACT_CELL_SEEDED_REGIONS ||
+    this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_REGION;
+
+  ConnectedRegions regions(this, input, this->InScalars, this->ScalarRange, false);
+  bool labelled = regions.BuildComponents();
+  this->UpdateProgress(0.5);
+  if (labelled && !seeded)
+  {
+    labelled = regions.LabelAllRegions(this->Visited);
+  }
+  else if (labelled)
+  {
+    std::vector<vtkIdType> seedCells;
+    auto addPointCells = [&](vtkIdType ptId)
+    {
+      const vtkIdType* cells = regions.GetPointCells(ptId);
+      seedCells.insert(seedCells.end(), cells, cells + regions.GetNumberOfPointCells(ptId));
+    };
+    if (this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS)
+    {
+      for (vtkIdType i = 0; i < this->Seeds->GetNumberOfIds(); i++)
+      {
+        const vtkIdType ptId = this->Seeds->GetId(i);
+        if (ptId >= 0 && ptId < numPts)
+        {
+          addPointCells(ptId);
+        }
+      }
+    }
+    else if (this->ExtractionMode == VTK_EXTRACT_CELL_SEEDED_REGIONS)
+    {
+      seedCells.assign(this->Seeds->begin(), this->Seeds->end());
+    }
+    else
+    {
+      addPointCells(regions.FindClosestPoint(this->ClosestPoint));
+    }
+    labelled = regions.LabelSeededRegion(seedCells, this->Visited);
+  }
+  if (!labelled)
+  {
+    std::fill_n(this->Visited, numCells, -1);
+    return 0;
+  }
+  this->UpdateProgress(0.8);
+
+  // Leave the traversal state as the sequential traversal does.
+  const vtkIdType numRegions = static_cast<vtkIdType>(regions.RegionSizes.size());
+  this->RegionSizes->SetNumberOfValues(numRegions);
+  std::copy(regions.RegionSizes.begin(), regions.RegionSizes.end(),
+    this->RegionSizes->GetPointer(0));
+  this->RegionNumber = seeded ? 0 : numRegions;
+  this->PointNumber =
+    regions.MapPoints(this->Visited, this->PointMap, this->NewScalars->GetPointer(0));
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        if (this->Visited[cellId] >= 0)
+        {
+          this->NewCellScalars->SetValue(cellId, this->Visited[cellId]);
+        }
+      }
+    });
+  this->UpdateProgress(0.9);
+
+  return std::max_element(regions.RegionSizes.begin(), regions.RegionSizes.end()) -
+    regions.RegionSizes.begin();
+}
+
 //-------------------------------------------------------------------------------------------------
 void vtkConnectivityFilter::OrderRegionIds(
   vtkIdTypeArray* pointRegionIds, vtkIdTypeArray* cellRegionIds)
@@ -789,6 +874,7 @@ void vtkConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Scalar Range: (" << range[0] << ", " << range[1] << ")\n";
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
   os << indent << "Compress Arrays: " << this->CompressArrays << "\n";
+  os << indent << "Use Threading: " << this->UseThreading << "\n";
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -219,6 +219,21 @@ public:
   vtkBooleanMacro(CompressArrays, bool);
   ///@}
 
+  ///@{
+  /**
+   * Specify whether to label the regions with threads. When on, the cells
+   * satisfying the connectivity criterion are grouped with a concurrent
+   * union-find over static cell links, which supports all the extraction
+   * modes and produces the same region ids and extracted cells as the
+   * sequential traversal. The only difference is the order of the output
+   * points, which follows the input point ids instead of the traversal.
+   * Default is false.
+   */
+  vtkSetMacro(UseThreading, bool);
+  vtkGetMacro(UseThreading, bool);
+  vtkBooleanMacro(UseThreading, bool);
+  ///@}
+
 protected:
   vtkConnectivityFilter();
   ~vtkConnectivityFilter() override;
@@ -269,6 +284,12 @@ protected:
    */
   void TraverseAndMark(vtkDataSet* input);
 
+  /**
+   * Threaded counterpart of the traversal: mark the visited cells and points
+   * with their region number. Returns the id of the largest region.
+   */
+  vtkIdType ThreadedTraverseAndMark(vtkDataSet* input);
+
   void OrderRegionIds(vtkIdTypeArray* pointRegionIds, vtkIdTypeArray* cellRegionIds);
 
   /**
@@ -297,6 +318,7 @@ private:
   vtkIdList* PointIds = nullptr;
   vtkIdList* CellIds = nullptr;
   bool CompressArrays = true;
+  bool UseThreading = false;
 
   vtkConnectivityFilter(const vtkConnectivityFilter&) = delete;
   void operator=(const vtkConnectivityFilter&) = delete;
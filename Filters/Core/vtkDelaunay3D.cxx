@@ -9,14 +9,22 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointLocator.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkTetra.h"
 #include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkDelaunay3D);
 
@@ -124,6 +132,7 @@ vtkDelaunay3D::vtkDelaunay3D()
   this->BoundingTriangulation = 0;
   this->Offset = 2.5;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->UseSpatialSortInsertion = false;
   this->Locator = nullptr;
   this->TetraArray = nullptr;
   this->References = nullptr;
@@ -135,6 +144,7 @@ vtkDelaunay3D::vtkDelaunay3D()
   this->Faces->Allocate(15);
   this->CheckedTetras = vtkIdList::New();
   this->CheckedTetras->Allocate(25);
+  this->LastTetra = -1;
 }
 
 //------------------------------------------------------------------------------
@@ -157,6 +167,97 @@ vtkDelaunay3D::~vtkDelaunay3D()
 static int GetTetraFaceNeighbor(vtkUnstructuredGrid* Mesh, vtkIdType tetraId, vtkIdType p1,
   vtkIdType p2, vtkIdType p3, vtkIdType& nei);
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Scramble a point id into a reproducible pseudo-random number (splitmix64).
+vtkTypeUInt64 HashPointId(vtkIdType ptId)
+{
+  vtkTypeUInt64 z = static_cast<vtkTypeUInt64>(ptId) + 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+//------------------------------------------------------------------------------
+// Compute a biased randomized insertion order of the input points. Points
+// are spread over rounds of doubling size (half of the points in the last
+// round, a quarter in the previous one, and so on) so that the triangulation
+// grows evenly, and each round visits the buckets of a static point locator
+// along a serpentine path so that consecutive points are close to each
+// other. The order only depends on the point ids and positions.
+void ComputeInsertionOrder(vtkPointSet* input, std::vector<vtkIdType>& order)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(input);
+  locator->SetNumberOfPointsPerBucket(4);
+  locator->BuildLocator();
+  int divs[3];
+  locator->GetDivisions(divs);
+  const vtkIdType nx = divs[0];
+  const vtkIdType ny = divs[1];
+  const vtkIdType numBuckets = nx * ny * divs[2];
+
+  // Bucket visited at each step of the path: rows alternate direction in
+  // x, and slices alternate direction in y.
+  auto pathBucket = [nx, ny](vtkIdType step)
+  {
+    const vtkIdType row = step / nx;
+    const vtkIdType slice = row / ny;
+    const vtkIdType i = row % 2 ? nx - 1 - step % nx : step % nx;
+    const vtkIdType j = slice % 2 ? ny - 1 - row % ny : row % ny;
+    return i + j * nx + slice * nx * ny;
+  };
+
+  // Rank of each point along the path.
+  std::vector<vtkIdType> offsets(numBuckets);
+  vtkSMPTools::For(0, numBuckets,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType step = begin; step < end; ++step)
+      {
+        offsets[step] = locator->GetNumberOfPointsInBucket(pathBucket(step));
+      }
+    });
+  vtkSMPTools::ExclusiveScan(offsets.begin(), offsets.end(), offsets.begin(), vtkIdType(0));
+
+  int numRounds = 1;
+  while ((numPts >> (numRounds + 4)) > 0)
+  {
+    ++numRounds;
+  }
+  std::vector<vtkIdType> keys(numPts);
+  vtkSMPThreadLocalObject<vtkIdList> bucketIds;
+  vtkSMPTools::For(0, numBuckets,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdList* ids = bucketIds.Local();
+      for (vtkIdType step = begin; step < end; ++step)
+      {
+        locator->GetBucketIds(pathBucket(step), ids);
+        for (vtkIdType n = 0; n < ids->GetNumberOfIds(); ++n)
+        {
+          const vtkIdType ptId = ids->GetId(n);
+          vtkTypeUInt64 hash = HashPointId(ptId);
+          int level = 0;
+          while (level < numRounds - 1 && !(hash & 1))
+          {
+            hash >>= 1;
+            ++level;
+          }
+          keys[ptId] = (numRounds - 1 - level) * numPts + offsets[step] + n;
+        }
+      }
+    });
+
+  order.resize(numPts);
+  std::iota(order.begin(), order.end(), 0);
+  vtkSMPTools::Sort(order.begin(), order.end(),
+    [&keys](vtkIdType ptId0, vtkIdType ptId1) { return keys[ptId0] < keys[ptId1]; });
+}
+} // anonymous namespace
+
 //------------------------------------------------------------------------------
 // Find all faces that enclose a point. (Enclosure means not satisfying
 // Delaunay criterion.) This method works in two distinct parts. First, the
@@ -190,26 +291,37 @@ vtkIdType vtkDelaunay3D::FindEnclosingFaces(double x[3], vtkUnstructuredGrid* Me
     return 0;
   }
 
-  closestPoint = locator->FindClosestInsertedPoint(x);
-  vtkCellLinks* links = static_cast<vtkCellLinks*>(Mesh->GetLinks());
-  int numCells = links->GetNcells(closestPoint);
-  vtkIdType* cells = links->GetCells(closestPoint);
-  if (numCells <= 0) // shouldn't happen
+  // When points are inserted in spatial order, the previous point is close:
+  // walk from the last created tetrahedron first.
+  tetraId = -1;
+  if (this->UseSpatialSortInsertion && this->LastTetra >= 0)
   {
-    this->NumberOfDegeneracies++;
-    return 0;
-  }
-  else
-  {
-    tetraId = cells[0];
+    tetraId = this->FindTetra(Mesh, xd, this->LastTetra, 0);
   }
 
-  // Okay, walk towards the containing tetrahedron
-  tetraId = this->FindTetra(Mesh, xd, tetraId, 0);
   if (tetraId < 0)
   {
-    this->NumberOfDegeneracies++;
-    return 0;
+    closestPoint = locator->FindClosestInsertedPoint(x);
+    vtkCellLinks* links = static_cast<vtkCellLinks*>(Mesh->GetLinks());
+    int numCells = links->GetNcells(closestPoint);
+    vtkIdType* cells = links->GetCells(closestPoint);
+    if (numCells <= 0) // shouldn't happen
+    {
+      this->NumberOfDegeneracies++;
+      return 0;
+    }
+    else
+    {
+      tetraId = cells[0];
+    }
+
+    // Okay, walk towards the containing tetrahedron
+    tetraId = this->FindTetra(Mesh, xd, tetraId, 0);
+    if (tetraId < 0)
+    {
+      this->NumberOfDegeneracies++;
+      return 0;
+    }
   }
 
   // Initialize the list of tetras who contain the point according
@@ -482,16 +594,22 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
   // of tetra cause tetra to be deleted, leaving a void with bounding
   // faces. Combination of point and each face is used to form new
   // tetrahedra.
-  for (ptId = 0; ptId < numPoints; ptId++)
+  std::vector<vtkIdType> insertionOrder;
+  if (this->UseSpatialSortInsertion)
+  {
+    ::ComputeInsertionOrder(input, insertionOrder);
+  }
+  for (i = 0; i < numPoints; i++)
   {
+    ptId = this->UseSpatialSortInsertion ? insertionOrder[i] : i;
     inPoints->GetPoint(ptId, x);
 
     this->InsertPoint(Mesh, points, ptId, x, holeTetras);
 
-    if (!(ptId % 250))
+    if (!(i % 250))
     {
-      vtkDebugMacro(<< "point #" << ptId);
-      this->UpdateProgress(static_cast<double>(ptId) / numPoints);
+      vtkDebugMacro(<< "point #" << i);
+      this->UpdateProgress(static_cast<double>(i) / numPoints);
       if (this->CheckAbort())
       {
         break;
@@ -784,6 +902,7 @@ vtkUnstructuredGrid* vtkDelaunay3D::InitPointInsertion(
 
   this->NumberOfDuplicatePoints = 0;
   this->NumberOfDegeneracies = 0;
+  this->LastTetra = -1;
 
   if (length <= 0.0)
   {
@@ -949,6 +1068,7 @@ void vtkDelaunay3D::InsertPoint(
       }
 
       this->InsertTetra(Mesh, points, tetraId);
+      this->LastTetra = tetraId;
 
     } // for each face
 
@@ -1059,6 +1179,8 @@ void vtkDelaunay3D::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Use Spatial Sort Insertion: "
+     << (this->UseSpatialSortInsertion ? "On\n" : "Off\n");
 }
 
 //------------------------------------------------------------------------------
@@ -75,6 +75,15 @@
  * will be found. However, in degenerate cases an enclosing tetrahedron may
  * not be found and the point will be rejected.
  *
+ * @warning
+ * When UseSpatialSortInsertion is on, the points are inserted in a spatially
+ * coherent order and each search walks from the tetrahedron created last,
+ * falling back to the closest inserted point when the walk fails. For points
+ * in general position the triangulation is the same. The output may differ
+ * from the default one for degenerate input, such as cospherical points or
+ * points on a lattice, and for the choice of the coincident point which is
+ * kept, since they depend on the insertion order.
+ *
  * @sa
  * vtkDelaunay2D vtkGaussianSplatter vtkUnstructuredGrid
  */
@@ -253,6 +262,25 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Specify whether to insert the points in a spatially sorted order. When
+   * on, the input points are bucketed with a vtkStaticPointLocator and sorted
+   * with vtkSMPTools in a biased randomized insertion order: successive rounds
+   * of doubling size, each one traversing the buckets along a space filling
+   * path. Only the sort uses threads: the points are still inserted one after
+   * another, but each point is located by a short walk from the previous one
+   * instead of a search of the closest inserted point, which makes the
+   * triangulation of millions of points practical. Alpha shapes and the
+   * bounding triangulation are handled as usual. Since the insertion order
+   * changes, the output may differ from the default one for degenerate or
+   * cospherical points (see the warning above). Default is off.
+   */
+  vtkSetMacro(UseSpatialSortInsertion, bool);
+  vtkGetMacro(UseSpatialSortInsertion, bool);
+  vtkBooleanMacro(UseSpatialSortInsertion, bool);
+  ///@}
+
 protected:
   vtkDelaunay3D();
   ~vtkDelaunay3D() override;
@@ -268,6 +296,7 @@ protected:
   vtkTypeBool BoundingTriangulation;
   double Offset;
   int OutputPointsPrecision;
+  bool UseSpatialSortInsertion;
 
   vtkIncrementalPointLocator* Locator; // help locate points faster
 
@@ -291,6 +320,7 @@ private:                    // members added for performance
   vtkIdList* Tetras;        // used in InsertPoint
   vtkIdList* Faces;         // used in InsertPoint
   vtkIdList* CheckedTetras; // used by InsertPoint
+  vtkIdType LastTetra;      // start of the walks when UseSpatialSortInsertion is on
 
   vtkDelaunay3D(const vtkDelaunay3D&) = delete;
   void operator=(const vtkDelaunay3D&) = delete;
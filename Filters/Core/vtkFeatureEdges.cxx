@@ -15,11 +15,17 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticEdgeLocatorTemplate.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleStrip.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
 #include <map>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkFeatureEdges);
@@ -28,6 +34,187 @@ namespace
 {
 constexpr unsigned char CELL_NOT_VISIBLE =
   vtkDataSetAttributes::HIDDENCELL | vtkDataSetAttributes::DUPLICATECELL;
+
+// Types of the polygon edges, as classified by ClassifyPolygonEdges().
+enum EdgeType : unsigned char
+{
+  NOT_EXTRACTED = 0,
+  BOUNDARY_EDGE,
+  NON_MANIFOLD_EDGE,
+  FEATURE_EDGE,
+  MANIFOLD_EDGE
+};
+
+// A use of an edge by a polygon. Slot is the position of the edge in the
+// polygons connectivity, i.e. the offset of the polygon plus the index of
+// the edge in the polygon.
+struct EdgeUse
+{
+  vtkIdType CellId;
+  vtkIdType Slot;
+};
+using EdgeUseTuple = EdgeTuple<vtkIdType, EdgeUse>;
+
+// Classify all the polygon edges concurrently, when UseThreading is on. The
+// uses of each edge are gathered by sorting them with a
+// vtkStaticEdgeLocatorTemplate, and the neighbors of a polygon across an edge
+// are the other polygons of the group, in ascending order. Unlike
+// vtkPolyData::GetCellEdgeNeighbors(), a polygon using both end points of the
+// edge without having it as an edge (e.g. as the diagonal of a quad) is not a
+// neighbor. The classification is then the one of the sequential loop of
+// vtkFeatureEdges::RequestData(), and its result is stored per slot in types.
+void ClassifyPolygonEdges(vtkFeatureEdges* self, vtkCellArray* polys,
+  const std::vector<unsigned char>& hidden, vtkFloatArray* polyNormals, double cosAngle,
+  std::vector<unsigned char>& types)
+{
+  const vtkIdType numPolys = polys->GetNumberOfCells();
+  const vtkIdType numSlots = polys->GetNumberOfConnectivityIds();
+  types.assign(numSlots, NOT_EXTRACTED);
+
+  std::vector<EdgeUseTuple> edges(numSlots);
+  vtkSMPThreadLocalObject<vtkIdList> tlCellPts;
+  vtkSMPTools::For(0, numPolys,
+    [&](vtkIdType cellId, vtkIdType endCellId)
+    {
+      vtkIdList* cellPts = tlCellPts.Local();
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (; cellId < endCellId; ++cellId)
+      {
+        polys->GetCellAtId(cellId, npts, pts, cellPts);
+        const vtkIdType offset = polys->GetOffset(cellId);
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          edges[offset + i] =
+            EdgeUseTuple(pts[i], pts[(i + 1) % npts], EdgeUse{ cellId, offset + i });
+        }
+      }
+    });
+
+  vtkStaticEdgeLocatorTemplate<vtkIdType, EdgeUse> edgeLocator;
+  vtkIdType numUniqueEdges;
+  const vtkIdType* edgeOffsets = edgeLocator.MergeEdges(numSlots, edges.data(), numUniqueEdges);
+
+  const bool boundaryEdges = self->GetBoundaryEdges();
+  const bool nonManifoldEdges = self->GetNonManifoldEdges();
+  const bool featureEdges = self->GetFeatureEdges();
+  const bool manifoldEdges = self->GetManifoldEdges();
+  const bool removeGhostInterfaces = self->GetRemoveGhostInterfaces();
+  const bool hasGhosts = !hidden.empty();
+  vtkSMPThreadLocal<std::vector<vtkIdType>> tlCells;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> tlNeighbors;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> tlGhostNeighbors;
+  vtkSMPTools::For(0, numUniqueEdges,
+    [&](vtkIdType edgeId, vtkIdType endEdgeId)
+    {
+      std::vector<vtkIdType>& cells = tlCells.Local();
+      std::vector<vtkIdType>& neighbors = tlNeighbors.Local();
+      std::vector<vtkIdType>& ghostNeighbors = tlGhostNeighbors.Local();
+      for (; edgeId < endEdgeId; ++edgeId)
+      {
+        EdgeUseTuple* first = edges.data() + edgeOffsets[edgeId];
+        EdgeUseTuple* last = edges.data() + edgeOffsets[edgeId + 1];
+        if (first->V0 == first->V1)
+        {
+          continue; // degenerate edge
+        }
+        std::sort(first, last,
+          [](const EdgeUseTuple& a, const EdgeUseTuple& b) { return a.Data.Slot < b.Data.Slot; });
+        cells.clear();
+        for (EdgeUseTuple* edge = first; edge != last; ++edge)
+        {
+          if (cells.empty() || cells.back() != edge->Data.CellId)
+          {
+            cells.push_back(edge->Data.CellId);
+          }
+        }
+
+        for (EdgeUseTuple* edge = first; edge != last; ++edge)
+        {
+          const vtkIdType cellId = edge->Data.CellId;
+          if (hasGhosts && hidden[cellId])
+          {
+            continue;
+          }
+          neighbors.clear();
+          for (vtkIdType neiId : cells)
+          {
+            if (neiId != cellId)
+            {
+              neighbors.push_back(neiId);
+            }
+          }
+          const vtkIdType numNei = static_cast<vtkIdType>(neighbors.size());
+
+          vtkIdType numNeiWithoutGhosts = numNei;
+          vtkIdType firstNeighbor = 0;
+          ghostNeighbors.clear();
+          if (hasGhosts)
+          {
+            for (vtkIdType j = 0; j < numNei; ++j)
+            {
+              if (hidden[neighbors[j]])
+              {
+                if (nonManifoldEdges)
+                {
+                  ghostNeighbors.push_back(j);
+                }
+                if (j == firstNeighbor)
+                {
+                  ++firstNeighbor;
+                }
+                --numNeiWithoutGhosts;
+              }
+            }
+          }
+          // Ignoring edges that are not visible
+          if (numNeiWithoutGhosts != numNei && removeGhostInterfaces)
+          {
+            continue;
+          }
+
+          unsigned char& type = types[edge->Data.Slot];
+          if (boundaryEdges && numNeiWithoutGhosts < 1)
+          {
+            type = BOUNDARY_EDGE;
+          }
+          else if (nonManifoldEdges && numNeiWithoutGhosts > 1)
+          {
+            // check to make sure that this edge hasn't been created before
+            const vtkIdType numCandidates =
+              hasGhosts ? static_cast<vtkIdType>(ghostNeighbors.size()) : numNei;
+            vtkIdType j;
+            for (j = 0; j < numCandidates; j++)
+            {
+              if (neighbors[hasGhosts ? ghostNeighbors[j] : j] < cellId)
+              {
+                break;
+              }
+            }
+            if (j >= numNeiWithoutGhosts)
+            {
+              type = NON_MANIFOLD_EDGE;
+            }
+          }
+          else if (featureEdges && numNeiWithoutGhosts == 1 && neighbors[firstNeighbor] > cellId)
+          {
+            double neiTuple[3];
+            double cellTuple[3];
+            polyNormals->GetTuple(neighbors[firstNeighbor], neiTuple);
+            polyNormals->GetTuple(cellId, cellTuple);
+            if (vtkMath::Dot(neiTuple, cellTuple) <= cosAngle)
+            {
+              type = FEATURE_EDGE;
+            }
+          }
+          else if (manifoldEdges && numNeiWithoutGhosts == 1 && neighbors[firstNeighbor] > cellId)
+          {
+            type = MANIFOLD_EDGE;
+          }
+        }
+      }
+    });
+}
 } // anonymous namespace
 
 //------------------------------------------------------------------------------
@@ -209,7 +396,10 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
     newPolys = inPolys;
     Mesh->SetPolys(newPolys);
   }
-  Mesh->BuildLinks();
+  if (!this->UseThreading)
+  {
+    Mesh->BuildLinks();
+  }
 
   // Allocate storage for lines/points (arbitrary allocation sizes)
   //
@@ -259,11 +449,33 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
     polyNormals->SetNumberOfComponents(3);
     polyNormals->Allocate(3 * newPolys->GetNumberOfCells());
 
-    vtkIdType cellId;
-    for (cellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts); cellId++)
+    if (this->UseThreading)
+    {
+      polyNormals->SetNumberOfTuples(newPolys->GetNumberOfCells());
+      vtkSMPThreadLocalObject<vtkIdList> tlCellPts;
+      vtkSMPTools::For(0, newPolys->GetNumberOfCells(),
+        [&](vtkIdType cellId, vtkIdType endCellId)
+        {
+          vtkIdList* cellPts = tlCellPts.Local();
+          vtkIdType numCellPts;
+          const vtkIdType* cellPtIds;
+          double normal[3];
+          for (; cellId < endCellId; ++cellId)
+          {
+            newPolys->GetCellAtId(cellId, numCellPts, cellPtIds, cellPts);
+            vtkPolygon::ComputeNormal(inPts, numCellPts, cellPtIds, normal);
+            polyNormals->SetTuple(cellId, normal);
+          }
+        });
+    }
+    else
     {
-      vtkPolygon::ComputeNormal(inPts, npts, pts, n);
-      polyNormals->InsertTuple(cellId, n);
+      vtkIdType cellId;
+      for (cellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts); cellId++)
+      {
+        vtkPolygon::ComputeNormal(inPts, npts, pts, n);
+        polyNormals->InsertTuple(cellId, n);
+      }
     }
 
     cosAngle = cos(vtkMath::RadiansFromDegrees(this->FeatureAngle));
@@ -322,6 +534,41 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  // When threaded, the polygon edges are all classified beforehand, and only
+  // output in the loop below.
+  std::vector<unsigned char> edgeTypes;
+  if (this->UseThreading)
+  {
+    std::vector<unsigned char> hidden;
+    if (ghosts)
+    {
+      hidden.resize(newPolys->GetNumberOfCells());
+      vtkSMPTools::For(0, newPolys->GetNumberOfCells(),
+        [&](vtkIdType polyId, vtkIdType endPolyId)
+        {
+          for (; polyId < endPolyId; ++polyId)
+          {
+            vtkIdType inputCellId;
+            if (numPolys == numCells)
+            {
+              inputCellId = polyId;
+            }
+            else if (polyId < numPolys)
+            {
+              inputCellId = polyIdToCellIdMap->GetId(polyId);
+            }
+            else
+            {
+              auto it = decomposedStripIdToStripIdMap.lower_bound(polyId + 1);
+              inputCellId = stripIdToCellIdMap->GetId(it->second);
+            }
+            hidden[polyId] = (ghosts[inputCellId] & CELL_NOT_VISIBLE) ? 1 : 0;
+          }
+        });
+    }
+    ClassifyPolygonEdges(this, newPolys, hidden, polyNormals, cosAngle, edgeTypes);
+  }
+
   for (newCellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts) && !abort;
        newCellId++)
   {
@@ -358,104 +605,131 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
       p1 = pts[i];
       p2 = pts[(i + 1) % npts];
 
-      Mesh->GetCellEdgeNeighbors(newCellId, p1, p2, neighbors);
-      numNei = neighbors->GetNumberOfIds();
-
-      vtkIdType numNeiWithoutGhosts = numNei;
-      vtkIdType firstNeighbor = 0;
-      if (ghosts)
+      if (this->UseThreading)
       {
-        for (j = 0; j < numNei; ++j)
+        switch (edgeTypes[newPolys->GetOffset(newCellId) + i])
         {
-          vtkIdType neiId = neighbors->GetId(j);
-          vtkIdType neighborCellIdInInput;
-          if (numPolys == numCells)
-          {
-            neighborCellIdInInput = neiId;
-          }
-          else if (neiId < numPolys)
-          {
-            neighborCellIdInInput = polyIdToCellIdMap->GetId(neiId);
-          }
-          else
-          {
-            auto it = decomposedStripIdToStripIdMap.lower_bound(neiId + 1);
-            neighborCellIdInInput = stripIdToCellIdMap->GetId(it->second);
-          }
-          if (ghosts[neighborCellIdInInput] & CELL_NOT_VISIBLE)
+          case BOUNDARY_EDGE:
+            numBEdges++;
+            scalar = 0.0;
+            break;
+          case NON_MANIFOLD_EDGE:
+            numNonManifoldEdges++;
+            scalar = 0.222222;
+            break;
+          case FEATURE_EDGE:
+            numFedges++;
+            scalar = 0.444444;
+            break;
+          case MANIFOLD_EDGE:
+            numManifoldEdges++;
+            scalar = 0.666667;
+            break;
+          default:
+            continue;
+        }
+      }
+      else
+      {
+        Mesh->GetCellEdgeNeighbors(newCellId, p1, p2, neighbors);
+        numNei = neighbors->GetNumberOfIds();
+
+        vtkIdType numNeiWithoutGhosts = numNei;
+        vtkIdType firstNeighbor = 0;
+        if (ghosts)
+        {
+          for (j = 0; j < numNei; ++j)
           {
-            if (this->NonManifoldEdges)
+            vtkIdType neiId = neighbors->GetId(j);
+            vtkIdType neighborCellIdInInput;
+            if (numPolys == numCells)
             {
-              edgesRemapping->InsertNextId(j);
+              neighborCellIdInInput = neiId;
             }
-            if (j == firstNeighbor)
+            else if (neiId < numPolys)
             {
-              ++firstNeighbor;
+              neighborCellIdInInput = polyIdToCellIdMap->GetId(neiId);
+            }
+            else
+            {
+              auto it = decomposedStripIdToStripIdMap.lower_bound(neiId + 1);
+              neighborCellIdInInput = stripIdToCellIdMap->GetId(it->second);
+            }
+            if (ghosts[neighborCellIdInInput] & CELL_NOT_VISIBLE)
+            {
+              if (this->NonManifoldEdges)
+              {
+                edgesRemapping->InsertNextId(j);
+              }
+              if (j == firstNeighbor)
+              {
+                ++firstNeighbor;
+              }
+              --numNeiWithoutGhosts;
             }
-            --numNeiWithoutGhosts;
           }
         }
-      }
-      // Ignoring edges that are not visible
-      if (numNeiWithoutGhosts != numNei && this->RemoveGhostInterfaces)
-      {
-        continue;
-      }
+        // Ignoring edges that are not visible
+        if (numNeiWithoutGhosts != numNei && this->RemoveGhostInterfaces)
+        {
+          continue;
+        }
 
-      if (this->BoundaryEdges && numNeiWithoutGhosts < 1)
-      {
-        numBEdges++;
-        scalar = 0.0;
-      }
+        if (this->BoundaryEdges && numNeiWithoutGhosts < 1)
+        {
+          numBEdges++;
+          scalar = 0.0;
+        }
 
-      else if (this->NonManifoldEdges && numNeiWithoutGhosts > 1)
-      {
-        // check to make sure that this edge hasn't been created before
-        for (j = 0; j < (ghosts ? edgesRemapping->GetNumberOfIds() : numNei); j++)
+        else if (this->NonManifoldEdges && numNeiWithoutGhosts > 1)
         {
-          if (neighbors->GetId(ghosts ? edgesRemapping->GetId(j) : j) < newCellId)
+          // check to make sure that this edge hasn't been created before
+          for (j = 0; j < (ghosts ? edgesRemapping->GetNumberOfIds() : numNei); j++)
           {
-            break;
+            if (neighbors->GetId(ghosts ? edgesRemapping->GetId(j) : j) < newCellId)
+            {
+              break;
+            }
+          }
+          edgesRemapping->Reset();
+          if (j >= numNeiWithoutGhosts)
+          {
+            numNonManifoldEdges++;
+            scalar = 0.222222;
+          }
+          else
+          {
+            continue;
           }
         }
-        edgesRemapping->Reset();
-        if (j >= numNeiWithoutGhosts)
-        {
-          numNonManifoldEdges++;
-          scalar = 0.222222;
-        }
-        else
+        else if (this->FeatureEdges && numNeiWithoutGhosts == 1 &&
+          (nei = neighbors->GetId(firstNeighbor)) > newCellId)
         {
-          continue;
+          double neiTuple[3];
+          double cellTuple[3];
+          polyNormals->GetTuple(nei, neiTuple);
+          polyNormals->GetTuple(newCellId, cellTuple);
+          if (vtkMath::Dot(neiTuple, cellTuple) <= cosAngle)
+          {
+            numFedges++;
+            scalar = 0.444444;
+          }
+          else
+          {
+            continue;
+          }
         }
-      }
-      else if (this->FeatureEdges && numNeiWithoutGhosts == 1 &&
-        (nei = neighbors->GetId(firstNeighbor)) > newCellId)
-      {
-        double neiTuple[3];
-        double cellTuple[3];
-        polyNormals->GetTuple(nei, neiTuple);
-        polyNormals->GetTuple(newCellId, cellTuple);
-        if (vtkMath::Dot(neiTuple, cellTuple) <= cosAngle)
+        else if (this->ManifoldEdges && numNeiWithoutGhosts == 1 &&
+          neighbors->GetId(firstNeighbor) > newCellId)
         {
-          numFedges++;
-          scalar = 0.444444;
+          numManifoldEdges++;
+          scalar = 0.666667;
         }
         else
         {
           continue;
         }
       }
-      else if (this->ManifoldEdges && numNeiWithoutGhosts == 1 &&
-        neighbors->GetId(firstNeighbor) > newCellId)
-      {
-        numManifoldEdges++;
-        scalar = 0.666667;
-      }
-      else
-      {
-        continue;
-      }
 
       // Add edge to output
       Mesh->GetPoint(p1, x1);
@@ -621,5 +895,6 @@ void vtkFeatureEdges::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Use Threading: " << (this->UseThreading ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
@@ -15,6 +15,9 @@
  * based on edge type. The cell coloring is assigned to the cell data of
  * the extracted edges.
  *
+ * When UseThreading is on, the edges of the polygons are classified in
+ * parallel from a sorted list of all the polygon edges instead of cell links.
+ *
  * @warning
  * To see the coloring of the lines you may have to set the ScalarMode
  * instance variable of the mapper to SetScalarModeToUseCellData(). (This
@@ -171,6 +174,28 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off the threaded classification of the polygon edges. When on,
+   * the polygon normals are computed with vtkSMPTools, and all the edges of
+   * the polygons are sorted with vtkStaticEdgeLocatorTemplate so that the
+   * polygons using the same edge are gathered without building cell links;
+   * the boundary, non-manifold, feature and manifold edges are then
+   * classified concurrently. The edges are output (and their points merged
+   * with the Locator) in the same order as the sequential implementation, so
+   * the output is usually the same. It differs in two cases. The zero length
+   * edges of degenerate polygons repeating a point are ignored. And only the
+   * polygons having an edge count as its neighbors, whereas the sequential
+   * implementation (vtkPolyData::GetCellEdgeNeighbors()) also counts the
+   * polygons using both end points without having the edge, such as a quad
+   * whose diagonal is the edge, which changes the classification of such
+   * non-manifold configurations. Default is off.
+   */
+  vtkSetMacro(UseThreading, bool);
+  vtkGetMacro(UseThreading, bool);
+  vtkBooleanMacro(UseThreading, bool);
+  ///@}
+
 protected:
   vtkFeatureEdges();
   ~vtkFeatureEdges() override;
@@ -190,6 +215,7 @@ protected:
   bool RemoveGhostInterfaces;
   int OutputPointsPrecision;
   vtkIncrementalPointLocator* Locator;
+  bool UseThreading = false;
 
 private:
   vtkFeatureEdges(const vtkFeatureEdges&) = delete;
@@ -5,6 +5,7 @@
 #include "vtkCell.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkConnectedRegionsInternal.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
@@ -16,6 +17,7 @@
 #include "vtkPolyData.h"
 
 #include <algorithm> // for fill_n
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkPolyDataConnectivityFilter);
@@ -47,6 +49,7 @@ vtkPolyDataConnectivityFilter::vtkPolyDataConnectivityFilter()
   this->VisitedPointIds = vtkIdList::New();
 
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->UseThreading = false;
 }
 
 vtkPolyDataConnectivityFilter::~vtkPolyDataConnectivityFilter()
@@ -119,7 +122,15 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   //
   this->Mesh = vtkPolyData::New();
   this->Mesh->CopyStructure(input);
-  this->Mesh->BuildLinks();
+  if (this->UseThreading)
+  {
+    // static cell links are built by the threaded traversal
+    this->Mesh->BuildCells();
+  }
+  else
+  {
+    this->Mesh->BuildLinks();
+  }
   this->UpdateProgress(0.10);
 
   // Remove all visited point ids
@@ -171,7 +182,11 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   this->PointIds->Allocate(8, VTK_CELL_SIZE);
   vtkIdType checkAbortInterval = 0;
 
-  if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
+  if (this->UseThreading)
+  { // label all regions at once with threads
+    largestRegionId = this->ThreadedTraverseAndMark();
+  }
+  else if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
@@ -529,6 +544,73 @@ void vtkPolyDataConnectivityFilter::TraverseAndMark()
   } // while wave is not empty
 }
 
+//------------------------------------------------------------------------------
+vtkIdType vtkPolyDataConnectivityFilter::ThreadedTraverseAndMark()
+{
+  const vtkIdType numCells = this->Mesh->GetNumberOfCells();
+  const vtkIdType numPts = this->Mesh->GetNumberOfPoints();
+  const bool seeded = this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS ||
+    this->ExtractionMode == VTK_EXTRACT_CELL_SEEDED_REGIONS ||
+    this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_REGION;
+
+  ConnectedRegions regions(
+    this, this->Mesh, this->InScalars, this->ScalarRange, this->FullScalarConnectivity != 0);
+  bool labelled = regions.BuildComponents();
+  this->UpdateProgress(0.5);
+  if (labelled && !seeded)
+  {
+    labelled = regions.LabelAllRegions(this->Visited);
+  }
+  else if (labelled)
+  {
+    std::vector<vtkIdType> seedCells;
+    auto addPointCells = [&](vtkIdType ptId)
+    {
+      const vtkIdType* cells = regions.GetPointCells(ptId);
+      seedCells.insert(seedCells.end(), cells, cells + regions.GetNumberOfPointCells(ptId));
+    };
+    if (this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS)
+    {
+      for (vtkIdType i = 0; i < this->Seeds->GetNumberOfIds(); i++)
+      {
+        const vtkIdType ptId = this->Seeds->GetId(i);
+        if (ptId >= 0 && ptId < numPts)
+        {
+          addPointCells(ptId);
+        }
+      }
+    }
+    else if (this->ExtractionMode == VTK_EXTRACT_CELL_SEEDED_REGIONS)
+    {
+      seedCells.assign(this->Seeds->begin(), this->Seeds->end());
+    }
+    else
+    {
+      addPointCells(regions.FindClosestPoint(this->ClosestPoint));
+    }
+    labelled = regions.LabelSeededRegion(seedCells, this->Visited);
+  }
+  if (!labelled)
+  {
+    std::fill_n(this->Visited, numCells, -1);
+    return 0;
+  }
+  this->UpdateProgress(0.8);
+
+  // Leave the traversal state as the sequential traversal does.
+  const vtkIdType numRegions = static_cast<vtkIdType>(regions.RegionSizes.size());
+  this->RegionSizes->SetNumberOfValues(numRegions);
+  std::copy(regions.RegionSizes.begin(), regions.RegionSizes.end(),
+    this->RegionSizes->GetPointer(0));
+  this->RegionNumber = seeded ? 0 : numRegions;
+  vtkIdTypeArray* pointRegions = vtkArrayDownCast<vtkIdTypeArray>(this->NewScalars);
+  this->PointNumber = regions.MapPoints(this->Visited, this->PointMap, pointRegions->GetPointer(0));
+  this->UpdateProgress(0.9);
+
+  return std::max_element(regions.RegionSizes.begin(), regions.RegionSizes.end()) -
+    regions.RegionSizes.begin();
+}
+
 //------------------------------------------------------------------------------
 int vtkPolyDataConnectivityFilter::IsScalarConnected(vtkIdType cellId)
 {
@@ -666,5 +748,6 @@ void vtkPolyDataConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Use Threading: " << (this->UseThreading ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
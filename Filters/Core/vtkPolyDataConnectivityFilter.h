@@ -218,6 +218,21 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Specify whether to label the regions with threads. When on, the cells
+   * satisfying the connectivity criterion are grouped with a concurrent
+   * union-find over static cell links, which supports all the extraction
+   * modes and produces the same region ids and extracted cells as the
+   * sequential traversal. The only difference is the order of the output
+   * points, which follows the input point ids instead of the traversal.
+   * Default is OFF.
+   */
+  vtkSetMacro(UseThreading, bool);
+  vtkGetMacro(UseThreading, bool);
+  vtkBooleanMacro(UseThreading, bool);
+  ///@}
+
 protected:
   vtkPolyDataConnectivityFilter();
   ~vtkPolyDataConnectivityFilter() override;
@@ -243,6 +258,10 @@ protected:
 
   void TraverseAndMark();
 
+  // Threaded counterpart of TraverseAndMark() labelling all the regions at
+  // once. Returns the id of the largest region.
+  vtkIdType ThreadedTraverseAndMark();
+
   // used to support algorithm execution
   vtkDataArray* CellScalars;
   vtkIdList* NeighborCellPointIds;
@@ -262,6 +281,7 @@ protected:
 
   vtkTypeBool MarkVisitedPointIds;
   int OutputPointsPrecision;
+  bool UseThreading;
 
 private:
   vtkPolyDataConnectivityFilter(const vtkPolyDataConnectivityFilter&) = delete;
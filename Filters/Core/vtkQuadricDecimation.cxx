@@ -41,12 +41,73 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 #include "vtkType.h"
 
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkQuadricDecimation);
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Lower an atomic value to the given one when it is smaller.
+void QuadricAtomicMin(std::atomic<vtkIdType>& value, vtkIdType newValue)
+{
+  vtkIdType current = value.load(std::memory_order_relaxed);
+  while (newValue < current &&
+    !value.compare_exchange_weak(current, newValue, std::memory_order_relaxed))
+  {
+  }
+}
+
+//------------------------------------------------------------------------------
+// Per thread buffers used to compute the cost of the edge collapses.
+struct QuadricCostBuffers
+{
+  std::vector<double> Quad;
+  std::vector<double> Data;
+  std::vector<double*> A;
+  std::vector<double> B;
+
+  void Allocate(int quadSize, int dim)
+  {
+    if (!this->Quad.empty())
+    {
+      return;
+    }
+    this->Quad.resize(quadSize);
+    this->Data.resize(dim * dim);
+    this->A.resize(dim);
+    this->B.resize(dim);
+    for (int i = 0; i < dim; ++i)
+    {
+      this->A[i] = this->Data.data() + i * dim;
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// Whether the triangle uses the three given points, as in vtkPolyData::IsTriangle.
+bool QuadricTriangleUses(const vtkIdType* pts, vtkIdType v0, vtkIdType v1, vtkIdType v2)
+{
+  for (vtkIdType v : { v0, v1, v2 })
+  {
+    if (pts[0] != v && pts[1] != v && pts[2] != v)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+} // anonymous namespace
+
 //------------------------------------------------------------------------------
 vtkQuadricDecimation::vtkQuadricDecimation()
 {
@@ -321,27 +382,31 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
-  vtkDebugMacro(<< "Computing Edges");
-  this->Edges->InitEdgeInsertion(numPts, 1); // storing edge id as attribute
-  this->EdgeCosts->Allocate(this->Mesh->GetPolys()->GetNumberOfCells() * 3);
-  for (i = 0; i < this->Mesh->GetNumberOfCells(); i++)
+  // The threaded decimation enumerates the edges at each pass.
+  if (!this->UseThreading)
   {
-    this->Mesh->GetCellPoints(i, npts, pts);
-
-    for (j = 0; j < 3; j++)
+    vtkDebugMacro(<< "Computing Edges");
+    this->Edges->InitEdgeInsertion(numPts, 1); // storing edge id as attribute
+    this->EdgeCosts->Allocate(this->Mesh->GetPolys()->GetNumberOfCells() * 3);
+    for (i = 0; i < this->Mesh->GetNumberOfCells(); i++)
     {
-      if (this->Edges->IsEdge(pts[j], pts[(j + 1) % 3]) == -1)
+      this->Mesh->GetCellPoints(i, npts, pts);
+
+      for (j = 0; j < 3; j++)
       {
-        // If this edge has not been processed, get an id for it, add it to
-        // the edge list (Edges), and add its endpoints to the EndPoint1List
-        // and EndPoint2List (the 2 endpoints to different lists).
-        edgeId = this->Edges->GetNumberOfEdges();
-        this->Edges->InsertEdge(pts[j], pts[(j + 1) % 3], edgeId);
-        this->EndPoint1List->InsertId(edgeId, pts[j]);
-        this->EndPoint2List->InsertId(edgeId, pts[(j + 1) % 3]);
+        if (this->Edges->IsEdge(pts[j], pts[(j + 1) % 3]) == -1)
+        {
+          // If this edge has not been processed, get an id for it, add it to
+          // the edge list (Edges), and add its endpoints to the EndPoint1List
+          // and EndPoint2List (the 2 endpoints to different lists).
+          edgeId = this->Edges->GetNumberOfEdges();
+          this->Edges->InsertEdge(pts[j], pts[(j + 1) % 3], edgeId);
+          this->EndPoint1List->InsertId(edgeId, pts[j]);
+          this->EndPoint2List->InsertId(edgeId, pts[(j + 1) % 3]);
+        }
       }
-    }
-  } // end for
+    } // end for
+  }
 
   this->UpdateProgress(0.1);
 
@@ -373,77 +438,86 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   this->AddBoundaryConstraints();
   this->UpdateProgress(0.15);
 
-  vtkDebugMacro(<< "Computing Costs");
-  // Compute the cost of and target point for collapsing each edge.
-  for (i = 0; i < this->Edges->GetNumberOfEdges(); i++)
+  if (this->UseThreading)
   {
-    if (this->AttributeErrorMetric)
-    {
-      cost = this->ComputeCost2(i, x);
-    }
-    else
-    {
-      cost = this->ComputeCost(i, x);
-    }
-    this->EdgeCosts->Insert(cost, i);
-    this->TargetPoints->InsertTuple(i, x);
+    vtkDebugMacro(<< "Collapsing edges in batches");
+    numDeletedTris = this->ThreadedCollapseEdges(numPts, numTris);
+    vtkDebugMacro(<< "Number Of Edge Collapses: " << this->NumberOfEdgeCollapses);
   }
-  this->UpdateProgress(0.20);
-
-  // Okay collapse edges until desired reduction is reached
-  this->ActualReduction = 0.0;
-  this->NumberOfEdgeCollapses = 0;
-  edgeId = this->EdgeCosts->Pop(0, cost);
-
-  bool abort = false;
-  while (!abort && edgeId >= 0 && cost < this->MaximumError &&
-    this->ActualReduction < this->TargetReduction)
+  else
   {
-    if (!(this->NumberOfEdgeCollapses % 10000))
+    vtkDebugMacro(<< "Computing Costs");
+    // Compute the cost of and target point for collapsing each edge.
+    for (i = 0; i < this->Edges->GetNumberOfEdges(); i++)
     {
-      vtkDebugMacro(<< "Collapsing edge#" << this->NumberOfEdgeCollapses);
-      this->UpdateProgress(0.20 + 0.80 * this->NumberOfEdgeCollapses / numPts);
-      abort = this->CheckAbort();
+      if (this->AttributeErrorMetric)
+      {
+        cost = this->ComputeCost2(i, x);
+      }
+      else
+      {
+        cost = this->ComputeCost(i, x);
+      }
+      this->EdgeCosts->Insert(cost, i);
+      this->TargetPoints->InsertTuple(i, x);
     }
+    this->UpdateProgress(0.20);
 
-    endPtIds[0] = this->EndPoint1List->GetId(edgeId);
-    endPtIds[1] = this->EndPoint2List->GetId(edgeId);
-    this->TargetPoints->GetTuple(edgeId, x);
+    // Okay collapse edges until desired reduction is reached
+    this->ActualReduction = 0.0;
+    this->NumberOfEdgeCollapses = 0;
+    edgeId = this->EdgeCosts->Pop(0, cost);
 
-    // check for a poorly placed point
-    if (!this->IsGoodPlacement(endPtIds[0], endPtIds[1], x))
+    bool abort = false;
+    while (!abort && edgeId >= 0 && cost < this->MaximumError &&
+      this->ActualReduction < this->TargetReduction)
     {
-      vtkDebugMacro(<< "Poor placement detected " << edgeId << " " << cost);
-      // return the point to the queue but with the max cost so that
-      // when it is recomputed it will be reconsidered
-      this->EdgeCosts->Insert(VTK_DOUBLE_MAX, edgeId);
+      if (!(this->NumberOfEdgeCollapses % 10000))
+      {
+        vtkDebugMacro(<< "Collapsing edge#" << this->NumberOfEdgeCollapses);
+        this->UpdateProgress(0.20 + 0.80 * this->NumberOfEdgeCollapses / numPts);
+        abort = this->CheckAbort();
+      }
 
-      edgeId = this->EdgeCosts->Pop(0, cost);
-      continue;
-    }
+      endPtIds[0] = this->EndPoint1List->GetId(edgeId);
+      endPtIds[1] = this->EndPoint2List->GetId(edgeId);
+      this->TargetPoints->GetTuple(edgeId, x);
 
-    this->NumberOfEdgeCollapses++;
+      // check for a poorly placed point
+      if (!this->IsGoodPlacement(endPtIds[0], endPtIds[1], x))
+      {
+        vtkDebugMacro(<< "Poor placement detected " << edgeId << " " << cost);
+        // return the point to the queue but with the max cost so that
+        // when it is recomputed it will be reconsidered
+        this->EdgeCosts->Insert(VTK_DOUBLE_MAX, edgeId);
 
-    // Set the new coordinates of point0.
-    this->SetPointActiveAttributes(endPtIds[0], x);
-    this->SetPointAttributeArray(endPtIds, x);
-    this->SetPointCoordinates(endPtIds[0], x);
+        edgeId = this->EdgeCosts->Pop(0, cost);
+        continue;
+      }
 
-    vtkDebugMacro(<< "Cost: " << cost << " Edge: " << endPtIds[0] << " " << endPtIds[1]);
+      this->NumberOfEdgeCollapses++;
 
-    // Merge the quadrics of the two points.
-    this->AddQuadric(endPtIds[1], endPtIds[0]);
+      // Set the new coordinates of point0.
+      this->SetPointActiveAttributes(endPtIds[0], x);
+      this->SetPointAttributeArray(endPtIds, x);
+      this->SetPointCoordinates(endPtIds[0], x);
 
-    this->UpdateEdgeData(endPtIds[0], endPtIds[1]);
+      vtkDebugMacro(<< "Cost: " << cost << " Edge: " << endPtIds[0] << " " << endPtIds[1]);
 
-    // Update the output triangles.
-    numDeletedTris += this->CollapseEdge(endPtIds[0], endPtIds[1]);
-    this->ActualReduction = (double)numDeletedTris / numTris;
-    edgeId = this->EdgeCosts->Pop(0, cost);
-  }
+      // Merge the quadrics of the two points.
+      this->AddQuadric(endPtIds[1], endPtIds[0]);
+
+      this->UpdateEdgeData(endPtIds[0], endPtIds[1]);
+
+      // Update the output triangles.
+      numDeletedTris += this->CollapseEdge(endPtIds[0], endPtIds[1]);
+      this->ActualReduction = (double)numDeletedTris / numTris;
+      edgeId = this->EdgeCosts->Pop(0, cost);
+    }
 
-  vtkDebugMacro(<< "Number Of Edge Collapses: " << this->NumberOfEdgeCollapses
-                << " Cost: " << cost);
+    vtkDebugMacro(<< "Number Of Edge Collapses: " << this->NumberOfEdgeCollapses
+                  << " Cost: " << cost);
+  }
 
   // clean up working data
   for (i = 0; i < numPts; i++)
@@ -970,6 +1044,13 @@ void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
 
 //------------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
+{
+  return this->ComputeCost(
+    this->EndPoint1List->GetId(edgeId), this->EndPoint2List->GetId(edgeId), x, this->TempQuad);
+}
+
+//------------------------------------------------------------------------------
+double vtkQuadricDecimation::ComputeCost(vtkIdType pt0Id, vtkIdType pt1Id, double* x, double* quad)
 {
   static const double errorNumber = 1e-10;
   double temp[3], A[3][3], b[3];
@@ -981,25 +1062,25 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
   double v[3], c, norm, normTemp, temp2[3];
   double pt1[3], pt2[3];
 
-  pointIds[0] = this->EndPoint1List->GetId(edgeId);
-  pointIds[1] = this->EndPoint2List->GetId(edgeId);
+  pointIds[0] = pt0Id;
+  pointIds[1] = pt1Id;
 
   for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
   {
-    this->TempQuad[i] =
+    quad[i] =
       this->ErrorQuadrics[pointIds[0]].Quadric[i] + this->ErrorQuadrics[pointIds[1]].Quadric[i];
   }
 
-  A[0][0] = this->TempQuad[0];
-  A[0][1] = A[1][0] = this->TempQuad[1];
-  A[0][2] = A[2][0] = this->TempQuad[2];
-  A[1][1] = this->TempQuad[4];
-  A[1][2] = A[2][1] = this->TempQuad[5];
-  A[2][2] = this->TempQuad[7];
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
 
-  b[0] = -this->TempQuad[3];
-  b[1] = -this->TempQuad[6];
-  b[2] = -this->TempQuad[8];
+  b[0] = -quad[3];
+  b[1] = -quad[6];
+  b[2] = -quad[8];
 
   norm = vtkMath::Norm(A[0]);
   normTemp = vtkMath::Norm(A[1]);
@@ -1051,7 +1132,7 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
 
   // Compute the cost
   // x'*quad*x
-  index = this->TempQuad;
+  index = quad;
   for (i = 0; i < 4; i++)
   {
     cost += (*index++) * newPoint[i] * newPoint[i];
@@ -1066,6 +1147,14 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
 
 //------------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
+{
+  return this->ComputeCost2(this->EndPoint1List->GetId(edgeId),
+    this->EndPoint2List->GetId(edgeId), x, this->TempQuad, this->TempA, this->TempB);
+}
+
+//------------------------------------------------------------------------------
+double vtkQuadricDecimation::ComputeCost2(
+  vtkIdType pt0Id, vtkIdType pt1Id, double* x, double* quad, double** A, double* b)
 {
   // this function is so ugly because the functionality of converting an QEM
   // into a dense matrix was not extracted into a separate function and
@@ -1076,34 +1165,34 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
   int i, j;
   int solveOk;
 
-  pointIds[0] = this->EndPoint1List->GetId(edgeId);
-  pointIds[1] = this->EndPoint2List->GetId(edgeId);
+  pointIds[0] = pt0Id;
+  pointIds[1] = pt1Id;
 
   for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
   {
-    this->TempQuad[i] =
+    quad[i] =
       this->ErrorQuadrics[pointIds[0]].Quadric[i] + this->ErrorQuadrics[pointIds[1]].Quadric[i];
   }
 
   // copy the temp quad into TempA
   // converting from the sparse matrix format into a dense
-  this->TempA[0][0] = this->TempQuad[0];
-  this->TempA[0][1] = this->TempA[1][0] = this->TempQuad[1];
-  this->TempA[0][2] = this->TempA[2][0] = this->TempQuad[2];
-  this->TempA[1][1] = this->TempQuad[4];
-  this->TempA[1][2] = this->TempA[2][1] = this->TempQuad[5];
-  this->TempA[2][2] = this->TempQuad[7];
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
 
-  this->TempB[0] = -this->TempQuad[3];
-  this->TempB[1] = -this->TempQuad[6];
-  this->TempB[2] = -this->TempQuad[8];
+  b[0] = -quad[3];
+  b[1] = -quad[6];
+  b[2] = -quad[8];
 
   for (i = 3; i < 3 + this->NumberOfComponents; i++)
   {
-    this->TempA[0][i] = this->TempA[i][0] = this->TempQuad[11 + (4 * (i - 3))];
-    this->TempA[1][i] = this->TempA[i][1] = this->TempQuad[11 + (4 * (i - 3)) + 1];
-    this->TempA[2][i] = this->TempA[i][2] = this->TempQuad[11 + (4 * (i - 3)) + 2];
-    this->TempB[i] = -this->TempQuad[11 + (4 * (i - 3)) + 3];
+    A[0][i] = A[i][0] = quad[11 + (4 * (i - 3))];
+    A[1][i] = A[i][1] = quad[11 + (4 * (i - 3)) + 1];
+    A[2][i] = A[i][2] = quad[11 + (4 * (i - 3)) + 2];
+    b[i] = -quad[11 + (4 * (i - 3)) + 3];
   }
 
   // Set zero to all components of the submatrix a[3:n;3:n] and al to its diagonal
@@ -1113,11 +1202,11 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i == j)
       {
-        this->TempA[i][j] = this->TempQuad[10];
+        A[i][j] = quad[10];
       }
       else
       {
-        this->TempA[i][j] = 0;
+        A[i][j] = 0;
       }
     }
   }
@@ -1128,50 +1217,46 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i >= 3)
       {
-        this->TempA[i][3 + this->NumberOfComponents] = 0;
-        this->TempA[3 + this->NumberOfComponents][i] = 0;
+        A[i][3 + this->NumberOfComponents] = 0;
+        A[3 + this->NumberOfComponents][i] = 0;
       }
       else
       {
-        this->TempA[i][3 + this->NumberOfComponents] =
-          this->VolumeConstraints[(pointIds[0] * 4) + i];
-        this->TempA[3 + this->NumberOfComponents][i] =
-          this->VolumeConstraints[(pointIds[0] * 4) + i];
-        this->TempA[i][3 + this->NumberOfComponents] +=
-          this->VolumeConstraints[(pointIds[1] * 4) + i];
-        this->TempA[3 + this->NumberOfComponents][i] +=
-          this->VolumeConstraints[(pointIds[1] * 4) + i];
+        A[i][3 + this->NumberOfComponents] = this->VolumeConstraints[(pointIds[0] * 4) + i];
+        A[3 + this->NumberOfComponents][i] = this->VolumeConstraints[(pointIds[0] * 4) + i];
+        A[i][3 + this->NumberOfComponents] += this->VolumeConstraints[(pointIds[1] * 4) + i];
+        A[3 + this->NumberOfComponents][i] += this->VolumeConstraints[(pointIds[1] * 4) + i];
       }
     }
     // Add constraint to b
-    this->TempB[3 + this->NumberOfComponents] = this->VolumeConstraints[(pointIds[0] * 4) + 3];
-    this->TempB[3 + this->NumberOfComponents] += this->VolumeConstraints[(pointIds[1] * 4) + 3];
+    b[3 + this->NumberOfComponents] = this->VolumeConstraints[(pointIds[0] * 4) + 3];
+    b[3 + this->NumberOfComponents] += this->VolumeConstraints[(pointIds[1] * 4) + 3];
   }
 
   for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    x[i] = this->TempB[i];
+    x[i] = b[i];
   }
 
   // solve A*x = b
   // this clobers A
   // need to develop a quality of the solution test??
-  solveOk = vtkMath::SolveLinearSystem(
-    this->TempA, x, 3 + this->NumberOfComponents + this->VolumePreservation);
+  solveOk =
+    vtkMath::SolveLinearSystem(A, x, 3 + this->NumberOfComponents + this->VolumePreservation);
 
   // need to copy back into A
-  this->TempA[0][0] = this->TempQuad[0];
-  this->TempA[0][1] = this->TempA[1][0] = this->TempQuad[1];
-  this->TempA[0][2] = this->TempA[2][0] = this->TempQuad[2];
-  this->TempA[1][1] = this->TempQuad[4];
-  this->TempA[1][2] = this->TempA[2][1] = this->TempQuad[5];
-  this->TempA[2][2] = this->TempQuad[7];
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
 
   for (i = 3; i < 3 + this->NumberOfComponents; i++)
   {
-    this->TempA[0][i] = this->TempA[i][0] = this->TempQuad[11 + 4 * (i - 3)];
-    this->TempA[1][i] = this->TempA[i][1] = this->TempQuad[11 + 4 * (i - 3) + 1];
-    this->TempA[2][i] = this->TempA[i][2] = this->TempQuad[11 + 4 * (i - 3) + 2];
+    A[0][i] = A[i][0] = quad[11 + 4 * (i - 3)];
+    A[1][i] = A[i][1] = quad[11 + 4 * (i - 3) + 1];
+    A[2][i] = A[i][2] = quad[11 + 4 * (i - 3) + 2];
   }
 
   for (i = 3; i < 3 + this->NumberOfComponents; i++)
@@ -1180,11 +1265,11 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i == j)
       {
-        this->TempA[i][j] = this->TempQuad[10];
+        A[i][j] = quad[10];
       }
       else
       {
-        this->TempA[i][j] = 0;
+        A[i][j] = 0;
       }
     }
   }
@@ -1195,17 +1280,15 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i >= 3)
       {
-        this->TempA[i][3 + this->NumberOfComponents] = 0;
-        this->TempA[3 + this->NumberOfComponents][i] = 0;
+        A[i][3 + this->NumberOfComponents] = 0;
+        A[3 + this->NumberOfComponents][i] = 0;
       }
       else
       {
-        this->TempA[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[i][3 + this->NumberOfComponents] +=
-          this->VolumeConstraints[pointIds[1] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] +=
-          this->VolumeConstraints[pointIds[1] * 4 + i];
+        A[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        A[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        A[i][3 + this->NumberOfComponents] += this->VolumeConstraints[pointIds[1] * 4 + i];
+        A[3 + this->NumberOfComponents][i] += this->VolumeConstraints[pointIds[1] * 4 + i];
       }
     }
   }
@@ -1238,7 +1321,7 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
       temp2[i] = 0;
       for (j = 0; j < 3 + this->NumberOfComponents; ++j)
       {
-        temp2[i] += this->TempA[i][j] * v[j];
+        temp2[i] += A[i][j] * v[j];
       }
     }
 
@@ -1256,13 +1339,13 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
         temp[i] = 0;
         for (j = 0; j < 3 + this->NumberOfComponents; ++j)
         {
-          temp[i] += this->TempA[i][j] * pt1[j];
+          temp[i] += A[i][j] * pt1[j];
         }
       }
 
       for (i = 0; i < 3 + this->NumberOfComponents; i++)
       {
-        temp[i] = this->TempB[i] - temp[i];
+        temp[i] = b[i] - temp[i];
       }
 
       for (i = 0; i < 3 + this->NumberOfComponents; i++)
@@ -1291,18 +1374,18 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
   // x'*A*x - 2*b*x + d
   for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    cost += this->TempA[i][i] * x[i] * x[i];
+    cost += A[i][i] * x[i] * x[i];
     for (j = i + 1; j < 3 + this->NumberOfComponents + this->VolumePreservation; j++)
     {
-      cost += 2.0 * this->TempA[i][j] * x[i] * x[j];
+      cost += 2.0 * A[i][j] * x[i] * x[j];
     }
   }
   for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    cost -= 2.0 * this->TempB[i] * x[i];
+    cost -= 2.0 * b[i] * x[i];
   }
 
-  cost += this->TempQuad[9];
+  cost += quad[9];
 
   return cost;
 }
@@ -1363,6 +1446,438 @@ int vtkQuadricDecimation::CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id)
   return numDeleted;
 }
 
+//------------------------------------------------------------------------------
+vtkIdType vtkQuadricDecimation::ThreadedCollapseEdges(vtkIdType numPts, vtkIdType numTris)
+{
+  const int quadSize = 11 + 4 * this->NumberOfComponents;
+  const int dim = 3 + this->NumberOfComponents + this->VolumePreservation;
+  vtkSMPThreadLocal<QuadricCostBuffers> tlBuffers;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> tlNeighbors;
+
+  // Working copy of the triangles. Deleted triangles, and cells which are not
+  // triangles, are marked with a negative first point id.
+  std::vector<vtkIdType> tris(3 * numTris);
+  for (vtkIdType cellId = 0; cellId < numTris; ++cellId)
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    this->Mesh->GetCellPoints(cellId, npts, pts);
+    vtkIdType* tri = tris.data() + 3 * cellId;
+    if (npts == 3)
+    {
+      std::copy(pts, pts + 3, tri);
+    }
+    else
+    {
+      std::fill(tri, tri + 3, -1);
+    }
+  }
+
+  std::vector<std::atomic<vtkIdType>> counts(numPts);
+  std::vector<vtkIdType> pointCounts(numPts);
+  std::vector<vtkIdType> offsets(numPts + 1);
+  std::vector<vtkIdType> pointTris;
+  std::vector<vtkIdType> numNeighbors(numPts);
+  std::vector<vtkIdType> edgeOffsets(numPts + 1);
+  std::vector<vtkIdType> edgePts;
+  std::vector<double> costs;
+  std::vector<double> targets;
+  std::vector<vtkIdType> isCandidate;
+  std::vector<vtkIdType> candidates;
+  std::vector<vtkIdType> positions;
+  std::vector<std::atomic<vtkIdType>> minRanks(numPts);
+  std::vector<vtkIdType> isSelected;
+  std::vector<vtkIdType> deletions;
+  std::vector<vtkIdType> batch;
+  std::vector<vtkIdType> batchDeletions;
+
+  // Triangles using a point, which are still in the mesh at the current pass.
+  auto pointTrisBegin = [&](vtkIdType ptId) { return pointTris.data() + offsets[ptId]; };
+  auto pointTrisEnd = [&](vtkIdType ptId) { return pointTris.data() + offsets[ptId + 1]; };
+
+  // Same check as IsGoodPlacement using the triangles of the current pass.
+  auto isGoodPlacement = [&](vtkIdType pt0Id, vtkIdType pt1Id, const double* x)
+  {
+    double pt1[3], pt2[3], pt3[3];
+    for (int i = 0; i < 2; ++i)
+    {
+      const vtkIdType ptId = i == 0 ? pt0Id : pt1Id;
+      const vtkIdType otherId = i == 0 ? pt1Id : pt0Id;
+      for (const vtkIdType* triId = pointTrisBegin(ptId); triId != pointTrisEnd(ptId); ++triId)
+      {
+        const vtkIdType* pts = tris.data() + 3 * *triId;
+        if (pts[0] == otherId || pts[1] == otherId || pts[2] == otherId)
+        {
+          continue;
+        }
+        for (int j = 0; j < 3; ++j)
+        {
+          if (pts[j] == ptId)
+          {
+            this->Mesh->GetPoint(pts[j], pt1);
+            this->Mesh->GetPoint(pts[(j + 1) % 3], pt2);
+            this->Mesh->GetPoint(pts[(j + 2) % 3], pt3);
+            if (!this->TrianglePlaneCheck(pt1, pt2, pt3, x))
+            {
+              return false;
+            }
+          }
+        }
+      }
+    }
+    return true;
+  };
+
+  // Same as CollapseEdge on the working triangles: triangles using both points
+  // are deleted, pt1Id is replaced by pt0Id in the others unless that would
+  // duplicate an existing triangle.
+  auto collapseEdge = [&](vtkIdType pt0Id, vtkIdType pt1Id)
+  {
+    vtkIdType numDeleted = 0;
+    for (const vtkIdType* triId = pointTrisBegin(pt1Id); triId != pointTrisEnd(pt1Id); ++triId)
+    {
+      vtkIdType* pts = tris.data() + 3 * *triId;
+      if (pts[0] == pt0Id || pts[1] == pt0Id || pts[2] == pt0Id)
+      {
+        pts[0] = -1;
+        numDeleted++;
+      }
+    }
+    for (const vtkIdType* triId = pointTrisBegin(pt1Id); triId != pointTrisEnd(pt1Id); ++triId)
+    {
+      vtkIdType* pts = tris.data() + 3 * *triId;
+      if (pts[0] < 0)
+      {
+        continue;
+      }
+      vtkIdType newPts[3];
+      for (int j = 0; j < 3; ++j)
+      {
+        newPts[j] = pts[j] == pt1Id ? pt0Id : pts[j];
+      }
+      // The triangles now using pt0Id are the ones of pt0Id and the ones of
+      // pt1Id already processed.
+      bool duplicate = false;
+      for (const vtkIdType* otherId = pointTrisBegin(pt0Id);
+           !duplicate && otherId != pointTrisEnd(pt0Id); ++otherId)
+      {
+        const vtkIdType* otherPts = tris.data() + 3 * *otherId;
+        duplicate = otherPts[0] >= 0 &&
+          QuadricTriangleUses(otherPts, newPts[0], newPts[1], newPts[2]);
+      }
+      for (const vtkIdType* otherId = pointTrisBegin(pt1Id); !duplicate && otherId != triId;
+           ++otherId)
+      {
+        const vtkIdType* otherPts = tris.data() + 3 * *otherId;
+        duplicate = otherPts[0] >= 0 &&
+          QuadricTriangleUses(otherPts, newPts[0], newPts[1], newPts[2]);
+      }
+      if (duplicate)
+      {
+        pts[0] = -1;
+        numDeleted++;
+      }
+      else
+      {
+        std::copy(newPts, newPts + 3, pts);
+      }
+    }
+    return numDeleted;
+  };
+
+  this->ActualReduction = 0.0;
+  this->NumberOfEdgeCollapses = 0;
+  vtkIdType numDeletedTris = 0;
+  bool abort = false;
+  while (!abort && numTris > 0 && this->ActualReduction < this->TargetReduction)
+  {
+    // Link the points to the remaining triangles. Each list is sorted so that
+    // the result does not depend on the scheduling of the threads.
+    vtkSMPTools::Fill(counts.begin(), counts.end(), 0);
+    vtkSMPTools::For(0, numTris,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType triId = begin; triId < end; ++triId)
+        {
+          const vtkIdType* pts = tris.data() + 3 * triId;
+          if (pts[0] < 0)
+          {
+            continue;
+          }
+          for (int j = 0; j < 3; ++j)
+          {
+            if ((j < 1 || pts[j] != pts[0]) && (j < 2 || pts[j] != pts[1]))
+            {
+              counts[pts[j]]++;
+            }
+          }
+        }
+      });
+    vtkSMPTools::For(0, numPts,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType ptId = begin; ptId < end; ++ptId)
+        {
+          pointCounts[ptId] = counts[ptId];
+        }
+      });
+    offsets[numPts] = vtkSMPTools::ExclusiveScan(
+      pointCounts.begin(), pointCounts.end(), offsets.begin(), vtkIdType(0));
+    pointTris.resize(offsets[numPts]);
+    vtkSMPTools::For(0, numPts,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType ptId = begin; ptId < end; ++ptId)
+        {
+          counts[ptId] = offsets[ptId];
+        }
+      });
+    vtkSMPTools::For(0, numTris,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType triId = begin; triId < end; ++triId)
+        {
+          const vtkIdType* pts = tris.data() + 3 * triId;
+          if (pts[0] < 0)
+          {
+            continue;
+          }
+          for (int j = 0; j < 3; ++j)
+          {
+            if ((j < 1 || pts[j] != pts[0]) && (j < 2 || pts[j] != pts[1]))
+            {
+              pointTris[counts[pts[j]]++] = triId;
+            }
+          }
+        }
+      });
+
+    // Enumerate the edges, numbered by their first (smallest) point.
+    vtkSMPTools::For(0, numPts,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        std::vector<vtkIdType>& neighbors = tlNeighbors.Local();
+        for (vtkIdType ptId = begin; ptId < end; ++ptId)
+        {
+          std::sort(pointTrisBegin(ptId), pointTrisEnd(ptId));
+          neighbors.clear();
+          for (const vtkIdType* triId = pointTrisBegin(ptId); triId != pointTrisEnd(ptId);
+               ++triId)
+          {
+            const vtkIdType* pts = tris.data() + 3 * *triId;
+            for (int j = 0; j < 3; ++j)
+            {
+              if (pts[j] > ptId)
+              {
+                neighbors.push_back(pts[j]);
+              }
+            }
+          }
+          std::sort(neighbors.begin(), neighbors.end());
+          numNeighbors[ptId] = std::unique(neighbors.begin(), neighbors.end()) - neighbors.begin();
+        }
+      });
+    edgeOffsets[numPts] = vtkSMPTools::ExclusiveScan(
+      numNeighbors.begin(), numNeighbors.end(), edgeOffsets.begin(), vtkIdType(0));
+    const vtkIdType numEdges = edgeOffsets[numPts];
+    edgePts.resize(2 * numEdges);
+    costs.resize(numEdges);
+    targets.assign(static_cast<size_t>(dim) * numEdges, 0.0);
+    isCandidate.resize(numEdges);
+    positions.resize(numEdges);
+    isSelected.resize(numEdges);
+    deletions.resize(numEdges);
+
+    // Compute the cost and the target point of each collapse. Poorly placed
+    // points and costs above the maximum error exclude the edge from the pass.
+    vtkSMPTools::For(0, numPts,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        std::vector<vtkIdType>& neighbors = tlNeighbors.Local();
+        QuadricCostBuffers& buffers = tlBuffers.Local();
+        buffers.Allocate(quadSize, dim);
+        for (vtkIdType ptId = begin; ptId < end; ++ptId)
+        {
+          neighbors.clear();
+          for (const vtkIdType* triId = pointTrisBegin(ptId); triId != pointTrisEnd(ptId);
+               ++triId)
+          {
+            const vtkIdType* pts = tris.data() + 3 * *triId;
+            for (int j = 0; j < 3; ++j)
+            {
+              if (pts[j] > ptId)
+              {
+                neighbors.push_back(pts[j]);
+              }
+            }
+          }
+          std::sort(neighbors.begin(), neighbors.end());
+          neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+
+          vtkIdType edgeId = edgeOffsets[ptId];
+          for (vtkIdType neighborId : neighbors)
+          {
+            edgePts[2 * edgeId] = ptId;
+            edgePts[2 * edgeId + 1] = neighborId;
+            double* x = targets.data() + static_cast<size_t>(dim) * edgeId;
+            if (this->AttributeErrorMetric)
+            {
+              costs[edgeId] = this->ComputeCost2(ptId, neighborId, x, buffers.Quad.data(),
+                buffers.A.data(), buffers.B.data());
+            }
+            else
+            {
+              costs[edgeId] = this->ComputeCost(ptId, neighborId, x, buffers.Quad.data());
+            }
+            isCandidate[edgeId] =
+              costs[edgeId] < this->MaximumError && isGoodPlacement(ptId, neighborId, x);
+            edgeId++;
+          }
+        }
+      });
+
+    // Rank the candidate collapses by cost, ties being broken by edge id.
+    const vtkIdType numCandidates = vtkSMPTools::ExclusiveScan(
+      isCandidate.begin(), isCandidate.end(), positions.begin(), vtkIdType(0));
+    if (numCandidates == 0)
+    {
+      break;
+    }
+    candidates.resize(numCandidates);
+    vtkSMPTools::For(0, numEdges,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType edgeId = begin; edgeId < end; ++edgeId)
+        {
+          if (isCandidate[edgeId])
+          {
+            candidates[positions[edgeId]] = edgeId;
+          }
+        }
+      });
+    vtkSMPTools::Sort(candidates.begin(), candidates.end(),
+      [&](vtkIdType a, vtkIdType b)
+      { return costs[a] < costs[b] || (costs[a] == costs[b] && a < b); });
+    vtkSMPTools::Fill(minRanks.begin(), minRanks.end(), numEdges);
+    vtkSMPTools::For(0, numCandidates,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType rank = begin; rank < end; ++rank)
+        {
+          const vtkIdType edgeId = candidates[rank];
+          QuadricAtomicMin(minRanks[edgePts[2 * edgeId]], rank);
+          QuadricAtomicMin(minRanks[edgePts[2 * edgeId + 1]], rank);
+        }
+      });
+
+    // Select the collapses which are the cheapest of all the points of the
+    // triangles around their end points. The triangles modified by two
+    // selected collapses are then disjoint, as are the points they move.
+    vtkSMPTools::For(0, numCandidates,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType rank = begin; rank < end; ++rank)
+        {
+          const vtkIdType edgeId = candidates[rank];
+          const vtkIdType pt0Id = edgePts[2 * edgeId];
+          const vtkIdType pt1Id = edgePts[2 * edgeId + 1];
+          bool selected = minRanks[pt0Id] == rank && minRanks[pt1Id] == rank;
+          vtkIdType numDeleted = 0;
+          for (vtkIdType ptId : { pt0Id, pt1Id })
+          {
+            for (const vtkIdType* triId = pointTrisBegin(ptId);
+                 selected && triId != pointTrisEnd(ptId); ++triId)
+            {
+              const vtkIdType* pts = tris.data() + 3 * *triId;
+              selected = minRanks[pts[0]] >= rank && minRanks[pts[1]] >= rank &&
+                minRanks[pts[2]] >= rank;
+              if (ptId == pt0Id && (pts[0] == pt1Id || pts[1] == pt1Id || pts[2] == pt1Id))
+              {
+                numDeleted++;
+              }
+            }
+          }
+          isSelected[rank] = selected;
+          deletions[rank] = numDeleted;
+        }
+      });
+
+    // Gather the selected collapses by increasing cost, and only keep those
+    // needed to reach the target reduction.
+    const vtkIdType numSelected = vtkSMPTools::ExclusiveScan(isSelected.begin(),
+      isSelected.begin() + numCandidates, positions.begin(), vtkIdType(0));
+    batch.resize(numSelected);
+    vtkSMPTools::For(0, numCandidates,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType rank = begin; rank < end; ++rank)
+        {
+          if (isSelected[rank])
+          {
+            batch[positions[rank]] = rank;
+          }
+        }
+      });
+    vtkIdType batchSize = 0;
+    for (vtkIdType expected = numDeletedTris; batchSize < numSelected &&
+         static_cast<double>(expected) / numTris < this->TargetReduction;
+         ++batchSize)
+    {
+      expected += deletions[batch[batchSize]];
+    }
+
+    // Collapse the batch.
+    batchDeletions.resize(batchSize);
+    vtkSMPTools::For(0, batchSize,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          const vtkIdType edgeId = candidates[batch[i]];
+          vtkIdType endPtIds[2] = { edgePts[2 * edgeId], edgePts[2 * edgeId + 1] };
+          const double* x = targets.data() + static_cast<size_t>(dim) * edgeId;
+
+          // Set the new coordinates of point0.
+          this->SetPointActiveAttributes(endPtIds[0], x);
+          this->SetPointAttributeArray(endPtIds, x);
+          this->SetPointCoordinates(endPtIds[0], x);
+
+          // Merge the quadrics of the two points.
+          this->AddQuadric(endPtIds[1], endPtIds[0]);
+
+          batchDeletions[i] = collapseEdge(endPtIds[0], endPtIds[1]);
+        }
+      });
+    numDeletedTris += std::accumulate(batchDeletions.begin(), batchDeletions.end(), vtkIdType(0));
+    this->NumberOfEdgeCollapses += batchSize;
+    this->ActualReduction = static_cast<double>(numDeletedTris) / numTris;
+
+    vtkDebugMacro(<< "Collapsed " << batchSize << " edges out of " << numEdges);
+    this->UpdateProgress(0.20 + 0.80 * this->NumberOfEdgeCollapses / numPts);
+    abort = this->CheckAbort();
+  }
+
+  // Update the working mesh with the remaining triangles.
+  for (vtkIdType cellId = 0; cellId < numTris; ++cellId)
+  {
+    const vtkIdType* pts = tris.data() + 3 * cellId;
+    if (this->Mesh->GetCellSize(cellId) != 3)
+    {
+      continue;
+    }
+    if (pts[0] < 0)
+    {
+      this->Mesh->DeleteCell(cellId);
+    }
+    else
+    {
+      this->Mesh->ReplaceCell(cellId, 3, pts);
+    }
+  }
+
+  return numDeletedTris;
+}
+
 // triangle t0, t1, t2 and point x
 // determines if t0 and x are on the same side of the plane defined by
 // t1 and t2, and parallel to the normal of the triangle
@@ -1591,5 +2106,6 @@ void vtkQuadricDecimation::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Normals Weight: " << this->NormalsWeight << "\n";
   os << indent << "TCoords Weight: " << this->TCoordsWeight << "\n";
   os << indent << "Tensors Weight: " << this->TensorsWeight << "\n";
+  os << indent << "Use Threading: " << (this->UseThreading ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
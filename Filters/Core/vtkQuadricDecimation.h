@@ -37,6 +37,12 @@
  * Attributes" is also a good take on the subject especially as it pertains
  * to the error metric applied to attributes.
  *
+ * @warning
+ * When UseThreading is on, the edges are not collapsed one at a time in the
+ * order of a global priority queue but in batches of independent collapses,
+ * each batch being processed concurrently. The result is therefore close to,
+ * but not the same as, the sequential one.
+ *
  * @par Thanks:
  * Thanks to Bradley Lowekamp of the National Library of Medicine/NIH for
  * contributing this class.
@@ -208,6 +214,23 @@ public:
   vtkGetMacro(ActualReduction, double);
   ///@}
 
+  ///@{
+  /**
+   * Collapse the edges in parallel. Each pass computes the cost of all the
+   * remaining edges concurrently and collapses, all at once, the edges which
+   * are the cheapest of the triangles around their two end points. Such
+   * collapses do not touch the same triangles so the batch is processed with
+   * vtkSMPTools. Passes go on until TargetReduction or MaximumError is
+   * reached; the last batch is cut so that the reduction is not overshot.
+   * The quadrics, attribute errors, volume preservation and boundary
+   * constraints are the same as for the sequential decimation, and the
+   * output does not depend on the number of threads. Default is off.
+   */
+  vtkSetMacro(UseThreading, bool);
+  vtkGetMacro(UseThreading, bool);
+  vtkBooleanMacro(UseThreading, bool);
+  ///@}
+
 protected:
   vtkQuadricDecimation();
   ~vtkQuadricDecimation() override;
@@ -250,6 +273,24 @@ protected:
   double ComputeCost2(vtkIdType edgeId, double* x);
   ///@}
 
+  ///@{
+  /**
+   * Compute cost for contracting the edge between these two points, using
+   * the given buffers instead of the temporary variables so that costs can be
+   * computed concurrently. `quad` holds 11 + 4 * NumberOfComponents values,
+   * `A` and `b` the dense system of the attribute error metric.
+   */
+  double ComputeCost(vtkIdType pt0Id, vtkIdType pt1Id, double* x, double* quad);
+  double ComputeCost2(
+    vtkIdType pt0Id, vtkIdType pt1Id, double* x, double* quad, double** A, double* b);
+  ///@}
+
+  /**
+   * Collapse edges in independent batches until the desired reduction is
+   * reached, when UseThreading is on. Return the number of triangles deleted.
+   */
+  vtkIdType ThreadedCollapseEdges(vtkIdType numPts, vtkIdType numTris);
+
   /**
    * Find all edges that will have an endpoint change ids because of an edge
    * collapse.  p1Id and p2Id are the endpoints of the edge.  p2Id is the
@@ -314,6 +355,7 @@ protected:
   vtkTypeBool VolumePreservation;
 
   bool MapPointData = false;
+  bool UseThreading = false;
 
   vtkTypeBool ScalarsAttribute;
   vtkTypeBool VectorsAttribute;
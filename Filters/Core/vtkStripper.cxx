@@ -12,12 +12,288 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkStripper);
 
+namespace
+{
+//------------------------------------------------------------------------------
+// The strips, poly-lines and passed polygons built from one partition of the
+// cells when UseThreading is on, and the input cells of their field data
+// tuples.
+struct StripperPartition
+{
+  vtkNew<vtkCellArray> Strips;
+  vtkNew<vtkCellArray> Lines;
+  vtkNew<vtkCellArray> Polys;
+  std::vector<vtkIdType> StripCellIds;
+  std::vector<vtkIdType> LineCellIds;
+  std::vector<vtkIdType> PolyCellIds;
+  vtkIdType NumberOfStrips = 0;
+  vtkIdType NumberOfLines = 0;
+  vtkIdType LongestStrip = 0;
+  vtkIdType LongestLine = 0;
+};
+
+// Strip partitions of the cells. A partition only grows its strips and
+// poly-lines with cells of the same partition, so that the partitions only
+// touch their own visited flags and can be stripped concurrently, the mesh
+// being only read through its thread-safe accessors. Without threading, all
+// the cells are stripped as a single partition.
+struct StripPartitions
+{
+  vtkPolyData* Mesh;
+  char* Visited;
+  vtkIdType NumberOfCells;
+  vtkIdType PartitionSize;
+  vtkIdType MaximumLength;
+  vtkIdType ProgressInterval;
+  bool RecordCellIds;
+  std::vector<StripperPartition>& Partitions;
+  vtkStripper* Filter;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> Pts;
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+  vtkSMPThreadLocalObject<vtkIdList> CellPts;
+
+  StripPartitions(vtkPolyData* mesh, char* visited, vtkIdType partitionSize,
+    vtkIdType maximumLength, bool recordCellIds, std::vector<StripperPartition>& partitions,
+    vtkStripper* filter)
+    : Mesh(mesh)
+    , Visited(visited)
+    , NumberOfCells(mesh->GetNumberOfCells())
+    , PartitionSize(partitionSize)
+    , MaximumLength(maximumLength)
+    , ProgressInterval(mesh->GetNumberOfCells() / 20 + 1)
+    , RecordCellIds(recordCellIds)
+    , Partitions(partitions)
+    , Filter(filter)
+  {
+  }
+
+  void operator()(vtkIdType beginPartition, vtkIdType endPartition)
+  {
+    const bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType partitionId = beginPartition; partitionId < endPartition; ++partitionId)
+    {
+      const vtkIdType first = partitionId * this->PartitionSize;
+      const vtkIdType last = std::min(first + this->PartitionSize, this->NumberOfCells);
+      if (!this->StripPartition(first, last, this->Partitions[partitionId], isFirst))
+      {
+        break;
+      }
+    }
+  }
+
+  // Strip the cells [first, last). Only the thread reporting progress updates
+  // the progress and checks for an abort, the others follow its abort flag.
+  // Return false if the execution was aborted.
+  bool StripPartition(
+    vtkIdType first, vtkIdType last, StripperPartition& partition, bool reportProgress)
+  {
+    vtkPolyData* mesh = this->Mesh;
+    char* visited = this->Visited;
+    std::vector<vtkIdType>& ptsBuffer = this->Pts.Local();
+    ptsBuffer.resize(this->MaximumLength + 2);
+    vtkIdType* pts = ptsBuffer.data();
+    vtkIdList* cellIds = this->CellIds.Local();
+    vtkIdList* cellPts = this->CellPts.Local();
+    auto isAvailable = [&](vtkIdType cellId, int cellType)
+    {
+      return cellId >= first && cellId < last && !visited[cellId] &&
+        mesh->GetCellType(cellId) == cellType;
+    };
+
+    vtkIdType numPts, numCellPts, neighbor = 0, i;
+    const vtkIdType* cellPtIds;
+    for (vtkIdType cellId = first; cellId < last; cellId++)
+    {
+      if (!(cellId % this->ProgressInterval))
+      {
+        if (reportProgress)
+        {
+          this->Filter->UpdateProgress(static_cast<double>(cellId) / this->NumberOfCells);
+          this->Filter->CheckAbort();
+        }
+        if (this->Filter->GetAbortOutput())
+        {
+          return false;
+        }
+      }
+      if (visited[cellId])
+      {
+        continue;
+      }
+      visited[cellId] = 1;
+      const int cellType = mesh->GetCellType(cellId);
+      if (cellType == VTK_TRIANGLE)
+      {
+        //  Got a starting point for the strip.  Initialize.  Find a neighbor
+        //  to extend strip.
+        //
+        partition.NumberOfStrips++;
+        numPts = 3;
+        mesh->GetCellPoints(cellId, numCellPts, cellPtIds, cellPts);
+        for (i = 0; i < 3; i++)
+        {
+          pts[1] = cellPtIds[i];
+          pts[2] = cellPtIds[(i + 1) % 3];
+          mesh->GetCellEdgeNeighbors(cellId, pts[1], pts[2], cellIds);
+          if (cellIds->GetNumberOfIds() > 0 &&
+            isAvailable(neighbor = cellIds->GetId(0), VTK_TRIANGLE))
+          {
+            pts[0] = cellPtIds[(i + 2) % 3];
+            break;
+          }
+        }
+        if (this->RecordCellIds)
+        {
+          partition.StripCellIds.push_back(cellId);
+        }
+        //  If no unvisited neighbor, just create the strip of one triangle.
+        //
+        if (i >= 3)
+        {
+          partition.Strips->InsertNextCell(3, cellPtIds);
+          continue;
+        }
+        //  Have a neighbor.  March along grabbing new points
+        //
+        while (neighbor >= 0)
+        {
+          visited[neighbor] = 1;
+          mesh->GetCellPoints(neighbor, numCellPts, cellPtIds, cellPts);
+          if (this->RecordCellIds)
+          {
+            partition.StripCellIds.push_back(neighbor);
+          }
+          for (i = 0; i < 3; i++)
+          {
+            if (cellPtIds[i] != pts[numPts - 2] && cellPtIds[i] != pts[numPts - 1])
+            {
+              break;
+            }
+          }
+          // only add the triangle to the strip if it isn't degenerate.
+          if (i < 3)
+          {
+            pts[numPts] = cellPtIds[i];
+            mesh->GetCellEdgeNeighbors(neighbor, pts[numPts], pts[numPts - 1], cellIds);
+            numPts++;
+          }
+          partition.LongestStrip = std::max(numPts, partition.LongestStrip);
+
+          // note: if updates value of neighbor
+          // Note2: for a degenerate triangle this test will
+          // correctly fail because the visited[neighbor] will
+          // now be visited
+          if (cellIds->GetNumberOfIds() <= 0 ||
+            !isAvailable(neighbor = cellIds->GetId(0), VTK_TRIANGLE) ||
+            numPts >= (this->MaximumLength + 2))
+          {
+            partition.Strips->InsertNextCell(numPts, pts);
+            neighbor = -1;
+          }
+        }
+      }
+      else if (cellType == VTK_LINE)
+      {
+        //
+        //  Got a starting point for the line.  Initialize.  Find a neighbor
+        //  to extend poly-line.
+        //
+        partition.NumberOfLines++;
+        numPts = 2;
+        mesh->GetCellPoints(cellId, numCellPts, cellPtIds, cellPts);
+        vtkIdType numNeighbors;
+        vtkIdType* neighbors;
+        bool foundOne = false;
+        for (i = 0; !foundOne && i < 2; i++)
+        {
+          pts[0] = cellPtIds[i];
+          pts[1] = cellPtIds[(i + 1) % 2];
+          mesh->GetPointCells(pts[1], numNeighbors, neighbors);
+          for (vtkIdType j = 0; j < numNeighbors; j++)
+          {
+            neighbor = neighbors[j];
+            if (neighbor != cellId && isAvailable(neighbor, VTK_LINE))
+            {
+              foundOne = true;
+              break;
+            }
+          }
+        }
+        // for each polyline that we construct, we set the cell data to be that
+        // for the first cell that formed the polyline. We may build the field data
+        // for the mini-cells in the polyline, similar to triangle strips,
+        // but that is not required currently.
+        if (this->RecordCellIds)
+        {
+          partition.LineCellIds.push_back(cellId);
+        }
+        //  If no unvisited neighbor, just create the poly-line from one line.
+        //
+        if (!foundOne)
+        {
+          partition.Lines->InsertNextCell(2, cellPtIds);
+          continue;
+        }
+        while (neighbor >= 0)
+        {
+          visited[neighbor] = 1;
+          mesh->GetCellPoints(neighbor, numCellPts, cellPtIds, cellPts);
+          for (i = 0; i < 2; i++)
+          {
+            if (cellPtIds[i] != pts[numPts - 1])
+            {
+              break;
+            }
+          }
+          pts[numPts] = cellPtIds[i];
+          mesh->GetPointCells(pts[numPts], numNeighbors, neighbors);
+          partition.LongestLine = std::max(++numPts, partition.LongestLine);
+
+          // get new neighbor
+          vtkIdType j;
+          for (j = 0; j < numNeighbors; j++)
+          {
+            if (neighbors[j] != neighbor && isAvailable(neighbors[j], VTK_LINE))
+            {
+              neighbor = neighbors[j];
+              break;
+            }
+          }
+          if (j >= numNeighbors || numPts >= (this->MaximumLength + 1))
+          {
+            partition.Lines->InsertNextCell(numPts, pts);
+            neighbor = -1;
+          }
+        }
+      }
+      // not line, triangle, or strip must be quad or tpolygon which we pass through
+      else if (cellType == VTK_POLYGON || cellType == VTK_QUAD)
+      {
+        mesh->GetCellPoints(cellId, numCellPts, cellPtIds, cellPts);
+        partition.Polys->InsertNextCell(numCellPts, cellPtIds);
+        if (this->RecordCellIds)
+        {
+          partition.PolyCellIds.push_back(cellId);
+        }
+      }
+    }
+    return true;
+  }
+};
+} // anonymous namespace
+
 // Construct object with MaximumLength set to 1000.
 vtkStripper::vtkStripper()
 {
@@ -40,21 +316,16 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
   vtkIdType cellId, numCells, i;
-  int longestStrip, longestLine, j, numPts;
-  vtkIdType numLines, numStrips, nei;
+  int longestStrip, longestLine;
+  vtkIdType numLines, numStrips;
   vtkCellArray *newStrips = nullptr, *inStrips, *newLines = nullptr, *inLines, *inPolys;
   vtkCellArray* newPolys = nullptr;
   vtkIdType numLinePts = 0;
-  vtkIdList* cellIds;
-  int foundOne;
-  vtkIdType *pts, neighbor = 0;
   vtkPolyData* mesh;
   char* visited;
   vtkIdType numStripPts = 0;
   const vtkIdType* stripPts = nullptr;
   const vtkIdType* linePts = nullptr;
-  const vtkIdType* triPts;
-  vtkIdType numTriPts;
   vtkPointData* pd = input->GetPointData();
   vtkCellData* cd = input->GetCellData();
 
@@ -96,10 +367,6 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  pts = new vtkIdType[this->MaximumLength + 2]; // working array
-  cellIds = vtkIdList::New();
-  cellIds->Allocate(this->MaximumLength + 2);
-
   // The new field data object that maintains the transformed cell data.
   if (this->PassCellDataAsFieldData)
   {
@@ -227,227 +494,71 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
   longestLine = 0;
   numLines = 0;
 
-  int cellType;
-  bool abort = false;
-  vtkIdType progressInterval = numCells / 20 + 1;
-  for (cellId = 0; cellId < numCells && !abort; cellId++)
+  // Strip the cells, concurrently in partitions of PartitionSize cells when
+  // UseThreading is on, or else as a single partition. The partitions are
+  // merged in order, as if they had been stripped one after the other.
+  std::vector<StripperPartition> partitions(
+    this->UseThreading ? (numCells + this->PartitionSize - 1) / this->PartitionSize : 1);
+  StripPartitions stripPartitions(mesh, visited, this->PartitionSize, this->MaximumLength,
+    this->PassCellDataAsFieldData || this->PassThroughCellIds, partitions, this);
+  if (partitions.size() > 1)
+  {
+    vtkSMPTools::For(0, static_cast<vtkIdType>(partitions.size()), 1, stripPartitions);
+  }
+  else
+  {
+    partitions.resize(1);
+    stripPartitions.StripPartition(0, numCells, partitions[0], true);
+  }
+  for (StripperPartition& partition : partitions)
   {
-    if (ghostCells && ghostCells->GetValue(cellId))
+    if (newStrips)
     {
-      continue;
+      newStrips->Append(partition.Strips);
+      newPolys->Append(partition.Polys);
     }
-    if (!(cellId % progressInterval))
+    if (newLines)
     {
-      this->UpdateProgress((float)cellId / numCells);
-      abort = this->CheckAbort();
+      newLines->Append(partition.Lines);
     }
-    if (!visited[cellId])
+    numStrips += partition.NumberOfStrips;
+    numLines += partition.NumberOfLines;
+    longestStrip = std::max(longestStrip, static_cast<int>(partition.LongestStrip));
+    longestLine = std::max(longestLine, static_cast<int>(partition.LongestLine));
+    if (this->PassCellDataAsFieldData)
     {
-      visited[cellId] = 1;
-      if ((cellType = mesh->GetCellType(cellId)) == VTK_TRIANGLE)
+      for (vtkIdType id : partition.StripCellIds)
       {
-        //  Got a starting point for the strip.  Initialize.  Find a neighbor
-        //  to extend strip.
-        //
-        numStrips++;
-        numPts = 3;
-
-        mesh->GetCellPoints(cellId, numTriPts, triPts);
-
-        for (i = 0; i < 3; i++)
-        {
-          pts[1] = triPts[i];
-          pts[2] = triPts[(i + 1) % 3];
-
-          mesh->GetCellEdgeNeighbors(cellId, pts[1], pts[2], cellIds);
-          if (cellIds->GetNumberOfIds() > 0 && !visited[neighbor = cellIds->GetId(0)] &&
-            mesh->GetCellType(neighbor) == VTK_TRIANGLE)
-          {
-            pts[0] = triPts[(i + 2) % 3];
-            break;
-          }
-        }
-        //  If no unvisited neighbor, just create the strip of one triangle.
-        //
-        if (i >= 3)
-        {
-          pts[0] = triPts[0];
-          pts[1] = triPts[1];
-          pts[2] = triPts[2];
-          newStrips->InsertNextCell(3, pts);
-          if (this->PassCellDataAsFieldData)
-          {
-            newfdStrips->InsertNextTuple(cellId, cd);
-          }
-          if (this->PassThroughCellIds)
-          {
-            origStripIds->InsertNextValue(cellId);
-          }
-        }
-        else // continue strip
-        {
-          //  Have a neighbor.  March along grabbing new points
-          //
-          if (this->PassCellDataAsFieldData)
-          {
-            newfdStrips->InsertNextTuple(cellId, cd);
-          }
-          if (this->PassThroughCellIds)
-          {
-            origStripIds->InsertNextValue(cellId);
-          }
-          while (neighbor >= 0)
-          {
-            visited[neighbor] = 1;
-            mesh->GetCellPoints(neighbor, numTriPts, triPts);
-            if (this->PassCellDataAsFieldData)
-            {
-              newfdStrips->InsertNextTuple(neighbor, cd);
-            }
-            if (this->PassThroughCellIds)
-            {
-              origStripIds->InsertNextValue(neighbor);
-            }
-            for (i = 0; i < 3; i++)
-            {
-              if (triPts[i] != pts[numPts - 2] && triPts[i] != pts[numPts - 1])
-              {
-                break;
-              }
-            }
-
-            // only add the triangle to the strip if it isn't degenerate.
-            if (i < 3)
-            {
-              pts[numPts] = triPts[i];
-              mesh->GetCellEdgeNeighbors(neighbor, pts[numPts], pts[numPts - 1], cellIds);
-              numPts++;
-            }
-
-            longestStrip = std::max(numPts, longestStrip);
-
-            // note: if updates value of neighbor
-            // Note2: for a degenerate triangle this test will
-            // correctly fail because the visited[neighbor] will
-            // now be visited
-            if (cellIds->GetNumberOfIds() <= 0 || visited[neighbor = cellIds->GetId(0)] ||
-              mesh->GetCellType(neighbor) != VTK_TRIANGLE || numPts >= (this->MaximumLength + 2))
-            {
-              newStrips->InsertNextCell(numPts, pts);
-              neighbor = (-1);
-            }
-          } // while
-        }   // else continue strip
-      }     // if triangle
-
-      else if (cellType == VTK_LINE)
+        newfdStrips->InsertNextTuple(id, cd);
+      }
+      for (vtkIdType id : partition.LineCellIds)
       {
-        //
-        //  Got a starting point for the line.  Initialize.  Find a neighbor
-        //  to extend poly-line.
-        //
-        numLines++;
-        numPts = 2;
-
-        mesh->GetCellPoints(cellId, numLinePts, linePts);
-
-        for (foundOne = i = 0; !foundOne && i < 2; i++)
-        {
-          pts[0] = linePts[i];
-          pts[1] = linePts[(i + 1) % 2];
-          mesh->GetPointCells(pts[1], cellIds);
-          for (j = 0; j < cellIds->GetNumberOfIds(); j++)
-          {
-            neighbor = cellIds->GetId(j);
-            if (neighbor != cellId && !visited[neighbor] && mesh->GetCellType(neighbor) == VTK_LINE)
-            {
-              foundOne = 1;
-              break;
-            }
-          }
-        }
-
-        // for each polyline that we construct, we set the cell data to be that
-        // for the first cell that formed the polyline. We may build the field data
-        // for the mini-cells in the polyline, similar to triangle strips,
-        // but that is not required currently.
-        if (this->PassCellDataAsFieldData)
-        {
-          newfdLines->InsertNextTuple(cellId, cd);
-        }
-        if (this->PassThroughCellIds)
-        {
-          origLineIds->InsertNextValue(cellId);
-        }
-        //  If no unvisited neighbor, just create the poly-line from one line.
-        //
-        if (!foundOne)
-        {
-          newLines->InsertNextCell(2, linePts);
-        }
-        else // continue poly-line
-        {
-          //  Have a neighbor.  March along grabbing new points
-          //
-          while (neighbor >= 0)
-          {
-            visited[neighbor] = 1;
-            mesh->GetCellPoints(neighbor, numLinePts, linePts);
-            for (i = 0; i < 2; i++)
-            {
-              if (linePts[i] != pts[numPts - 1])
-              {
-                break;
-              }
-            }
-            pts[numPts] = linePts[i];
-            mesh->GetPointCells(pts[numPts], cellIds);
-            if (++numPts > longestLine)
-            {
-              longestLine = numPts;
-            }
-
-            // get new neighbor
-            for (j = 0; j < cellIds->GetNumberOfIds(); j++)
-            {
-              nei = cellIds->GetId(j);
-              if (nei != neighbor && !visited[nei] && mesh->GetCellType(nei) == VTK_LINE)
-              {
-                neighbor = nei;
-                break;
-              }
-            }
-
-            if (j >= cellIds->GetNumberOfIds() || numPts >= (this->MaximumLength + 1))
-            {
-              newLines->InsertNextCell(numPts, pts);
-              neighbor = (-1);
-            }
-          } // while
-        }   // else continue line
-      }     // if line
-
-      // not line, triangle, or strip must be quad or tpolygon which we pass through
-      else if (cellType == VTK_POLYGON || cellType == VTK_QUAD)
+        newfdLines->InsertNextTuple(id, cd);
+      }
+      for (vtkIdType id : partition.PolyCellIds)
       {
-        mesh->GetCellPoints(cellId, numTriPts, triPts);
-        newPolys->InsertNextCell(numTriPts, triPts);
-        if (this->PassCellDataAsFieldData)
-        {
-          newfdPolys->InsertNextTuple(cellId, cd);
-        }
-        if (this->PassThroughCellIds)
-        {
-          origPolyIds->InsertNextValue(cellId);
-        }
+        newfdPolys->InsertNextTuple(id, cd);
       }
-
-    } // if not visited
-  }   // for all elements
+    }
+    if (this->PassThroughCellIds)
+    {
+      for (vtkIdType id : partition.StripCellIds)
+      {
+        origStripIds->InsertNextValue(id);
+      }
+      for (vtkIdType id : partition.LineCellIds)
+      {
+        origLineIds->InsertNextValue(id);
+      }
+      for (vtkIdType id : partition.PolyCellIds)
+      {
+        origPolyIds->InsertNextValue(id);
+      }
+    }
+  }
 
   // Update output and release memory
   //
-  delete[] pts;
   delete[] visited;
   mesh->Delete();
 
@@ -637,7 +748,6 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
 
   // pass through verts
   output->SetVerts(input->GetVerts());
-  cellIds->Delete();
 
   if (this->PassCellDataAsFieldData)
   {
@@ -731,5 +841,7 @@ void vtkStripper::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "PassThroughCellIds: " << this->PassThroughCellIds << endl;
   os << indent << "PassThroughPointIds: " << this->PassThroughPointIds << endl;
   os << indent << "JoinContiguousSegments: " << this->JoinContiguousSegments << endl;
+  os << indent << "UseThreading: " << this->UseThreading << endl;
+  os << indent << "PartitionSize: " << this->PartitionSize << endl;
 }
 VTK_ABI_NAMESPACE_END
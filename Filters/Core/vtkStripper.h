@@ -35,6 +35,10 @@
  * If there is a ghost cell array in the input, the ghost array is discarded.
  * Any cell tagged as ghost is skipped when stripping. Ghost points are kept.
  *
+ * When UseThreading is on, the cells are split into partitions of
+ * PartitionSize consecutive cells which are stripped concurrently, and the
+ * strips and poly-lines of the partitions are then merged in order.
+ *
  * @warning
  * If triangle strips or poly-lines exist in the input data they will
  * be passed through to the output data. This filter will only construct
@@ -118,6 +122,31 @@ public:
   vtkBooleanMacro(JoinContiguousSegments, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * If on, the cells are split into partitions of PartitionSize consecutive
+   * cells, and the triangle strips and poly-lines of each partition are built
+   * concurrently, only from the cells of the partition. The partitions are
+   * then merged in order, so that the output cells and field data are ordered
+   * as if the partitions had been stripped one after the other. Strips and
+   * poly-lines stop at partition boundaries, so the output has a few more
+   * cells than the sequential stripping. It does not depend on the number of
+   * threads. The default is off.
+   */
+  vtkSetMacro(UseThreading, bool);
+  vtkGetMacro(UseThreading, bool);
+  vtkBooleanMacro(UseThreading, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Specify the number of consecutive cells in a partition when UseThreading
+   * is on. The default is 65536.
+   */
+  vtkSetClampMacro(PartitionSize, vtkIdType, 1, VTK_ID_MAX);
+  vtkGetMacro(PartitionSize, vtkIdType);
+  ///@}
+
 protected:
   vtkStripper();
   ~vtkStripper() override = default;
@@ -130,6 +159,8 @@ protected:
   vtkTypeBool PassThroughCellIds;
   vtkTypeBool PassThroughPointIds;
   vtkTypeBool JoinContiguousSegments;
+  bool UseThreading = false;
+  vtkIdType PartitionSize = 65536;
 
 private:
   vtkStripper(const vtkStripper&) = delete;
@@ -2,20 +2,211 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkTriangleFilter.h"
 
+#include "vtkArrayListTemplate.h" // For processing attribute data
 #include "vtkCellArray.h"
 #include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangleStrip.h"
 
+#include <algorithm>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkTriangleFilter);
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Threaded decomposition of the cells of a cell array into cells of a fixed
+// size. Input cells are processed by blocks: each block gathers the output
+// cells it generates, and the input cell each of them comes from. A prefix
+// sum over the number of cells of each block then tells where the blocks go
+// in the output, so that the output is ordered as with the sequential loops.
+constexpr vtkIdType DecompositionBlockSize = 1024;
+
+struct DecomposedBlock
+{
+  std::vector<vtkIdType> Connectivity;
+  std::vector<vtkIdType> InputCellIds;
+};
+
+// decompose(npts, pts, connectivity) appends the points of the cells
+// generated by an input cell to connectivity. It is called concurrently.
+template <typename DecomposeFunctor>
+vtkSmartPointer<vtkCellArray> ThreadedDecompose(vtkCellArray* inCells, vtkIdType cellSize,
+  vtkIdType firstInCellId, vtkCellData* inCD, vtkCellData* outCD, vtkIdType firstOutCellId,
+  DecomposeFunctor& decompose)
+{
+  const vtkIdType numCells = inCells->GetNumberOfCells();
+  const vtkIdType numBlocks = (numCells + DecompositionBlockSize - 1) / DecompositionBlockSize;
+  std::vector<DecomposedBlock> blocks(numBlocks);
+  vtkSMPThreadLocalObject<vtkIdList> tlCellPts;
+  vtkSMPTools::For(0, numBlocks,
+    [&](vtkIdType beginBlock, vtkIdType endBlock)
+    {
+      vtkIdList* cellPts = tlCellPts.Local();
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (vtkIdType blockId = beginBlock; blockId < endBlock; ++blockId)
+      {
+        DecomposedBlock& block = blocks[blockId];
+        const vtkIdType endCellId = std::min((blockId + 1) * DecompositionBlockSize, numCells);
+        for (vtkIdType cellId = blockId * DecompositionBlockSize; cellId < endCellId; ++cellId)
+        {
+          inCells->GetCellAtId(cellId, npts, pts, cellPts);
+          decompose(npts, pts, block.Connectivity);
+          block.InputCellIds.resize(block.Connectivity.size() / cellSize, firstInCellId + cellId);
+        }
+      }
+    });
+
+  // Offsets of the blocks in the output.
+  std::vector<vtkIdType> blockOffsets(numBlocks + 1);
+  for (vtkIdType blockId = 0; blockId < numBlocks; ++blockId)
+  {
+    blockOffsets[blockId] = static_cast<vtkIdType>(blocks[blockId].InputCellIds.size());
+  }
+  blockOffsets[numBlocks] = vtkSMPTools::ExclusiveScan(
+    blockOffsets.begin(), blockOffsets.begin() + numBlocks, blockOffsets.begin(), vtkIdType(0));
+  const vtkIdType numNewCells = blockOffsets[numBlocks];
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numNewCells + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(numNewCells * cellSize);
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  vtkIdType* connectivityPtr = connectivity->GetPointer(0);
+  offsetsPtr[numNewCells] = numNewCells * cellSize;
+
+  // ArrayList::AddArrays() sets the number of tuples of the output arrays,
+  // which discards their values if they have to be reallocated. Grow them
+  // first so that the data of the cells generated before is kept.
+  const vtkIdType numOutCells = firstOutCellId + numNewCells;
+  for (int i = 0; i < outCD->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray* array = outCD->GetAbstractArray(i);
+    if (array->GetSize() < numOutCells * array->GetNumberOfComponents())
+    {
+      array->Resize(numOutCells);
+    }
+  }
+  ArrayList arrays;
+  arrays.AddArrays(numOutCells, inCD, outCD, 0.0, /*promote=*/false);
+  vtkSMPTools::For(0, numBlocks,
+    [&](vtkIdType beginBlock, vtkIdType endBlock)
+    {
+      for (vtkIdType blockId = beginBlock; blockId < endBlock; ++blockId)
+      {
+        DecomposedBlock& block = blocks[blockId];
+        const vtkIdType firstCellId = blockOffsets[blockId];
+        std::copy(block.Connectivity.begin(), block.Connectivity.end(),
+          connectivityPtr + firstCellId * cellSize);
+        const vtkIdType numBlockCells = static_cast<vtkIdType>(block.InputCellIds.size());
+        for (vtkIdType i = 0; i < numBlockCells; ++i)
+        {
+          offsetsPtr[firstCellId + i] = (firstCellId + i) * cellSize;
+          arrays.Copy(block.InputCellIds[i], firstOutCellId + firstCellId + i);
+        }
+        block = DecomposedBlock();
+      }
+    });
+
+  auto newCells = vtkSmartPointer<vtkCellArray>::New();
+  newCells->SetData(offsets, connectivity);
+  return newCells;
+}
+
+//------------------------------------------------------------------------------
+// The decompositions below generate the same cells as the sequential loops of
+// vtkTriangleFilter::RequestData, except for empty cells which are skipped.
+void DecomposeVerts(vtkIdType npts, const vtkIdType* pts, std::vector<vtkIdType>& connectivity)
+{
+  connectivity.insert(connectivity.end(), pts, pts + npts);
+}
+
+void DecomposeLines(vtkIdType npts, const vtkIdType* pts, std::vector<vtkIdType>& connectivity)
+{
+  for (vtkIdType i = 0; i < (npts - 1); i++)
+  {
+    connectivity.push_back(pts[i]);
+    connectivity.push_back(pts[i + 1]);
+  }
+}
+
+void DecomposeStrip(vtkIdType npts, const vtkIdType* pts, std::vector<vtkIdType>& connectivity)
+{
+  // Same ordering as vtkTriangleStrip::DecomposeStrip().
+  for (vtkIdType i = 0; i < (npts - 2); i++)
+  {
+    if (i % 2)
+    {
+      connectivity.push_back(pts[i + 1]);
+      connectivity.push_back(pts[i]);
+    }
+    else
+    {
+      connectivity.push_back(pts[i]);
+      connectivity.push_back(pts[i + 1]);
+    }
+    connectivity.push_back(pts[i + 2]);
+  }
+}
+
+struct DecomposePolygon
+{
+  vtkPoints* Points;
+  double Tolerance;
+  vtkSMPThreadLocalObject<vtkPolygon> Polygon;
+  vtkSMPThreadLocalObject<vtkIdList> PtIds;
+
+  DecomposePolygon(vtkPoints* points, double tolerance)
+    : Points(points)
+    , Tolerance(tolerance)
+  {
+  }
+
+  void operator()(vtkIdType npts, const vtkIdType* pts, std::vector<vtkIdType>& connectivity)
+  {
+    if (npts == 3)
+    {
+      connectivity.insert(connectivity.end(), pts, pts + 3);
+      return;
+    }
+
+    vtkPolygon* poly = this->Polygon.Local();
+    if (this->Tolerance > 0.0)
+    {
+      poly->SetTolerance(this->Tolerance); // Tighten tessellation tolerance
+    }
+    poly->PointIds->SetNumberOfIds(npts);
+    poly->Points->SetNumberOfPoints(npts);
+    double x[3];
+    for (vtkIdType i = 0; i < npts; i++)
+    {
+      poly->PointIds->SetId(i, pts[i]);
+      this->Points->GetPoint(pts[i], x);
+      poly->Points->SetPoint(i, x);
+    }
+    vtkIdList* ptIds = this->PtIds.Local();
+    poly->TriangulateLocalIds(0, ptIds);
+    const vtkIdType numSimplices = ptIds->GetNumberOfIds() / 3;
+    for (vtkIdType i = 0; i < 3 * numSimplices; i++)
+    {
+      connectivity.push_back(poly->PointIds->GetId(ptIds->GetId(i)));
+    }
+  }
+};
+} // anonymous namespace
+
 //-------------------------------------------------------------------------
 int vtkTriangleFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -70,6 +261,14 @@ int vtkTriangleFilter::RequestData(vtkInformation* vtkNotUsed(request),
         }
         inCellId += numInVerts;
       }
+      else if (this->UseThreading)
+      {
+        output->SetVerts(ThreadedDecompose(
+          inVerts, 1, inCellId, inCD, outCD, output->GetNumberOfCells(), DecomposeVerts));
+        inCellId += numInVerts;
+        this->UpdateProgress((float)inCellId / numInCells);
+        abort = this->CheckAbort();
+      }
       else
       {
         outCellId = output->GetNumberOfCells();
@@ -131,6 +330,14 @@ int vtkTriangleFilter::RequestData(vtkInformation* vtkNotUsed(request),
         }
         inCellId += numInLines;
       }
+      else if (this->UseThreading)
+      {
+        output->SetLines(ThreadedDecompose(
+          inLines, 2, inCellId, inCD, outCD, output->GetNumberOfCells(), DecomposeLines));
+        inCellId += numInLines;
+        this->UpdateProgress((float)inCellId / numInCells);
+        abort = this->CheckAbort();
+      }
       else
       {
         outCellId = output->GetNumberOfCells();
@@ -210,6 +417,16 @@ int vtkTriangleFilter::RequestData(vtkInformation* vtkNotUsed(request),
       }
       inCellId += numInPolys;
     }
+    else if (this->UseThreading)
+    {
+      DecomposePolygon decompose(inPts, this->Tolerance);
+      newPolys = ThreadedDecompose(
+        inPolys, 3, inCellId, inCD, outCD, output->GetNumberOfCells(), decompose);
+      output->SetPolys(newPolys);
+      inCellId += numInPolys;
+      this->UpdateProgress((float)inCellId / numInCells);
+      abort = this->CheckAbort();
+    }
     else
     {
       outCellId = output->GetNumberOfCells();
@@ -284,7 +501,21 @@ int vtkTriangleFilter::RequestData(vtkInformation* vtkNotUsed(request),
   }
 
   // strips
-  if (!abort && numInStrips > 0)
+  if (!abort && numInStrips > 0 && this->UseThreading)
+  {
+    vtkSmartPointer<vtkCellArray> stripPolys = ThreadedDecompose(
+      inStrips, 3, inCellId, inCD, outCD, output->GetNumberOfCells(), DecomposeStrip);
+    if (newPolys == nullptr)
+    {
+      newPolys = stripPolys;
+    }
+    else
+    {
+      newPolys->Append(stripPolys);
+    }
+    output->SetPolys(newPolys);
+  }
+  else if (!abort && numInStrips > 0)
   {
     outCellId = output->GetNumberOfCells();
     if (newPolys == nullptr)
@@ -330,5 +561,6 @@ void vtkTriangleFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Pass Verts: " << (this->PassVerts ? "On\n" : "Off\n");
   os << indent << "Pass Lines: " << (this->PassLines ? "On\n" : "Off\n");
+  os << indent << "Use Threading: " << (this->UseThreading ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
@@ -8,6 +8,9 @@
  * strips.  It also generates line segments from polylines unless PassLines
  * is off, and generates individual vertex cells from vtkVertex point lists
  * unless PassVerts is off.
+ *
+ * When UseThreading is on, the cells are decomposed in parallel with
+ * vtkSMPTools; the output is the same as with the sequential implementation.
  */
 
 #ifndef vtkTriangleFilter_h
@@ -75,12 +78,26 @@ public:
   vtkGetMacro(Tolerance, double);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off the threaded decomposition of poly-vertices, polylines,
+   * polygons and triangle strips (default: off). Blocks of input cells are
+   * decomposed concurrently, then a prefix sum over the number of cells
+   * generated by each block gives where they go in the output. The output
+   * cells and cell data are ordered as with the sequential implementation.
+   */
+  vtkSetMacro(UseThreading, bool);
+  vtkGetMacro(UseThreading, bool);
+  vtkBooleanMacro(UseThreading, bool);
+  ///@}
+
 protected:
   vtkTriangleFilter()
     : PassVerts(1)
     , PassLines(1)
     , PreservePolys(0)
     , Tolerance(-1.0) // use default vtkPolygon::Tolerance
+    , UseThreading(false)
   {
   }
   ~vtkTriangleFilter() override = default;
@@ -92,6 +109,7 @@ protected:
   vtkTypeBool PassLines;
   vtkTypeBool PreservePolys;
   double Tolerance;
+  bool UseThreading;
 
 private:
   vtkTriangleFilter(const vtkTriangleFilter&) = delete;
@@ -0,0 +1,209 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Builds a tree with the deprecated vtkOBBTree::BuildTree
+#define VTK_DEPRECATION_LEVEL 0
+
+#include "vtkOBBTree.h"
+
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSphereSource.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+// A tree built recursively by vtkOBBTree::BuildTree, as subclasses may still do,
+// giving access to its nodes.
+class vtkRecursiveOBBTree : public vtkOBBTree
+{
+public:
+  static vtkRecursiveOBBTree* New();
+  vtkTypeMacro(vtkRecursiveOBBTree, vtkOBBTree);
+
+  vtkOBBNode* GetRoot() { return this->Tree; }
+
+  bool Recursive = false;
+
+protected:
+  void BuildLocatorInternal() override
+  {
+    if (!this->Recursive)
+    {
+      this->Superclass::BuildLocatorInternal();
+      return;
+    }
+    this->FreeSearchStructure();
+    vtkIdList* cells = vtkIdList::New();
+    cells->SetNumberOfIds(this->DataSet->GetNumberOfCells());
+    for (vtkIdType cellId = 0; cellId < cells->GetNumberOfIds(); ++cellId)
+    {
+      cells->SetId(cellId, cellId);
+    }
+    this->Tree = new vtkOBBNode;
+    this->Level = 0;
+    this->BuildTree(cells, this->Tree, 0);
+    this->BuildTime.Modified();
+  }
+};
+vtkStandardNewMacro(vtkRecursiveOBBTree);
+
+// Check that the cell lists of the leaves hold every cell once.
+int CheckCellLists(vtkRecursiveOBBTree* tree, vtkIdType numberOfCells)
+{
+  std::vector<int> counts(numberOfCells, 0);
+  std::vector<vtkOBBNode*> nodes{ tree->GetRoot() };
+  while (!nodes.empty())
+  {
+    vtkOBBNode* node = nodes.back();
+    nodes.pop_back();
+    if (node->Kids)
+    {
+      nodes.push_back(node->Kids[0]);
+      nodes.push_back(node->Kids[1]);
+    }
+    else if (node->Cells)
+    {
+      for (vtkIdType i = 0; i < node->Cells->GetNumberOfIds(); ++i)
+      {
+        ++counts[node->Cells->GetId(i)];
+      }
+    }
+  }
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    if (counts[cellId] != 1)
+    {
+      std::cerr << "Cell " << cellId << " is in " << counts[cellId] << " cell lists" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+// Compare the batched intersections of the rays with the ones of
+// IntersectWithLine, computed with the given number of threads.
+int CheckIntersectWithLines(
+  vtkOBBTree* tree, vtkPoints* startPoints, vtkPoints* endPoints, int numberOfThreads)
+{
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkDoubleArray> ts;
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ numberOfThreads },
+    [&]() { tree->IntersectWithLines(startPoints, endPoints, 0.0, cellIds, ts, points); });
+
+  const vtkIdType numberOfRays = startPoints->GetNumberOfPoints();
+  if (cellIds->GetNumberOfIds() != numberOfRays || ts->GetNumberOfTuples() != numberOfRays ||
+    points->GetNumberOfPoints() != numberOfRays)
+  {
+    std::cerr << "Wrong number of results with " << numberOfThreads << " threads" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  int retVal = EXIT_SUCCESS;
+  vtkNew<vtkGenericCell> cell;
+  vtkIdType numberOfHits = 0;
+  for (vtkIdType i = 0; i < numberOfRays; ++i)
+  {
+    double p0[3], p1[3], t, x[3], pcoords[3];
+    int subId;
+    vtkIdType cellId = -1;
+    startPoints->GetPoint(i, p0);
+    endPoints->GetPoint(i, p1);
+    if (tree->IntersectWithLine(p0, p1, 0.0, t, x, pcoords, subId, cellId, cell))
+    {
+      ++numberOfHits;
+    }
+    else
+    {
+      cellId = -1;
+      t = VTK_DOUBLE_MAX;
+      x[0] = p1[0];
+      x[1] = p1[1];
+      x[2] = p1[2];
+    }
+
+    double point[3];
+    points->GetPoint(i, point);
+    if (cellIds->GetId(i) != cellId || ts->GetValue(i) != t ||
+      vtkMath::Distance2BetweenPoints(point, x) != 0.0)
+    {
+      std::cerr << "Ray " << i << " intersects cell " << cellIds->GetId(i) << " at t "
+                << ts->GetValue(i) << " instead of cell " << cellId << " at t " << t << " with "
+                << numberOfThreads << " threads" << std::endl;
+      retVal = EXIT_FAILURE;
+    }
+  }
+
+  // Half of the rays are aimed at the sphere, the others miss it.
+  if (numberOfHits != numberOfRays / 2)
+  {
+    std::cerr << numberOfHits << " rays intersect the sphere instead of " << numberOfRays / 2
+              << std::endl;
+    retVal = EXIT_FAILURE;
+  }
+  return retVal;
+}
+}
+
+int TestOBBTreeIntersectWithLines(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(120);
+  sphere->SetPhiResolution(60);
+  sphere->Update();
+
+  vtkNew<vtkOBBTree> tree;
+  tree->SetDataSet(sphere->GetOutput());
+
+  // Rays from outside the sphere, alternately towards its center and away from it.
+  vtkNew<vtkPoints> startPoints;
+  vtkNew<vtkPoints> endPoints;
+  const int numberOfRays = 1000;
+  for (int i = 0; i < numberOfRays; ++i)
+  {
+    const double theta = 2.0 * vtkMath::Pi() * i / numberOfRays;
+    const double phi = vtkMath::Pi() * (i % 37 + 0.5) / 37;
+    const double direction[3] = { std::cos(theta) * std::sin(phi),
+      std::sin(theta) * std::sin(phi), std::cos(phi) };
+    const double start[3] = { 2.0 * direction[0], 2.0 * direction[1], 2.0 * direction[2] };
+    const double sign = i % 2 ? 1.0 : -1.0;
+    startPoints->InsertNextPoint(start);
+    endPoints->InsertNextPoint(start[0] + sign * 2.0 * direction[0],
+      start[1] + sign * 2.0 * direction[1], start[2] + sign * 2.0 * direction[2]);
+  }
+
+  // The locator is built by the first call.
+  int retVal = CheckIntersectWithLines(tree, startPoints, endPoints, 1);
+  if (tree->GetLevel() < 1)
+  {
+    std::cerr << "The locator was not built" << std::endl;
+    retVal = EXIT_FAILURE;
+  }
+  retVal |= CheckIntersectWithLines(tree, startPoints, endPoints, 4);
+
+  // The cell lists of the leaves are retained by default.
+  vtkNew<vtkRecursiveOBBTree> recursiveTree;
+  recursiveTree->SetDataSet(sphere->GetOutput());
+  recursiveTree->BuildLocator();
+  retVal |= CheckCellLists(recursiveTree, sphere->GetOutput()->GetNumberOfCells());
+
+  // Trees built by BuildTree are intersected through their nodes.
+  recursiveTree->Recursive = true;
+  recursiveTree->ForceBuildLocator();
+  retVal |= CheckCellLists(recursiveTree, sphere->GetOutput()->GetNumberOfCells());
+  retVal |= CheckIntersectWithLines(recursiveTree, startPoints, endPoints, 1);
+  retVal |= CheckIntersectWithLines(recursiveTree, startPoints, endPoints, 4);
+  return retVal;
+}
@@ -1,19 +1,34 @@
 // SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
 // SPDX-License-Identifier: BSD-3-Clause
+
+// VTK_DEPRECATED_IN_9_7_0
+#define VTK_DEPRECATION_LEVEL 0
+
 #include "vtkOBBTree.h"
 
 #include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
 #include "vtkLine.h"
 #include "vtkMath.h"
 #include "vtkMatrix4x4.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkPoints.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <iostream>
+#include <numeric>
+#include <utility>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -61,6 +76,694 @@ vtkOBBNode::~vtkOBBNode()
   }
 }
 
+//------------------------------------------------------------------------------
+// A copy of the OBB tree in contiguous arrays, with the projections of the
+// boxes on their axes computed once, used to intersect lines. When the cell
+// lists are retained, Cells holds them and the cell lists of the leaves of the
+// vtkOBBNode tree are views of it.
+struct vtkOBBFlatTree
+{
+  struct Node
+  {
+    double Axes[3][3];
+    double RangeMin[3];   // projection of the corner on each axis
+    double RangeMax[3];   // projection of the opposite corner on each axis
+    double SqrtExtent[3]; // square root of RangeMax - RangeMin, scales the tolerance
+    vtkIdType Kids;       // index of the first kid, followed by the second one, or -1
+    vtkIdType CellsBegin; // range of the cells of a leaf in Cells
+    vtkIdType CellsEnd;
+  };
+
+  std::vector<Node> Nodes;
+  std::vector<vtkIdType> Cells;
+
+  void SetBox(vtkIdType index, const vtkOBBNode* node)
+  {
+    Node& flatNode = this->Nodes[index];
+    for (int ii = 0; ii < 3; ii++)
+    {
+      for (int jj = 0; jj < 3; jj++)
+      {
+        flatNode.Axes[ii][jj] = node->Axes[ii][jj];
+      }
+      flatNode.RangeMin[ii] = vtkMath::Dot(node->Corner, node->Axes[ii]);
+      flatNode.RangeMax[ii] = flatNode.RangeMin[ii] + vtkMath::Dot(node->Axes[ii], node->Axes[ii]);
+      flatNode.SqrtExtent[ii] = sqrt(fabs(flatNode.RangeMax[ii] - flatNode.RangeMin[ii]));
+    }
+  }
+
+  // Same test as vtkOBBTree::LineIntersectsNode
+  static bool LineIntersectsNode(
+    const Node& node, const double b0[3], const double b1[3], double tolerance)
+  {
+    for (int ii = 0; ii < 3; ii++)
+    {
+      double rangeBmin = vtkMath::Dot(b0, node.Axes[ii]);
+      double rangeBmax = rangeBmin;
+      const double dotB = vtkMath::Dot(b1, node.Axes[ii]);
+      if (dotB < rangeBmin)
+      {
+        rangeBmin = dotB;
+      }
+      else
+      {
+        rangeBmax = dotB;
+      }
+
+      double eps = tolerance;
+      if (eps != 0)
+      {
+        eps *= node.SqrtExtent[ii];
+      }
+
+      if ((node.RangeMax[ii] + eps < rangeBmin) || (rangeBmax + eps < node.RangeMin[ii]))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Return the first intersection of a line with the cells, visiting the nodes
+  // in the same order as the tree. stack must hold the depth of the tree + 1
+  // nodes. This method is thread-safe.
+  int IntersectWithLine(vtkDataSet* dataSet, double tolerance, const double a0[3],
+    const double a1[3], double tol, double& t, double x[3], double pcoords[3], int& subId,
+    vtkIdType& cellId, vtkGenericCell* cell, vtkIdType* stack) const
+  {
+    double tBest = VTK_DOUBLE_MAX, xBest[3] = { 0., 0., 0. }, pcoordsBest[3] = { 0., 0., 0. };
+    int subIdBest = -1;
+    vtkIdType cellIdBest = -1;
+
+    stack[0] = 0;
+    int depth = 1;
+    while (depth > 0)
+    {
+      depth--;
+      const Node& node = this->Nodes[stack[depth]];
+      if (!vtkOBBFlatTree::LineIntersectsNode(node, a0, a1, tolerance))
+      {
+        continue;
+      }
+      if (node.Kids >= 0)
+      {
+        stack[depth] = node.Kids;
+        stack[depth + 1] = node.Kids + 1;
+        depth += 2;
+        continue;
+      }
+      for (vtkIdType ii = node.CellsBegin; ii < node.CellsEnd; ii++)
+      {
+        const vtkIdType thisId = this->Cells[ii];
+        dataSet->GetCell(thisId, cell);
+        if (cell->IntersectWithLine(a0, a1, tol, t, x, pcoords, subId) && t < tBest)
+        {
+          tBest = t;
+          xBest[0] = x[0];
+          xBest[1] = x[1];
+          xBest[2] = x[2];
+          pcoordsBest[0] = pcoords[0];
+          pcoordsBest[1] = pcoords[1];
+          pcoordsBest[2] = pcoords[2];
+          subIdBest = subId;
+          cellIdBest = thisId;
+        }
+      }
+    }
+
+    if (cellIdBest >= 0)
+    {
+      dataSet->GetCell(cellIdBest, cell);
+      t = tBest;
+      x[0] = xBest[0];
+      x[1] = xBest[1];
+      x[2] = xBest[2];
+      pcoords[0] = pcoordsBest[0];
+      pcoords[1] = pcoordsBest[1];
+      pcoords[2] = pcoordsBest[2];
+      subId = subIdBest;
+      cellId = cellIdBest;
+      return 1;
+    }
+    return 0;
+  }
+};
+
+//------------------------------------------------------------------------------
+namespace
+{
+// Nodes with at least this many cells, and holding more than the share of the
+// cells of one thread, are built with their cells processed concurrently.
+constexpr vtkIdType OBB_PARALLEL_NODE_SIZE = 65536;
+
+// The moments of the cells of a node are summed over blocks of this many cells
+// before adding the blocks in order, so that the boxes do not depend on the
+// number of threads.
+constexpr vtkIdType OBB_MOMENTS_BLOCK_SIZE = 8192;
+
+struct vtkOBBMoments
+{
+  double Mass = 0.0;
+  double Mean[3] = { 0.0, 0.0, 0.0 };
+  double A[3][3] = { { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } };
+};
+
+//------------------------------------------------------------------------------
+// Add the moments of inertia of the triangles of the cells to moments.
+void AccumulateMoments(vtkDataSet* dataSet, const vtkIdType* begin, const vtkIdType* end,
+  vtkIdList* cellPts, vtkOBBMoments& moments)
+{
+  vtkIdType numPts, pId, qId, rId;
+  const vtkIdType* ptIds;
+  double p[3], q[3], r[3], xp[3], dp0[3], dp1[3], c[3], tri_mass;
+  double* mean = moments.Mean;
+  double* a0 = moments.A[0];
+  double* a1 = moments.A[1];
+  double* a2 = moments.A[2];
+
+  for (const vtkIdType* cellIdIt = begin; cellIdIt != end; ++cellIdIt)
+  {
+    const vtkIdType cellId = *cellIdIt;
+    const int type = dataSet->GetCellType(cellId);
+    dataSet->GetCellPoints(cellId, numPts, ptIds, cellPts);
+    for (vtkIdType j = 0; j < numPts - 2; j++)
+    {
+      vtkCELLTRIANGLES(ptIds, type, j, pId, qId, rId);
+      if (pId < 0)
+      {
+        continue;
+      }
+      dataSet->GetPoint(pId, p);
+      dataSet->GetPoint(qId, q);
+      dataSet->GetPoint(rId, r);
+      // p, q, and r are the oriented triangle points.
+      // Compute the components of the moment of inertia tensor.
+      for (int k = 0; k < 3; k++)
+      {
+        // two edge vectors
+        dp0[k] = q[k] - p[k];
+        dp1[k] = r[k] - p[k];
+        // centroid
+        c[k] = (p[k] + q[k] + r[k]) / 3;
+      }
+      vtkMath::Cross(dp0, dp1, xp);
+      tri_mass = 0.5 * vtkMath::Norm(xp);
+      moments.Mass += tri_mass;
+      for (int k = 0; k < 3; k++)
+      {
+        mean[k] += tri_mass * c[k];
+      }
+
+      // on-diagonal terms
+      a0[0] += tri_mass * (9 * c[0] * c[0] + p[0] * p[0] + q[0] * q[0] + r[0] * r[0]) / 12;
+      a1[1] += tri_mass * (9 * c[1] * c[1] + p[1] * p[1] + q[1] * q[1] + r[1] * r[1]) / 12;
+      a2[2] += tri_mass * (9 * c[2] * c[2] + p[2] * p[2] + q[2] * q[2] + r[2] * r[2]) / 12;
+
+      // off-diagonal terms
+      a0[1] += tri_mass * (9 * c[0] * c[1] + p[0] * p[1] + q[0] * q[1] + r[0] * r[1]) / 12;
+      a0[2] += tri_mass * (9 * c[0] * c[2] + p[0] * p[2] + q[0] * q[2] + r[0] * r[2]) / 12;
+      a1[2] += tri_mass * (9 * c[1] * c[2] + p[1] * p[2] + q[1] * q[2] + r[1] * r[2]) / 12;
+    } // end foreach triangle
+  }   // end foreach cell
+}
+
+//------------------------------------------------------------------------------
+// Update the range of the parametric coordinates of the points of the cells
+// along the axes through mean. If visited is not null, points already marked
+// with stamp are skipped, and the other ones are marked. Points shared with
+// nodes built concurrently may be projected twice, which does not change the
+// range.
+void ProjectCellPoints(vtkDataSet* dataSet, const vtkIdType* begin, const vtkIdType* end,
+  const double mean[3], const double* axes[3], const double axesNorm2[3], vtkIdList* cellPts,
+  std::atomic<vtkIdType>* visited, vtkIdType stamp, double tMin[3], double tMax[3])
+{
+  vtkIdType numPts;
+  const vtkIdType* ptIds;
+  double p[3], t;
+  for (const vtkIdType* cellIdIt = begin; cellIdIt != end; ++cellIdIt)
+  {
+    dataSet->GetCellPoints(*cellIdIt, numPts, ptIds, cellPts);
+    for (vtkIdType j = 0; j < numPts; j++)
+    {
+      if (visited)
+      {
+        std::atomic<vtkIdType>& pointStamp = visited[ptIds[j]];
+        if (pointStamp.load(std::memory_order_relaxed) == stamp)
+        {
+          continue;
+        }
+        pointStamp.store(stamp, std::memory_order_relaxed);
+      }
+      dataSet->GetPoint(ptIds[j], p);
+      p[0] -= mean[0];
+      p[1] -= mean[1];
+      p[2] -= mean[2];
+      for (int i = 0; i < 3; i++)
+      {
+        t = vtkMath::Dot(p, axes[i]) / axesNorm2[i];
+        tMin[i] = std::min(t, tMin[i]);
+        tMax[i] = std::max(t, tMax[i]);
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Compute the OBB of the cells, as described in vtkOBBTree::ComputeOBB. If
+// parallel is true, the cells are processed concurrently. See ProjectCellPoints
+// for visited and stamp.
+void ComputeCellsOBB(vtkDataSet* dataSet, const vtkIdType* cells, vtkIdType numCells,
+  bool parallel, vtkSMPThreadLocalObject<vtkIdList>& cellPts, std::atomic<vtkIdType>* visited,
+  vtkIdType stamp, double corner[3], double max[3], double mid[3], double min[3], double size[3])
+{
+  //
+  // Compute mean & moments
+  //
+  const vtkIdType numBlocks = (numCells + OBB_MOMENTS_BLOCK_SIZE - 1) / OBB_MOMENTS_BLOCK_SIZE;
+  std::vector<vtkOBBMoments> blockMoments(numBlocks);
+  auto accumulateBlocks = [&](vtkIdType first, vtkIdType last)
+  {
+    vtkIdList* ptIds = cellPts.Local();
+    for (vtkIdType block = first; block < last; ++block)
+    {
+      const vtkIdType* begin = cells + block * OBB_MOMENTS_BLOCK_SIZE;
+      const vtkIdType* end = cells + std::min((block + 1) * OBB_MOMENTS_BLOCK_SIZE, numCells);
+      AccumulateMoments(dataSet, begin, end, ptIds, blockMoments[block]);
+    }
+  };
+  if (parallel)
+  {
+    vtkSMPTools::For(0, numBlocks, 1, accumulateBlocks);
+  }
+  else
+  {
+    accumulateBlocks(0, numBlocks);
+  }
+
+  vtkOBBMoments moments;
+  for (const vtkOBBMoments& block : blockMoments)
+  {
+    moments.Mass += block.Mass;
+    for (int i = 0; i < 3; i++)
+    {
+      moments.Mean[i] += block.Mean[i];
+      for (int j = i; j < 3; j++)
+      {
+        moments.A[i][j] += block.A[i][j];
+      }
+    }
+  }
+
+  // normalize data
+  double mean[3];
+  for (int i = 0; i < 3; i++)
+  {
+    mean[i] = moments.Mean[i] / moments.Mass;
+  }
+
+  // matrix is symmetric
+  double *a[3], a0[3], a1[3], a2[3];
+  a[0] = a0;
+  a[1] = a1;
+  a[2] = a2;
+  for (int i = 0; i < 3; i++)
+  {
+    for (int j = 0; j < 3; j++)
+    {
+      a[i][j] = i <= j ? moments.A[i][j] : moments.A[j][i];
+    }
+  }
+
+  // get covariance from moments
+  for (int i = 0; i < 3; i++)
+  {
+    for (int j = 0; j < 3; j++)
+    {
+      a[i][j] = a[i][j] / moments.Mass - mean[i] * mean[j];
+    }
+  }
+
+  //
+  // Extract axes (i.e., eigenvectors) from covariance matrix.
+  //
+  double *v[3], v0[3], v1[3], v2[3];
+  v[0] = v0;
+  v[1] = v1;
+  v[2] = v2;
+  vtkMath::Jacobi(a, size, v);
+  max[0] = v[0][0];
+  max[1] = v[1][0];
+  max[2] = v[2][0];
+  mid[0] = v[0][1];
+  mid[1] = v[1][1];
+  mid[2] = v[2][1];
+  min[0] = v[0][2];
+  min[1] = v[1][2];
+  min[2] = v[2][2];
+
+  // Parametric coordinates along the axes are (x - mean).axis / |axis|^2
+  const double* axes[3] = { max, mid, min };
+  double axesNorm2[3];
+  for (int i = 0; i < 3; i++)
+  {
+    axesNorm2[i] = vtkMath::Dot(axes[i], axes[i]);
+  }
+
+  //
+  // Create oriented bounding box by projecting points onto eigenvectors.
+  //
+  double tMin[3] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, VTK_DOUBLE_MAX };
+  double tMax[3] = { -VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+  if (parallel)
+  {
+    const std::array<double, 6> empty = { VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, VTK_DOUBLE_MAX,
+      -VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+    vtkSMPThreadLocal<std::array<double, 6>> localRanges(empty);
+    vtkSMPTools::For(0, numCells,
+      [&](vtkIdType first, vtkIdType last)
+      {
+        std::array<double, 6>& range = localRanges.Local();
+        ProjectCellPoints(dataSet, cells + first, cells + last, mean, axes, axesNorm2,
+          cellPts.Local(), visited, stamp, range.data(), range.data() + 3);
+      });
+    for (const std::array<double, 6>& range : localRanges)
+    {
+      for (int i = 0; i < 3; i++)
+      {
+        tMin[i] = std::min(range[i], tMin[i]);
+        tMax[i] = std::max(range[i + 3], tMax[i]);
+      }
+    }
+  }
+  else
+  {
+    ProjectCellPoints(dataSet, cells, cells + numCells, mean, axes, axesNorm2, cellPts.Local(),
+      visited, stamp, tMin, tMax);
+  }
+
+  for (int i = 0; i < 3; i++)
+  {
+    corner[i] = mean[i] + tMin[0] * max[i] + tMin[1] * mid[i] + tMin[2] * min[i];
+
+    max[i] = (tMax[0] - tMin[0]) * max[i];
+    mid[i] = (tMax[1] - tMin[1]) * mid[i];
+    min[i] = (tMax[2] - tMin[2]) * min[i];
+  }
+}
+
+//------------------------------------------------------------------------------
+// Build the OBB tree one level at a time. The nodes of a level are built
+// concurrently, except for the few large nodes near the root, which are built
+// one after the other with their cells processed concurrently.
+class vtkOBBTreeBuilder
+{
+public:
+  vtkOBBTreeBuilder(vtkDataSet* dataSet, int maxLevel, int numberOfCellsPerNode,
+    bool retainCellLists, vtkOBBFlatTree* flatTree)
+    : DataSet(dataSet)
+    , MaxLevel(maxLevel)
+    , NumberOfCellsPerNode(numberOfCellsPerNode)
+    , RetainCellLists(retainCellLists)
+    , FlatTree(flatTree)
+    , VisitedPoints(dataSet->GetNumberOfPoints())
+  {
+  }
+
+  void Build(vtkOBBNode* root)
+  {
+    const vtkIdType numCells = this->DataSet->GetNumberOfCells();
+    const vtkIdType numberOfThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+
+    std::vector<Task> level(1);
+    level[0].Node = root;
+    level[0].FlatIndex = 0;
+    level[0].Level = 0;
+    level[0].Cells.resize(numCells);
+    std::iota(level[0].Cells.begin(), level[0].Cells.end(), 0);
+    this->FlatTree->Nodes.resize(1);
+
+    std::vector<Task> kids;
+    std::vector<Task> nextLevel;
+    std::vector<char> isSplit;
+    std::vector<size_t> concurrentTasks;
+    std::vector<std::pair<vtkOBBNode*, vtkIdType>> leaves;
+    while (!level.empty())
+    {
+      const size_t numberOfTasks = level.size();
+      this->Level = level[0].Level;
+      this->NumberOfNodes += static_cast<int>(numberOfTasks);
+
+      kids.clear();
+      kids.resize(2 * numberOfTasks);
+      isSplit.assign(numberOfTasks, 0);
+      concurrentTasks.clear();
+      for (size_t i = 0; i < numberOfTasks; i++)
+      {
+        const vtkIdType size = static_cast<vtkIdType>(level[i].Cells.size());
+        if (size >= OBB_PARALLEL_NODE_SIZE && size * numberOfThreads > numCells)
+        {
+          isSplit[i] = this->BuildNode(level[i], &kids[2 * i], true);
+        }
+        else
+        {
+          concurrentTasks.push_back(i);
+        }
+      }
+
+      vtkSMPTools::For(0, static_cast<vtkIdType>(concurrentTasks.size()), 1,
+        [&](vtkIdType begin, vtkIdType end)
+        {
+          for (vtkIdType taskIdx = begin; taskIdx < end; taskIdx++)
+          {
+            const size_t i = concurrentTasks[taskIdx];
+            isSplit[i] = this->BuildNode(level[i], &kids[2 * i], false);
+          }
+        });
+
+      // Kids of a node are next to each other in the flat tree
+      nextLevel.clear();
+      for (size_t i = 0; i < numberOfTasks; i++)
+      {
+        const vtkIdType flatIndex = level[i].FlatIndex;
+        const vtkIdType numberOfFlatNodes = static_cast<vtkIdType>(this->FlatTree->Nodes.size());
+        vtkOBBFlatTree::Node& flatNode = this->FlatTree->Nodes[flatIndex];
+        if (isSplit[i])
+        {
+          flatNode.Kids = numberOfFlatNodes;
+          flatNode.CellsBegin = flatNode.CellsEnd = 0;
+          kids[2 * i].FlatIndex = numberOfFlatNodes;
+          kids[2 * i + 1].FlatIndex = numberOfFlatNodes + 1;
+          nextLevel.push_back(std::move(kids[2 * i]));
+          nextLevel.push_back(std::move(kids[2 * i + 1]));
+          this->FlatTree->Nodes.resize(numberOfFlatNodes + 2);
+        }
+        else
+        {
+          std::vector<vtkIdType>& flatCells = this->FlatTree->Cells;
+          flatNode.Kids = -1;
+          flatNode.CellsBegin = static_cast<vtkIdType>(flatCells.size());
+          if (this->RetainCellLists)
+          {
+            flatCells.insert(flatCells.end(), level[i].Cells.begin(), level[i].Cells.end());
+            leaves.emplace_back(level[i].Node, flatIndex);
+          }
+          flatNode.CellsEnd = static_cast<vtkIdType>(flatCells.size());
+          std::vector<vtkIdType>().swap(level[i].Cells);
+        }
+      }
+      std::swap(level, nextLevel);
+    }
+
+    // The cells of a leaf are only stored once, in the flat tree, and its
+    // cell list does not own them
+    for (const auto& leaf : leaves)
+    {
+      const vtkOBBFlatTree::Node& flatNode = this->FlatTree->Nodes[leaf.second];
+      leaf.first->Cells = vtkIdList::New();
+      leaf.first->Cells->SetArray(this->FlatTree->Cells.data() + flatNode.CellsBegin,
+        flatNode.CellsEnd - flatNode.CellsBegin, false);
+    }
+  }
+
+  int Level = 0;
+  int NumberOfNodes = 0;
+
+private:
+  struct Task
+  {
+    vtkOBBNode* Node = nullptr;
+    vtkIdType FlatIndex = 0;
+    int Level = 0;
+    std::vector<vtkIdType> Cells;
+  };
+
+  // Assign the cells to the left (1) or right (0) of the plane through p with
+  // normal n, as vtkOBBTree::BuildTree does. Return the number of cells on the left.
+  vtkIdType ClassifyCells(const std::vector<vtkIdType>& cells, const double n[3],
+    const double p[3], bool parallel, std::vector<unsigned char>& left)
+  {
+    const vtkIdType numCells = static_cast<vtkIdType>(cells.size());
+    left.resize(numCells);
+    auto classify = [&](vtkIdType first, vtkIdType last)
+    {
+      vtkIdList* ptIds = this->CellPoints.Local();
+      vtkIdType numPts;
+      const vtkIdType* pts;
+      double x[3], c[3], val;
+      for (vtkIdType i = first; i < last; i++)
+      {
+        this->DataSet->GetCellPoints(cells[i], numPts, pts, ptIds);
+        c[0] = c[1] = c[2] = 0.0;
+        bool negative = false;
+        bool positive = false;
+        for (vtkIdType j = 0; j < numPts; j++)
+        {
+          this->DataSet->GetPoint(pts[j], x);
+          val = n[0] * (x[0] - p[0]) + n[1] * (x[1] - p[1]) + n[2] * (x[2] - p[2]);
+          c[0] += x[0];
+          c[1] += x[1];
+          c[2] += x[2];
+          if (val < 0.0)
+          {
+            negative = true;
+          }
+          else
+          {
+            positive = true;
+          }
+        }
+
+        if (negative && positive)
+        { // Use centroid to decide straddle cases
+          c[0] /= numPts;
+          c[1] /= numPts;
+          c[2] /= numPts;
+          left[i] = n[0] * (c[0] - p[0]) + n[1] * (c[1] - p[1]) + n[2] * (c[2] - p[2]) < 0.0;
+        }
+        else
+        {
+          left[i] = negative;
+        }
+      }
+    };
+    if (parallel)
+    {
+      vtkSMPTools::For(0, numCells, classify);
+    }
+    else
+    {
+      classify(0, numCells);
+    }
+    return std::count(left.begin(), left.end(), 1);
+  }
+
+  // Compute the box of the node of task and, if it is split, create its kids
+  // and the tasks to build them. Return whether the node was split.
+  bool BuildNode(Task& task, Task kids[2], bool parallel)
+  {
+    vtkOBBNode* OBBptr = task.Node;
+    const vtkIdType numCells = static_cast<vtkIdType>(task.Cells.size());
+    double size[3];
+    ComputeCellsOBB(this->DataSet, task.Cells.data(), numCells, parallel, this->CellPoints,
+      this->VisitedPoints.data(), task.FlatIndex + 1, OBBptr->Corner, OBBptr->Axes[0],
+      OBBptr->Axes[1], OBBptr->Axes[2], size);
+    this->FlatTree->SetBox(task.FlatIndex, OBBptr);
+
+    //
+    // Check whether to continue recursing; if so, create two children and
+    // assign cells to appropriate child.
+    //
+    if (task.Level < this->MaxLevel && numCells > this->NumberOfCellsPerNode)
+    {
+      std::vector<unsigned char> left;
+      double n[3], p[3], ratio, bestRatio;
+      int splitPlane, bestPlane = 0;
+      bool splitAcceptable, foundBestSplit;
+      vtkIdType numInLHnode = 0, numInRHnode = 0;
+
+      // loop over three split planes to find acceptable one
+      for (int i = 0; i < 3; i++) // compute split point
+      {
+        p[i] = OBBptr->Corner[i] + OBBptr->Axes[0][i] / 2.0 + OBBptr->Axes[1][i] / 2.0 +
+          OBBptr->Axes[2][i] / 2.0;
+      }
+
+      bestRatio = 1.0; // worst case ratio
+      foundBestSplit = false;
+      for (splitPlane = 0, splitAcceptable = false; !splitAcceptable && splitPlane < 3;)
+      {
+        // compute split normal
+        for (int i = 0; i < 3; i++)
+        {
+          n[i] = OBBptr->Axes[splitPlane][i];
+        }
+        vtkMath::Normalize(n);
+
+        // evaluate this split
+        numInLHnode = this->ClassifyCells(task.Cells, n, p, parallel, left);
+        numInRHnode = numCells - numInLHnode;
+        ratio = fabs(((double)numInRHnode - numInLHnode) / numCells);
+
+        // see whether we've found acceptable split plane
+        if (ratio < 0.6 || foundBestSplit) // accept right off the bat
+        {
+          splitAcceptable = true;
+        }
+        else
+        { // not a great split try another
+          if (ratio < bestRatio)
+          {
+            bestRatio = ratio;
+            bestPlane = splitPlane;
+          }
+          if (++splitPlane == 3 && bestRatio < 0.95)
+          { // at closing time, even the ugly ones look good
+            splitPlane = bestPlane;
+            foundBestSplit = true;
+          }
+        } // try another split
+      }   // for each split
+
+      if (splitAcceptable) // otherwise recursion terminates
+      {
+        vtkOBBNode* LHnode = new vtkOBBNode;
+        vtkOBBNode* RHnode = new vtkOBBNode;
+        OBBptr->Kids = new vtkOBBNode*[2];
+        OBBptr->Kids[0] = LHnode;
+        OBBptr->Kids[1] = RHnode;
+        LHnode->Parent = OBBptr;
+        RHnode->Parent = OBBptr;
+
+        kids[0].Node = LHnode;
+        kids[1].Node = RHnode;
+        kids[0].Level = kids[1].Level = task.Level + 1;
+        kids[0].Cells.reserve(numInLHnode);
+        kids[1].Cells.reserve(numInRHnode);
+        for (vtkIdType i = 0; i < numCells; i++)
+        {
+          kids[left[i] ? 0 : 1].Cells.push_back(task.Cells[i]);
+        }
+
+        // don't need to keep anymore
+        std::vector<vtkIdType>().swap(task.Cells);
+        return true;
+      }
+    } // if should build tree
+
+    return false;
+  }
+
+  vtkDataSet* DataSet;
+  int MaxLevel;
+  int NumberOfCellsPerNode;
+  bool RetainCellLists;
+  vtkOBBFlatTree* FlatTree;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+  // Stamp of the last node whose box includes each point, see ProjectCellPoints
+  std::vector<std::atomic<vtkIdType>> VisitedPoints;
+};
+} // anonymous namespace
+
 //------------------------------------------------------------------------------
 // Construct with automatic computation of divisions, averaging
 // 25 cells per octant.
@@ -74,6 +777,7 @@ vtkOBBTree::vtkOBBTree()
   this->PointsList = nullptr;
   this->InsertedPoints = nullptr;
   this->OBBCount = 0;
+  this->FlatTree = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -91,6 +795,8 @@ void vtkOBBTree::FreeSearchStructure()
     delete this->Tree;
     this->Tree = nullptr;
   }
+  delete this->FlatTree;
+  this->FlatTree = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -225,14 +931,13 @@ void vtkOBBTree::ComputeOBB(
 void vtkOBBTree::ComputeOBB(
   vtkDataSet* input, double corner[3], double max[3], double mid[3], double min[3], double size[3])
 {
-  vtkIdType numPts, numCells, i;
+  vtkIdType numCells, i;
   vtkIdList* cellList;
   vtkDataSet* origDataSet;
 
   vtkDebugMacro(<< "Computing OBB");
 
-  if (input == nullptr || (numPts = input->GetNumberOfPoints()) < 1 ||
-    (input->GetNumberOfCells()) < 1)
+  if (input == nullptr || input->GetNumberOfPoints() < 1 || input->GetNumberOfCells() < 1)
   {
     vtkErrorMacro(<< "Can't compute OBB - no data available!");
     return;
@@ -244,15 +949,7 @@ void vtkOBBTree::ComputeOBB(
   origDataSet = this->DataSet;
   this->DataSet = input;
 
-  // these are other member variables that ComputeOBB requires
   this->OBBCount = 0;
-  this->InsertedPoints = new int[numPts];
-  for (i = 0; i < numPts; i++)
-  {
-    this->InsertedPoints[i] = 0;
-  }
-  this->PointsList = vtkPoints::New();
-  this->PointsList->Allocate(numPts);
 
   cellList = vtkIdList::New();
   cellList->Allocate(numCells);
@@ -264,8 +961,6 @@ void vtkOBBTree::ComputeOBB(
   this->ComputeOBB(cellList, corner, max, mid, min, size);
 
   this->DataSet = origDataSet;
-  delete[] this->InsertedPoints;
-  this->PointsList->Delete();
   cellList->Delete();
 }
 
@@ -276,170 +971,10 @@ void vtkOBBTree::ComputeOBB(
 void vtkOBBTree::ComputeOBB(
   vtkIdList* cells, double corner[3], double max[3], double mid[3], double min[3], double size[3])
 {
-  vtkIdType numCells, i, j, cellId, ptId, pId, qId, rId;
-  int k, type;
-  vtkIdType numPts = 0;
-  const vtkIdType* ptIds = nullptr;
-  double p[3], q[3], r[3], mean[3], xp[3], *v[3], v0[3], v1[3], v2[3];
-  double *a[3], a0[3], a1[3], a2[3];
-  double tMin[3], tMax[3], closest[3], t;
-  double dp0[3], dp1[3], tri_mass, tot_mass, c[3];
-
   this->OBBCount++;
-  this->PointsList->Reset();
-  //
-  // Compute mean & moments
-  //
-
-  numCells = cells->GetNumberOfIds();
-  mean[0] = mean[1] = mean[2] = 0.0;
-  tot_mass = 0.0;
-  a[0] = a0;
-  a[1] = a1;
-  a[2] = a2;
-  for (i = 0; i < 3; i++)
-  {
-    a0[i] = a1[i] = a2[i] = 0.0;
-  }
-
-  for (i = 0; i < numCells; i++)
-  {
-    cellId = cells->GetId(i);
-    type = this->DataSet->GetCellType(cellId);
-    switch (this->DataSet->GetDataObjectType())
-    {
-      case VTK_POLY_DATA:
-        ((vtkPolyData*)this->DataSet)->GetCellPoints(cellId, numPts, ptIds);
-        break;
-      case VTK_UNSTRUCTURED_GRID:
-        ((vtkUnstructuredGrid*)this->DataSet)->GetCellPoints(cellId, numPts, ptIds);
-        break;
-      default:
-        vtkErrorMacro(<< "DataSet " << this->DataSet->GetClassName() << " not supported.");
-        break;
-    }
-    for (j = 0; j < numPts - 2; j++)
-    {
-      vtkCELLTRIANGLES(ptIds, type, j, pId, qId, rId);
-      if (pId < 0)
-      {
-        continue;
-      }
-      this->DataSet->GetPoint(pId, p);
-      this->DataSet->GetPoint(qId, q);
-      this->DataSet->GetPoint(rId, r);
-      // p, q, and r are the oriented triangle points.
-      // Compute the components of the moment of inertia tensor.
-      for (k = 0; k < 3; k++)
-      {
-        // two edge vectors
-        dp0[k] = q[k] - p[k];
-        dp1[k] = r[k] - p[k];
-        // centroid
-        c[k] = (p[k] + q[k] + r[k]) / 3;
-      }
-      vtkMath::Cross(dp0, dp1, xp);
-      tri_mass = 0.5 * vtkMath::Norm(xp);
-      tot_mass += tri_mass;
-      for (k = 0; k < 3; k++)
-      {
-        mean[k] += tri_mass * c[k];
-      }
-
-      // on-diagonal terms
-      a0[0] += tri_mass * (9 * c[0] * c[0] + p[0] * p[0] + q[0] * q[0] + r[0] * r[0]) / 12;
-      a1[1] += tri_mass * (9 * c[1] * c[1] + p[1] * p[1] + q[1] * q[1] + r[1] * r[1]) / 12;
-      a2[2] += tri_mass * (9 * c[2] * c[2] + p[2] * p[2] + q[2] * q[2] + r[2] * r[2]) / 12;
-
-      // off-diagonal terms
-      a0[1] += tri_mass * (9 * c[0] * c[1] + p[0] * p[1] + q[0] * q[1] + r[0] * r[1]) / 12;
-      a0[2] += tri_mass * (9 * c[0] * c[2] + p[0] * p[2] + q[0] * q[2] + r[0] * r[2]) / 12;
-      a1[2] += tri_mass * (9 * c[1] * c[2] + p[1] * p[2] + q[1] * q[2] + r[1] * r[2]) / 12;
-    } // end foreach triangle
-
-    // While computing cell moments, gather all the cell's
-    // point coordinates into a single list.
-    //
-    for (j = 0; j < numPts; j++)
-    {
-      if (this->InsertedPoints[ptIds[j]] != this->OBBCount)
-      {
-        this->InsertedPoints[ptIds[j]] = this->OBBCount;
-        this->PointsList->InsertNextPoint(this->DataSet->GetPoint(ptIds[j]));
-      }
-    } // for all points of this cell
-  }   // end foreach cell
-
-  // normalize data
-  for (i = 0; i < 3; i++)
-  {
-    mean[i] = mean[i] / tot_mass;
-  }
-
-  // matrix is symmetric
-  a1[0] = a0[1];
-  a2[0] = a0[2];
-  a2[1] = a1[2];
-
-  // get covariance from moments
-  for (i = 0; i < 3; i++)
-  {
-    for (j = 0; j < 3; j++)
-    {
-      a[i][j] = a[i][j] / tot_mass - mean[i] * mean[j];
-    }
-  }
-
-  //
-  // Extract axes (i.e., eigenvectors) from covariance matrix.
-  //
-  v[0] = v0;
-  v[1] = v1;
-  v[2] = v2;
-  vtkMath::Jacobi(a, size, v);
-  max[0] = v[0][0];
-  max[1] = v[1][0];
-  max[2] = v[2][0];
-  mid[0] = v[0][1];
-  mid[1] = v[1][1];
-  mid[2] = v[2][1];
-  min[0] = v[0][2];
-  min[1] = v[1][2];
-  min[2] = v[2][2];
-
-  for (i = 0; i < 3; i++)
-  {
-    a[0][i] = mean[i] + max[i];
-    a[1][i] = mean[i] + mid[i];
-    a[2][i] = mean[i] + min[i];
-  }
-
-  //
-  // Create oriented bounding box by projecting points onto eigenvectors.
-  //
-  tMin[0] = tMin[1] = tMin[2] = VTK_DOUBLE_MAX;
-  tMax[0] = tMax[1] = tMax[2] = -VTK_DOUBLE_MAX;
-
-  numPts = this->PointsList->GetNumberOfPoints();
-  for (ptId = 0; ptId < numPts; ptId++)
-  {
-    this->PointsList->GetPoint(ptId, p);
-    for (i = 0; i < 3; i++)
-    {
-      vtkLine::DistanceToLine(p, mean, a[i], t, closest);
-      tMin[i] = std::min(t, tMin[i]);
-      tMax[i] = std::max(t, tMax[i]);
-    }
-  } // for all points
-
-  for (i = 0; i < 3; i++)
-  {
-    corner[i] = mean[i] + tMin[0] * max[i] + tMin[1] * mid[i] + tMin[2] * min[i];
-
-    max[i] = (tMax[0] - tMin[0]) * max[i];
-    mid[i] = (tMax[1] - tMin[1]) * mid[i];
-    min[i] = (tMax[2] - tMin[2]) * min[i];
-  }
+  vtkSMPThreadLocalObject<vtkIdList> cellPts;
+  ComputeCellsOBB(this->DataSet, cells->GetPointer(0), cells->GetNumberOfIds(), false, cellPts,
+    nullptr, 0, corner, max, mid, min, size);
 }
 
 //------------------------------------------------------------------------------
@@ -906,7 +1441,19 @@ int vtkOBBTree::IntersectWithLine(
 int vtkOBBTree::IntersectWithLine(const double a0[3], const double a1[3], double tol, double& t,
   double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
 {
-  double tBest = VTK_DOUBLE_MAX, xBest[3] = {0., 0., 0,}, pcoordsBest[3] = {0., 0., 0.};
+  if (this->FlatTree && !this->FlatTree->Nodes.empty())
+  {
+    std::vector<vtkIdType> OBBstack(this->GetLevel() + 1);
+    return this->FlatTree->IntersectWithLine(this->DataSet, this->Tolerance, a0, a1, tol, t, x,
+      pcoords, subId, cellId, cell, OBBstack.data());
+  }
+  if (this->Tree == nullptr)
+  {
+    return 0;
+  }
+
+  // Trees built with BuildTree() have no flat copy: walk the nodes instead
+  double tBest = VTK_DOUBLE_MAX, xBest[3] = { 0., 0., 0. }, pcoordsBest[3] = { 0., 0., 0. };
   int subIdBest = -1;
   vtkIdType cellIdBest = -1;
 
@@ -917,41 +1464,37 @@ int vtkOBBTree::IntersectWithLine(const double a0[3], const double a1[3], double
   { // simulate recursion without the overhead or limitations
     depth--;
     vtkOBBNode* node = OBBstack[depth];
-    if (this->LineIntersectsNode(node, a0, a1))
+    if (!this->LineIntersectsNode(node, a0, a1))
     {
-      if (node->Kids == nullptr)
-      { // then this is a leaf node...get Cells
-        for (int ii = 0; ii < node->Cells->GetNumberOfIds(); ii++)
-        {
-          vtkIdType thisId = node->Cells->GetId(ii);
-          this->DataSet->GetCell(thisId, cell);
-          if (cell->IntersectWithLine(a0, a1, tol, t, x, pcoords, subId))
-          { // line intersects cell, but is it the best one?
-            if (t < tBest)
-            { // Yes, it's the best.
-              tBest = t;
-              xBest[0] = x[0];
-              xBest[1] = x[1];
-              xBest[2] = x[2];
-              pcoordsBest[0] = pcoords[0];
-              pcoordsBest[1] = pcoords[1];
-              pcoordsBest[2] = pcoords[2];
-              subIdBest = subId;
-              cellIdBest = thisId;
-            }
-          }
-        }
-      }
-      else
-      { // push kids onto stack
-        OBBstack[depth] = node->Kids[0];
-        OBBstack[depth + 1] = node->Kids[1];
-        depth += 2;
+      continue;
+    }
+    if (node->Kids)
+    { // push kids onto stack
+      OBBstack[depth] = node->Kids[0];
+      OBBstack[depth + 1] = node->Kids[1];
+      depth += 2;
+      continue;
+    }
+    const vtkIdType numCells = node->Cells ? node->Cells->GetNumberOfIds() : 0;
+    for (vtkIdType ii = 0; ii < numCells; ii++)
+    {
+      const vtkIdType thisId = node->Cells->GetId(ii);
+      this->DataSet->GetCell(thisId, cell);
+      if (cell->IntersectWithLine(a0, a1, tol, t, x, pcoords, subId) && t < tBest)
+      {
+        tBest = t;
+        xBest[0] = x[0];
+        xBest[1] = x[1];
+        xBest[2] = x[2];
+        pcoordsBest[0] = pcoords[0];
+        pcoordsBest[1] = pcoords[1];
+        pcoordsBest[2] = pcoords[2];
+        subIdBest = subId;
+        cellIdBest = thisId;
       }
     }
-  } // end while
+  }
 
-  // If a cell has been intersected, recover the information and return.
   if (cellIdBest >= 0)
   {
     this->DataSet->GetCell(cellIdBest, cell);
@@ -969,6 +1512,75 @@ int vtkOBBTree::IntersectWithLine(const double a0[3], const double a1[3], double
   return 0;
 }
 
+//------------------------------------------------------------------------------
+void vtkOBBTree::IntersectWithLines(vtkPoints* startPoints, vtkPoints* endPoints, double tol,
+  vtkIdList* cellIds, vtkDoubleArray* ts, vtkPoints* points)
+{
+  if (!startPoints || !endPoints || !cellIds)
+  {
+    vtkErrorMacro(<< "IntersectWithLines: start points, end points and cell ids are required");
+    return;
+  }
+  const vtkIdType numLines = startPoints->GetNumberOfPoints();
+  if (endPoints->GetNumberOfPoints() != numLines)
+  {
+    vtkErrorMacro(<< "IntersectWithLines: " << numLines << " start points but "
+                  << endPoints->GetNumberOfPoints() << " end points");
+    return;
+  }
+
+  this->BuildLocator();
+  cellIds->SetNumberOfIds(numLines);
+  if (ts)
+  {
+    ts->SetNumberOfComponents(1);
+    ts->SetNumberOfTuples(numLines);
+  }
+  if (points)
+  {
+    points->SetNumberOfPoints(numLines);
+  }
+
+  vtkSMPThreadLocalObject<vtkGenericCell> threadCell;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> threadStack;
+  vtkSMPTools::For(0, numLines,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkGenericCell* cell = threadCell.Local();
+      std::vector<vtkIdType>& OBBstack = threadStack.Local();
+      OBBstack.resize(this->GetLevel() + 1);
+      double a0[3], a1[3], t, x[3], pcoords[3];
+      int subId;
+      for (vtkIdType lineId = begin; lineId < end; lineId++)
+      {
+        startPoints->GetPoint(lineId, a0);
+        endPoints->GetPoint(lineId, a1);
+        vtkIdType cellId = -1;
+        const int hit = this->FlatTree && !this->FlatTree->Nodes.empty()
+          ? this->FlatTree->IntersectWithLine(this->DataSet, this->Tolerance, a0, a1, tol, t, x,
+              pcoords, subId, cellId, cell, OBBstack.data())
+          : this->vtkOBBTree::IntersectWithLine(a0, a1, tol, t, x, pcoords, subId, cellId, cell);
+        if (!hit)
+        {
+          cellId = -1;
+          t = VTK_DOUBLE_MAX;
+          x[0] = a1[0];
+          x[1] = a1[1];
+          x[2] = a1[2];
+        }
+        cellIds->SetId(lineId, cellId);
+        if (ts)
+        {
+          ts->SetValue(lineId, t);
+        }
+        if (points)
+        {
+          points->SetPoint(lineId, x);
+        }
+      }
+    });
+}
+
 //------------------------------------------------------------------------------
 void vtkOBBNode::DebugPrintTree(int level, double* leaf_vol, int* minCells, int* maxCells)
 {
@@ -1049,43 +1661,33 @@ void vtkOBBTree::ForceBuildLocator()
 //------------------------------------------------------------------------------
 void vtkOBBTree::BuildLocatorInternal()
 {
-  vtkIdType numPts, numCells, i;
-  vtkIdList* cellList;
-
   vtkDebugMacro(<< "Building OBB tree");
 
-  numPts = this->DataSet->GetNumberOfPoints();
-  numCells = this->DataSet->GetNumberOfCells();
-  if (this->DataSet == nullptr || numPts < 1 || numCells < 1)
+  if (this->DataSet == nullptr || this->DataSet->GetNumberOfPoints() < 1 ||
+    this->DataSet->GetNumberOfCells() < 1)
   {
     vtkErrorMacro(<< "Can't build OBB tree - no data available!");
     return;
   }
+  vtkIdType numCells = this->DataSet->GetNumberOfCells();
 
-  this->OBBCount = 0;
-  this->InsertedPoints = new int[numPts];
-  for (i = 0; i < numPts; i++)
-  {
-    this->InsertedPoints[i] = 0;
-  }
-  this->PointsList = vtkPoints::New();
-  this->PointsList->Allocate(numPts);
+  this->FreeSearchStructure();
+
+  // This is done to cause non-thread safe initialization to occur due to
+  // side effects from GetCell().
+  vtkNew<vtkGenericCell> cell;
+  this->DataSet->GetCell(0, cell);
 
   //
-  // Begin recursively creating OBB's
+  // Create the OBB's one level at a time
   //
-  cellList = vtkIdList::New();
-  cellList->Allocate(numCells);
-  for (i = 0; i < numCells; i++)
-  {
-    cellList->InsertId(i, i);
-  }
-
-  this->FreeSearchStructure();
-
   this->Tree = new vtkOBBNode;
-  this->Level = 0;
-  this->BuildTree(cellList, this->Tree, 0);
+  this->FlatTree = new vtkOBBFlatTree;
+  vtkOBBTreeBuilder builder(this->DataSet, this->MaxLevel, this->NumberOfCellsPerNode,
+    this->RetainCellLists, this->FlatTree);
+  builder.Build(this->Tree);
+  this->Level = builder.Level;
+  this->OBBCount = builder.NumberOfNodes;
 
   vtkDebugMacro(<< "# Cells: " << numCells << ", Deepest tree level: " << this->Level
                 << ", Created: " << this->OBBCount << " OBB nodes");
@@ -1099,12 +1701,6 @@ void vtkOBBTree::BuildLocatorInternal()
     std::cout.flush();
   }
 
-  //
-  // Clean up
-  //
-  delete[] this->InsertedPoints;
-  this->PointsList->Delete();
-
   this->BuildTime.Modified();
 }
 
@@ -1119,6 +1715,13 @@ void vtkOBBTree::BuildTree(vtkIdList* cells, vtkOBBNode* OBBptr, int level)
   vtkIdList* cellPts = vtkIdList::New();
   double size[3];
 
+  // The flat copy does not follow this tree: line intersections walk it instead.
+  // Its cells are kept, as they may still be viewed by the cell lists of nodes.
+  if (this->FlatTree)
+  {
+    this->FlatTree->Nodes.clear();
+  }
+
   this->Level = std::max(level, this->Level);
   //
   // Now compute the OBB
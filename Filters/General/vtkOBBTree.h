@@ -9,7 +9,7 @@
  * up along coordinate axes. The OBB tree is a hierarchical tree structure
  * of such boxes, where deeper levels of OBB confine smaller regions of space.
  *
- * To build the OBB, a recursive, top-down process is used. First, the root OBB
+ * To build the OBB, a top-down process is used. First, the root OBB
  * is constructed by finding the mean and covariance matrix of the cells (and
  * their points) that define the dataset. The eigenvectors of the covariance
  * matrix are extracted, giving a set of three orthogonal vectors that define
@@ -17,6 +17,9 @@
  * is found that (approximately) divides the number cells in half. These are
  * then assigned to the children OBB's. This process then continues until
  * the MaxLevel ivar limits the recursion, or no split plane can be found.
+ * The tree is built one level at a time, with the nodes of a level built
+ * concurrently using vtkSMPTools, and the cells of the largest nodes processed
+ * concurrently.
  *
  * A good reference for OBB-trees is Gottschalk & Manocha in Proceedings of
  * Siggraph `96.
@@ -55,10 +58,12 @@
 #define vtkOBBTree_h
 
 #include "vtkAbstractCellLocator.h"
+#include "vtkDeprecation.h"          // For VTK_DEPRECATED_IN_9_7_0
 #include "vtkFiltersGeneralModule.h" // For export macro
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkMatrix4x4;
+struct vtkOBBFlatTree;
 
 // Special class defines node for the OBB tree
 class VTKFILTERSGENERAL_EXPORT vtkOBBNode
@@ -122,6 +127,14 @@ public:
   int IntersectWithLine(
     const double a0[3], const double a1[3], vtkPoints* points, vtkIdList* cellIds) override;
 
+  /**
+   * Intersect many line segments with the cells of the dataset concurrently,
+   * see vtkAbstractCellLocator. The segments traverse the flattened nodes of
+   * the tree directly.
+   */
+  void IntersectWithLines(vtkPoints* startPoints, vtkPoints* endPoints, double tol,
+    vtkIdList* cellIds, vtkDoubleArray* ts = nullptr, vtkPoints* points = nullptr) override;
+
   /**
    * Compute an OBB from the list of points given. Return the corner point
    * and the three axes defining the orientation of the OBB. Also return
@@ -204,6 +217,7 @@ protected:
     double size[3]);
 
   vtkOBBNode* Tree;
+  VTK_DEPRECATED_IN_9_7_0("The tree is built one level at a time by BuildLocatorInternal")
   void BuildTree(vtkIdList* cells, vtkOBBNode* parent, int level);
   vtkPoints* PointsList;
   int* InsertedPoints;
@@ -214,6 +228,9 @@ protected:
     vtkOBBNode* OBBptr, int level, int repLevel, vtkPoints* pts, vtkCellArray* polys);
 
 private:
+  // Copy of the tree in contiguous arrays, used to intersect lines
+  vtkOBBFlatTree* FlatTree;
+
   vtkOBBTree(const vtkOBBTree&) = delete;
   void operator=(const vtkOBBTree&) = delete;
 };
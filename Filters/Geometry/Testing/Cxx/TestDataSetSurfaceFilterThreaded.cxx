@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the threaded implementation of vtkDataSetSurfaceFilter produces
+// the same output as the sequential one for unstructured grids.
+
+#include "vtkAppendFilter.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellTypeSource.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+
+namespace
+{
+// Build a grid with all the linear cell types handled by the threaded
+// implementation, in an interleaved order.
+vtkSmartPointer<vtkUnstructuredGrid> CreateInput(bool withGhosts)
+{
+  vtkNew<vtkAppendFilter> append;
+  for (int cellType : { VTK_HEXAHEDRON, VTK_VOXEL, VTK_TETRA, VTK_WEDGE, VTK_PYRAMID,
+         VTK_PENTAGONAL_PRISM, VTK_HEXAGONAL_PRISM })
+  {
+    vtkNew<vtkCellTypeSource> source;
+    source->SetCellType(cellType);
+    source->SetBlocksDimensions(3, 4, 2);
+    source->Update();
+    append->AddInputData(source->GetOutput());
+  }
+  append->Update();
+  vtkUnstructuredGrid* cells3D = append->GetOutput();
+  const vtkIdType numPts = cells3D->GetNumberOfPoints();
+
+  // Lower dimensional cells, reusing the points of the 3D cells.
+  vtkNew<vtkUnstructuredGrid> cells;
+  cells->ShallowCopy(cells3D);
+  cells->GetCellData()->Initialize();
+  vtkIdType ids[8];
+  for (vtkIdType i = 0; i < 8; ++i)
+  {
+    for (vtkIdType j = 0; j < 8; ++j)
+    {
+      ids[j] = (i * 37 + j * 11) % numPts;
+    }
+    cells->InsertNextCell(VTK_VERTEX, 1, ids);
+    cells->InsertNextCell(VTK_POLY_VERTEX, 3, ids);
+    cells->InsertNextCell(VTK_LINE, 2, ids);
+    cells->InsertNextCell(VTK_POLY_LINE, 4, ids);
+    cells->InsertNextCell(VTK_TRIANGLE, 3, ids);
+    cells->InsertNextCell(VTK_QUAD, 4, ids);
+    cells->InsertNextCell(VTK_PIXEL, 4, ids);
+    cells->InsertNextCell(VTK_POLYGON, 5, ids);
+    cells->InsertNextCell(VTK_TRIANGLE_STRIP, 6, ids);
+    cells->InsertNextCell(VTK_EMPTY_CELL, 0, ids);
+  }
+
+  // Interleave the cells.
+  const vtkIdType numCells = cells->GetNumberOfCells();
+  vtkIdType stride = 7;
+  while (numCells % stride == 0)
+  {
+    stride += 2;
+  }
+  vtkNew<vtkUnstructuredGrid> input;
+  input->SetPoints(cells->GetPoints());
+  input->AllocateEstimate(numCells, 8);
+  vtkNew<vtkIdList> cellPts;
+  vtkNew<vtkDoubleArray> cellIndex;
+  cellIndex->SetName("CellIndex");
+  for (vtkIdType i = 0; i < numCells; ++i)
+  {
+    const vtkIdType cellId = (i * stride) % numCells;
+    cells->GetCellPoints(cellId, cellPts);
+    input->InsertNextCell(cells->GetCellType(cellId), cellPts);
+    cellIndex->InsertNextValue(cellId);
+  }
+  input->GetCellData()->AddArray(cellIndex);
+
+  vtkNew<vtkDoubleArray> pointIndex;
+  pointIndex->SetName("PointIndex");
+  pointIndex->SetNumberOfComponents(2);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    pointIndex->InsertNextTuple2(ptId, -ptId);
+  }
+  input->GetPointData()->AddArray(pointIndex);
+
+  if (withGhosts)
+  {
+    vtkNew<vtkUnsignedCharArray> cellGhosts;
+    cellGhosts->SetName(vtkDataSetAttributes::GhostArrayName());
+    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+      cellGhosts->InsertNextValue(cellId % 9 == 0 ? vtkDataSetAttributes::HIDDENCELL : 0);
+    }
+    input->GetCellData()->AddArray(cellGhosts);
+    vtkNew<vtkUnsignedCharArray> pointGhosts;
+    pointGhosts->SetName(vtkDataSetAttributes::GhostArrayName());
+    for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+      pointGhosts->InsertNextValue(ptId % 23 == 0 ? vtkDataSetAttributes::HIDDENPOINT : 0);
+    }
+    input->GetPointData()->AddArray(pointGhosts);
+  }
+  return input;
+}
+
+bool TestConfiguration(vtkUnstructuredGrid* input, const char* name, bool passThroughIds)
+{
+  vtkNew<vtkDataSetSurfaceFilter> sequential;
+  sequential->SetInputData(input);
+  sequential->SetPassThroughCellIds(passThroughIds);
+  sequential->SetPassThroughPointIds(passThroughIds);
+  sequential->Update();
+
+  vtkNew<vtkDataSetSurfaceFilter> threaded;
+  threaded->SetInputData(input);
+  threaded->SetPassThroughCellIds(passThroughIds);
+  threaded->SetPassThroughPointIds(passThroughIds);
+  threaded->UseThreadingOn();
+  threaded->Update();
+
+  if (sequential->GetOutput()->GetNumberOfPolys() == 0)
+  {
+    vtkLog(ERROR, "No surface extracted with " << name << ".");
+    return false;
+  }
+  if (!vtkTestUtilities::CompareDataObjects(sequential->GetOutput(), threaded->GetOutput()))
+  {
+    vtkLog(ERROR, "Threaded output differs from sequential output with " << name << ".");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestDataSetSurfaceFilterThreaded(int, char*[])
+{
+  vtkSmartPointer<vtkUnstructuredGrid> input = CreateInput(false);
+  bool success = TestConfiguration(input, "default parameters", false);
+  success &= TestConfiguration(input, "original ids", true);
+
+  vtkSmartPointer<vtkUnstructuredGrid> ghostInput = CreateInput(true);
+  success &= TestConfiguration(ghostInput, "ghosts", true);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
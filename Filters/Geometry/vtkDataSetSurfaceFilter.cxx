@@ -3,6 +3,7 @@
 
 #include "vtkDataSetSurfaceFilter.h"
 
+#include "vtkArrayListTemplate.h" // For processing attribute data
 #include "vtkBezierCurve.h"
 #include "vtkBezierQuadrilateral.h"
 #include "vtkBezierTriangle.h"
@@ -28,6 +29,9 @@
 #include "vtkPyramid.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridGeometryFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredData.h"
@@ -45,9 +49,13 @@
 #include "vtkWedge.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <limits>
+#include <memory>
 #include <numeric>
 #include <unordered_map>
+#include <vector>
 
 namespace
 {
@@ -281,6 +289,201 @@ bool StructuredExecuteWithBlanking(
   return true;
 }
 
+//------------------------------------------------------------------------------
+// Helpers for the threaded extraction of the surface of unstructured grids.
+// The faces of the 3D cells are gathered in buckets indexed by their smallest
+// point id, like in the quad hash. Each bucket is then resolved by replaying
+// the insertions of the sequential implementation in cell order, so that the
+// output is identical.
+
+// The faces of a linear 3D cell, in the order they are inserted in the quad
+// hash. Faces with 3 points go through InsertTriInHash(), faces with 4 points
+// through InsertQuadInHash() and larger faces through InsertPolygonInHash().
+constexpr int MaxNumberOfFaces = 8;
+constexpr int MaxFaceSize = 6;
+struct FaceDefinitions
+{
+  int NumberOfFaces;
+  int FaceSizes[MaxNumberOfFaces];
+  int Faces[MaxNumberOfFaces][MaxFaceSize];
+};
+
+const FaceDefinitions HexahedronFaces = { 6, { 4, 4, 4, 4, 4, 4 },
+  { { 0, 1, 5, 4 }, { 0, 3, 2, 1 }, { 0, 4, 7, 3 }, { 1, 2, 6, 5 }, { 2, 3, 7, 6 },
+    { 4, 5, 6, 7 } } };
+const FaceDefinitions VoxelFaces = { 6, { 4, 4, 4, 4, 4, 4 },
+  { { 0, 1, 5, 4 }, { 0, 2, 3, 1 }, { 0, 4, 6, 2 }, { 1, 3, 7, 5 }, { 2, 6, 7, 3 },
+    { 4, 5, 7, 6 } } };
+const FaceDefinitions TetraFaces = { 4, { 3, 3, 3, 3 },
+  { { 0, 1, 3 }, { 0, 2, 1 }, { 0, 3, 2 }, { 1, 2, 3 } } };
+const FaceDefinitions PentagonalPrismFaces = { 7, { 4, 4, 4, 4, 4, 5, 5 },
+  { { 0, 1, 6, 5 }, { 1, 2, 7, 6 }, { 2, 3, 8, 7 }, { 3, 4, 9, 8 }, { 4, 0, 5, 9 },
+    { 0, 1, 2, 3, 4 }, { 5, 6, 7, 8, 9 } } };
+const FaceDefinitions HexagonalPrismFaces = { 8, { 4, 4, 4, 4, 4, 4, 6, 6 },
+  { { 0, 1, 7, 6 }, { 1, 2, 8, 7 }, { 2, 3, 9, 8 }, { 3, 4, 10, 9 }, { 4, 5, 11, 10 },
+    { 5, 0, 6, 11 }, { 0, 1, 2, 3, 4, 5 }, { 6, 7, 8, 9, 10, 11 } } };
+const FaceDefinitions PyramidFaces = { 5, { 4, 3, 3, 3, 3 },
+  { { 3, 2, 1, 0 }, { 0, 1, 4 }, { 1, 2, 4 }, { 2, 3, 4 }, { 3, 0, 4 } } };
+const FaceDefinitions WedgeFaces = { 5, { 4, 4, 4, 3, 3 },
+  { { 0, 2, 5, 3 }, { 1, 0, 3, 4 }, { 2, 1, 4, 5 }, { 0, 1, 2 }, { 3, 5, 4 } } };
+
+const FaceDefinitions* GetFaceDefinitions(int cellType)
+{
+  switch (cellType)
+  {
+    case VTK_HEXAHEDRON:
+      return &HexahedronFaces;
+    case VTK_VOXEL:
+      return &VoxelFaces;
+    case VTK_TETRA:
+      return &TetraFaces;
+    case VTK_PENTAGONAL_PRISM:
+      return &PentagonalPrismFaces;
+    case VTK_HEXAGONAL_PRISM:
+      return &HexagonalPrismFaces;
+    case VTK_PYRAMID:
+      return &PyramidFaces;
+    case VTK_WEDGE:
+      return &WedgeFaces;
+    default:
+      return nullptr;
+  }
+}
+
+// Whether the threaded implementation handles all the cells of the grid.
+bool CanExtractSurfaceInParallel(vtkUnstructuredGrid* input)
+{
+  vtkUnsignedCharArray* cellTypes = input->GetDistinctCellTypesArray();
+  for (vtkIdType i = 0; i < cellTypes->GetNumberOfValues(); ++i)
+  {
+    const int cellType = cellTypes->GetValue(i);
+    switch (cellType)
+    {
+      case VTK_EMPTY_CELL:
+      case VTK_VERTEX:
+      case VTK_POLY_VERTEX:
+      case VTK_LINE:
+      case VTK_POLY_LINE:
+      case VTK_TRIANGLE:
+      case VTK_QUAD:
+      case VTK_PIXEL:
+      case VTK_POLYGON:
+      case VTK_TRIANGLE_STRIP:
+        break;
+      default:
+        if (!GetFaceDefinitions(cellType))
+        {
+          return false;
+        }
+    }
+  }
+  return true;
+}
+
+// Copy a face in the form the quad hash stores it: rotated so that its
+// smallest point id comes first, with the same tie breaking as
+// InsertTriInHash(), InsertQuadInHash() and InsertPolygonInHash().
+int GetHashedFace(
+  const vtkIdType* cellPts, const FaceDefinitions& faces, int faceId, vtkIdType* face)
+{
+  const int size = faces.FaceSizes[faceId];
+  const int* facePts = faces.Faces[faceId];
+  int start = 0;
+  if (size <= 4)
+  {
+    for (int i = 1; i < size; ++i)
+    {
+      bool smallest = true;
+      for (int j = 0; j < size && smallest; ++j)
+      {
+        smallest = (j == i || cellPts[facePts[i]] < cellPts[facePts[j]]);
+      }
+      if (smallest)
+      {
+        start = i;
+      }
+    }
+  }
+  else
+  {
+    for (int i = 1; i < size; ++i)
+    {
+      if (cellPts[facePts[i]] < cellPts[facePts[start]])
+      {
+        start = i;
+      }
+    }
+  }
+  for (int i = 0; i < size; ++i)
+  {
+    face[i] = cellPts[facePts[(start + i) % size]];
+  }
+  return size;
+}
+
+// Whether a face inserted in the hash matches a face already in the same
+// bucket, following the tests of the quad hash insertion methods.
+bool MatchHashedFaces(const vtkIdType* face, const vtkIdType* hashed, int size)
+{
+  if (size == 3)
+  {
+    return (face[1] == hashed[1] && face[2] == hashed[2]) ||
+      (face[1] == hashed[2] && face[2] == hashed[1]);
+  }
+  if (size == 4)
+  {
+    return face[2] == hashed[2] &&
+      ((face[1] == hashed[1] && face[3] == hashed[3]) ||
+        (face[1] == hashed[3] && face[3] == hashed[1]));
+  }
+  if (face[1] == hashed[1])
+  {
+    return std::equal(face + 2, face + size, hashed + 2);
+  }
+  for (int i = 1; i < size; ++i)
+  {
+    if (face[size - i] != hashed[i])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Output produced by a block of input cells, other than the faces of 3D cells.
+constexpr vtkIdType SurfaceCellBlockSize = 1024;
+struct SurfaceCellBlock
+{
+  vtkIdType NumberOfVerts = 0;
+  vtkIdType VertsSize = 0;
+  vtkIdType NumberOfLines = 0;
+  vtkIdType LinesSize = 0;
+  vtkIdType NumberOfPolys = 0;
+  vtkIdType PolysSize = 0;
+  // Number of point uses by the 2D cells, which differs from the size of the
+  // output polygons for triangle strips.
+  vtkIdType PolysUses = 0;
+};
+
+// Workspace used to resolve a bucket of faces.
+struct FaceBucketWorkspace
+{
+  std::vector<vtkIdType> Points;
+  std::vector<int> Sizes;
+  std::vector<vtkIdType> Slots;
+  std::vector<bool> Hidden;
+};
+
+constexpr vtkIdType UnusedPosition = std::numeric_limits<vtkIdType>::max();
+
+void AtomicMin(std::atomic<vtkIdType>& value, vtkIdType candidate)
+{
+  vtkIdType current = value.load(std::memory_order_relaxed);
+  while (candidate < current &&
+    !value.compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+  {
+  }
+}
 }
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -359,6 +562,7 @@ vtkDataSetSurfaceFilter::vtkDataSetSurfaceFilter()
 
   this->AllowInterpolation = true;
   this->Delegation = false;
+  this->UseThreading = false;
 }
 
 //------------------------------------------------------------------------------
@@ -1295,6 +1499,7 @@ void vtkDataSetSurfaceFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "FastMode: " << this->GetFastMode() << endl;
   os << indent << "AllowInterpolation: " << this->GetAllowInterpolation() << endl;
   os << indent << "Delegation: " << this->GetDelegation() << endl;
+  os << indent << "UseThreading: " << this->GetUseThreading() << endl;
 }
 
 //========================================================================
@@ -1349,6 +1554,12 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(
     delete info;
   }
 
+  if (this->UseThreading && !handleSubdivision && this->NonlinearSubdivisionLevel < 2 &&
+    ::CanExtractSurfaceInParallel(input))
+  {
+    return this->ThreadedUnstructuredGridExecute(input, output);
+  }
+
   // If here, the data is gnarly and this filter will process it.
   return this->UnstructuredGridExecuteInternal(input, output, handleSubdivision);
 }
@@ -2287,6 +2498,595 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecuteInternal(
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// Threaded version of UnstructuredGridExecuteInternal() for grids of linear
+// cells. It produces the same output: cells are output in the same order, and
+// points are numbered in the order of their first use by the output cells,
+// like GetOutputPointId() does.
+int vtkDataSetSurfaceFilter::ThreadedUnstructuredGridExecute(
+  vtkUnstructuredGrid* input, vtkPolyData* output)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+  vtkUnsignedCharArray* ghosts = input->GetPointGhostArray();
+  vtkUnsignedCharArray* ghostCells = input->GetCellGhostArray();
+  vtkPointData* inputPD = input->GetPointData();
+  vtkCellData* inputCD = input->GetCellData();
+  vtkPointData* outputPD = output->GetPointData();
+  vtkCellData* outputCD = output->GetCellData();
+
+  // Shallow copy field data not associated with points or cells
+  output->GetFieldData()->ShallowCopy(input->GetFieldData());
+
+  auto isHiddenCell = [ghostCells](vtkIdType cellId)
+  {
+    return ghostCells &&
+      (ghostCells->GetValue(cellId) & vtkDataSetAttributes::CellGhostTypes::HIDDENCELL);
+  };
+  auto isHiddenFace = [ghosts](const vtkIdType* face, int size)
+  {
+    return ghosts &&
+      std::any_of(face, face + size, [ghosts](vtkIdType ptId)
+        { return (ghosts->GetValue(ptId) & vtkDataSetAttributes::HIDDENPOINT) != 0; });
+  };
+  vtkSMPThreadLocalObject<vtkIdList> localPointIds;
+
+  // Count the output of each block of cells, and the number of faces in each
+  // bucket of the face hash.
+  const vtkIdType numBlocks = (numCells + SurfaceCellBlockSize - 1) / SurfaceCellBlockSize;
+  std::vector<SurfaceCellBlock> blocks(numBlocks);
+  std::unique_ptr<std::atomic<vtkIdType>[]> bucketCounts(new std::atomic<vtkIdType>[numPts]);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType ptId, vtkIdType endPtId)
+    {
+      for (; ptId < endPtId; ++ptId)
+      {
+        bucketCounts[ptId].store(0, std::memory_order_relaxed);
+      }
+    });
+  vtkSMPTools::For(0, numBlocks,
+    [&](vtkIdType blockId, vtkIdType endBlockId)
+    {
+      vtkIdList* pointIds = localPointIds.Local();
+      vtkIdType face[MaxFaceSize];
+      const vtkIdType* pts;
+      vtkIdType npts;
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      for (; blockId < endBlockId; ++blockId)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+        SurfaceCellBlock& block = blocks[blockId];
+        const vtkIdType endCellId = std::min(numCells, (blockId + 1) * SurfaceCellBlockSize);
+        for (vtkIdType cellId = blockId * SurfaceCellBlockSize; cellId < endCellId; ++cellId)
+        {
+          const int cellType = input->GetCellType(cellId);
+          if (cellType == VTK_VERTEX || cellType == VTK_POLY_VERTEX)
+          {
+            // Vertices are extracted even when hidden.
+            block.NumberOfVerts++;
+            block.VertsSize += input->GetCellSize(cellId);
+            continue;
+          }
+          if (cellType == VTK_EMPTY_CELL || isHiddenCell(cellId))
+          {
+            continue;
+          }
+          npts = input->GetCellSize(cellId);
+          switch (cellType)
+          {
+            case VTK_LINE:
+            case VTK_POLY_LINE:
+              block.NumberOfLines++;
+              block.LinesSize += npts;
+              break;
+            case VTK_PIXEL:
+              block.NumberOfPolys++;
+              block.PolysSize += 4;
+              block.PolysUses += 4;
+              break;
+            case VTK_TRIANGLE:
+            case VTK_QUAD:
+            case VTK_POLYGON:
+              block.NumberOfPolys++;
+              block.PolysSize += npts;
+              block.PolysUses += npts;
+              break;
+            case VTK_TRIANGLE_STRIP:
+              if (npts > 1)
+              {
+                block.NumberOfPolys += npts - 2;
+                block.PolysSize += 3 * (npts - 2);
+                block.PolysUses += npts;
+              }
+              break;
+            default:
+            {
+              const FaceDefinitions& faces = *GetFaceDefinitions(cellType);
+              input->GetCellPoints(cellId, npts, pts, pointIds);
+              for (int faceId = 0; faceId < faces.NumberOfFaces; ++faceId)
+              {
+                GetHashedFace(pts, faces, faceId, face);
+                bucketCounts[face[0]].fetch_add(1, std::memory_order_relaxed);
+              }
+            }
+          }
+        }
+      }
+    });
+  this->UpdateProgress(0.2);
+  if (this->CheckAbort())
+  {
+    return 1;
+  }
+
+  // Turn the counts into output locations.
+  SurfaceCellBlock totals;
+  for (SurfaceCellBlock& block : blocks)
+  {
+    std::swap(block.NumberOfVerts, totals.NumberOfVerts);
+    totals.NumberOfVerts += block.NumberOfVerts;
+    std::swap(block.VertsSize, totals.VertsSize);
+    totals.VertsSize += block.VertsSize;
+    std::swap(block.NumberOfLines, totals.NumberOfLines);
+    totals.NumberOfLines += block.NumberOfLines;
+    std::swap(block.LinesSize, totals.LinesSize);
+    totals.LinesSize += block.LinesSize;
+    std::swap(block.NumberOfPolys, totals.NumberOfPolys);
+    totals.NumberOfPolys += block.NumberOfPolys;
+    std::swap(block.PolysSize, totals.PolysSize);
+    totals.PolysSize += block.PolysSize;
+    std::swap(block.PolysUses, totals.PolysUses);
+    totals.PolysUses += block.PolysUses;
+  }
+  std::vector<vtkIdType> bucketOffsets(numPts + 1);
+  vtkSMPTools::Transform(bucketCounts.get(), bucketCounts.get() + numPts, bucketOffsets.begin(),
+    [](const std::atomic<vtkIdType>& count) { return count.load(std::memory_order_relaxed); });
+  bucketOffsets[numPts] = 0;
+  const vtkIdType numFaces = vtkSMPTools::ExclusiveScan(
+    bucketOffsets.begin(), bucketOffsets.end(), bucketOffsets.begin(), vtkIdType(0));
+
+  // Gather the faces in their buckets. A face is recorded by its cell id and
+  // its index in the cell, so sorting a bucket sorts the faces in the order
+  // the sequential implementation inserts them.
+  std::vector<vtkIdType> bucketFaces(numFaces);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType ptId, vtkIdType endPtId)
+    {
+      for (; ptId < endPtId; ++ptId)
+      {
+        bucketCounts[ptId].store(0, std::memory_order_relaxed);
+      }
+    });
+  vtkSMPTools::For(0, numBlocks,
+    [&](vtkIdType blockId, vtkIdType endBlockId)
+    {
+      vtkIdList* pointIds = localPointIds.Local();
+      vtkIdType face[MaxFaceSize];
+      const vtkIdType* pts;
+      vtkIdType npts;
+      const vtkIdType beginCellId = blockId * SurfaceCellBlockSize;
+      const vtkIdType endCellId = std::min(numCells, endBlockId * SurfaceCellBlockSize);
+      for (vtkIdType cellId = beginCellId; cellId < endCellId; ++cellId)
+      {
+        const FaceDefinitions* faces = GetFaceDefinitions(input->GetCellType(cellId));
+        if (!faces || isHiddenCell(cellId))
+        {
+          continue;
+        }
+        input->GetCellPoints(cellId, npts, pts, pointIds);
+        for (int faceId = 0; faceId < faces->NumberOfFaces; ++faceId)
+        {
+          GetHashedFace(pts, *faces, faceId, face);
+          const vtkIdType slot = bucketOffsets[face[0]] +
+            bucketCounts[face[0]].fetch_add(1, std::memory_order_relaxed);
+          bucketFaces[slot] = cellId * MaxNumberOfFaces + faceId;
+        }
+      }
+    });
+  bucketCounts.reset();
+
+  // Resolve each bucket: a face matching a face already in the bucket hides
+  // it, otherwise it is added to the bucket. The remaining faces are output.
+  // Faces that are not output are marked with -1.
+  auto getBucketFace = [&](vtkIdType record, vtkIdList* pointIds, vtkIdType* face)
+  {
+    const vtkIdType cellId = record / MaxNumberOfFaces;
+    const vtkIdType* pts;
+    vtkIdType npts;
+    input->GetCellPoints(cellId, npts, pts, pointIds);
+    return GetHashedFace(pts, *GetFaceDefinitions(input->GetCellType(cellId)),
+      static_cast<int>(record % MaxNumberOfFaces), face);
+  };
+  std::vector<vtkIdType> bucketNumberOfPolys(numPts + 1);
+  std::vector<vtkIdType> bucketPolysSizes(numPts + 1);
+  std::vector<vtkIdType> bucketPolysUses(numPts + 1);
+  vtkSMPThreadLocal<FaceBucketWorkspace> localWorkspaces;
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType ptId, vtkIdType endPtId)
+    {
+      vtkIdList* pointIds = localPointIds.Local();
+      FaceBucketWorkspace& workspace = localWorkspaces.Local();
+      for (; ptId < endPtId; ++ptId)
+      {
+        auto begin = bucketFaces.begin() + bucketOffsets[ptId];
+        auto end = bucketFaces.begin() + bucketOffsets[ptId + 1];
+        std::sort(begin, end);
+        workspace.Points.resize(MaxFaceSize * (end - begin));
+        workspace.Sizes.clear();
+        workspace.Slots.clear();
+        workspace.Hidden.clear();
+        for (auto it = begin; it != end; ++it)
+        {
+          vtkIdType* face = workspace.Points.data() + MaxFaceSize * workspace.Sizes.size();
+          const int size = getBucketFace(*it, pointIds, face);
+          bool matched = false;
+          for (std::size_t i = 0; i < workspace.Sizes.size() && !matched; ++i)
+          {
+            if (workspace.Sizes[i] == size &&
+              MatchHashedFaces(face, workspace.Points.data() + MaxFaceSize * i, size))
+            {
+              workspace.Hidden[i] = true;
+              matched = true;
+            }
+          }
+          if (matched)
+          {
+            *it = -1;
+          }
+          else
+          {
+            workspace.Sizes.push_back(size);
+            workspace.Slots.push_back(it - bucketFaces.begin());
+            workspace.Hidden.push_back(false);
+          }
+        }
+
+        vtkIdType numberOfPolys = 0;
+        vtkIdType polysSize = 0;
+        vtkIdType polysUses = 0;
+        for (std::size_t i = 0; i < workspace.Sizes.size(); ++i)
+        {
+          const int size = workspace.Sizes[i];
+          if (workspace.Hidden[i])
+          {
+            bucketFaces[workspace.Slots[i]] = -1;
+            continue;
+          }
+          // Faces using a hidden point are not output, but their points are
+          // still used like in the sequential implementation.
+          polysUses += size;
+          if (!isHiddenFace(workspace.Points.data() + MaxFaceSize * i, size))
+          {
+            numberOfPolys++;
+            polysSize += size;
+          }
+        }
+        bucketNumberOfPolys[ptId] = numberOfPolys;
+        bucketPolysSizes[ptId] = polysSize;
+        bucketPolysUses[ptId] = polysUses;
+      }
+    });
+  const vtkIdType numFacePolys = vtkSMPTools::ExclusiveScan(bucketNumberOfPolys.begin(),
+    bucketNumberOfPolys.end(), bucketNumberOfPolys.begin(), vtkIdType(0));
+  const vtkIdType facePolysSize = vtkSMPTools::ExclusiveScan(
+    bucketPolysSizes.begin(), bucketPolysSizes.end(), bucketPolysSizes.begin(), vtkIdType(0));
+  vtkSMPTools::ExclusiveScan(
+    bucketPolysUses.begin(), bucketPolysUses.end(), bucketPolysUses.begin(), vtkIdType(0));
+  this->UpdateProgress(0.4);
+  if (this->CheckAbort())
+  {
+    return 1;
+  }
+
+  // Allocate the output cells. Output cells are ordered as vertices, lines,
+  // 2D cells and faces of 3D cells, and so are the point uses.
+  const vtkIdType numPolys = totals.NumberOfPolys + numFacePolys;
+  const vtkIdType numNewCells = totals.NumberOfVerts + totals.NumberOfLines + numPolys;
+  auto allocate = [](vtkIdTypeArray* offsets, vtkIdTypeArray* connectivity,
+                    vtkIdType numberOfCells, vtkIdType size)
+  {
+    offsets->SetNumberOfValues(numberOfCells + 1);
+    offsets->SetValue(numberOfCells, size);
+    connectivity->SetNumberOfValues(size);
+  };
+  vtkNew<vtkIdTypeArray> vertsOffsets, vertsConnectivity;
+  allocate(vertsOffsets, vertsConnectivity, totals.NumberOfVerts, totals.VertsSize);
+  vtkNew<vtkIdTypeArray> linesOffsets, linesConnectivity;
+  allocate(linesOffsets, linesConnectivity, totals.NumberOfLines, totals.LinesSize);
+  vtkNew<vtkIdTypeArray> polysOffsets, polysConnectivity;
+  allocate(polysOffsets, polysConnectivity, numPolys, totals.PolysSize + facePolysSize);
+  std::vector<vtkIdType> cellSources(numNewCells);
+  const vtkIdType firstLine = totals.NumberOfVerts;
+  const vtkIdType firstPoly = firstLine + totals.NumberOfLines;
+  const vtkIdType firstLineUse = totals.VertsSize;
+  const vtkIdType firstPolyUse = firstLineUse + totals.LinesSize;
+  const vtkIdType firstFaceUse = firstPolyUse + totals.PolysUses;
+
+  // Produce the output cells with input point ids, and find the position of
+  // the first use of each point.
+  std::unique_ptr<std::atomic<vtkIdType>[]> firstUses(new std::atomic<vtkIdType>[numPts]);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType ptId, vtkIdType endPtId)
+    {
+      for (; ptId < endPtId; ++ptId)
+      {
+        firstUses[ptId].store(UnusedPosition, std::memory_order_relaxed);
+      }
+    });
+  vtkSMPTools::For(0, numBlocks,
+    [&](vtkIdType blockId, vtkIdType endBlockId)
+    {
+      vtkIdList* pointIds = localPointIds.Local();
+      vtkIdType* vertsOffsetsPtr = vertsOffsets->GetPointer(0);
+      vtkIdType* vertsPtr = vertsConnectivity->GetPointer(0);
+      vtkIdType* linesOffsetsPtr = linesOffsets->GetPointer(0);
+      vtkIdType* linesPtr = linesConnectivity->GetPointer(0);
+      vtkIdType* polysOffsetsPtr = polysOffsets->GetPointer(0);
+      vtkIdType* polysPtr = polysConnectivity->GetPointer(0);
+      const vtkIdType* pts;
+      vtkIdType npts;
+      for (; blockId < endBlockId; ++blockId)
+      {
+        SurfaceCellBlock block = blocks[blockId];
+        const vtkIdType endCellId = std::min(numCells, (blockId + 1) * SurfaceCellBlockSize);
+        for (vtkIdType cellId = blockId * SurfaceCellBlockSize; cellId < endCellId; ++cellId)
+        {
+          const int cellType = input->GetCellType(cellId);
+          if (cellType == VTK_EMPTY_CELL || GetFaceDefinitions(cellType) ||
+            (cellType != VTK_VERTEX && cellType != VTK_POLY_VERTEX && isHiddenCell(cellId)))
+          {
+            continue;
+          }
+          input->GetCellPoints(cellId, npts, pts, pointIds);
+          switch (cellType)
+          {
+            case VTK_VERTEX:
+            case VTK_POLY_VERTEX:
+              vertsOffsetsPtr[block.NumberOfVerts] = block.VertsSize;
+              cellSources[block.NumberOfVerts++] = cellId;
+              for (vtkIdType i = 0; i < npts; ++i)
+              {
+                AtomicMin(firstUses[pts[i]], block.VertsSize);
+                vertsPtr[block.VertsSize++] = pts[i];
+              }
+              break;
+            case VTK_LINE:
+            case VTK_POLY_LINE:
+              linesOffsetsPtr[block.NumberOfLines] = block.LinesSize;
+              cellSources[firstLine + block.NumberOfLines++] = cellId;
+              for (vtkIdType i = 0; i < npts; ++i)
+              {
+                AtomicMin(firstUses[pts[i]], firstLineUse + block.LinesSize);
+                linesPtr[block.LinesSize++] = pts[i];
+              }
+              break;
+            case VTK_PIXEL:
+            {
+              const vtkIdType pixelPts[4] = { pts[0], pts[1], pts[3], pts[2] };
+              polysOffsetsPtr[block.NumberOfPolys] = block.PolysSize;
+              cellSources[firstPoly + block.NumberOfPolys++] = cellId;
+              for (vtkIdType ptId : pixelPts)
+              {
+                AtomicMin(firstUses[ptId], firstPolyUse + block.PolysUses++);
+                polysPtr[block.PolysSize++] = ptId;
+              }
+              break;
+            }
+            case VTK_TRIANGLE:
+            case VTK_QUAD:
+            case VTK_POLYGON:
+              polysOffsetsPtr[block.NumberOfPolys] = block.PolysSize;
+              cellSources[firstPoly + block.NumberOfPolys++] = cellId;
+              for (vtkIdType i = 0; i < npts; ++i)
+              {
+                AtomicMin(firstUses[pts[i]], firstPolyUse + block.PolysUses++);
+                polysPtr[block.PolysSize++] = pts[i];
+              }
+              break;
+            case VTK_TRIANGLE_STRIP:
+            {
+              // Change strips to triangles so we do not have to worry about order.
+              if (npts <= 1)
+              {
+                break;
+              }
+              for (vtkIdType i = 0; i < npts; ++i)
+              {
+                AtomicMin(firstUses[pts[i]], firstPolyUse + block.PolysUses++);
+              }
+              int toggle = 0;
+              vtkIdType ptIds[3] = { pts[0], pts[1], 0 };
+              for (vtkIdType i = 2; i < npts; ++i)
+              {
+                ptIds[2] = pts[i];
+                polysOffsetsPtr[block.NumberOfPolys] = block.PolysSize;
+                cellSources[firstPoly + block.NumberOfPolys++] = cellId;
+                std::copy(ptIds, ptIds + 3, polysPtr + block.PolysSize);
+                block.PolysSize += 3;
+                ptIds[toggle] = ptIds[2];
+                toggle = !toggle;
+              }
+              break;
+            }
+            default:
+              break;
+          }
+        }
+      }
+    });
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType ptId, vtkIdType endPtId)
+    {
+      vtkIdList* pointIds = localPointIds.Local();
+      vtkIdType* polysOffsetsPtr = polysOffsets->GetPointer(0);
+      vtkIdType* polysPtr = polysConnectivity->GetPointer(0);
+      vtkIdType face[MaxFaceSize];
+      for (; ptId < endPtId; ++ptId)
+      {
+        vtkIdType polyId = totals.NumberOfPolys + bucketNumberOfPolys[ptId];
+        vtkIdType polysSize = totals.PolysSize + bucketPolysSizes[ptId];
+        vtkIdType position = firstFaceUse + bucketPolysUses[ptId];
+        for (vtkIdType slot = bucketOffsets[ptId]; slot < bucketOffsets[ptId + 1]; ++slot)
+        {
+          const vtkIdType record = bucketFaces[slot];
+          if (record < 0)
+          {
+            continue;
+          }
+          const int size = getBucketFace(record, pointIds, face);
+          for (int i = 0; i < size; ++i)
+          {
+            AtomicMin(firstUses[face[i]], position++);
+          }
+          if (!isHiddenFace(face, size))
+          {
+            polysOffsetsPtr[polyId] = polysSize;
+            cellSources[firstPoly + polyId++] = record / MaxNumberOfFaces;
+            std::copy(face, face + size, polysPtr + polysSize);
+            polysSize += size;
+          }
+        }
+      }
+    });
+  bucketFaces = std::vector<vtkIdType>();
+  bucketOffsets = std::vector<vtkIdType>();
+  this->UpdateProgress(0.7);
+  if (this->CheckAbort())
+  {
+    return 1;
+  }
+
+  // Number the used points in order of first use, and renumber the output cells.
+  std::vector<vtkIdType> pointMap(numPts + 1);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType ptId, vtkIdType endPtId)
+    {
+      for (; ptId < endPtId; ++ptId)
+      {
+        pointMap[ptId] = firstUses[ptId].load(std::memory_order_relaxed) != UnusedPosition;
+      }
+    });
+  const vtkIdType numNewPts =
+    vtkSMPTools::ExclusiveScan(pointMap.begin(), pointMap.end(), pointMap.begin(), vtkIdType(0));
+  std::vector<vtkIdType> newPtSources(numNewPts);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType ptId, vtkIdType endPtId)
+    {
+      for (; ptId < endPtId; ++ptId)
+      {
+        if (pointMap[ptId + 1] != pointMap[ptId])
+        {
+          newPtSources[pointMap[ptId]] = ptId;
+        }
+      }
+    });
+  vtkSMPTools::Sort(newPtSources.begin(), newPtSources.end(),
+    [&](vtkIdType a, vtkIdType b)
+    {
+      return firstUses[a].load(std::memory_order_relaxed) <
+        firstUses[b].load(std::memory_order_relaxed);
+    });
+  firstUses.reset();
+  vtkSMPTools::For(0, numNewPts,
+    [&](vtkIdType newPtId, vtkIdType endNewPtId)
+    {
+      for (; newPtId < endNewPtId; ++newPtId)
+      {
+        pointMap[newPtSources[newPtId]] = newPtId;
+      }
+    });
+  for (vtkIdTypeArray* connectivity : { vertsConnectivity.Get(), linesConnectivity.Get(),
+         polysConnectivity.Get() })
+  {
+    vtkIdType* ids = connectivity->GetPointer(0);
+    vtkSMPTools::Transform(ids, ids + connectivity->GetNumberOfValues(), ids,
+      [&pointMap](vtkIdType ptId) { return pointMap[ptId]; });
+  }
+
+  // Produce the output points, cells and attributes.
+  vtkNew<vtkPoints> newPts;
+  newPts->SetDataType(input->GetPoints()->GetData()->GetDataType());
+  newPts->SetNumberOfPoints(numNewPts);
+  outputPD->CopyGlobalIdsOn();
+  outputPD->CopyAllocate(inputPD, numNewPts);
+  ArrayList pointArrays;
+  pointArrays.AddArrays(numNewPts, inputPD, outputPD, 0.0, /*promote=*/false);
+  vtkNew<vtkIdTypeArray> originalPointIds;
+  if (this->PassThroughPointIds)
+  {
+    originalPointIds->SetName(this->GetOriginalPointIdsName());
+    originalPointIds->SetNumberOfValues(numNewPts);
+  }
+  vtkSMPTools::For(0, numNewPts,
+    [&](vtkIdType newPtId, vtkIdType endNewPtId)
+    {
+      double x[3];
+      for (; newPtId < endNewPtId; ++newPtId)
+      {
+        const vtkIdType ptId = newPtSources[newPtId];
+        input->GetPoint(ptId, x);
+        newPts->SetPoint(newPtId, x);
+        pointArrays.Copy(ptId, newPtId);
+        if (this->PassThroughPointIds)
+        {
+          originalPointIds->SetValue(newPtId, ptId);
+        }
+      }
+    });
+
+  outputCD->CopyGlobalIdsOn();
+  outputCD->CopyAllocate(inputCD, numNewCells);
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numNewCells, inputCD, outputCD, 0.0, /*promote=*/false);
+  vtkSMPTools::For(0, numNewCells,
+    [&](vtkIdType newCellId, vtkIdType endNewCellId)
+    {
+      for (; newCellId < endNewCellId; ++newCellId)
+      {
+        cellArrays.Copy(cellSources[newCellId], newCellId);
+      }
+    });
+  if (this->PassThroughCellIds)
+  {
+    vtkNew<vtkIdTypeArray> originalCellIds;
+    originalCellIds->SetName(this->GetOriginalCellIdsName());
+    originalCellIds->SetNumberOfValues(numNewCells);
+    std::copy(cellSources.begin(), cellSources.end(), originalCellIds->GetPointer(0));
+    outputCD->AddArray(originalCellIds);
+  }
+  if (this->PassThroughPointIds)
+  {
+    outputPD->AddArray(originalPointIds);
+  }
+
+  output->SetPoints(newPts);
+  vtkNew<vtkCellArray> newPolys;
+  newPolys->SetData(polysOffsets, polysConnectivity);
+  output->SetPolys(newPolys);
+  if (totals.NumberOfVerts > 0)
+  {
+    vtkNew<vtkCellArray> newVerts;
+    newVerts->SetData(vertsOffsets, vertsConnectivity);
+    output->SetVerts(newVerts);
+  }
+  if (totals.NumberOfLines > 0)
+  {
+    vtkNew<vtkCellArray> newLines;
+    newLines->SetData(linesOffsets, linesConnectivity);
+    output->SetLines(newLines);
+  }
+  output->Squeeze();
+
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 void vtkDataSetSurfaceFilter::InitializeQuadHash(vtkIdType numPoints)
 {
@@ -90,6 +90,7 @@ class vtkIdTypeArray;
 class vtkImageData;
 class vtkRectilinearGrid;
 class vtkStructuredGrid;
+class vtkUnstructuredGrid;
 class vtkUnstructuredGridBase;
 
 // Helper structure for hashing faces.
@@ -216,6 +217,22 @@ public:
   vtkBooleanMacro(Delegation, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Use a threaded implementation to extract the surface of unstructured
+   * grids made of linear cells (vertices, lines, 2D cells, tetrahedra,
+   * hexahedra, voxels, wedges, pyramids, pentagonal and hexagonal prisms).
+   * The output is identical to the output of the sequential implementation,
+   * including OriginalCellIds and OriginalPointIds. Other grids, and grids
+   * requiring nonlinear subdivision, are always processed sequentially. Note
+   * that the threaded implementation does not use the face hash methods, so
+   * subclasses overriding them should leave it off. The default is off.
+   */
+  vtkSetMacro(UseThreading, bool);
+  vtkGetMacro(UseThreading, bool);
+  vtkBooleanMacro(UseThreading, bool);
+  ///@}
+
   ///@{
   /**
    * Direct access methods so that this class can be used as an
@@ -364,11 +381,13 @@ protected:
   vtkTypeBool AllowInterpolation;
   vtkTypeBool Delegation;
   bool FastMode;
+  bool UseThreading;
 
 private:
   int UnstructuredGridBaseExecute(vtkDataSet* input, vtkPolyData* output);
   int UnstructuredGridExecuteInternal(
     vtkUnstructuredGridBase* input, vtkPolyData* output, bool handleSubdivision);
+  int ThreadedUnstructuredGridExecute(vtkUnstructuredGrid* input, vtkPolyData* output);
 
   int StructuredExecuteNoBlanking(
     vtkDataSet* input, vtkPolyData* output, vtkIdType* ext, vtkIdType* wholeExt);
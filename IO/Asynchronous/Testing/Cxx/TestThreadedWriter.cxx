@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Write a time series with vtkThreadedWriter while changing the data between
+// writes, and check the files, the completion events and the errors.
+
+#include "vtkCallbackCommand.h"
+#include "vtkCellArray.h"
+#include "vtkExecutive.h"
+#include "vtkFloatArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTestUtilities.h"
+#include "vtkThreadedWriter.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr int NumberOfSteps = 12;
+constexpr vtkIdType NumberOfPoints = 100000;
+
+// Replace the points and the point data of polyData with those of step.
+void SetStep(vtkPolyData* polyData, int step)
+{
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(NumberOfPoints);
+  vtkNew<vtkFloatArray> temperature;
+  temperature->SetName("Temperature");
+  temperature->SetNumberOfTuples(NumberOfPoints);
+  for (vtkIdType ptId = 0; ptId < NumberOfPoints; ++ptId)
+  {
+    points->SetPoint(ptId, ptId, step, 0);
+    temperature->SetValue(ptId, static_cast<float>(step * ptId));
+  }
+  polyData->SetPoints(points);
+  polyData->GetPointData()->SetScalars(temperature);
+}
+
+bool CheckStep(const std::string& fileName, int step)
+{
+  vtkNew<vtkXMLPolyDataReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  vtkPolyData* output = reader->GetOutput();
+  vtkDataArray* temperature = output->GetPointData()->GetArray("Temperature");
+  if (output->GetNumberOfPoints() != NumberOfPoints || output->GetNumberOfVerts() != 1 ||
+    !temperature)
+  {
+    vtkLog(ERROR, "Cannot read " << fileName << ".");
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < NumberOfPoints; ptId += 997)
+  {
+    double x[3];
+    output->GetPoint(ptId, x);
+    if (x[0] != ptId || x[1] != step || temperature->GetTuple1(ptId) != step * ptId)
+    {
+      vtkLog(ERROR, "Wrong point " << ptId << " in " << fileName << ".");
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestThreadedWriter(int argc, char* argv[])
+{
+  char* tempDirCStr =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string tempDir = tempDirCStr;
+  delete[] tempDirCStr;
+
+  vtkNew<vtkThreadedWriter> threadedWriter;
+  threadedWriter->SetMaxThreads(2);
+  threadedWriter->SetMaxNumberOfPendingWrites(3);
+
+  std::vector<vtkIdType> completedIds;
+  vtkNew<vtkCallbackCommand> onCompleted;
+  onCompleted->SetClientData(&completedIds);
+  onCompleted->SetCallback(
+    [](vtkObject*, unsigned long, void* clientData, void* callData)
+    {
+      auto result = static_cast<vtkThreadedWriter::WriteResult*>(callData);
+      if (result->Success)
+      {
+        static_cast<std::vector<vtkIdType>*>(clientData)->push_back(result->Id);
+      }
+    });
+  threadedWriter->AddObserver(vtkThreadedWriter::WriteCompletedEvent, onCompleted);
+
+  // The same data object is changed after each write.
+  vtkNew<vtkPolyData> polyData;
+  vtkNew<vtkCellArray> verts;
+  verts->InsertNextCell(1);
+  verts->InsertCellPoint(0);
+  polyData->SetVerts(verts);
+  std::vector<std::string> fileNames;
+  for (int step = 0; step < NumberOfSteps; ++step)
+  {
+    SetStep(polyData, step);
+    fileNames.push_back(tempDir + "/TestThreadedWriter_" + std::to_string(step) + ".vtp");
+    vtkNew<vtkXMLPolyDataWriter> writer;
+    writer->SetFileName(fileNames.back().c_str());
+    if (threadedWriter->Write(writer, polyData) != step)
+    {
+      vtkLog(ERROR, "Cannot queue step " << step << ".");
+      return EXIT_FAILURE;
+    }
+    if (threadedWriter->GetNumberOfPendingWrites() > 3)
+    {
+      vtkLog(ERROR, "Too many pending writes.");
+      return EXIT_FAILURE;
+    }
+    // Values changed in place are not written when the data is deep copied.
+    if (step == NumberOfSteps - 2)
+    {
+      threadedWriter->DeepCopyOn();
+    }
+    else if (step == NumberOfSteps - 1)
+    {
+      polyData->GetPoints()->SetPoint(0, -1, -1, -1);
+    }
+  }
+
+  if (!threadedWriter->Wait() || threadedWriter->GetNumberOfPendingWrites() != 0 ||
+    threadedWriter->GetNumberOfCompletedWrites() != NumberOfSteps ||
+    threadedWriter->GetNumberOfFailedWrites() != 0 ||
+    static_cast<int>(completedIds.size()) != NumberOfSteps)
+  {
+    vtkLog(ERROR, "Writes did not all complete.");
+    return EXIT_FAILURE;
+  }
+  for (int step = 0; step < NumberOfSteps; ++step)
+  {
+    if (completedIds[step] != step || !CheckStep(fileNames[step], step))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Failures are reported once the write completes.
+  vtkNew<vtkTest::ErrorObserver> writerErrors;
+  vtkNew<vtkTest::ErrorObserver> errors;
+  threadedWriter->AddObserver(vtkCommand::ErrorEvent, errors);
+  vtkNew<vtkXMLPolyDataWriter> writer;
+  writer->AddObserver(vtkCommand::ErrorEvent, writerErrors);
+  writer->GetExecutive()->AddObserver(vtkCommand::ErrorEvent, writerErrors);
+  writer->SetFileName((tempDir + "/NoSuchDirectory/TestThreadedWriter.vtp").c_str());
+  if (threadedWriter->Write(writer, polyData) != NumberOfSteps || threadedWriter->Wait() ||
+    threadedWriter->GetNumberOfFailedWrites() != 1 || !writerErrors->GetError() ||
+    errors->CheckErrorMessage("failed") != 0)
+  {
+    vtkLog(ERROR, "The failed write is not reported.");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,216 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkThreadedWriter.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkErrorCode.h"
+#include "vtkLogger.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreadedTaskQueue.h"
+#include "vtkWriter.h"
+#include "vtkXMLWriterBase.h"
+
+#include <algorithm>
+#include <deque>
+#include <string>
+
+//****************************************************************************
+namespace
+{
+// Run a writer on a worker thread, then release its input.
+bool RunWriter(const vtkSmartPointer<vtkAlgorithm>& writer)
+{
+  vtkLogF(TRACE, "writing with %s", writer->GetClassName());
+  int result = 1;
+  if (auto ioWriter = vtkWriter::SafeDownCast(writer))
+  {
+    result = ioWriter->Write();
+  }
+  else if (auto xmlWriter = vtkXMLWriterBase::SafeDownCast(writer))
+  {
+    result = xmlWriter->Write();
+  }
+  else
+  {
+    // Always write, as vtkWriter::Write() does.
+    writer->Modified();
+    writer->UpdateWholeExtent();
+  }
+  writer->RemoveAllInputs();
+  return result != 0 && writer->GetErrorCode() == vtkErrorCode::NoError;
+}
+}
+
+VTK_ABI_NAMESPACE_BEGIN
+//****************************************************************************
+class vtkThreadedWriter::vtkInternals
+{
+public:
+  using TaskQueueType = vtkThreadedTaskQueue<bool, vtkSmartPointer<vtkAlgorithm>>;
+
+  struct PendingWrite
+  {
+    vtkIdType Id;
+    vtkSmartPointer<vtkAlgorithm> Writer;
+    vtkTypeInt64 MemorySize;
+  };
+
+  // Results are popped in the order of the writes, which is the order of
+  // Pending.
+  std::unique_ptr<TaskQueueType> Queue;
+  int NumberOfThreads = 0;
+  std::deque<PendingWrite> Pending;
+  vtkTypeInt64 PendingMemorySize = 0;
+  vtkIdType NextId = 0;
+};
+
+vtkStandardNewMacro(vtkThreadedWriter);
+//------------------------------------------------------------------------------
+vtkThreadedWriter::vtkThreadedWriter()
+  : Internals(new vtkInternals())
+{
+}
+
+//------------------------------------------------------------------------------
+vtkThreadedWriter::~vtkThreadedWriter()
+{
+  // The workers run the remaining writes before they stop.
+  this->Internals->Queue.reset();
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkThreadedWriter::Write(vtkAlgorithm* writer, vtkDataObject* data)
+{
+  if (writer == nullptr || data == nullptr)
+  {
+    vtkErrorMacro(<< "Write: Please specify a writer and an input!");
+    return -1;
+  }
+
+  auto& internals = *this->Internals;
+  if (std::any_of(internals.Pending.begin(), internals.Pending.end(),
+        [writer](const vtkInternals::PendingWrite& write) { return write.Writer == writer; }))
+  {
+    vtkErrorMacro(<< "Write: " << writer->GetClassName() << " (" << writer
+                  << ") is already writing.");
+    return -1;
+  }
+
+  // Freeze the data: the caller may change it as soon as this returns.
+  vtkSmartPointer<vtkDataObject> copy;
+  copy.TakeReference(data->NewInstance());
+  if (this->DeepCopy)
+  {
+    copy->DeepCopy(data);
+  }
+  else
+  {
+    copy->ShallowCopy(data);
+  }
+  const vtkTypeInt64 memorySize = static_cast<vtkTypeInt64>(copy->GetActualMemorySize());
+
+  // Wait for room in the queue.
+  this->ProcessCompletedWrites();
+  while (!internals.Pending.empty() &&
+    (static_cast<int>(internals.Pending.size()) >= this->MaxNumberOfPendingWrites ||
+      (this->MaxPendingMemorySize > 0 &&
+        internals.PendingMemorySize + memorySize > this->MaxPendingMemorySize)))
+  {
+    this->ProcessOldestWrite(true);
+  }
+
+  if (!internals.Queue || internals.NumberOfThreads != this->MaxThreads)
+  {
+    while (this->ProcessOldestWrite(true))
+    {
+    }
+    internals.Queue.reset();
+    internals.Queue.reset(new vtkInternals::TaskQueueType(::RunWriter,
+      /*strict_ordering=*/true,
+      /*buffer_size=*/-1,
+      /*max_concurrent_tasks=*/this->MaxThreads));
+    internals.NumberOfThreads = this->MaxThreads;
+  }
+
+  writer->SetInputDataObject(copy);
+  const vtkIdType id = internals.NextId++;
+  internals.Pending.push_back({ id, writer, memorySize });
+  internals.PendingMemorySize += memorySize;
+  internals.Queue->Push(vtkSmartPointer<vtkAlgorithm>(writer));
+  return id;
+}
+
+//------------------------------------------------------------------------------
+bool vtkThreadedWriter::ProcessOldestWrite(bool wait)
+{
+  auto& internals = *this->Internals;
+  bool success = false;
+  if (internals.Pending.empty() ||
+    !(wait ? internals.Queue->Pop(success) : internals.Queue->TryPop(success)))
+  {
+    return false;
+  }
+
+  const vtkInternals::PendingWrite write = std::move(internals.Pending.front());
+  internals.Pending.pop_front();
+  internals.PendingMemorySize -= write.MemorySize;
+  ++this->NumberOfCompletedWrites;
+  if (!success)
+  {
+    ++this->NumberOfFailedWrites;
+    const unsigned long errorCode = write.Writer->GetErrorCode();
+    vtkErrorMacro(<< "Write " << write.Id << " with " << write.Writer->GetClassName()
+                  << " failed"
+                  << (errorCode != vtkErrorCode::NoError
+                         ? std::string(": ") + vtkErrorCode::GetStringFromErrorCode(errorCode)
+                         : std::string())
+                  << ".");
+  }
+
+  WriteResult result{ write.Id, write.Writer, success };
+  this->InvokeEvent(WriteCompletedEvent, &result);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+int vtkThreadedWriter::ProcessCompletedWrites()
+{
+  int count = 0;
+  while (this->ProcessOldestWrite(false))
+  {
+    ++count;
+  }
+  return count;
+}
+
+//------------------------------------------------------------------------------
+bool vtkThreadedWriter::Wait()
+{
+  const vtkIdType numberOfFailedWrites = this->NumberOfFailedWrites;
+  while (this->ProcessOldestWrite(true))
+  {
+  }
+  return this->NumberOfFailedWrites == numberOfFailedWrites;
+}
+
+//------------------------------------------------------------------------------
+int vtkThreadedWriter::GetNumberOfPendingWrites() const
+{
+  return static_cast<int>(this->Internals->Pending.size());
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MaxThreads: " << this->MaxThreads << "\n";
+  os << indent << "MaxNumberOfPendingWrites: " << this->MaxNumberOfPendingWrites << "\n";
+  os << indent << "MaxPendingMemorySize: " << this->MaxPendingMemorySize << "\n";
+  os << indent << "DeepCopy: " << (this->DeepCopy ? "On" : "Off") << "\n";
+  os << indent << "NumberOfPendingWrites: " << this->GetNumberOfPendingWrites() << "\n";
+  os << indent << "NumberOfCompletedWrites: " << this->NumberOfCompletedWrites << "\n";
+  os << indent << "NumberOfFailedWrites: " << this->NumberOfFailedWrites << "\n";
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,176 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class    vtkThreadedWriter
+ * @brief    write data objects with any writer on background threads
+ *
+ * vtkThreadedWriter runs writers on background threads so that the caller,
+ * typically a simulation producing in situ output, does not wait for its data
+ * to be written. It generalizes vtkThreadedImageWriter to any vtkDataObject
+ * and any writer: vtkWriter subclasses such as vtkHDFWriter, the XML writers,
+ * which derive from vtkXMLWriterBase, or any other algorithm that writes its
+ * input when updated.
+ *
+ * `Write()` takes a writer that is ready to write, with its file name and
+ * options set, and the data to write. The data is frozen by a shallow copy of
+ * its structure, so the caller may modify the data object or replace its
+ * arrays, but must not modify the values of its arrays in place until the
+ * write completes, unless `DeepCopy` is on. The writer belongs to the
+ * vtkThreadedWriter until its write completes: it must not be modified, nor
+ * given to `Write()` again, until then.
+ *
+ * Writes are queued and run in order by up to `MaxThreads` threads. The
+ * number of writes and the memory they hold are bounded by
+ * `MaxNumberOfPendingWrites` and `MaxPendingMemorySize`: `Write()` blocks
+ * until enough earlier writes complete.
+ *
+ * Completed writes are reported in order, on the calling thread, by `Write()`,
+ * `ProcessCompletedWrites()` and `Wait()`. `WriteCompletedEvent` is invoked
+ * for each of them with a `vtkThreadedWriter::WriteResult` as call data, and
+ * failures are also reported as errors. Writes still pending when the
+ * vtkThreadedWriter is destroyed complete, but are not reported.
+ *
+ * @warning
+ * With more than one thread, several writers run at the same time. Writers
+ * using a library that is not thread-safe, such as vtkHDFWriter with an HDF5
+ * library built without thread safety, must use a single thread, the default.
+ *
+ * @sa
+ * vtkThreadedImageWriter vtkThreadedTaskQueue
+ */
+
+#ifndef vtkThreadedWriter_h
+#define vtkThreadedWriter_h
+
+#include "vtkCommand.h"              // For vtkCommand::UserEvent
+#include "vtkIOAsynchronousModule.h" // For export macro
+#include "vtkObject.h"
+
+#include <memory> // For std::unique_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkAlgorithm;
+class vtkDataObject;
+
+class VTKIOASYNCHRONOUS_EXPORT vtkThreadedWriter : public vtkObject
+{
+public:
+  static vtkThreadedWriter* New();
+  vtkTypeMacro(vtkThreadedWriter, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Event invoked for each completed write, with a pointer to its
+   * WriteResult as call data.
+   */
+  enum
+  {
+    WriteCompletedEvent = vtkCommand::UserEvent + 300
+  };
+
+#ifndef __VTK_WRAP__
+  /**
+   * Outcome of a write.
+   */
+  struct WriteResult
+  {
+    vtkIdType Id;         // as returned by Write()
+    vtkAlgorithm* Writer; // may be used again
+    bool Success;
+  };
+#endif
+
+  /**
+   * Queue the write of data by writer, and return its id, or -1 if the write
+   * cannot be queued. Ids start at 0 and follow the order of the calls.
+   * This blocks while too many writes are pending.
+   */
+  vtkIdType Write(vtkAlgorithm* writer, vtkDataObject* data);
+
+  /**
+   * Report the writes completed since the last call, without waiting.
+   * Returns the number of writes reported.
+   */
+  int ProcessCompletedWrites();
+
+  /**
+   * Wait for all the queued writes to complete, and report them.
+   * Returns false if one of the writes reported by this call failed.
+   */
+  bool Wait();
+
+  /**
+   * Get the number of writes that are queued or running.
+   */
+  int GetNumberOfPendingWrites() const;
+
+  /**
+   * Get the number of writes reported as completed, and as failed.
+   */
+  vtkGetMacro(NumberOfCompletedWrites, vtkIdType);
+  vtkGetMacro(NumberOfFailedWrites, vtkIdType);
+
+  ///@{
+  /**
+   * Set/Get the number of threads that run the writers. After a change, the
+   * next `Write()` first waits for the pending writes. The default is 1.
+   */
+  vtkSetClampMacro(MaxThreads, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaxThreads, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the number of writes that can be pending before `Write()`
+   * blocks. The default is 4.
+   */
+  vtkSetClampMacro(MaxNumberOfPendingWrites, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaxNumberOfPendingWrites, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the memory held by pending writes, in kibibytes, beyond which
+   * `Write()` blocks, as given by vtkDataObject::GetActualMemorySize().
+   * A write larger than this is still queued once no other write is pending.
+   * 0, the default, means no limit.
+   */
+  vtkSetMacro(MaxPendingMemorySize, vtkTypeInt64);
+  vtkGetMacro(MaxPendingMemorySize, vtkTypeInt64);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get whether the data is deep copied by `Write()`, so that the caller
+   * may modify its arrays in place right away. The default is off.
+   */
+  vtkSetMacro(DeepCopy, bool);
+  vtkGetMacro(DeepCopy, bool);
+  vtkBooleanMacro(DeepCopy, bool);
+  ///@}
+
+protected:
+  vtkThreadedWriter();
+  ~vtkThreadedWriter() override;
+
+private:
+  vtkThreadedWriter(const vtkThreadedWriter&) = delete;
+  void operator=(const vtkThreadedWriter&) = delete;
+
+  // Report the oldest pending write, waiting for it to complete if wait is
+  // true. Returns false if it is not complete.
+  bool ProcessOldestWrite(bool wait);
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+
+  int MaxThreads = 1;
+  int MaxNumberOfPendingWrites = 4;
+  vtkTypeInt64 MaxPendingMemorySize = 0;
+  bool DeepCopy = false;
+  vtkIdType NumberOfCompletedWrites = 0;
+  vtkIdType NumberOfFailedWrites = 0;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -16,6 +16,14 @@
  * should be implemented with this in mind to provide a predictable
  * compressor interface for vtkDataCompressor users.
  *
+ * @par Thread safety:
+ * The XML readers and writers call Uncompress and Compress concurrently on
+ * the same compressor to process several blocks at once, so UncompressBuffer
+ * and CompressBuffer must not modify the state of the compressor.
+ * Compressors that cannot meet this requirement must be used with
+ * vtkXMLReader::UseThreadedDecompressionOff() and
+ * vtkXMLWriterBase::UseThreadedCompressionOff().
+ *
  * @par Thanks:
  * Homogeneous CompressionLevel behavior contributed by Quincy Wofford
  * (qwofford@lanl.gov) and John Patchett (patchett@lanl.gov)
@@ -49,7 +57,8 @@ public:
    * Compress the given input data buffer into the given output
    * buffer.  The size of the output buffer must be at least as large
    * as the value given by GetMaximumCompressionSpace for the given
-   * input size.
+   * input size.  vtkXMLWriter calls this method concurrently to
+   * compress several blocks at once, see the thread safety note above.
    */
   size_t Compress(unsigned char const* uncompressedData, size_t uncompressedSize,
     unsigned char* compressedData, size_t compressionSpace);
@@ -58,7 +67,9 @@ public:
    * Uncompress the given input data into the given output buffer.
    * The size of the uncompressed data must be known by the caller.
    * It should be transmitted from the compressor by a means outside
-   * of this class.
+   * of this class.  vtkXMLDataParser calls this method concurrently
+   * to decompress several blocks at once, see the thread safety note
+   * above.
    */
   size_t Uncompress(unsigned char const* compressedData, size_t compressedSize,
     unsigned char* uncompressedData, size_t uncompressedSize);
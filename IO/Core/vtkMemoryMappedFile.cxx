@@ -0,0 +1,238 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkMemoryMappedFile.h"
+
+#include "vtkObjectFactory.h"
+
+#include <mutex>
+#include <unordered_map>
+
+#if defined(_WIN32)
+#include <vtksys/Encoding.hxx>
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+struct Mapping
+{
+  void* Base = nullptr;
+  size_t Length = 0;
+};
+
+// The mappings of the regions given by MapRegion, by address of the region,
+// for FreeRegion to find what to unmap.
+std::mutex& GetRegionsMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::unordered_map<void*, Mapping>& GetRegions()
+{
+  static std::unordered_map<void*, Mapping> regions;
+  return regions;
+}
+
+// Map size bytes of the file from position, or up to the end of the file if
+// wholeFile is true, in which case size is set to the number of bytes mapped.
+// Mappings start on a boundary given by the system, so the mapping may start
+// before position.  Sets data to the address of position in the mapping, or
+// to nullptr if there is nothing to map.  Returns false on error.
+bool MapFile(const char* fileName, vtkTypeInt64 position, size_t& size, bool wholeFile,
+  Mapping& mapping, unsigned char*& data)
+{
+  data = nullptr;
+  if (!fileName || position < 0)
+  {
+    return false;
+  }
+
+#if defined(_WIN32)
+  HANDLE file = CreateFileW(vtksys::Encoding::ToWindowsExtendedPath(fileName).c_str(),
+    GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    return false;
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize))
+  {
+    CloseHandle(file);
+    return false;
+  }
+  const vtkTypeInt64 available = static_cast<vtkTypeInt64>(fileSize.QuadPart) - position;
+#else
+  const int file = open(fileName, O_RDONLY);
+  if (file < 0)
+  {
+    return false;
+  }
+  struct stat status;
+  if (fstat(file, &status) != 0)
+  {
+    close(file);
+    return false;
+  }
+  const vtkTypeInt64 available = static_cast<vtkTypeInt64>(status.st_size) - position;
+#endif
+
+  if (wholeFile && available >= 0)
+  {
+    size = static_cast<size_t>(available);
+  }
+  // Accessing mapped pages past the end of the file is an error, not a read
+  // of zeros, so the region must be in the file.
+  bool success = available >= 0 && static_cast<vtkTypeInt64>(size) <= available;
+  if (success && size > 0)
+  {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const vtkTypeInt64 start = position - position % info.dwAllocationGranularity;
+    mapping.Length = static_cast<size_t>(position - start) + size;
+    // The view keeps the file mapping, and the file, open until it is unmapped.
+    HANDLE fileMapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (fileMapping)
+    {
+      mapping.Base = MapViewOfFile(fileMapping, FILE_MAP_COPY, static_cast<DWORD>(start >> 32),
+        static_cast<DWORD>(start & 0xFFFFFFFF), mapping.Length);
+      CloseHandle(fileMapping);
+    }
+#else
+    const vtkTypeInt64 pageSize = static_cast<vtkTypeInt64>(sysconf(_SC_PAGESIZE));
+    const vtkTypeInt64 start = position - position % pageSize;
+    mapping.Length = static_cast<size_t>(position - start) + size;
+    mapping.Base = mmap(nullptr, mapping.Length, PROT_READ | PROT_WRITE, MAP_PRIVATE, file,
+      static_cast<off_t>(start));
+    if (mapping.Base == MAP_FAILED)
+    {
+      mapping.Base = nullptr;
+    }
+#endif
+    if (mapping.Base)
+    {
+      data = static_cast<unsigned char*>(mapping.Base) + (position - start);
+    }
+    success = data != nullptr;
+  }
+
+#if defined(_WIN32)
+  CloseHandle(file);
+#else
+  close(file);
+#endif
+  return success;
+}
+
+void UnmapFile(const Mapping& mapping)
+{
+#if defined(_WIN32)
+  UnmapViewOfFile(mapping.Base);
+#else
+  munmap(mapping.Base, mapping.Length);
+#endif
+}
+}
+
+vtkStandardNewMacro(vtkMemoryMappedFile);
+
+//------------------------------------------------------------------------------
+vtkMemoryMappedFile::vtkMemoryMappedFile() = default;
+
+//------------------------------------------------------------------------------
+vtkMemoryMappedFile::~vtkMemoryMappedFile()
+{
+  this->Close();
+}
+
+//------------------------------------------------------------------------------
+void vtkMemoryMappedFile::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Opened: " << this->Opened << endl;
+  os << indent << "Size: " << this->Size << endl;
+}
+
+//------------------------------------------------------------------------------
+bool vtkMemoryMappedFile::Open(VTK_FILEPATH const char* fileName)
+{
+  this->Close();
+
+  size_t size = 0;
+  Mapping mapping;
+  unsigned char* data = nullptr;
+  if (!MapFile(fileName, 0, size, true, mapping, data))
+  {
+    return false;
+  }
+
+  this->Data = data;
+  this->Size = size;
+  this->Opened = true;
+  this->Modified();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkMemoryMappedFile::Close()
+{
+  if (!this->Opened)
+  {
+    return;
+  }
+  if (this->Data)
+  {
+    Mapping mapping;
+    mapping.Base = this->Data;
+    mapping.Length = this->Size;
+    UnmapFile(mapping);
+  }
+  this->Data = nullptr;
+  this->Size = 0;
+  this->Opened = false;
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void* vtkMemoryMappedFile::MapRegion(
+  VTK_FILEPATH const char* fileName, vtkTypeInt64 position, size_t size)
+{
+  Mapping mapping;
+  unsigned char* data = nullptr;
+  if (!MapFile(fileName, position, size, false, mapping, data) || !data)
+  {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(GetRegionsMutex());
+  GetRegions()[data] = mapping;
+  return data;
+}
+
+//------------------------------------------------------------------------------
+void vtkMemoryMappedFile::FreeRegion(void* region)
+{
+  Mapping mapping;
+  {
+    std::lock_guard<std::mutex> lock(GetRegionsMutex());
+    auto it = GetRegions().find(region);
+    if (it == GetRegions().end())
+    {
+      return;
+    }
+    mapping = it->second;
+    GetRegions().erase(it);
+  }
+  UnmapFile(mapping);
+}
+VTK_ABI_NAMESPACE_END
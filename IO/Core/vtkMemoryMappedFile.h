@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkMemoryMappedFile
+ * @brief   Map the content of a file in memory.
+ *
+ * vtkMemoryMappedFile maps a whole file in memory, so that readers can parse
+ * it in place instead of reading it through a stream, and maps regions of
+ * files for data arrays to use them without copy, see MapRegion.
+ *
+ * The mappings are private and copy-on-write: their pages are shared with the
+ * page cache, and with the other processes mapping the same file, until they
+ * are modified, and modifications are never written back to the file.  The
+ * file must not be truncated while it is mapped.
+ *
+ * @sa
+ * vtkFileResourceStream
+ */
+
+#ifndef vtkMemoryMappedFile_h
+#define vtkMemoryMappedFile_h
+
+#include "vtkIOCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKIOCORE_EXPORT vtkMemoryMappedFile : public vtkObject
+{
+public:
+  static vtkMemoryMappedFile* New();
+  vtkTypeMacro(vtkMemoryMappedFile, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Map the whole content of the given file, after unmapping the file
+   * mapped before, if any.  Returns false if the file cannot be mapped.
+   */
+  bool Open(VTK_FILEPATH const char* fileName);
+
+  /**
+   * Unmap the file.
+   */
+  void Close();
+
+  /**
+   * Return true if a file is mapped.
+   */
+  bool IsOpen() const { return this->Opened; }
+
+  ///@{
+  /**
+   * Get the content of the mapped file, and its size in bytes.  The data is
+   * nullptr if no file is mapped, or if the file is empty.
+   */
+  const unsigned char* GetData() const { return this->Data; }
+  size_t GetSize() const { return this->Size; }
+  ///@}
+
+  /**
+   * Map the given number of bytes of a file, from the given position, on
+   * their own, and return their address, or nullptr if they cannot be mapped.
+   * The region stays mapped until it is given to FreeRegion, which is meant
+   * to be the free function of the data array using it:
+   *
+   * \code
+   * array->SetVoidArray(region, numberOfValues, 0, vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+   * array->SetArrayFreeFunction(vtkMemoryMappedFile::FreeRegion);
+   * \endcode
+   *
+   * The region is only aligned on the alignment of the position in the file.
+   */
+  static void* MapRegion(VTK_FILEPATH const char* fileName, vtkTypeInt64 position, size_t size);
+
+  /**
+   * Unmap a region mapped by MapRegion.
+   */
+  static void FreeRegion(void* region);
+
+protected:
+  vtkMemoryMappedFile();
+  ~vtkMemoryMappedFile() override;
+
+private:
+  vtkMemoryMappedFile(const vtkMemoryMappedFile&) = delete;
+  void operator=(const vtkMemoryMappedFile&) = delete;
+
+  unsigned char* Data = nullptr;
+  size_t Size = 0;
+  bool Opened = false;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -0,0 +1,186 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that vtkOBJReader gives the same output when files are mapped in
+// memory or read from memory streams, which are parsed concurrently, and when
+// they are read from file streams.
+
+#include "vtkCellArray.h"
+#include "vtkCommand.h"
+#include "vtkFileResourceStream.h"
+#include "vtkLogger.h"
+#include "vtkMemoryResourceStream.h"
+#include "vtkNew.h"
+#include "vtkOBJReader.h"
+#include "vtkPolyData.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTestUtilities.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+bool CompareReaders(vtkOBJReader* expected, vtkOBJReader* actual, const std::string& name)
+{
+  const std::string expectedComment = expected->GetComment() ? expected->GetComment() : "";
+  const std::string actualComment = actual->GetComment() ? actual->GetComment() : "";
+  if (expectedComment != actualComment)
+  {
+    vtkLog(ERROR, "The comment differs with " << name << ".");
+    return false;
+  }
+  if (!vtkTestUtilities::CompareDataObjects(expected->GetOutput(), actual->GetOutput()))
+  {
+    vtkLog(ERROR, "The output differs with " << name << ".");
+    return false;
+  }
+  return true;
+}
+
+// Write content to a file, and compare its reading from a file stream with
+// its reading as a mapped file and from a memory stream. Warnings are
+// expected if warning is set.
+bool TestContent(
+  const std::string& tempDir, const std::string& name, const std::string& content, bool warning)
+{
+  const std::string fileName = tempDir + "/TestOBJReaderParallel" + name + ".obj";
+  {
+    std::ofstream file(fileName, std::ios::binary);
+    file << content;
+  }
+
+  vtkNew<vtkTest::ErrorObserver> expectedObserver;
+  vtkNew<vtkFileResourceStream> fileStream;
+  fileStream->Open(fileName.c_str());
+  vtkNew<vtkOBJReader> expected;
+  expected->AddObserver(vtkCommand::WarningEvent, expectedObserver);
+  expected->SetStream(fileStream);
+  expected->Update();
+  if (expected->GetOutput()->GetNumberOfCells() == 0 ||
+    expectedObserver->GetWarning() != warning)
+  {
+    vtkLog(ERROR, "Unexpected reading of " << name << ".");
+    return false;
+  }
+
+  vtkNew<vtkTest::ErrorObserver> observer;
+  vtkNew<vtkOBJReader> reader;
+  reader->AddObserver(vtkCommand::WarningEvent, observer);
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  if (!CompareReaders(expected, reader, name + " from the file name"))
+  {
+    return false;
+  }
+
+  vtkNew<vtkMemoryResourceStream> memoryStream;
+  memoryStream->SetBuffer(content.data(), content.size());
+  reader->SetFileName(nullptr);
+  reader->SetStream(memoryStream);
+  reader->Update();
+  if (!CompareReaders(expected, reader, name + " from a memory stream"))
+  {
+    return false;
+  }
+  if (observer->GetWarning() != warning)
+  {
+    vtkLog(ERROR, "The warnings differ with " << name << ".");
+    return false;
+  }
+  return true;
+}
+
+// Each kind of record, with relative indices, materials and groups.
+const char* const RECORDS = R"(# first comment
+#second line
+  #   third line
+
+# not part of the comment
+mtllib first.mtl
+v 0 0 0
+v 1 0 0 1
+v 1 1 0
+v 0 1 0
+vt 0 0
+vt 1 0 0
+vt 1 1
+vt 0 1
+vn 0 0 1
+f 1//1 2//1 3//1
+usemtl red
+g top
+f 1/1/1 2/2/1 3/3/1 4/4/1
+f -4//-1 -3//-1 -2//-1
+usemtl blue
+f 1/1/1 -3/-3/-1 3/3/1
+unknown command
+g
+usemtl red
+mtllib second.mtl
+f 1/4/1 2/3/1 \
+  3/2/1
+p 1 -1 \
+2
+l 1/1 2/2 -1
+l 1 2 3 4
+)";
+
+// Faces before the first group, and tcoords before the first material.
+const char* const DEFAULT_TCOORDS = "v 0 0 0\r\nv 1 0 0\r\nv 1 1 0\r\nvt 0 0\r\nvt 1 0\r\n"
+                                    "vt 1 1\r\nf 1/1 2/2 3/3\r\ng\r\nf 3/3 2/2 1/1\r\n"
+                                    "usemtl red\r\nf 1/3 2/2 3/1\r\n";
+
+// Many chunks of quads with relative indices, changing materials and groups.
+std::string LargeContent()
+{
+  std::ostringstream content;
+  content << "# large file\n";
+  for (int i = 0; i < 30000; ++i)
+  {
+    if (i % 1000 == 0)
+    {
+      content << "usemtl material" << (i / 1000) % 3 << "\n";
+    }
+    if (i % 700 == 0)
+    {
+      content << "g group" << i / 700 << "\n";
+    }
+    content << "v " << i << " 0 0\nv " << i << " 1 0\nv " << i << " 1 1\nv " << i << " 0 1\n";
+    content << "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\nvn " << i % 7 << " 0 1\n";
+    if (i % 2)
+    {
+      content << "f -4/-4/-1 -3/-3/-1 -2/-2/-1 -1/-1/-1\n";
+    }
+    else
+    {
+      content << "f " << 4 * i + 1 << "/" << 4 * i + 1 << "/" << i + 1 << " " << 4 * i + 2 << "/"
+              << 4 * i + 2 << "/" << i + 1 << " " << 4 * i + 3 << "/" << 4 * i + 3 << "/" << i + 1
+              << "\n";
+    }
+    if (i % 100 == 0)
+    {
+      content << "l -4 -3 -2\np -1\n";
+    }
+  }
+  return content.str();
+}
+}
+
+int TestOBJReaderParallel(int argc, char* argv[])
+{
+  char* tempDirCStr =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string tempDir = tempDirCStr;
+  delete[] tempDirCStr;
+
+  bool success = TestContent(tempDir, "Records", RECORDS, false);
+  success &= TestContent(tempDir, "DefaultTCoords", DEFAULT_TCOORDS, false);
+  success &= TestContent(tempDir, "Large", LargeContent(), false);
+  // Read by the serial parser, with a leading '+' and an unexpected value
+  success &= TestContent(tempDir, "Plus", "v 0 0 0\nv 1 0 0\nv 1 1 0\nf +1 +2 +3\n", false);
+  success &= TestContent(tempDir, "Warning", "v 0 0 0\nv 1 0 0 1 1\nv 1 1 0\nf 1 2 3\n", true);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,238 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that vtkSTLReader gives the same output when files are mapped in
+// memory, read from memory or file streams, and when points are merged
+// concurrently or with a vtkMergePoints.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkFileResourceStream.h"
+#include "vtkLogger.h"
+#include "vtkMemoryResourceStream.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSTLReader.h"
+#include "vtkSTLWriter.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace
+{
+bool ComparePolyData(vtkPolyData* expected, vtkPolyData* actual, const std::string& name)
+{
+  if (!vtkTestUtilities::CompareDataObjects(expected, actual))
+  {
+    vtkLog(ERROR, "The output differs with " << name << ".");
+    return false;
+  }
+  return true;
+}
+
+// Read fileName as a mapped file, a file stream and a memory stream, merging
+// points or not, and compare with vtkMergePoints.
+bool TestFile(const std::string& fileName, bool scalarTags)
+{
+  std::ifstream file(fileName, std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  for (bool merging : { true, false })
+  {
+    const std::string name = fileName + (merging ? " merged" : " not merged");
+    vtkNew<vtkSTLReader> expectedReader;
+    expectedReader->SetFileName(fileName.c_str());
+    expectedReader->SetMerging(merging);
+    expectedReader->SetScalarTags(scalarTags);
+    vtkNew<vtkMergePoints> locator;
+    expectedReader->SetLocator(locator);
+    expectedReader->Update();
+    vtkPolyData* expected = expectedReader->GetOutput();
+    if (expected->GetNumberOfCells() == 0)
+    {
+      vtkLog(ERROR, "Cannot read " << fileName << ".");
+      return false;
+    }
+
+    vtkNew<vtkSTLReader> reader;
+    reader->SetMerging(merging);
+    reader->SetScalarTags(scalarTags);
+    reader->SetFileName(fileName.c_str());
+    reader->Update();
+    if (!ComparePolyData(expected, reader->GetOutput(), name + " from the file name"))
+    {
+      return false;
+    }
+
+    vtkNew<vtkFileResourceStream> fileStream;
+    fileStream->Open(fileName.c_str());
+    reader->SetStream(fileStream);
+    reader->Update();
+    if (!ComparePolyData(expected, reader->GetOutput(), name + " from a file stream"))
+    {
+      return false;
+    }
+
+    vtkNew<vtkMemoryResourceStream> memoryStream;
+    memoryStream->SetBuffer(content.data(), content.size());
+    reader->SetStream(memoryStream);
+    reader->Update();
+    if (!ComparePolyData(expected, reader->GetOutput(), name + " from a memory stream"))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestSphere(const std::string& tempDir)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(120);
+  sphere->SetPhiResolution(60);
+  sphere->Update();
+
+  // Add a triangle that is degenerate once its points are merged.
+  vtkNew<vtkPolyData> input;
+  input->DeepCopy(sphere->GetOutput());
+  const vtkIdType ptId = input->GetPoints()->InsertNextPoint(0.1, 0.2, 0.3);
+  input->GetPoints()->InsertNextPoint(0.1, 0.2, 0.3);
+  input->GetPoints()->InsertNextPoint(0.3, 0.2, 0.1);
+  const vtkIdType degenerate[3] = { ptId, ptId + 1, ptId + 2 };
+  input->GetPolys()->InsertNextCell(3, degenerate);
+
+  bool success = true;
+  for (bool binary : { true, false })
+  {
+    const std::string fileName =
+      tempDir + (binary ? "/TestSTLReaderParallelBinary.stl" : "/TestSTLReaderParallelASCII.stl");
+    vtkNew<vtkSTLWriter> writer;
+    writer->SetInputData(input);
+    writer->SetFileName(fileName.c_str());
+    writer->SetFileType(binary ? VTK_BINARY : VTK_ASCII);
+    writer->Write();
+    success &= TestFile(fileName, false);
+
+    vtkNew<vtkSTLReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->Update();
+    if (reader->GetOutput()->GetNumberOfPoints() != input->GetNumberOfPoints() - 1 ||
+      reader->GetOutput()->GetNumberOfCells() != sphere->GetOutput()->GetNumberOfCells())
+    {
+      vtkLog(ERROR, "Points of " << fileName << " are not merged.");
+      success = false;
+    }
+  }
+  return success;
+}
+
+bool TestSolids(const std::string& tempDir)
+{
+  // Several solids, with keywords in any case, and all kinds of line endings.
+  const std::string fileName = tempDir + "/TestSTLReaderParallelSolids.stl";
+  {
+    std::ofstream file(fileName, std::ios::binary);
+    file << "solid first\r\n"
+            "  facet normal 0 0 1\r\n"
+            "    outer loop\r\n"
+            "      vertex 0 0 0\r\n"
+            "      vertex 1 0 0\r\n"
+            "      vertex 0 1 0\r\n"
+            "    endloop\r\n"
+            "  endfacet\r\n"
+            "endsolid first\r"
+            "SOLID second\n"
+            "\n"
+            "  FACET NORMAL 0 0 1\n"
+            "    OUTER LOOP\n"
+            "      VERTEX 1 0 0\n"
+            "      VERTEX 1 1 0\n"
+            "      VERTEX 0 1e0 0\n"
+            "    ENDLOOP\n"
+            "  ENDFACET\n"
+            "ENDSOLID second";
+  }
+  if (!TestFile(fileName, true))
+  {
+    return false;
+  }
+
+  vtkNew<vtkSTLReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->ScalarTagsOn();
+  reader->Update();
+  vtkPolyData* output = reader->GetOutput();
+  vtkDataArray* tags = output->GetCellData()->GetScalars();
+  if (output->GetNumberOfPoints() != 4 || output->GetNumberOfCells() != 2 || !tags ||
+    tags->GetTuple1(0) != 0 || tags->GetTuple1(1) != 1 ||
+    std::string(reader->GetHeader()) != "first\nsecond")
+  {
+    vtkLog(ERROR, "Wrong solids in " << fileName << ".");
+    return false;
+  }
+  return true;
+}
+
+bool TestInvalidVertex(const std::string& tempDir)
+{
+  // What precedes an invalid vertex is read when conformance is not relaxed.
+  const std::string fileName = tempDir + "/TestSTLReaderParallelInvalid.stl";
+  {
+    std::ofstream file(fileName, std::ios::binary);
+    file << "solid\n";
+    for (int i = 0; i < 1000; ++i)
+    {
+      file << "facet normal 0 0 1\nouter loop\n";
+      file << "vertex " << i << " 0 0\nvertex " << i << " 1 0\n";
+      file << (i == 600 ? "vertex 0 x 0\n" : "vertex 0 0 1\n");
+      file << "endloop\nendfacet\n";
+    }
+    file << "endsolid\n";
+  }
+
+  for (bool merging : { true, false })
+  {
+    vtkNew<vtkSTLReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->RelaxedConformanceOff();
+    reader->SetMerging(merging);
+    reader->Update();
+
+    vtkNew<vtkFileResourceStream> fileStream;
+    fileStream->Open(fileName.c_str());
+    vtkNew<vtkSTLReader> streamReader;
+    streamReader->SetStream(fileStream);
+    streamReader->RelaxedConformanceOff();
+    streamReader->SetMerging(merging);
+    streamReader->Update();
+
+    if (reader->GetOutput()->GetNumberOfCells() != 600 ||
+      !ComparePolyData(streamReader->GetOutput(), reader->GetOutput(), "an invalid vertex"))
+    {
+      vtkLog(ERROR, "Wrong triangles before an invalid vertex.");
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestSTLReaderParallel(int argc, char* argv[])
+{
+  char* tempDirCStr =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string tempDir = tempDirCStr;
+  delete[] tempDirCStr;
+
+  bool success = TestSphere(tempDir);
+  success &= TestSolids(tempDir);
+  success &= TestInvalidVertex(tempDir);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
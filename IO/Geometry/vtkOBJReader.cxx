@@ -4,19 +4,30 @@
 
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkDoubleArray.h"
 #include "vtkFileResourceStream.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMemoryMappedFile.h"
+#include "vtkMemoryResourceStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkResourceParser.h"
+#include "vtkSMPTools.h"
 #include "vtkStringArray.h"
+#include "vtkStringScanner.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cctype>
 #include <sstream>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkOBJReader);
@@ -34,7 +45,7 @@ vtkOBJReader::~vtkOBJReader()
 }
 
 //------------------------------------------------------------------------------
-vtkSmartPointer<vtkResourceStream> vtkOBJReader::Open()
+vtkSmartPointer<vtkResourceStream> vtkOBJReader::Open(vtkMemoryMappedFile* mappedFile)
 {
   if (this->Stream)
   {
@@ -46,6 +57,14 @@ vtkSmartPointer<vtkResourceStream> vtkOBJReader::Open()
     return this->Stream;
   }
 
+  // Files mapped in memory are parsed concurrently.
+  if (this->FileName && mappedFile->Open(this->FileName))
+  {
+    auto memoryStream = vtkSmartPointer<vtkMemoryResourceStream>::New();
+    memoryStream->SetBuffer(mappedFile->GetData(), mappedFile->GetSize());
+    return memoryStream;
+  }
+
   auto fileStream = vtkSmartPointer<vtkFileResourceStream>::New();
   if (!this->FileName || !fileStream->Open(this->FileName))
   {
@@ -57,6 +76,824 @@ vtkSmartPointer<vtkResourceStream> vtkOBJReader::Open()
   return fileStream;
 }
 
+namespace
+{
+// Files in memory are parsed concurrently by chunks of whole lines of about
+// this size.
+constexpr std::ptrdiff_t OBJ_CHUNK_SIZE = 1 << 20;
+
+const std::string OBJ_NO_MATERIAL_NAME = "NO_MATERIAL";
+
+inline bool objIsSpace(char c)
+{
+  return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+inline bool objIsNewLine(char c)
+{
+  return c == '\n' || c == '\r';
+}
+
+// Return the beginning of the line following pos. Lines end with "\n", "\r\n"
+// or "\r", as with vtkResourceParser.
+const char* objNextLine(const char* pos, const char* end)
+{
+  pos = std::find_if(pos, end, objIsNewLine);
+  if (pos != end && *pos++ == '\r' && pos != end && *pos == '\n')
+  {
+    ++pos;
+  }
+  return pos;
+}
+
+// Parse the arguments of a record in memory as vtkResourceParser does when it
+// stops on new lines, so that both parsers give the same output.
+class objRecordParser
+{
+public:
+  objRecordParser(const char* pos, const char* end)
+    : Pos(pos)
+    , End(end)
+  {
+  }
+
+  // Discard the whitespace if asked, up to the next character. A line end is
+  // consumed and reported.
+  vtkParseResult Discard(bool whitespace)
+  {
+    while (whitespace && this->Pos != this->End && !objIsNewLine(*this->Pos) &&
+      objIsSpace(*this->Pos))
+    {
+      ++this->Pos;
+    }
+    if (this->Pos == this->End)
+    {
+      return vtkParseResult::EndOfStream;
+    }
+    if (objIsNewLine(*this->Pos))
+    {
+      this->Pos = objNextLine(this->Pos, this->End);
+      return vtkParseResult::EndOfLine;
+    }
+    return vtkParseResult::Ok;
+  }
+
+  vtkParseResult Parse(double& value, bool whitespace = true)
+  {
+    const vtkParseResult result = this->Discard(whitespace);
+    if (result != vtkParseResult::Ok)
+    {
+      return result;
+    }
+    const auto parsed = vtk::from_chars(this->Pos, this->End, value);
+    if (parsed.ec != std::errc{})
+    {
+      return vtkParseResult::Error;
+    }
+    this->Pos = parsed.ptr;
+    return vtkParseResult::Ok;
+  }
+
+  vtkParseResult Parse(int& value, bool whitespace = true)
+  {
+    const vtkParseResult result = this->Discard(whitespace);
+    if (result != vtkParseResult::Ok)
+    {
+      return result;
+    }
+    // vtkResourceParser also reads a leading '+' and the 0x, 0o and 0b
+    // prefixes, these integers are left to it.
+    const char* digits = this->Pos + (*this->Pos == '-' ? 1 : 0);
+    if (*this->Pos == '+' ||
+      (digits + 1 < this->End && *digits == '0' &&
+        std::isalnum(static_cast<unsigned char>(digits[1]))))
+    {
+      this->Unsupported = true;
+      return vtkParseResult::Error;
+    }
+    const auto parsed = vtk::from_chars(this->Pos, this->End, value);
+    if (parsed.ec != std::errc{})
+    {
+      return vtkParseResult::Error;
+    }
+    this->Pos = parsed.ptr;
+    return vtkParseResult::Ok;
+  }
+
+  vtkParseResult Parse(char& c, bool whitespace = true)
+  {
+    const vtkParseResult result = this->Discard(whitespace);
+    if (result == vtkParseResult::Ok)
+    {
+      c = *this->Pos++;
+    }
+    return result;
+  }
+
+  vtkParseResult Parse(std::string_view& word)
+  {
+    const vtkParseResult result = this->Discard(true);
+    if (result == vtkParseResult::Ok)
+    {
+      const char* begin = this->Pos;
+      this->Pos = std::find_if(this->Pos, this->End, objIsSpace);
+      word = std::string_view(begin, static_cast<size_t>(this->Pos - begin));
+    }
+    return result;
+  }
+
+  // Consume the end of the line, which must be empty. vtkOBJReader warns
+  // otherwise.
+  bool FlushLine()
+  {
+    std::string_view remaining;
+    return this->Parse(remaining) == vtkParseResult::EndOfLine;
+  }
+
+  // Parse count values, and an optional one that is discarded, up to the end
+  // of the line.
+  bool ParseTuple(double* values, int count, bool optional)
+  {
+    for (int i = 0; i < count; ++i)
+    {
+      if (this->Parse(values[i]) != vtkParseResult::Ok)
+      {
+        return false;
+      }
+    }
+    if (!optional)
+    {
+      return this->FlushLine();
+    }
+    double extra = 0.0;
+    const vtkParseResult result = this->Parse(extra);
+    return result != vtkParseResult::Error && (result != vtkParseResult::Ok || this->FlushLine());
+  }
+
+  // Once an index could not be parsed in a "p", "l" or "f" record, check that
+  // a backslash continues the record on the next line.
+  bool ContinueLine()
+  {
+    char c = 0;
+    this->Parse(c);
+    return c == '\\' && this->FlushLine();
+  }
+
+  // Set when an integer is not read as vtkResourceParser would read it.
+  bool Unsupported = false;
+
+private:
+  const char* Pos;
+  const char* End;
+};
+
+// Read the first comment of a file in memory. Return false if the comment
+// ends the file, which is left to vtkResourceParser.
+bool objReadFirstComment(const char* begin, const char* end, std::string& comment)
+{
+  while (true)
+  {
+    objRecordParser parser(begin, end);
+    std::string_view command;
+    if (parser.Parse(command) != vtkParseResult::Ok || command[0] != '#')
+    {
+      return true;
+    }
+
+    const char* lineBegin = command.data() + command.size();
+    if (command != "#") // first word is right next to #
+    {
+      comment += command.substr(1);
+    }
+    else // otherwise remove leading blankspaces
+    {
+      lineBegin = std::find_if(
+        lineBegin, end, [](char c) { return !std::isblank(static_cast<unsigned char>(c)); });
+    }
+
+    const char* lineEnd = std::find_if(lineBegin, end, objIsNewLine);
+    if (lineEnd == end)
+    {
+      return false;
+    }
+    comment.append(lineBegin, lineEnd);
+    comment += '\n';
+    begin = objNextLine(lineEnd, end);
+  }
+}
+
+// Types of the records parsed concurrently. The lines of other types, such
+// as comments, are ignored.
+enum objRecordType
+{
+  objVertex,   // "v"
+  objTCoord,   // "vt"
+  objNormal,   // "vn"
+  objFace,     // "f"
+  objGroup,    // "g"
+  objMaterial, // "usemtl"
+  objLibrary,  // "mtllib"
+  objPoints,   // "p"
+  objLines,    // "l"
+  objNumberOfRecordTypes
+};
+
+objRecordType objGetRecordType(std::string_view command)
+{
+  static const std::array<std::string_view, objNumberOfRecordTypes> commands = { "v", "vt", "vn",
+    "f", "g", "usemtl", "mtllib", "p", "l" };
+  return static_cast<objRecordType>(
+    std::find(commands.begin(), commands.end(), command) - commands.begin());
+}
+
+struct objRecord
+{
+  const char* Arguments; // right after the command
+  objRecordType Type;
+};
+
+// The cells of one kind parsed in a chunk.
+struct objCells
+{
+  std::vector<vtkIdType> Sizes;
+  std::vector<vtkIdType> Ids;
+};
+
+// A "usemtl" record, with the number of faces before it.
+struct objMaterialUse
+{
+  const char* Position;
+  std::string_view Name;
+  vtkIdType FaceId;
+};
+
+// A chunk of whole lines of a file in memory.
+struct objChunk
+{
+  const char* Begin = nullptr;
+  const char* End = nullptr;
+
+  // The records of the chunk, found by the first pass, with their numbers by
+  // type in the chunk and in the chunks before it.
+  std::vector<objRecord> Records;
+  std::array<vtkIdType, objNumberOfRecordTypes> Counts{};
+  std::array<vtkIdType, objNumberOfRecordTypes> Offsets{};
+
+  // What the records define, filled by the second pass.
+  objCells FaceVertices;
+  objCells FaceTCoords;
+  objCells FaceNormals;
+  objCells Points;
+  objCells Lines;
+  bool TCoordsMatchVertices = true;
+  bool NormalsMatchVertices = true;
+  const char* FirstTCoordFace = nullptr;
+  std::vector<objMaterialUse> Materials;
+  std::vector<std::string_view> Libraries;
+};
+
+// Find the records of a chunk, and count them by type.
+void objScanChunk(objChunk& chunk)
+{
+  const char* pos = chunk.Begin;
+  while (pos != chunk.End)
+  {
+    while (pos != chunk.End && !objIsNewLine(*pos) && objIsSpace(*pos))
+    {
+      ++pos;
+    }
+    const char* command = pos;
+    pos = std::find_if(pos, chunk.End, objIsSpace);
+    const objRecordType type =
+      objGetRecordType(std::string_view(command, static_cast<size_t>(pos - command)));
+    if (type != objNumberOfRecordTypes)
+    {
+      chunk.Records.push_back({ pos, type });
+      ++chunk.Counts[type];
+    }
+    pos = objNextLine(pos, chunk.End);
+  }
+}
+
+// Parse the records of a chunk, as the serial loop of vtkOBJReader::RequestData
+// does. The coordinates are written at the offsets of the chunk, the cells are
+// kept in the chunk.
+class objChunkParser
+{
+public:
+  objChunkParser(objChunk& chunk, const char* end)
+    : Chunk(chunk)
+    , End(end)
+    , Counts(chunk.Offsets)
+  {
+  }
+
+  // Return false if a record cannot be parsed, or not as vtkResourceParser
+  // would parse it.
+  bool Parse();
+
+  double* Points = nullptr;
+  float* TCoords = nullptr;
+  float* Normals = nullptr;
+  float* GroupIds = nullptr;
+  // Whether a face comes before the first "g" record, numbering the groups
+  // from 1 instead of 0.
+  bool FaceBeforeFirstGroup = false;
+
+private:
+  bool ParseElements(objRecordParser& parser, objCells& cells, bool lines);
+  bool ParseFace(objRecordParser& parser, const char* position);
+
+  objChunk& Chunk;
+  const char* End;
+  // The numbers of records of each type before the current one
+  std::array<vtkIdType, objNumberOfRecordTypes> Counts;
+};
+
+bool objChunkParser::Parse()
+{
+  double tuple[3];
+  for (const objRecord& record : this->Chunk.Records)
+  {
+    objRecordParser parser(record.Arguments, this->End);
+    const vtkIdType index = this->Counts[record.Type];
+    bool valid = true;
+    switch (record.Type)
+    {
+      case objVertex:
+        valid = parser.ParseTuple(this->Points + 3 * index, 3, true);
+        break;
+      case objTCoord:
+        valid = parser.ParseTuple(tuple, 2, true);
+        if (valid)
+        {
+          std::copy(tuple, tuple + 2, this->TCoords + 2 * index);
+        }
+        break;
+      case objNormal:
+        valid = parser.ParseTuple(tuple, 3, false);
+        if (valid)
+        {
+          std::copy(tuple, tuple + 3, this->Normals + 3 * index);
+        }
+        break;
+      case objFace:
+        valid = this->ParseFace(parser, record.Arguments);
+        break;
+      case objMaterial:
+      case objLibrary:
+      {
+        std::string_view name;
+        valid = parser.Parse(name) == vtkParseResult::Ok && parser.FlushLine();
+        if (record.Type == objMaterial)
+        {
+          this->Chunk.Materials.push_back({ record.Arguments, name, this->Counts[objFace] });
+        }
+        else
+        {
+          this->Chunk.Libraries.push_back(name);
+        }
+        break;
+      }
+      case objPoints:
+        valid = this->ParseElements(parser, this->Chunk.Points, false);
+        break;
+      case objLines:
+        valid = this->ParseElements(parser, this->Chunk.Lines, true);
+        break;
+      default: // the group names are ignored
+        break;
+    }
+    if (!valid || parser.Unsupported)
+    {
+      return false;
+    }
+    ++this->Counts[record.Type];
+  }
+  return true;
+}
+
+bool objChunkParser::ParseElements(objRecordParser& parser, objCells& cells, bool lines)
+{
+  const vtkIdType pointCount = this->Counts[objVertex];
+  vtkIdType vertCount = 0;
+  vtkParseResult result = vtkParseResult::Ok;
+  while (result == vtkParseResult::Ok)
+  {
+    int vert = 0;
+    result = parser.Parse(vert);
+    if (result == vtkParseResult::Ok)
+    {
+      if (vert < 0)
+      {
+        vert = static_cast<int>(pointCount + vert + 1);
+      }
+      if (vert <= 0)
+      {
+        return false;
+      }
+      cells.Ids.push_back(vert - 1);
+      ++vertCount;
+
+      if (lines) // an unused index may follow a slash
+      {
+        char c = 0;
+        result = parser.Parse(c, false);
+        if (c == '/')
+        {
+          result = parser.Parse(vert, false);
+          if (result != vtkParseResult::Ok)
+          {
+            return false;
+          }
+        }
+      }
+    }
+    else if (result == vtkParseResult::Error)
+    {
+      if (!parser.ContinueLine())
+      {
+        return false;
+      }
+      result = vtkParseResult::Ok;
+    }
+  }
+
+  if (vertCount < (lines ? 2 : 1))
+  {
+    return false;
+  }
+  cells.Sizes.push_back(vertCount);
+  return true;
+}
+
+bool objChunkParser::ParseFace(objRecordParser& parser, const char* position)
+{
+  const vtkIdType globalVertexCount = this->Counts[objVertex];
+  const vtkIdType globalTcoordCount = this->Counts[objTCoord];
+  const vtkIdType globalNormalCount = this->Counts[objNormal];
+  vtkIdType vertexCount = 0;
+  vtkIdType tcoordCount = 0;
+  vtkIdType normalCount = 0;
+
+  // parse `v` or `v/vt` or `v//vn` or `v/vt/vn`
+  vtkParseResult result = vtkParseResult::Ok;
+  while (result == vtkParseResult::Ok)
+  {
+    int vertex = 0;
+    result = parser.Parse(vertex);
+    if (result == vtkParseResult::Ok)
+    {
+      ++vertexCount;
+      const int vertexAbs = vertex < 0 ? static_cast<int>(globalVertexCount + vertex) : vertex - 1;
+      if (vertexAbs < 0)
+      {
+        return false;
+      }
+      this->Chunk.FaceVertices.Ids.push_back(vertexAbs);
+
+      // determine if we have tcoord or normal
+      char c = 0;
+      result = parser.Parse(c, false);
+      if (c == '/') // check tcoords
+      {
+        int tcoord = 0;
+        result = parser.Parse(tcoord, false);
+        if (result == vtkParseResult::Ok)
+        {
+          const int tcoordAbs =
+            tcoord < 0 ? static_cast<int>(globalTcoordCount + tcoord) : tcoord - 1;
+          ++tcoordCount;
+          if (tcoordAbs < 0)
+          {
+            return false;
+          }
+          this->Chunk.FaceTCoords.Ids.push_back(tcoordAbs);
+          if (!this->Chunk.FirstTCoordFace)
+          {
+            this->Chunk.FirstTCoordFace = position;
+          }
+          if (tcoordAbs != vertexAbs)
+          {
+            this->Chunk.TCoordsMatchVertices = false;
+          }
+        }
+        else if (result != vtkParseResult::Error) // error may indicate a double slash
+        {
+          return false;
+        }
+
+        c = 0;
+        result = parser.Parse(c, false);
+        if (c == '/')
+        {
+          int normal = 0;
+          result = parser.Parse(normal, false);
+          if (result != vtkParseResult::Ok)
+          {
+            return false;
+          }
+          ++normalCount;
+          const int normalAbs =
+            normal < 0 ? static_cast<int>(globalNormalCount + normal) : normal - 1;
+          if (normalAbs < 0)
+          {
+            return false;
+          }
+          this->Chunk.FaceNormals.Ids.push_back(normalAbs);
+          if (normalAbs != vertexAbs)
+          {
+            this->Chunk.NormalsMatchVertices = false;
+          }
+        }
+      }
+    }
+    else if (result == vtkParseResult::Error)
+    {
+      if (!parser.ContinueLine())
+      {
+        return false;
+      }
+      result = vtkParseResult::Ok;
+    }
+  }
+
+  // count of tcoords and normals must be equal to number of vertices or zero
+  if (vertexCount < 3 || (tcoordCount > 0 && tcoordCount != vertexCount) ||
+    (normalCount > 0 && normalCount != vertexCount))
+  {
+    return false;
+  }
+  this->Chunk.FaceVertices.Sizes.push_back(vertexCount);
+  this->Chunk.FaceTCoords.Sizes.push_back(tcoordCount);
+  this->Chunk.FaceNormals.Sizes.push_back(normalCount);
+
+  const vtkIdType groupId = this->Counts[objGroup] - (this->FaceBeforeFirstGroup ? 0 : 1);
+  this->GroupIds[this->Counts[objFace]] = static_cast<float>(groupId);
+  return true;
+}
+
+// Set the cells parsed in the chunks, concatenated concurrently.
+void objSetCells(vtkCellArray* cells, const std::vector<objChunk>& chunks, objCells objChunk::*kind)
+{
+  const size_t numChunks = chunks.size();
+  std::vector<vtkIdType> cellOffsets(numChunks + 1, 0);
+  std::vector<vtkIdType> idOffsets(numChunks + 1, 0);
+  for (size_t i = 0; i < numChunks; ++i)
+  {
+    const objCells& chunkCells = chunks[i].*kind;
+    cellOffsets[i + 1] = cellOffsets[i] + static_cast<vtkIdType>(chunkCells.Sizes.size());
+    idOffsets[i + 1] = idOffsets[i] + static_cast<vtkIdType>(chunkCells.Ids.size());
+  }
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(cellOffsets.back() + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(idOffsets.back());
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  vtkIdType* connectivityPtr = connectivity->GetPointer(0);
+  offsetsPtr[0] = 0;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numChunks), 1,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const objCells& chunkCells = chunks[i].*kind;
+        vtkIdType offset = idOffsets[i];
+        vtkIdType* chunkOffsets = offsetsPtr + cellOffsets[i] + 1;
+        for (vtkIdType size : chunkCells.Sizes)
+        {
+          *chunkOffsets++ = offset += size;
+        }
+        std::copy(chunkCells.Ids.begin(), chunkCells.Ids.end(), connectivityPtr + idOffsets[i]);
+      }
+    });
+  cells->SetData(offsets, connectivity);
+}
+
+// What vtkOBJReader::RequestData parses, before it is converted to the output.
+struct objOutput
+{
+  std::string& FirstComment;
+  vtkPoints* Points;
+  vtkSmartPointer<vtkFloatArray>& TCoords;
+  vtkSmartPointer<vtkFloatArray>& Normals;
+  vtkCellArray* VertexPolys;
+  vtkCellArray* TCoordPolys;
+  bool& TCoordsMatchVertices;
+  vtkCellArray* NormalPolys;
+  bool& NormalsMatchVertices;
+  vtkCellArray* PointElems;
+  vtkCellArray* LineElems;
+  vtkFloatArray* FaceScalars;
+  int& GroupId;
+  vtkStringArray* MaterialNames;
+  int& MaterialCount;
+  std::unordered_map<std::string, int>& MaterialNameToId;
+  std::unordered_map<vtkIdType, std::string>& StartCellToMaterialName;
+  std::unordered_map<std::string, std::vector<bool>>& TCoordsMap;
+  vtkStringArray* LibNames;
+};
+
+// Parse a file in memory concurrently: the records of chunks of lines are
+// found and counted first, then parsed with the numbers of records in the
+// chunks before them, which resolve the relative indices. Return false,
+// leaving output unchanged, if the file cannot be parsed this way.
+bool objReadBuffer(const char* begin, const char* end, objOutput& output)
+{
+  std::string firstComment;
+  if (!objReadFirstComment(begin, end, firstComment))
+  {
+    return false;
+  }
+
+  // First pass: find the records of the chunks, which begin with lines
+  const std::ptrdiff_t size = end - begin;
+  const vtkIdType numChunks = std::max<vtkIdType>(1, (size + OBJ_CHUNK_SIZE - 1) / OBJ_CHUNK_SIZE);
+  std::vector<objChunk> chunks(numChunks);
+  for (vtkIdType i = 0; i < numChunks; ++i)
+  {
+    chunks[i].Begin = i == 0 ? begin : chunks[i - 1].End;
+    chunks[i].End =
+      i + 1 == numChunks ? end : objNextLine(begin + (i + 1) * OBJ_CHUNK_SIZE - 1, end);
+  }
+  vtkSMPTools::For(0, numChunks, 1,
+    [&](vtkIdType chunkBegin, vtkIdType chunkEnd)
+    {
+      for (vtkIdType i = chunkBegin; i < chunkEnd; ++i)
+      {
+        objScanChunk(chunks[i]);
+      }
+    });
+
+  std::array<vtkIdType, objNumberOfRecordTypes> totals{};
+  const char* firstFace = nullptr;
+  const char* firstGroup = nullptr;
+  for (objChunk& chunk : chunks)
+  {
+    chunk.Offsets = totals;
+    for (int type = 0; type < objNumberOfRecordTypes; ++type)
+    {
+      totals[type] += chunk.Counts[type];
+    }
+    for (const objRecord& record : chunk.Records)
+    {
+      if (record.Type == objFace && !firstFace)
+      {
+        firstFace = record.Arguments;
+      }
+      else if (record.Type == objGroup && !firstGroup)
+      {
+        firstGroup = record.Arguments;
+      }
+    }
+  }
+
+  // Second pass: parse the records
+  vtkNew<vtkDoubleArray> points;
+  points->SetNumberOfComponents(3);
+  points->SetNumberOfTuples(totals[objVertex]);
+  auto tcoords = vtkSmartPointer<vtkFloatArray>::New();
+  tcoords->SetNumberOfComponents(2);
+  tcoords->SetNumberOfTuples(totals[objTCoord]);
+  auto normals = vtkSmartPointer<vtkFloatArray>::New();
+  normals->SetNumberOfComponents(3);
+  normals->SetNumberOfTuples(totals[objNormal]);
+  normals->SetName("Normals");
+  std::vector<float> groupIds(totals[objFace]);
+  const bool faceBeforeFirstGroup = firstFace && (!firstGroup || firstFace < firstGroup);
+  std::atomic<bool> valid(true);
+  vtkSMPTools::For(0, numChunks, 1,
+    [&](vtkIdType chunkBegin, vtkIdType chunkEnd)
+    {
+      for (vtkIdType i = chunkBegin; i < chunkEnd && valid; ++i)
+      {
+        objChunkParser parser(chunks[i], end);
+        parser.Points = points->GetPointer(0);
+        parser.TCoords = tcoords->GetPointer(0);
+        parser.Normals = normals->GetPointer(0);
+        parser.GroupIds = groupIds.data();
+        parser.FaceBeforeFirstGroup = faceBeforeFirstGroup;
+        if (!parser.Parse())
+        {
+          valid = false;
+        }
+      }
+    });
+  if (!valid)
+  {
+    return false;
+  }
+
+  output.FirstComment = firstComment;
+  output.Points->SetData(points);
+  output.TCoords = tcoords;
+  output.Normals = normals;
+  objSetCells(output.VertexPolys, chunks, &objChunk::FaceVertices);
+  objSetCells(output.TCoordPolys, chunks, &objChunk::FaceTCoords);
+  objSetCells(output.NormalPolys, chunks, &objChunk::FaceNormals);
+  objSetCells(output.PointElems, chunks, &objChunk::Points);
+  objSetCells(output.LineElems, chunks, &objChunk::Lines);
+  output.FaceScalars->SetNumberOfValues(totals[objFace]);
+  std::copy(groupIds.begin(), groupIds.end(), output.FaceScalars->GetPointer(0));
+  if (firstFace || firstGroup)
+  {
+    output.GroupId = static_cast<int>(totals[objGroup] - (faceBeforeFirstGroup ? 0 : 1));
+  }
+
+  // Materials are recorded in the order of the records, the first face using
+  // no material.
+  const char* firstTCoordFace = nullptr;
+  std::vector<objMaterialUse> materials;
+  for (const objChunk& chunk : chunks)
+  {
+    output.TCoordsMatchVertices &= chunk.TCoordsMatchVertices;
+    output.NormalsMatchVertices &= chunk.NormalsMatchVertices;
+    if (!firstTCoordFace)
+    {
+      firstTCoordFace = chunk.FirstTCoordFace;
+    }
+    materials.insert(materials.end(), chunk.Materials.begin(), chunk.Materials.end());
+    for (std::string_view name : chunk.Libraries)
+    {
+      output.LibNames->InsertNextValue(std::string(name));
+    }
+  }
+
+  // Faces with tcoords before any material use the default tcoords
+  if (firstTCoordFace && (materials.empty() || firstTCoordFace < materials[0].Position))
+  {
+    output.TCoordsMap.emplace("TCoords", std::vector<bool>{});
+  }
+
+  const auto useMaterial = [&output](const std::string& name, vtkIdType cellId)
+  {
+    if (output.MaterialNameToId.find(name) == output.MaterialNameToId.end())
+    {
+      // haven't seen this material yet, keep a record of it
+      output.MaterialNameToId.emplace(name, output.MaterialCount);
+      output.MaterialNames->InsertNextValue(name);
+      output.MaterialCount++;
+    }
+
+    // remember that starting with current cell, we should draw with it
+    output.StartCellToMaterialName[cellId] = name;
+  };
+  bool noMaterialUsed = firstFace == nullptr;
+  for (const objMaterialUse& material : materials)
+  {
+    if (!noMaterialUsed && firstFace < material.Position)
+    {
+      useMaterial(OBJ_NO_MATERIAL_NAME, 0);
+      noMaterialUsed = true;
+    }
+    const std::string name(material.Name);
+    useMaterial(name, material.FaceId);
+    if (output.TCoordsMap.find(name) == output.TCoordsMap.end())
+    {
+      output.TCoordsMap.emplace(name, std::vector<bool>{});
+    }
+  }
+  if (!noMaterialUsed)
+  {
+    useMaterial(OBJ_NO_MATERIAL_NAME, 0);
+  }
+
+  // Mark the tcoords used by the faces with the material they are drawn with
+  if (firstTCoordFace)
+  {
+    auto material = materials.begin();
+    std::vector<bool>* tcoordArray = nullptr; // of the active material
+    vtkIdType faceId = 0;
+    for (const objChunk& chunk : chunks)
+    {
+      auto tcoordId = chunk.FaceTCoords.Ids.begin();
+      for (vtkIdType tcoordCount : chunk.FaceTCoords.Sizes)
+      {
+        for (; material != materials.end() && material->FaceId <= faceId; ++material)
+        {
+          tcoordArray = &output.TCoordsMap.find(std::string(material->Name))->second;
+        }
+        if (tcoordCount > 0 && !tcoordArray)
+        {
+          tcoordArray = &output.TCoordsMap.find("TCoords")->second;
+        }
+        for (const auto end = tcoordId + tcoordCount; tcoordId != end; ++tcoordId)
+        {
+          if (static_cast<std::size_t>(*tcoordId) >= tcoordArray->size())
+          {
+            tcoordArray->resize(*tcoordId + 1);
+          }
+          (*tcoordArray)[*tcoordId] = true;
+        }
+        ++faceId;
+      }
+    }
+  }
+  return true;
+}
+}
+
 /*---------------------------------------------------------------------------*\
 
 This is only partial support for the OBJ format, which is quite complicated.
@@ -127,7 +964,8 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkSmartPointer<vtkResourceStream> stream = this->Open();
+  vtkNew<vtkMemoryMappedFile> mappedFile;
+  vtkSmartPointer<vtkResourceStream> stream = this->Open(mappedFile);
   if (!stream)
   {
     vtkErrorMacro(<< "Failed to open stream");
@@ -138,7 +976,7 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
   parser->SetStream(stream);
   parser->StopOnNewLineOn();
 
-  const std::string noMaterialName = "NO_MATERIAL";
+  const std::string& noMaterialName = OBJ_NO_MATERIAL_NAME;
 
   // Vertices ("v")
   auto points = vtkSmartPointer<vtkPoints>::New();
@@ -221,6 +1059,21 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
   };
 
   vtkParseResult result = vtkParseResult::Ok;
+  if (auto memoryStream = vtkMemoryResourceStream::SafeDownCast(stream))
+  {
+    // In memory, the file is parsed concurrently. Files that cannot be parsed
+    // this way, such as invalid ones, are parsed below to report their errors.
+    const char* buffer = static_cast<const char*>(memoryStream->GetBuffer());
+    objOutput parsed{ firstComment, points, tcoords, normals, vertexPolys, tcoordPolys,
+      tcoordsMatchVertices, normalPolys, normalsMatchVertices, pointElems, lineElems, faceScalars,
+      groupId, materialNames, materialCount, materialNameToId, startCellToMaterialName, tcoordsMap,
+      libNames };
+    if (objReadBuffer(buffer + stream->Tell(), buffer + memoryStream->GetSize(), parsed))
+    {
+      result = vtkParseResult::EndOfStream; // nothing left to parse
+    }
+  }
+
   while (result == vtkParseResult::Ok || result == vtkParseResult::EndOfLine)
   {
     ++lineNumber;
@@ -11,6 +11,11 @@
  * When selecting input method, `Stream` has an higher priority than `Filename`.
  * If both are null, reader outputs nothing.
  *
+ * Files are mapped in memory when possible. Files in memory, and
+ * `vtkMemoryResourceStream`, are parsed concurrently: the records of each
+ * chunk of lines are found first, then parsed with their relative indices
+ * resolved from the numbers of records in the previous chunks.
+ *
  * @sa
  * vtkOBJImporter
  */
@@ -22,6 +27,8 @@
 #include "vtkIOGeometryModule.h" // For export macro
 
 VTK_ABI_NAMESPACE_BEGIN
+class vtkMemoryMappedFile;
+
 class VTKIOGEOMETRY_EXPORT vtkOBJReader : public vtkAbstractPolyDataReader
 {
 public:
@@ -49,7 +56,8 @@ protected:
   char* Comment;
 
 private:
-  vtkSmartPointer<vtkResourceStream> Open();
+  // Open the stream to read, mapping the file in mappedFile when possible.
+  vtkSmartPointer<vtkResourceStream> Open(vtkMemoryMappedFile* mappedFile);
 
   vtkOBJReader(const vtkOBJReader&) = delete;
   void operator=(const vtkOBJReader&) = delete;
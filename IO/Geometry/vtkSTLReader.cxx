@@ -8,25 +8,35 @@
 #include "vtkErrorCode.h"
 #include "vtkFileResourceStream.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMemoryMappedFile.h"
+#include "vtkMemoryResourceStream.h"
 #include "vtkMergePoints.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
 #include "vtkResourceParser.h"
 #include "vtkResourceStream.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringScanner.h"
 #include "vtkUnsignedCharArray.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
+#include <numeric>
 #include <string>
+#include <string_view>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -38,6 +48,153 @@ constexpr int STL_HEADER_SIZE = 80;
 
 // twelve 32-bit-floating point numbers + 2 byte for attribute byte count = 50 bytes.
 constexpr vtkTypeInt64 STL_TRI_SIZE = 12 * sizeof(float) + sizeof(uint16_t);
+
+// Number of facets read at once from binary streams that are not in memory.
+constexpr vtkIdType STL_TRI_BLOCK_SIZE = 65536;
+
+// Lower the first index stored in value to index.
+void AtomicMin(std::atomic<vtkIdType>& value, vtkIdType index)
+{
+  vtkIdType current = value.load();
+  while (index < current && !value.compare_exchange_weak(current, index))
+  {
+  }
+}
+
+// Read the normal and the three vertices of a binary facet, and return the
+// error message of its first non-finite value, or nullptr if they are finite.
+const char* stlReadFacet(const unsigned char* facet, float values[12])
+{
+  std::memcpy(values, facet, 12 * sizeof(float));
+  vtkByteSwap::SwapLERange(values, 12);
+  static const char* const messages[4] = { "Normal vector non-finite.", "vertex 1 non-finite.",
+    "vertex 2 non-finite.", "vertex 3 non-finite." };
+  for (int i = 0; i < 12; ++i)
+  {
+    if (!std::isfinite(values[i]))
+    {
+      return messages[i / 3];
+    }
+  }
+  return nullptr;
+}
+
+// Decode numTris binary facets into the coordinates of their vertices,
+// concurrently. Returns the index of the first facet with a non-finite
+// value, or numTris if there is none.
+vtkIdType stlDecodeFacets(const unsigned char* facets, vtkIdType numTris, float* coords)
+{
+  std::atomic<vtkIdType> firstInvalid(numTris);
+  vtkSMPTools::For(0, numTris,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      float values[12];
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        if (stlReadFacet(facets + i * ::STL_TRI_SIZE, values))
+        {
+          AtomicMin(firstInvalid, i);
+          return;
+        }
+        std::copy(values + 3, values + 12, coords + 9 * i);
+      }
+    });
+  return firstInvalid;
+}
+
+// Set the cells to numTris triangles over consecutive points, as the
+// facets are read.
+void stlSetTriangles(vtkCellArray* polys, vtkIdType numTris)
+{
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numTris + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(3 * numTris);
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  vtkIdType* connectivityPtr = connectivity->GetPointer(0);
+  vtkSMPTools::For(0, numTris + 1,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        offsetsPtr[i] = 3 * i;
+      }
+      std::iota(connectivityPtr + 3 * begin, connectivityPtr + 3 * std::min(end, numTris),
+        3 * begin);
+    });
+  polys->SetData(offsets, connectivity);
+}
+
+// Merge the coincident points of numTris triangles with a static point
+// locator, which bins and compares the points concurrently, and drop the
+// triangles that become degenerate. Merged points are numbered in the order
+// of their first use, as when they are inserted in a vtkMergePoints.
+void stlMergeTriangles(vtkPoints* points, vtkIdType numTris, vtkFloatArray* scalars,
+  vtkPoints* mergedPts, vtkCellArray* mergedPolys, vtkFloatArray* mergedScalars)
+{
+  const vtkIdType numPts = 3 * numTris;
+  std::vector<vtkIdType> mergeMap(numPts);
+  if (numPts > 0)
+  {
+    vtkNew<vtkPolyData> cloud;
+    cloud->SetPoints(points);
+    vtkNew<vtkStaticPointLocator> locator;
+    locator->SetDataSet(cloud);
+    locator->BuildLocator();
+    locator->MergePoints(0.0, mergeMap.data());
+  }
+
+  // Coincident points are merged to the one with the lowest id, so it is
+  // numbered first.
+  std::vector<vtkIdType> pointIds(numPts);
+  vtkIdType numMergedPts = 0;
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    pointIds[i] = mergeMap[i] == i ? numMergedPts++ : pointIds[mergeMap[i]];
+  }
+
+  mergedPts->SetDataTypeToFloat();
+  mergedPts->SetNumberOfPoints(numMergedPts);
+  const float* coords = vtkFloatArray::FastDownCast(points->GetData())->GetPointer(0);
+  float* mergedCoords = vtkFloatArray::FastDownCast(mergedPts->GetData())->GetPointer(0);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        if (mergeMap[i] == i)
+        {
+          std::copy(coords + 3 * i, coords + 3 * i + 3, mergedCoords + 3 * pointIds[i]);
+        }
+      }
+    });
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numTris + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(3 * numTris);
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  vtkIdType* connectivityPtr = connectivity->GetPointer(0);
+  vtkIdType numMergedTris = 0;
+  offsetsPtr[0] = 0;
+  for (vtkIdType i = 0; i < numTris; ++i)
+  {
+    const vtkIdType* nodes = pointIds.data() + 3 * i;
+    if (nodes[0] != nodes[1] && nodes[0] != nodes[2] && nodes[1] != nodes[2])
+    {
+      std::copy(nodes, nodes + 3, connectivityPtr + 3 * numMergedTris);
+      ++numMergedTris;
+      offsetsPtr[numMergedTris] = 3 * numMergedTris;
+      if (scalars)
+      {
+        mergedScalars->InsertNextValue(scalars->GetValue(i));
+      }
+    }
+  }
+  offsets->SetNumberOfValues(numMergedTris + 1);
+  connectivity->SetNumberOfValues(3 * numMergedTris);
+  mergedPolys->SetData(offsets, connectivity);
+}
 }
 
 vtkStandardNewMacro(vtkSTLReader);
@@ -92,12 +249,20 @@ int vtkSTLReader::RequestData(vtkInformation* vtkNotUsed(request),
     return 0;
   }
 
+  // Files are mapped in memory when possible, to be parsed in place.
   vtkResourceStream* stream = this->Stream;
+  vtkNew<vtkMemoryMappedFile> mappedFile;
+  vtkNew<vtkMemoryResourceStream> mappedStream;
   vtkNew<vtkFileResourceStream> fileStream;
   if (stream)
   {
     stream->Seek(0, vtkResourceStream::SeekDirection::Begin);
   }
+  else if (mappedFile->Open(this->FileName))
+  {
+    mappedStream->SetBuffer(mappedFile->GetData(), mappedFile->GetSize());
+    stream = mappedStream;
+  }
   else
   {
     if (!fileStream->Open(this->FileName))
@@ -122,22 +287,21 @@ int vtkSTLReader::RequestData(vtkInformation* vtkNotUsed(request),
   if (solid == "solid")
   {
     // First word is "solid", which means the data should be ASCII.
-    newPts->Allocate(5000);
-    newPolys->AllocateEstimate(10000, 1);
     if (this->ScalarTags)
     {
       newScalars = vtkSmartPointer<vtkFloatArray>::New();
       newScalars->Allocate(5000);
     }
 
-    vtkNew<vtkResourceParser> parser;
-    parser->SetStream(stream);
-    if (!this->ReadASCIISTL(parser, newPts.Get(), newPolys.Get(), newScalars))
+    if (!this->ReadASCIISTL(stream, newPts.Get(), newPolys.Get(), newScalars))
     {
       // In relaxed mode, fallback to try reading as binary (because we have seen malformed STL
       // files in the wild that have the 80 byte header but start with `solid`).
       if (this->GetRelaxedConformance())
       {
+        newPts->Initialize();
+        newPolys->Initialize();
+        newScalars = nullptr;
         stream->Seek(0, vtkResourceStream::SeekDirection::Begin);
         if (!this->ReadBinarySTL(stream, newPts.Get(), newPolys.Get()))
         {
@@ -159,51 +323,57 @@ int vtkSTLReader::RequestData(vtkInformation* vtkNotUsed(request),
   vtkDebugMacro(<< "Read: " << newPts->GetNumberOfPoints() << " points, "
                 << newPolys->GetNumberOfCells() << " triangles");
 
-  // If merging is on, create hash table and merge points/triangles.
+  // If merging is on, merge coincident points and drop degenerate triangles.
   vtkSmartPointer<vtkPoints> mergedPts = newPts;
   vtkSmartPointer<vtkCellArray> mergedPolys = newPolys;
   vtkSmartPointer<vtkFloatArray> mergedScalars = newScalars;
   if (this->Merging)
   {
     mergedPts = vtkSmartPointer<vtkPoints>::New();
-    mergedPts->Allocate(newPts->GetNumberOfPoints() / 2);
     mergedPolys = vtkSmartPointer<vtkCellArray>::New();
-    mergedPolys->AllocateCopy(newPolys);
     if (newScalars)
     {
       mergedScalars = vtkSmartPointer<vtkFloatArray>::New();
       mergedScalars->Allocate(newPolys->GetNumberOfCells());
     }
 
-    vtkSmartPointer<vtkIncrementalPointLocator> locator = this->Locator;
     if (this->Locator == nullptr)
     {
-      locator.TakeReference(this->NewDefaultLocator());
+      // The triangles use consecutive points, the points of an incomplete
+      // last facet, if any, are not used.
+      const vtkIdType numTris = newPolys->GetNumberOfCells();
+      newPts->SetNumberOfPoints(3 * numTris);
+      stlMergeTriangles(newPts, numTris, newScalars, mergedPts, mergedPolys, mergedScalars);
     }
-    locator->InitPointInsertion(mergedPts, newPts->GetBounds());
-
-    vtkIdType nextCell = 0;
-    const vtkIdType* pts = nullptr;
-    vtkIdType npts;
-    for (newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts);)
+    else
     {
-      vtkIdType nodes[3];
-      for (int i = 0; i < 3; i++)
+      mergedPts->Allocate(newPts->GetNumberOfPoints() / 2);
+      mergedPolys->AllocateCopy(newPolys);
+      this->Locator->InitPointInsertion(mergedPts, newPts->GetBounds());
+
+      vtkIdType nextCell = 0;
+      const vtkIdType* pts = nullptr;
+      vtkIdType npts;
+      for (newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts);)
       {
-        double x[3];
-        newPts->GetPoint(pts[i], x);
-        locator->InsertUniquePoint(x, nodes[i]);
-      }
+        vtkIdType nodes[3];
+        for (int i = 0; i < 3; i++)
+        {
+          double x[3];
+          newPts->GetPoint(pts[i], x);
+          this->Locator->InsertUniquePoint(x, nodes[i]);
+        }
 
-      if (nodes[0] != nodes[1] && nodes[0] != nodes[2] && nodes[1] != nodes[2])
-      {
-        mergedPolys->InsertNextCell(3, nodes);
-        if (newScalars)
+        if (nodes[0] != nodes[1] && nodes[0] != nodes[2] && nodes[1] != nodes[2])
         {
-          mergedScalars->InsertNextValue(newScalars->GetValue(nextCell));
+          mergedPolys->InsertNextCell(3, nodes);
+          if (newScalars)
+          {
+            mergedScalars->InsertNextValue(newScalars->GetValue(nextCell));
+          }
         }
+        nextCell++;
       }
-      nextCell++;
     }
 
     vtkDebugMacro(<< "Merged to: " << mergedPts->GetNumberOfPoints() << " points, "
@@ -260,13 +430,6 @@ bool vtkSTLReader::ReadBinaryTrisFile(vtkResourceStream* stream, vtkTypeInt64& n
 bool vtkSTLReader::ReadBinarySTL(
   vtkResourceStream* stream, vtkPoints* newPts, vtkCellArray* newPolys)
 {
-  struct facet_t_t
-  {
-    float n[3], v1[3], v2[3], v3[3];
-    uint16_t attrByteCount;
-  };
-  using facet_t = struct facet_t_t;
-
   vtkDebugMacro(<< "Reading BINARY STL file");
 
   //  File is read to obtain raw information as well as bounding box
@@ -320,62 +483,56 @@ bool vtkSTLReader::ReadBinarySTL(
 
   // now allocate the memory we need for the triangles.
   // note we ignore the triangle count field and read until end of file.
-  newPts->Allocate(numTrisFile * 3);
-  newPolys->AllocateEstimate(numTrisFile, 3);
-
-  facet_t facet;
-  for (size_t i = 0; stream->Read(&facet, ::STL_TRI_SIZE) > 0; ++i)
+  newPts->SetDataTypeToFloat();
+  newPts->SetNumberOfPoints(numTrisFile * 3);
+  float* coords = vtkFloatArray::FastDownCast(newPts->GetData())->GetPointer(0);
+
+  // Facets are decoded in place when the stream is in memory, and read by
+  // blocks otherwise.
+  vtkIdType numTris = 0;
+  if (auto memoryStream = vtkMemoryResourceStream::SafeDownCast(stream))
   {
-    vtkByteSwap::Swap4LE(facet.n);
-    vtkByteSwap::Swap4LE(facet.n + 1);
-    vtkByteSwap::Swap4LE(facet.n + 2);
-    if (!std::isfinite(facet.n[0]) || !std::isfinite(facet.n[1]) || !std::isfinite(facet.n[2]))
-    {
-      vtkErrorMacro("Normal vector non-finite.");
-      return false;
-    }
-
-    vtkByteSwap::Swap4LE(facet.v1);
-    vtkByteSwap::Swap4LE(facet.v1 + 1);
-    vtkByteSwap::Swap4LE(facet.v1 + 2);
-    if (!std::isfinite(facet.v1[0]) || !std::isfinite(facet.v1[1]) || !std::isfinite(facet.v1[2]))
-    {
-      vtkErrorMacro("vertex 1 non-finite.");
-      return false;
-    }
-
-    vtkByteSwap::Swap4LE(facet.v2);
-    vtkByteSwap::Swap4LE(facet.v2 + 1);
-    vtkByteSwap::Swap4LE(facet.v2 + 2);
-    if (!std::isfinite(facet.v2[0]) || !std::isfinite(facet.v2[1]) || !std::isfinite(facet.v2[2]))
-    {
-      vtkErrorMacro("vertex 2 non-finite.");
-      return false;
-    }
-
-    vtkByteSwap::Swap4LE(facet.v3);
-    vtkByteSwap::Swap4LE(facet.v3 + 1);
-    vtkByteSwap::Swap4LE(facet.v3 + 2);
-    if (!std::isfinite(facet.v3[0]) || !std::isfinite(facet.v3[1]) || !std::isfinite(facet.v3[2]))
+    const unsigned char* facets =
+      static_cast<const unsigned char*>(memoryStream->GetBuffer()) + stream->Tell();
+    const vtkIdType invalidTri = stlDecodeFacets(facets, numTrisFile, coords);
+    if (invalidTri < numTrisFile)
     {
-      vtkErrorMacro("vertex 3 non-finite.");
+      float values[12];
+      vtkErrorMacro(<< stlReadFacet(facets + invalidTri * ::STL_TRI_SIZE, values));
       return false;
     }
-
-    vtkIdType pts[3];
-    pts[0] = newPts->InsertNextPoint(facet.v1);
-    pts[1] = newPts->InsertNextPoint(facet.v2);
-    pts[2] = newPts->InsertNextPoint(facet.v3);
-
-    newPolys->InsertNextCell(3, pts);
-
-    if ((i % 100000) == 0 && i != 0)
+    numTris = numTrisFile;
+  }
+  else
+  {
+    const vtkIdType blockSize = std::min<vtkIdType>(numTrisFile, ::STL_TRI_BLOCK_SIZE);
+    std::vector<unsigned char> block(static_cast<size_t>(blockSize * ::STL_TRI_SIZE));
+    while (numTris < numTrisFile)
     {
-      vtkDebugMacro(<< "triangle# " << i);
-      this->UpdateProgress(static_cast<double>(i) / numTrisFile);
+      const vtkIdType numWantedTris = std::min(blockSize, numTrisFile - numTris);
+      const size_t readSize =
+        stream->Read(block.data(), static_cast<size_t>(numWantedTris * ::STL_TRI_SIZE));
+      const vtkIdType numBlockTris = static_cast<vtkIdType>(readSize / ::STL_TRI_SIZE);
+      const vtkIdType invalidTri =
+        stlDecodeFacets(block.data(), numBlockTris, coords + 9 * numTris);
+      if (invalidTri < numBlockTris)
+      {
+        float values[12];
+        vtkErrorMacro(<< stlReadFacet(block.data() + invalidTri * ::STL_TRI_SIZE, values));
+        return false;
+      }
+      numTris += numBlockTris;
+      if (numBlockTris < numWantedTris)
+      {
+        break;
+      }
+      vtkDebugMacro(<< "triangle# " << numTris);
+      this->UpdateProgress(static_cast<double>(numTris) / numTrisFile);
     }
+    newPts->SetNumberOfPoints(numTris * 3);
   }
 
+  stlSetTriangles(newPolys, numTris);
   return true;
 }
 
@@ -394,11 +551,14 @@ inline std::string stlParseExpected(const std::string& expected, const std::stri
   return "Parse error. Expecting '" + expected + "' found '" + found + "'";
 }
 
-// Get three space-delimited floats from string.
-bool stlReadVertex(char* buf, float vertCoord[3])
+inline bool stlIsSpace(char c)
 {
-  std::string_view buffer = buf;
+  return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
 
+// Get three space-delimited floats from string.
+bool stlReadVertex(std::string_view buffer, float vertCoord[3])
+{
   for (int i = 0; i < 3; ++i)
   {
     auto result = vtk::scan_value<float>(buffer);
@@ -407,12 +567,230 @@ bool stlReadVertex(char* buf, float vertCoord[3])
       return false;
     }
     vertCoord[i] = result->value();
-    buffer = result->range().data();
+    buffer = std::string_view(result->range().data(), result->range().size());
   }
 
   return true;
 }
 
+// Check the structure of an ASCII STL file, line by line. The coordinates of
+// the vertices are left to the caller, to be converted as lines are read, or
+// later, all at once.
+class stlASCIIScanner
+{
+public:
+  enum LineType
+  {
+    OtherLine,
+    VertexLine,
+    LastVertexLine // the last vertex of a facet
+  };
+
+  // Check a line, without its end-of-line characters, and return its type.
+  // The arguments of vertex lines are given in arg.
+  LineType ScanLine(std::string_view line, std::string_view& arg);
+
+  // Check that the file can end in the current state.
+  void ScanEnd();
+
+  std::string Header;
+  std::string ErrorMessage;
+  size_t LineNum = 0;
+  int SolidId = -1;
+
+private:
+  enum StlAsciiScanState
+  {
+    scanSolid = 0,
+    scanFacet,
+    scanLoop,
+    scanVerts,
+    scanEndLoop,
+    scanEndFacet
+  };
+
+  StlAsciiScanState State = scanSolid;
+  int VertOff = 0;
+};
+
+stlASCIIScanner::LineType stlASCIIScanner::ScanLine(std::string_view line, std::string_view& arg)
+{
+  // Cue to the first non-space.
+  size_t cmdBegin = 0;
+  while (cmdBegin < line.size() && stlIsSpace(line[cmdBegin]))
+  {
+    ++cmdBegin;
+  }
+
+  // An empty line - try again
+  if (cmdBegin == line.size())
+  {
+    // Increment line-number, but not while still in the header
+    if (this->LineNum)
+      ++this->LineNum;
+    return OtherLine;
+  }
+
+  // Ensure consistent case on the first token and separate from
+  // subsequent arguments
+  std::string cmd;
+  size_t argBegin = cmdBegin;
+  while (argBegin < line.size() && !stlIsSpace(line[argBegin]))
+  {
+    cmd += static_cast<char>(std::tolower(static_cast<unsigned char>(line[argBegin])));
+    ++argBegin;
+  }
+  while (argBegin < line.size() && stlIsSpace(line[argBegin]))
+  {
+    ++argBegin;
+  }
+  arg = line.substr(argBegin);
+
+  ++this->LineNum;
+
+  // Handle all expected parsed elements
+  switch (this->State)
+  {
+    case scanSolid:
+    {
+      if (cmd == "solid")
+      {
+        ++this->SolidId;
+        this->State = scanFacet; // Next state
+        if (!this->Header.empty())
+        {
+          this->Header += "\n";
+        }
+        this->Header += arg;
+      }
+      else
+      {
+        this->ErrorMessage = stlParseExpected("solid", cmd);
+      }
+      break;
+    }
+    case scanFacet:
+    {
+      if (cmd == "color")
+      {
+        // Optional 'color' entry (after solid) - continue looking for 'facet'
+        break;
+      }
+
+      if (cmd == "facet")
+      {
+        this->State = scanLoop; // Next state
+      }
+      else if (cmd == "endsolid")
+      {
+        // Finished with 'endsolid' - find next solid
+        this->State = scanSolid;
+      }
+      else
+      {
+        this->ErrorMessage = stlParseExpected("facet", cmd);
+      }
+      break;
+    }
+    case scanLoop:
+    {
+      if (cmd == "outer") // More pedantic => && arg == "loop"
+      {
+        this->State = scanVerts; // Next state
+      }
+      else
+      {
+        this->ErrorMessage = stlParseExpected("outer loop", cmd);
+      }
+      break;
+    }
+    case scanVerts:
+    {
+      if (cmd == "vertex")
+      {
+        ++this->VertOff; // Next vertex
+        if (this->VertOff < 3)
+        {
+          return VertexLine;
+        }
+
+        // Finished this triangle.
+        this->VertOff = 0;
+        this->State = scanEndLoop; // Next state
+        return LastVertexLine;
+      }
+      this->ErrorMessage = stlParseExpected("vertex", cmd);
+      break;
+    }
+    case scanEndLoop:
+    {
+      if (cmd == "endloop")
+      {
+        this->State = scanEndFacet; // Next state
+      }
+      else
+      {
+        this->ErrorMessage = stlParseExpected("endloop", cmd);
+      }
+      break;
+    }
+    case scanEndFacet:
+    {
+      if (cmd == "endfacet")
+      {
+        this->State = scanFacet; // Next facet, or endsolid
+      }
+      else
+      {
+        this->ErrorMessage = stlParseExpected("endfacet", cmd);
+      }
+      break;
+    }
+  }
+  return OtherLine;
+}
+
+void stlASCIIScanner::ScanEnd()
+{
+  // If scanning for the next "solid" this is a valid way to exit,
+  // but is an error if scanning for the initial "solid" or any other token
+  switch (this->State)
+  {
+    case scanSolid:
+    {
+      // Emit error if EOF encountered without having read anything
+      if (this->SolidId < 0)
+        this->ErrorMessage = stlParseEof("solid");
+      break;
+    }
+    case scanFacet:
+    {
+      this->ErrorMessage = stlParseEof("facet");
+      break;
+    }
+    case scanLoop:
+    {
+      this->ErrorMessage = stlParseEof("outer loop");
+      break;
+    }
+    case scanVerts:
+    {
+      this->ErrorMessage = stlParseEof("vertex");
+      break;
+    }
+    case scanEndLoop:
+    {
+      this->ErrorMessage = stlParseEof("endloop");
+      break;
+    }
+    case scanEndFacet:
+    {
+      this->ErrorMessage = stlParseEof("endfacet");
+      break;
+    }
+  }
+}
+
 } // end of anonymous namespace
 
 // https://en.wikipedia.org/wiki/STL_%28file_format%29#ASCII_STL
@@ -440,275 +818,137 @@ bool stlReadVertex(char* buf, float vertCoord[3])
 // endsolid [name]
 
 bool vtkSTLReader::ReadASCIISTL(
-  vtkResourceParser* parser, vtkPoints* newPts, vtkCellArray* newPolys, vtkFloatArray* scalars)
+  vtkResourceStream* stream, vtkPoints* newPts, vtkCellArray* newPolys, vtkFloatArray* scalars)
 {
   vtkDebugMacro(<< "Reading ASCII STL file");
 
   this->SetHeader(nullptr);
   this->SetBinaryHeader(nullptr);
-  std::string header;
 
-  std::string line;   // line buffer
-  float vertCoord[3]; // scratch space when parsing "vertex %f %f %f"
-  vtkIdType pts[3];   // point ids for building triangles
-  int vertOff = 0;
+  stlASCIIScanner scanner;
+  std::string_view arg;
+  vtkIdType numTris = 0;
 
-  int solidId = -1;
-  size_t lineNum = 0;
-
-  enum StlAsciiScanState
+  if (auto memoryStream = vtkMemoryResourceStream::SafeDownCast(stream))
   {
-    scanSolid = 0,
-    scanFacet,
-    scanLoop,
-    scanVerts,
-    scanEndLoop,
-    scanEndFacet,
-    scanEndSolid
-  };
-
-  std::string errorMessage;
-
-  for (StlAsciiScanState state = scanSolid; errorMessage.empty(); /*nil*/)
-  {
-    vtkParseResult res = parser->ReadLine(line);
-    char* cmd = line.data();
-    if (res == vtkParseResult::EndOfStream)
+    // In memory, the structure is checked first, then the vertices are
+    // converted concurrently.
+    const char* buffer = static_cast<const char*>(memoryStream->GetBuffer());
+    const char* begin = buffer + stream->Tell();
+    const char* end = buffer + memoryStream->GetSize();
+    std::vector<std::string_view> vertices;
+    while (scanner.ErrorMessage.empty())
     {
-      // If scanning for the next "solid" this is a valid way to exit,
-      // but is an error if scanning for the initial "solid" or any other token
-
-      switch (state)
+      if (begin == end)
       {
-        case scanSolid:
-        {
-          // Emit error if EOF encountered without having read anything
-          if (solidId < 0)
-            errorMessage = stlParseEof("solid");
-          break;
-        }
-        case scanFacet:
-        {
-          errorMessage = stlParseEof("facet");
-          break;
-        }
-        case scanLoop:
-        {
-          errorMessage = stlParseEof("outer loop");
-          break;
-        }
-        case scanVerts:
-        {
-          errorMessage = stlParseEof("vertex");
-          break;
-        }
-        case scanEndLoop:
-        {
-          errorMessage = stlParseEof("endloop");
-          break;
-        }
-        case scanEndFacet:
-        {
-          errorMessage = stlParseEof("endfacet");
-          break;
-        }
-        case scanEndSolid:
-        {
-          errorMessage = stlParseEof("endsolid");
-          break;
-        }
+        scanner.ScanEnd();
+        break;
       }
 
-      // Terminate the parsing loop
-      break;
-    }
-
-    // Cue to the first non-space.
-    while (isspace(*cmd))
-    {
-      ++cmd;
-    }
-
-    // An empty line - try again
-    if (!*cmd)
-    {
-      // Increment line-number, but not while still in the header
-      if (lineNum)
-        ++lineNum;
-      continue;
-    }
-
-    // Ensure consistent case on the first token and separate from
-    // subsequent arguments
-
-    char* arg = cmd;
-    while (*arg && !isspace(*arg))
-    {
-      *arg = tolower(*arg);
-      ++arg;
-    }
-
-    // Terminate first token (cmd)
-    if (*arg)
-    {
-      *arg = '\0';
-      ++arg;
-
-      while (isspace(*arg))
+      // Lines end with "\n", "\r\n" or "\r", as with vtkResourceParser.
+      const char* lineEnd = std::find_if(begin, end, [](char c) { return c == '\n' || c == '\r'; });
+      const std::string_view line(begin, static_cast<size_t>(lineEnd - begin));
+      begin = lineEnd;
+      if (begin != end && *begin++ == '\r' && begin != end && *begin == '\n')
       {
-        ++arg;
+        ++begin;
       }
-    }
-
-    ++lineNum;
 
-    // Handle all expected parsed elements
-    switch (state)
-    {
-      case scanSolid:
+      const auto type = scanner.ScanLine(line, arg);
+      if (type != stlASCIIScanner::OtherLine)
       {
-        if (!strcmp(cmd, "solid"))
-        {
-          ++solidId;
-          state = scanFacet; // Next state
-          if (!header.empty())
-          {
-            header += "\n";
-          }
-          if (*arg)
-          {
-            header += arg;
-            // strip end-of-line character from the end
-            while (!header.empty() && (header.back() == '\r' || header.back() == '\n'))
-            {
-              header.pop_back();
-            }
-          }
-        }
-        else
-        {
-          errorMessage = stlParseExpected("solid", cmd);
-        }
-        break;
-      }
-      case scanFacet:
-      {
-        if (!strcmp(cmd, "color"))
-        {
-          // Optional 'color' entry (after solid) - continue looking for 'facet'
-          continue;
-        }
-
-        if (!strcmp(cmd, "facet"))
-        {
-          state = scanLoop; // Next state
-        }
-        else if (!strcmp(cmd, "endsolid"))
-        {
-          // Finished with 'endsolid' - find next solid
-          state = scanSolid;
-        }
-        else
-        {
-          errorMessage = stlParseExpected("facet", cmd);
-        }
-        break;
+        vertices.push_back(arg);
       }
-      case scanLoop:
+      if (type == stlASCIIScanner::LastVertexLine)
       {
-        if (!strcmp(cmd, "outer")) // More pedantic => && !strcmp(arg, "loop")
+        ++numTris;
+        if (scalars)
         {
-          state = scanVerts; // Next state
+          scalars->InsertNextValue(scanner.SolidId);
         }
-        else
-        {
-          errorMessage = stlParseExpected("outer loop", cmd);
-        }
-        break;
       }
-      case scanVerts:
+    }
+
+    const vtkIdType numPts = static_cast<vtkIdType>(vertices.size());
+    newPts->SetDataTypeToFloat();
+    newPts->SetNumberOfPoints(numPts);
+    float* coords = vtkFloatArray::FastDownCast(newPts->GetData())->GetPointer(0);
+    std::atomic<vtkIdType> invalidPt(numPts);
+    vtkSMPTools::For(0, numPts,
+      [&](vtkIdType ptBegin, vtkIdType ptEnd)
       {
-        if (!strcmp(cmd, "vertex"))
+        for (vtkIdType ptId = ptBegin; ptId < ptEnd; ++ptId)
         {
-          if (stlReadVertex(arg, vertCoord))
+          if (!stlReadVertex(vertices[ptId], coords + 3 * ptId))
           {
-            pts[vertOff] = newPts->InsertNextPoint(vertCoord);
-            ++vertOff; // Next vertex
-
-            if (vertOff >= 3)
-            {
-              // Finished this triangle.
-              vertOff = 0;
-              state = scanEndLoop; // Next state
-
-              // Save as cell
-              newPolys->InsertNextCell(3, pts);
-              if (scalars)
-              {
-                scalars->InsertNextValue(solidId);
-              }
-
-              if ((newPolys->GetNumberOfCells() % 5000) == 0)
-              {
-                this->UpdateProgress((newPolys->GetNumberOfCells() % 50000) / 50000.0);
-              }
-            }
-          }
-          else
-          {
-            errorMessage = "Parse error reading STL vertex";
+            AtomicMin(invalidPt, ptId);
+            return;
           }
         }
-        else
-        {
-          errorMessage = stlParseExpected("vertex", cmd);
-        }
-        break;
+      });
+
+    // Keep what precedes the first invalid vertex, as when reading a stream.
+    if (invalidPt < numPts)
+    {
+      scanner.ErrorMessage = "Parse error reading STL vertex " + std::to_string(invalidPt.load());
+      newPts->SetNumberOfPoints(invalidPt);
+      numTris = std::min(numTris, invalidPt / 3);
+      if (scalars)
+      {
+        scalars->SetNumberOfTuples(numTris);
       }
-      case scanEndLoop:
+    }
+  }
+  else
+  {
+    vtkNew<vtkResourceParser> parser;
+    parser->SetStream(stream);
+    newPts->Allocate(5000);
+
+    std::string line;   // line buffer
+    float vertCoord[3]; // scratch space when parsing "vertex %f %f %f"
+    while (scanner.ErrorMessage.empty())
+    {
+      if (parser->ReadLine(line) == vtkParseResult::EndOfStream)
       {
-        if (!strcmp(cmd, "endloop"))
-        {
-          state = scanEndFacet; // Next state
-        }
-        else
-        {
-          errorMessage = stlParseExpected("endloop", cmd);
-        }
+        scanner.ScanEnd();
         break;
       }
-      case scanEndFacet:
+
+      const auto type = scanner.ScanLine(line, arg);
+      if (type == stlASCIIScanner::OtherLine)
       {
-        if (!strcmp(cmd, "endfacet"))
-        {
-          state = scanFacet; // Next facet, or endsolid
-        }
-        else
-        {
-          errorMessage = stlParseExpected("endfacet", cmd);
-        }
+        continue;
+      }
+      if (!stlReadVertex(arg, vertCoord))
+      {
+        scanner.ErrorMessage = "Parse error reading STL vertex";
         break;
       }
-      case scanEndSolid:
+      newPts->InsertNextPoint(vertCoord);
+      if (type == stlASCIIScanner::LastVertexLine)
       {
-        if (!strcmp(cmd, "endsolid"))
+        ++numTris;
+        if (scalars)
         {
-          state = scanSolid; // Start over again
+          scalars->InsertNextValue(scanner.SolidId);
         }
-        else
+
+        if ((numTris % 5000) == 0)
         {
-          errorMessage = stlParseExpected("endsolid", cmd);
+          this->UpdateProgress((numTris % 50000) / 50000.0);
         }
-        break;
       }
     }
   }
 
-  this->SetHeader(header.c_str());
+  stlSetTriangles(newPolys, numTris);
+  this->SetHeader(scanner.Header.c_str());
 
-  if (!errorMessage.empty())
+  if (!scanner.ErrorMessage.empty())
   {
-    vtkDebugMacro("STLReader: unable to read line " << lineNum << ": " << errorMessage);
+    vtkDebugMacro(
+      "STLReader: unable to read line " << scanner.LineNum << ": " << scanner.ErrorMessage);
     return false;
   }
 
@@ -12,8 +12,13 @@
  * .stl files are quite inefficient since they duplicate vertex
  * definitions. By setting the Merging boolean you can control whether the
  * point data is merged after reading. Merging is performed by default,
- * however, merging requires a large amount of temporary storage since a
- * 3D hash table must be constructed.
+ * however, merging requires a large amount of temporary storage since the
+ * points must be binned.
+ *
+ * Files are mapped in memory when possible. Binary facets, and the vertices
+ * of ASCII files mapped in memory or read from a vtkMemoryResourceStream, are
+ * converted concurrently, and points are merged concurrently with a
+ * vtkStaticPointLocator unless a Locator is specified.
  *
  * @warning
  * Binary files written on one system may not be readable on other systems.
@@ -31,7 +36,6 @@ class vtkCellArray;
 class vtkFloatArray;
 class vtkIncrementalPointLocator;
 class vtkPoints;
-class vtkResourceParser;
 class vtkResourceStream;
 
 class VTKIOGEOMETRY_EXPORT vtkSTLReader : public vtkAbstractPolyDataReader
@@ -96,8 +100,9 @@ public:
 
   ///@{
   /**
-   * Specify a spatial locator for merging points. By
-   * default an instance of vtkMergePoints is used.
+   * Specify a spatial locator for merging points, one point after the other.
+   * By default, points are merged concurrently with a vtkStaticPointLocator,
+   * which gives the same points as a vtkMergePoints.
    */
   void SetLocator(vtkIncrementalPointLocator* locator);
   vtkGetObjectMacro(Locator, vtkIncrementalPointLocator);
@@ -127,7 +132,7 @@ protected:
   ~vtkSTLReader() override;
 
   /**
-   * Create default locator. Used to create one when none is specified.
+   * Create a default incremental locator, a vtkMergePoints.
    */
   vtkIncrementalPointLocator* NewDefaultLocator();
 
@@ -153,7 +158,7 @@ private:
 
   bool ReadBinarySTL(vtkResourceStream* stream, vtkPoints*, vtkCellArray*);
   bool ReadASCIISTL(
-    vtkResourceParser* parser, vtkPoints*, vtkCellArray*, vtkFloatArray* scalars = nullptr);
+    vtkResourceStream* stream, vtkPoints*, vtkCellArray*, vtkFloatArray* scalars = nullptr);
 
   static bool ReadBinaryHeader(vtkResourceStream* stream, vtkUnsignedCharArray* header);
   static bool ReadBinaryTrisField(vtkResourceStream* stream, uint32_t& numTrisField);
@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that reading the steps of a temporal file with read ahead, forward,
+// backward and out of order, gives the same data as reading them without, and
+// that the parts of the file of the next step are loaded ahead when the steps
+// are read in sequence.
+
+#include "vtkCleanUnstructuredGrid.h"
+#include "vtkDataObject.h"
+#include "vtkHDFReader.h"
+#include "vtkHDFWriter.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointDataToCellData.h"
+#include "vtkSpatioTemporalHarmonicsSource.h"
+#include "vtkTestUtilities.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace
+{
+bool TestSteps(
+  const std::string& fileName, const std::vector<vtkIdType>& steps, bool inSequence)
+{
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->ReadAheadOn();
+  vtkNew<vtkHDFReader> expectedReader;
+  expectedReader->SetFileName(fileName.c_str());
+  for (std::size_t i = 0; i < steps.size(); ++i)
+  {
+    const vtkIdType step = steps[i];
+    reader->SetStep(step);
+    reader->Update();
+    expectedReader->SetStep(step);
+    expectedReader->Update();
+    if (!vtkTestUtilities::CompareDataObjects(
+          reader->GetOutputDataObject(0), expectedReader->GetOutputDataObject(0)))
+    {
+      vtkLog(ERROR, "Step " << step << " differs when read ahead.");
+      return false;
+    }
+    // The next step of a sequence is known from the second step read, until the last one.
+    const bool loadsAhead = inSequence && i > 0 && i + 1 < steps.size();
+    if (inSequence && (reader->GetReadAheadSize() > 0) != loadsAhead)
+    {
+      vtkLog(ERROR,
+        "Wrong size read ahead after step " << step << ": " << reader->GetReadAheadSize() << ".");
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestHDFReaderReadAhead(int argc, char* argv[])
+{
+  char* tempDirCStr =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string tempDir = tempDirCStr;
+  delete[] tempDirCStr;
+
+  // The mesh and the arrays of each step are appended to the file.
+  vtkNew<vtkSpatioTemporalHarmonicsSource> harmonics;
+  harmonics->SetWholeExtent(-20, 20, -20, 20, -10, 10);
+  vtkNew<vtkCleanUnstructuredGrid> toUnstructuredGrid;
+  toUnstructuredGrid->SetInputConnection(harmonics->GetOutputPort());
+  vtkNew<vtkPointDataToCellData> pointDataToCellData;
+  pointDataToCellData->SetPassPointData(true);
+  pointDataToCellData->SetInputConnection(toUnstructuredGrid->GetOutputPort());
+
+  const std::string fileName = tempDir + "/TestHDFReaderReadAhead.vtkhdf";
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetInputConnection(pointDataToCellData->GetOutputPort());
+  writer->SetFileName(fileName.c_str());
+  writer->SetWriteAllTimeSteps(true);
+  writer->SetChunkSize(4096);
+  if (!writer->Write())
+  {
+    vtkLog(ERROR, "Cannot write " << fileName << ".");
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->UpdateInformation();
+  const vtkIdType numberOfSteps = reader->GetNumberOfSteps();
+  if (numberOfSteps < 4)
+  {
+    vtkLog(ERROR, "Wrong number of steps in " << fileName << ": " << numberOfSteps << ".");
+    return EXIT_FAILURE;
+  }
+
+  std::vector<vtkIdType> forward;
+  std::vector<vtkIdType> backward;
+  for (vtkIdType step = 0; step < numberOfSteps; ++step)
+  {
+    forward.push_back(step);
+    backward.push_back(numberOfSteps - 1 - step);
+  }
+  const std::vector<vtkIdType> shuffled = { 1, 3, 0, 2, 2, numberOfSteps - 1, 1 };
+
+  return TestSteps(fileName, forward, true) && TestSteps(fileName, backward, true) &&
+      TestSteps(fileName, shuffled, false)
+    ? EXIT_SUCCESS
+    : EXIT_FAILURE;
+}
@@ -0,0 +1,166 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Write a temporal dataset with the compression methods of vtkHDFWriter, with
+// and without shuffling and automatic chunks, and check that it reads back as
+// written without compression. Zstandard is only tested with VTK::IOZstd.
+
+#include "vtkCleanUnstructuredGrid.h"
+#include "vtkDataObject.h"
+#include "vtkHDFReader.h"
+#include "vtkHDFWriter.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointDataToCellData.h"
+#include "vtkSpatioTemporalHarmonicsSource.h"
+#include "vtkTestUtilities.h"
+
+#include "vtk_hdf5.h"
+
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+#include "vtkZstdDataCompressor.h"
+#endif
+
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+constexpr int LZ4_FILTER_ID = 32004;
+constexpr int ZSTD_FILTER_ID = 32015;
+constexpr int COMPRESSION_LEVEL = 7;
+
+struct Configuration
+{
+  const char* Name;
+  int Method;
+  bool Shuffle;
+  int ChunkSize;
+};
+
+// Return whether the filters of the points of fileName are the expected ones.
+bool CheckFilters(const std::string& fileName, const Configuration& configuration)
+{
+  hid_t file = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+  hid_t dataset = H5Dopen(file, "/VTKHDF/Points", H5P_DEFAULT);
+  hid_t plist = H5Dget_create_plist(dataset);
+  const int numberOfFilters = H5Pget_nfilters(plist);
+  bool valid = numberOfFilters == (configuration.Shuffle ? 2 : 1);
+  for (int i = 0; valid && i < numberOfFilters; ++i)
+  {
+    unsigned int flags = 0;
+    std::size_t numberOfValues = 1;
+    unsigned int values[1] = { 0 };
+    const H5Z_filter_t filter =
+      H5Pget_filter2(plist, i, &flags, &numberOfValues, values, 0, nullptr, nullptr);
+    if (configuration.Shuffle && i == 0)
+    {
+      valid = filter == H5Z_FILTER_SHUFFLE;
+    }
+    else if (configuration.Method == vtkHDFWriter::LZ4)
+    {
+      valid = filter == LZ4_FILTER_ID;
+    }
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+    else if (configuration.Method == vtkHDFWriter::ZSTD)
+    {
+      // The native Zstandard level, as read by the HDF5 Zstandard filter plugin
+      valid = filter == ZSTD_FILTER_ID && numberOfValues == 1 &&
+        static_cast<int>(values[0]) ==
+          vtkZstdDataCompressor::ToZstdCompressionLevel(COMPRESSION_LEVEL);
+    }
+#endif
+    else
+    {
+      valid = filter == H5Z_FILTER_DEFLATE;
+    }
+  }
+  H5Pclose(plist);
+  H5Dclose(dataset);
+  H5Fclose(file);
+  return valid;
+}
+}
+
+int TestHDFWriterCompression(int argc, char* argv[])
+{
+  char* tempDirCStr =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string tempDir = tempDirCStr;
+  delete[] tempDirCStr;
+
+  vtkNew<vtkSpatioTemporalHarmonicsSource> harmonics;
+  harmonics->SetWholeExtent(-20, 20, -20, 20, -10, 10);
+  vtkNew<vtkCleanUnstructuredGrid> toUnstructuredGrid;
+  toUnstructuredGrid->SetInputConnection(harmonics->GetOutputPort());
+  vtkNew<vtkPointDataToCellData> pointDataToCellData;
+  pointDataToCellData->SetPassPointData(true);
+  pointDataToCellData->SetInputConnection(toUnstructuredGrid->GetOutputPort());
+
+  // Chunks of 1000 rows are not aligned with the steps appended
+  const std::string expectedFileName = tempDir + "/TestHDFWriterCompression.vtkhdf";
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetInputConnection(pointDataToCellData->GetOutputPort());
+  writer->SetWriteAllTimeSteps(true);
+  writer->SetChunkSize(1000);
+  writer->SetFileName(expectedFileName.c_str());
+  if (!writer->Write())
+  {
+    vtkLog(ERROR, "Cannot write " << expectedFileName << ".");
+    return EXIT_FAILURE;
+  }
+
+  const Configuration configurations[] = {
+    { "Deflate", vtkHDFWriter::DEFLATE, false, 1000 },
+    { "DeflateShuffle", vtkHDFWriter::DEFLATE, true, 1000 },
+    { "LZ4", vtkHDFWriter::LZ4, false, 1000 },
+    { "LZ4Shuffle", vtkHDFWriter::LZ4, true, 1000 },
+    { "LZ4Automatic", vtkHDFWriter::LZ4, true, 0 },
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+    { "Zstd", vtkHDFWriter::ZSTD, false, 1000 },
+    { "ZstdShuffle", vtkHDFWriter::ZSTD, true, 0 },
+#endif
+  };
+  for (const Configuration& configuration : configurations)
+  {
+    const std::string fileName =
+      tempDir + "/TestHDFWriterCompression" + configuration.Name + ".vtkhdf";
+    writer->SetFileName(fileName.c_str());
+    writer->SetChunkSize(configuration.ChunkSize);
+    writer->SetCompressionLevel(COMPRESSION_LEVEL);
+    writer->SetCompressionMethod(configuration.Method);
+    writer->SetShuffle(configuration.Shuffle);
+    if (!writer->Write())
+    {
+      vtkLog(ERROR, "Cannot write " << fileName << ".");
+      return EXIT_FAILURE;
+    }
+    if (!::CheckFilters(fileName, configuration))
+    {
+      vtkLog(ERROR, "Wrong filters in " << fileName << ".");
+      return EXIT_FAILURE;
+    }
+
+    vtkNew<vtkHDFReader> reader;
+    reader->SetFileName(fileName.c_str());
+    vtkNew<vtkHDFReader> expectedReader;
+    expectedReader->SetFileName(expectedFileName.c_str());
+    expectedReader->UpdateInformation();
+    const vtkIdType numberOfSteps = expectedReader->GetNumberOfSteps();
+    for (vtkIdType step = 0; step < numberOfSteps; ++step)
+    {
+      reader->SetStep(step);
+      reader->Update();
+      expectedReader->SetStep(step);
+      expectedReader->Update();
+      if (!vtkTestUtilities::CompareDataObjects(
+            reader->GetOutputDataObject(0), expectedReader->GetOutputDataObject(0)))
+      {
+        vtkLog(ERROR, "Step " << step << " of " << fileName << " differs.");
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -3,11 +3,14 @@
 
 #include "HDFTestUtilities.h"
 #include "vtkAppendDataSets.h"
+#include "vtkCellArray.h"
 #include "vtkCleanUnstructuredGrid.h"
 #include "vtkDataAssemblyUtilities.h"
 #include "vtkDataObjectTree.h"
 #include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
 #include "vtkExtractSurface.h"
+#include "vtkFieldData.h"
 #include "vtkForceStaticMesh.h"
 #include "vtkGroupDataSetsFilter.h"
 #include "vtkHDFReader.h"
@@ -17,12 +20,15 @@
 #include "vtkLogger.h"
 #include "vtkMergeBlocks.h"
 #include "vtkNew.h"
+#include "vtkObjectFactory.h"
 #include "vtkPartitionedDataSet.h"
 #include "vtkPartitionedDataSetCollection.h"
 #include "vtkPartitionedDataSetCollectionAlgorithm.h"
 #include "vtkPointData.h"
 #include "vtkPointDataToCellData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSOADataArrayTemplate.h"
 #include "vtkSpatioTemporalHarmonicsSource.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringFormatter.h"
@@ -30,8 +36,12 @@
 #include "vtkTesting.h"
 #include "vtkTransformFilter.h"
 #include "vtkUnstructuredGrid.h"
+#include "vtkUnstructuredGridAlgorithm.h"
 #include "vtkXMLUnstructuredGridWriter.h"
 
+#include <numeric>
+#include <vector>
+
 namespace HDFTestUtilities
 {
 vtkStandardNewMacro(vtkAddAssembly);
@@ -51,6 +61,77 @@ struct WriterConfigOptions
   bool UseExternalPartitions;
   std::string FileNameSuffix;
 };
+
+/**
+ * Source of many steps of the same vertices, with a point array stored by component and a field
+ * array changing every step.
+ */
+class vtkStaticVerticesSource : public vtkUnstructuredGridAlgorithm
+{
+public:
+  static vtkStaticVerticesSource* New();
+  vtkTypeMacro(vtkStaticVerticesSource, vtkUnstructuredGridAlgorithm);
+
+  static constexpr int NumberOfSteps = 300;
+  static constexpr vtkIdType NumberOfPoints = 1000;
+
+protected:
+  vtkStaticVerticesSource()
+  {
+    this->SetNumberOfInputPorts(0);
+    this->Points->SetNumberOfPoints(NumberOfPoints);
+    for (vtkIdType ptId = 0; ptId < NumberOfPoints; ++ptId)
+    {
+      this->Points->SetPoint(ptId, ptId, 0, 0);
+      this->Vertices->InsertNextCell(1, &ptId);
+    }
+  }
+
+  int RequestInformation(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    std::vector<double> times(NumberOfSteps);
+    std::iota(times.begin(), times.end(), 0.0);
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), times.data(), NumberOfSteps);
+    double range[2] = { times.front(), times.back() };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    return 1;
+  }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    const double time = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    vtkUnstructuredGrid* output = vtkUnstructuredGrid::GetData(outInfo);
+    output->SetPoints(this->Points);
+    output->SetCells(VTK_VERTEX, this->Vertices);
+
+    vtkNew<vtkSOADataArrayTemplate<double>> velocity;
+    velocity->SetName("Velocity");
+    velocity->SetNumberOfComponents(3);
+    velocity->SetNumberOfTuples(NumberOfPoints);
+    for (vtkIdType ptId = 0; ptId < NumberOfPoints; ++ptId)
+    {
+      velocity->SetTypedComponent(ptId, 0, ptId);
+      velocity->SetTypedComponent(ptId, 1, time);
+      velocity->SetTypedComponent(ptId, 2, ptId * time);
+    }
+    output->GetPointData()->AddArray(velocity);
+
+    vtkNew<vtkDoubleArray> timeArray;
+    timeArray->SetName("Time");
+    timeArray->InsertNextValue(time);
+    output->GetFieldData()->AddArray(timeArray);
+    return 1;
+  }
+
+private:
+  vtkNew<vtkPoints> Points;
+  vtkNew<vtkCellArray> Vertices;
+};
+vtkStandardNewMacro(vtkStaticVerticesSource);
 }
 
 //----------------------------------------------------------------------------
@@ -215,6 +296,58 @@ bool TestTemporalStaticMesh(
   return true;
 }
 
+//----------------------------------------------------------------------------
+bool TestTemporalStaticVertices(const std::string& tempDir)
+{
+  vtkNew<::vtkStaticVerticesSource> source;
+  vtkNew<vtkHDFWriter> HDFWriter;
+  HDFWriter->SetInputConnection(source->GetOutputPort());
+  const std::string tempPath = tempDir + "/HDFWriter_static_vertices.vtkhdf";
+  HDFWriter->SetFileName(tempPath.c_str());
+  HDFWriter->SetWriteAllTimeSteps(true);
+  HDFWriter->SetChunkSize(128);
+  if (!HDFWriter->Write())
+  {
+    vtkLog(ERROR, "An error occurred while writing " << tempPath);
+    return false;
+  }
+
+  vtkNew<vtkHDFReader> HDFReader;
+  HDFReader->SetFileName(tempPath.c_str());
+  HDFReader->UpdateInformation();
+  if (HDFReader->GetNumberOfSteps() != ::vtkStaticVerticesSource::NumberOfSteps)
+  {
+    vtkLog(ERROR, "Wrong number of steps in " << tempPath);
+    return false;
+  }
+  for (int step : { 0, 1, 150, ::vtkStaticVerticesSource::NumberOfSteps - 1 })
+  {
+    HDFReader->SetStep(step);
+    HDFReader->Update();
+    auto output = vtkUnstructuredGrid::SafeDownCast(HDFReader->GetOutputDataObject(0));
+    vtkDataArray* velocity = output ? output->GetPointData()->GetArray("Velocity") : nullptr;
+    vtkDataArray* timeArray = output ? output->GetFieldData()->GetArray("Time") : nullptr;
+    if (!velocity || !timeArray || timeArray->GetTuple1(0) != step ||
+      output->GetNumberOfPoints() != ::vtkStaticVerticesSource::NumberOfPoints ||
+      output->GetNumberOfCells() != ::vtkStaticVerticesSource::NumberOfPoints)
+    {
+      vtkLog(ERROR, "Wrong data at step " << step << " of " << tempPath);
+      return false;
+    }
+    for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+    {
+      const double* value = velocity->GetTuple3(ptId);
+      if (output->GetPoint(ptId)[0] != ptId || value[0] != ptId || value[1] != step ||
+        value[2] != ptId * step)
+      {
+        vtkLog(ERROR, "Wrong point " << ptId << " at step " << step << " of " << tempPath);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 bool TestTemporalComposite(const std::string& tempDir, const std::string& dataRoot,
   const std::vector<std::string>& baseNames, int compositeType)
@@ -402,5 +535,6 @@ int TestHDFWriterTemporal(int argc, char* argv[])
     tempDir, "transient_static_sphere_ug_source", ::supportedDataSetTypes::vtkUnstructuredGridType);
   result &= TestTemporalStaticMesh(
     tempDir, "transient_static_sphere_polydata_source", ::supportedDataSetTypes::vtkPolyDataType);
+  result &= TestTemporalStaticVertices(tempDir);
   return result ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -347,6 +347,8 @@ void vtkHDFReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Step: " << this->Step << "\n";
   os << indent << "TimeValue: " << this->TimeValue << "\n";
   os << indent << "TimeRange: " << this->TimeRange[0] << " - " << this->TimeRange[1] << "\n";
+  os << indent << "ReadAhead: " << (this->ReadAhead ? "true" : "false") << "\n";
+  os << indent << "ReadAheadSize: " << this->ReadAheadSize << "\n";
   if (this->Stream)
   {
     os << indent << "Stream: "
@@ -1890,6 +1892,13 @@ int vtkHDFReader::RequestData(vtkInformation* vtkNotUsed(request),
     return 0;
   }
 
+  // Read ahead needs a file that other threads can read.
+  const bool readAhead = this->ReadAhead && !this->Stream;
+  if (readAhead)
+  {
+    this->Impl->StartReadRecording(this->Step);
+  }
+
   this->CompositeCachePath.clear();
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
   if (!outInfo)
@@ -1914,6 +1923,15 @@ int vtkHDFReader::RequestData(vtkInformation* vtkNotUsed(request),
     // do this at the end because using cache may override this.
     output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), this->TimeValue);
   }
+  this->ReadAheadSize = 0;
+  if (readAhead && result && this->GetHasTemporalData())
+  {
+    this->ReadAheadSize = static_cast<vtkTypeInt64>(this->Impl->ReadAhead(this->NumberOfSteps));
+  }
+  else
+  {
+    this->Impl->CancelReadAhead();
+  }
   this->Impl->Close();
 
   return result ? 1 : 0;
@@ -183,6 +183,30 @@ public:
   vtkGetMacro(MaximumLevelsToReadByDefaultForAMR, unsigned int);
   ///@}
 
+  ///@{
+  /**
+   * Boolean property to read ahead the next time step (default is false).
+   * When reading temporal data, the parts of the file that the next time step is
+   * expected to be read from are read in the background while the current time
+   * step is processed. This only warms the page cache of the operating system:
+   * the next update still reads and decodes the step with HDF5 on the calling
+   * thread, without waiting on the disk. The next step continues the steps last
+   * read, forward or backward, and the parts it is read from are extrapolated
+   * from the reads of these steps, so read ahead starts with the second step
+   * read. This only applies when reading from a file, and does not cover image
+   * data and overlapping AMR.
+   */
+  vtkSetMacro(ReadAhead, bool);
+  vtkGetMacro(ReadAhead, bool);
+  vtkBooleanMacro(ReadAhead, bool);
+  ///@}
+
+  /**
+   * Get the number of bytes of the file that the last update started to load
+   * in the page cache for the next time step, see ReadAhead.
+   */
+  vtkGetMacro(ReadAheadSize, vtkTypeInt64);
+
   ///@{
   /**
    * Get or Set the Original id name of an attribute (POINT, CELL, FIELD...)
@@ -304,6 +328,9 @@ protected:
 
   unsigned int MaximumLevelsToReadByDefaultForAMR = 0;
 
+  bool ReadAhead = false;
+  vtkTypeInt64 ReadAheadSize = 0;
+
   bool UseCache = true;
   struct DataCache;
   std::shared_ptr<DataCache> Cache;
@@ -27,11 +27,15 @@
 #include "vtkPartitionedDataSetCollection.h"
 #include "vtkPolyData.h"
 #include "vtkStringFormatter.h"
+#include "vtkThreadedCallbackQueue.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <vtksys/FStream.hxx>
+
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <numeric>
 #include <sstream>
 
@@ -45,8 +49,166 @@ auto bitSizeToBytes = [](vtkIdType numBits)
 {
   return (numBits + BYTE_SIZE - 1) / BYTE_SIZE; // Integer 'ceil'
 };
+
+// Byte ranges of a file, as (offset, size)
+using FileRanges = std::vector<std::pair<hsize_t, hsize_t>>;
+
+// Size of the ranges loaded by each read ahead task, and of their reads.
+constexpr hsize_t READ_AHEAD_TASK_SIZE = 8 << 20;
+constexpr hsize_t READ_AHEAD_BLOCK_SIZE = 1 << 20;
+
+//------------------------------------------------------------------------------
+std::string GetObjectPath(hid_t object)
+{
+  const ssize_t length = H5Iget_name(object, nullptr, 0);
+  if (length <= 0)
+  {
+    return std::string();
+  }
+  std::vector<char> path(length + 1);
+  H5Iget_name(object, path.data(), path.size());
+  return std::string(path.data(), length);
 }
 
+//------------------------------------------------------------------------------
+// Append the byte ranges of the file of dataset `path` that store its rows
+// [start, end) to `ranges`, by file name. Compact datasets, stored in the
+// object header, and virtual datasets are ignored.
+void AppendFileRanges(hid_t file, const std::string& path, hsize_t start, hsize_t end,
+  std::map<std::string, FileRanges>& ranges)
+{
+  vtkHDF::ScopedH5DHandle dataset = H5Dopen(file, path.c_str(), H5P_DEFAULT);
+  if (dataset < 0)
+  {
+    return;
+  }
+  vtkHDF::ScopedH5SHandle dataspace = H5Dget_space(dataset);
+  const int rank = H5Sget_simple_extent_ndims(dataspace);
+  if (rank < 1)
+  {
+    return;
+  }
+  std::vector<hsize_t> dims(rank);
+  H5Sget_simple_extent_dims(dataspace, dims.data(), nullptr);
+  end = std::min(end, dims[0]);
+  if (start >= end)
+  {
+    return;
+  }
+
+  const ssize_t fileNameLength = H5Fget_name(dataset, nullptr, 0);
+  if (fileNameLength <= 0)
+  {
+    return;
+  }
+  std::vector<char> fileName(fileNameLength + 1);
+  H5Fget_name(dataset, fileName.data(), fileName.size());
+  FileRanges& fileRanges = ranges[std::string(fileName.data(), fileNameLength)];
+
+  vtkHDF::ScopedH5PHandle plist = H5Dget_create_plist(dataset);
+  const H5D_layout_t layout = H5Pget_layout(plist);
+  if (layout == H5D_CONTIGUOUS)
+  {
+    vtkHDF::ScopedH5THandle type = H5Dget_type(dataset);
+    hsize_t rowSize = H5Tget_size(type);
+    for (int i = 1; i < rank; ++i)
+    {
+      rowSize *= dims[i];
+    }
+    const haddr_t address = H5Dget_offset(dataset);
+    if (address != HADDR_UNDEF)
+    {
+      fileRanges.emplace_back(address + start * rowSize, (end - start) * rowSize);
+    }
+  }
+  else if (layout == H5D_CHUNKED)
+  {
+    std::vector<hsize_t> chunkDims(rank);
+    if (H5Pget_chunk(plist, rank, chunkDims.data()) != rank)
+    {
+      return;
+    }
+    // Visit the chunks holding the rows, last dimension first.
+    std::vector<hsize_t> coords(rank, 0);
+    coords[0] = start / chunkDims[0] * chunkDims[0];
+    while (coords[0] < end)
+    {
+      unsigned filterMask = 0;
+      haddr_t address = HADDR_UNDEF;
+      hsize_t size = 0;
+      if (H5Dget_chunk_info_by_coord(dataset, coords.data(), &filterMask, &address, &size) >= 0 &&
+        address != HADDR_UNDEF && size > 0)
+      {
+        fileRanges.emplace_back(address, size);
+      }
+      int dim = rank - 1;
+      for (; dim > 0; --dim)
+      {
+        coords[dim] += chunkDims[dim];
+        if (coords[dim] < dims[dim])
+        {
+          break;
+        }
+        coords[dim] = 0;
+      }
+      if (dim == 0)
+      {
+        coords[0] += chunkDims[0];
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Read a byte range of a file and discard it, so that it is in the cache of the
+// operating system when HDF5 reads it.
+void LoadFileRange(const std::string& fileName, hsize_t offset, hsize_t size,
+  const std::shared_ptr<std::atomic<bool>>& canceled)
+{
+  vtksys::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  file.seekg(static_cast<std::streamoff>(offset));
+  std::vector<char> buffer(std::min(size, READ_AHEAD_BLOCK_SIZE));
+  while (size > 0 && file && !*canceled)
+  {
+    const hsize_t blockSize = std::min(size, READ_AHEAD_BLOCK_SIZE);
+    file.read(buffer.data(), static_cast<std::streamsize>(blockSize));
+    size -= blockSize;
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+struct vtkHDFReader::Implementation::ReadAheadInformation
+{
+  // Rows [first, second) read, by dataset path and rank of the read among the
+  // reads of this dataset for a step.
+  using ReadMap = std::map<std::pair<std::string, int>, std::pair<hsize_t, hsize_t>>;
+
+  ReadAheadInformation() { this->Queue->SetNumberOfThreads(4); }
+  ~ReadAheadInformation() { this->Cancel(); }
+
+  void Cancel()
+  {
+    if (this->Canceled)
+    {
+      *this->Canceled = true;
+      this->Canceled = nullptr;
+    }
+  }
+
+  std::string FileName;
+  bool Recording = false;
+  vtkIdType Step = -1;
+  ReadMap Reads;
+  std::map<std::string, int> NumberOfReads;
+  vtkIdType PreviousStep = -1;
+  ReadMap PreviousReads;
+
+  // Shared with the tasks loading the current read ahead.
+  std::shared_ptr<std::atomic<bool>> Canceled;
+  vtkNew<vtkThreadedCallbackQueue> Queue;
+};
+
 //------------------------------------------------------------------------------
 vtkHDFReader::Implementation::Implementation(vtkHDFReader* reader)
   : File(-1)
@@ -63,6 +225,7 @@ vtkHDFReader::Implementation::Implementation(vtkHDFReader* reader)
 vtkHDFReader::Implementation::~Implementation()
 {
   this->Close();
+  this->CancelReadAhead();
 }
 
 //------------------------------------------------------------------------------
@@ -310,6 +473,10 @@ std::vector<std::string> vtkHDFReader::Implementation::GetOrderedChildrenOfGroup
 vtkDataArray* vtkHDFReader::Implementation::NewArray(
   int attributeType, const char* name, const std::vector<hsize_t>& fileExtent)
 {
+  if (fileExtent.size() == 2)
+  {
+    this->RecordRead(this->AttributeDataGroup[attributeType], name, fileExtent[0], fileExtent[1]);
+  }
   return vtkHDFUtilities::NewArrayForGroup(
     this->AttributeDataGroup[attributeType], name, fileExtent);
 }
@@ -319,6 +486,7 @@ vtkDataArray* vtkHDFReader::Implementation::NewArray(
   int attributeType, const char* name, hsize_t offset, hsize_t size)
 {
   std::vector<hsize_t> fileExtent = { offset, offset + size };
+  this->RecordRead(this->AttributeDataGroup[attributeType], name, offset, offset + size);
   return vtkHDFUtilities::NewArrayForGroup(
     this->AttributeDataGroup[attributeType], name, fileExtent);
 }
@@ -327,6 +495,10 @@ vtkDataArray* vtkHDFReader::Implementation::NewArray(
 vtkAbstractArray* vtkHDFReader::Implementation::NewFieldArray(
   const char* name, vtkIdType offset, vtkIdType size, vtkIdType dimMaxSize)
 {
+  if (offset >= 0 && size > 0)
+  {
+    this->RecordRead(this->AttributeDataGroup[vtkDataObject::FIELD], name, offset, offset + size);
+  }
   return vtkHDFUtilities::NewFieldArray(this->AttributeDataGroup, name, offset, size, dimMaxSize);
 }
 
@@ -335,9 +507,133 @@ vtkDataArray* vtkHDFReader::Implementation::NewMetadataArray(
   const char* name, hsize_t offset, hsize_t size)
 {
   std::vector<hsize_t> fileExtent = { offset, offset + size };
+  this->RecordRead(this->VTKGroup, name, offset, offset + size);
   return vtkHDFUtilities::NewArrayForGroup(this->VTKGroup, name, fileExtent);
 }
 
+//------------------------------------------------------------------------------
+void vtkHDFReader::Implementation::RecordRead(
+  hid_t group, const char* name, hsize_t start, hsize_t end)
+{
+  if (!this->ReadAheadInfo || !this->ReadAheadInfo->Recording || group < 0 || start >= end)
+  {
+    return;
+  }
+  const std::string path = ::GetObjectPath(group) + "/" + name;
+  ReadAheadInformation& info = *this->ReadAheadInfo;
+  info.Reads[{ path, info.NumberOfReads[path]++ }] = { start, end };
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFReader::Implementation::StartReadRecording(vtkIdType step)
+{
+  if (!this->ReadAheadInfo)
+  {
+    this->ReadAheadInfo.reset(new ReadAheadInformation());
+  }
+  ReadAheadInformation& info = *this->ReadAheadInfo;
+  if (info.FileName != this->FileName)
+  {
+    info.Cancel();
+    info.FileName = this->FileName;
+    info.Step = -1;
+    info.Reads.clear();
+  }
+  // Reading the same step again, with other arrays for instance, keeps the
+  // previous step.
+  if (info.Step != step)
+  {
+    info.PreviousStep = info.Step;
+    info.PreviousReads = std::move(info.Reads);
+  }
+  info.Step = step;
+  info.Reads.clear();
+  info.NumberOfReads.clear();
+  info.Recording = true;
+}
+
+//------------------------------------------------------------------------------
+hsize_t vtkHDFReader::Implementation::ReadAhead(vtkIdType numberOfSteps)
+{
+  if (!this->ReadAheadInfo)
+  {
+    return 0;
+  }
+  ReadAheadInformation& info = *this->ReadAheadInfo;
+  info.Recording = false;
+  const vtkIdType nextStep = 2 * info.Step - info.PreviousStep;
+  if (this->File < 0 || info.PreviousStep < 0 || nextStep < 0 || nextStep >= numberOfSteps)
+  {
+    return 0;
+  }
+
+  // The rows read are expected to move by the same number of rows from one
+  // step to the next, which holds for data appended step after step. Rows
+  // that do not move, such as those of a static mesh, are already in memory.
+  std::map<std::string, FileRanges> ranges;
+  for (const auto& read : info.Reads)
+  {
+    auto previous = info.PreviousReads.find(read.first);
+    if (previous == info.PreviousReads.end() || previous->second.first == read.second.first)
+    {
+      continue;
+    }
+    const hsize_t start = read.second.first;
+    const hsize_t previousStart = previous->second.first;
+    if (start < previousStart && previousStart - start > start)
+    {
+      continue;
+    }
+    const hsize_t nextStart = start < previousStart ? start - (previousStart - start)
+                                                    : start + (start - previousStart);
+    ::AppendFileRanges(
+      this->File, read.first.first, nextStart, nextStart + (read.second.second - start), ranges);
+  }
+
+  // Merge the ranges and split them in tasks.
+  info.Cancel();
+  info.Canceled = std::make_shared<std::atomic<bool>>(false);
+  hsize_t loadedSize = 0;
+  for (auto& fileRanges : ranges)
+  {
+    FileRanges& fRanges = fileRanges.second;
+    std::sort(fRanges.begin(), fRanges.end());
+    FileRanges merged;
+    for (const auto& range : fRanges)
+    {
+      if (!merged.empty() && range.first <= merged.back().first + merged.back().second)
+      {
+        merged.back().second =
+          std::max(merged.back().second, range.first + range.second - merged.back().first);
+      }
+      else
+      {
+        merged.emplace_back(range);
+      }
+    }
+    for (const auto& range : merged)
+    {
+      loadedSize += range.second;
+      for (hsize_t offset = 0; offset < range.second; offset += READ_AHEAD_TASK_SIZE)
+      {
+        info.Queue->Push(&::LoadFileRange, fileRanges.first, range.first + offset,
+          std::min(READ_AHEAD_TASK_SIZE, range.second - offset), info.Canceled);
+      }
+    }
+  }
+  return loadedSize;
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFReader::Implementation::CancelReadAhead()
+{
+  if (this->ReadAheadInfo)
+  {
+    this->ReadAheadInfo->Recording = false;
+    this->ReadAheadInfo->Cancel();
+  }
+}
+
 //------------------------------------------------------------------------------
 std::vector<vtkIdType> vtkHDFReader::Implementation::GetMetadata(
   const char* name, hsize_t size, hsize_t offset)
@@ -13,6 +13,7 @@
 #include "vtk_hdf5.h"
 #include <array>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -252,6 +253,20 @@ public:
   bool AppendMaskForHyperTree(vtkHyperTreeGrid* htg, vtkIdType inputCellOffset,
     vtkIdType maskOffset, vtkIdType readableTreeSize);
 
+  ///@{
+  /**
+   * Read ahead support. `StartReadRecording` records the ranges of rows read
+   * for `step` from now on. `ReadAhead` stops recording and loads in the
+   * background the parts of the file that the next step is expected to be read
+   * from, the next step following `step` as `step` follows the previous
+   * recorded step, and returns their size in bytes. `CancelReadAhead` stops
+   * loading.
+   */
+  void StartReadRecording(vtkIdType step);
+  hsize_t ReadAhead(vtkIdType numberOfSteps);
+  void CancelReadAhead();
+  ///@}
+
 private:
   std::string FileName;
   vtkResourceStream* Stream = nullptr;
@@ -265,6 +280,15 @@ private:
   std::array<int, 2> Version;
   vtkHDFReader* Reader;
 
+  struct ReadAheadInformation;
+  std::unique_ptr<ReadAheadInformation> ReadAheadInfo;
+
+  /**
+   * Record that rows [start, end) of dataset `name` of `group` are read, if
+   * recording.
+   */
+  void RecordRead(hid_t group, const char* name, hsize_t start, hsize_t end);
+
   ///@{
   /**
    * Specific methods and structure of AMR support.
@@ -7,6 +7,7 @@
 #include "vtkHDFUtilities.h"
 
 #include "vtkCharArray.h"
+#include "vtkDataCompressor.h"
 #include "vtkDoubleArray.h"
 #include "vtkFieldData.h"
 #include "vtkFloatArray.h"
@@ -25,6 +26,13 @@
 #include "vtkUnsignedLongLongArray.h"
 #include "vtkUnsignedShortArray.h"
 
+#include "vtk_lz4.h"
+
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+#include "vtkNew.h"
+#include "vtkZstdDataCompressor.h"
+#endif
+
 #include <algorithm>
 #include <iostream>
 #include <iterator>
@@ -283,6 +291,167 @@ ArrayReader* GetArrayBuilder(hid_t type)
   return it->second;
 }
 
+//-----------------------------------------------------------------------------
+// The LZ4 filter stores the size of the data as a big endian 64 bits integer,
+// and the size of the blocks as a 32 bits one. Each block is then stored after
+// its compressed size, as a 32 bits integer. A block as large as its
+// compressed size is stored as is.
+constexpr std::size_t LZ4_HEADER_SIZE = 12;
+constexpr std::size_t LZ4_DEFAULT_BLOCK_SIZE = 1 << 30;
+
+void WriteBigEndian(vtkTypeUInt64 value, int numberOfBytes, unsigned char* output)
+{
+  for (int i = numberOfBytes - 1; i >= 0; --i)
+  {
+    output[i] = static_cast<unsigned char>(value & 0xff);
+    value >>= 8;
+  }
+}
+
+vtkTypeUInt64 ReadBigEndian(const unsigned char* input, int numberOfBytes)
+{
+  vtkTypeUInt64 value = 0;
+  for (int i = 0; i < numberOfBytes; ++i)
+  {
+    value = (value << 8) | input[i];
+  }
+  return value;
+}
+
+//-----------------------------------------------------------------------------
+bool DecompressLZ4(const unsigned char* input, std::size_t inputSize, unsigned char* output,
+  std::size_t outputSize, std::size_t blockSize)
+{
+  std::size_t inputPos = LZ4_HEADER_SIZE;
+  for (std::size_t outputPos = 0; outputPos < outputSize; outputPos += blockSize)
+  {
+    blockSize = std::min(blockSize, outputSize - outputPos);
+    if (inputPos + 4 > inputSize)
+    {
+      return false;
+    }
+    const std::size_t compressedSize = ReadBigEndian(input + inputPos, 4);
+    inputPos += 4;
+    if (compressedSize > inputSize - inputPos)
+    {
+      return false;
+    }
+    if (compressedSize == blockSize)
+    {
+      std::copy_n(input + inputPos, blockSize, output + outputPos);
+    }
+    else if (LZ4_decompress_safe(reinterpret_cast<const char*>(input + inputPos),
+               reinterpret_cast<char*>(output + outputPos), static_cast<int>(compressedSize),
+               static_cast<int>(blockSize)) != static_cast<int>(blockSize))
+    {
+      return false;
+    }
+    inputPos += compressedSize;
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+// HDF5 filter function of the LZ4 filter. The buffer is replaced by the
+// filtered one, whose size is returned, or 0 on failure.
+size_t LZ4Filter(unsigned int flags, size_t cdNbElements, const unsigned int cdValues[],
+  size_t nbytes, size_t* bufferSize, void** buffer)
+{
+  const auto input = static_cast<const unsigned char*>(*buffer);
+  void* output = nullptr;
+  std::size_t outputSize = 0;
+  if (flags & H5Z_FLAG_REVERSE)
+  {
+    if (nbytes < LZ4_HEADER_SIZE)
+    {
+      return 0;
+    }
+    outputSize = ReadBigEndian(input, 8);
+    const std::size_t blockSize = ReadBigEndian(input + 8, 4);
+    output = H5allocate_memory(outputSize, false);
+    if (!output || blockSize == 0 ||
+      !DecompressLZ4(input, nbytes, static_cast<unsigned char*>(output), outputSize, blockSize))
+    {
+      H5free_memory(output);
+      return 0;
+    }
+  }
+  else
+  {
+    std::vector<unsigned char> compressed;
+    if (!vtkHDFUtilities::CompressLZ4(
+          input, nbytes, cdNbElements > 0 ? cdValues[0] : 0, compressed))
+    {
+      return 0;
+    }
+    outputSize = compressed.size();
+    output = H5allocate_memory(outputSize, false);
+    if (!output)
+    {
+      return 0;
+    }
+    std::copy(compressed.begin(), compressed.end(), static_cast<unsigned char*>(output));
+  }
+  H5free_memory(*buffer);
+  *buffer = output;
+  *bufferSize = outputSize;
+  return outputSize;
+}
+
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+//-----------------------------------------------------------------------------
+constexpr int ZSTD_DEFAULT_LEVEL = 3;
+
+// HDF5 filter function of the Zstandard filter. Each chunk is a single
+// Zstandard frame, which stores the size of the data. The only value of the
+// filter is the native Zstandard level, 3 by default, as for the HDF5
+// Zstandard filter plugin.
+size_t ZstdFilter(unsigned int flags, size_t cdNbElements, const unsigned int cdValues[],
+  size_t nbytes, size_t* bufferSize, void** buffer)
+{
+  const auto input = static_cast<const unsigned char*>(*buffer);
+  vtkNew<vtkZstdDataCompressor> compressor;
+  void* output = nullptr;
+  std::size_t outputSize = 0;
+  if (flags & H5Z_FLAG_REVERSE)
+  {
+    if (!vtkZstdDataCompressor::GetUncompressedSize(input, nbytes, outputSize))
+    {
+      return 0;
+    }
+    output = H5allocate_memory(outputSize, false);
+    if (!output ||
+      compressor->Uncompress(input, nbytes, static_cast<unsigned char*>(output), outputSize) !=
+        outputSize)
+    {
+      H5free_memory(output);
+      return 0;
+    }
+  }
+  else
+  {
+    compressor->SetZstdCompressionLevel(
+      cdNbElements > 0 ? static_cast<int>(cdValues[0]) : ::ZSTD_DEFAULT_LEVEL);
+    std::vector<unsigned char> compressed;
+    if (!vtkHDFUtilities::Compress(compressor, input, nbytes, compressed))
+    {
+      return 0;
+    }
+    outputSize = compressed.size();
+    output = H5allocate_memory(outputSize, false);
+    if (!output)
+    {
+      return 0;
+    }
+    std::copy(compressed.begin(), compressed.end(), static_cast<unsigned char*>(output));
+  }
+  H5free_memory(*buffer);
+  *buffer = output;
+  *bufferSize = outputSize;
+  return outputSize;
+}
+#endif
+
 //-----------------------------------------------------------------------------
 herr_t AddName(hid_t group, const char* name, const H5L_info_t*, void* op_data)
 {
@@ -521,6 +690,78 @@ void vtkHDFUtilities::MakeObjectNameValid(std::string& objectName)
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkHDFUtilities::RegisterFilters()
+{
+  static const H5Z_class2_t lz4Class = { H5Z_CLASS_T_VERS, LZ4_FILTER_ID,
+    /*encoder_present=*/1, /*decoder_present=*/1, "lz4", /*can_apply=*/nullptr,
+    /*set_local=*/nullptr, ::LZ4Filter };
+  if (H5Zfilter_avail(LZ4_FILTER_ID) <= 0 && H5Zregister(&lz4Class) < 0)
+  {
+    vtkErrorWithObjectMacro(nullptr, "Could not register the LZ4 filter.");
+  }
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+  static const H5Z_class2_t zstdClass = { H5Z_CLASS_T_VERS, ZSTD_FILTER_ID,
+    /*encoder_present=*/1, /*decoder_present=*/1, "zstd", /*can_apply=*/nullptr,
+    /*set_local=*/nullptr, ::ZstdFilter };
+  if (H5Zfilter_avail(ZSTD_FILTER_ID) <= 0 && H5Zregister(&zstdClass) < 0)
+  {
+    vtkErrorWithObjectMacro(nullptr, "Could not register the Zstandard filter.");
+  }
+#endif
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFUtilities::CompressLZ4(
+  const void* data, std::size_t size, std::size_t blockSize, std::vector<unsigned char>& output)
+{
+  if (blockSize == 0)
+  {
+    blockSize = ::LZ4_DEFAULT_BLOCK_SIZE;
+  }
+  blockSize = std::max<std::size_t>(std::min(blockSize, size), 1);
+  const std::size_t numberOfBlocks = (size + blockSize - 1) / blockSize;
+  output.resize(::LZ4_HEADER_SIZE +
+    numberOfBlocks * (4 + LZ4_compressBound(static_cast<int>(blockSize))));
+  ::WriteBigEndian(size, 8, output.data());
+  ::WriteBigEndian(blockSize, 4, output.data() + 8);
+
+  const auto input = static_cast<const unsigned char*>(data);
+  std::size_t outputPos = ::LZ4_HEADER_SIZE;
+  for (std::size_t inputPos = 0; inputPos < size; inputPos += blockSize)
+  {
+    const std::size_t currentBlockSize = std::min(blockSize, size - inputPos);
+    unsigned char* block = output.data() + outputPos + 4;
+    int compressedSize = LZ4_compress_default(reinterpret_cast<const char*>(input + inputPos),
+      reinterpret_cast<char*>(block), static_cast<int>(currentBlockSize),
+      static_cast<int>(output.size() - outputPos - 4));
+    if (compressedSize <= 0)
+    {
+      return false;
+    }
+    if (static_cast<std::size_t>(compressedSize) >= currentBlockSize)
+    {
+      std::copy_n(input + inputPos, currentBlockSize, block);
+      compressedSize = static_cast<int>(currentBlockSize);
+    }
+    ::WriteBigEndian(compressedSize, 4, output.data() + outputPos);
+    outputPos += 4 + compressedSize;
+  }
+  output.resize(outputPos);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFUtilities::Compress(vtkDataCompressor* compressor, const void* data, std::size_t size,
+  std::vector<unsigned char>& output)
+{
+  output.resize(compressor->GetMaximumCompressionSpace(size));
+  const std::size_t compressedSize = compressor->Compress(
+    static_cast<const unsigned char*>(data), size, output.data(), output.size());
+  output.resize(compressedSize);
+  return compressedSize > 0;
+}
+
 //------------------------------------------------------------------------------
 bool vtkHDFUtilities::Open(const char* fileName, hid_t& fileID)
 {
@@ -530,6 +771,7 @@ bool vtkHDFUtilities::Open(const char* fileName, hid_t& fileID)
     return false;
   }
 
+  vtkHDFUtilities::RegisterFilters();
   fileID = H5Fopen(fileName, H5F_ACC_RDONLY, H5P_DEFAULT);
   if (fileID < 0)
   {
@@ -549,6 +791,7 @@ bool vtkHDFUtilities::Open(vtkMemoryResourceStream* stream, hid_t& fileImageID)
     return false;
   }
 
+  vtkHDFUtilities::RegisterFilters();
   fileImageID = H5LTopen_file_image((void*)(stream->GetBuffer()), stream->GetSize(),
     H5LT_FILE_IMAGE_DONT_COPY | H5LT_FILE_IMAGE_DONT_RELEASE);
   if (fileImageID < 0)
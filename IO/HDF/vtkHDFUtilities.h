@@ -34,6 +34,7 @@ VTK_ABI_NAMESPACE_BEGIN
 #error "No HDF5 type available for vtkIdType"
 #endif
 
+class vtkDataCompressor;
 class vtkMemoryResourceStream;
 
 namespace vtkHDFUtilities
@@ -57,6 +58,18 @@ const std::vector<std::string> POLY_DATA_TOPOS{ "Vertices", "Lines", "Polygons",
  */
 constexpr int GEOMETRY_ATTRIBUTE_TAG = -42;
 
+/*
+ * Identifier of the LZ4 filter registered with The HDF Group. Data compressed
+ * with it are readable by the HDF5 LZ4 filter plugin.
+ */
+constexpr int LZ4_FILTER_ID = 32004;
+
+/*
+ * Identifier of the Zstandard filter registered with The HDF Group. Data
+ * compressed with it are readable by the HDF5 Zstandard filter plugin.
+ */
+constexpr int ZSTD_FILTER_ID = 32015;
+
 /*
  * How many attribute types we have. This returns 3: point, cell and field
  * attribute types.
@@ -156,6 +169,29 @@ VTKIOHDF_EXPORT bool Open(const char* fileName, hid_t& fileID);
  */
 VTKIOHDF_EXPORT bool Open(vtkMemoryResourceStream* stream, hid_t& fileImageID);
 
+/**
+ * Register with HDF5 the filters implemented by VTK, so that the datasets using
+ * them can be read and written. This is LZ4_FILTER_ID, and ZSTD_FILTER_ID when
+ * the VTK::IOZstd module is enabled. Filters already available, from a plugin
+ * for instance, are left as is.
+ */
+VTKIOHDF_EXPORT void RegisterFilters();
+
+/**
+ * Compress `size` bytes of `data` to `output` as the LZ4 filter does, in
+ * blocks of `blockSize` bytes, or in a single block if `blockSize` is 0.
+ * Returns false on failure.
+ */
+VTKIOHDF_EXPORT bool CompressLZ4(
+  const void* data, std::size_t size, std::size_t blockSize, std::vector<unsigned char>& output);
+
+/**
+ * Compress `size` bytes of `data` to `output` with `compressor`, which may be
+ * used by several threads at once if it supports it. Returns false on failure.
+ */
+VTKIOHDF_EXPORT bool Compress(vtkDataCompressor* compressor, const void* data, std::size_t size,
+  std::vector<unsigned char>& output);
+
 /**
  * Convert C++ template type T to HDF5 native type
  * this can be constexpr in C++17 standard
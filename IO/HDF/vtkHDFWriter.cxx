@@ -29,6 +29,7 @@
 #include "vtkType.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <string>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -40,9 +41,8 @@ namespace
 constexpr int NUM_POLY_DATA_TOPOS = 4;
 constexpr hsize_t SINGLE_COLUMN = 1;
 
-// Used for chunked arrays with 4 columns (polydata primitive topologies)
-hsize_t PRIMITIVE_CHUNK[] = { 1, NUM_POLY_DATA_TOPOS };
-hsize_t SMALL_CHUNK[] = { 1, 1 }; // Used for chunked arrays where values are read one by one
+// Maximum number of rows of the chunks of datasets where values are appended every step
+constexpr vtkIdType MAX_STEPS_PER_CHUNK = 1024;
 
 /**
  * Return the name of a partitioned dataset in a pdc given its index.
@@ -236,6 +236,28 @@ void vtkHDFWriter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Overwrite: " << (this->Overwrite ? "yes" : "no") << "\n";
   os << indent << "WriteAllTimeSteps: " << (this->WriteAllTimeSteps ? "yes" : "no") << "\n";
   os << indent << "ChunkSize: " << this->ChunkSize << "\n";
+  os << indent << "CompressionLevel: " << this->CompressionLevel << "\n";
+  const char* const methodNames[] = { "DEFLATE", "LZ4", "ZSTD" };
+  os << indent << "CompressionMethod: " << methodNames[this->CompressionMethod] << "\n";
+  os << indent << "Shuffle: " << (this->Shuffle ? "yes" : "no") << "\n";
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFWriter::SetCompressionMethod(int method)
+{
+  method = std::min(std::max(method, static_cast<int>(DEFLATE)), static_cast<int>(ZSTD));
+#if !VTK_MODULE_ENABLE_VTK_IOZstd
+  if (method == ZSTD)
+  {
+    vtkWarningMacro("Zstandard compression requires the VTK::IOZstd module.");
+    return;
+  }
+#endif
+  if (this->CompressionMethod != method)
+  {
+    this->CompressionMethod = method;
+    this->Modified();
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -279,6 +301,8 @@ void vtkHDFWriter::WriteData()
     writer->SetInputData(input);
     writer->SetFileName(subFilePath.c_str());
     writer->SetCompressionLevel(this->CompressionLevel);
+    writer->SetCompressionMethod(this->CompressionMethod);
+    writer->SetShuffle(this->Shuffle);
     writer->SetChunkSize(this->ChunkSize);
     writer->SetUseExternalComposite(this->UseExternalComposite);
     writer->SetUseExternalPartitions(this->UseExternalPartitions);
@@ -505,6 +529,8 @@ bool vtkHDFWriter::WriteDatasetToFile(hid_t group, vtkPartitionedDataSet* input)
       writer->SetInputData(input->GetPartition(partIndex));
       writer->SetFileName(subFilePath.c_str());
       writer->SetCompressionLevel(this->CompressionLevel);
+      writer->SetCompressionMethod(this->CompressionMethod);
+      writer->SetShuffle(this->Shuffle);
       writer->SetChunkSize(this->ChunkSize);
       writer->SetUseExternalComposite(this->UseExternalComposite);
       writer->SetUseExternalPartitions(this->UseExternalPartitions);
@@ -675,11 +701,16 @@ bool vtkHDFWriter::UpdateStepsGroup(hid_t group, vtkPolyData* input)
   vtkHDF::ScopedH5DHandle connectivityOffsetsHandle =
     this->Impl->OpenDataset(stepsGroup, "ConnectivityIdOffsets");
 
-  // Get the connectivity offsets for the previous timestep
-  std::vector<vtkIdType> allValues;
-  allValues.resize(NUM_POLY_DATA_TOPOS * (this->CurrentTimeIndex + 1));
-  H5Dread(connectivityOffsetsHandle, VTK_ID_H5T, H5Dget_space(connectivityOffsetsHandle), H5S_ALL,
-    H5P_DEFAULT, allValues.data());
+  // Get the connectivity offsets for the previous timestep, the last row of the dataset
+  std::vector<vtkIdType> previousValues(NUM_POLY_DATA_TOPOS, 0);
+  hsize_t previousStart[] = { static_cast<hsize_t>(this->CurrentTimeIndex), 0 };
+  hsize_t previousCount[] = { 1, NUM_POLY_DATA_TOPOS };
+  vtkHDF::ScopedH5SHandle previousFileSpace = H5Dget_space(connectivityOffsetsHandle);
+  vtkHDF::ScopedH5SHandle previousMemSpace = H5Screate_simple(2, previousCount, nullptr);
+  H5Sselect_hyperslab(
+    previousFileSpace, H5S_SELECT_SET, previousStart, nullptr, previousCount, nullptr);
+  H5Dread(connectivityOffsetsHandle, VTK_ID_H5T, previousMemSpace, previousFileSpace, H5P_DEFAULT,
+    previousValues.data());
 
   // Offset the offset by the previous timestep's offset
   std::vector<vtkIdType> connectivityOffsetArray{ 0, 0, 0, 0 };
@@ -689,7 +720,7 @@ bool vtkHDFWriter::UpdateStepsGroup(hid_t group, vtkPolyData* input)
 
   for (int i = 0; i < NUM_POLY_DATA_TOPOS; i++)
   {
-    connectivityOffsetArray[i] += allValues[this->CurrentTimeIndex * NUM_POLY_DATA_TOPOS + i];
+    connectivityOffsetArray[i] += previousValues[i];
     if (geometryUpdated)
     {
       connectivityOffsetArray[i] += cellArrayTopos[i].cellArray->GetNumberOfConnectivityIds();
@@ -769,15 +800,16 @@ bool vtkHDFWriter::InitializeTemporalUnstructuredGrid(hid_t group)
   }
 
   // Create empty offsets arrays, where a value is appended every step
+  hsize_t stepsChunkSize[] = { static_cast<hsize_t>(this->GetNumberOfStepsPerChunk()), 1 };
   bool initResult = true;
   initResult &= this->Impl->InitDynamicDataset(
-    stepsGroup, "PointOffsets", H5T_STD_I64LE, SINGLE_COLUMN, SMALL_CHUNK);
+    stepsGroup, "PointOffsets", H5T_STD_I64LE, SINGLE_COLUMN, stepsChunkSize);
   initResult &= this->Impl->InitDynamicDataset(
-    stepsGroup, "PartOffsets", H5T_STD_I64LE, SINGLE_COLUMN, SMALL_CHUNK);
+    stepsGroup, "PartOffsets", H5T_STD_I64LE, SINGLE_COLUMN, stepsChunkSize);
   initResult &= this->Impl->InitDynamicDataset(
-    stepsGroup, "CellOffsets", H5T_STD_I64LE, SINGLE_COLUMN, SMALL_CHUNK);
+    stepsGroup, "CellOffsets", H5T_STD_I64LE, SINGLE_COLUMN, stepsChunkSize);
   initResult &= this->Impl->InitDynamicDataset(
-    stepsGroup, "ConnectivityIdOffsets", H5T_STD_I64LE, SINGLE_COLUMN, SMALL_CHUNK);
+    stepsGroup, "ConnectivityIdOffsets", H5T_STD_I64LE, SINGLE_COLUMN, stepsChunkSize);
 
   // Add an initial 0 value in the offset arrays, only when not writing the meta file
   if (!this->Impl->GetSubFilesReady())
@@ -818,11 +850,13 @@ bool vtkHDFWriter::InitializeTemporalPolyData(hid_t group)
   }
 
   // Create empty offsets arrays, where a value is appended every step, and add and initial 0 value.
+  const hsize_t stepsPerChunk = this->GetNumberOfStepsPerChunk();
+  hsize_t stepsChunkSize[] = { stepsPerChunk, 1 };
   bool initResult = true;
   initResult &= this->Impl->InitDynamicDataset(
-    stepsGroup, "PointOffsets", H5T_STD_I64LE, SINGLE_COLUMN, SMALL_CHUNK);
+    stepsGroup, "PointOffsets", H5T_STD_I64LE, SINGLE_COLUMN, stepsChunkSize);
   initResult &= this->Impl->InitDynamicDataset(
-    stepsGroup, "PartOffsets", H5T_STD_I64LE, SINGLE_COLUMN, SMALL_CHUNK);
+    stepsGroup, "PartOffsets", H5T_STD_I64LE, SINGLE_COLUMN, stepsChunkSize);
 
   // Add an initial 0 value in the offset arrays, only when not writing the meta file
   if (!this->Impl->GetSubFilesReady())
@@ -832,10 +866,11 @@ bool vtkHDFWriter::InitializeTemporalPolyData(hid_t group)
   }
 
   // Initialize datasets for primitive cells and connectivity. Fill with an empty 1*4 vector.
+  hsize_t primitiveChunkSize[] = { stepsPerChunk, NUM_POLY_DATA_TOPOS };
   initResult &= this->Impl->InitDynamicDataset(
-    stepsGroup, "CellOffsets", H5T_STD_I64LE, NUM_POLY_DATA_TOPOS, PRIMITIVE_CHUNK);
+    stepsGroup, "CellOffsets", H5T_STD_I64LE, NUM_POLY_DATA_TOPOS, primitiveChunkSize);
   initResult &= this->Impl->InitDynamicDataset(
-    stepsGroup, "ConnectivityIdOffsets", H5T_STD_I64LE, NUM_POLY_DATA_TOPOS, PRIMITIVE_CHUNK);
+    stepsGroup, "ConnectivityIdOffsets", H5T_STD_I64LE, NUM_POLY_DATA_TOPOS, primitiveChunkSize);
 
   if (!initResult)
   {
@@ -938,11 +973,12 @@ bool vtkHDFWriter::InitializePointDatasets(hid_t group, vtkPoints* points)
   // Create resizeable datasets for Points and NumberOfPoints
   std::vector<hsize_t> pointChunkSize{ static_cast<hsize_t>(this->ChunkSize),
     static_cast<hsize_t>(components) };
+  hsize_t stepsChunkSize[] = { static_cast<hsize_t>(this->GetNumberOfStepsPerChunk()), 1 };
   bool initResult = true;
   initResult &= this->Impl->InitDynamicDataset(
     group, "Points", datatype, components, pointChunkSize.data(), this->CompressionLevel);
   initResult &= this->Impl->InitDynamicDataset(
-    group, "NumberOfPoints", H5T_STD_I64LE, SINGLE_COLUMN, SMALL_CHUNK);
+    group, "NumberOfPoints", H5T_STD_I64LE, SINGLE_COLUMN, stepsChunkSize);
   return initResult;
 }
 
@@ -950,15 +986,16 @@ bool vtkHDFWriter::InitializePointDatasets(hid_t group, vtkPoints* points)
 bool vtkHDFWriter::InitializePrimitiveDataset(hid_t group)
 {
   hsize_t largeChunkSize[] = { static_cast<hsize_t>(this->ChunkSize), 1 };
+  hsize_t stepsChunkSize[] = { static_cast<hsize_t>(this->GetNumberOfStepsPerChunk()), 1 };
   bool initResult = true;
   initResult &=
     this->Impl->InitDynamicDataset(group, "Offsets", H5T_STD_I64LE, SINGLE_COLUMN, largeChunkSize);
   initResult &= this->Impl->InitDynamicDataset(
-    group, "NumberOfCells", H5T_STD_I64LE, SINGLE_COLUMN, SMALL_CHUNK);
+    group, "NumberOfCells", H5T_STD_I64LE, SINGLE_COLUMN, stepsChunkSize);
   initResult &= this->Impl->InitDynamicDataset(
     group, "Connectivity", H5T_STD_I64LE, SINGLE_COLUMN, largeChunkSize, this->CompressionLevel);
   initResult &= this->Impl->InitDynamicDataset(
-    group, "NumberOfConnectivityIds", H5T_STD_I64LE, SINGLE_COLUMN, SMALL_CHUNK);
+    group, "NumberOfConnectivityIds", H5T_STD_I64LE, SINGLE_COLUMN, stepsChunkSize);
   return initResult;
 }
 
@@ -1422,6 +1459,8 @@ bool vtkHDFWriter::AppendExternalBlock(vtkDataObject* block, const std::string&
   writer->SetInputData(block);
   writer->SetFileName(subfileName.c_str());
   writer->SetCompressionLevel(this->CompressionLevel);
+  writer->SetCompressionMethod(this->CompressionMethod);
+  writer->SetShuffle(this->Shuffle);
   writer->SetChunkSize(this->ChunkSize);
   writer->SetUseExternalComposite(this->UseExternalComposite);
   writer->SetUseExternalPartitions(this->UseExternalPartitions);
@@ -1666,7 +1705,7 @@ bool vtkHDFWriter::AppendDataArrayOffset(hid_t baseGroup, vtkAbstractArray* arra
   if (this->CurrentTimeIndex == 0 || (this->Impl->GetSubFilesReady() && this->NbPieces > 1))
   {
     // Initialize offsets array
-    hsize_t ChunkSize1D[] = { static_cast<hsize_t>(this->ChunkSize), 1 };
+    hsize_t ChunkSize1D[] = { static_cast<hsize_t>(this->GetNumberOfStepsPerChunk()), 1 };
     if (!this->Impl->InitDynamicDataset(
           this->Impl->GetStepsGroup(baseGroup), datasetName.c_str(), H5T_STD_I64LE, 1, ChunkSize1D))
     {
@@ -1719,7 +1758,7 @@ bool vtkHDFWriter::AppendDataArraySizeOffset(hid_t baseGroup, vtkAbstractArray*
     value[1] = array->GetNumberOfTuples();
 
     // FieldData size always represented by a pair of value per timestep
-    hsize_t ChunkSize1D[] = { 1, 2 };
+    hsize_t ChunkSize1D[] = { static_cast<hsize_t>(this->GetNumberOfStepsPerChunk()), 2 };
     if (!this->Impl->InitDynamicDataset(this->Impl->GetStepsGroup(baseGroup), datasetName.c_str(),
           H5T_STD_I64LE, value.size(), ChunkSize1D))
     {
@@ -1756,6 +1795,16 @@ bool vtkHDFWriter::AppendDataArraySizeOffset(hid_t baseGroup, vtkAbstractArray*
   return true;
 }
 
+//------------------------------------------------------------------------------
+vtkIdType vtkHDFWriter::GetNumberOfStepsPerChunk()
+{
+  if (!this->IsTemporal)
+  {
+    return 1;
+  }
+  return std::max<vtkIdType>(std::min<vtkIdType>(this->NumberOfTimeSteps, MAX_STEPS_PER_CHUNK), 1);
+}
+
 //------------------------------------------------------------------------------
 bool vtkHDFWriter::HasGeometryChangedFromPreviousStep(vtkDataSet* input)
 {
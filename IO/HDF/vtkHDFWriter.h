@@ -114,9 +114,13 @@ public:
    * data, please check this documentation:
    * https://docs.hdfgroup.org/hdf5/develop/_l_b_dset_layout.html
    *
+   * The chunks of arrays with several components hold ChunkSize tuples. When ChunkSize is 0, the
+   * number of tuples of the chunks of each array is chosen so that they hold about 1Mb, whatever
+   * its type and number of components.
+   *
    * Defaults to 25000 (to fit with the default chunk cache of 1Mb of HDF5).
    */
-  vtkSetMacro(ChunkSize, int);
+  vtkSetClampMacro(ChunkSize, int, 0, VTK_INT_MAX);
   vtkGetMacro(ChunkSize, int);
   ///@}
 
@@ -131,12 +135,57 @@ public:
    * @note Only points, cells and data arrays will be compressed. Other datas are considered to be
    * too small to be worth compressing.
    *
+   * @note The chunks of compressed arrays are compressed concurrently, using vtkSMPTools, and
+   * written directly to the file, when the array type matches the type in the file.
+   *
    * Default to 0.
    */
   vtkSetClampMacro(CompressionLevel, int, 0, 9);
   vtkGetMacro(CompressionLevel, int);
   ///@}
 
+  /**
+   * Compression methods.
+   */
+  enum CompressionMethodType
+  {
+    DEFLATE = 0,
+    LZ4 = 1,
+    ZSTD = 2
+  };
+
+  ///@{
+  /**
+   * Get/set the compression method used when CompressionLevel is not 0:
+   * - DEFLATE, the default, uses the gzip filter of HDF5, with CompressionLevel as level.
+   * - LZ4 is much faster, for a lower compression ratio, and ignores the level. It uses the filter
+   *   registered with the HDF Group as 32004, that other applications read with the HDF5 LZ4
+   *   filter plugin.
+   * - ZSTD compresses about as fast as DEFLATE, with a better ratio, and decompresses faster. It
+   *   uses vtkZstdDataCompressor, with CompressionLevel as level, and the filter registered with
+   *   the HDF Group as 32015, that other applications read with the HDF5 Zstandard filter plugin.
+   *   The filter stores the native Zstandard level that CompressionLevel maps to, as the plugin
+   *   expects, so that both compress the same way.
+   *   ZSTD requires the VTK::IOZstd module: without it, setting ZSTD keeps the current method.
+   */
+  void SetCompressionMethod(int method);
+  vtkGetMacro(CompressionMethod, int);
+  void SetCompressionMethodToDeflate() { this->SetCompressionMethod(DEFLATE); }
+  void SetCompressionMethodToLZ4() { this->SetCompressionMethod(LZ4); }
+  void SetCompressionMethodToZstd() { this->SetCompressionMethod(ZSTD); }
+  ///@}
+
+  ///@{
+  /**
+   * Get/set whether the bytes of the values of compressed arrays are shuffled before compression,
+   * so that bytes of the same significance are compressed together. This usually improves the
+   * compression of numbers. Default is false.
+   */
+  vtkSetMacro(Shuffle, bool);
+  vtkGetMacro(Shuffle, bool);
+  vtkBooleanMacro(Shuffle, bool);
+  ///@}
+
   ///@{
   /**
    * When set, write composite leaf blocks in different files,
@@ -381,6 +430,13 @@ private:
    */
   bool AppendTimeValues(hid_t group);
 
+  /**
+   * Return the number of rows of the chunks of datasets where values are appended every step.
+   * This is the number of steps to write, up to a limit, so that their storage is allocated once
+   * instead of every step.
+   */
+  vtkIdType GetNumberOfStepsPerChunk();
+
   /**
    * Check if the mesh geometry changed between this step and the last.
    */
@@ -403,6 +459,8 @@ private:
   bool UseExternalPartitions = false;
   int ChunkSize = 25000;
   int CompressionLevel = 0;
+  int CompressionMethod = DEFLATE;
+  bool Shuffle = false;
 
   // Temporal-related private variables
   std::vector<double> timeSteps;
@@ -2,14 +2,23 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkHDFWriterImplementation.h"
 
+#include "vtkDataCompressor.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkHDF5ScopedHandle.h"
 #include "vtkHDFVersion.h"
 #include "vtkLogger.h"
+#include "vtkSMPTools.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkSmartPointer.h"
 #include "vtkStringFormatter.h"
 #include "vtkType.h"
 
 #include "vtk_hdf5.h"
+#include "vtk_zlib.h"
+
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+#include "vtkZstdDataCompressor.h"
+#endif
 
 #include <algorithm>
 #include <numeric>
@@ -58,6 +67,44 @@ bool ContainsAny(const std::string& path, const std::vector<std::string>& subpat
 };
 }
 
+namespace
+{
+// Size of the chunks of arrays when vtkHDFWriter::ChunkSize is 0, the size of
+// the default chunk cache of HDF5
+constexpr hsize_t AUTOMATIC_CHUNK_BYTES = 1 << 20;
+
+template <typename ValueType>
+void AppendComponentBuffers(vtkDataArray* array, std::vector<const void*>& buffers)
+{
+  auto soa = vtkArrayDownCast<vtkSOADataArrayTemplate<ValueType>>(array);
+  if (soa && soa->GetStorageType() == vtkSOADataArrayTemplate<ValueType>::SOA)
+  {
+    for (int comp = 0; comp < soa->GetNumberOfComponents(); ++comp)
+    {
+      buffers.push_back(soa->GetComponentArrayPointer(comp));
+    }
+  }
+}
+
+/**
+ * Return the buffer of each component of `array` when it stores them in separate
+ * buffers, as vtkSOADataArrayTemplate does, and an empty vector otherwise.
+ */
+std::vector<const void*> GetComponentBuffers(vtkDataArray* array)
+{
+  std::vector<const void*> buffers;
+  if (array->GetArrayType() != vtkArrayTypes::VTK_SOA_DATA_ARRAY)
+  {
+    return buffers;
+  }
+  switch (array->GetDataType())
+  {
+    vtkTemplateMacro(AppendComponentBuffers<VTK_TT>(array, buffers));
+  }
+  return buffers;
+}
+}
+
 //------------------------------------------------------------------------------
 bool vtkHDFWriter::Implementation::WriteHeader(hid_t group, const char* hdfType)
 {
@@ -126,6 +173,7 @@ bool vtkHDFWriter::Implementation::CreateFile(bool overwrite, const std::string&
   vtkDebugWithObjectMacro(
     this->Writer, << "Creating file " << this->Writer->CurrentPiece << ": " << filename);
 
+  vtkHDFUtilities::RegisterFilters();
   vtkHDF::ScopedH5FHandle file{ H5Fcreate(
     filename.c_str(), overwrite ? H5F_ACC_TRUNC : H5F_ACC_EXCL, H5P_DEFAULT, H5P_DEFAULT) };
   if (file == H5I_INVALID_HID)
@@ -153,6 +201,7 @@ bool vtkHDFWriter::Implementation::OpenFile()
   vtkDebugWithObjectMacro(
     this->Writer, << "Opening file on rank" << this->Writer->CurrentPiece << ": " << filename);
 
+  vtkHDFUtilities::RegisterFilters();
   vtkHDF::ScopedH5FHandle file{ H5Fopen(filename, H5F_ACC_RDWR, H5P_DEFAULT) };
   if (file == H5I_INVALID_HID)
   {
@@ -423,18 +472,48 @@ vtkHDF::ScopedH5DHandle vtkHDFWriter::Implementation::CreateChunkedHdfDataset(hi
     return H5I_INVALID_HID;
   }
   H5Pset_layout(plist, H5D_CHUNKED);
+  hsize_t chunkDims[] = { chunkSize[0], numCols == 1 ? 1 : chunkSize[1] };
+  if (chunkDims[0] == 0)
+  {
+    // Fit the chunks in the default chunk cache of 1Mb
+    const hsize_t rowSize = std::max<hsize_t>(H5Tget_size(type) * chunkDims[1], 1);
+    chunkDims[0] = std::max<hsize_t>(AUTOMATIC_CHUNK_BYTES / rowSize, 1);
+  }
   if (numCols == 1)
   {
-    H5Pset_chunk(plist, 1, chunkSize);
+    H5Pset_chunk(plist, 1, chunkDims);
   }
   else
   {
-    H5Pset_chunk(plist, 2, chunkSize); // 2-Dimensional
+    H5Pset_chunk(plist, 2, chunkDims); // 2-Dimensional
   }
 
   if (compressionLevel != 0)
   {
-    H5Pset_deflate(plist, compressionLevel);
+    // Shuffling has to come first in the filter pipeline
+    if (this->Writer->Shuffle)
+    {
+      H5Pset_shuffle(plist);
+    }
+    if (this->Writer->CompressionMethod == vtkHDFWriter::LZ4)
+    {
+      vtkHDFUtilities::RegisterFilters();
+      H5Pset_filter(plist, vtkHDFUtilities::LZ4_FILTER_ID, H5Z_FLAG_MANDATORY, 0, nullptr);
+    }
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+    else if (this->Writer->CompressionMethod == vtkHDFWriter::ZSTD)
+    {
+      // The filter stores the native Zstandard level, as the HDF5 plugin reads it
+      vtkHDFUtilities::RegisterFilters();
+      const auto level = static_cast<unsigned int>(
+        vtkZstdDataCompressor::ToZstdCompressionLevel(compressionLevel));
+      H5Pset_filter(plist, vtkHDFUtilities::ZSTD_FILTER_ID, H5Z_FLAG_MANDATORY, 1, &level);
+    }
+#endif
+    else
+    {
+      H5Pset_deflate(plist, compressionLevel);
+    }
   }
 
   vtkHDF::ScopedH5DHandle dset =
@@ -547,10 +626,15 @@ bool vtkHDFWriter::Implementation::AddSingleValueToDataset(
   // Add the last value of the dataset if we want an offset (only for arrays of stride 1)
   if (offset && currentdims[0] > 0)
   {
-    std::vector<vtkIdType> allValues;
-    allValues.resize(currentdims[0]);
-    H5Dread(dataset, H5T_STD_I64LE, currentDataspace, H5S_ALL, H5P_DEFAULT, allValues.data());
-    value += allValues.back();
+    const hsize_t last[1] = { currentdims[0] - 1 };
+    H5Sselect_hyperslab(currentDataspace, H5S_SELECT_SET, last, nullptr, addedDims, nullptr);
+    vtkIdType lastValue = 0;
+    if (H5Dread(dataset, H5T_STD_I64LE, newDataspace, currentDataspace, H5P_DEFAULT, &lastValue) <
+      0)
+    {
+      return false;
+    }
+    value += lastValue;
   }
 
   // Resize dataset
@@ -838,10 +922,27 @@ bool vtkHDFWriter::Implementation::AddArrayToDataset(
     H5Sselect_hyperslab(
       currentDataspace, H5S_SELECT_SET, start.data(), nullptr, count.data(), nullptr);
 
-    // Write new data to the dataset
+    // Arrays with a buffer per component are written from these buffers
+    const int soaWrite =
+      this->WriteComponentsDirectly(dataset, source_type, start[0], count[0], da);
+    if (soaWrite != 0)
+    {
+      return soaWrite > 0;
+    }
+
+    // Write new data to the dataset, compressing its chunks concurrently when appended
     auto aos = da->ToAOSDataArray();
-    if (H5Dwrite(dataset, source_type, dataspace, currentDataspace, H5P_DEFAULT,
-          aos->GetVoidPointer(0)) < 0) // NOLINT(bugprone-unsafe-functions)
+    const int directWrite = trim == 0
+      ? this->WriteChunksDirectly(
+          dataset, source_type, start[0], count[0], aos->GetVoidPointer(0)) // NOLINT
+      : 0;
+    if (directWrite < 0)
+    {
+      return false;
+    }
+    if (directWrite == 0 &&
+      H5Dwrite(dataset, source_type, dataspace, currentDataspace, H5P_DEFAULT,
+        aos->GetVoidPointer(0)) < 0) // NOLINT(bugprone-unsafe-functions)
     {
       return false;
     }
@@ -855,6 +956,227 @@ bool vtkHDFWriter::Implementation::AddArrayToDataset(
   return true;
 }
 
+//------------------------------------------------------------------------------
+int vtkHDFWriter::Implementation::WriteComponentsDirectly(
+  hid_t dataset, hid_t memType, hsize_t start, hsize_t count, vtkDataArray* dataArray)
+{
+  const std::vector<const void*> buffers = ::GetComponentBuffers(dataArray);
+  if (buffers.empty())
+  {
+    return 0;
+  }
+  vtkHDF::ScopedH5PHandle plist = H5Dget_create_plist(dataset);
+  if (plist == H5I_INVALID_HID || H5Pget_layout(plist) != H5D_CHUNKED ||
+    H5Pget_nfilters(plist) != 0)
+  {
+    return 0;
+  }
+  vtkHDF::ScopedH5SHandle fileSpace = H5Dget_space(dataset);
+  const int rank = H5Sget_simple_extent_ndims(fileSpace);
+  hsize_t chunkDims[] = { 0, 1 };
+  if (rank < 1 || rank > 2 || H5Pget_chunk(plist, rank, chunkDims) != rank ||
+    (rank == 1 && buffers.size() != 1))
+  {
+    return 0;
+  }
+
+  // Components are written a chunk of rows at a time, so that each chunk stays in the chunk cache
+  // until all its components are written.
+  const std::size_t valueSize = H5Tget_size(memType);
+  hsize_t rowStart = start;
+  while (rowStart < start + count)
+  {
+    const hsize_t rowEnd = std::min(start + count, (rowStart / chunkDims[0] + 1) * chunkDims[0]);
+    hsize_t memDims[] = { rowEnd - rowStart };
+    vtkHDF::ScopedH5SHandle memSpace = H5Screate_simple(1, memDims, nullptr);
+    for (std::size_t comp = 0; comp < buffers.size(); ++comp)
+    {
+      hsize_t fileStart[] = { rowStart, comp };
+      hsize_t fileCount[] = { rowEnd - rowStart, 1 };
+      H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, fileStart, nullptr, fileCount, nullptr);
+      const auto buffer =
+        static_cast<const unsigned char*>(buffers[comp]) + (rowStart - start) * valueSize;
+      if (H5Dwrite(dataset, memType, memSpace, fileSpace, H5P_DEFAULT, buffer) < 0)
+      {
+        return -1;
+      }
+    }
+    rowStart = rowEnd;
+  }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkHDFWriter::Implementation::WriteChunksDirectly(
+  hid_t dataset, hid_t memType, hsize_t start, hsize_t count, const void* data)
+{
+  vtkHDF::ScopedH5PHandle plist = H5Dget_create_plist(dataset);
+  if (plist == H5I_INVALID_HID || H5Pget_layout(plist) != H5D_CHUNKED)
+  {
+    return 0;
+  }
+  vtkHDF::ScopedH5THandle fileType = H5Dget_type(dataset);
+  if (fileType == H5I_INVALID_HID || H5Tequal(fileType, memType) <= 0)
+  {
+    return 0;
+  }
+  vtkHDF::ScopedH5SHandle fileSpace = H5Dget_space(dataset);
+  const int rank = H5Sget_simple_extent_ndims(fileSpace);
+  hsize_t dims[] = { 0, 1 };
+  hsize_t chunkDims[] = { 0, 1 };
+  if (rank < 1 || rank > 2 || H5Sget_simple_extent_dims(fileSpace, dims, nullptr) != rank ||
+    H5Pget_chunk(plist, rank, chunkDims) != rank || chunkDims[1] != dims[1] ||
+    dims[0] != start + count)
+  {
+    return 0;
+  }
+
+  // Only the filters set by CreateChunkedHdfDataset are supported
+  bool shuffle = false;
+  int deflateLevel = -1;
+  bool lz4 = false;
+  std::size_t lz4BlockSize = 0;
+  vtkSmartPointer<vtkDataCompressor> compressor;
+  const int numberOfFilters = H5Pget_nfilters(plist);
+  for (int i = 0; i < numberOfFilters; ++i)
+  {
+    unsigned int flags = 0;
+    std::size_t numberOfValues = 1;
+    unsigned int values[1] = { 0 };
+    const H5Z_filter_t filter =
+      H5Pget_filter2(plist, i, &flags, &numberOfValues, values, 0, nullptr, nullptr);
+    if (filter == H5Z_FILTER_SHUFFLE && i == 0)
+    {
+      shuffle = true;
+    }
+    else if (filter == H5Z_FILTER_DEFLATE && i == numberOfFilters - 1 && numberOfValues == 1)
+    {
+      deflateLevel = static_cast<int>(values[0]);
+    }
+    else if (filter == vtkHDFUtilities::LZ4_FILTER_ID && i == numberOfFilters - 1)
+    {
+      lz4 = true;
+      lz4BlockSize = numberOfValues > 0 ? values[0] : 0;
+    }
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+    else if (filter == vtkHDFUtilities::ZSTD_FILTER_ID && i == numberOfFilters - 1)
+    {
+      // The compressor is shared by the threads, each with its own context
+      auto zstdCompressor = vtkSmartPointer<vtkZstdDataCompressor>::New();
+      if (numberOfValues > 0)
+      {
+        zstdCompressor->SetZstdCompressionLevel(static_cast<int>(values[0]));
+      }
+      compressor = zstdCompressor;
+    }
+#endif
+    else
+    {
+      return 0;
+    }
+  }
+  if (deflateLevel < 0 && !lz4 && !compressor)
+  {
+    return 0;
+  }
+
+  const std::size_t typeSize = H5Tget_size(fileType);
+  const std::size_t rowSize = typeSize * dims[1];
+  const std::size_t chunkBytes = rowSize * chunkDims[0];
+  const auto bytes = static_cast<const unsigned char*>(data);
+
+  // Rows before the first chunk boundary go through the filters of HDF5
+  const hsize_t headCount = std::min(count, (chunkDims[0] - start % chunkDims[0]) % chunkDims[0]);
+  if (headCount > 0)
+  {
+    hsize_t headStart[] = { start, 0 };
+    hsize_t headDims[] = { headCount, dims[1] };
+    vtkHDF::ScopedH5SHandle memSpace = H5Screate_simple(rank, headDims, nullptr);
+    H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, headStart, nullptr, headDims, nullptr);
+    if (H5Dwrite(dataset, memType, memSpace, fileSpace, H5P_DEFAULT, bytes) < 0)
+    {
+      return -1;
+    }
+  }
+
+  // Full chunks, and the last one padded with zeros, are compressed in batches
+  constexpr hsize_t chunksPerBatch = 64;
+  const hsize_t firstRow = start + headCount;
+  const hsize_t numberOfChunks = (start + count - firstRow + chunkDims[0] - 1) / chunkDims[0];
+  std::vector<std::vector<unsigned char>> compressedChunks;
+  for (hsize_t batchStart = 0; batchStart < numberOfChunks; batchStart += chunksPerBatch)
+  {
+    const hsize_t batchSize = std::min(chunksPerBatch, numberOfChunks - batchStart);
+    compressedChunks.assign(batchSize, std::vector<unsigned char>());
+    vtkSMPTools::For(0, static_cast<vtkIdType>(batchSize),
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        std::vector<unsigned char> chunk(chunkBytes);
+        std::vector<unsigned char> shuffled(shuffle ? chunkBytes : 0);
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          const hsize_t chunkStart = firstRow + (batchStart + i) * chunkDims[0];
+          const hsize_t rows = std::min(chunkDims[0], start + count - chunkStart);
+          const unsigned char* source = bytes + (chunkStart - start) * rowSize;
+          std::copy_n(source, rows * rowSize, chunk.begin());
+          std::fill(chunk.begin() + rows * rowSize, chunk.end(), 0);
+          const unsigned char* input = chunk.data();
+          if (shuffle)
+          {
+            const std::size_t numberOfElements = chunkBytes / typeSize;
+            for (std::size_t element = 0; element < numberOfElements; ++element)
+            {
+              for (std::size_t byte = 0; byte < typeSize; ++byte)
+              {
+                shuffled[byte * numberOfElements + element] = chunk[element * typeSize + byte];
+              }
+            }
+            input = shuffled.data();
+          }
+
+          std::vector<unsigned char>& compressed = compressedChunks[i];
+          if (lz4)
+          {
+            if (!vtkHDFUtilities::CompressLZ4(input, chunkBytes, lz4BlockSize, compressed))
+            {
+              compressed.clear();
+            }
+            continue;
+          }
+          if (compressor)
+          {
+            if (!vtkHDFUtilities::Compress(compressor, input, chunkBytes, compressed))
+            {
+              compressed.clear();
+            }
+            continue;
+          }
+          uLongf compressedSize = compressBound(static_cast<uLong>(chunkBytes));
+          compressed.resize(compressedSize);
+          if (compress2(compressed.data(), &compressedSize, input,
+                static_cast<uLong>(chunkBytes), deflateLevel) != Z_OK)
+          {
+            compressedSize = 0;
+          }
+          compressed.resize(compressedSize);
+        }
+      });
+
+    // HDF5 is not thread safe: chunks are written one after the other
+    for (hsize_t i = 0; i < batchSize; ++i)
+    {
+      const std::vector<unsigned char>& compressed = compressedChunks[i];
+      hsize_t offset[] = { firstRow + (batchStart + i) * chunkDims[0], 0 };
+      if (compressed.empty() ||
+        H5Dwrite_chunk(dataset, H5P_DEFAULT, 0, offset, compressed.size(), compressed.data()) < 0)
+      {
+        return -1;
+      }
+    }
+  }
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 bool vtkHDFWriter::Implementation::AddOrCreateDataset(
   hid_t group, const char* name, hid_t type, vtkAbstractArray* dataArray)
@@ -344,6 +344,28 @@ private:
 
   std::string GetBasePath(const std::string& fullPath);
 
+  /**
+   * Write rows [start, start + count) of the chunked and compressed `dataset`
+   * from `data`, of type `memType`, compressing the full chunks concurrently
+   * and writing them with H5Dwrite_chunk. The rows before the first chunk
+   * boundary are written with H5Dwrite.
+   * Return 1 on success, -1 on failure and 0 if the chunks cannot be written
+   * directly, when the type of the data is not the type of the dataset, or its
+   * filters are not the ones vtkHDFWriter uses.
+   */
+  int WriteChunksDirectly(
+    hid_t dataset, hid_t memType, hsize_t start, hsize_t count, const void* data);
+
+  /**
+   * Write rows [start, start + count) of the chunked and uncompressed `dataset`
+   * from the buffer of each component of `dataArray`, without copying them to a
+   * single buffer first.
+   * Return 1 on success, -1 on failure and 0 if `dataArray` does not store its
+   * components in separate buffers or the dataset is compressed.
+   */
+  int WriteComponentsDirectly(
+    hid_t dataset, hid_t memType, hsize_t start, hsize_t count, vtkDataArray* dataArray);
+
   /**
    * Return true if the given dataset exists in the given existing group.
    */
@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that arrays large enough to be parsed and byte swapped concurrently by
+// vtkDataReader are read back exactly, in ASCII and binary files of the
+// current and 4.2 formats, from strings and from streams that cannot seek,
+// and that what follows them is read correctly.
+
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkResourceStream.h"
+#include "vtkShortArray.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnsignedIntArray.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkUnstructuredGridReader.h"
+#include "vtkUnstructuredGridWriter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+template <class ArrayT>
+void AddArray(vtkDataSetAttributes* attributes, const char* name, int numComps, vtkIdType num)
+{
+  vtkNew<ArrayT> array;
+  array->SetName(name);
+  array->SetNumberOfComponents(numComps);
+  array->SetNumberOfTuples(num);
+  // Float arrays are written with 6 significant digits, which these values fit.
+  for (vtkIdType i = 0; i < array->GetNumberOfValues(); ++i)
+  {
+    array->SetValue(i, static_cast<typename ArrayT::ValueType>((i * 7919 % 800) / 8.0));
+  }
+  attributes->AddArray(array);
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> CreateGrid()
+{
+  const vtkIdType numPts = 30000;
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPts);
+  vtkNew<vtkDoubleArray> magnitudes;
+  magnitudes->SetName("Magnitudes");
+  magnitudes->SetNumberOfComponents(3);
+  magnitudes->SetNumberOfTuples(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    points->SetPoint(i, (i % 50) / 3.0, (i / 50 % 30) / 7.0, (i / 1500) / 11.0);
+    magnitudes->SetTuple3(i, std::sin(0.001 * i) / 3.0, std::cos(0.002 * i) * 1e-7, 1e12 * i);
+  }
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(points);
+  grid->Allocate(numPts / 3);
+  for (vtkIdType i = 0; i + 3 < numPts; i += 3)
+  {
+    vtkIdType ids[4] = { i, i + 1, i + 2, i + 3 };
+    grid->InsertNextCell(i % 2 ? VTK_TETRA : VTK_TRIANGLE, i % 2 ? 4 : 3, ids);
+  }
+
+  grid->GetPointData()->AddArray(magnitudes);
+  AddArray<vtkFloatArray>(grid->GetPointData(), "Float", 3, numPts);
+  AddArray<vtkIntArray>(grid->GetPointData(), "Int", 1, numPts);
+  AddArray<vtkShortArray>(grid->GetPointData(), "Short", 2, numPts);
+  AddArray<vtkUnsignedCharArray>(grid->GetPointData(), "UnsignedChar", 4, numPts);
+  AddArray<vtkUnsignedIntArray>(grid->GetPointData(), "UnsignedInt", 1, numPts);
+  AddArray<vtkIdTypeArray>(grid->GetPointData(), "IdType", 1, numPts);
+  AddArray<vtkDoubleArray>(grid->GetCellData(), "Double", 1, grid->GetNumberOfCells());
+  return grid;
+}
+
+// A stream that can only be read forward, as a pipe or a socket.
+class ForwardOnlyStream : public vtkResourceStream
+{
+public:
+  static ForwardOnlyStream* New();
+  vtkTypeMacro(ForwardOnlyStream, vtkResourceStream);
+
+  std::string Buffer;
+
+  std::size_t Read(void* buffer, std::size_t bytes) override
+  {
+    const std::size_t read = std::min(bytes, this->Buffer.size() - this->Position);
+    std::copy_n(this->Buffer.data() + this->Position, read, static_cast<char*>(buffer));
+    this->Position += read;
+    return read;
+  }
+
+  bool EndOfStream() override { return this->Position == this->Buffer.size(); }
+
+protected:
+  ForwardOnlyStream()
+    : vtkResourceStream(false)
+  {
+  }
+
+private:
+  std::size_t Position = 0;
+};
+vtkStandardNewMacro(ForwardOnlyStream);
+
+bool TestConfiguration(vtkUnstructuredGrid* grid, int fileType, int fileVersion)
+{
+  const std::string name = std::string(fileType == VTK_ASCII ? "ASCII" : "binary") +
+    " file version " + std::to_string(fileVersion);
+
+  vtkNew<vtkUnstructuredGridWriter> writer;
+  writer->SetInputData(grid);
+  writer->SetFileType(fileType);
+  writer->SetFileVersion(fileVersion);
+  writer->SetPrecision(17);
+  writer->WriteToOutputStringOn();
+  writer->Write();
+
+  vtkNew<vtkUnstructuredGridReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(writer->GetOutputStdString());
+  reader->Update();
+  bool success = true;
+  if (!vtkTestUtilities::CompareDataObjects(grid, reader->GetOutput()))
+  {
+    vtkLog(ERROR, "The grid differs with " << name << ".");
+    success = false;
+  }
+
+  // Large arrays are read sequentially from streams that cannot seek back.
+  vtkNew<ForwardOnlyStream> stream;
+  stream->Buffer = writer->GetOutputStdString();
+  vtkNew<vtkUnstructuredGridReader> streamReader;
+  streamReader->ReadFromInputStreamOn();
+  streamReader->SetStream(stream);
+  streamReader->Update();
+  if (!vtkTestUtilities::CompareDataObjects(grid, streamReader->GetOutput()))
+  {
+    vtkLog(ERROR, "The grid differs with " << name << " read from a stream.");
+    success = false;
+  }
+  return success;
+}
+}
+
+int TestLegacyLargeArrays(int, char*[])
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid = CreateGrid();
+  bool success = true;
+  for (int fileType : { VTK_ASCII, VTK_BINARY })
+  {
+    success &= TestConfiguration(grid, fileType, 51);
+    success &= TestConfiguration(grid, fileType, 42);
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
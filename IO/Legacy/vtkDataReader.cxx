@@ -34,6 +34,7 @@
 #include "vtkPointSet.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkResourceStream.h"
+#include "vtkSMPTools.h"
 #include "vtkShortArray.h"
 #include "vtkStringArray.h"
 #include "vtkStringScanner.h"
@@ -50,8 +51,12 @@
 #include <vtksys/SystemTools.hxx>
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cstring>
+#include <numeric>
 #include <sstream>
+#include <type_traits>
 #include <vector>
 
 // I need a safe way to read a line of arbitrary length.  It exists on
@@ -487,6 +492,20 @@ int vtkDataReader::OpenVTKFile(const char* fname)
     {
       // Use provided resource stream.
       vtkDebugMacro(<< "Reading from resource stream");
+      if (!this->Stream->SupportSeek())
+      {
+        // Peek and the parsing of large ASCII arrays move back in the input,
+        // so streams that cannot seek are read in memory, as input strings.
+        std::string str;
+        std::vector<char> buffer(65536);
+        std::size_t read;
+        while ((read = this->Stream->Read(buffer.data(), buffer.size())) > 0)
+        {
+          str.append(buffer.data(), read);
+        }
+        this->IS = new std::istringstream(str);
+        return 1;
+      }
       this->Stream->Seek(0, vtkResourceStream::SeekDirection::Begin);
       this->Streambuf = this->Stream->ToStreambuf();
       this->IS = new std::istream(this->Streambuf.get());
@@ -1531,10 +1550,221 @@ int vtkReadBinaryData(istream* IS, T* data, vtkIdType numTuples, vtkIdType numCo
   return 1;
 }
 
+namespace
+{
+// Binary data is big endian.  Swap it to the byte order of this machine,
+// concurrently for large arrays.
+template <class T>
+void vtkSwapBERange(T* data, vtkIdType numValues)
+{
+#ifdef VTK_WORDS_BIGENDIAN
+  (void)data;
+  (void)numValues;
+#else
+  vtkSMPTools::For(0, numValues, 65536,
+    [data](vtkIdType begin, vtkIdType end)
+    { vtkByteSwap::SwapBERange(data + begin, static_cast<size_t>(end - begin)); });
+#endif
+}
+
+// Large ASCII arrays are read by chunks of the stream, split in pieces of
+// whole lines whose values are counted, then parsed, concurrently.
+constexpr vtkIdType ASCIIParallelMinimumValues = 4096;
+constexpr std::streamsize ASCIIChunkSize = 8388608;
+constexpr std::streamsize ASCIIPieceSize = 65536;
+
+inline bool vtkIsASCIISpace(char c)
+{
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+vtkIdType vtkCountASCIIValues(const char* begin, const char* end)
+{
+  vtkIdType count = 0;
+  bool inValue = false;
+  for (const char* c = begin; c != end; ++c)
+  {
+    const bool space = vtkIsASCIISpace(*c);
+    count += (!space && !inValue) ? 1 : 0;
+    inValue = !space;
+  }
+  return count;
+}
+
+const char* vtkSkipASCIIValues(const char* c, const char* end, vtkIdType numValues)
+{
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    while (c != end && vtkIsASCIISpace(*c))
+    {
+      ++c;
+    }
+    while (c != end && !vtkIsASCIISpace(*c))
+    {
+      ++c;
+    }
+  }
+  return c;
+}
+
+// Parse numValues values of the given text, which holds at least that many.
+// Characters are integers, as in vtkDataReader::Read.
+template <class T>
+bool vtkParseASCIIValues(const char* c, const char* end, T* data, vtkIdType numValues)
+{
+  using ParseType = typename std::conditional<sizeof(T) == 1, int, T>::type;
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    while (vtkIsASCIISpace(*c))
+    {
+      ++c;
+    }
+    if (*c == '+' && c + 1 != end)
+    {
+      ++c;
+    }
+    ParseType value;
+    auto result = vtk::from_chars(c, end, value);
+    if (result.ec != std::errc() || (result.ptr != end && !vtkIsASCIISpace(*result.ptr)))
+    {
+      return false;
+    }
+    data[i] = static_cast<T>(value);
+    c = result.ptr;
+  }
+  return true;
+}
+
+template <class T>
+int vtkReadASCIIDataInParallel(istream* IS, T* data, vtkIdType numValues)
+{
+  std::vector<char> chunk(ASCIIChunkSize);
+  std::vector<std::streamsize> pieceBegins;
+  std::vector<vtkIdType> pieceValues;
+  vtkIdType numRead = 0;
+  while (numRead < numValues)
+  {
+    IS->read(chunk.data(), ASCIIChunkSize);
+    const std::streamsize size = IS->gcount();
+    const bool last = size < ASCIIChunkSize;
+    if (last)
+    {
+      IS->clear();
+    }
+
+    // Only use whole lines, or whole values when lines are very long, unless
+    // the stream ended.
+    const char* text = chunk.data();
+    std::streamsize end = size;
+    if (!last)
+    {
+      end = 0;
+      for (std::streamsize i = size; i > 0 && end == 0; --i)
+      {
+        end = text[i - 1] == '\n' ? i : 0;
+      }
+      for (std::streamsize i = size; i > 0 && end == 0; --i)
+      {
+        end = vtkIsASCIISpace(text[i - 1]) ? i : 0;
+      }
+      if (end == 0)
+      {
+        vtkGenericWarningMacro(<< "Error reading ascii data. Value too long.");
+        return 0;
+      }
+    }
+
+    pieceBegins.assign(1, 0);
+    while (pieceBegins.back() + ASCIIPieceSize < end)
+    {
+      const char* lineEnd = static_cast<const char*>(std::memchr(text + pieceBegins.back() +
+          ASCIIPieceSize, '\n', static_cast<size_t>(end - pieceBegins.back() - ASCIIPieceSize)));
+      if (!lineEnd)
+      {
+        break;
+      }
+      pieceBegins.push_back(lineEnd + 1 - text);
+    }
+    if (pieceBegins.back() != end)
+    {
+      pieceBegins.push_back(end);
+    }
+    const vtkIdType numPieces = static_cast<vtkIdType>(pieceBegins.size()) - 1;
+
+    // Values before each piece.
+    pieceValues.assign(numPieces + 1, 0);
+    vtkSMPTools::For(0, numPieces,
+      [&](vtkIdType begin, vtkIdType endPiece)
+      {
+        for (vtkIdType piece = begin; piece < endPiece; ++piece)
+        {
+          pieceValues[piece + 1] =
+            vtkCountASCIIValues(text + pieceBegins[piece], text + pieceBegins[piece + 1]);
+        }
+      });
+    std::partial_sum(pieceValues.begin(), pieceValues.end(), pieceValues.begin());
+    const vtkIdType numWanted = std::min(numValues - numRead, pieceValues.back());
+
+    std::atomic<bool> failed(false);
+    T* chunkData = data + numRead;
+    vtkSMPTools::For(0, numPieces,
+      [&](vtkIdType begin, vtkIdType endPiece)
+      {
+        for (vtkIdType piece = begin; piece < endPiece && !failed; ++piece)
+        {
+          const vtkIdType first = pieceValues[piece];
+          const vtkIdType count = std::min(pieceValues[piece + 1], numWanted) - first;
+          if (count > 0 &&
+            !vtkParseASCIIValues(text + pieceBegins[piece], text + pieceBegins[piece + 1],
+              chunkData + first, count))
+          {
+            failed = true;
+          }
+        }
+      });
+    if (failed)
+    {
+      vtkGenericWarningMacro(<< "Error reading ascii data. Invalid value.");
+      return 0;
+    }
+    numRead += numWanted;
+
+    // Leave the stream right after the last value read, for the next ones.
+    std::streamsize consumed = end;
+    if (numRead == numValues)
+    {
+      const vtkIdType piece =
+        std::lower_bound(pieceValues.begin() + 1, pieceValues.end(), numWanted) -
+        pieceValues.begin() - 1;
+      consumed = vtkSkipASCIIValues(text + pieceBegins[piece], text + pieceBegins[piece + 1],
+                   numWanted - pieceValues[piece]) -
+        text;
+    }
+    IS->seekg(consumed - size, std::ios_base::cur);
+
+    if (numRead < numValues && last)
+    {
+      vtkGenericWarningMacro(<< "Error reading ascii data. Possible mismatch of "
+                                "datasize with declaration.");
+      return 0;
+    }
+  }
+  return 1;
+}
+}
+
 // General templated function to read data of various types.
 template <class T>
 int vtkReadASCIIData(vtkDataReader* self, T* data, vtkIdType numTuples, vtkIdType numComp)
 {
+  // vtk::from_chars rejects negative values for unsigned types, which the
+  // stream operators wrap around, so they are read sequentially.
+  if (numTuples * numComp >= ASCIIParallelMinimumValues &&
+    (sizeof(T) == 1 || std::is_signed<T>::value))
+  {
+    return vtkReadASCIIDataInParallel(self->GetIStream(), data, numTuples * numComp);
+  }
+
   vtkIdType i, j;
 
   for (i = 0; i < numTuples; i++)
@@ -1648,7 +1878,7 @@ vtkAbstractArray* vtkDataReader::ReadArray(
     if (this->FileType == VTK_BINARY)
     {
       vtkReadBinaryData(this->IS, ptr, numTuples, numComp);
-      vtkByteSwap::Swap2BERange(ptr, numTuples * numComp);
+      vtkSwapBERange(ptr, numTuples * numComp);
     }
     else
     {
@@ -1664,7 +1894,7 @@ vtkAbstractArray* vtkDataReader::ReadArray(
     if (this->FileType == VTK_BINARY)
     {
       vtkReadBinaryData(this->IS, ptr, numTuples, numComp);
-      vtkByteSwap::Swap2BERange((short*)ptr, numTuples * numComp);
+      vtkSwapBERange(ptr, numTuples * numComp);
     }
     else
     {
@@ -1681,17 +1911,16 @@ vtkAbstractArray* vtkDataReader::ReadArray(
     if (this->FileType == VTK_BINARY)
     {
       vtkReadBinaryData(this->IS, buffer.data(), numTuples, numComp);
-      vtkByteSwap::Swap4BERange(buffer.data(), numTuples * numComp);
+      vtkSwapBERange(buffer.data(), numTuples * numComp);
     }
     else
     {
       vtkReadASCIIData(this, buffer.data(), numTuples, numComp);
     }
     vtkIdType* ptr2 = ((vtkIdTypeArray*)array)->WritePointer(0, numTuples * numComp);
-    for (vtkIdType idx = 0; idx < numTuples * numComp; idx++)
-    {
-      ptr2[idx] = buffer[idx];
-    }
+    vtkSMPTools::For(0, numTuples * numComp, 65536,
+      [&](vtkIdType begin, vtkIdType end)
+      { std::copy(buffer.begin() + begin, buffer.begin() + end, ptr2 + begin); });
   }
 
   else if (!strncmp(type, "int", 3))
@@ -1702,7 +1931,7 @@ vtkAbstractArray* vtkDataReader::ReadArray(
     if (this->FileType == VTK_BINARY)
     {
       vtkReadBinaryData(this->IS, ptr, numTuples, numComp);
-      vtkByteSwap::Swap4BERange(ptr, numTuples * numComp);
+      vtkSwapBERange(ptr, numTuples * numComp);
     }
     else
     {
@@ -1718,7 +1947,7 @@ vtkAbstractArray* vtkDataReader::ReadArray(
     if (this->FileType == VTK_BINARY)
     {
       vtkReadBinaryData(this->IS, ptr, numTuples, numComp);
-      vtkByteSwap::Swap4BERange((int*)ptr, numTuples * numComp);
+      vtkSwapBERange(ptr, numTuples * numComp);
     }
     else
     {
@@ -1737,11 +1966,7 @@ vtkAbstractArray* vtkDataReader::ReadArray(
     if (this->FileType == VTK_BINARY)
     {
       vtkReadBinaryData(this->IS, ptr, numTuples, numComp);
-#if VTK_SIZEOF_LONG == 4
-      vtkByteSwap::Swap4BERange(ptr, numTuples * numComp);
-#else // VTK_SIZEOF_LONG == 8
-      vtkByteSwap::Swap8BERange(ptr, numTuples * numComp);
-#endif
+      vtkSwapBERange(ptr, numTuples * numComp);
     }
 
     else
@@ -1758,11 +1983,7 @@ vtkAbstractArray* vtkDataReader::ReadArray(
     if (this->FileType == VTK_BINARY)
     {
       vtkReadBinaryData(this->IS, ptr, numTuples, numComp);
-#if VTK_SIZEOF_LONG == 4
-      vtkByteSwap::Swap4BERange(ptr, numTuples * numComp);
-#else // VTK_SIZEOF_LONG == 8
-      vtkByteSwap::Swap8BERange(ptr, numTuples * numComp);
-#endif
+      vtkSwapBERange(ptr, numTuples * numComp);
     }
     else
     {
@@ -1778,7 +1999,7 @@ vtkAbstractArray* vtkDataReader::ReadArray(
     if (this->FileType == VTK_BINARY)
     {
       vtkReadBinaryData(this->IS, ptr, numTuples, numComp);
-      vtkByteSwap::Swap8BERange(ptr, numTuples * numComp);
+      vtkSwapBERange(ptr, numTuples * numComp);
     }
 
     else
@@ -1795,7 +2016,7 @@ vtkAbstractArray* vtkDataReader::ReadArray(
     if (this->FileType == VTK_BINARY)
     {
       vtkReadBinaryData(this->IS, ptr, numTuples, numComp);
-      vtkByteSwap::Swap8BERange(ptr, numTuples * numComp);
+      vtkSwapBERange(ptr, numTuples * numComp);
     }
 
     else
@@ -1812,7 +2033,7 @@ vtkAbstractArray* vtkDataReader::ReadArray(
     if (this->FileType == VTK_BINARY)
     {
       vtkReadBinaryData(this->IS, ptr, numTuples, numComp);
-      vtkByteSwap::Swap4BERange(ptr, numTuples * numComp);
+      vtkSwapBERange(ptr, numTuples * numComp);
     }
     else
     {
@@ -1828,7 +2049,7 @@ vtkAbstractArray* vtkDataReader::ReadArray(
     if (this->FileType == VTK_BINARY)
     {
       vtkReadBinaryData(this->IS, ptr, numTuples, numComp);
-      vtkByteSwap::Swap8BERange(ptr, numTuples * numComp);
+      vtkSwapBERange(ptr, numTuples * numComp);
     }
     else
     {
@@ -3187,7 +3408,6 @@ int vtkDataReader::ReadCells(vtkSmartPointer<vtkCellArray>& cellArray)
 int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data)
 {
   char line[256];
-  int i;
 
   if (this->FileType == VTK_BINARY)
   {
@@ -3201,19 +3421,16 @@ int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data)
                     << " for file: " << (fname ? fname : "(Null FileName)"));
       return 0;
     }
-    vtkByteSwap::Swap4BERange(data, size);
+    vtkSwapBERange(data, size);
   }
   else // ascii
   {
-    for (i = 0; i < size; i++)
+    if (!vtkReadASCIIData(this, data, size, 1))
     {
-      if (!this->Read(data + i))
-      {
-        const char* fname = this->CurrentFileName.c_str();
-        vtkErrorMacro(<< "Error reading ascii cell data!"
-                      << " for file: " << (fname ? fname : "(Null FileName)"));
-        return 0;
-      }
+      const char* fname = this->CurrentFileName.c_str();
+      vtkErrorMacro(<< "Error reading ascii cell data!"
+                    << " for file: " << (fname ? fname : "(Null FileName)"));
+      return 0;
     }
   }
 
@@ -3253,7 +3470,7 @@ int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data, int skip1, int rea
                     << " for file: " << (fname ? fname : "(Null FileName)"));
       return 0;
     }
-    vtkByteSwap::Swap4BERange(tmp, size);
+    vtkSwapBERange(tmp, size);
     if (tmp == data)
     {
       return 1;
@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the vertices and faces of PLY files, which are read by blocks and
+// converted concurrently, are read back exactly as written, in ASCII and
+// binary files of both byte orders, from a file and from a string.
+
+#include "vtkCellArray.h"
+#include "vtkFloatArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPLYReader.h"
+#include "vtkPLYWriter.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace
+{
+// A sphere with enough vertices and faces to be read in several blocks, with
+// polygons of various sizes, normals, colors and texture coordinates.
+vtkSmartPointer<vtkPolyData> CreateInput()
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(800);
+  sphere->SetPhiResolution(400);
+  sphere->GenerateNormalsOn();
+  sphere->Update();
+
+  vtkNew<vtkPolyData> input;
+  input->ShallowCopy(sphere->GetOutput());
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  vtkNew<vtkUnsignedCharArray> colors;
+  colors->SetName("RGB");
+  colors->SetNumberOfComponents(3);
+  colors->SetNumberOfTuples(numPts);
+  vtkNew<vtkFloatArray> tcoords;
+  tcoords->SetName("TCoords");
+  tcoords->SetNumberOfComponents(2);
+  tcoords->SetNumberOfTuples(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    colors->SetTuple3(ptId, ptId % 256, (ptId / 256) % 256, 255);
+    double x[3];
+    input->GetPoint(ptId, x);
+    tcoords->SetTuple2(ptId, x[0], x[1]);
+  }
+  input->GetPointData()->SetScalars(colors);
+  input->GetPointData()->SetTCoords(tcoords);
+
+  vtkNew<vtkCellArray> polys;
+  polys->DeepCopy(input->GetPolys());
+  for (vtkIdType i = 0; i < 1000; ++i)
+  {
+    const vtkIdType polyPts[] = { i, i + 1, i + 2, i + 3, i + 4, i + 5 };
+    polys->InsertNextCell(4 + i % 3, polyPts);
+  }
+  input->SetPolys(polys);
+  return input;
+}
+
+bool TestConfiguration(
+  vtkPolyData* input, const std::string& fileName, int fileType, bool bigEndian)
+{
+  vtkNew<vtkPLYWriter> writer;
+  writer->SetInputData(input);
+  writer->SetFileType(fileType);
+  writer->SetArrayName("RGB");
+  if (bigEndian)
+  {
+    writer->SetDataByteOrderToBigEndian();
+  }
+  writer->SetFileName(fileName.c_str());
+  writer->Write();
+
+  vtkNew<vtkPLYReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  if (!vtkTestUtilities::CompareDataObjects(input, reader->GetOutput()))
+  {
+    vtkLog(ERROR, "Cannot read " << fileName << " back.");
+    return false;
+  }
+
+  std::ifstream file(fileName, std::ios::binary);
+  const std::string content(
+    (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  vtkNew<vtkPLYReader> stringReader;
+  stringReader->ReadFromInputStringOn();
+  stringReader->SetInputString(content);
+  stringReader->Update();
+  if (!vtkTestUtilities::CompareDataObjects(input, stringReader->GetOutput()))
+  {
+    vtkLog(ERROR, "Cannot read " << fileName << " back from a string.");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestPLYReaderThreaded(int argc, char* argv[])
+{
+  char* tempDirCStr =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string tempDir = tempDirCStr;
+  delete[] tempDirCStr;
+
+  vtkSmartPointer<vtkPolyData> input = CreateInput();
+  bool success =
+    TestConfiguration(input, tempDir + "/TestPLYReaderThreadedASCII.ply", VTK_ASCII, false);
+  success &=
+    TestConfiguration(input, tempDir + "/TestPLYReaderThreadedLE.ply", VTK_BINARY, false);
+  success &= TestConfiguration(input, tempDir + "/TestPLYReaderThreadedBE.ply", VTK_BINARY, true);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -22,18 +22,22 @@ chars representing red, green and blue.
 */
 
 #include "vtkPLY.h"
+#include "vtkBuffer.h"
 #include "vtkByteSwap.h"
 #include "vtkFileResourceStream.h"
 #include "vtkHeap.h"
 #include "vtkMath.h"
+#include "vtkMemoryMappedFile.h"
 #include "vtkMemoryResourceStream.h"
 #include "vtkResourceParser.h"
+#include "vtkSMPTools.h"
 #include "vtkStringFormatter.h"
 #include "vtkStringScanner.h"
 
 #include <vtksys/FStream.hxx>
 #include <vtksys/SystemTools.hxx>
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -41,6 +45,8 @@ chars representing red, green and blue.
 #include <fstream>
 #include <limits>
 #include <sstream>
+#include <type_traits>
+#include <vector>
 
 // This entire structure should be converted over to C++-isms instead of using
 // C APIs.
@@ -78,7 +84,200 @@ void* plyAllocateMemory(size_t n)
 const char* type_names[] = { "invalid", "char", "short", "int", "int8", "int16", "int32", "uchar",
   "ushort", "uint", "uint8", "uint16", "uint32", "float", "float32", "double", "float64" };
 
-constexpr int ply_type_size[] = { 0, 1, 2, 4, 1, 2, 4, 1, 2, 4, 1, 2, 4, 4, 4, 8 };
+constexpr int ply_type_size[] = { 0, 1, 2, 4, 1, 2, 4, 1, 2, 4, 1, 2, 4, 4, 4, 8, 8 };
+
+// Number of bytes of elements read at once by ply_get_elements().
+constexpr size_t PLY_BLOCK_SIZE = 8388608;
+
+// Get the value of a binary item in memory, in the byte order of the file,
+// as get_binary_item() does from the file.
+template <typename T>
+void get_binary_value(
+  const char* ptr, bool big_endian, int* int_val, unsigned int* uint_val, double* double_val)
+{
+  T value;
+  memcpy(&value, ptr, sizeof(value));
+  big_endian ? vtkByteSwap::SwapBE(&value) : vtkByteSwap::SwapLE(&value);
+  if constexpr (std::is_same<T, vtkTypeFloat32>::value)
+  {
+    *int_val =
+      static_cast<int>(vtkMath::ClampValue<double>(value, VTK_INT_MIN, 2147483520.0f));
+    *uint_val = static_cast<unsigned int>(vtkMath::ClampValue<double>(value, 0.0, 4294967040.0f));
+  }
+  else if constexpr (std::is_same<T, vtkTypeFloat64>::value)
+  {
+    *int_val = static_cast<int>(vtkMath::ClampValue<double>(value, VTK_INT_MIN, VTK_INT_MAX));
+    *uint_val =
+      static_cast<unsigned int>(vtkMath::ClampValue<double>(value, 0.0, VTK_UNSIGNED_INT_MAX));
+  }
+  else
+  {
+    *int_val = static_cast<int>(value);
+    *uint_val = static_cast<unsigned int>(value);
+  }
+  *double_val = static_cast<double>(value);
+}
+
+// Get the value of a binary item of the given type in memory.
+void get_binary_value(int type, const char* ptr, bool big_endian, int* int_val,
+  unsigned int* uint_val, double* double_val)
+{
+  switch (type)
+  {
+    case PLY_CHAR:
+    case PLY_INT8:
+      get_binary_value<vtkTypeInt8>(ptr, big_endian, int_val, uint_val, double_val);
+      break;
+    case PLY_UCHAR:
+    case PLY_UINT8:
+      get_binary_value<vtkTypeUInt8>(ptr, big_endian, int_val, uint_val, double_val);
+      break;
+    case PLY_SHORT:
+    case PLY_INT16:
+      get_binary_value<vtkTypeInt16>(ptr, big_endian, int_val, uint_val, double_val);
+      break;
+    case PLY_USHORT:
+    case PLY_UINT16:
+      get_binary_value<vtkTypeUInt16>(ptr, big_endian, int_val, uint_val, double_val);
+      break;
+    case PLY_INT:
+    case PLY_INT32:
+      get_binary_value<vtkTypeInt32>(ptr, big_endian, int_val, uint_val, double_val);
+      break;
+    case PLY_UINT:
+    case PLY_UINT32:
+      get_binary_value<vtkTypeUInt32>(ptr, big_endian, int_val, uint_val, double_val);
+      break;
+    case PLY_FLOAT:
+    case PLY_FLOAT32:
+      get_binary_value<vtkTypeFloat32>(ptr, big_endian, int_val, uint_val, double_val);
+      break;
+    default:
+      get_binary_value<vtkTypeFloat64>(ptr, big_endian, int_val, uint_val, double_val);
+      break;
+  }
+}
+
+// Get the value of an ascii word of the given type, as get_ascii_item() does
+// from the file.
+void get_ascii_value(int type, const char* first, const char* last, int* int_val,
+  unsigned int* uint_val, double* double_val)
+{
+  switch (type)
+  {
+    case PLY_UINT:
+    case PLY_UINT32:
+      vtk::from_chars(first, last, *uint_val);
+      *int_val = static_cast<int>(*uint_val);
+      break;
+    case PLY_FLOAT:
+    case PLY_FLOAT32:
+    case PLY_DOUBLE:
+    case PLY_FLOAT64:
+      vtk::from_chars(first, last, *double_val);
+      break;
+    default:
+      vtk::from_chars(first, last, *int_val);
+      *uint_val = static_cast<unsigned int>(*int_val);
+      break;
+  }
+}
+
+inline bool is_ascii_space(char c)
+{
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+enum class ElementStatus
+{
+  Whole,
+  Incomplete,
+  Invalid
+};
+
+// Read an element of the given text or binary data, moving ptr to its end.
+// The element is incomplete if it does not end before end, or at end when
+// at_eof is set.  With a nullptr elem_ptr, only the sizes of the lists are
+// read.  Otherwise, the properties are stored in elem_ptr as
+// ascii_get_element() and binary_get_element() do.
+ElementStatus get_element_in_memory(PlyElement* elem, const char*& ptr, const char* end,
+  bool at_eof, bool ascii, bool big_endian, char* elem_ptr)
+{
+  int int_val = 0;
+  unsigned int uint_val = 0;
+  double double_val = 0.0;
+  auto get_value = [&](int type, bool parse)
+  {
+    if (!ascii)
+    {
+      const int size = ply_type_size[type];
+      if (end - ptr < size)
+        return false;
+      if (parse)
+        get_binary_value(type, ptr, big_endian, &int_val, &uint_val, &double_val);
+      ptr += size;
+      return true;
+    }
+    while (ptr != end && is_ascii_space(*ptr))
+      ptr++;
+    const char* word = ptr;
+    while (ptr != end && !is_ascii_space(*ptr))
+      ptr++;
+    if (word == ptr || (ptr == end && !at_eof))
+      return false;
+    if (parse)
+      get_ascii_value(type, word, ptr, &int_val, &uint_val, &double_val);
+    return true;
+  };
+
+  for (int j = 0; j < elem->nprops; j++)
+  {
+    PlyProperty* prop = elem->props[j];
+    const bool store_it = elem_ptr && elem->store_prop[j];
+    if (prop->is_list)
+    {
+      /* get and store the number of items in the list */
+      if (!get_value(prop->count_external, true))
+        return ElementStatus::Incomplete;
+      const int list_count = int_val;
+      if (list_count < 0)
+        return ElementStatus::Invalid;
+      char* item = nullptr;
+      if (store_it)
+      {
+        vtkPLY::store_item(elem_ptr + prop->count_offset, prop->count_internal, int_val, uint_val,
+          double_val);
+        /* allocate space for an array of items and store a ptr to the array */
+        char** store_array = (char**)(elem_ptr + prop->offset);
+        *store_array = list_count == 0
+          ? nullptr
+          : (char*)myalloc(sizeof(char) * ply_type_size[prop->internal_type] * list_count);
+        item = *store_array;
+      }
+
+      /* read items and store them into the array */
+      for (int k = 0; k < list_count; k++)
+      {
+        if (!get_value(prop->external_type, store_it))
+          return ElementStatus::Incomplete;
+        if (store_it)
+        {
+          vtkPLY::store_item(item, prop->internal_type, int_val, uint_val, double_val);
+          item += ply_type_size[prop->internal_type];
+        }
+      }
+    }
+    else
+    { /* not a list */
+      if (!get_value(prop->external_type, store_it))
+        return ElementStatus::Incomplete;
+      if (store_it)
+        vtkPLY::store_item(
+          elem_ptr + prop->offset, prop->internal_type, int_val, uint_val, double_val);
+    }
+  }
+  return ElementStatus::Whole;
+}
 }
 
 #define NO_OTHER_PROPS (-1)
@@ -798,17 +997,35 @@ PlyFile* vtkPLY::ply_open_for_reading(const char* filename, int* nelems, char***
   // memory leaks
   plyInitialize();
 
-  /* open the file for reading */
-  auto ifs = vtkSmartPointer<vtkFileResourceStream>::New();
-  if (!ifs->Open(filename))
+  /* map the file in memory if possible, or open it for reading */
+  vtkSmartPointer<vtkResourceStream> is;
+  vtksys::SystemTools::Stat_t status;
+  const size_t size = filename && vtksys::SystemTools::Stat(filename, &status) == 0
+    ? static_cast<size_t>(status.st_size)
+    : 0;
+  if (void* region = size > 0 ? vtkMemoryMappedFile::MapRegion(filename, 0, size) : nullptr)
+  {
+    auto buffer = vtkSmartPointer<vtkBuffer<char>>::New();
+    buffer->SetBuffer(static_cast<char*>(region), static_cast<vtkIdType>(size));
+    buffer->SetFreeFunction(false, vtkMemoryMappedFile::FreeRegion);
+    auto mem = vtkSmartPointer<vtkMemoryResourceStream>::New();
+    mem->SetBuffer(buffer);
+    is = mem;
+  }
+  else
   {
-    plyCleanUp();
-    return nullptr;
+    auto ifs = vtkSmartPointer<vtkFileResourceStream>::New();
+    if (!ifs->Open(filename))
+    {
+      plyCleanUp();
+      return nullptr;
+    }
+    is = ifs;
   }
 
   /* create the PlyFile data structure */
 
-  plyfile = vtkPLY::ply_read(ifs, nelems, elem_names);
+  plyfile = vtkPLY::ply_read(is, nelems, elem_names);
   if (plyfile == nullptr)
   {
     plyCleanUp();
@@ -995,6 +1212,28 @@ void vtkPLY::ply_get_element(PlyFile* plyfile, void* elem_ptr)
     binary_get_element(plyfile, (char*)elem_ptr);
 }
 
+/******************************************************************************
+Read a number of elements into an array.  This routine assumes that we're
+reading the type of element specified in the last call to the routine
+ply_get_element_setup().  Elements without other properties are read by
+blocks and converted concurrently.
+
+Entry:
+  plyfile   - file identifier
+  elem_ptrs - pointer to the array where the elements should be put
+  num_elems - number of elements to read
+  elem_size - size of the elements in the array, in bytes
+******************************************************************************/
+
+void vtkPLY::ply_get_elements(PlyFile* plyfile, void* elem_ptrs, int num_elems, int elem_size)
+{
+  if (get_elements_by_blocks(plyfile, (char*)elem_ptrs, num_elems, elem_size))
+    return;
+
+  for (int i = 0; i < num_elems; i++)
+    ply_get_element(plyfile, (char*)elem_ptrs + static_cast<size_t>(i) * elem_size);
+}
+
 /******************************************************************************
 Extract the comments from the header information of a PLY file.
 
@@ -1716,6 +1955,90 @@ bool vtkPLY::binary_get_element(PlyFile* plyfile, char* elem_ptr)
   return true;
 }
 
+/******************************************************************************
+Read a number of elements by blocks and convert them concurrently.  The whole
+elements of each block, whose lists have variable sizes, are found first, then
+converted, and the file is moved back to the end of the last one.  Elements
+with other properties, and files that cannot seek, cannot be read this way.
+
+Entry:
+  plyfile   - file identifier
+  elem_ptrs - pointer to an array of elements
+  num_elems - number of elements to read
+  elem_size - size of the elements in the array, in bytes
+
+Exit:
+  returns false, before reading anything, if the elements cannot be read by blocks
+******************************************************************************/
+
+bool vtkPLY::get_elements_by_blocks(
+  PlyFile* plyfile, char* elem_ptrs, int num_elems, int elem_size)
+{
+  /* the kind of element we're reading currently */
+  PlyElement* elem = plyfile->which_elem;
+  vtkTypeInt64 position = plyfile->parser->Tell();
+  if (elem->other_offset != NO_OTHER_PROPS || position < 0)
+    return false;
+
+  const bool ascii = plyfile->file_type == PLY_ASCII;
+  const bool big_endian = plyfile->file_type == PLY_BINARY_BE;
+  std::vector<char> block(PLY_BLOCK_SIZE);
+  std::vector<const char*> starts;
+  int first = 0;
+  while (first < num_elems)
+  {
+    const size_t size = plyfile->parser->Read(block.data(), block.size());
+    const bool at_eof = size < block.size();
+    const char* end = block.data() + size;
+
+    /* find the whole elements of the block */
+    starts.clear();
+    const char* whole_end = block.data();
+    ElementStatus status = ElementStatus::Whole;
+    while (first + static_cast<int>(starts.size()) < num_elems)
+    {
+      const char* ptr = whole_end;
+      status = get_element_in_memory(elem, ptr, end, at_eof, ascii, big_endian, nullptr);
+      if (status != ElementStatus::Whole)
+        break;
+      starts.push_back(whole_end);
+      whole_end = ptr;
+    }
+
+    if (starts.empty())
+    {
+      if (status == ElementStatus::Incomplete && !at_eof)
+      {
+        /* an element larger than the block */
+        block.resize(2 * block.size());
+        plyfile->parser->Seek(position, vtkResourceStream::SeekDirection::Begin);
+        continue;
+      }
+      vtkGenericWarningMacro("PLY error reading file."
+        << " Premature EOF or invalid list while reading " << elem->name << " elements.");
+      memset(elem_ptrs + static_cast<size_t>(first) * elem_size, 0,
+        static_cast<size_t>(num_elems - first) * elem_size);
+      break;
+    }
+
+    vtkSMPTools::For(0, static_cast<vtkIdType>(starts.size()),
+      [&](vtkIdType begin, vtkIdType endElem)
+      {
+        for (vtkIdType i = begin; i < endElem; i++)
+        {
+          const char* elem_data = starts[i];
+          get_element_in_memory(elem, elem_data, end, at_eof, ascii, big_endian,
+            elem_ptrs + (first + i) * elem_size);
+        }
+      });
+
+    first += static_cast<int>(starts.size());
+    position += whole_end - block.data();
+    plyfile->parser->Seek(position, vtkResourceStream::SeekDirection::Begin);
+  }
+  return true;
+}
+
 /******************************************************************************
 Write to a file the word that represents a PLY data type.
 
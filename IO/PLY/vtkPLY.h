@@ -175,6 +175,7 @@ public:
   static void ply_get_property(PlyFile*, const char*, PlyProperty*);
   static PlyOtherProp* ply_get_other_properties(PlyFile*, const char*, int);
   static void ply_get_element(PlyFile*, void*);
+  static void ply_get_elements(PlyFile*, void*, int, int);
   static char** ply_get_comments(PlyFile*, int*);
   static char** ply_get_obj_info(PlyFile*, int*);
   static void ply_close(PlyFile*);
@@ -208,6 +209,7 @@ public:
   static bool get_binary_item(PlyFile*, int, int*, unsigned int*, double*);
   static bool ascii_get_element(PlyFile*, char*);
   static bool binary_get_element(PlyFile*, char*);
+  static bool get_elements_by_blocks(PlyFile*, char*, int, int);
   static void* my_alloc(size_t, int, const char*);
   static int get_prop_type(const char*);
 };
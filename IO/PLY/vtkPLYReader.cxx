@@ -19,6 +19,7 @@
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
 #include "vtkResourceParser.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStringArray.h"
 #include "vtkUnsignedCharArray.h"
@@ -396,31 +397,33 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
         rgbPoints->SetNumberOfTuples(numPts);
       }
 
-      plyVertex vertex;
-      for (int j = 0; j < numPts; j++)
-      {
-        vtkPLY::ply_get_element(ply, (void*)&vertex);
-        pts->SetPoint(j, vertex.x);
-        if (texCoordsPointsAvailable)
-        {
-          texCoordsPoints->SetTuple2(j, vertex.tex[0], vertex.tex[1]);
-        }
-        if (normalPointsAvailable)
-        {
-          normals->SetTuple3(j, vertex.normal[0], vertex.normal[1], vertex.normal[2]);
-        }
-        if (rgbPointsAvailable)
+      // Vertices are read by blocks and converted concurrently, then copied
+      // concurrently too.
+      std::vector<plyVertex> vertices(numPts);
+      vtkPLY::ply_get_elements(ply, vertices.data(), numPts, sizeof(plyVertex));
+      float* coords = vtkArrayDownCast<vtkFloatArray>(pts->GetData())->GetPointer(0);
+      vtkSMPTools::For(0, numPts,
+        [&](vtkIdType begin, vtkIdType end)
         {
-          if (rgbPointsHaveAlpha)
+          for (vtkIdType j = begin; j < end; j++)
           {
-            rgbPoints->SetTuple4(j, vertex.red, vertex.green, vertex.blue, vertex.alpha);
-          }
-          else
-          {
-            rgbPoints->SetTuple3(j, vertex.red, vertex.green, vertex.blue);
+            const plyVertex& vertex = vertices[j];
+            std::copy(vertex.x, vertex.x + 3, coords + 3 * j);
+            if (texCoordsPointsAvailable)
+            {
+              texCoordsPoints->SetTypedTuple(j, vertex.tex);
+            }
+            if (normalPointsAvailable)
+            {
+              normals->SetTypedTuple(j, vertex.normal);
+            }
+            if (rgbPointsAvailable)
+            {
+              const unsigned char rgba[4] = { vertex.red, vertex.green, vertex.blue, vertex.alpha };
+              rgbPoints->SetTypedTuple(j, rgba);
+            }
           }
-        }
-      }
+        });
       output->SetPoints(pts);
       pts->Delete();
     } // if vertex
@@ -443,7 +446,6 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
       numPolys = numElems;
       vtkSmartPointer<vtkCellArray> polys = vtkSmartPointer<vtkCellArray>::New();
       polys->AllocateEstimate(numPolys, 3);
-      plyFace face;
       vtkIdType vtkVerts[256];
 
       // Get the face properties
@@ -480,17 +482,24 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
         }
       }
 
-      // grab all the face elements
+      // grab all the face elements, by batches read and converted concurrently
+      constexpr int faceBatchSize = 65536;
+      std::vector<plyFace> faces;
       vtkNew<vtkPolygon> cell;
       for (int j = 0; j < numPolys; j++)
       {
-        // grab and element from the file
-        vtkPLY::ply_get_element(ply, (void*)&face);
+        if (j % faceBatchSize == 0)
+        {
+          faces.resize(std::min(faceBatchSize, numPolys - j));
+          vtkPLY::ply_get_elements(
+            ply, faces.data(), static_cast<int>(faces.size()), sizeof(plyFace));
+        }
+        const plyFace& face = faces[j % faceBatchSize];
         for (int k = 0; k < face.nverts; k++)
         {
           vtkVerts[k] = face.verts[k];
         }
-        free(face.verts); // allocated in vtkPLY::ascii/binary_get_element
+        free(face.verts); // allocated in vtkPLY::ply_get_elements
 
         cell->Initialize(face.nverts, vtkVerts, output->GetPoints());
         if (intensityAvailable)
@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that compressed arrays made of many blocks, which are decompressed
+// concurrently by vtkXMLDataParser, are read back correctly, including
+// sub-extents starting and ending in the middle of blocks, and that they are
+// also read back when the concurrent decompression is turned off.
+
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+vtkSmartPointer<vtkImageData> CreateImage()
+{
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 39, 0, 29, 0, 19);
+  const vtkIdType numPts = image->GetNumberOfPoints();
+
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(numPts);
+  vtkNew<vtkIntArray> indices;
+  indices->SetName("Indices");
+  indices->SetNumberOfTuples(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    vectors->SetTuple3(ptId, std::sin(0.01 * ptId), std::cos(0.02 * ptId), 0.5 * ptId);
+    indices->SetValue(ptId, static_cast<int>(ptId));
+  }
+  image->GetPointData()->AddArray(vectors);
+  image->GetPointData()->AddArray(indices);
+  return image;
+}
+
+bool CompareImages(vtkImageData* expected, vtkImageData* actual, const std::string& name)
+{
+  int extent[6];
+  actual->GetExtent(extent);
+  for (const char* arrayName : { "Vectors", "Indices" })
+  {
+    vtkDataArray* expectedArray = expected->GetPointData()->GetArray(arrayName);
+    vtkDataArray* actualArray = actual->GetPointData()->GetArray(arrayName);
+    if (!actualArray || actualArray->GetNumberOfTuples() != actual->GetNumberOfPoints())
+    {
+      vtkLog(ERROR, "Array " << arrayName << " is missing with " << name << ".");
+      return false;
+    }
+    for (int k = extent[4]; k <= extent[5]; ++k)
+    {
+      for (int j = extent[2]; j <= extent[3]; ++j)
+      {
+        for (int i = extent[0]; i <= extent[1]; ++i)
+        {
+          int ijk[3] = { i, j, k };
+          const vtkIdType expectedId = expected->ComputePointId(ijk);
+          const vtkIdType actualId = actual->ComputePointId(ijk);
+          for (int c = 0; c < expectedArray->GetNumberOfComponents(); ++c)
+          {
+            if (expectedArray->GetComponent(expectedId, c) !=
+              actualArray->GetComponent(actualId, c))
+            {
+              vtkLog(ERROR,
+                "Array " << arrayName << " differs at point (" << i << ", " << j << ", " << k
+                         << ") with " << name << ".");
+              return false;
+            }
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool TestConfiguration(
+  vtkImageData* image, int compressorType, bool appended, bool encode, bool threaded = true)
+{
+  const std::string name = "compressor " + std::to_string(compressorType) +
+    (appended ? (encode ? ", encoded appended data" : ", raw appended data") : ", binary data") +
+    (threaded ? "" : ", sequential decompression");
+
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->SetCompressorType(compressorType);
+  writer->SetBlockSize(4096);
+  writer->SetHeaderTypeToUInt64();
+  if (appended)
+  {
+    writer->SetDataModeToAppended();
+    writer->SetEncodeAppendedData(encode);
+  }
+  else
+  {
+    writer->SetDataModeToBinary();
+  }
+  writer->WriteToOutputStringOn();
+  writer->Write();
+
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(writer->GetOutputString());
+  reader->SetUseThreadedDecompression(threaded);
+  reader->Update();
+  if (!CompareImages(image, reader->GetOutput(), name))
+  {
+    return false;
+  }
+
+  // Rows of a sub-extent start and end in the middle of compressed blocks.
+  const int subExtent[6] = { 5, 30, 3, 25, 2, 17 };
+  vtkAlgorithm* algorithm = reader;
+  algorithm->UpdateExtent(subExtent);
+  return CompareImages(image, reader->GetOutput(), name + " and a sub-extent");
+}
+}
+
+int TestXMLCompressedBlocks(int, char*[])
+{
+  vtkSmartPointer<vtkImageData> image = CreateImage();
+
+  bool success = true;
+  for (int compressorType :
+    { vtkXMLWriterBase::ZLIB, vtkXMLWriterBase::LZ4, vtkXMLWriterBase::LZMA })
+  {
+    success &= TestConfiguration(image, compressorType, true, false);
+    success &= TestConfiguration(image, compressorType, true, true);
+    success &= TestConfiguration(image, compressorType, false, false);
+    success &= TestConfiguration(image, compressorType, true, false, false);
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
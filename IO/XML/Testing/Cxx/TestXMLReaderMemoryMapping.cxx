@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the XML readers give the same data with and without memory
+// mapping, for files that can be mapped and files that cannot, that the
+// arrays of raw files are actually mapped, and that modifying mapped arrays
+// does not change the file.
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+template <class WriterT>
+void Write(vtkDataObject* data, const std::string& fileName, bool raw, int headerType)
+{
+  vtkNew<WriterT> writer;
+  writer->SetInputData(data);
+  writer->SetFileName(fileName.c_str());
+  writer->SetDataModeToAppended();
+  writer->SetEncodeAppendedData(!raw);
+  writer->SetCompressorTypeToNone();
+  writer->SetHeaderType(headerType);
+  writer->Write();
+}
+
+template <class ReaderT>
+vtkSmartPointer<vtkDataObject> Read(
+  const std::string& fileName, bool useMemoryMapping, vtkIdType* numberOfMappedArrays = nullptr)
+{
+  vtkNew<ReaderT> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetUseMemoryMapping(useMemoryMapping);
+  reader->Update();
+  if (numberOfMappedArrays)
+  {
+    *numberOfMappedArrays = reader->GetNumberOfMappedArrays();
+  }
+  return reader->GetOutputDataObject(0);
+}
+
+bool TestImage(const std::string& tempDir, bool raw, int headerType)
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(31, 17, 11);
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(image->GetNumberOfPoints());
+  vtkNew<vtkIntArray> indices;
+  indices->SetName("Indices");
+  indices->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < image->GetNumberOfPoints(); ++ptId)
+  {
+    vectors->SetTuple3(ptId, std::sin(0.01 * ptId), std::cos(0.02 * ptId), 0.5 * ptId);
+    indices->SetValue(ptId, static_cast<int>(ptId));
+  }
+  image->GetPointData()->AddArray(indices);
+  image->GetPointData()->AddArray(vectors);
+
+  const std::string fileName = tempDir + "/TestXMLReaderMemoryMapping.vti";
+  Write<vtkXMLImageDataWriter>(image, fileName, raw, headerType);
+  const std::string name = std::string(raw ? "raw" : "encoded") + " image with " +
+    std::to_string(headerType) + " bits headers";
+
+  vtkIdType numberOfMappedArrays;
+  vtkSmartPointer<vtkDataObject> mapped =
+    Read<vtkXMLImageDataReader>(fileName, true, &numberOfMappedArrays);
+  if (!vtkTestUtilities::CompareDataObjects(image, mapped))
+  {
+    vtkLog(ERROR, "The mapped " << name << " differs from the original one.");
+    return false;
+  }
+  // Both arrays of raw data are mapped, base64 encoded data are read instead.
+  if (numberOfMappedArrays != (raw ? 2 : 0))
+  {
+    vtkLog(ERROR, "Got " << numberOfMappedArrays << " mapped arrays for the " << name << ".");
+    return false;
+  }
+
+  // Mapped arrays are copied on write, and grow like other arrays.
+  vtkDataArray* mappedVectors =
+    vtkImageData::SafeDownCast(mapped)->GetPointData()->GetArray("Vectors");
+  mappedVectors->SetComponent(0, 0, -1.0);
+  mappedVectors->InsertNextTuple3(1.0, 2.0, 3.0);
+  vtkSmartPointer<vtkDataObject> copy = Read<vtkXMLImageDataReader>(fileName, false);
+  if (!vtkTestUtilities::CompareDataObjects(image, copy))
+  {
+    vtkLog(ERROR, "The " << name << " read again differs from the original one.");
+    return false;
+  }
+  if (mappedVectors->GetComponent(0, 0) != -1.0 ||
+    mappedVectors->GetComponent(image->GetNumberOfPoints(), 2) != 3.0)
+  {
+    vtkLog(ERROR, "A mapped array of " << name << " cannot be modified.");
+    return false;
+  }
+  return true;
+}
+
+bool TestPolyData(const std::string& tempDir)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(32);
+  sphere->Update();
+  vtkPolyData* expected = sphere->GetOutput();
+
+  const std::string fileName = tempDir + "/TestXMLReaderMemoryMapping.vtp";
+  Write<vtkXMLPolyDataWriter>(expected, fileName, true, 64);
+  vtkIdType numberOfMappedArrays;
+  vtkSmartPointer<vtkDataObject> mapped =
+    Read<vtkXMLPolyDataReader>(fileName, true, &numberOfMappedArrays);
+  if (!vtkTestUtilities::CompareDataObjects(expected, mapped))
+  {
+    vtkLog(ERROR, "The mapped poly data differs from the original one.");
+    return false;
+  }
+  // The points, the normals and the connectivity of the polygons. The offsets
+  // are read after a leading zero, so they are copied.
+  if (numberOfMappedArrays != 3)
+  {
+    vtkLog(ERROR, "Only " << numberOfMappedArrays << " arrays of the poly data were mapped.");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestXMLReaderMemoryMapping(int argc, char* argv[])
+{
+  char* tempDirCStr =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string tempDir = tempDirCStr;
+  delete[] tempDirCStr;
+
+  bool success = TestImage(tempDir, true, 32);
+  success &= TestImage(tempDir, true, 64);
+  // Base64 encoded data cannot be mapped, it is read instead.
+  success &= TestImage(tempDir, false, 64);
+  success &= TestPolyData(tempDir);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
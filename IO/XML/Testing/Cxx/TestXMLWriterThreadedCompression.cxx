@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the blocks compressed concurrently by vtkXMLWriter give the
+// same file as a sequential compression, for arrays smaller and larger than
+// the batches of blocks compressed at once, as well as the file written with
+// the concurrent compression turned off, and that the file reads back.
+
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+vtkSmartPointer<vtkImageData> CreateImage(int res)
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(res, res, res);
+  const vtkIdType numPts = image->GetNumberOfPoints();
+
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(numPts);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        vectors->SetTuple3(ptId, std::sin(0.001 * ptId), ptId % 1000, 0.5 * (ptId / 1000));
+      }
+    });
+  // The writers cache the range of the vectors in their information, which
+  // is then written as well: compute it now so that all the files match.
+  vectors->GetRange(-1);
+  image->GetPointData()->SetVectors(vectors);
+  return image;
+}
+
+std::string Write(
+  vtkImageData* image, int compressorType, bool appended, bool useThreadedCompression = true)
+{
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->SetCompressorType(compressorType);
+  writer->SetUseThreadedCompression(useThreadedCompression);
+  writer->SetHeaderTypeToUInt64();
+  if (appended)
+  {
+    writer->SetDataModeToAppended();
+    writer->EncodeAppendedDataOff();
+  }
+  else
+  {
+    writer->SetDataModeToBinary();
+  }
+  writer->WriteToOutputStringOn();
+  writer->Write();
+  return writer->GetOutputString();
+}
+
+bool TestConfiguration(vtkImageData* image, int compressorType, bool appended)
+{
+  const std::string name = "compressor " + std::to_string(compressorType) +
+    (appended ? ", appended data" : ", binary data") + " and " +
+    std::to_string(image->GetNumberOfPoints()) + " points";
+
+  const std::string threaded = Write(image, compressorType, appended);
+  std::string sequential;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ std::string("Sequential") },
+    [&]() { sequential = Write(image, compressorType, appended); });
+  if (threaded != sequential)
+  {
+    vtkLog(ERROR, "The file depends on the number of threads with " << name << ".");
+    return false;
+  }
+  if (threaded != Write(image, compressorType, appended, false))
+  {
+    vtkLog(ERROR, "The file depends on UseThreadedCompression with " << name << ".");
+    return false;
+  }
+
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(threaded);
+  reader->Update();
+  vtkDataArray* expected = image->GetPointData()->GetVectors();
+  vtkDataArray* actual = reader->GetOutput()->GetPointData()->GetVectors();
+  if (!actual || actual->GetNumberOfTuples() != expected->GetNumberOfTuples())
+  {
+    vtkLog(ERROR, "Wrong number of vectors read back with " << name << ".");
+    return false;
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfValues(); ++i)
+  {
+    if (expected->GetComponent(i / 3, i % 3) != actual->GetComponent(i / 3, i % 3))
+    {
+      vtkLog(ERROR, "Value " << i << " differs with " << name << ".");
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestXMLWriterThreadedCompression(int, char*[])
+{
+  vtkSmartPointer<vtkImageData> small = CreateImage(40);
+  bool success = true;
+  for (int compressorType :
+    { vtkXMLWriterBase::ZLIB, vtkXMLWriterBase::LZ4, vtkXMLWriterBase::LZMA })
+  {
+    success &= TestConfiguration(small, compressorType, true);
+    success &= TestConfiguration(small, compressorType, false);
+  }
+
+  // More than 32MB of vectors, compressed in several batches.
+  vtkSmartPointer<vtkImageData> large = CreateImage(150);
+  success &= TestConfiguration(large, vtkXMLWriterBase::LZ4, true);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -342,6 +342,7 @@ int vtkXMLPDataReader::ReadPieceData(int index)
 
   // Actually read the data.
   this->PieceReaders[this->Piece]->SetAbortExecute(0);
+  this->PieceReaders[this->Piece]->SetUseMemoryMapping(this->GetUseMemoryMapping());
   vtkDataArraySelection* pds = this->PieceReaders[this->Piece]->GetPointDataArraySelection();
   vtkDataArraySelection* cds = this->PieceReaders[this->Piece]->GetCellDataArraySelection();
   pds->CopySelections(this->PointDataArraySelection);
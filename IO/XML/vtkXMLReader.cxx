@@ -26,6 +26,7 @@
 #include "vtkInformationVector.h"
 #include "vtkLZ4DataCompressor.h"
 #include "vtkLZMADataCompressor.h"
+#include "vtkMemoryMappedFile.h"
 #include "vtkObjectFactory.h"
 #include "vtkQuadratureSchemeDefinition.h"
 #include "vtkResourceStream.h"
@@ -37,6 +38,10 @@
 #include "vtkXMLReaderVersion.h"
 #include "vtkZLibDataCompressor.h"
 
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+#include "vtkZstdDataCompressor.h"
+#endif
+
 #include "vtksys/Encoding.hxx"
 #include "vtksys/FStream.hxx"
 #include <vtksys/SystemTools.hxx>
@@ -254,6 +259,9 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << "ResourceStream: (none)\n";
   }
+  os << indent << "UseMemoryMapping: " << this->UseMemoryMapping << "\n";
+  os << indent << "NumberOfMappedArrays: " << this->NumberOfMappedArrays << "\n";
+  os << indent << "UseThreadedDecompression: " << this->UseThreadedDecompression << "\n";
   os << indent << "TimeStep:" << this->TimeStep << "\n";
   os << indent << "ActiveTimeDataArrayName:"
      << (this->ActiveTimeDataArrayName ? this->ActiveTimeDataArrayName : "(null)") << "\n";
@@ -566,6 +574,12 @@ void vtkXMLReader::SetupCompressor(const char* type)
     {
       compressor = vtkLZMADataCompressor::New();
     }
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+    else if (strcmp(type, "vtkZstdDataCompressor") == 0)
+    {
+      compressor = vtkZstdDataCompressor::New();
+    }
+#endif
   }
 
   if (!compressor)
@@ -788,6 +802,7 @@ int vtkXMLReader::RequestData(vtkInformation* vtkNotUsed(request),
   // reads will work.
   (*this->Stream).imbue(std::locale::classic());
   this->XMLParser->SetStream(this->Stream);
+  this->XMLParser->SetUseThreadedDecompression(this->UseThreadedDecompression);
 
   // We are just starting to read.  Do not call UpdateProgressDiscrete
   // because we want a 0 progress callback the first time.
@@ -802,6 +817,7 @@ int vtkXMLReader::RequestData(vtkInformation* vtkNotUsed(request),
     // We are just starting to execute.  No errors have yet occurred.
     this->XMLParser->SetAbort(0);
     this->DataError = 0;
+    this->NumberOfMappedArrays = 0;
 
     // Let the subclasses read the data they want.
     this->ReadXMLData();
@@ -1023,6 +1039,46 @@ int vtkXMLDataReaderReadArrayValues(vtkXMLDataElement* da, vtkXMLDataParser* xml
 
 }
 
+//------------------------------------------------------------------------------
+bool vtkXMLReader::MapArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
+  vtkAbstractArray* array, vtkIdType startIndex, vtkIdType numValues)
+{
+  // Only whole arrays of numbers, read from the file by name, can use it.
+  if (arrayIndex != 0 || startIndex != 0 || numValues == 0 ||
+    numValues != array->GetNumberOfValues() || !array->IsNumeric() ||
+    array->GetDataType() == VTK_BIT || !this->FileName || !this->FileStream ||
+    this->Stream != this->FileStream || !da->GetAttribute("offset"))
+  {
+    return false;
+  }
+
+  vtkTypeInt64 offset = 0;
+  da->GetScalarAttribute("offset", offset);
+  vtkTypeInt64 position = 0;
+  const size_t numWords = static_cast<size_t>(numValues);
+  if (!this->XMLParser->FindRawAppendedData(offset, numWords, array->GetDataType(), position))
+  {
+    return false;
+  }
+
+  // Mappings start on page boundaries, so misaligned values in the file would
+  // be misaligned in memory.
+  const size_t wordSize = static_cast<size_t>(array->GetDataTypeSize());
+  if (position % wordSize != 0)
+  {
+    return false;
+  }
+
+  void* values = vtkMemoryMappedFile::MapRegion(this->FileName, position, numWords * wordSize);
+  if (!values)
+  {
+    return false;
+  }
+  array->SetVoidArray(values, numValues, 0, vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+  array->SetArrayFreeFunction(vtkMemoryMappedFile::FreeRegion);
+  return true;
+}
+
 //------------------------------------------------------------------------------
 int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
   vtkAbstractArray* array, vtkIdType startIndex, vtkIdType numValues, FieldType fieldType)
@@ -1041,12 +1097,22 @@ int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
                                << arrayIndex + numValues << " were requested to be read");
     return 0;
   }
-  switch (array->GetDataType())
+  if (this->UseMemoryMapping &&
+    this->MapArrayValues(da, arrayIndex, array, startIndex, numValues))
   {
-    vtkArrayIteratorTemplateMacro(result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
-                                    arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
-    default:
-      result = 0;
+    ++this->NumberOfMappedArrays;
+    result = 1;
+  }
+  else
+  {
+    switch (array->GetDataType())
+    {
+      vtkArrayIteratorTemplateMacro(
+        result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser, arrayIndex,
+          static_cast<VTK_TT*>(iter), startIndex, numValues));
+      default:
+        result = 0;
+    }
   }
   if (iter)
   {
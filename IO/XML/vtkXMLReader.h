@@ -118,6 +118,42 @@ public:
   vtkResourceStream* GetStream();
   ///@}
 
+  ///@{
+  /**
+   * Enable memory mapping of the arrays stored uncompressed in raw appended
+   * data, in the byte order of this machine.  Such arrays are not read: they
+   * use the content of the file mapped in memory, which is much faster for
+   * large files and lets processes reading the same file share its pages.
+   * Modifying these arrays copies the modified pages in memory, it never
+   * changes the file, which must not be truncated while the arrays exist.
+   * Other arrays, partially read arrays, and arrays read from a string or
+   * a stream are read as usual.
+   * Default is false.
+   */
+  vtkSetMacro(UseMemoryMapping, bool);
+  vtkGetMacro(UseMemoryMapping, bool);
+  vtkBooleanMacro(UseMemoryMapping, bool);
+  ///@}
+
+  /**
+   * Get the number of arrays of the last update that use the content of the
+   * file mapped in memory instead of being read, see UseMemoryMapping.
+   */
+  vtkGetMacro(NumberOfMappedArrays, vtkIdType);
+
+  ///@{
+  /**
+   * Enable the concurrent decompression of the blocks of compressed arrays.
+   * The compressor is then used by several threads at once, see
+   * vtkDataCompressor.  Turn this off when using a custom compressor whose
+   * Uncompress method is not thread-safe.
+   * Default is true.
+   */
+  vtkSetMacro(UseThreadedDecompression, bool);
+  vtkGetMacro(UseThreadedDecompression, bool);
+  vtkBooleanMacro(UseThreadedDecompression, bool);
+  ///@}
+
   /**
    * Test whether the file (type) with the given name can be read by this
    * reader. If the file has a newer version than the reader, we still say
@@ -552,6 +588,16 @@ private:
 
   bool ReadFromInputStream = false;
 
+  bool UseMemoryMapping = false;
+  vtkIdType NumberOfMappedArrays = 0;
+
+  bool UseThreadedDecompression = true;
+
+  // Make array use the values of da mapped in memory, if they are stored as
+  // is in the file.  Returns false if the values must be read.
+  bool MapArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex, vtkAbstractArray* array,
+    vtkIdType startIndex, vtkIdType numValues);
+
   // The stream used to read the input if it is in a file.
   istream* FileStream;
   // The stream used to read the input if it is in a string.
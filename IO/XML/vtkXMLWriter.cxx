@@ -34,6 +34,7 @@
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringFormatter.h"
@@ -54,6 +55,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #if !defined(_WIN32) || defined(__CYGWIN__)
 #include <unistd.h> /* unlink */
@@ -1003,6 +1005,12 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
     }
 
+    // Compress and write the blocks still queued.
+    if (result && !this->WriteCompressionBlocks())
+    {
+      result = 0;
+    }
+
     // Finish writing the data.
     if (result && !this->DataStream->EndWriting())
     {
@@ -1359,8 +1367,10 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
   this->CompressionHeader->Set(1, this->BlockSize);
   this->CompressionHeader->Set(2, lastBlockSize);
 
-  // Initialize counter for block writing.
+  // Initialize counter and queue for block writing.
   this->CompressionBlockNumber = 0;
+  this->CompressionBlocksData.clear();
+  this->CompressionBlocksSizes.clear();
 
   return result;
 }
@@ -1368,26 +1378,81 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
 //------------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
 {
-  // Compress the data.
-  vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
+  // Queue the block, so that blocks are compressed concurrently in batches
+  // of about 32MB.
+  constexpr size_t batchSize = 33554432;
+  this->CompressionBlocksData.insert(this->CompressionBlocksData.end(), data, data + size);
+  this->CompressionBlocksSizes.push_back(size);
+  if (this->CompressionBlocksData.size() < batchSize)
+  {
+    return 1;
+  }
+  return this->WriteCompressionBlocks();
+}
 
-  // Find the compressed size.
-  size_t outputSize = outputArray->GetNumberOfTuples();
-  unsigned char* outputPointer = outputArray->GetPointer(0);
+//------------------------------------------------------------------------------
+int vtkXMLWriter::WriteCompressionBlocks()
+{
+  const size_t numBlocks = this->CompressionBlocksSizes.size();
+  if (numBlocks == 0)
+  {
+    return 1;
+  }
 
-  // Write the compressed data.
-  int result = this->DataStream->Write(outputPointer, outputSize);
-  this->Stream->flush();
-  if (this->Stream->fail())
+  // Find where each block starts in the queue.
+  std::vector<size_t> offsets(numBlocks);
+  size_t offset = 0;
+  for (size_t i = 0; i < numBlocks; ++i)
   {
-    this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    offsets[i] = offset;
+    offset += this->CompressionBlocksSizes[i];
   }
 
-  // Store the resulting compressed size in the compression header.
-  this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, outputSize);
+  // Compress the blocks.  No block is larger than BlockSize.
+  const size_t compressionSpace = this->Compressor->GetMaximumCompressionSpace(this->BlockSize);
+  std::vector<unsigned char> compressedData(numBlocks * compressionSpace);
+  std::vector<size_t> compressedSizes(numBlocks);
+  auto compressBlocks = [&](vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      compressedSizes[i] = this->Compressor->Compress(
+        this->CompressionBlocksData.data() + offsets[i], this->CompressionBlocksSizes[i],
+        compressedData.data() + i * compressionSpace, compressionSpace);
+    }
+  };
+  if (this->UseThreadedCompression)
+  {
+    vtkSMPTools::For(0, static_cast<vtkIdType>(numBlocks), 1, compressBlocks);
+  }
+  else
+  {
+    compressBlocks(0, static_cast<vtkIdType>(numBlocks));
+  }
+  this->CompressionBlocksData.clear();
+  this->CompressionBlocksSizes.clear();
 
-  outputArray->Delete();
+  // Write the compressed data in order.
+  int result = 1;
+  for (size_t i = 0; i < numBlocks && result; ++i)
+  {
+    if (!compressedSizes[i])
+    {
+      vtkErrorMacro("Error compressing block " << this->CompressionBlockNumber << ".");
+      return 0;
+    }
+    result =
+      this->DataStream->Write(compressedData.data() + i * compressionSpace, compressedSizes[i]);
 
+    // Store the resulting compressed size in the compression header.
+    this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, compressedSizes[i]);
+  }
+  this->Stream->flush();
+  if (this->Stream->fail())
+  {
+    this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    return 0;
+  }
   return result;
 }
 
@@ -2028,6 +2093,21 @@ void vtkXMLWriter::WriteArrayAppended(vtkAbstractArray* a, vtkIndent indent, Off
 void vtkXMLWriter::WriteArrayAppendedData(
   vtkAbstractArray* a, vtkTypeInt64 pos, vtkTypeInt64& lastoffset)
 {
+  // Raw uncompressed values are padded to start at a multiple of their word
+  // size in the file, so that readers can map them in place.
+  if (!this->EncodeAppendedData && !this->Compressor && vtkArrayDownCast<vtkDataArray>(a) &&
+    a->GetDataType() != VTK_BIT)
+  {
+    ostream& os = *(this->Stream);
+    const vtkTypeInt64 wordSize =
+      static_cast<vtkTypeInt64>(this->GetOutputWordTypeSize(a->GetDataType()));
+    const vtkTypeInt64 headerSize = this->HeaderType == vtkXMLWriter::UInt64 ? 8 : 4;
+    const vtkTypeInt64 dataPos = static_cast<vtkTypeInt64>(os.tellp()) + headerSize;
+    for (vtkTypeInt64 i = 0; i < (wordSize - dataPos % wordSize) % wordSize; ++i)
+    {
+      os.put('\0');
+    }
+  }
   this->WriteAppendedDataOffset(pos, lastoffset, "offset");
   this->WriteBinaryData(a);
 }
@@ -11,6 +11,10 @@
 #include "vtkXMLReaderVersion.h"
 #include "vtkZLibDataCompressor.h"
 
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+#include "vtkZstdDataCompressor.h"
+#endif
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkCxxSetObjectMacro(vtkXMLWriterBase, Compressor, vtkDataCompressor);
 //----------------------------------------------------------------------------
@@ -122,6 +126,20 @@ void vtkXMLWriterBase::SetCompressorType(int compressorType)
     this->Compressor->SetCompressionLevel(this->CompressionLevel);
     this->Modified();
   }
+  else if (compressorType == ZSTD)
+  {
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+    if (this->Compressor)
+    {
+      this->Compressor->Delete();
+    }
+    this->Compressor = vtkZstdDataCompressor::New();
+    this->Compressor->SetCompressionLevel(this->CompressionLevel);
+    this->Modified();
+#else
+    vtkWarningMacro("Zstandard compression requires the VTK::IOZstd module.");
+#endif
+  }
   else
   {
     vtkWarningMacro("Invalid compressorType:" << compressorType);
@@ -257,5 +275,6 @@ void vtkXMLWriterBase::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << indent << "EncodeAppendedData: " << this->EncodeAppendedData << "\n";
   os << indent << "BlockSize: " << this->BlockSize << "\n";
+  os << indent << "UseThreadedCompression: " << this->UseThreadedCompression << "\n";
 }
 VTK_ABI_NAMESPACE_END
@@ -139,18 +139,21 @@ public:
     NONE,
     ZLIB,
     LZ4,
-    LZMA
+    LZMA,
+    ZSTD
   };
 
   ///@{
   /**
    * Convenience functions to set the compressor to certain known types.
+   * ZSTD requires the VTK::IOZstd module.
    */
   void SetCompressorType(int compressorType);
   void SetCompressorTypeToNone() { this->SetCompressorType(NONE); }
   void SetCompressorTypeToLZ4() { this->SetCompressorType(LZ4); }
   void SetCompressorTypeToZLib() { this->SetCompressorType(ZLIB); }
   void SetCompressorTypeToLZMA() { this->SetCompressorType(LZMA); }
+  void SetCompressorTypeToZstd() { this->SetCompressorType(ZSTD); }
   ///@}
 
   ///@{
@@ -173,6 +176,19 @@ public:
   vtkGetMacro(BlockSize, size_t);
   ///@}
 
+  ///@{
+  /**
+   * Enable the concurrent compression of the blocks of an array.  The
+   * compressor is then used by several threads at once, see
+   * vtkDataCompressor.  Turn this off when using a custom compressor whose
+   * Compress method is not thread-safe.  The files are identical either way.
+   * Default is true.
+   */
+  vtkSetMacro(UseThreadedCompression, bool);
+  vtkGetMacro(UseThreadedCompression, bool);
+  vtkBooleanMacro(UseThreadedCompression, bool);
+  ///@}
+
   ///@{
   /**
    * Get/Set the data mode used for the file's data.  The options are
@@ -258,6 +274,7 @@ protected:
   // Compression information.
   vtkDataCompressor* Compressor;
   size_t BlockSize;
+  bool UseThreadedCompression = true;
 
   // Compression Level for vtkDataCompressor objects
   // 1 (worst compression, fastest) ... 9 (best compression, slowest)
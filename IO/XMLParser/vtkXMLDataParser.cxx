@@ -8,6 +8,7 @@
 #include "vtkDataCompressor.h"
 #include "vtkInputStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkStringScanner.h"
 #include "vtkXMLDataElement.h"
 #define vtkXMLDataHeaderPrivate_DoNotInclude
@@ -15,6 +16,7 @@
 #undef vtkXMLDataHeaderPrivate_DoNotInclude
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cctype>
 #include <memory>
@@ -90,6 +92,7 @@ void vtkXMLDataParser::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "AppendedDataPosition: " << this->AppendedDataPosition << "\n";
   os << indent << "AppendedDataFound: " << this->AppendedDataFound << "\n";
+  os << indent << "UseThreadedDecompression: " << this->UseThreadedDecompression << "\n";
   if (this->RootElement)
   {
     this->RootElement->PrintXML(os, indent);
@@ -750,85 +753,90 @@ size_t vtkXMLDataParser::ReadCompressedData(
   // Find the offset into the last block where the data end.
   size_t endBlockOffset = endOffset - lastBlock * this->BlockUncompressedSize;
 
+  // Read the compressed blocks in batches of about 32MB, and decompress the
+  // blocks of a batch concurrently straight into the output.  Only the
+  // blocks partially covered by the requested range need a temporary buffer.
+  constexpr size_t batchSize = 33554432;
+  vtkTypeUInt64 endBlock = lastBlock + (endBlockOffset > 0 ? 1 : 0);
+  size_t length = endOffset - beginOffset;
+  std::vector<unsigned char> compressedData;
   this->UpdateProgress(0);
-  if (firstBlock == lastBlock)
-  {
-    // Everything fits in one block.
-    unsigned char* blockBuffer = this->ReadBlock(firstBlock);
-    if (!blockBuffer)
+  for (vtkTypeUInt64 batchBegin = firstBlock, batchEnd; batchBegin < endBlock && !this->Abort;
+       batchBegin = batchEnd)
+  {
+    // Find the blocks of this batch, which are contiguous in the stream.
+    size_t compressedSize = this->BlockCompressedSizes[batchBegin];
+    for (batchEnd = batchBegin + 1; batchEnd < endBlock &&
+         compressedSize + this->BlockCompressedSizes[batchEnd] <= batchSize;
+         ++batchEnd)
     {
-      return 0;
+      compressedSize += this->BlockCompressedSizes[batchEnd];
     }
-    size_t n = endBlockOffset - beginBlockOffset;
-    memcpy(data, blockBuffer + beginBlockOffset, n);
-    delete[] blockBuffer;
-
-    // Byte swap this block.  Note that n will always be an integer
-    // multiple of the word size.
-    this->PerformByteSwap(data, n / wordSize, wordSize);
-  }
-  else
-  {
-    // Read all the complete blocks first.
-    size_t length = endOffset - beginOffset;
-    unsigned char* outputPointer = data;
-    size_t blockSize = this->FindBlockSize(firstBlock);
 
-    // Read the first block.
-    unsigned char* blockBuffer = this->ReadBlock(firstBlock);
-    if (!blockBuffer)
+    // Read the compressed blocks.
+    compressedData.resize(compressedSize);
+    if (!this->DataStream->Seek(this->BlockStartOffsets[batchBegin]) ||
+      this->DataStream->Read(compressedData.data(), compressedSize) < compressedSize)
     {
       return 0;
     }
-    size_t n = blockSize - beginBlockOffset;
-    memcpy(outputPointer, blockBuffer + beginBlockOffset, n);
-    delete[] blockBuffer;
-
-    // Byte swap the first block.  Note that n will always be an
-    // integer multiple of the word size.
-    this->PerformByteSwap(outputPointer, n / wordSize, wordSize);
-
-    // Advance the pointer to the beginning of the second block.
-    outputPointer += blockSize - beginBlockOffset;
-
-    // Report progress.
-    this->UpdateProgress(float(outputPointer - data) / length);
 
-    unsigned int currentBlock = firstBlock + 1;
-    for (; currentBlock != lastBlock && !this->Abort; ++currentBlock)
+    // Decompress and byte swap them.  Note that the byte counts will always
+    // be integer multiples of the word size.
+    std::atomic<bool> failed(false);
+    auto uncompressBlocks = [&](vtkIdType begin, vtkIdType end)
     {
-      // Read this block.
-      if (!this->ReadBlock(currentBlock, outputPointer))
+      std::vector<unsigned char> blockBuffer;
+      for (vtkIdType block = begin; block < end && !failed; ++block)
       {
-        return 0;
+        size_t blockSize = this->FindBlockSize(block);
+        size_t first = vtkTypeUInt64(block) == firstBlock ? beginBlockOffset : 0;
+        size_t last = vtkTypeUInt64(block) == lastBlock ? endBlockOffset : blockSize;
+        unsigned char* outputPointer =
+          data + (block * this->BlockUncompressedSize + first - beginOffset);
+        unsigned char const* blockData = compressedData.data() +
+          (this->BlockStartOffsets[block] - this->BlockStartOffsets[batchBegin]);
+        size_t const blockCompressedSize = this->BlockCompressedSizes[block];
+        if (first == 0 && last == blockSize)
+        {
+          if (!this->Compressor->Uncompress(
+                blockData, blockCompressedSize, outputPointer, blockSize))
+          {
+            failed = true;
+          }
+        }
+        else
+        {
+          blockBuffer.resize(blockSize);
+          if (!this->Compressor->Uncompress(
+                blockData, blockCompressedSize, blockBuffer.data(), blockSize))
+          {
+            failed = true;
+            continue;
+          }
+          memcpy(outputPointer, blockBuffer.data() + first, last - first);
+        }
+        this->PerformByteSwap(outputPointer, (last - first) / wordSize, wordSize);
       }
-
-      // Byte swap this block.  Note that blockSize will always be an
-      // integer multiple of the word size.
-      this->PerformByteSwap(outputPointer, blockSize / wordSize, wordSize);
-
-      // Advance the pointer to the beginning of the next block.
-      outputPointer += this->FindBlockSize(currentBlock);
-
-      // Report progress.
-      this->UpdateProgress(float(outputPointer - data) / length);
+    };
+    if (this->UseThreadedDecompression)
+    {
+      vtkSMPTools::For(
+        static_cast<vtkIdType>(batchBegin), static_cast<vtkIdType>(batchEnd), 1, uncompressBlocks);
     }
-
-    // Now read the final block, which is incomplete if it exists.
-    if (endBlockOffset > 0 && !this->Abort)
+    else
     {
-      blockBuffer = this->ReadBlock(lastBlock);
-      if (!blockBuffer)
-      {
-        return 0;
-      }
-      memcpy(outputPointer, blockBuffer, endBlockOffset);
-      delete[] blockBuffer;
-
-      // Byte swap the partial block.  Note that endBlockOffset will
-      // always be an integer multiple of the word size.
-      this->PerformByteSwap(outputPointer, endBlockOffset / wordSize, wordSize);
+      uncompressBlocks(static_cast<vtkIdType>(batchBegin), static_cast<vtkIdType>(batchEnd));
+    }
+    if (failed)
+    {
+      return 0;
     }
+
+    // Report progress.
+    vtkTypeUInt64 const readEnd =
+      std::min(batchEnd * this->BlockUncompressedSize, vtkTypeUInt64(endOffset));
+    this->UpdateProgress(float(readEnd - beginOffset) / length);
   }
   this->UpdateProgress(1);
 
@@ -953,6 +961,38 @@ size_t vtkXMLDataParser::ReadAppendedData(
   return this->ReadBinaryData(buffer, startWord, numWords, wordType);
 }
 
+//------------------------------------------------------------------------------
+bool vtkXMLDataParser::FindRawAppendedData(
+  vtkTypeInt64 offset, size_t numWords, int wordType, vtkTypeInt64& position)
+{
+#ifdef VTK_WORDS_BIGENDIAN
+  const int nativeByteOrder = vtkXMLDataParser::BigEndian;
+#else
+  const int nativeByteOrder = vtkXMLDataParser::LittleEndian;
+#endif
+  if (this->Compressor || this->ByteOrder != nativeByteOrder || this->AppendedDataPosition <= 0 ||
+    vtkBase64InputStream::SafeDownCast(this->AppendedDataStream))
+  {
+    return false;
+  }
+
+  // Check that the data holds all the words.
+  std::unique_ptr<vtkXMLDataHeader> uh(vtkXMLDataHeader::New(this->HeaderType, 1));
+  const size_t headerSize = uh->DataSize();
+  this->SeekG(this->AppendedDataPosition + offset);
+  this->AppendedDataStream->SetStream(this->Stream);
+  this->AppendedDataStream->StartReading();
+  const size_t r = this->AppendedDataStream->Read(uh->Data(), headerSize);
+  this->AppendedDataStream->EndReading();
+  if (r < headerSize || uh->Get(0) < numWords * this->GetWordTypeSize(wordType))
+  {
+    return false;
+  }
+
+  position = this->AppendedDataPosition + offset + static_cast<vtkTypeInt64>(headerSize);
+  return true;
+}
+
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 // Define a parsing function template.  The extra "long" argument is used
@@ -70,6 +70,15 @@ public:
     return this->ReadAppendedData(offset, buffer, startWord, numWords, VTK_CHAR);
   }
 
+  /**
+   * Find the position in the input of the numWords words of the given type
+   * stored at the given appended data offset, if they are stored as is:
+   * raw appended data, uncompressed, in the byte order of this machine.
+   * Returns false otherwise, in which case they must be read.
+   */
+  bool FindRawAppendedData(
+    vtkTypeInt64 offset, size_t numWords, int wordType, vtkTypeInt64& position);
+
   /**
    * Read from an ascii data section starting at the current position in
    * the stream.  Returns the number of words read.
@@ -91,6 +100,18 @@ public:
   vtkGetObjectMacro(Compressor, vtkDataCompressor);
   ///@}
 
+  ///@{
+  /**
+   * Enable the concurrent decompression of the blocks of compressed data.
+   * The compressor is then shared by several threads: turn this off for
+   * compressors whose Uncompress method is not thread-safe.
+   * Default is true.
+   */
+  vtkSetMacro(UseThreadedDecompression, bool);
+  vtkGetMacro(UseThreadedDecompression, bool);
+  vtkBooleanMacro(UseThreadedDecompression, bool);
+  ///@}
+
   /**
    * Get the size of a word of the given type.
    */
@@ -231,6 +252,7 @@ protected:
   size_t PartialLastBlockUncompressedSize;
   size_t* BlockCompressedSizes;
   vtkTypeInt64* BlockStartOffsets;
+  bool UseThreadedDecompression = true;
 
   // Ascii data parsing.
   unsigned char* AsciiDataBuffer;
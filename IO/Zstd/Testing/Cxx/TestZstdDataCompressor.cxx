@@ -0,0 +1,210 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that vtkZstdDataCompressor uncompresses what it compresses at all
+// levels, with a trained dictionary and with several threads, and that the
+// XML writers and readers support it.
+
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+#include "vtkZstdDataCompressor.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Text-like records sharing most of their content, as small buffers for
+// which a dictionary helps.
+std::string MakeRecord(int i)
+{
+  return "<Piece NumberOfPoints=\"" + std::to_string(i * 37 % 1000) + "\" NumberOfCells=\"" +
+    std::to_string(i * 91 % 500) + "\"><PointData Scalars=\"Temperature\" Vectors=\"Velocity\">" +
+    "<DataArray type=\"Float32\" Name=\"Temperature\" format=\"appended\" offset=\"" +
+    std::to_string(i * 4096) + "\"/></PointData></Piece>";
+}
+
+bool RoundTrip(vtkZstdDataCompressor* compressor, const std::vector<unsigned char>& data,
+  const std::string& name, size_t* compressedSize = nullptr)
+{
+  vtkSmartPointer<vtkUnsignedCharArray> compressed;
+  compressed.TakeReference(compressor->Compress(data.data(), data.size()));
+  if (!compressed)
+  {
+    vtkLog(ERROR, "Compression failed with " << name << ".");
+    return false;
+  }
+  vtkSmartPointer<vtkUnsignedCharArray> uncompressed;
+  uncompressed.TakeReference(compressor->Uncompress(compressed->GetPointer(0),
+    static_cast<size_t>(compressed->GetNumberOfValues()), data.size()));
+  if (!uncompressed || uncompressed->GetNumberOfValues() != static_cast<vtkIdType>(data.size()) ||
+    std::memcmp(uncompressed->GetPointer(0), data.data(), data.size()) != 0)
+  {
+    vtkLog(ERROR, "Uncompressed data differ with " << name << ".");
+    return false;
+  }
+  if (compressedSize)
+  {
+    *compressedSize = static_cast<size_t>(compressed->GetNumberOfValues());
+  }
+  return true;
+}
+
+bool TestLevels()
+{
+  std::vector<unsigned char> data(1 << 20);
+  for (size_t i = 0; i < data.size(); ++i)
+  {
+    data[i] = static_cast<unsigned char>(100.0 * std::sin(0.001 * i) + (i % 7));
+  }
+
+  bool success = true;
+  vtkNew<vtkZstdDataCompressor> compressor;
+  for (int level = 1; level <= 9; ++level)
+  {
+    compressor->SetCompressionLevel(level);
+    success &= RoundTrip(compressor, data, "level " + std::to_string(level));
+    if (compressor->GetZstdCompressionLevel() !=
+      vtkZstdDataCompressor::ToZstdCompressionLevel(level))
+    {
+      vtkLog(ERROR, "Wrong Zstandard level for level " << level << ".");
+      success = false;
+    }
+  }
+
+  // Native levels between two mapped levels keep the lower level.
+  compressor->SetZstdCompressionLevel(5);
+  success &= RoundTrip(compressor, data, "Zstandard level 5");
+  if (compressor->GetZstdCompressionLevel() != 5 || compressor->GetCompressionLevel() != 4)
+  {
+    vtkLog(ERROR, "Wrong levels for Zstandard level 5.");
+    success = false;
+  }
+  compressor->SetNumberOfThreads(4);
+  success &= RoundTrip(compressor, data, "4 threads");
+  return success;
+}
+
+bool TestDictionary()
+{
+  vtkNew<vtkUnsignedCharArray> samples;
+  vtkNew<vtkIdTypeArray> sampleSizes;
+  for (int i = 0; i < 1000; ++i)
+  {
+    const std::string record = MakeRecord(i);
+    for (char c : record)
+    {
+      samples->InsertNextValue(static_cast<unsigned char>(c));
+    }
+    sampleSizes->InsertNextValue(static_cast<vtkIdType>(record.size()));
+  }
+
+  vtkNew<vtkZstdDataCompressor> compressor;
+  const std::string record = MakeRecord(1234);
+  const std::vector<unsigned char> data(record.begin(), record.end());
+  size_t sizeWithoutDictionary = 0;
+  if (!RoundTrip(compressor, data, "no dictionary", &sizeWithoutDictionary))
+  {
+    return false;
+  }
+  if (!compressor->TrainDictionary(samples, sampleSizes, 4096) || !compressor->GetDictionary())
+  {
+    vtkLog(ERROR, "Dictionary training failed.");
+    return false;
+  }
+  size_t sizeWithDictionary = 0;
+  if (!RoundTrip(compressor, data, "a dictionary", &sizeWithDictionary))
+  {
+    return false;
+  }
+  if (sizeWithDictionary >= sizeWithoutDictionary)
+  {
+    vtkLog(ERROR,
+      "The dictionary does not help: " << sizeWithDictionary << " bytes instead of "
+                                       << sizeWithoutDictionary << ".");
+    return false;
+  }
+
+  // Another compressor with the same dictionary uncompresses the data.
+  vtkSmartPointer<vtkUnsignedCharArray> compressed;
+  compressed.TakeReference(compressor->Compress(data.data(), data.size()));
+  vtkNew<vtkZstdDataCompressor> other;
+  other->SetDictionary(compressor->GetDictionary());
+  vtkSmartPointer<vtkUnsignedCharArray> uncompressed;
+  uncompressed.TakeReference(other->Uncompress(compressed->GetPointer(0),
+    static_cast<size_t>(compressed->GetNumberOfValues()), data.size()));
+  if (!uncompressed || std::memcmp(uncompressed->GetPointer(0), data.data(), data.size()) != 0)
+  {
+    vtkLog(ERROR, "A copy of the dictionary does not uncompress the data.");
+    return false;
+  }
+  return true;
+}
+
+bool TestXML()
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(50, 40, 30);
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+  {
+    scalars->SetValue(i, static_cast<float>(std::cos(0.01 * i)));
+  }
+  image->GetPointData()->SetScalars(scalars);
+
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->SetCompressorTypeToZstd();
+  writer->SetCompressionLevel(7);
+  writer->SetDataModeToAppended();
+  writer->EncodeAppendedDataOff();
+  writer->WriteToOutputStringOn();
+  writer->Write();
+  if (!vtkZstdDataCompressor::SafeDownCast(writer->GetCompressor()))
+  {
+    vtkLog(ERROR, "The XML writer does not use a Zstandard compressor.");
+    return false;
+  }
+
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(writer->GetOutputString());
+  reader->Update();
+  vtkDataArray* actual = reader->GetOutput()->GetPointData()->GetScalars();
+  if (!actual || actual->GetNumberOfTuples() != scalars->GetNumberOfTuples())
+  {
+    vtkLog(ERROR, "The XML reader does not read the Zstandard compressed scalars.");
+    return false;
+  }
+  for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); ++i)
+  {
+    if (actual->GetComponent(i, 0) != scalars->GetValue(i))
+    {
+      vtkLog(ERROR, "Scalar " << i << " differs after an XML round trip.");
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestZstdDataCompressor(int, char*[])
+{
+  bool success = TestLevels();
+  success &= TestDictionary();
+  success &= TestXML();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
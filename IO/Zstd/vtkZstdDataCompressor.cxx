@@ -0,0 +1,308 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkZstdDataCompressor.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <zdict.h>
+#include <zstd.h>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+// The Zstandard levels matching the levels 1 to 9 of vtkDataCompressor.
+constexpr int ZstdLevels[9] = { 1, 2, 3, 4, 6, 9, 12, 15, 19 };
+}
+
+//------------------------------------------------------------------------------
+struct vtkZstdDataCompressor::vtkInternals
+{
+  // Several threads may compress or uncompress with the same compressor, so
+  // each thread gets its own contexts, reused from one buffer to the next.
+  vtkSMPThreadLocal<ZSTD_CCtx*> CompressionContexts;
+  vtkSMPThreadLocal<ZSTD_DCtx*> DecompressionContexts;
+
+  vtkNew<vtkUnsignedCharArray> Dictionary;
+  ZSTD_CDict* CompressionDictionary = nullptr;
+  ZSTD_DDict* DecompressionDictionary = nullptr;
+
+  vtkInternals()
+    : CompressionContexts(nullptr)
+    , DecompressionContexts(nullptr)
+  {
+  }
+
+  ~vtkInternals()
+  {
+    for (ZSTD_CCtx* context : this->CompressionContexts)
+    {
+      ZSTD_freeCCtx(context);
+    }
+    for (ZSTD_DCtx* context : this->DecompressionContexts)
+    {
+      ZSTD_freeDCtx(context);
+    }
+    this->FreeDictionaries();
+  }
+
+  void FreeDictionaries()
+  {
+    ZSTD_freeCDict(this->CompressionDictionary);
+    this->CompressionDictionary = nullptr;
+    ZSTD_freeDDict(this->DecompressionDictionary);
+    this->DecompressionDictionary = nullptr;
+  }
+
+  // Digest the dictionary once, instead of for every buffer.
+  void UpdateDictionaries(int zstdCompressionLevel)
+  {
+    this->FreeDictionaries();
+    const size_t size = static_cast<size_t>(this->Dictionary->GetNumberOfValues());
+    if (size > 0)
+    {
+      const unsigned char* dictionary = this->Dictionary->GetPointer(0);
+      this->CompressionDictionary =
+        ZSTD_createCDict(dictionary, size, zstdCompressionLevel);
+      this->DecompressionDictionary = ZSTD_createDDict(dictionary, size);
+    }
+  }
+};
+
+vtkStandardNewMacro(vtkZstdDataCompressor);
+
+//------------------------------------------------------------------------------
+vtkZstdDataCompressor::vtkZstdDataCompressor()
+  : Internals(new vtkInternals)
+{
+  this->CompressionLevel = 5;
+  this->ZstdCompressionLevel = ZstdLevels[this->CompressionLevel - 1];
+  this->NumberOfThreads = 0;
+}
+
+//------------------------------------------------------------------------------
+vtkZstdDataCompressor::~vtkZstdDataCompressor() = default;
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "CompressionLevel: " << this->CompressionLevel << endl;
+  os << indent << "ZstdCompressionLevel: " << this->ZstdCompressionLevel << endl;
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
+  os << indent << "DictionarySize: " << this->Internals->Dictionary->GetNumberOfValues() << endl;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::CompressBuffer(unsigned char const* uncompressedData,
+  size_t uncompressedSize, unsigned char* compressedData, size_t compressionSpace)
+{
+  ZSTD_CCtx*& context = this->Internals->CompressionContexts.Local();
+  if (!context)
+  {
+    context = ZSTD_createCCtx();
+    if (!context)
+    {
+      vtkErrorMacro("Memory allocation failed.");
+      return 0;
+    }
+  }
+
+  ZSTD_CCtx_reset(context, ZSTD_reset_session_and_parameters);
+  ZSTD_CCtx_setParameter(context, ZSTD_c_compressionLevel, this->ZstdCompressionLevel);
+  if (this->NumberOfThreads > 0)
+  {
+    // This fails, and compression stays single-threaded, if the Zstandard
+    // library was built without multithreading support.
+    ZSTD_CCtx_setParameter(context, ZSTD_c_nbWorkers, this->NumberOfThreads);
+  }
+  if (this->Internals->CompressionDictionary)
+  {
+    ZSTD_CCtx_refCDict(context, this->Internals->CompressionDictionary);
+  }
+
+  const size_t result =
+    ZSTD_compress2(context, compressedData, compressionSpace, uncompressedData, uncompressedSize);
+  if (ZSTD_isError(result))
+  {
+    vtkErrorMacro("Zstd error while compressing data: " << ZSTD_getErrorName(result));
+    return 0;
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::UncompressBuffer(unsigned char const* compressedData,
+  size_t compressedSize, unsigned char* uncompressedData, size_t uncompressedSize)
+{
+  ZSTD_DCtx*& context = this->Internals->DecompressionContexts.Local();
+  if (!context)
+  {
+    context = ZSTD_createDCtx();
+    if (!context)
+    {
+      vtkErrorMacro("Memory allocation failed.");
+      return 0;
+    }
+  }
+
+  const size_t result = this->Internals->DecompressionDictionary
+    ? ZSTD_decompress_usingDDict(context, uncompressedData, uncompressedSize, compressedData,
+        compressedSize, this->Internals->DecompressionDictionary)
+    : ZSTD_decompressDCtx(
+        context, uncompressedData, uncompressedSize, compressedData, compressedSize);
+  if (ZSTD_isError(result))
+  {
+    vtkErrorMacro("Zstd error while uncompressing data: " << ZSTD_getErrorName(result));
+    return 0;
+  }
+
+  // Make sure the output size matched that expected.
+  if (result != uncompressedSize)
+  {
+    vtkErrorMacro("Decompression produced incorrect size.\n"
+                  "Expected "
+      << uncompressedSize << " and got " << result);
+    return 0;
+  }
+
+  return result;
+}
+
+//------------------------------------------------------------------------------
+int vtkZstdDataCompressor::GetCompressionLevel()
+{
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): returning CompressionLevel "
+                << this->CompressionLevel);
+  return this->CompressionLevel;
+}
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::SetCompressionLevel(int compressionLevel)
+{
+  int min = 1;
+  int max = 9;
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): setting CompressionLevel to "
+                << compressionLevel);
+  compressionLevel = std::min(std::max(compressionLevel, min), max);
+  if (this->CompressionLevel != compressionLevel ||
+    this->ZstdCompressionLevel != ZstdLevels[compressionLevel - 1])
+  {
+    this->CompressionLevel = compressionLevel;
+    this->ZstdCompressionLevel = ZstdLevels[compressionLevel - 1];
+    this->Internals->UpdateDictionaries(this->ZstdCompressionLevel);
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::SetZstdCompressionLevel(int zstdCompressionLevel)
+{
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): setting ZstdCompressionLevel to "
+                << zstdCompressionLevel);
+  zstdCompressionLevel = std::min(std::max(zstdCompressionLevel, 1), ZSTD_maxCLevel());
+  if (this->ZstdCompressionLevel != zstdCompressionLevel)
+  {
+    this->ZstdCompressionLevel = zstdCompressionLevel;
+    this->CompressionLevel = static_cast<int>(
+      std::upper_bound(std::begin(ZstdLevels), std::end(ZstdLevels), zstdCompressionLevel) -
+      std::begin(ZstdLevels));
+    this->Internals->UpdateDictionaries(this->ZstdCompressionLevel);
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+int vtkZstdDataCompressor::ToZstdCompressionLevel(int compressionLevel)
+{
+  return ZstdLevels[std::min(std::max(compressionLevel, 1), 9) - 1];
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::GetMaximumCompressionSpace(size_t size)
+{
+  return ZSTD_compressBound(size);
+}
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::SetDictionary(vtkUnsignedCharArray* dictionary)
+{
+  if (dictionary)
+  {
+    this->Internals->Dictionary->DeepCopy(dictionary);
+  }
+  else
+  {
+    this->Internals->Dictionary->Initialize();
+  }
+  this->Internals->UpdateDictionaries(this->ZstdCompressionLevel);
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+vtkUnsignedCharArray* vtkZstdDataCompressor::GetDictionary()
+{
+  return this->Internals->Dictionary->GetNumberOfValues() > 0 ? this->Internals->Dictionary.Get()
+                                                              : nullptr;
+}
+
+//------------------------------------------------------------------------------
+bool vtkZstdDataCompressor::TrainDictionary(
+  vtkUnsignedCharArray* samples, vtkIdTypeArray* sampleSizes, size_t dictionaryCapacity)
+{
+  if (!samples || !sampleSizes || sampleSizes->GetNumberOfValues() == 0)
+  {
+    vtkErrorMacro("No samples to train a dictionary from.");
+    return false;
+  }
+
+  std::vector<size_t> sizes(sampleSizes->GetNumberOfValues());
+  vtkIdType totalSize = 0;
+  for (vtkIdType i = 0; i < sampleSizes->GetNumberOfValues(); ++i)
+  {
+    sizes[i] = static_cast<size_t>(sampleSizes->GetValue(i));
+    totalSize += sampleSizes->GetValue(i);
+  }
+  if (totalSize != samples->GetNumberOfValues())
+  {
+    vtkErrorMacro("The sample sizes add up to " << totalSize << " bytes instead of "
+                                                << samples->GetNumberOfValues() << ".");
+    return false;
+  }
+
+  vtkNew<vtkUnsignedCharArray> dictionary;
+  dictionary->SetNumberOfValues(static_cast<vtkIdType>(dictionaryCapacity));
+  const size_t result = ZDICT_trainFromBuffer(dictionary->GetPointer(0), dictionaryCapacity,
+    samples->GetPointer(0), sizes.data(), static_cast<unsigned int>(sizes.size()));
+  if (ZDICT_isError(result))
+  {
+    vtkErrorMacro("Zstd error while training a dictionary: " << ZDICT_getErrorName(result));
+    return false;
+  }
+  dictionary->SetNumberOfValues(static_cast<vtkIdType>(result));
+  this->SetDictionary(dictionary);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkZstdDataCompressor::GetUncompressedSize(
+  unsigned char const* compressedData, size_t compressedSize, size_t& uncompressedSize)
+{
+  const unsigned long long size = ZSTD_getFrameContentSize(compressedData, compressedSize);
+  if (size == ZSTD_CONTENTSIZE_UNKNOWN || size == ZSTD_CONTENTSIZE_ERROR ||
+    size > std::numeric_limits<size_t>::max())
+  {
+    return false;
+  }
+  uncompressedSize = static_cast<size_t>(size);
+  return true;
+}
+VTK_ABI_NAMESPACE_END
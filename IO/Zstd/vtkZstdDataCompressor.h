@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkZstdDataCompressor
+ * @brief   Data compression using Zstandard.
+ *
+ * vtkZstdDataCompressor provides a concrete vtkDataCompressor class
+ * using Zstandard for compressing and uncompressing data.  Zstandard
+ * compresses about as fast as zlib with a better ratio, and uncompresses
+ * faster.  The compression levels 1 to 9 are mapped to the Zstandard
+ * levels 1 to 19, which can also be set directly with
+ * SetZstdCompressionLevel.
+ *
+ * A dictionary, trained from samples of the data with TrainDictionary or
+ * given with SetDictionary, improves the compression of small buffers.
+ * Data compressed with a dictionary can only be uncompressed with the same
+ * dictionary.  The XML file formats do not store it, so dictionaries are
+ * meant for buffers compressed and uncompressed with this class directly.
+ *
+ * @sa
+ * vtkZLibDataCompressor vtkLZ4DataCompressor vtkLZMADataCompressor
+ */
+
+#ifndef vtkZstdDataCompressor_h
+#define vtkZstdDataCompressor_h
+
+#include "vtkDataCompressor.h"
+#include "vtkIOZstdModule.h" // For export macro
+
+#include <memory> // For std::unique_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkIdTypeArray;
+class vtkUnsignedCharArray;
+
+class VTKIOZSTD_EXPORT vtkZstdDataCompressor : public vtkDataCompressor
+{
+public:
+  vtkTypeMacro(vtkZstdDataCompressor, vtkDataCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  static vtkZstdDataCompressor* New();
+
+  /**
+   *  Get the maximum space that may be needed to store data of the
+   *  given uncompressed size after compression.  This is the minimum
+   *  size of the output buffer that can be passed to the four-argument
+   *  Compress method.
+   */
+  size_t GetMaximumCompressionSpace(size_t size) override;
+
+  // Compression level setter required by vtkDataCompressor.
+  void SetCompressionLevel(int compressionLevel) override;
+
+  // Compression level getter required by vtkDataCompressor.
+  int GetCompressionLevel() override;
+
+  ///@{
+  /**
+   * Get/Set the native Zstandard compression level, from 1 to the maximum
+   * level of the Zstandard library.  SetCompressionLevel sets it to
+   * ToZstdCompressionLevel(compressionLevel).  Setting it directly sets
+   * CompressionLevel to the highest level that maps to at most this level.
+   */
+  void SetZstdCompressionLevel(int zstdCompressionLevel);
+  int GetZstdCompressionLevel() { return this->ZstdCompressionLevel; }
+  ///@}
+
+  /**
+   * Get the native Zstandard level that a compression level from 1 to 9
+   * maps to.
+   */
+  static int ToZstdCompressionLevel(int compressionLevel);
+
+  ///@{
+  /**
+   * Get/Set the number of threads Zstandard uses to compress each buffer,
+   * if the Zstandard library supports multithreading.  Only buffers of
+   * several megabytes are split between threads, so this is meant for
+   * large buffers, such as a large BlockSize of the XML writers, which
+   * already compress their blocks concurrently.  The default, 0,
+   * compresses in the calling thread.
+   */
+  vtkSetClampMacro(NumberOfThreads, int, 0, 256);
+  vtkGetMacro(NumberOfThreads, int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the dictionary used to compress and uncompress data.  The
+   * dictionary is copied.  Set nullptr or an empty array to compress
+   * without dictionary, which is the default.
+   */
+  void SetDictionary(vtkUnsignedCharArray* dictionary);
+  vtkUnsignedCharArray* GetDictionary();
+  ///@}
+
+  /**
+   * Train a dictionary of at most dictionaryCapacity bytes from the given
+   * samples, stored one after the other in samples with their sizes in
+   * sampleSizes, and use it.  Zstandard needs about a hundred samples, and
+   * about a hundred times more sample data than the dictionary capacity.
+   * Returns false, and keeps the current dictionary, if training fails.
+   */
+  bool TrainDictionary(
+    vtkUnsignedCharArray* samples, vtkIdTypeArray* sampleSizes, size_t dictionaryCapacity = 112640);
+
+  /**
+   * Get the uncompressed size of data compressed by Zstandard, as stored in
+   * its frame header.  This is the size to pass to Uncompress when it is not
+   * known otherwise.  Returns false if the data is not a Zstandard frame, or
+   * if its frame does not store the uncompressed size.
+   */
+  static bool GetUncompressedSize(
+    unsigned char const* compressedData, size_t compressedSize, size_t& uncompressedSize);
+
+protected:
+  vtkZstdDataCompressor();
+  ~vtkZstdDataCompressor() override;
+
+  int CompressionLevel;
+  int ZstdCompressionLevel;
+  int NumberOfThreads;
+
+  // Compression method required by vtkDataCompressor.
+  size_t CompressBuffer(unsigned char const* uncompressedData, size_t uncompressedSize,
+    unsigned char* compressedData, size_t compressionSpace) override;
+  // Decompression method required by vtkDataCompressor.
+  size_t UncompressBuffer(unsigned char const* compressedData, size_t compressedSize,
+    unsigned char* uncompressedData, size_t uncompressedSize) override;
+
+private:
+  vtkZstdDataCompressor(const vtkZstdDataCompressor&) = delete;
+  void operator=(const vtkZstdDataCompressor&) = delete;
+
+  struct vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif